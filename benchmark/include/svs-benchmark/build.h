@@ -338,8 +338,9 @@ DynamicOperation<Index> measure_state(
     std::this_thread::sleep_for(std::chrono::milliseconds(200));
 
     size_t num_neighbors = parameters.num_neighbors_;
-    auto iso_config =
-        search::search_with_config(index, configurations, queries, gt, num_neighbors);
+    auto iso_config = search::search_with_config(
+        index, configurations, queries, gt, num_neighbors, parameters.latency_
+    );
 
     auto query_set = search::QuerySet(queries, gt, queries_in_training_set);
     auto iso_recall = search::tune_and_search_with_hint(
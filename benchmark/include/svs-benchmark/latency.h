@@ -0,0 +1,132 @@
+#pragma once
+
+// svs
+#include "svs/lib/exception.h"
+
+// stl
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace svsbenchmark {
+
+///
+/// Log-linear histogram for recording latencies, in the spirit of HdrHistogram.
+///
+/// Values below `2 * sub_buckets` are recorded exactly. Larger values are grouped by
+/// power of two with each power of two split into `sub_buckets` linear buckets, so the
+/// relative error of reported percentiles is at most `1 / sub_buckets`.
+///
+/// Recording is constant time and allocation free. Use one histogram per thread and
+/// `merge` the results.
+///
+class LatencyHistogram {
+  public:
+    static constexpr size_t sub_bucket_bits = 7;
+    static constexpr size_t sub_buckets = size_t{1} << sub_bucket_bits;
+    static constexpr size_t num_buckets = (64 - sub_bucket_bits + 1) * sub_buckets;
+
+    LatencyHistogram()
+        : counts_(num_buckets, 0) {}
+
+    ///
+    /// Record a single value (typically in nanoseconds).
+    ///
+    void record(uint64_t value, size_t count = 1) {
+        counts_[bucket_index(value)] += count;
+        total_ += count;
+        sum_ += static_cast<double>(value) * count;
+        min_ = std::min(min_, value);
+        max_ = std::max(max_, value);
+    }
+
+    ///
+    /// Add all values recorded in `other` to this histogram.
+    ///
+    void merge(const LatencyHistogram& other) {
+        for (size_t i = 0; i < num_buckets; ++i) {
+            counts_[i] += other.counts_[i];
+        }
+        total_ += other.total_;
+        sum_ += other.sum_;
+        min_ = std::min(min_, other.min_);
+        max_ = std::max(max_, other.max_);
+    }
+
+    /// Return the number of recorded values.
+    size_t count() const { return total_; }
+    /// Return the smallest recorded value. Returns 0 if the histogram is empty.
+    uint64_t min() const { return total_ == 0 ? 0 : min_; }
+    /// Return the largest recorded value.
+    uint64_t max() const { return max_; }
+    /// Return the exact mean of all recorded values.
+    double mean() const { return total_ == 0 ? 0.0 : sum_ / static_cast<double>(total_); }
+
+    ///
+    /// @brief Return the value at percentile `p`.
+    ///
+    /// @param p The percentile in the range `[0, 100]`.
+    ///
+    /// The returned value is the largest value equivalent to the bucket containing the
+    /// requested percentile (capped by the largest recorded value) so the reported
+    /// latency is never optimistic.
+    ///
+    uint64_t value_at_percentile(double p) const {
+        if (p < 0 || p > 100) {
+            throw ANNEXCEPTION("Percentile {} must be between 0 and 100!", p);
+        }
+        if (total_ == 0) {
+            return 0;
+        }
+
+        auto target = static_cast<size_t>(std::ceil(p / 100 * static_cast<double>(total_)));
+        target = std::clamp(target, size_t{1}, total_);
+        size_t cumulative = 0;
+        for (size_t i = 0; i < num_buckets; ++i) {
+            cumulative += counts_[i];
+            if (cumulative >= target) {
+                return std::min(highest_equivalent(i), max_);
+            }
+        }
+        return max_;
+    }
+
+    ///// Bucket calculations.
+    static size_t bucket_index(uint64_t value) {
+        if (value < 2 * sub_buckets) {
+            return value;
+        }
+        // Keep the `sub_bucket_bits + 1` most significant bits of `value`.
+        size_t shift = std::bit_width(value) - (sub_bucket_bits + 1);
+        size_t mantissa = value >> shift;
+        return (shift + 1) * sub_buckets + (mantissa - sub_buckets);
+    }
+
+    static uint64_t lowest_equivalent(size_t index) {
+        if (index < 2 * sub_buckets) {
+            return index;
+        }
+        size_t shift = index / sub_buckets - 1;
+        uint64_t mantissa = sub_buckets + index % sub_buckets;
+        return mantissa << shift;
+    }
+
+    static uint64_t highest_equivalent(size_t index) {
+        if (index + 1 == num_buckets) {
+            return std::numeric_limits<uint64_t>::max();
+        }
+        return lowest_equivalent(index + 1) - 1;
+    }
+
+  private:
+    std::vector<size_t> counts_;
+    size_t total_ = 0;
+    double sum_ = 0;
+    uint64_t min_ = std::numeric_limits<uint64_t>::max();
+    uint64_t max_ = 0;
+};
+
+} // namespace svsbenchmark
@@ -3,14 +3,21 @@
 // svs-benchmark
 #include "svs-benchmark/benchmark.h"
 #include "svs-benchmark/index_traits.h"
+#include "svs-benchmark/latency.h"
 
 // svs
 #include "svs/core/data.h"
 #include "svs/core/data/view.h"
+#include "svs/core/query_result.h"
 #include "svs/core/recall.h"
+#include "svs/lib/misc.h"
 #include "svs/lib/saveload.h"
+#include "svs/lib/timing.h"
 
 // stl
+#include <algorithm>
+#include <chrono>
+#include <optional>
 #include <vector>
 
 namespace svsbenchmark::search {
@@ -19,37 +26,202 @@ namespace svsbenchmark::search {
 ///// Classes
 /////
 
+///
+/// Configuration for measuring single-query latency.
+///
+/// Queries are issued in micro-batches of `batch_size` queries by a single client. A
+/// batch size of zero disables the measurement.
+///
+/// Concurrent clients are not supported: indexes run each search on their own thread
+/// pool and per-thread scratch space, so searches on the same index are serialized.
+///
+struct LatencyParameters {
+  public:
+    size_t batch_size_ = 0;
+
+  public:
+    LatencyParameters() = default;
+    explicit LatencyParameters(size_t batch_size)
+        : batch_size_{batch_size} {}
+
+    bool enabled() const { return batch_size_ != 0; }
+
+    // Saving and Loading
+    static constexpr svs::lib::Version save_version{0, 0, 0};
+    static constexpr std::string_view serialization_schema =
+        "benchmark_latency_parameters";
+    svs::lib::SaveTable save() const {
+        return svs::lib::SaveTable(
+            serialization_schema,
+            save_version,
+            {SVS_LIST_SAVE_(batch_size)}
+        );
+    }
+
+    static LatencyParameters load(const svs::lib::ContextFreeLoadTable& table) {
+        return LatencyParameters(SVS_LOAD_MEMBER_AT_(table, batch_size));
+    }
+};
+
 struct SearchParameters {
   public:
     size_t num_neighbors_;
     std::vector<double> target_recalls_;
+    LatencyParameters latency_;
 
   public:
-    SearchParameters(size_t num_neighbors, std::vector<double> target_recalls)
+    SearchParameters(
+        size_t num_neighbors,
+        std::vector<double> target_recalls,
+        LatencyParameters latency = {}
+    )
         : num_neighbors_{num_neighbors}
-        , target_recalls_{std::move(target_recalls)} {}
+        , target_recalls_{std::move(target_recalls)}
+        , latency_{latency} {}
 
-    static SearchParameters example() { return SearchParameters(10, {0.80, 0.85, 0.90}); }
+    static SearchParameters example() {
+        return SearchParameters(10, {0.80, 0.85, 0.90}, LatencyParameters(1));
+    }
 
     // Saving and Loading
-    static constexpr svs::lib::Version save_version{0, 0, 0};
+    // History
+    // * v0.0.0: Initial Version
+    // * v0.0.1: Added the `latency` sub-table. Older versions disable latency measurement.
+    static constexpr svs::lib::Version save_version{0, 0, 1};
     static constexpr std::string_view serialization_schema = "benchmark_search_parameters";
     svs::lib::SaveTable save() const {
         return svs::lib::SaveTable(
             serialization_schema,
             save_version,
-            {SVS_LIST_SAVE_(num_neighbors), SVS_LIST_SAVE_(target_recalls)}
+            {SVS_LIST_SAVE_(num_neighbors),
+             SVS_LIST_SAVE_(target_recalls),
+             SVS_LIST_SAVE_(latency)}
         );
     }
 
     static SearchParameters load(const svs::lib::ContextFreeLoadTable& table) {
+        auto latency = LatencyParameters();
+        if (table.contains("latency")) {
+            latency = SVS_LOAD_MEMBER_AT_(table, latency);
+        }
         return SearchParameters(
             SVS_LOAD_MEMBER_AT_(table, num_neighbors),
-            SVS_LOAD_MEMBER_AT_(table, target_recalls)
+            SVS_LOAD_MEMBER_AT_(table, target_recalls),
+            latency
         );
     }
 };
 
+///
+/// Per-query latency, throughput, and recall distribution for a single configuration.
+///
+struct LatencyReport {
+  public:
+    size_t batch_size_;
+    size_t num_queries_;
+    // Queries per second over the whole run.
+    double qps_;
+    // Latency statistics in microseconds.
+    double latency_mean_us_;
+    double latency_p50_us_;
+    double latency_p90_us_;
+    double latency_p99_us_;
+    double latency_p999_us_;
+    double latency_max_us_;
+    // Recall statistics.
+    // Low percentiles describe the worst performing queries.
+    double recall_mean_;
+    double recall_p1_;
+    double recall_p10_;
+    double recall_p50_;
+    // Entry `i` is the number of queries for which `i` of the true neighbors were found.
+    std::vector<size_t> recall_counts_;
+
+  public:
+    LatencyReport(
+        const LatencyParameters& parameters,
+        const LatencyHistogram& histogram,
+        double elapsed_seconds,
+        std::vector<size_t> recall_counts
+    )
+        : batch_size_{parameters.batch_size_}
+        , num_queries_{histogram.count()}
+        , qps_{static_cast<double>(histogram.count()) / elapsed_seconds}
+        , latency_mean_us_{histogram.mean() / 1000}
+        , latency_p50_us_{to_us(histogram.value_at_percentile(50))}
+        , latency_p90_us_{to_us(histogram.value_at_percentile(90))}
+        , latency_p99_us_{to_us(histogram.value_at_percentile(99))}
+        , latency_p999_us_{to_us(histogram.value_at_percentile(99.9))}
+        , latency_max_us_{to_us(histogram.max())}
+        , recall_mean_{recall_mean(recall_counts)}
+        , recall_p1_{recall_at_percentile(recall_counts, 1)}
+        , recall_p10_{recall_at_percentile(recall_counts, 10)}
+        , recall_p50_{recall_at_percentile(recall_counts, 50)}
+        , recall_counts_{std::move(recall_counts)} {}
+
+    // Saving
+    static constexpr svs::lib::Version save_version{0, 0, 0};
+    static constexpr std::string_view serialization_schema = "benchmark_latency_report";
+    svs::lib::SaveTable save() const {
+        return svs::lib::SaveTable(
+            serialization_schema,
+            save_version,
+            {
+                SVS_LIST_SAVE_(batch_size),
+                SVS_LIST_SAVE_(num_queries),
+                SVS_LIST_SAVE_(qps),
+                SVS_LIST_SAVE_(latency_mean_us),
+                SVS_LIST_SAVE_(latency_p50_us),
+                SVS_LIST_SAVE_(latency_p90_us),
+                SVS_LIST_SAVE_(latency_p99_us),
+                SVS_LIST_SAVE_(latency_p999_us),
+                SVS_LIST_SAVE_(latency_max_us),
+                SVS_LIST_SAVE_(recall_mean),
+                SVS_LIST_SAVE_(recall_p1),
+                SVS_LIST_SAVE_(recall_p10),
+                SVS_LIST_SAVE_(recall_p50),
+                SVS_LIST_SAVE_(recall_counts),
+            }
+        );
+    }
+
+    ///// Helpers
+    static double to_us(uint64_t nanoseconds) {
+        return static_cast<double>(nanoseconds) / 1000;
+    }
+
+    static double recall_mean(const std::vector<size_t>& counts) {
+        size_t k = counts.size() - 1;
+        size_t total = 0;
+        size_t found = 0;
+        for (size_t i = 0; i <= k; ++i) {
+            total += counts[i];
+            found += i * counts[i];
+        }
+        return total == 0 ? 0.0 : static_cast<double>(found) / (total * k);
+    }
+
+    // Return the smallest recall such that at least `p` percent of queries have a recall
+    // less than or equal to it.
+    static double recall_at_percentile(const std::vector<size_t>& counts, double p) {
+        size_t k = counts.size() - 1;
+        size_t total = 0;
+        for (auto c : counts) {
+            total += c;
+        }
+        auto target = static_cast<size_t>(std::ceil(p / 100 * static_cast<double>(total)));
+        target = std::max(target, size_t{1});
+        size_t cumulative = 0;
+        for (size_t i = 0; i <= k; ++i) {
+            cumulative += counts[i];
+            if (cumulative >= target) {
+                return static_cast<double>(i) / k;
+            }
+        }
+        return 1.0;
+    }
+};
+
 template <typename Index> struct RunReport {
   public:
     using config_type = svsbenchmark::config_type<Index>;
@@ -62,6 +234,8 @@ template <typename Index> struct RunReport {
     size_t num_queries_;
     size_t num_neighbors_;
     std::vector<double> latencies_;
+    // Per-query measurements if requested.
+    std::optional<LatencyReport> latency_;
 
   public:
     RunReport(
@@ -70,20 +244,25 @@ template <typename Index> struct RunReport {
         double recall,
         size_t num_queries,
         size_t num_neighbors,
-        std::vector<double> latencies
+        std::vector<double> latencies,
+        std::optional<LatencyReport> latency = std::nullopt
     )
         : config_{config}
         , state_{std::move(state)}
         , recall_{recall}
         , num_queries_{num_queries}
         , num_neighbors_{num_neighbors}
-        , latencies_{std::move(latencies)} {}
+        , latencies_{std::move(latencies)}
+        , latency_{std::move(latency)} {}
 
     // Saving
-    static constexpr svs::lib::Version save_version{0, 0, 0};
+    // History
+    // * v0.0.0: Initial Version
+    // * v0.0.1: Added the optional `latency` sub-table.
+    static constexpr svs::lib::Version save_version{0, 0, 1};
     static constexpr std::string_view serialization_schema = "benchmark_search_run_report";
     svs::lib::SaveTable save() const {
-        return svs::lib::SaveTable(
+        auto table = svs::lib::SaveTable(
             serialization_schema,
             save_version,
             {
@@ -95,6 +274,10 @@ template <typename Index> struct RunReport {
                 SVS_LIST_SAVE_(latencies),
             }
         );
+        if (latency_.has_value()) {
+            table.insert("latency", svs::lib::save(latency_.value()));
+        }
+        return table;
     }
 };
 
@@ -163,6 +346,72 @@ template <typename T, std::integral I> struct QuerySet {
     }
 };
 
+///
+/// Measure per-query latency by issuing micro-batches of queries one after another.
+///
+/// Every query in a micro-batch is assigned the latency of the whole micro-batch since
+/// that is when its result becomes available.
+///
+/// Search parameters are passed explicitly with each request rather than applied to the
+/// index so the index configuration is left unchanged.
+///
+template <typename Index, typename Queries, typename Groundtruth>
+LatencyReport measure_latency(
+    Index& index,
+    const svsbenchmark::config_type<Index>& config,
+    const Queries& queries,
+    const Groundtruth& groundtruth,
+    size_t num_neighbors,
+    const LatencyParameters& parameters
+) {
+    using query_type = typename Queries::element_type;
+    size_t num_queries = queries.size();
+    size_t batch_size = parameters.batch_size_;
+    if (num_neighbors == 0) {
+        throw ANNEXCEPTION("Latency measurements require at least one neighbor!");
+    }
+
+    auto results = svs::QueryResult<size_t>(num_queries, num_neighbors);
+    auto histogram = LatencyHistogram();
+    auto tic = svs::lib::now();
+    for (size_t first = 0; first < num_queries; first += batch_size) {
+        size_t count = std::min(batch_size, num_queries - first);
+        auto batch_queries = svs::data::ConstSimpleDataView<query_type>(
+            queries.get_datum(first).data(), count, queries.dimensions()
+        );
+        auto batch_results = svs::QueryResultView<size_t>(
+            svs::MatrixView<size_t>{
+                svs::make_dims(count, num_neighbors), &results.index(first, 0)},
+            svs::MatrixView<float>{
+                svs::make_dims(count, num_neighbors), &results.distance(first, 0)}
+        );
+
+        auto batch_tic = svs::lib::now();
+        index.search(batch_results, batch_queries, config);
+        auto batch_elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            svs::lib::now() - batch_tic
+        );
+        histogram.record(batch_elapsed.count(), count);
+    }
+    double elapsed = svs::lib::time_difference(tic);
+
+    // Per-query recall distribution.
+    auto recall_counts = std::vector<size_t>(num_neighbors + 1, 0);
+    const auto& gt = svs::recall_convert(groundtruth);
+    auto ids = svs::recall_convert(results);
+    for (size_t i = 0; i < num_queries; ++i) {
+        auto expected = gt.get_datum(i);
+        auto actual = ids.get_datum(i);
+        recall_counts.at(svs::lib::count_intersect(
+            expected.begin(),
+            expected.begin() + num_neighbors,
+            actual.begin(),
+            actual.begin() + num_neighbors
+        ))++;
+    }
+    return LatencyReport(parameters, histogram, elapsed, std::move(recall_counts));
+}
+
 template <
     typename Index,
     typename Queries,
@@ -173,7 +422,8 @@ RunReport<Index> search_with_config(
     const svsbenchmark::config_type<Index>& config,
     const Queries& queries,
     const Groundtruth& groundtruth,
-    size_t num_neighbors
+    size_t num_neighbors,
+    const LatencyParameters& latency_parameters = {}
 ) {
     using Traits = svsbenchmark::IndexTraits<Index>;
     auto latencies = std::vector<double>();
@@ -188,13 +438,21 @@ RunReport<Index> search_with_config(
         latencies.push_back(svs::lib::time_difference(tic));
     }
     double recall = svs::k_recall_at_n(groundtruth, results, num_neighbors, num_neighbors);
+
+    auto latency = std::optional<LatencyReport>();
+    if (latency_parameters.enabled()) {
+        latency = measure_latency(
+            index, config, queries, groundtruth, num_neighbors, latency_parameters
+        );
+    }
     return RunReport<Index>(
         config,
         Traits::report_state(index),
         recall,
         queries.size(),
         num_neighbors,
-        std::move(latencies)
+        std::move(latencies),
+        std::move(latency)
     );
 }
 
@@ -208,13 +466,14 @@ std::vector<RunReport<Index>> search_with_config(
     const std::vector<config_type<Index>>& configs,
     const Queries& queries,
     const Groundtruth& groundtruth,
-    size_t num_neighbors
+    size_t num_neighbors,
+    const LatencyParameters& latency_parameters = {}
 ) {
     auto reports = std::vector<RunReport<Index>>();
     for (const auto& config : configs) {
-        reports.push_back(
-            search_with_config(index, config, queries, groundtruth, num_neighbors)
-        );
+        reports.push_back(search_with_config(
+            index, config, queries, groundtruth, num_neighbors, latency_parameters
+        ));
     }
     return reports;
 }
@@ -266,7 +525,8 @@ std::vector<RunReport<Index>> tune_and_search(
             config,
             query_set.test_set_,
             query_set.test_set_groundtruth_,
-            num_neighbors
+            num_neighbors,
+            parameters.latency_
         ));
     }
     return reports;
@@ -329,7 +589,8 @@ std::vector<RunReport<Index>> tune_and_search_with_hint(
             config,
             query_set.test_set_,
             query_set.test_set_groundtruth_,
-            num_neighbors
+            num_neighbors,
+            parameters.latency_
         ));
     }
     return reports;
@@ -404,7 +665,8 @@ SearchReport<Job, Index, Mixin> run_search(
         job.get_search_configs(),
         query_set.test_set_,
         query_set.test_set_groundtruth_,
-        search_parameters.num_neighbors_
+        search_parameters.num_neighbors_,
+        search_parameters.latency_
     );
 
     auto target_recalls = search::tune_and_search(
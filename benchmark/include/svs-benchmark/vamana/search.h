@@ -8,11 +8,14 @@
 
 // svs
 #include "svs/core/distance.h"
+#include "svs/index/vamana/reorder.h"
 #include "svs/index/vamana/search_params.h"
 #include "svs/lib/dispatcher.h"
 
 // stl
 #include <memory>
+#include <optional>
+#include <string>
 
 namespace svsbenchmark::vamana {
 
@@ -75,6 +78,8 @@ struct SearchJob {
     size_t num_threads_;
     svsbenchmark::search::SearchParameters search_parameters_;
     std::vector<svs::index::vamana::VamanaSearchParameters> preset_parameters_;
+    // Optional vertex reordering applied to the index after loading.
+    std::optional<svs::index::vamana::GraphOrdering> reorder_;
 
   public:
     SearchJob(
@@ -92,7 +97,8 @@ struct SearchJob {
         Extent ndims,
         size_t num_threads,
         const svsbenchmark::search::SearchParameters& search_parameters,
-        std::vector<svs::index::vamana::VamanaSearchParameters> preset_parameters
+        std::vector<svs::index::vamana::VamanaSearchParameters> preset_parameters,
+        std::optional<svs::index::vamana::GraphOrdering> reorder = std::nullopt
     )
         : description_{std::move(description)}
         , dataset_{std::move(dataset)}
@@ -108,7 +114,8 @@ struct SearchJob {
         , ndims_{ndims}
         , num_threads_{num_threads}
         , search_parameters_{search_parameters}
-        , preset_parameters_{std::move(preset_parameters)} {}
+        , preset_parameters_{std::move(preset_parameters)}
+        , reorder_{reorder} {}
 
     // Return the benchmark search parameters
     const svsbenchmark::search::SearchParameters& get_search_parameters() const {
@@ -119,6 +126,14 @@ struct SearchJob {
     static std::nullopt_t get_build_parameters() { return std::nullopt; }
     svs::DistanceType get_distance() const { return distance_; }
 
+    // Apply the requested vertex reordering (if any) to the loaded index.
+    // Running the same job with and without reordering compares their throughput.
+    template <typename Index> void maybe_reorder(Index& index) const {
+        if (reorder_.has_value()) {
+            index.reorder(*reorder_);
+        }
+    }
+
     // Return the preset search configurations.
     const std::vector<svs::index::vamana::VamanaSearchParameters>&
     get_search_configs() const {
@@ -141,7 +156,8 @@ struct SearchJob {
             Extent{svs::Dynamic},                              // ndims
             4,                                                 // num_threads
             search::SearchParameters::example(),               // search_parameters
-            {{{10, 20}, false, 1, 1}, {{15, 15}, false, 1, 1}} // preset_parameters
+            {{{10, 20}, false, 1, 1}, {{15, 15}, false, 1, 1}}, // preset_parameters
+            svs::index::vamana::GraphOrdering::BreadthFirst     // reorder
         };
     }
 
@@ -151,8 +167,12 @@ struct SearchJob {
     }
 
     ///// Save/Load
-    static constexpr svs::lib::Version save_version{0, 0, 0};
+    // Version History
+    // - v0.0.1: Added the optional "reorder" field. Valid values are "none" and the names
+    //   of the `svs::index::vamana::GraphOrdering` alternatives.
+    static constexpr svs::lib::Version save_version{0, 0, 1};
     static constexpr std::string_view serialization_schema = "benchmark_vamana_search_job";
+    static constexpr std::string_view no_reorder = "none";
     svs::lib::SaveTable save() const {
         return svs::lib::SaveTable(
             serialization_schema,
@@ -171,14 +191,34 @@ struct SearchJob {
              SVS_LIST_SAVE_(ndims),
              SVS_LIST_SAVE_(num_threads),
              SVS_LIST_SAVE_(search_parameters),
-             SVS_LIST_SAVE_(preset_parameters)}
+             SVS_LIST_SAVE_(preset_parameters),
+             {"reorder",
+              svs::lib::save(std::string{
+                  reorder_.has_value() ? svs::index::vamana::name(*reorder_) : no_reorder
+              })}}
         );
     }
 
+    static bool
+    check_load_compatibility(std::string_view schema, const svs::lib::Version& version) {
+        return schema == serialization_schema && version <= save_version;
+    }
+
     static SearchJob load(
         const svs::lib::ContextFreeLoadTable& table,
         const std::optional<std::filesystem::path>& root = {}
     ) {
+        auto load_reorder = [&]() -> std::optional<svs::index::vamana::GraphOrdering> {
+            if (table.version() == svs::lib::Version{0, 0, 0}) {
+                return std::nullopt;
+            }
+            auto reorder = svs::lib::load_at<std::string>(table, "reorder");
+            if (reorder == no_reorder) {
+                return std::nullopt;
+            }
+            return svs::index::vamana::parse_graph_ordering(reorder);
+        };
+
         return SearchJob{
             SVS_LOAD_MEMBER_AT_(table, description),
             SVS_LOAD_MEMBER_AT_(table, dataset, root),
@@ -194,7 +234,8 @@ struct SearchJob {
             SVS_LOAD_MEMBER_AT_(table, ndims),
             SVS_LOAD_MEMBER_AT_(table, num_threads),
             SVS_LOAD_MEMBER_AT_(table, search_parameters),
-            SVS_LOAD_MEMBER_AT_(table, preset_parameters)};
+            SVS_LOAD_MEMBER_AT_(table, preset_parameters),
+            load_reorder()};
     }
 };
 
@@ -101,6 +101,7 @@ toml::table run_static_search(
         job.config_, svs::GraphLoader{job.graph_}, lazy, distance, job.num_threads_
     );
     double load_time = svs::lib::time_difference(tic);
+    job.maybe_reorder(index);
     auto queries = svs::data::SimpleData<Q>::load(job.queries_);
     auto groundtruth = svs::data::SimpleData<uint32_t>::load(job.groundtruth_);
     auto results = svsbenchmark::search::run_search(
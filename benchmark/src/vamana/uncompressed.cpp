@@ -52,6 +52,9 @@ template <typename F> void for_standard_search_specializations(F&& f) {
 
         X(float, svs::Float16, svs::distance::DistanceIP, svs::Dynamic);
         X(float, svs::Float16, svs::distance::DistanceL2, svs::Dynamic);
+
+        X(float, svs::BFloat16, svs::distance::DistanceIP, svs::Dynamic);
+        X(float, svs::BFloat16, svs::distance::DistanceL2, svs::Dynamic);
     } else {
         for_standard_specializations(SVS_FWD(f));
     }
@@ -80,6 +83,7 @@ toml::table run_static_search(
     );
 
     double load_time = svs::lib::time_difference(tic);
+    job.maybe_reorder(index);
     auto queries = svs::data::SimpleData<Q>::load(job.queries_);
     auto groundtruth = svs::data::SimpleData<uint32_t>::load(job.groundtruth_);
 
@@ -18,6 +18,8 @@
 
 #include <pybind11/numpy.h>
 
+#include <vector>
+
 // Implementation here is largely inspired by:
 //
 // https://github.com/pybind/pybind11/issues/1776#issuecomment-491514980W
@@ -184,6 +186,22 @@ pybind11::array_t<T, pybind11::array::c_style> numpy_vector(size_t s) {
         {svs::lib::narrow<pybind11::ssize_t>(s)}};
 }
 
+///
+/// Create a 1-dimensional Numpy array taking ownership of the contents of `v`.
+///
+/// The vector is moved to the heap and released when the array is garbage collected,
+/// so no copy of the underlying data is made.
+///
+template <typename T>
+pybind11::array_t<T, pybind11::array::c_style> numpy_vector(std::vector<T>&& v) {
+    auto* owner = new std::vector<T>(std::move(v));
+    auto capsule = pybind11::capsule(owner, [](void* ptr) {
+        delete static_cast<std::vector<T>*>(ptr);
+    });
+    return pybind11::array_t<T, pybind11::array::c_style>{
+        {svs::lib::narrow<pybind11::ssize_t>(owner->size())}, owner->data(), capsule};
+}
+
 ///
 /// Create a 2-dimensional Numpy array with dimensions `(s0, s1)`.
 ///
@@ -204,10 +222,14 @@ create_data(const pybind11::array_t<T, pybind11::array::c_style>& data) {
     return dst;
 }
 
+///
+/// Construct a `BlockedData` object from a view.
+///
+/// Does not touch any Python objects and may be called with the GIL released.
+///
 template <typename T, size_t Extent = Dynamic>
 svs::data::BlockedData<T, Extent, RebindAllocator<T>>
-create_blocked_data(const pybind11::array_t<T, pybind11::array::c_style>& py_data) {
-    auto src = data_view(py_data);
+create_blocked_data(svs::data::ConstSimpleDataView<T> src) {
     if constexpr (Extent != Dynamic) {
         if (Extent != src.dimensions()) {
             throw ANNEXCEPTION(
@@ -225,6 +247,12 @@ create_blocked_data(const pybind11::array_t<T, pybind11::array::c_style>& py_dat
     return dst;
 }
 
+template <typename T, size_t Extent = Dynamic>
+svs::data::BlockedData<T, Extent, RebindAllocator<T>>
+create_blocked_data(const pybind11::array_t<T, pybind11::array::c_style>& py_data) {
+    return create_blocked_data<T, Extent>(data_view(py_data));
+}
+
 namespace detail {
 template <typename F, typename T>
 using and_then_return_t = std::remove_cvref_t<std::invoke_result_t<F, T>>;
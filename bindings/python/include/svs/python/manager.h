@@ -23,35 +23,142 @@
 
 // stdlib
 #include <concepts>
+#include <vector>
 
 namespace svs::python {
+
+// Convert an optional boolean mask of allowed IDs into a search filter.
+// A vector is shared by all queries while a matrix holds one row per query.
+inline svs::SearchFilter
+make_search_filter(const pybind11::object& filter, size_t n_queries) {
+    if (filter.is_none()) {
+        return svs::SearchFilter();
+    }
+    using mask_type =
+        pybind11::array_t<bool, pybind11::array::c_style | pybind11::array::forcecast>;
+    auto mask = mask_type::ensure(filter);
+    if (!mask) {
+        throw ANNEXCEPTION("Filter must be convertible to a boolean numpy array!");
+    }
+
+    auto to_bitset = [](const bool* allowed, size_t size) {
+        auto bitset = svs::BitSet(size);
+        for (size_t i = 0; i < size; ++i) {
+            if (allowed[i]) {
+                bitset.set(i);
+            }
+        }
+        return bitset;
+    };
+
+    if (mask.ndim() == 1) {
+        return svs::SearchFilter(to_bitset(mask.data(), mask.shape(0)));
+    }
+    if (mask.ndim() != 2) {
+        throw ANNEXCEPTION("Filter must be a vector or a matrix!");
+    }
+    if (svs::lib::narrow<size_t>(mask.shape(0)) != n_queries) {
+        throw ANNEXCEPTION(
+            "Filter has {} rows but {} queries were given!", mask.shape(0), n_queries
+        );
+    }
+    auto bitsets = std::vector<svs::BitSet>();
+    for (size_t i = 0; i < n_queries; ++i) {
+        bitsets.push_back(to_bitset(mask.data(i, 0), mask.shape(1)));
+    }
+    return svs::SearchFilter(std::move(bitsets));
+}
+
 template <typename QueryType, typename Manager>
 pybind11::tuple py_search(
     Manager& self,
     pybind11::array_t<QueryType, pybind11::array::c_style> queries,
-    size_t n_neighbors
+    size_t n_neighbors,
+    const pybind11::object& filter
 ) {
     const auto query_data = data_view(queries, allow_vectors);
     size_t n_queries = query_data.size();
+    auto search_filter = make_search_filter(filter, n_queries);
     auto result_idx = numpy_matrix<size_t>(n_queries, n_neighbors);
     auto result_dists = numpy_matrix<float>(n_queries, n_neighbors);
     svs::QueryResultView<size_t> q_result(
         matrix_view(result_idx), matrix_view(result_dists)
     );
 
-    svs::index::search_batch_into(self, q_result, query_data.cview());
+    {
+        // The queries and results are borrowed from numpy arrays kept alive by the caller.
+        pybind11::gil_scoped_release release;
+        svs::index::search_batch_into(self, q_result, query_data.cview(), search_filter);
+    }
     return pybind11::make_tuple(result_idx, result_dists);
 }
 
+template <typename QueryType, typename Manager>
+void py_search_into(
+    Manager& self,
+    pybind11::array_t<QueryType, pybind11::array::c_style> queries,
+    pybind11::array_t<size_t, pybind11::array::c_style> result_idx,
+    pybind11::array_t<float, pybind11::array::c_style> result_dists,
+    const pybind11::object& filter
+) {
+    const auto query_data = data_view(queries, allow_vectors);
+    size_t n_queries = query_data.size();
+    if (result_idx.ndim() != 2 || result_dists.ndim() != 2) {
+        throw ANNEXCEPTION("Output arrays must be matrices!");
+    }
+    if (result_idx.shape(0) != result_dists.shape(0) ||
+        result_idx.shape(1) != result_dists.shape(1)) {
+        throw ANNEXCEPTION("Output arrays for IDs and distances must have the same shape!");
+    }
+    if (svs::lib::narrow<size_t>(result_idx.shape(0)) != n_queries) {
+        throw ANNEXCEPTION(
+            "Output arrays have {} rows but {} queries were given!",
+            result_idx.shape(0),
+            n_queries
+        );
+    }
+
+    auto search_filter = make_search_filter(filter, n_queries);
+    svs::QueryResultView<size_t> q_result(
+        matrix_view(result_idx), matrix_view(result_dists)
+    );
+    pybind11::gil_scoped_release release;
+    svs::index::search_batch_into(self, q_result, query_data.cview(), search_filter);
+}
+
+template <typename QueryType, typename Manager>
+pybind11::tuple py_range_search(
+    Manager& self,
+    pybind11::array_t<QueryType, pybind11::array::c_style> queries,
+    float radius
+) {
+    const auto query_data = data_view(queries, allow_vectors);
+    auto result = svs::RangeSearchResult<size_t>{};
+    {
+        pybind11::gil_scoped_release release;
+        result = self.range_search(query_data, radius);
+    }
+    // Hand the result buffers to numpy without copying.
+    return pybind11::make_tuple(
+        numpy_vector(std::move(result.offsets())),
+        numpy_vector(std::move(result.indices())),
+        numpy_vector(std::move(result.distances()))
+    );
+}
+
 template <typename QueryType, typename Manager>
 void add_search_specialization(pybind11::class_<Manager>& py_manager) {
     py_manager.def(
         "search",
         [](Manager& self,
            pybind11::array_t<QueryType, pybind11::array::c_style> queries,
-           size_t n_neighbors) { return py_search<QueryType>(self, queries, n_neighbors); },
+           size_t n_neighbors,
+           const pybind11::object& filter) {
+            return py_search<QueryType>(self, queries, n_neighbors, filter);
+        },
         pybind11::arg("queries"),
         pybind11::arg("n_neighbors"),
+        pybind11::arg("filter") = pybind11::none(),
         R"(
 Perform a search to return the `n_neighbors` approximate nearest neighbors to the query.
 
@@ -65,14 +172,79 @@ Args:
 
     n_neighbors: The number of neighbors to return for this search job.
 
+    filter: Optional boolean Numpy array of allowed IDs. Entry `i` marks ID `i` as allowed.
+        A vector is shared by all queries while a matrix holds one row per query.
+        Other IDs are never returned. For dynamic indexes, IDs are the external IDs.
+
 Returns:
     A tuple `(I, D)` where `I` contains the `n_neighbors` approximate (or exact) nearest
     neighbors to the queries and `D` contains the approximate distances.
 
+    If fewer than `n_neighbors` allowed neighbors are found for a query, the remaining
+    entries of its row hold the maximum `numpy.uint64` ID with the worst distance.
+
     Note: This form is returned regardless of whether the given query was a vector or a
     matrix.
         )"
     );
+
+    py_manager.def(
+        "search_into",
+        [](Manager& self,
+           pybind11::array_t<QueryType, pybind11::array::c_style> queries,
+           pybind11::array_t<size_t, pybind11::array::c_style> ids,
+           pybind11::array_t<float, pybind11::array::c_style> distances,
+           const pybind11::object& filter) {
+            py_search_into<QueryType>(self, queries, ids, distances, filter);
+        },
+        pybind11::arg("queries"),
+        // Converting the outputs would write the results into a temporary copy.
+        pybind11::arg("ids").noconvert(),
+        pybind11::arg("distances").noconvert(),
+        pybind11::arg("filter") = pybind11::none(),
+        R"(
+Perform a search, writing the approximate nearest neighbors into caller-provided arrays.
+
+Args:
+    queries: Numpy Vector or Matrix representing the queries with the same conventions as
+        `search`.
+    ids: C-contiguous `numpy.uint64` matrix receiving the neighbor IDs. Must have one row
+        per query. The number of columns determines the number of neighbors returned.
+    distances: C-contiguous `numpy.float32` matrix receiving the distances. Must have the
+        same shape as `ids`.
+    filter: Optional boolean Numpy array of allowed IDs with the same conventions as
+        `search`.
+
+Reusing the output arrays across calls avoids allocating new results for every batch.
+        )"
+    );
+
+    py_manager.def(
+        "range_search",
+        [](Manager& self,
+           pybind11::array_t<QueryType, pybind11::array::c_style> queries,
+           float radius) { return py_range_search<QueryType>(self, queries, radius); },
+        pybind11::arg("queries"),
+        pybind11::arg("radius"),
+        R"(
+Return all indexed vectors within `radius` of each query.
+
+Args:
+    queries: Numpy Vector or Matrix representing the queries with the same conventions as
+        `search`.
+    radius: The search radius. A vector is returned if its distance to the query is at
+        least as good as `radius`. For similarity measures like inner product, this means
+        the similarity must be greater than or equal to `radius`.
+
+Returns:
+    A tuple `(offsets, I, D)` in compressed sparse row form. The neighbors of query `i` are
+    `I[offsets[i]:offsets[i + 1]]` with distances `D[offsets[i]:offsets[i + 1]]`, ordered
+    from nearest to furthest. `offsets` has one more entry than the number of queries.
+
+Raises:
+    RuntimeError: If the index does not support range search.
+        )"
+    );
 }
 
 template <typename Manager>
@@ -111,10 +283,14 @@ reconstruct(Index& index, py_contiguous_array_t<uint64_t> ids) {
     // Create a flat buffer for the destination.
     // We will reshape is appropriately before returning.
     auto destination = py_contiguous_array_t<float>({num_ids, data_dims});
-    index.reconstruct_at(
-        mutable_data_view(destination),
-        std::span<const uint64_t>(ids.template mutable_unchecked().mutable_data(), num_ids)
-    );
+    {
+        auto ids_span = std::span<const uint64_t>(
+            ids.template mutable_unchecked().mutable_data(), num_ids
+        );
+        auto destination_view = mutable_data_view(destination);
+        pybind11::gil_scoped_release release;
+        index.reconstruct_at(destination_view, ids_span);
+    }
 
     // Reshape the destination to have the same shape as the original IDs (plus the extra
     // dimension for the data vectors themselves.
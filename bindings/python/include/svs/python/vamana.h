@@ -75,6 +75,9 @@ template <typename F> void for_standard_specializations(F&& f) {
     using float16xfloat = svs::lib::Types<svs::Float16, float>;
     X (float16xfloat, svs::Float16, Dynamic, EnableBuild::FromFileAndArray);
 
+    // NumPy has no bfloat16 type, so only building from file is possible.
+    X (float,   svs::BFloat16, Dynamic, EnableBuild::FromFile);
+
     // XN(uint8_t, uint8_t,      128); // BigANN 1B
     X (uint8_t, uint8_t,      Dynamic, EnableBuild::FromFileAndArray);
 
@@ -192,9 +195,12 @@ void add_experimental_calibration(pybind11::class_<Manager>& py_manager) {
            size_t num_neighbors,
            double target_recall,
            const svs::index::vamana::CalibrationParameters& calibration_parameters) {
+            auto queries_view = data_view(queries);
+            auto groundtruth_view = data_view(groundtruth);
+            pybind11::gil_scoped_release release;
             return self.experimental_calibrate(
-                data_view(queries),
-                data_view(groundtruth),
+                queries_view,
+                groundtruth_view,
                 num_neighbors,
                 target_recall,
                 calibration_parameters
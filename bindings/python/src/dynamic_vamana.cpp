@@ -49,14 +49,14 @@ svs::DynamicVamana build_from_array(
     svs::DistanceType distance_type,
     size_t num_threads
 ) {
+    auto data = data_view(py_data);
+    auto ids = std::span(py_ids.data(), py_ids.size());
+
+    py::gil_scoped_release release;
     auto dispatcher = svs::DistanceDispatcher(distance_type);
     return dispatcher([&](auto distance) {
         return svs::DynamicVamana::build<ElementType>(
-            parameters,
-            create_blocked_data(py_data),
-            std::span(py_ids.data(), py_ids.size()),
-            distance,
-            num_threads
+            parameters, create_blocked_data(data), ids, distance, num_threads
         );
     });
 }
@@ -103,7 +103,11 @@ void add_points(
             "Expected IDs to be the same length as the number of rows in points!"
         );
     }
-    index.add_points(data_view(py_data), std::span(ids.data(), ids.size()));
+    auto points = data_view(py_data);
+    auto ids_span = std::span(ids.data(), ids.size());
+
+    py::gil_scoped_release release;
+    index.add_points(points, ids_span);
 }
 
 const char* ADD_POINTS_DOCSTRING = R"(
@@ -256,6 +260,7 @@ svs::DynamicVamana assemble(
     size_t num_threads,
     bool debug_load_from_static
 ) {
+    py::gil_scoped_release release;
     auto dispatcher = svs::lib::Dispatcher<
         svs::DynamicVamana,
         const std::filesystem::path&,
@@ -306,8 +311,18 @@ void wrap(py::module& m) {
         "Read/Write (int): Get/set the window size used when adding and deleting points."
     );
 
-    vamana.def("consolidate", &svs::DynamicVamana::consolidate, CONSOLIDATE_DOCSTRING);
-    vamana.def("compact", &svs::DynamicVamana::compact, COMPACT_DOCSTRING);
+    vamana.def(
+        "consolidate",
+        &svs::DynamicVamana::consolidate,
+        py::call_guard<py::gil_scoped_release>(),
+        CONSOLIDATE_DOCSTRING
+    );
+    vamana.def(
+        "compact",
+        &svs::DynamicVamana::compact,
+        py::call_guard<py::gil_scoped_release>(),
+        COMPACT_DOCSTRING
+    );
 
     // Reloading
     vamana.def(
@@ -335,7 +350,9 @@ void wrap(py::module& m) {
     vamana.def(
         "delete",
         [](svs::DynamicVamana& index, const py_contiguous_array_t<size_t>& ids) {
-            index.delete_points(as_span(ids));
+            auto ids_span = as_span(ids);
+            py::gil_scoped_release release;
+            index.delete_points(ids_span);
         },
         py::arg("ids"),
         DELETE_DOCSTRING
@@ -365,6 +382,7 @@ void wrap(py::module& m) {
     vamana.def(
         "save",
         &save_index,
+        py::call_guard<py::gil_scoped_release>(),
         py::arg("config_directory"),
         py::arg("graph_directory"),
         py::arg("data_directory"),
@@ -43,10 +43,11 @@ template <typename F> void for_standard_specializations(F&& f) {
     // Pattern:
     // QueryType, DataType, Dimensionality, Enable Building
     // clang-format off
-    X(float,   float,        Dynamic);
-    X(float,   svs::Float16, Dynamic);
-    X(uint8_t, uint8_t,      Dynamic);
-    X(int8_t,  int8_t,       Dynamic);
+    X(float,   float,         Dynamic);
+    X(float,   svs::Float16,  Dynamic);
+    X(float,   svs::BFloat16, Dynamic);
+    X(uint8_t, uint8_t,       Dynamic);
+    X(int8_t,  int8_t,        Dynamic);
     // clang-format on
 #undef X
 }
@@ -115,6 +116,7 @@ svs::Flat assemble(
     svs::DataType SVS_UNUSED(query_type),
     size_t n_threads
 ) {
+    py::gil_scoped_release release;
     return assembly_dispatcher().invoke(std::move(source), distance_type, n_threads);
 }
 
@@ -150,9 +152,9 @@ void add_assemble_specialization(py::class_<svs::Flat>& flat) {
         py::init([](py_contiguous_array_t<ElementType> py_data,
                     svs::DistanceType distance_type,
                     size_t num_threads) {
-            return assemble_from_array(
-                AnonymousVectorData(py_data), distance_type, num_threads
-            );
+            auto data = AnonymousVectorData(py_data);
+            py::gil_scoped_release release;
+            return assemble_from_array(data, distance_type, num_threads);
         }),
         py::arg("data"),
         py::arg("distance"),
@@ -20,11 +20,14 @@
 #include "svs/python/vamana.h"
 
 // SVS dependencies
+#include "svs/core/data.h"
 #include "svs/core/distance.h"
 #include "svs/core/io.h"
 #include "svs/lib/array.h"
+#include "svs/lib/bfloat16.h"
 #include "svs/lib/datatype.h"
 #include "svs/lib/float16.h"
+#include "svs/lib/threads.h"
 #include "svs/third-party/toml.h"
 
 // fmt
@@ -64,6 +67,17 @@ void convert_fvecs_to_float16(
     }
 }
 
+// Convert fvecs to bfloat16
+void convert_fvecs_to_bfloat16(
+    const std::string& filename_f32, const std::string& filename_bf16
+) {
+    auto reader = svs::io::vecs::VecsReader<float>{filename_f32};
+    auto writer = svs::io::vecs::VecsWriter<svs::BFloat16>{filename_bf16, reader.ndims()};
+    for (auto i : reader) {
+        writer << i;
+    }
+}
+
 // Convert fvecs to svs - typed
 template <typename Eltype>
 void convert_vecs_to_svs_impl(const std::string& vecs_file, const std::string& svs_file) {
@@ -75,7 +89,7 @@ void convert_vecs_to_svs_impl(const std::string& vecs_file, const std::string& s
 }
 
 const auto SUPPORTED_VECS_CONVERSION_TYPES =
-    svs::lib::Types<float, svs::Float16, uint32_t, uint8_t>();
+    svs::lib::Types<float, svs::Float16, svs::BFloat16, uint32_t, uint8_t>();
 // Convert fvecs to svs - dynamic dispatch.
 void convert_vecs_to_svs(
     const std::string& vecs_file, const std::string& svs_file, svs::DataType dtype
@@ -86,6 +100,32 @@ void convert_vecs_to_svs(
     });
 }
 
+// Read a vecs file into a numpy matrix - typed.
+template <typename Eltype>
+py::array_t<Eltype, py::array::c_style>
+read_vecs_impl(const std::string& vecs_file, size_t num_threads) {
+    auto file = svs::io::vecs::VecsFile(vecs_file);
+    auto [num_vectors, dimensions] = file.get_dims(sizeof(Eltype));
+    auto result = svs::python::numpy_matrix<Eltype>(num_vectors, dimensions);
+    auto view = svs::python::mutable_data_view(result);
+    {
+        py::gil_scoped_release release;
+        auto threadpool = svs::threads::NativeThreadPool(num_threads);
+        svs::io::parallel_populate(view, file, svs::lib::Type<Eltype>(), threadpool);
+    }
+    return result;
+}
+
+const auto SUPPORTED_VECS_READ_TYPES = svs::lib::Types<float, uint32_t, uint8_t>();
+// Read a vecs file into a numpy matrix - dynamic dispatch.
+py::object
+read_vecs(const std::string& vecs_file, svs::DataType dtype, size_t num_threads) {
+    return svs::lib::match(SUPPORTED_VECS_READ_TYPES, dtype, [&](auto type) {
+        using T = typename decltype(type)::type;
+        return py::object(read_vecs_impl<T>(vecs_file, num_threads));
+    });
+}
+
 void wrap_conversion(py::module& m) {
     auto supported_types = std::vector<svs::DataType>();
     svs::lib::for_each_type(SUPPORTED_VECS_CONVERSION_TYPES, [&](auto type) {
@@ -115,6 +155,19 @@ File extension type map:
         py::arg("dtype") = svs::DataType::float32,
         fmt::format(docstring_proto, svs::lib::format(supported_types)).c_str()
     );
+
+    m.def(
+        "_read_vecs",
+        &read_vecs,
+        py::arg("vecs_file"),
+        py::arg("dtype"),
+        py::arg("num_threads") = 1,
+        R"(
+Read the vecs file with the given element type into a numpy matrix, splitting the file into
+chunks read and converted by ``num_threads`` threads. Use ``svs.read_vecs`` instead, which
+deduces the element type from the file extension.
+)"
+    );
 }
 
 /// Overrides the `__name__` of a module.  Classes defined by pybind11 use the
@@ -172,6 +225,7 @@ PYBIND11_MODULE(SVS_MODULE_NAME, m) {
         .value("float16", svs::DataType::float16, "16-bit IEEE floating point.")
         .value("float32", svs::DataType::float32, "32-bit IEEE floating point.")
         .value("float64", svs::DataType::float64, "64-bit IEEE floating point.")
+        .value("bfloat16", svs::DataType::bfloat16, "16-bit brain floating point.")
         .export_values();
 
     // Helper Functions
@@ -184,6 +238,25 @@ PYBIND11_MODULE(SVS_MODULE_NAME, m) {
 Convert the `fvecs` file on disk with 32-bit floating point entries to a `fvecs` file with
 16-bit floating point entries.
 
+Args:
+    source_file: The source file path to convert.
+    destination_file: The destination file to generate.
+        )"
+    );
+
+    m.def(
+        "convert_fvecs_to_bfloat16",
+        &convert_fvecs_to_bfloat16,
+        py::arg("source_file"),
+        py::arg("destination_file"),
+        R"(
+Convert the `fvecs` file on disk with 32-bit floating point entries to a `vecs` file with
+16-bit brain floating point (bfloat16) entries. Values are rounded to the nearest
+representable bfloat16.
+
+The result can be converted to the native format with ``convert_vecs_to_svs`` using
+``svs.DataType.bfloat16``.
+
 Args:
     source_file: The source file path to convert.
     destination_file: The destination file to generate.
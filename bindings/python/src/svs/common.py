@@ -70,7 +70,7 @@ def read_npy(filename: str):
     X = np.load(filename)
     return np.ascontiguousarray(X)
 
-def read_vecs(filename: str):
+def read_vecs(filename: str, num_threads: int = 1):
     """
     Read a file in the `bvecs/fvecs/ivecs` format and return a NumPy array with the results.
 
@@ -83,6 +83,8 @@ def read_vecs(filename: str):
 
     Args:
         filename: The file to read.
+        num_threads: The number of threads used to read the file. Each thread reads a
+            separate chunk of the file.
 
     Returns:
         Numpy array with the results.
@@ -91,29 +93,14 @@ def read_vecs(filename: str):
     file_type = filename[-5:]
     if file_type == 'bvecs':
         dtype = np.uint8
-        struct_format = 'B'
-        n_bytes = 1
-        padding = 4
     elif file_type == 'fvecs':
         dtype = np.float32
-        struct_format = 'f'
-        n_bytes = 4
-        padding = 1
     elif file_type == 'ivecs':
         dtype = np.uint32
-        struct_format = 'i'
-        n_bytes = 4
-        padding = 1
     else:
         raise ValueError('Can only open bvecs, fvecs, and ivecs.')
 
-    with open(filename, 'rb') as fin:
-        vec_size = struct.unpack('i', fin.read(4))[0]
-
-    X = np.fromfile(filename, dtype=dtype)
-    X = X.reshape((-1, vec_size + padding))
-    X = X[:, padding:]
-    return np.ascontiguousarray(X)
+    return lib._read_vecs(filename, np_to_svs(dtype), num_threads)
 
 def read_svs(filename: str, dtype = np.float32):
     """
@@ -282,6 +282,7 @@ svs::Vamana assemble(
     bool SVS_UNUSED(enforce_dims),
     size_t num_threads
 ) {
+    py::gil_scoped_release release;
     return assembly_dispatcher().invoke(
         config_path, graph_file, std::move(data_kind), distance_type, num_threads
     );
@@ -307,6 +308,7 @@ svs::Vamana build_from_file(
     svs::DistanceType distance_type,
     size_t num_threads
 ) {
+    py::gil_scoped_release release;
     return build_from_file_dispatcher().invoke(
         parameters, std::move(data_source), distance_type, num_threads
     );
@@ -355,9 +357,9 @@ void add_build_specialization(py::class_<svs::Vamana>& vamana) {
            py_contiguous_array_t<ElementType> py_data,
            svs::DistanceType distance_type,
            size_t num_threads) {
-            return build_from_array(
-                parameters, AnonymousVectorData(py_data), distance_type, num_threads
-            );
+            auto data = AnonymousVectorData(py_data);
+            py::gil_scoped_release release;
+            return build_from_array(parameters, data, distance_type, num_threads);
         },
         py::arg("parameters"),
         py::arg("py_data"),
@@ -522,7 +524,10 @@ void wrap(py::module& m) {
                         size_t window_size,
                         size_t max_candidate_pool_size,
                         size_t prune_to,
-                        size_t num_threads) {
+                        size_t num_threads,
+                        size_t num_entry_points,
+                        bool use_exact_visited_set,
+                        bool use_vectorized_search_buffer) {
                 if (num_threads != std::numeric_limits<size_t>::max()) {
                     PyErr_WarnEx(
                         PyExc_DeprecationWarning,
@@ -548,7 +553,10 @@ void wrap(py::module& m) {
                     window_size,
                     max_candidate_pool_size,
                     prune_to,
-                    true};
+                    true,
+                    num_entry_points,
+                    use_exact_visited_set,
+                    use_vectorized_search_buffer};
             }),
             py::arg("alpha") = 1.2,
             py::arg("graph_max_degree") = 32,
@@ -556,6 +564,9 @@ void wrap(py::module& m) {
             py::arg("max_candidate_pool_size") = 80,
             py::arg("prune_to") = std::numeric_limits<size_t>::max(),
             py::arg("num_threads") = std::numeric_limits<size_t>::max(),
+            py::arg("num_entry_points") = 1,
+            py::arg("use_exact_visited_set") = false,
+            py::arg("use_vectorized_search_buffer") = false,
             R"(
             Construct a new instance from keyword arguments.
 
@@ -576,6 +587,17 @@ void wrap(py::module& m) {
                     target max degree. In general, setting this to slightly less than
                     `graph_max_degree` will yield faster index building times. Default:
                     `graph_max_degree`.
+                num_entry_points: The total number of entry points available to search.
+                    Values greater than one add entry points near the k-means centroids of
+                    the dataset, which can shorten searches over skewed or multi-modal
+                    datasets. Default: 1.
+                use_exact_visited_set: Track the candidates visited by construction
+                    searches exactly rather than with a lossy filter. Avoids repeated
+                    distance computations for large window sizes at the cost of memory
+                    proportional to the dataset size per thread. Default: False.
+                use_vectorized_search_buffer: Use the experimental structure-of-arrays
+                    search buffer with SIMD insertion for construction searches. The
+                    resulting graph is unchanged. Default: False.
             )"
         )
         .def_readwrite("alpha", &svs::index::vamana::VamanaBuildParameters::alpha)
@@ -588,6 +610,17 @@ void wrap(py::module& m) {
         .def_readwrite(
             "max_candidate_pool_size",
             &svs::index::vamana::VamanaBuildParameters::max_candidate_pool_size
+        )
+        .def_readwrite(
+            "num_entry_points", &svs::index::vamana::VamanaBuildParameters::num_entry_points
+        )
+        .def_readwrite(
+            "use_exact_visited_set",
+            &svs::index::vamana::VamanaBuildParameters::use_exact_visited_set
+        )
+        .def_readwrite(
+            "use_vectorized_search_buffer",
+            &svs::index::vamana::VamanaBuildParameters::use_vectorized_search_buffer
         );
 
     ///
@@ -632,6 +665,7 @@ void wrap(py::module& m) {
     vamana.def(
         "save",
         &detail::save_index,
+        py::call_guard<py::gil_scoped_release>(),
         py::arg("config_directory"),
         py::arg("graph_directory"),
         py::arg("data_directory"),
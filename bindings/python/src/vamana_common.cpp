@@ -40,8 +40,15 @@ std::string stringify_search_params(const svs::index::vamana::VamanaSearchParame
     auto fields = std::vector<std::string>(
         {fmt::format("buffer_config = {}", stringify_config(c.buffer_config_)),
          fmt::format("search_buffer_visited_set = {}", c.search_buffer_visited_set_),
+         fmt::format(
+             "search_buffer_exact_visited_set = {}", c.search_buffer_exact_visited_set_
+         ),
          fmt::format("prefetch_lookahead = {}", c.prefetch_lookahead_),
-         fmt::format("prefetch_step = {}", c.prefetch_step_)}
+         fmt::format("prefetch_step = {}", c.prefetch_step_),
+         fmt::format("rerank_depth = {}", c.rerank_depth_),
+         fmt::format("interleave = {}", c.interleave_),
+         fmt::format("early_termination_patience = {}", c.early_termination_patience_),
+         fmt::format("early_termination_ratio = {}", c.early_termination_ratio_)}
     );
 
     return fmt::format("VamanaSearchParameters({})", fmt::join(fields, ", "));
@@ -59,6 +66,12 @@ std::string stringify_calibration_params(const svs::index::vamana::CalibrationPa
          fmt::format("    prefetch_steps = [{}]", fmt::join(c.prefetch_steps_, ", ")),
          fmt::format("    search_buffer_optimization = {}", c.search_buffer_optimization_),
          fmt::format("    train_prefetchers = {}", c.train_prefetchers_),
+         fmt::format("    train_rerank_depth = {}", c.train_rerank_depth_),
+         fmt::format(
+             "    early_termination_patience = [{}]",
+             fmt::join(c.early_termination_patience_, ", ")
+         ),
+         fmt::format("    train_early_termination = {}", c.train_early_termination_),
          fmt::format(
              "    use_existing_parameter_values = {}", c.use_existing_parameter_values_
          )}
@@ -130,6 +143,23 @@ Attributes:
     prefetch_step (unsigned int, read/write): The maximum number of iterations to prefetch
         at a time until the desired `prefetch_lookahead` is achieved. Setting this to 1
         is special and has the same effect setting this to `prefetch_lookahead + 1`.
+    rerank_depth (unsigned int, read/write): The number of candidates refined by datasets
+        that rerank search results (such as two-level LVQ). Setting this to zero reranks
+        the entire search buffer. Search never reranks fewer candidates than the number
+        of requested neighbors.
+    interleave (unsigned int, read/write): The number of queries each thread traverses
+        concurrently during batch search. Values greater than one hide memory latency for
+        large indices without changing the results. Ignored by datasets that rerank.
+    early_termination_patience (unsigned int, read/write): Stop a graph search after this
+        many consecutive candidate expansions fail to improve the current nearest
+        neighbors. Zero (the default) disables this condition.
+    early_termination_ratio (float, read/write): Stop a graph search once the best
+        unexpanded candidate is further away than this factor times the distance to the
+        furthest current nearest neighbor. Values less than one (the default is zero)
+        disable this condition.
+    search_buffer_exact_visited_set (bool, read/write): Use an exact visited set when the
+        visited set is enabled. The exact set never recomputes distances but uses memory
+        proportional to the number of indexed vectors for each search thread.
 
 Setting either ``prefetch_lookahead``  or ``prefetch_step`` to zero disables candidate
 prefetching during search.
@@ -138,11 +168,25 @@ prefetching during search.
     // N.B.: Keep defaults the same as the C++ class
     params
         .def(
-            py::init<svs::index::vamana::SearchBufferConfig, bool, size_t, size_t>(),
+            py::init<
+                svs::index::vamana::SearchBufferConfig,
+                bool,
+                size_t,
+                size_t,
+                size_t,
+                size_t,
+                size_t,
+                float,
+                bool>(),
             py::arg("buffer_config") = svs::index::vamana::SearchBufferConfig(),
             py::arg("search_buffer_visited_set") = false,
             py::arg("prefetch_lookahead") = 4,
-            py::arg("prefetch_step") = 1
+            py::arg("prefetch_step") = 1,
+            py::arg("rerank_depth") = 0,
+            py::arg("interleave") = 1,
+            py::arg("early_termination_patience") = 0,
+            py::arg("early_termination_ratio") = 0.0f,
+            py::arg("search_buffer_exact_visited_set") = false
         )
         .def_readwrite("buffer_config", &VamanaSearchParameters::buffer_config_)
         .def_readwrite(
@@ -150,6 +194,19 @@ prefetching during search.
         )
         .def_readwrite("prefetch_lookahead", &VamanaSearchParameters::prefetch_lookahead_)
         .def_readwrite("prefetch_step", &VamanaSearchParameters::prefetch_step_)
+        .def_readwrite("rerank_depth", &VamanaSearchParameters::rerank_depth_)
+        .def_readwrite("interleave", &VamanaSearchParameters::interleave_)
+        .def_readwrite(
+            "early_termination_patience",
+            &VamanaSearchParameters::early_termination_patience_
+        )
+        .def_readwrite(
+            "early_termination_ratio", &VamanaSearchParameters::early_termination_ratio_
+        )
+        .def_readwrite(
+            "search_buffer_exact_visited_set",
+            &VamanaSearchParameters::search_buffer_exact_visited_set_
+        )
         .def("__str__", &stringify_search_params)
         .def(
             "__eq__",
@@ -213,6 +270,11 @@ Attributes:
           the search window size.
 
     train_prefetchers (bool): Flag to train prefetch parameters.
+    train_rerank_depth (bool): Flag to tune the rerank depth for datasets that use
+        reranking.
+    early_termination_patience (List[int]): Early termination patience values to try.
+    train_early_termination (bool): Flag to tune the early termination patience. Disabled
+        by default.
     use_existing_parameter_values (bool): Should optimization use existing search parameters
         or should it use defaults instead.
 )"};
@@ -226,6 +288,9 @@ Attributes:
         .def_readwrite("prefetch_steps", &C::prefetch_steps_)
         .def_readwrite("search_buffer_optimization", &C::search_buffer_optimization_)
         .def_readwrite("train_prefetchers", &C::train_prefetchers_)
+        .def_readwrite("train_rerank_depth", &C::train_rerank_depth_)
+        .def_readwrite("early_termination_patience", &C::early_termination_patience_)
+        .def_readwrite("train_early_termination", &C::train_early_termination_)
         .def_readwrite("use_existing_parameter_values", &C::use_existing_parameter_values_)
         .def("__str__", &stringify_calibration_params)
         .def(
@@ -132,9 +132,12 @@ class CommonTester(unittest.TestCase):
         file = os.path.join(self.tempdir_name, "test.bvecs")
         x = svs.common.random_dataset(10000, 10, dtype = np.uint8)
         svs.write_vecs(x, file)
-        # y = svs.read_vecs(file)
-        # self.assertEqual(y.dtype, np.uint8)
-        # self.assertTrue(np.array_equal(x, y))
+        y = svs.read_vecs(file)
+        self.assertEqual(y.dtype, np.uint8)
+        self.assertTrue(np.array_equal(x, y))
+        # parallel reads
+        y = svs.read_vecs(file, num_threads = 4)
+        self.assertTrue(np.array_equal(x, y))
         # convert to svs
         svs.convert_vecs_to_svs(file, svs_file, dtype = svs.uint8)
         # z = svs.read_svs(svs_file, dtype = np.uint8)
@@ -10,10 +10,13 @@
 #
 
 # Tests for the Flat index portion of the SVS module.
+import os
+import tempfile
 import unittest
 import svs
 
 import numpy as np
+from concurrent.futures import ThreadPoolExecutor
 
 # Local dependencies
 from .common import \
@@ -112,6 +115,63 @@ class FlatTester(unittest.TestCase):
         self.assertTrue(isapprox(recall, expected_recall, epsilon = 0.0001))
         # test_threading(flat, queries, num_neighbors)
 
+        # Search into caller-provided outputs.
+        ids = np.zeros((queries.shape[0], num_neighbors), dtype = np.uint64)
+        distances = np.zeros((queries.shape[0], num_neighbors), dtype = np.float32)
+        flat.search_into(queries, ids, distances)
+        self.assertTrue(np.array_equal(ids, results[0]))
+        self.assertTrue(np.array_equal(distances, results[1]))
+
+        # Outputs of the wrong type must not be silently converted.
+        with self.assertRaises(TypeError):
+            flat.search_into(queries, ids.astype(np.int32), distances)
+        with self.assertRaises(RuntimeError):
+            flat.search_into(queries, ids[:, :2].copy(), distances)
+
+        # Filtered search only returns allowed IDs.
+        # A shared 1-D mask applies to all queries while a 2-D mask has one row per query.
+        mask = np.zeros(flat.size, dtype = bool)
+        mask[::2] = True
+        ids, _ = flat.search(queries, num_neighbors, filter = mask)
+        self.assertTrue(np.all(ids % 2 == 0))
+
+        per_query = np.zeros((queries.shape[0], flat.size), dtype = bool)
+        per_query[:, 1::3] = True
+        ids, _ = flat.search(queries, num_neighbors, filter = per_query)
+        self.assertTrue(np.all(ids % 3 == 1))
+        with self.assertRaises(RuntimeError):
+            flat.search(queries, num_neighbors, filter = per_query[:-1])
+
+        # Range search returns CSR results consistent with k-nearest neighbor search.
+        # With the radius strictly better than the k-th neighbor distance of every query,
+        # the range results for each query are a prefix of its k-nearest neighbors.
+        distances = results[1]
+        ascending = distances[0, 0] <= distances[0, -1]
+        if ascending:
+            radius = np.nextafter(np.min(distances[:, -1]), np.float32(-np.inf))
+            within = distances <= radius
+        else:
+            radius = np.nextafter(np.max(distances[:, -1]), np.float32(np.inf))
+            within = distances >= radius
+        offsets, range_ids, range_distances = flat.range_search(queries, radius)
+        self.assertEqual(offsets.shape, (queries.shape[0] + 1,))
+        self.assertEqual(offsets[0], 0)
+        self.assertEqual(offsets[-1], range_ids.shape[0])
+        self.assertEqual(range_ids.dtype, np.uint64)
+        self.assertEqual(range_distances.dtype, np.float32)
+        self.assertTrue(np.array_equal(np.diff(offsets), np.sum(within, axis = 1)))
+        for i in range(queries.shape[0]):
+            d = range_distances[offsets[i]:offsets[i + 1]]
+            self.assertTrue(np.allclose(d, distances[i][within[i]]))
+
+        # Searches from several Python threads should give the same results.
+        with ThreadPoolExecutor(max_workers = 4) as executor:
+            futures = [
+                executor.submit(flat.search, queries, num_neighbors) for _ in range(4)
+            ]
+            for future in futures:
+                self.assertTrue(np.array_equal(future.result()[0], results[0]))
+
     def _do_test_from_file(self, distance: svs.DistanceType, queries, groundtruth):
         # Load the index from files.
         num_threads = 2
@@ -181,3 +241,20 @@ class FlatTester(unittest.TestCase):
         queries_u8 = (queries_f32 + 128).astype('uint8')
         flat = svs.Flat(data_u8, svs.DistanceType.L2)
         self._do_test(flat, queries_u8, groundtruth)
+
+    def test_from_file_bfloat16(self):
+        # NumPy does not support bfloat16, so datasets must be converted on disk.
+        # The test dataset is integer valued and thus exactly representable.
+        queries = svs.read_vecs(test_queries)
+        groundtruth = svs.read_vecs(test_groundtruth_l2)
+        with tempfile.TemporaryDirectory() as tempdir:
+            vecs_file = os.path.join(tempdir, "data_bf16.vecs")
+            svs_file = os.path.join(tempdir, "data_bf16.svs")
+            svs.convert_fvecs_to_bfloat16(test_data_vecs, vecs_file)
+            svs.convert_vecs_to_svs(vecs_file, svs_file, dtype = svs.bfloat16)
+
+            loader = svs.VectorDataLoader(
+                svs_file, svs.DataType.bfloat16, dims = test_data_dims
+            )
+            flat = svs.Flat(loader, distance = svs.DistanceType.L2)
+            self._do_test(flat, queries, groundtruth)
@@ -88,6 +88,11 @@ option(SVS_EXPERIMENTAL_LEANVEC
     OFF # disabled by default
 )
 
+option(SVS_EXPERIMENTAL_RUNTIME_DISPATCH
+    "Compile distance kernels for all supported Intel(R) AVX extensions and select among them at runtime. (Experimental)"
+    OFF # disabled by default
+)
+
 option(SVS_EXPERIMENTAL_BUILD_CUSTOM_MKL
     "Build a custom Intel(R) MKL shared-library for redistributable binaries. (Experimental)"
     OFF # disabled by default
@@ -139,6 +144,12 @@ else()
     target_compile_options(${SVS_LIB} INTERFACE -DSVS_ENABLE_NUMA=0)
 endif()
 
+if (SVS_EXPERIMENTAL_RUNTIME_DISPATCH)
+    target_compile_options(${SVS_LIB} INTERFACE -DSVS_RUNTIME_DISPATCH=1)
+else()
+    target_compile_options(${SVS_LIB} INTERFACE -DSVS_RUNTIME_DISPATCH=0)
+endif()
+
 if (SVS_INITIALIZE_LOGGER)
     target_compile_options(${SVS_LIB} INTERFACE -DSVS_INITIALIZE_LOGGER=1)
 else()
@@ -30,14 +30,18 @@
 #include "svs/lib/memory.h"
 #include "svs/lib/misc.h"
 #include "svs/lib/narrow.h"
+#include "svs/lib/preprocessor.h"
+#include "svs/lib/threads.h"
 
 #include "tsl/robin_map.h"
 
 #include <array>
+#include <atomic>
 #include <fcntl.h>
 #include <filesystem>
 #include <linux/mman.h>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <sys/mman.h>
@@ -502,4 +506,297 @@ class MemoryMapper {
         return MMapPtr<void>(base, bytes.value());
     }
 };
+
+/////
+///// Memory Mapped Allocator
+/////
+
+///
+/// @ingroup core_allocators_public
+/// @brief Options controlling how the memory of a ``MMapAllocator`` is mapped.
+///
+struct MMapOptions {
+  public:
+    /// @brief Populate the page tables when creating the mapping.
+    ///
+    /// Anonymous mappings use ``MAP_POPULATE``. File backed mappings are private and
+    /// writable, where ``MAP_POPULATE`` would copy every page out of the page cache, so
+    /// they are instead read-faulted on the calling thread (with ``MADV_POPULATE_READ``
+    /// where available). Pages stay shared with the page cache until first written.
+    bool populate_ = true;
+
+    /// @brief Advise the kernel to start reading the mapping ahead (``MADV_WILLNEED``).
+    bool willneed_ = false;
+
+    /// @brief Advise the kernel to back the mapping with transparent huge pages
+    /// (``MADV_HUGEPAGE``).
+    bool hugepage_ = false;
+
+    /// @brief The number of threads used to fault in file backed mappings.
+    ///
+    /// Reading from several threads saturates fast storage much better than the single
+    /// threaded ``MAP_POPULATE``. A value of zero disables pre-faulting.
+    size_t prefault_threads_ = 0;
+
+  public:
+    MMapOptions() = default;
+
+    SVS_CHAIN_SETTER_(MMapOptions, populate);
+    SVS_CHAIN_SETTER_(MMapOptions, willneed);
+    SVS_CHAIN_SETTER_(MMapOptions, hugepage);
+    SVS_CHAIN_SETTER_(MMapOptions, prefault_threads);
+
+    friend bool operator==(const MMapOptions&, const MMapOptions&) = default;
+};
+
+///
+/// @ingroup core_allocators_public
+/// @brief Fault in the pages of ``bytes`` bytes beginning at ``ptr`` using ``threadpool``.
+///
+/// Pages are only read, so private file mappings keep sharing them with the page cache.
+///
+template <threads::ThreadPool Pool>
+void prefault(const void* ptr, size_t bytes, Pool& threadpool) {
+    const auto pagesize = lib::narrow_cast<size_t>(sysconf(_SC_PAGESIZE));
+    const auto* base = static_cast<const volatile std::byte*>(ptr);
+    threads::run(
+        threadpool,
+        threads::StaticPartition{lib::div_round_up(bytes, pagesize)},
+        [&](const auto& pages, uint64_t SVS_UNUSED(tid)) {
+            for (auto page : pages) {
+                [[maybe_unused]] std::byte b = base[page * pagesize];
+            }
+        }
+    );
+}
+
+namespace detail {
+
+// Mappings handed out by the `MMapAllocator`.
+//
+// Allocations may begin past the start of their mapping (e.g., after a file header), so
+// the base and size of each mapping are recorded against the pointer given to the user.
+class MMapRegistry {
+  public:
+    struct Mapping {
+        void* base;
+        size_t size;
+    };
+
+    static void insert(void* ptr, Mapping mapping) {
+        std::lock_guard lock{mutex_};
+        mappings_.insert({ptr, mapping});
+    }
+
+    static void remove(void* ptr) {
+        std::lock_guard lock{mutex_};
+        auto itr = mappings_.find(ptr);
+        if (itr == mappings_.end()) {
+            throw ANNEXCEPTION("Could not find the memory mapping of the given pointer!");
+        }
+        auto mapping = itr->second;
+        mappings_.erase(itr);
+        if (munmap(mapping.base, mapping.size) != 0) {
+            throw ANNEXCEPTION("Unmap failed!");
+        }
+    }
+
+    static tsl::robin_map<void*, Mapping> get_mappings() {
+        std::lock_guard lock{mutex_};
+        return mappings_;
+    }
+
+  private:
+    inline static std::mutex mutex_{};
+    inline static tsl::robin_map<void*, Mapping> mappings_{};
+};
+
+// Apply the advice and pre-faulting in `options` to a new mapping and register it.
+inline void* finish_mapping(
+    void* base, size_t size, size_t offset, bool file_backed, const MMapOptions& options
+) {
+    // Advice is best effort. Kernels without transparent huge page support for the
+    // mapping simply reject it.
+#ifdef MADV_HUGEPAGE
+    if (options.hugepage_) {
+        madvise(base, size, MADV_HUGEPAGE);
+    }
+#endif
+    if (options.willneed_) {
+        madvise(base, size, MADV_WILLNEED);
+    }
+    if (file_backed && options.prefault_threads_ != 0) {
+        auto threadpool = threads::NativeThreadPool(options.prefault_threads_);
+        prefault(base, size, threadpool);
+    } else if (file_backed && options.populate_) {
+        // Fault the pages in for reading only, keeping them shared with the page cache.
+        bool populated = false;
+#ifdef MADV_POPULATE_READ
+        populated = madvise(base, size, MADV_POPULATE_READ) == 0;
+#endif
+        if (!populated) {
+            auto threadpool = threads::SequentialThreadPool();
+            prefault(base, size, threadpool);
+        }
+    }
+
+    void* ptr = static_cast<std::byte*>(base) + offset;
+    MMapRegistry::insert(ptr, {base, size});
+    return ptr;
+}
+
+// File backed mappings are populated by `finish_mapping` rather than `MAP_POPULATE`,
+// which write-faults private writable mappings and copies every page of the file.
+inline int mmap_flags(const MMapOptions& options, bool file_backed) {
+    bool populate = options.populate_ && !file_backed;
+    return MAP_PRIVATE | MAP_NORESERVE | (populate ? MAP_POPULATE : 0);
+}
+
+[[nodiscard]] inline void* mmap_anonymous(size_t bytes, const MMapOptions& options) {
+    int flags = mmap_flags(options, false) | MAP_ANONYMOUS;
+    void* base = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, flags, -1, 0);
+    if (base == MAP_FAILED) {
+        throw ANNEXCEPTION("Anonymous memory map of size {} failed!", bytes);
+    }
+    return finish_mapping(base, bytes, 0, false, options);
+}
+
+[[nodiscard]] inline void* mmap_file(
+    const std::filesystem::path& path,
+    size_t offset,
+    size_t bytes,
+    const MMapOptions& options
+) {
+    size_t size = offset + bytes;
+    auto filesize = std::filesystem::file_size(path);
+    if (filesize < size) {
+        throw ANNEXCEPTION(
+            "The size of file {} is {} which is less than the {} bytes to memory map!",
+            path,
+            filesize,
+            size
+        );
+    }
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1) {
+        throw ANNEXCEPTION("Could not open file {}!", path);
+    }
+    void* base =
+        ::mmap(nullptr, size, PROT_READ | PROT_WRITE, mmap_flags(options, true), fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        throw ANNEXCEPTION("Memory mapping file {} failed!", path);
+    }
+    return finish_mapping(base, size, offset, true, options);
+}
+
+} // namespace detail
+
+///
+/// @ingroup core_allocators_entry
+/// @brief Allocator backing containers with private memory maps.
+///
+/// Allocations are anonymous unless the allocator was returned by ``bind``, in which case
+/// its first allocation maps a file in place. Data saved in the same layout as it is held
+/// in memory is then used without being read or copied, making reloads of large indexes
+/// nearly free.
+///
+/// File mappings are private: pages are shared with the page cache until first written
+/// and writes are never carried through to the file.
+///
+template <typename T> class MMapAllocator {
+    static_assert(std::is_trivially_copyable_v<T>, "Mapped types must be trivial!");
+
+  public:
+    // Allocator type aliases.
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+    using is_always_equal = std::true_type;
+
+    /// @brief Construct an allocator using the default ``MMapOptions``.
+    MMapAllocator() = default;
+
+    /// @brief Construct an allocator applying ``options`` to every mapping.
+    explicit MMapAllocator(const MMapOptions& options)
+        : options_{options} {}
+
+    // Enable rebinding of allocators.
+    template <typename U> friend class MMapAllocator;
+
+    template <typename U>
+    MMapAllocator(const MMapAllocator<U>& other)
+        : options_{other.options_} {}
+
+    template <typename U> bool operator==(const MMapAllocator<U>& SVS_UNUSED(other)) const {
+        return true;
+    }
+
+    /// @brief Return the options applied to each mapping.
+    const MMapOptions& options() const { return options_; }
+
+    ///
+    /// @brief Return a copy of this allocator whose next allocation maps ``path``.
+    ///
+    /// @param path The file to map.
+    /// @param offset The offset in bytes of the first element in the file.
+    ///
+    /// Only the first allocation made through the returned allocator (or its copies) maps
+    /// the file. Later allocations, for example when a container grows, are anonymous.
+    ///
+    MMapAllocator bind(const std::filesystem::path& path, size_t offset = 0) const {
+        auto result = MMapAllocator(options_);
+        result.binding_ = std::make_shared<Binding>(path, offset);
+        return result;
+    }
+
+    /// @brief Return whether the next allocation maps a file.
+    bool is_bound() const { return binding_ != nullptr && !binding_->used_; }
+
+    // Copies of containers are independent of the file the original maps.
+    MMapAllocator select_on_container_copy_construction() const {
+        return MMapAllocator(options_);
+    }
+
+    [[nodiscard]] T* allocate(size_t n) {
+        if (n == 0) {
+            return nullptr;
+        }
+        size_t bytes = sizeof(T) * n;
+        if (binding_ != nullptr && !binding_->used_.exchange(true)) {
+            return static_cast<T*>(
+                detail::mmap_file(binding_->path_, binding_->offset_, bytes, options_)
+            );
+        }
+        return static_cast<T*>(detail::mmap_anonymous(bytes, options_));
+    }
+
+    void deallocate(void* ptr, size_t SVS_UNUSED(n)) {
+        if (ptr != nullptr) {
+            detail::MMapRegistry::remove(ptr);
+        }
+    }
+
+    // Perform default initialization so mapped contents are left untouched.
+    void construct(T* ptr) { ::new (static_cast<void*>(ptr)) T; }
+
+  private:
+    struct Binding {
+        Binding(std::filesystem::path path, size_t offset)
+            : path_{std::move(path)}
+            , offset_{offset} {}
+
+        std::filesystem::path path_;
+        size_t offset_;
+        std::atomic<bool> used_{false};
+    };
+
+    MMapOptions options_{};
+    std::shared_ptr<Binding> binding_{};
+};
+
+/// @brief Return whether ``Alloc`` is a ``MMapAllocator``.
+template <typename Alloc> inline constexpr bool is_mmap_allocator_v = false;
+template <typename T> inline constexpr bool is_mmap_allocator_v<MMapAllocator<T>> = true;
 } // namespace svs
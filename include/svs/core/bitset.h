@@ -0,0 +1,219 @@
+/**
+ *    Copyright (C) 2023, Intel Corporation
+ *
+ *    You can redistribute and/or modify this software under the terms of the
+ *    GNU Affero General Public License version 3.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    version 3 along with this software. If not, see
+ *    <https://www.gnu.org/licenses/agpl-3.0.en.html>.
+ */
+
+#pragma once
+
+#include "svs/lib/exception.h"
+#include "svs/lib/misc.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace svs {
+
+///
+/// @brief Non-owning view of a ``svs::BitSet``.
+///
+/// Views are cheap to copy and are invocable as ``bool operator()(size_t)``, so they may
+/// be passed wherever an index expects a predicate on IDs.
+///
+class BitSetView {
+  public:
+    using word_type = uint64_t;
+    static constexpr size_t word_bits = 64;
+
+    BitSetView() = default;
+    BitSetView(std::span<const word_type> words, size_t size)
+        : words_{words}
+        , size_{size} {}
+
+    /// @brief Return the number of bits in the set.
+    size_t size() const { return size_; }
+
+    /// @brief Return the packed words backing the set.
+    std::span<const word_type> words() const { return words_; }
+
+    /// @brief Return whether bit ``i`` is set. Bits past the end are never set.
+    bool test(size_t i) const {
+        return i < size_ && ((words_[i / word_bits] >> (i % word_bits)) & 1) != 0;
+    }
+
+    /// @copydoc test
+    bool operator()(size_t i) const { return test(i); }
+
+    /// @brief Return the number of set bits.
+    size_t count() const {
+        size_t total = 0;
+        for (auto word : words_) {
+            total += std::popcount(word);
+        }
+        return total;
+    }
+
+    ///
+    /// @brief Invoke ``f(i)`` for each set bit ``i`` in ``[start, stop)``, in order.
+    ///
+    /// Whole words of unset bits are skipped with a single comparison.
+    ///
+    template <typename F> void for_each(size_t start, size_t stop, F&& f) const {
+        stop = std::min(stop, size_);
+        if (start >= stop) {
+            return;
+        }
+        size_t w = start / word_bits;
+        const size_t last = (stop - 1) / word_bits;
+        word_type word = words_[w] & (~word_type{0} << (start % word_bits));
+        while (true) {
+            if (w == last && stop % word_bits != 0) {
+                word &= (word_type{1} << (stop % word_bits)) - 1;
+            }
+            while (word != 0) {
+                f(w * word_bits + std::countr_zero(word));
+                word &= word - 1;
+            }
+            if (++w > last) {
+                break;
+            }
+            word = words_[w];
+        }
+    }
+
+  private:
+    std::span<const word_type> words_{};
+    size_t size_ = 0;
+};
+
+///
+/// @brief A fixed-size set of IDs in ``[0, size())`` stored with one bit per ID.
+///
+class BitSet {
+  public:
+    using word_type = BitSetView::word_type;
+    static constexpr size_t word_bits = BitSetView::word_bits;
+
+    BitSet() = default;
+
+    ///
+    /// @brief Construct a set over ``[0, size)``.
+    ///
+    /// @param size The number of IDs covered by the set.
+    /// @param value The initial state of each bit.
+    ///
+    explicit BitSet(size_t size, bool value = false)
+        : words_(lib::div_round_up(size, word_bits), value ? ~word_type{0} : word_type{0})
+        , size_{size} {
+        // Keep the bits past the end cleared so `count()` stays exact.
+        if (value && size % word_bits != 0) {
+            words_.back() &= (word_type{1} << (size % word_bits)) - 1;
+        }
+    }
+
+    /// @brief Return the number of bits in the set.
+    size_t size() const { return size_; }
+    /// @brief Return the packed words backing the set.
+    std::span<const word_type> words() const { return words_; }
+    /// @brief Return a non-owning view of the set.
+    BitSetView view() const { return BitSetView{words_, size_}; }
+
+    /// @brief Return whether bit ``i`` is set. Bits past the end are never set.
+    bool test(size_t i) const { return view().test(i); }
+    /// @copydoc test
+    bool operator()(size_t i) const { return test(i); }
+    /// @brief Return the number of set bits.
+    size_t count() const { return view().count(); }
+
+    /// @brief Set bit ``i``. Requires ``i < size()``.
+    void set(size_t i) {
+        check(i);
+        words_[i / word_bits] |= word_type{1} << (i % word_bits);
+    }
+
+    /// @brief Clear bit ``i``. Requires ``i < size()``.
+    void reset(size_t i) {
+        check(i);
+        words_[i / word_bits] &= ~(word_type{1} << (i % word_bits));
+    }
+
+    /// @copydoc BitSetView::for_each
+    template <typename F> void for_each(size_t start, size_t stop, F&& f) const {
+        view().for_each(start, stop, std::forward<F>(f));
+    }
+
+  private:
+    void check(size_t i) const {
+        if (i >= size_) {
+            throw ANNEXCEPTION("Bit {} is out of bounds for a set of size {}!", i, size_);
+        }
+    }
+
+    std::vector<word_type> words_{};
+    size_t size_ = 0;
+};
+
+///
+/// @brief Restrict the results of a search to allowed IDs.
+///
+/// A filter is either empty (all IDs are allowed), holds a single ``svs::BitSet`` shared
+/// by all queries, or holds one ``svs::BitSet`` per query.
+///
+/// Bit ``i`` of a set marks ID ``i`` as allowed. For indexes with external IDs (such as
+/// the dynamic Vamana index), bits refer to external IDs. Elements that are not allowed
+/// may still be visited during search but are never returned. If fewer allowed elements
+/// than requested neighbors are found for a query, the remaining result entries hold the
+/// ID ``std::numeric_limits<I>::max()`` with the worst possible distance.
+///
+class SearchFilter {
+  public:
+    /// @brief Construct an empty filter that allows all IDs.
+    SearchFilter() = default;
+
+    /// @brief Construct a filter shared by all queries.
+    explicit SearchFilter(BitSet allowed)
+        : bitsets_{std::move(allowed)} {}
+
+    /// @brief Construct a filter with one set of allowed IDs for each query.
+    explicit SearchFilter(std::vector<BitSet> per_query)
+        : bitsets_{std::move(per_query)}
+        , per_query_{true} {}
+
+    /// @brief Return whether the filter allows all IDs.
+    bool empty() const { return !per_query_ && bitsets_.empty(); }
+    /// @brief Return whether each query has its own set of allowed IDs.
+    bool is_per_query() const { return per_query_; }
+
+    /// @brief Return the allowed IDs for query ``i``. Requires ``!empty()``.
+    BitSetView view(size_t i) const {
+        return per_query_ ? bitsets_.at(i).view() : bitsets_.front().view();
+    }
+
+    ///
+    /// @brief Throw an ``svs::ANNException`` if the filter cannot be applied to a batch of
+    ///     ``num_queries`` queries.
+    ///
+    void check(size_t num_queries) const {
+        if (per_query_ && bitsets_.size() != num_queries) {
+            throw ANNEXCEPTION(
+                "Filter has {} per-query sets but {} queries were given!",
+                bitsets_.size(),
+                num_queries
+            );
+        }
+    }
+
+  private:
+    std::vector<BitSet> bitsets_{};
+    bool per_query_ = false;
+};
+
+} // namespace svs
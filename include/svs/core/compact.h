@@ -24,6 +24,14 @@
 
 namespace svs {
 
+///
+/// @brief Move entry ``new_to_old[i]`` of ``data`` to position ``i``, using ``buffer`` as
+///     scratch space.
+///
+/// The data is moved in batches the size of ``buffer``. With batches smaller than
+/// ``new_to_old``, entries are only moved towards the front, so ``new_to_old`` must be
+/// sorted. A buffer holding all of ``new_to_old`` allows arbitrary permutations.
+///
 template <
     data::MemoryDataset Data,
     data::MemoryDataset Buffer,
@@ -34,7 +42,10 @@ void compact_data(
 ) {
     // The contents of the data and the buffer should be the same.
     static_assert(std::is_same_v<data::value_type_t<Data>, data::value_type_t<Buffer>>);
-    assert(std::is_sorted(new_to_old.begin(), new_to_old.end()));
+    assert(
+        buffer.size() >= new_to_old.size() ||
+        std::is_sorted(new_to_old.begin(), new_to_old.end())
+    );
 
     auto data_dims = data.dimensions();
     auto buffer_dims = buffer.dimensions();
@@ -138,12 +138,28 @@ class VectorDataLoader {
     /// @brief Load the dataset from disk.
     return_type load() const { return return_type::load(path_, allocator_); }
 
+    ///
+    /// @brief Load the dataset from disk, reading files in parallel using ``threadpool``.
+    ///
+    /// See ``svs::io::parallel_read`` for details.
+    ///
+    template <threads::ThreadPool Pool> return_type load(Pool& threadpool) const {
+        return return_type::load(path_, threadpool, allocator_, options_);
+    }
+
+    /// @brief Set the options used when loading in parallel.
+    VectorDataLoader& parallel_options(const io::ParallelLoadOptions& options) {
+        options_ = options;
+        return *this;
+    }
+
     /// @brief Return the file path given when this class was constructed.
     const std::filesystem::path& get_path() const { return path_; }
 
     ///// Members
     std::filesystem::path path_ = {};
     Allocator allocator_ = {};
+    io::ParallelLoadOptions options_ = {};
 };
 
 // Matching rule for uncompressed data.
@@ -16,10 +16,19 @@
 #include "svs/core/io.h"
 
 #include "svs/lib/array.h"
+#include "svs/lib/block_file.h"
 #include "svs/lib/exception.h"
 #include "svs/lib/memory.h"
 #include "svs/lib/meta.h"
 #include "svs/lib/misc.h"
+#include "svs/lib/preprocessor.h"
+#include "svs/lib/threads.h"
+
+// stl
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <span>
 
 namespace svs::io {
 
@@ -164,6 +173,217 @@ lib::lazy_result_t<F, size_t, size_t> load_dataset(const File& file, const F& la
     return load_impl(detail::to_native(file), default_accessor, lazy);
 }
 
+/////
+///// Parallel Loading
+/////
+
+///
+/// @brief Options for loading datasets with ``parallel_read`` and friends.
+///
+struct ParallelLoadOptions {
+  public:
+    /// @brief The approximate number of bytes read by a worker thread at a time.
+    size_t chunk_bytes_ = size_t{1} << 24;
+
+    /// @brief Read with direct I/O, bypassing the page cache.
+    ///
+    /// File systems that do not support direct I/O fall back to buffered reads.
+    bool direct_ = false;
+
+  public:
+    ParallelLoadOptions() = default;
+
+    SVS_CHAIN_SETTER_(ParallelLoadOptions, chunk_bytes);
+    SVS_CHAIN_SETTER_(ParallelLoadOptions, direct);
+};
+
+///
+/// @brief Byte layout of a file storing equally sized vectors back to back.
+///
+struct DenseLayout {
+    /// The number of bytes preceding the first vector.
+    size_t offset;
+    /// The number of bytes preceding each vector (e.g., the length field of vecs files).
+    size_t prefix;
+    /// The number of vectors in the file.
+    size_t num_vectors;
+    /// The number of elements in each vector.
+    size_t dimensions;
+    /// The number of bytes in each element.
+    size_t element_bytes;
+
+    size_t row_bytes() const { return prefix + element_bytes * dimensions; }
+};
+
+template <typename File, typename T>
+    requires requires { typename File::metadata; }
+DenseLayout dense_layout(const File& file, lib::Type<T> SVS_UNUSED(type)) {
+    using metadata = typename File::metadata;
+    auto [num_vectors, dimensions] = file.get_dims();
+    return DenseLayout{sizeof(metadata), 0, num_vectors, dimensions, sizeof(T)};
+}
+
+template <typename T>
+DenseLayout dense_layout(const vecs::VecsFile& file, lib::Type<T> SVS_UNUSED(type)) {
+    auto [num_vectors, dimensions] = file.get_dims(sizeof(T));
+    return DenseLayout{0, sizeof(vecs::length_t), num_vectors, dimensions, sizeof(T)};
+}
+
+template <typename T>
+DenseLayout dense_layout(const binary::BinaryFile& file, lib::Type<T> SVS_UNUSED(type)) {
+    auto [num_vectors, dimensions] = file.get_dims(sizeof(T));
+    return DenseLayout{sizeof(binary::Header), 0, num_vectors, dimensions, sizeof(T)};
+}
+
+namespace detail {
+// Offsets and lengths of direct I/O reads are aligned to this many bytes.
+inline constexpr size_t direct_io_alignment = 4096;
+} // namespace detail
+
+///
+/// @brief Invoke ``f(i, datum)`` for each vector in ``file`` using ``threadpool``.
+///
+/// @tparam T The element type of the vectors in the file.
+///
+/// @param file The file to read. Native, vecs and binary files are supported.
+/// @param type The element type of the vectors in the file.
+/// @param threadpool The pool whose workers read and process the file.
+/// @param options Chunk size and direct I/O settings.
+/// @param f Callback receiving the index and a ``std::span<const T>`` of each vector.
+///
+/// The file is split into chunks of whole vectors. Worker threads read the chunks with
+/// positional reads and immediately pass their vectors to ``f``, so processing of one
+/// chunk overlaps with reading the others. ``f`` is called concurrently from multiple
+/// threads.
+///
+template <typename File, typename T, threads::ThreadPool Pool, typename F>
+void parallel_read(
+    const File& file,
+    lib::Type<T> type,
+    Pool& threadpool,
+    const ParallelLoadOptions& options,
+    F&& f
+) {
+    if constexpr (std::is_same_v<File, NativeFile>) {
+        file.resolve([&](const auto& resolved) {
+            parallel_read(resolved, type, threadpool, options, f);
+        });
+    } else {
+        const auto layout = dense_layout(file, type);
+        const size_t row_bytes = layout.row_bytes();
+        const size_t rows_per_chunk = std::max(options.chunk_bytes_ / row_bytes, size_t{1});
+        const size_t num_chunks = lib::div_round_up(layout.num_vectors, rows_per_chunk);
+
+        auto blockfile = lib::BlockFile(file.get_path(), options.direct_);
+        const size_t alignment = blockfile.direct() ? detail::direct_io_alignment : 1;
+        auto buffers = threads::SequentialTLS<lib::AlignedBuffer>(threadpool.size());
+        threads::run(
+            threadpool,
+            threads::DynamicPartition{num_chunks, 1},
+            [&](const auto& chunks, uint64_t tid) {
+                auto& buffer = buffers.at(tid);
+                for (auto chunk : chunks) {
+                    size_t start = chunk * rows_per_chunk;
+                    size_t stop = std::min(start + rows_per_chunk, layout.num_vectors);
+                    size_t begin = layout.offset + start * row_bytes;
+                    size_t end = layout.offset + stop * row_bytes;
+
+                    // Widen the read to block boundaries for direct I/O.
+                    size_t read_begin = begin - begin % alignment;
+                    size_t read_bytes =
+                        lib::round_up_to_multiple_of(end - read_begin, alignment);
+                    if (buffer.size() < read_bytes) {
+                        buffer = lib::AlignedBuffer(
+                            read_bytes, std::max(alignment, alignof(std::max_align_t))
+                        );
+                    }
+                    if (blockfile.read_some(buffer.data(), read_bytes, read_begin) <
+                        end - read_begin) {
+                        throw ANNEXCEPTION(
+                            "File {} ended before its last vector!", file.get_path()
+                        );
+                    }
+
+                    const std::byte* row = buffer.data() + (begin - read_begin);
+                    for (size_t i = start; i < stop; ++i, row += row_bytes) {
+                        if constexpr (std::is_same_v<File, vecs::VecsFile>) {
+                            auto length = vecs::length_t{};
+                            std::memcpy(&length, row, sizeof(length));
+                            if (length != layout.dimensions) {
+                                throw ANNEXCEPTION(
+                                    "Vector {} of file {} has {} dimensions instead of {}!",
+                                    i,
+                                    file.get_path(),
+                                    length,
+                                    layout.dimensions
+                                );
+                            }
+                        }
+                        const auto* data =
+                            reinterpret_cast<const T*>(row + layout.prefix);
+                        f(i, std::span<const T>(data, layout.dimensions));
+                    }
+                }
+            }
+        );
+    }
+}
+
+///
+/// @brief Populate ``data`` with the contents of ``file`` using ``threadpool``.
+///
+/// @tparam T The element type of the vectors in the file.
+///
+/// Vectors are converted to the element type of ``data`` as they are read, so (for
+/// example) a file of ``float`` can be loaded directly into a dataset of ``Float16``.
+///
+template <
+    data::MemoryDataset Data,
+    typename File,
+    typename T,
+    threads::ThreadPool Pool>
+void parallel_populate(
+    Data& data,
+    const File& file,
+    lib::Type<T> type,
+    Pool& threadpool,
+    const ParallelLoadOptions& options = {}
+) {
+    parallel_read(file, type, threadpool, options, [&](size_t i, std::span<const T> v) {
+        data.set_datum(i, v);
+    });
+}
+
+///
+/// @brief Load a dataset from ``file`` using ``threadpool``.
+///
+/// @tparam T The element type of the vectors in the file.
+///
+/// @param file The file to load.
+/// @param type The element type of the vectors in the file.
+/// @param lazy Deferred constructor for the dataset. See ``auto_load``.
+/// @param threadpool The pool used to read and convert the data.
+/// @param options Chunk size and direct I/O settings.
+///
+template <
+    typename File,
+    typename T,
+    lib::LazyInvocable<size_t, size_t> F,
+    threads::ThreadPool Pool>
+lib::lazy_result_t<F, size_t, size_t> parallel_load_dataset(
+    const File& file,
+    lib::Type<T> type,
+    const F& lazy,
+    Pool& threadpool,
+    const ParallelLoadOptions& options = {}
+) {
+    const auto& resolved = detail::to_native(file);
+    auto [vectors_to_read, ndims] = resolved.get_dims();
+    auto data = lazy(vectors_to_read, ndims);
+    parallel_populate(data, resolved, type, threadpool, options);
+    return data;
+}
+
 // Return whether or not a file is directly loadable via file-extension.
 inline bool special_by_file_extension(std::string_view path) {
     return (path.ends_with("svs") || path.ends_with("vecs") || path.ends_with("bin"));
@@ -203,6 +423,41 @@ auto_load(const std::filesystem::path& filename, const F& construct) {
     throw ANNEXCEPTION("Unknown file extension for input file: {}.", filename);
 }
 
+///
+/// @brief Load a dataset from file in parallel, detecting the file type by extension.
+///
+/// @tparam T The element type of the vectors in the file.
+///
+/// Behaves like ``auto_load`` but reads and converts the file with ``threadpool``.
+/// See ``parallel_read`` for details.
+///
+template <typename T, lib::LazyInvocable<size_t, size_t> F, threads::ThreadPool Pool>
+lib::lazy_result_t<F, size_t, size_t> parallel_auto_load(
+    const std::filesystem::path& filename,
+    const F& construct,
+    Pool& threadpool,
+    const ParallelLoadOptions& options = {}
+) {
+    auto sv = std::string_view{filename.native()};
+    auto type = lib::Type<T>();
+    if (sv.ends_with("svs")) {
+        return parallel_load_dataset(
+            io::NativeFile(filename), type, construct, threadpool, options
+        );
+    }
+    if (sv.ends_with("vecs")) {
+        return parallel_load_dataset(
+            io::vecs::VecsFile(filename), type, construct, threadpool, options
+        );
+    }
+    if (sv.ends_with("bin")) {
+        return parallel_load_dataset(
+            io::binary::BinaryFile(filename), type, construct, threadpool, options
+        );
+    }
+    throw ANNEXCEPTION("Unknown file extension for input file: {}.", filename);
+}
+
 inline size_t deduce_dimensions(const std::filesystem::path& filename) {
     auto sv = std::string_view(filename.native());
     assert(special_by_file_extension(sv));
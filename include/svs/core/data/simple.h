@@ -87,9 +87,9 @@ class GenericSerializer {
         );
     }
 
-    template <typename T, lib::LazyInvocable<size_t, size_t> F>
-    static lib::lazy_result_t<F, size_t, size_t>
-    load(const lib::LoadTable& table, const F& lazy) {
+    // Return the path to the binary file of a saved dataset with element type `T`.
+    template <typename T>
+    static std::filesystem::path find_binary(const lib::LoadTable& table) {
         auto datatype = lib::load_at<DataType>(table, "eltype");
         if (datatype != datatype_v<T>) {
             throw ANNEXCEPTION(
@@ -106,7 +106,28 @@ class GenericSerializer {
         if (!binaryfile.has_value()) {
             throw ANNEXCEPTION("Could not open file with uuid {}!", uuid.str());
         }
-        return io::load_dataset(binaryfile.value(), lazy);
+        return binaryfile.value();
+    }
+
+    template <typename T, lib::LazyInvocable<size_t, size_t> F>
+    static lib::lazy_result_t<F, size_t, size_t>
+    load(const lib::LoadTable& table, const F& lazy) {
+        return io::load_dataset(find_binary<T>(table), lazy);
+    }
+
+    template <
+        typename T,
+        lib::LazyInvocable<size_t, size_t> F,
+        threads::ThreadPool Pool>
+    static lib::lazy_result_t<F, size_t, size_t> load(
+        const lib::LoadTable& table,
+        const F& lazy,
+        Pool& threadpool,
+        const io::ParallelLoadOptions& options
+    ) {
+        return io::parallel_load_dataset(
+            find_binary<T>(table), lib::Type<T>(), lazy, threadpool, options
+        );
     }
 };
 
@@ -409,6 +430,9 @@ class SimpleData {
     load(const lib::LoadTable& table, const allocator_type& allocator = {})
         requires(!is_view)
     {
+        if constexpr (is_mmap_allocator_v<Alloc>) {
+            return map(GenericSerializer::find_binary<T>(table), allocator);
+        }
         return GenericSerializer::load<T>(
             table, lib::Lazy([&](size_t n_elements, size_t n_dimensions) {
                 return SimpleData(n_elements, n_dimensions, allocator);
@@ -416,6 +440,36 @@ class SimpleData {
         );
     }
 
+    ///
+    /// @brief Reload a previously saved dataset using a thread pool.
+    ///
+    /// @param table The table containing saved hyper parameters.
+    /// @param threadpool The pool used to read the binary file.
+    /// @param allocator Allocator instance to use upon reloading.
+    /// @param options Chunk size and direct I/O settings for reading.
+    ///
+    template <threads::ThreadPool Pool>
+    static SimpleData load(
+        const lib::LoadTable& table,
+        Pool& threadpool,
+        const allocator_type& allocator = {},
+        const io::ParallelLoadOptions& options = {}
+    )
+        requires(!is_view)
+    {
+        if constexpr (is_mmap_allocator_v<Alloc>) {
+            return map(GenericSerializer::find_binary<T>(table), allocator);
+        }
+        return GenericSerializer::load<T>(
+            table,
+            lib::Lazy([&](size_t n_elements, size_t n_dimensions) {
+                return SimpleData(n_elements, n_dimensions, allocator);
+            }),
+            threadpool,
+            options
+        );
+    }
+
     ///
     /// @brief Try to automatically load the dataset.
     ///
@@ -434,6 +488,11 @@ class SimpleData {
         if (detail::is_likely_reload(path)) {
             return lib::load_from_disk<SimpleData>(path, allocator);
         }
+        if constexpr (is_mmap_allocator_v<Alloc>) {
+            if (path.native().ends_with("svs")) {
+                return map(path, allocator);
+            }
+        }
         // Try loading directly.
         return io::auto_load<T>(
             path, lib::Lazy([&](size_t n_elements, size_t n_dimensions) {
@@ -442,6 +501,66 @@ class SimpleData {
         );
     }
 
+    ///
+    /// @brief Automatically load the dataset, reading files in parallel.
+    ///
+    /// @param path The filepath to a dataset on disk. See the single threaded ``load``.
+    /// @param threadpool The pool used to read the dataset.
+    /// @param allocator The allocator instance to use when constructing this class.
+    /// @param options Chunk size and direct I/O settings for reading.
+    ///
+    /// The file is split into chunks that the threads in ``threadpool`` read with
+    /// positional reads. See ``svs::io::parallel_read``.
+    ///
+    template <threads::ThreadPool Pool>
+    static SimpleData load(
+        const std::filesystem::path& path,
+        Pool& threadpool,
+        const allocator_type& allocator = {},
+        const io::ParallelLoadOptions& options = {}
+    )
+        requires(!is_view)
+    {
+        if (detail::is_likely_reload(path)) {
+            return lib::load_from_disk<SimpleData>(path, threadpool, allocator, options);
+        }
+        if constexpr (is_mmap_allocator_v<Alloc>) {
+            if (path.native().ends_with("svs")) {
+                return map(path, allocator);
+            }
+        }
+        return io::parallel_auto_load<T>(
+            path,
+            lib::Lazy([&](size_t n_elements, size_t n_dimensions) {
+                return SimpleData(n_elements, n_dimensions, allocator);
+            }),
+            threadpool,
+            options
+        );
+    }
+
+    ///
+    /// @brief Construct the dataset directly over the contents of a native file.
+    ///
+    /// @param path The path to a native ".svs" file.
+    /// @param allocator The allocator whose options are used to map the file.
+    ///
+    /// Native files store vectors densely after their header, which is exactly how they
+    /// are laid out in memory, so the file is mapped in place rather than read.
+    ///
+    static SimpleData
+    map(const std::filesystem::path& path, const allocator_type& allocator)
+        requires is_mmap_allocator_v<Alloc>
+    {
+        return io::NativeFile(path).resolve([&](const auto& file) {
+            using metadata = typename std::decay_t<decltype(file)>::metadata;
+            auto [n_elements, n_dimensions] = file.get_dims();
+            return SimpleData(
+                n_elements, n_dimensions, allocator.bind(path, sizeof(metadata))
+            );
+        });
+    }
+
     ///
     /// @brief Resize the dataset to the new size.
     ///
@@ -14,6 +14,7 @@
 // svs
 #include "svs/core/distance/distance_core.h"
 #include "svs/core/distance/simd_utils.h"
+#include "svs/lib/arch.h"
 #include "svs/lib/saveload.h"
 #include "svs/lib/static.h"
 
@@ -162,6 +163,18 @@ float generic_cosine_similarity(
     return result / (a_norm * std::sqrt(accum));
 };
 
+// Implementations of the kernel for each instruction set level.
+// Only the generic implementation is required. See `simd::Dispatcher`.
+template <arch::ISA Isa, size_t N, typename Ea, typename Eb> struct CosineSimilarityKernel;
+
+template <size_t N, typename Ea, typename Eb>
+struct CosineSimilarityKernel<arch::ISA::generic, N, Ea, Eb> {
+    static float
+    compute(const Ea* a, const Eb* b, float a_norm, lib::MaybeStatic<N> length) {
+        return generic_cosine_similarity(a, b, a_norm, length);
+    }
+};
+
 template <size_t N, typename Ea, typename Eb> struct CosineSimilarityImpl {
     static float compute(
         const Ea* a,
@@ -169,7 +182,9 @@ template <size_t N, typename Ea, typename Eb> struct CosineSimilarityImpl {
         float a_norm,
         lib::MaybeStatic<N> length = lib::MaybeStatic<N>()
     ) {
-        return generic_cosine_similarity(a, b, a_norm, length);
+        return simd::Dispatcher<CosineSimilarityKernel, N, Ea, Eb>::compute(
+            a, b, a_norm, length
+        );
     }
 };
 
@@ -180,8 +195,12 @@ template <size_t N, typename Ea, typename Eb> struct CosineSimilarityImpl {
 // Shared implementation among those that use floating-point arithmetic.
 template <size_t SIMDWidth> struct CosineFloatOp;
 
-SVS_VALIDATE_BOOL_ENV(SVS_AVX512_F)
-#if SVS_AVX512_F
+// Operations on pairs of ``BFloat16`` using Intel(R) AVX-512 BF16.
+struct CosineBF16Op;
+
+SVS_VALIDATE_BOOL_ENV(SVS_BUILD_AVX512_F)
+#if SVS_BUILD_AVX512_F
+SVS_BEGIN_TARGET_AVX512_F
 
 template <> struct CosineFloatOp<16> : public svs::simd::ConvertToFloat<16> {
     using parent = svs::simd::ConvertToFloat<16>;
@@ -217,10 +236,67 @@ template <> struct CosineFloatOp<16> : public svs::simd::ConvertToFloat<16> {
     }
 };
 
+// Floating and Mixed Types
+template <size_t N> struct CosineSimilarityKernel<arch::ISA::avx512f, N, float, float> {
+    SVS_NOINLINE static float
+    compute(const float* a, const float* b, float a_norm, lib::MaybeStatic<N> length) {
+        auto [sum, norm] = simd::generic_simd_op(CosineFloatOp<16>(), a, b, length);
+        return sum / (std::sqrt(norm) * a_norm);
+    }
+};
+
+template <size_t N> struct CosineSimilarityKernel<arch::ISA::avx512f, N, float, uint8_t> {
+    SVS_NOINLINE static float
+    compute(const float* a, const uint8_t* b, float a_norm, lib::MaybeStatic<N> length) {
+        auto [sum, norm] = simd::generic_simd_op(CosineFloatOp<16>(), a, b, length);
+        return sum / (std::sqrt(norm) * a_norm);
+    };
+};
+
+template <size_t N> struct CosineSimilarityKernel<arch::ISA::avx512f, N, float, int8_t> {
+    SVS_NOINLINE static float
+    compute(const float* a, const int8_t* b, float a_norm, lib::MaybeStatic<N> length) {
+        auto [sum, norm] = simd::generic_simd_op(CosineFloatOp<16>(), a, b, length);
+        return sum / (std::sqrt(norm) * a_norm);
+    };
+};
+
+template <size_t N> struct CosineSimilarityKernel<arch::ISA::avx512f, N, float, Float16> {
+    SVS_NOINLINE static float
+    compute(const float* a, const Float16* b, float a_norm, lib::MaybeStatic<N> length) {
+        auto [sum, norm] = simd::generic_simd_op(CosineFloatOp<16>(), a, b, length);
+        return sum / (std::sqrt(norm) * a_norm);
+    }
+};
+
+template <size_t N> struct CosineSimilarityKernel<arch::ISA::avx512f, N, float, BFloat16> {
+    SVS_NOINLINE static float
+    compute(const float* a, const BFloat16* b, float a_norm, lib::MaybeStatic<N> length) {
+        auto [sum, norm] = simd::generic_simd_op(CosineFloatOp<16>(), a, b, length);
+        return sum / (std::sqrt(norm) * a_norm);
+    }
+};
+
+template <size_t N>
+struct CosineSimilarityKernel<arch::ISA::avx512f, N, BFloat16, BFloat16> {
+    SVS_NOINLINE static float compute(
+        const BFloat16* a, const BFloat16* b, float a_norm, lib::MaybeStatic<N> length
+    ) {
+        auto [sum, norm] = simd::generic_simd_op(CosineFloatOp<16>(), a, b, length);
+        return sum / (std::sqrt(norm) * a_norm);
+    }
+};
+
+SVS_END_TARGET
+#endif
+
 // Small Integers
-SVS_VALIDATE_BOOL_ENV(SVS_AVX512_VNNI)
-#if SVS_AVX512_VNNI
-template <size_t N> struct CosineSimilarityImpl<N, int8_t, int8_t> {
+SVS_VALIDATE_BOOL_ENV(SVS_BUILD_AVX512_VNNI)
+#if SVS_BUILD_AVX512_VNNI
+SVS_BEGIN_TARGET_AVX512_VNNI
+
+template <size_t N>
+struct CosineSimilarityKernel<arch::ISA::avx512vnni, N, int8_t, int8_t> {
     SVS_NOINLINE static float
     compute(const int8_t* a, const int8_t* b, float a_norm, lib::MaybeStatic<N> length) {
         auto sum = _mm512_setzero_epi32();
@@ -246,7 +322,8 @@ template <size_t N> struct CosineSimilarityImpl<N, int8_t, int8_t> {
     }
 };
 
-template <size_t N> struct CosineSimilarityImpl<N, uint8_t, uint8_t> {
+template <size_t N>
+struct CosineSimilarityKernel<arch::ISA::avx512vnni, N, uint8_t, uint8_t> {
     SVS_NOINLINE static float
     compute(const uint8_t* a, const uint8_t* b, float a_norm, lib::MaybeStatic<N> length) {
         auto sum = _mm512_setzero_epi32();
@@ -271,39 +348,58 @@ template <size_t N> struct CosineSimilarityImpl<N, uint8_t, uint8_t> {
     }
 };
 
+SVS_END_TARGET
 #endif
 
-// Floating and Mixed Types
-template <size_t N> struct CosineSimilarityImpl<N, float, float> {
-    SVS_NOINLINE static float
-    compute(const float* a, const float* b, float a_norm, lib::MaybeStatic<N> length) {
-        auto [sum, norm] = simd::generic_simd_op(CosineFloatOp<16>(), a, b, length);
-        return sum / (std::sqrt(norm) * a_norm);
-    }
-};
+// Brain Floating Point
+SVS_VALIDATE_BOOL_ENV(SVS_BUILD_AVX512_BF16)
+#if SVS_BUILD_AVX512_BF16
+SVS_BEGIN_TARGET_AVX512_BF16
 
-template <size_t N> struct CosineSimilarityImpl<N, float, uint8_t> {
-    SVS_NOINLINE static float
-    compute(const float* a, const uint8_t* b, float a_norm, lib::MaybeStatic<N> length) {
-        auto [sum, norm] = simd::generic_simd_op(CosineFloatOp<16>(), a, b, length);
-        return sum / (std::sqrt(norm) * a_norm);
-    };
-};
+struct CosineBF16Op : public svs::simd::ConvertForBF16 {
+    using parent = svs::simd::ConvertForBF16;
+    using reg_t = typename parent::reg_t;
+    using mask_t = typename parent::mask_t;
 
-template <size_t N> struct CosineSimilarityImpl<N, float, int8_t> {
-    SVS_NOINLINE static float
-    compute(const float* a, const int8_t* b, float a_norm, lib::MaybeStatic<N> length) {
-        auto [sum, norm] = simd::generic_simd_op(CosineFloatOp<16>(), a, b, length);
-        return sum / (std::sqrt(norm) * a_norm);
+    // Partial results for the inner product and the norm of the right-hand argument.
+    struct Pair {
+        __m512 op;
+        __m512 norm;
     };
+
+    static Pair init() { return {_mm512_setzero_ps(), _mm512_setzero_ps()}; };
+
+    static Pair accumulate(Pair accumulator, reg_t a, reg_t b) {
+        return {
+            _mm512_dpbf16_ps(accumulator.op, a, b),
+            _mm512_dpbf16_ps(accumulator.norm, b, b)};
+    }
+
+    // Masked lanes are loaded as zeros and contribute nothing to the accumulators.
+    static Pair accumulate(mask_t SVS_UNUSED(m), Pair accumulator, reg_t a, reg_t b) {
+        return accumulate(accumulator, a, b);
+    }
+
+    static Pair combine(Pair x, Pair y) {
+        return {_mm512_add_ps(x.op, y.op), _mm512_add_ps(x.norm, y.norm)};
+    }
+
+    static std::pair<float, float> reduce(Pair x) {
+        return std::make_pair(_mm512_reduce_add_ps(x.op), _mm512_reduce_add_ps(x.norm));
+    }
 };
 
-template <size_t N> struct CosineSimilarityImpl<N, float, Float16> {
-    SVS_NOINLINE static float
-    compute(const float* a, const Float16* b, float a_norm, lib::MaybeStatic<N> length) {
-        auto [sum, norm] = simd::generic_simd_op(CosineFloatOp<16>(), a, b, length);
+template <size_t N>
+struct CosineSimilarityKernel<arch::ISA::avx512bf16, N, BFloat16, BFloat16> {
+    SVS_NOINLINE static float compute(
+        const BFloat16* a, const BFloat16* b, float a_norm, lib::MaybeStatic<N> length
+    ) {
+        auto [sum, norm] = simd::generic_simd_op(CosineBF16Op(), a, b, length);
         return sum / (std::sqrt(norm) * a_norm);
     }
 };
+
+SVS_END_TARGET
 #endif
+
 } // namespace svs::distance
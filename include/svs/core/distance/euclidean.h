@@ -14,6 +14,8 @@
 // svs
 #include "svs/core/distance/distance_core.h"
 #include "svs/core/distance/simd_utils.h"
+#include "svs/lib/arch.h"
+#include "svs/lib/bfloat16.h"
 #include "svs/lib/float16.h"
 #include "svs/lib/preprocessor.h"
 #include "svs/lib/saveload.h"
@@ -36,9 +38,11 @@
 // Intel(R) AVX extension and the preferred vector width due to performance (sometimes, smaller
 // vector widths are faster).
 //
-// Versions for older extensions are implemented as fallbacks.
+// Versions for older extensions are implemented as fallbacks. Each version is a
+// specialization of `L2Kernel` for the corresponding `arch::ISA` and the best available
+// version is selected by `simd::Dispatcher`. In runtime dispatch builds, versions for all
+// extensions are compiled and selection is made based on the host processor.
 //
-// TODO: Implement testing for non-Intel(R) AVX-512 implementations.
 // TODO: Alphabetize implementations.
 // TODO: Refactor distance computation implementation to avoid the need to explicitly
 // implement kernels for all type combinations.
@@ -51,6 +55,12 @@
 // - Intel(R) AVX2, Vector Width 8 (smaller vector width is faster.
 // - [[TODO]]: What is the correct check for the `_mm256_cvtph_ps` intrinsic?
 //
+// <float,BFloat16> and <BFloat16,BFloat16>
+// - AVX512F, Vector Width 16 (promotes to float32 by shifting).
+// - Intel(R) AVX2, Vector Width 8 (promotes to float32 by shifting).
+// - Intel(R) AVX-512 BF16 is not used since the difference of two bfloat16 vectors would
+//   need to be rounded back to bfloat16 before the dot product.
+//
 // <int8_t,float>
 // - AVX512F, Vector Width 16 (promotes to float32).
 //
@@ -173,10 +183,21 @@ float generic_l2(
     return result;
 }
 
+// Implementations of the kernel for each instruction set level.
+// Only the generic implementation is required. See `simd::Dispatcher`.
+template <arch::ISA Isa, size_t N, typename Ea, typename Eb> struct L2Kernel;
+
+template <size_t N, typename Ea, typename Eb>
+struct L2Kernel<arch::ISA::generic, N, Ea, Eb> {
+    static float compute(const Ea* a, const Eb* b, lib::MaybeStatic<N> length) {
+        return generic_l2(a, b, length);
+    }
+};
+
 template <size_t N, typename Ea, typename Eb> struct L2Impl {
-    static constexpr float
+    static float
     compute(const Ea* a, const Eb* b, lib::MaybeStatic<N> length = lib::MaybeStatic<N>()) {
-        return generic_l2(a, b, length);
+        return simd::Dispatcher<L2Kernel, N, Ea, Eb>::compute(a, b, length);
     }
 };
 
@@ -192,8 +213,9 @@ template <size_t SIMDWidth> struct L2FloatOp;
 // ``To`` and perform arithmetic on those integer operands.
 template <std::integral To, size_t SIMDWidth> struct L2VNNIOp;
 
-SVS_VALIDATE_BOOL_ENV(SVS_AVX512_F)
-#if SVS_AVX512_F
+SVS_VALIDATE_BOOL_ENV(SVS_BUILD_AVX512_F)
+#if SVS_BUILD_AVX512_F
+SVS_BEGIN_TARGET_AVX512_F
 
 template <> struct L2FloatOp<16> : public svs::simd::ConvertToFloat<16> {
     using parent = svs::simd::ConvertToFloat<16>;
@@ -216,107 +238,134 @@ template <> struct L2FloatOp<16> : public svs::simd::ConvertToFloat<16> {
     static float reduce(__m512 x) { return _mm512_reduce_add_ps(x); }
 };
 
-// Small Integers
-SVS_VALIDATE_BOOL_ENV(SVS_AVX512_VNNI)
-#if SVS_AVX512_VNNI
-
-template <> struct L2VNNIOp<int16_t, 32> : public svs::simd::ConvertForVNNI<int16_t, 32> {
-    using parent = svs::simd::ConvertForVNNI<int16_t, 32>;
-    using reg_t = typename parent::reg_t;
-    using mask_t = typename parent::mask_t;
-
-    SVS_FORCE_INLINE static reg_t init() { return _mm512_setzero_si512(); }
-    SVS_FORCE_INLINE static reg_t accumulate(reg_t accumulator, reg_t a, reg_t b) {
-        auto c = _mm512_sub_epi16(a, b);
-        return _mm512_dpwssd_epi32(accumulator, c, c);
-    }
-
-    SVS_FORCE_INLINE static reg_t
-    accumulate(mask_t m, reg_t accumulator, reg_t a, reg_t b) {
-        auto c = _mm512_maskz_sub_epi16(m, a, b);
-        // `c` already contains zeros, so no need to mask the accumulation operation.
-        return _mm512_mask_dpwssd_epi32(accumulator, m, c, c);
-    }
-
-    SVS_FORCE_INLINE static reg_t combine(reg_t x, reg_t y) {
-        return _mm512_add_epi32(x, y);
+// Floating and Mixed Types
+template <size_t N> struct L2Kernel<arch::ISA::avx512f, N, float, float> {
+    SVS_NOINLINE static float
+    compute(const float* a, const float* b, lib::MaybeStatic<N> length) {
+        return simd::generic_simd_op(L2FloatOp<16>{}, a, b, length);
     }
+};
 
-    SVS_FORCE_INLINE static float reduce(reg_t x) {
-        return lib::narrow_cast<float>(_mm512_reduce_add_epi32(x));
-    }
+template <size_t N> struct L2Kernel<arch::ISA::avx512f, N, float, uint8_t> {
+    SVS_NOINLINE static float
+    compute(const float* a, const uint8_t* b, lib::MaybeStatic<N> length) {
+        return simd::generic_simd_op(L2FloatOp<16>{}, a, b, length);
+    };
 };
 
-// VNNI Dispatching
-template <size_t N> struct L2Impl<N, int8_t, int8_t> {
+template <size_t N> struct L2Kernel<arch::ISA::avx512f, N, float, int8_t> {
     SVS_NOINLINE static float
-    compute(const int8_t* a, const int8_t* b, lib::MaybeStatic<N> length) {
-        return simd::generic_simd_op(L2VNNIOp<int16_t, 32>(), a, b, length);
-    }
+    compute(const float* a, const int8_t* b, lib::MaybeStatic<N> length) {
+        return simd::generic_simd_op(L2FloatOp<16>{}, a, b, length);
+    };
 };
 
-template <size_t N> struct L2Impl<N, uint8_t, uint8_t> {
+template <size_t N> struct L2Kernel<arch::ISA::avx512f, N, float, Float16> {
     SVS_NOINLINE static float
-    compute(const uint8_t* a, const uint8_t* b, lib::MaybeStatic<N> length) {
-        return simd::generic_simd_op(L2VNNIOp<int16_t, 32>(), a, b, length);
+    compute(const float* a, const Float16* b, lib::MaybeStatic<N> length) {
+        return simd::generic_simd_op(L2FloatOp<16>{}, a, b, length);
     }
 };
 
-#endif
-
-// Floating and Mixed Types
-template <size_t N> struct L2Impl<N, float, float> {
+template <size_t N> struct L2Kernel<arch::ISA::avx512f, N, Float16, float> {
     SVS_NOINLINE static float
-    compute(const float* a, const float* b, lib::MaybeStatic<N> length) {
+    compute(const Float16* a, const float* b, lib::MaybeStatic<N> length) {
         return simd::generic_simd_op(L2FloatOp<16>{}, a, b, length);
     }
 };
 
-template <size_t N> struct L2Impl<N, float, uint8_t> {
+template <size_t N> struct L2Kernel<arch::ISA::avx512f, N, Float16, Float16> {
     SVS_NOINLINE static float
-    compute(const float* a, const uint8_t* b, lib::MaybeStatic<N> length) {
+    compute(const Float16* a, const Float16* b, lib::MaybeStatic<N> length) {
         return simd::generic_simd_op(L2FloatOp<16>{}, a, b, length);
     };
 };
 
-template <size_t N> struct L2Impl<N, float, int8_t> {
+template <size_t N> struct L2Kernel<arch::ISA::avx512f, N, float, BFloat16> {
     SVS_NOINLINE static float
-    compute(const float* a, const int8_t* b, lib::MaybeStatic<N> length) {
+    compute(const float* a, const BFloat16* b, lib::MaybeStatic<N> length) {
         return simd::generic_simd_op(L2FloatOp<16>{}, a, b, length);
-    };
+    }
 };
 
-template <size_t N> struct L2Impl<N, float, Float16> {
+template <size_t N> struct L2Kernel<arch::ISA::avx512f, N, BFloat16, float> {
     SVS_NOINLINE static float
-    compute(const float* a, const Float16* b, lib::MaybeStatic<N> length) {
+    compute(const BFloat16* a, const float* b, lib::MaybeStatic<N> length) {
         return simd::generic_simd_op(L2FloatOp<16>{}, a, b, length);
     }
 };
 
-template <size_t N> struct L2Impl<N, Float16, float> {
+template <size_t N> struct L2Kernel<arch::ISA::avx512f, N, BFloat16, BFloat16> {
     SVS_NOINLINE static float
-    compute(const Float16* a, const float* b, lib::MaybeStatic<N> length) {
+    compute(const BFloat16* a, const BFloat16* b, lib::MaybeStatic<N> length) {
         return simd::generic_simd_op(L2FloatOp<16>{}, a, b, length);
     }
 };
 
-template <size_t N> struct L2Impl<N, Float16, Float16> {
+SVS_END_TARGET
+#endif
+
+// Small Integers
+//
+// The methods of VNNI operations use `SVS_TARGET_INLINE`. See `simd::ConvertForVNNI`.
+SVS_VALIDATE_BOOL_ENV(SVS_BUILD_AVX512_VNNI)
+#if SVS_BUILD_AVX512_VNNI
+SVS_BEGIN_TARGET_AVX512_VNNI
+
+template <> struct L2VNNIOp<int16_t, 32> : public svs::simd::ConvertForVNNI<int16_t, 32> {
+    using parent = svs::simd::ConvertForVNNI<int16_t, 32>;
+    using reg_t = typename parent::reg_t;
+    using mask_t = typename parent::mask_t;
+
+    SVS_TARGET_INLINE static reg_t init() { return _mm512_setzero_si512(); }
+    SVS_TARGET_INLINE static reg_t accumulate(reg_t accumulator, reg_t a, reg_t b) {
+        auto c = _mm512_sub_epi16(a, b);
+        return _mm512_dpwssd_epi32(accumulator, c, c);
+    }
+
+    SVS_TARGET_INLINE static reg_t
+    accumulate(mask_t m, reg_t accumulator, reg_t a, reg_t b) {
+        auto c = _mm512_maskz_sub_epi16(m, a, b);
+        // `c` already contains zeros, so no need to mask the accumulation operation.
+        return _mm512_mask_dpwssd_epi32(accumulator, m, c, c);
+    }
+
+    SVS_TARGET_INLINE static reg_t combine(reg_t x, reg_t y) {
+        return _mm512_add_epi32(x, y);
+    }
+
+    SVS_TARGET_INLINE static float reduce(reg_t x) {
+        return lib::narrow_cast<float>(_mm512_reduce_add_epi32(x));
+    }
+};
+
+// VNNI Dispatching
+template <size_t N> struct L2Kernel<arch::ISA::avx512vnni, N, int8_t, int8_t> {
     SVS_NOINLINE static float
-    compute(const Float16* a, const Float16* b, lib::MaybeStatic<N> length) {
-        return simd::generic_simd_op(L2FloatOp<16>{}, a, b, length);
-    };
+    compute(const int8_t* a, const int8_t* b, lib::MaybeStatic<N> length) {
+        return simd::generic_simd_op(L2VNNIOp<int16_t, 32>(), a, b, length);
+    }
 };
 
+template <size_t N> struct L2Kernel<arch::ISA::avx512vnni, N, uint8_t, uint8_t> {
+    SVS_NOINLINE static float
+    compute(const uint8_t* a, const uint8_t* b, lib::MaybeStatic<N> length) {
+        return simd::generic_simd_op(L2VNNIOp<int16_t, 32>(), a, b, length);
+    }
+};
+
+SVS_END_TARGET
 #endif
 
 /////
 ///// Intel(R) AVX2 Implementations
 /////
 
-SVS_VALIDATE_BOOL_ENV(SVS_AVX512_F)
-SVS_VALIDATE_BOOL_ENV(SVS_AVX2)
-#if !SVS_AVX512_F && SVS_AVX2
-template <size_t N> struct L2Impl<N, float, float> {
+SVS_VALIDATE_BOOL_ENV(SVS_BUILD_AVX2)
+#if SVS_BUILD_AVX2
+SVS_BEGIN_TARGET_AVX2
+
+template <size_t N> struct L2Kernel<arch::ISA::avx2, N, float, float> {
     SVS_NOINLINE static float
     compute(const float* a, const float* b, lib::MaybeStatic<N> length) {
         constexpr size_t vector_size = 8;
@@ -336,7 +385,7 @@ template <size_t N> struct L2Impl<N, float, float> {
     }
 };
 
-template <size_t N> struct L2Impl<N, Float16, Float16> {
+template <size_t N> struct L2Kernel<arch::ISA::avx2, N, Float16, Float16> {
     SVS_NOINLINE static float
     compute(const Float16* a, const Float16* b, lib::MaybeStatic<N> length) {
         constexpr size_t vector_size = 8;
@@ -358,7 +407,7 @@ template <size_t N> struct L2Impl<N, Float16, Float16> {
     }
 };
 
-template <size_t N> struct L2Impl<N, float, Float16> {
+template <size_t N> struct L2Kernel<arch::ISA::avx2, N, float, Float16> {
     SVS_NOINLINE static float
     compute(const float* a, const Float16* b, lib::MaybeStatic<N> length) {
         constexpr size_t vector_size = 8;
@@ -379,7 +428,47 @@ template <size_t N> struct L2Impl<N, float, Float16> {
     }
 };
 
-template <size_t N> struct L2Impl<N, float, int8_t> {
+template <size_t N> struct L2Kernel<arch::ISA::avx2, N, BFloat16, BFloat16> {
+    SVS_NOINLINE static float
+    compute(const BFloat16* a, const BFloat16* b, lib::MaybeStatic<N> length) {
+        constexpr size_t vector_size = 8;
+
+        // Peel off the last iterations if the SIMD vector width does not evenly the total
+        // vector width.
+        size_t upper = lib::upper<vector_size>(length);
+        auto rest = lib::rest<vector_size>(length);
+        auto sum = _mm256_setzero_ps();
+        for (size_t j = 0; j < upper; j += vector_size) {
+            auto va = simd::load_bfloat16(a + j);
+            auto vb = simd::load_bfloat16(b + j);
+            auto tmp = _mm256_sub_ps(va, vb);
+            sum = _mm256_fmadd_ps(tmp, tmp, sum);
+        }
+        return simd::_mm256_reduce_add_ps(sum) + generic_l2(a + upper, b + upper, rest);
+    }
+};
+
+template <size_t N> struct L2Kernel<arch::ISA::avx2, N, float, BFloat16> {
+    SVS_NOINLINE static float
+    compute(const float* a, const BFloat16* b, lib::MaybeStatic<N> length) {
+        constexpr size_t vector_size = 8;
+
+        // Peel off the last iterations if the SIMD vector width does not evenly the total
+        // vector width.
+        size_t upper = lib::upper<vector_size>(length);
+        auto rest = lib::rest<vector_size>(length);
+        auto sum = _mm256_setzero_ps();
+        for (size_t j = 0; j < upper; j += vector_size) {
+            auto va = _mm256_loadu_ps(a + j);
+            auto vb = simd::load_bfloat16(b + j);
+            auto tmp = _mm256_sub_ps(va, vb);
+            sum = _mm256_fmadd_ps(tmp, tmp, sum);
+        }
+        return simd::_mm256_reduce_add_ps(sum) + generic_l2(a + upper, b + upper, rest);
+    }
+};
+
+template <size_t N> struct L2Kernel<arch::ISA::avx2, N, float, int8_t> {
     SVS_NOINLINE static float
     compute(const float* a, const int8_t* b, lib::MaybeStatic<N> length) {
         constexpr size_t vector_size = 8;
@@ -403,7 +492,7 @@ template <size_t N> struct L2Impl<N, float, int8_t> {
     }
 };
 
-template <size_t N> struct L2Impl<N, int8_t, int8_t> {
+template <size_t N> struct L2Kernel<arch::ISA::avx2, N, int8_t, int8_t> {
     SVS_NOINLINE static float
     compute(const int8_t* a, const int8_t* b, lib::MaybeStatic<N> length) {
         constexpr size_t vector_size = 8;
@@ -430,7 +519,7 @@ template <size_t N> struct L2Impl<N, int8_t, int8_t> {
     }
 };
 
-template <size_t N> struct L2Impl<N, uint8_t, uint8_t> {
+template <size_t N> struct L2Kernel<arch::ISA::avx2, N, uint8_t, uint8_t> {
     SVS_NOINLINE static float
     compute(const uint8_t* a, const uint8_t* b, lib::MaybeStatic<N> length) {
         constexpr size_t vector_size = 8;
@@ -457,5 +546,7 @@ template <size_t N> struct L2Impl<N, uint8_t, uint8_t> {
     }
 };
 
+SVS_END_TARGET
 #endif
+
 } // namespace svs::distance
@@ -14,6 +14,8 @@
 // svs
 #include "svs/core/distance/distance_core.h"
 #include "svs/core/distance/simd_utils.h"
+#include "svs/lib/arch.h"
+#include "svs/lib/bfloat16.h"
 #include "svs/lib/float16.h"
 #include "svs/lib/preprocessor.h"
 #include "svs/lib/saveload.h"
@@ -134,10 +136,21 @@ float generic_ip(
     return result;
 }
 
+// Implementations of the kernel for each instruction set level.
+// Only the generic implementation is required. See `simd::Dispatcher`.
+template <arch::ISA Isa, size_t N, typename Ea, typename Eb> struct IPKernel;
+
+template <size_t N, typename Ea, typename Eb>
+struct IPKernel<arch::ISA::generic, N, Ea, Eb> {
+    static float compute(const Ea* a, const Eb* b, lib::MaybeStatic<N> length) {
+        return generic_ip(a, b, length);
+    }
+};
+
 template <size_t N, typename Ea, typename Eb> struct IPImpl {
     static float
     compute(const Ea* a, const Eb* b, lib::MaybeStatic<N> length = lib::MaybeStatic<N>()) {
-        return generic_ip(a, b, length);
+        return simd::Dispatcher<IPKernel, N, Ea, Eb>::compute(a, b, length);
     }
 };
 
@@ -152,8 +165,12 @@ template <size_t SIMDWidth> struct IPFloatOp;
 // ``To`` and perform arithmetic on those integer operands.
 template <std::integral To, size_t SIMDWidth> struct IPVNNIOp;
 
-SVS_VALIDATE_BOOL_ENV(SVS_AVX512_F)
-#if SVS_AVX512_F
+// SIMD accelerated operations on pairs of ``BFloat16`` using Intel(R) AVX-512 BF16.
+struct IPBF16Op;
+
+SVS_VALIDATE_BOOL_ENV(SVS_BUILD_AVX512_F)
+#if SVS_BUILD_AVX512_F
+SVS_BEGIN_TARGET_AVX512_F
 
 template <> struct IPFloatOp<16> : public svs::simd::ConvertToFloat<16> {
     using parent = svs::simd::ConvertToFloat<16>;
@@ -174,103 +191,169 @@ template <> struct IPFloatOp<16> : public svs::simd::ConvertToFloat<16> {
     static float reduce(__m512 x) { return _mm512_reduce_add_ps(x); }
 };
 
+// Floating and Mixed Types
+template <size_t N> struct IPKernel<arch::ISA::avx512f, N, float, float> {
+    SVS_NOINLINE static float
+    compute(const float* a, const float* b, lib::MaybeStatic<N> length) {
+        return svs::simd::generic_simd_op(IPFloatOp<16>{}, a, b, length);
+    }
+};
+
+template <size_t N> struct IPKernel<arch::ISA::avx512f, N, float, uint8_t> {
+    SVS_NOINLINE static float
+    compute(const float* a, const uint8_t* b, lib::MaybeStatic<N> length) {
+        return svs::simd::generic_simd_op(IPFloatOp<16>{}, a, b, length);
+    };
+};
+
+template <size_t N> struct IPKernel<arch::ISA::avx512f, N, float, int8_t> {
+    SVS_NOINLINE static float
+    compute(const float* a, const int8_t* b, lib::MaybeStatic<N> length) {
+        return svs::simd::generic_simd_op(IPFloatOp<16>{}, a, b, length);
+    };
+};
+
+template <size_t N> struct IPKernel<arch::ISA::avx512f, N, float, Float16> {
+    SVS_NOINLINE static float
+    compute(const float* a, const Float16* b, lib::MaybeStatic<N> length) {
+        return svs::simd::generic_simd_op(IPFloatOp<16>{}, a, b, length);
+    }
+};
+
+template <size_t N> struct IPKernel<arch::ISA::avx512f, N, Float16, float> {
+    SVS_NOINLINE static float
+    compute(const Float16* a, const float* b, lib::MaybeStatic<N> length) {
+        return svs::simd::generic_simd_op(IPFloatOp<16>{}, a, b, length);
+    }
+};
+
+template <size_t N> struct IPKernel<arch::ISA::avx512f, N, Float16, Float16> {
+    SVS_NOINLINE static float
+    compute(const Float16* a, const Float16* b, lib::MaybeStatic<N> length) {
+        return svs::simd::generic_simd_op(IPFloatOp<16>{}, a, b, length);
+    }
+};
+
+template <size_t N> struct IPKernel<arch::ISA::avx512f, N, float, BFloat16> {
+    SVS_NOINLINE static float
+    compute(const float* a, const BFloat16* b, lib::MaybeStatic<N> length) {
+        return svs::simd::generic_simd_op(IPFloatOp<16>{}, a, b, length);
+    }
+};
+
+template <size_t N> struct IPKernel<arch::ISA::avx512f, N, BFloat16, float> {
+    SVS_NOINLINE static float
+    compute(const BFloat16* a, const float* b, lib::MaybeStatic<N> length) {
+        return svs::simd::generic_simd_op(IPFloatOp<16>{}, a, b, length);
+    }
+};
+
+template <size_t N> struct IPKernel<arch::ISA::avx512f, N, BFloat16, BFloat16> {
+    SVS_NOINLINE static float
+    compute(const BFloat16* a, const BFloat16* b, lib::MaybeStatic<N> length) {
+        return svs::simd::generic_simd_op(IPFloatOp<16>{}, a, b, length);
+    }
+};
+
+SVS_END_TARGET
+#endif
+
 // Small Integers
-SVS_VALIDATE_BOOL_ENV(SVS_AVX512_VNNI)
-#if SVS_AVX512_VNNI
+//
+// The methods of VNNI operations use `SVS_TARGET_INLINE`. See `simd::ConvertForVNNI`.
+SVS_VALIDATE_BOOL_ENV(SVS_BUILD_AVX512_VNNI)
+#if SVS_BUILD_AVX512_VNNI
+SVS_BEGIN_TARGET_AVX512_VNNI
 
 template <> struct IPVNNIOp<int16_t, 32> : public svs::simd::ConvertForVNNI<int16_t, 32> {
     using parent = svs::simd::ConvertForVNNI<int16_t, 32>;
     using reg_t = typename parent::reg_t;
     using mask_t = typename parent::mask_t;
 
-    SVS_FORCE_INLINE static reg_t init() { return _mm512_setzero_si512(); }
-    SVS_FORCE_INLINE static reg_t accumulate(__m512i accumulator, __m512i a, __m512i b) {
+    SVS_TARGET_INLINE static reg_t init() { return _mm512_setzero_si512(); }
+    SVS_TARGET_INLINE static reg_t accumulate(__m512i accumulator, __m512i a, __m512i b) {
         return _mm512_dpwssd_epi32(accumulator, a, b);
     }
 
-    SVS_FORCE_INLINE static reg_t
+    SVS_TARGET_INLINE static reg_t
     accumulate(mask_t m, reg_t accumulator, reg_t a, reg_t b) {
         return _mm512_mask_dpwssd_epi32(accumulator, m, a, b);
     }
 
-    SVS_FORCE_INLINE static reg_t combine(reg_t x, reg_t y) {
+    SVS_TARGET_INLINE static reg_t combine(reg_t x, reg_t y) {
         return _mm512_add_epi32(x, y);
     }
 
-    SVS_FORCE_INLINE static float reduce(reg_t x) {
+    SVS_TARGET_INLINE static float reduce(reg_t x) {
         return lib::narrow_cast<float>(_mm512_reduce_add_epi32(x));
     }
 };
 
 // VNNI Dispatching
-template <size_t N> struct IPImpl<N, int8_t, int8_t> {
+template <size_t N> struct IPKernel<arch::ISA::avx512vnni, N, int8_t, int8_t> {
     SVS_NOINLINE static float
     compute(const int8_t* a, const int8_t* b, lib::MaybeStatic<N> length) {
         return simd::generic_simd_op(IPVNNIOp<int16_t, 32>(), a, b, length);
     }
 };
 
-template <size_t N> struct IPImpl<N, uint8_t, uint8_t> {
+template <size_t N> struct IPKernel<arch::ISA::avx512vnni, N, uint8_t, uint8_t> {
     SVS_NOINLINE static float
     compute(const uint8_t* a, const uint8_t* b, lib::MaybeStatic<N> length) {
         return simd::generic_simd_op(IPVNNIOp<int16_t, 32>(), a, b, length);
     }
 };
 
+SVS_END_TARGET
 #endif
 
-// Floating and Mixed Types
-template <size_t N> struct IPImpl<N, float, float> {
-    SVS_NOINLINE static float
-    compute(const float* a, const float* b, lib::MaybeStatic<N> length) {
-        return svs::simd::generic_simd_op(IPFloatOp<16>{}, a, b, length);
-    }
-};
-
-template <size_t N> struct IPImpl<N, float, uint8_t> {
-    SVS_NOINLINE static float
-    compute(const float* a, const uint8_t* b, lib::MaybeStatic<N> length) {
-        return svs::simd::generic_simd_op(IPFloatOp<16>{}, a, b, length);
-    };
-};
-
-template <size_t N> struct IPImpl<N, float, int8_t> {
-    SVS_NOINLINE static float
-    compute(const float* a, const int8_t* b, lib::MaybeStatic<N> length) {
-        return svs::simd::generic_simd_op(IPFloatOp<16>{}, a, b, length);
-    };
-};
+// Brain Floating Point
+//
+// Products of normal bfloat16 pairs are exact in single precision, so `_mm512_dpbf16_ps`
+// only changes the order of accumulation with respect to the Intel(R) AVX-512 kernel while
+// processing twice as many elements per instruction.
+SVS_VALIDATE_BOOL_ENV(SVS_BUILD_AVX512_BF16)
+#if SVS_BUILD_AVX512_BF16
+SVS_BEGIN_TARGET_AVX512_BF16
+
+struct IPBF16Op : public svs::simd::ConvertForBF16 {
+    using parent = svs::simd::ConvertForBF16;
+    using reg_t = typename parent::reg_t;
+    using mask_t = typename parent::mask_t;
 
-template <size_t N> struct IPImpl<N, float, Float16> {
-    SVS_NOINLINE static float
-    compute(const float* a, const Float16* b, lib::MaybeStatic<N> length) {
-        return svs::simd::generic_simd_op(IPFloatOp<16>{}, a, b, length);
+    static __m512 init() { return _mm512_setzero_ps(); }
+    static __m512 accumulate(__m512 accumulator, reg_t a, reg_t b) {
+        return _mm512_dpbf16_ps(accumulator, a, b);
     }
-};
 
-template <size_t N> struct IPImpl<N, Float16, float> {
-    SVS_NOINLINE static float
-    compute(const Float16* a, const float* b, lib::MaybeStatic<N> length) {
-        return svs::simd::generic_simd_op(IPFloatOp<16>{}, a, b, length);
+    // Masked lanes are loaded as zeros and contribute nothing to the accumulator.
+    static __m512 accumulate(mask_t SVS_UNUSED(m), __m512 accumulator, reg_t a, reg_t b) {
+        return _mm512_dpbf16_ps(accumulator, a, b);
     }
+
+    static __m512 combine(__m512 x, __m512 y) { return _mm512_add_ps(x, y); }
+    static float reduce(__m512 x) { return _mm512_reduce_add_ps(x); }
 };
 
-template <size_t N> struct IPImpl<N, Float16, Float16> {
+template <size_t N> struct IPKernel<arch::ISA::avx512bf16, N, BFloat16, BFloat16> {
     SVS_NOINLINE static float
-    compute(const Float16* a, const Float16* b, lib::MaybeStatic<N> length) {
-        return svs::simd::generic_simd_op(IPFloatOp<16>{}, a, b, length);
+    compute(const BFloat16* a, const BFloat16* b, lib::MaybeStatic<N> length) {
+        return simd::generic_simd_op(IPBF16Op(), a, b, length);
     }
 };
+
+SVS_END_TARGET
 #endif
 
 /////
 ///// Intel(R) AVX2 Implementations
 /////
 
-SVS_VALIDATE_BOOL_ENV(SVS_AVX512_F)
-SVS_VALIDATE_BOOL_ENV(SVS_AVX2)
-#if !SVS_AVX512_F && SVS_AVX2
-template <size_t N> struct IPImpl<N, float, float> {
+SVS_VALIDATE_BOOL_ENV(SVS_BUILD_AVX2)
+#if SVS_BUILD_AVX2
+SVS_BEGIN_TARGET_AVX2
+
+template <size_t N> struct IPKernel<arch::ISA::avx2, N, float, float> {
     SVS_NOINLINE static float
     compute(const float* a, const float* b, lib::MaybeStatic<N> length) {
         constexpr size_t vector_size = 8;
@@ -289,7 +372,7 @@ template <size_t N> struct IPImpl<N, float, float> {
     }
 };
 
-template <size_t N> struct IPImpl<N, Float16, Float16> {
+template <size_t N> struct IPKernel<arch::ISA::avx2, N, Float16, Float16> {
     SVS_NOINLINE static float
     compute(const Float16* a, const Float16* b, lib::MaybeStatic<N> length) {
         constexpr size_t vector_size = 8;
@@ -310,7 +393,7 @@ template <size_t N> struct IPImpl<N, Float16, Float16> {
     }
 };
 
-template <size_t N> struct IPImpl<N, float, Float16> {
+template <size_t N> struct IPKernel<arch::ISA::avx2, N, float, Float16> {
     SVS_NOINLINE static float
     compute(const float* a, const Float16* b, lib::MaybeStatic<N> length) {
         constexpr size_t vector_size = 8;
@@ -330,7 +413,45 @@ template <size_t N> struct IPImpl<N, float, Float16> {
     }
 };
 
-template <size_t N> struct IPImpl<N, float, int8_t> {
+template <size_t N> struct IPKernel<arch::ISA::avx2, N, BFloat16, BFloat16> {
+    SVS_NOINLINE static float
+    compute(const BFloat16* a, const BFloat16* b, lib::MaybeStatic<N> length) {
+        constexpr size_t vector_size = 8;
+
+        // Peel off the last iterations if the SIMD vector width does not evenly the total
+        // vector width.
+        size_t upper = lib::upper<vector_size>(length);
+        auto rest = lib::rest<vector_size>(length);
+        auto sum = _mm256_setzero_ps();
+        for (size_t j = 0; j < upper; j += vector_size) {
+            auto va = simd::load_bfloat16(a + j);
+            auto vb = simd::load_bfloat16(b + j);
+            sum = _mm256_fmadd_ps(va, vb, sum);
+        }
+        return simd::_mm256_reduce_add_ps(sum) + generic_ip(a + upper, b + upper, rest);
+    }
+};
+
+template <size_t N> struct IPKernel<arch::ISA::avx2, N, float, BFloat16> {
+    SVS_NOINLINE static float
+    compute(const float* a, const BFloat16* b, lib::MaybeStatic<N> length) {
+        constexpr size_t vector_size = 8;
+
+        // Peel off the last iterations if the SIMD vector width does not evenly the total
+        // vector width.
+        size_t upper = lib::upper<vector_size>(length);
+        auto rest = lib::rest<vector_size>(length);
+        auto sum = _mm256_setzero_ps();
+        for (size_t j = 0; j < upper; j += vector_size) {
+            auto va = _mm256_loadu_ps(a + j);
+            auto vb = simd::load_bfloat16(b + j);
+            sum = _mm256_fmadd_ps(va, vb, sum);
+        }
+        return simd::_mm256_reduce_add_ps(sum) + generic_ip(a + upper, b + upper, rest);
+    }
+};
+
+template <size_t N> struct IPKernel<arch::ISA::avx2, N, float, int8_t> {
     SVS_NOINLINE static float
     compute(const float* a, const int8_t* b, lib::MaybeStatic<N> length) {
         constexpr size_t vector_size = 8;
@@ -353,7 +474,7 @@ template <size_t N> struct IPImpl<N, float, int8_t> {
     }
 };
 
-template <size_t N> struct IPImpl<N, int8_t, int8_t> {
+template <size_t N> struct IPKernel<arch::ISA::avx2, N, int8_t, int8_t> {
     SVS_NOINLINE static float
     compute(const int8_t* a, const int8_t* b, lib::MaybeStatic<N> length) {
         constexpr size_t vector_size = 8;
@@ -379,7 +500,7 @@ template <size_t N> struct IPImpl<N, int8_t, int8_t> {
     }
 };
 
-template <size_t N> struct IPImpl<N, uint8_t, uint8_t> {
+template <size_t N> struct IPKernel<arch::ISA::avx2, N, uint8_t, uint8_t> {
     SVS_NOINLINE static float
     compute(const uint8_t* a, const uint8_t* b, lib::MaybeStatic<N> length) {
         constexpr size_t vector_size = 8;
@@ -405,5 +526,7 @@ template <size_t N> struct IPImpl<N, uint8_t, uint8_t> {
     }
 };
 
+SVS_END_TARGET
 #endif
+
 } // namespace svs::distance
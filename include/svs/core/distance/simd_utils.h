@@ -12,17 +12,25 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <limits>
 #include <type_traits>
 
 #include "x86intrin.h"
 
+#include "svs/lib/arch.h"
+#include "svs/lib/bfloat16.h"
 #include "svs/lib/float16.h"
+#include "svs/lib/preprocessor.h"
 #include "svs/lib/static.h"
 
 namespace svs {
 namespace simd {
 
+SVS_VALIDATE_BOOL_ENV(SVS_BUILD_AVX2)
+#if SVS_BUILD_AVX2
+SVS_BEGIN_TARGET_AVX2
+
 inline float _mm256_reduce_add_ps(__m256 x) {
     const float* base = reinterpret_cast<float*>(&x);
     float sum{0};
@@ -31,6 +39,15 @@ inline float _mm256_reduce_add_ps(__m256 x) {
     }
     return sum;
 }
+
+// Load 8 bfloat16 values and widen them to single precision.
+inline __m256 load_bfloat16(const BFloat16* ptr) {
+    auto x = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr)));
+    return _mm256_castsi256_ps(_mm256_slli_epi32(x, 16));
+}
+
+SVS_END_TARGET
+#endif
 } // namespace simd
 
 namespace detail {
@@ -94,11 +111,125 @@ template <size_t VecLength> constexpr mask_intrinsic_from_length_t<VecLength> no
     return std::numeric_limits<mask_repr_t<VecLength>>::max();
 }
 
+namespace simd {
+
+/////
+///// Kernel Dispatch
+/////
+
+///
+/// @brief Select among the implementations of a distance kernel.
+///
+/// @tparam Kernel A class template ``Kernel<arch::ISA, N, Ea, Eb>`` with a static
+///     ``compute`` method. The specialization for ``arch::ISA::generic`` must always be
+///     defined. Specializations for other instruction set levels are optional and must
+///     share the signature of the generic ``compute`` method.
+///
+/// In runtime dispatch builds, the best implementation supported by the host is resolved
+/// the first time ``compute`` is called and stored in a constant-initialized function
+/// pointer, so later calls are a single indirect call with no initialization guard.
+/// Otherwise, the best compiled implementation is called directly.
+///
+template <
+    template <arch::ISA, size_t, typename, typename>
+    typename Kernel,
+    size_t N,
+    typename Ea,
+    typename Eb>
+class Dispatcher {
+  public:
+    using generic_type = Kernel<arch::ISA::generic, N, Ea, Eb>;
+    using function_type = decltype(&generic_type::compute);
+
+    /// Return whether an implementation of the kernel exists for `isa` in this build.
+    template <arch::ISA isa> static constexpr bool has_kernel() {
+        return requires { &Kernel<isa, N, Ea, Eb>::compute; };
+    }
+
+    /// Return whether the generic implementation is the only implementation.
+    static constexpr bool generic_only() {
+        return !has_kernel<arch::ISA::avx2>() && !has_kernel<arch::ISA::avx512f>() &&
+               !has_kernel<arch::ISA::avx512vnni>() && !has_kernel<arch::ISA::avx512bf16>();
+    }
+
+    /// Return the best implementation that may execute on the given instruction set level.
+    static function_type resolve(arch::ISA isa) {
+        if constexpr (has_kernel<arch::ISA::avx512bf16>()) {
+            if (isa >= arch::ISA::avx512bf16) {
+                return &Kernel<arch::ISA::avx512bf16, N, Ea, Eb>::compute;
+            }
+        }
+        if constexpr (has_kernel<arch::ISA::avx512vnni>()) {
+            if (isa >= arch::ISA::avx512vnni) {
+                return &Kernel<arch::ISA::avx512vnni, N, Ea, Eb>::compute;
+            }
+        }
+        if constexpr (has_kernel<arch::ISA::avx512f>()) {
+            if (isa >= arch::ISA::avx512f) {
+                return &Kernel<arch::ISA::avx512f, N, Ea, Eb>::compute;
+            }
+        }
+        if constexpr (has_kernel<arch::ISA::avx2>()) {
+            if (isa >= arch::ISA::avx2) {
+                return &Kernel<arch::ISA::avx2, N, Ea, Eb>::compute;
+            }
+        }
+        return &generic_type::compute;
+    }
+
+    template <typename... Args> SVS_FORCE_INLINE static float compute(Args... args) {
+        if constexpr (generic_only()) {
+            return generic_type::compute(args...);
+        } else {
+#if SVS_RUNTIME_DISPATCH
+            return function_.load(std::memory_order_relaxed)(args...);
+#else
+            return Kernel<best_compiled(), N, Ea, Eb>::compute(args...);
+#endif
+        }
+    }
+
+  private:
+#if SVS_RUNTIME_DISPATCH
+    // Initial target of `function_`. Resolves the implementation, replaces itself and
+    // forwards the call. Racing first calls resolve to the same implementation.
+    template <typename F> struct Resolver;
+    template <typename R, typename... Args> struct Resolver<R (*)(Args...)> {
+        static R compute(Args... args) {
+            auto f = resolve(arch::runtime_isa());
+            function_.store(f, std::memory_order_relaxed);
+            return f(args...);
+        }
+    };
+
+    static constinit inline std::atomic<function_type> function_{
+        &Resolver<function_type>::compute};
+#endif
+
+    static constexpr arch::ISA best_compiled() {
+        if constexpr (has_kernel<arch::ISA::avx512bf16>()) {
+            return arch::ISA::avx512bf16;
+        } else if constexpr (has_kernel<arch::ISA::avx512vnni>()) {
+            return arch::ISA::avx512vnni;
+        } else if constexpr (has_kernel<arch::ISA::avx512f>()) {
+            return arch::ISA::avx512f;
+        } else if constexpr (has_kernel<arch::ISA::avx2>()) {
+            return arch::ISA::avx2;
+        } else {
+            return arch::ISA::generic;
+        }
+    }
+};
+
 /////
 ///// A generic SIMD op.
 /////
 
-namespace simd {
+// In runtime dispatch builds, the generic SIMD op and the helpers below are compiled for
+// Intel(R) AVX-512 and may only be called from kernels compiled for at least that level.
+SVS_VALIDATE_BOOL_ENV(SVS_BUILD_AVX512_F)
+#if SVS_BUILD_AVX512_F
+SVS_BEGIN_TARGET_AVX512_F
 
 /// @brief A common generic routine for SIMD distance kernels.
 ///
@@ -243,11 +374,15 @@ generic_simd_op(Op op, const Ea* a, const Eb* b, lib::MaybeStatic<N> count) {
     return op.reduce(s0);
 }
 
+SVS_END_TARGET
+#endif
+
 // A utility base class for converting simd-converting to floating point.
 template <size_t SIMDWidth> struct ConvertToFloat;
 
-SVS_VALIDATE_BOOL_ENV(SVS_AVX512_F)
-#if SVS_AVX512_F
+SVS_VALIDATE_BOOL_ENV(SVS_BUILD_AVX512_F)
+#if SVS_BUILD_AVX512_F
+SVS_BEGIN_TARGET_AVX512_F
 
 // Common implementations for converting arguments to floats.
 // Partially satisfies the requirements for a `generic_simd_op` operation.
@@ -268,6 +403,18 @@ template <> struct ConvertToFloat<16> {
         return _mm512_cvtph_ps(_mm256_maskz_loadu_epi16(m, ptr));
     }
 
+    // from bfloat16
+    // Widening is exact: zero-extend to 32-bits and shift into the upper half.
+    static __m512 load(const BFloat16* ptr) {
+        auto x = _mm512_cvtepu16_epi32(_mm256_loadu_epi16(ptr));
+        return _mm512_castsi512_ps(_mm512_slli_epi32(x, 16));
+    }
+
+    static __m512 load(mask_t m, const BFloat16* ptr) {
+        auto x = _mm512_cvtepu16_epi32(_mm256_maskz_loadu_epi16(m, ptr));
+        return _mm512_castsi512_ps(_mm512_slli_epi32(x, 16));
+    }
+
     // from int8
     static __m512 load(const uint8_t* ptr) {
         return _mm512_cvtepi32_ps(_mm512_cvtepu8_epi32(_mm_loadu_epi8(ptr)));
@@ -292,6 +439,7 @@ template <> struct ConvertToFloat<16> {
     template <typename B> static __m512 load_b(mask_t m, const B* b) { return load(m, b); }
 };
 
+SVS_END_TARGET
 #endif
 
 // A base class used for customizing generic SIMD operations using VNNI instructions.
@@ -315,10 +463,16 @@ template <> struct ConvertToFloat<16> {
 // @endcode
 //
 // The behavior of ``load_a`` and ``load_b`` is identical.
+//
+// In runtime dispatch builds, these methods are compiled for a superset of the extensions
+// enabled for ``generic_simd_op`` and so are not forcibly inlined (see
+// ``SVS_TARGET_INLINE``). They are inlined once ``generic_simd_op`` has itself been inlined
+// into a kernel compiled for Intel(R) AVX-512 VNNI.
 template <std::integral To, size_t SIMDWidth> struct ConvertForVNNI;
 
-SVS_VALIDATE_BOOL_ENV(SVS_AVX512_VNNI)
-#if SVS_AVX512_VNNI
+SVS_VALIDATE_BOOL_ENV(SVS_BUILD_AVX512_VNNI)
+#if SVS_BUILD_AVX512_VNNI
+SVS_BEGIN_TARGET_AVX512_VNNI
 
 template <> struct ConvertForVNNI<int16_t, 32> {
     static constexpr size_t simd_width = 32;
@@ -326,40 +480,76 @@ template <> struct ConvertForVNNI<int16_t, 32> {
     using mask_t = svs::mask_repr_t<simd_width>;
 
     // uint8
-    SVS_FORCE_INLINE static reg_t load(const uint8_t* ptr) {
+    SVS_TARGET_INLINE static reg_t load(const uint8_t* ptr) {
         return _mm512_cvtepu8_epi16(_mm256_loadu_epi8(ptr));
     }
 
-    SVS_FORCE_INLINE static reg_t load(mask_t m, const uint8_t* ptr) {
+    SVS_TARGET_INLINE static reg_t load(mask_t m, const uint8_t* ptr) {
         return _mm512_cvtepu8_epi16(_mm256_maskz_loadu_epi8(m, ptr));
     }
 
     // int8
-    SVS_FORCE_INLINE static reg_t load(const int8_t* ptr) {
+    SVS_TARGET_INLINE static reg_t load(const int8_t* ptr) {
         return _mm512_cvtepi8_epi16(_mm256_loadu_epi8(ptr));
     }
 
-    SVS_FORCE_INLINE static reg_t load(mask_t m, const int8_t* ptr) {
+    SVS_TARGET_INLINE static reg_t load(mask_t m, const int8_t* ptr) {
         return _mm512_cvtepi8_epi16(_mm256_maskz_loadu_epi8(m, ptr));
     }
 
-    template <typename A> SVS_FORCE_INLINE static reg_t load_a(const A* a) {
+    template <typename A> SVS_TARGET_INLINE static reg_t load_a(const A* a) {
         return load(a);
     }
 
-    template <typename A> SVS_FORCE_INLINE static reg_t load_a(mask_t m, const A* a) {
+    template <typename A> SVS_TARGET_INLINE static reg_t load_a(mask_t m, const A* a) {
         return load(m, a);
     }
 
-    template <typename B> SVS_FORCE_INLINE static reg_t load_b(const B* b) {
+    template <typename B> SVS_TARGET_INLINE static reg_t load_b(const B* b) {
         return load(b);
     }
 
-    template <typename B> SVS_FORCE_INLINE static reg_t load_b(mask_t m, const B* b) {
+    template <typename B> SVS_TARGET_INLINE static reg_t load_b(mask_t m, const B* b) {
         return load(m, b);
     }
 };
 
+SVS_END_TARGET
+#endif
+
+// A base class used for customizing generic SIMD operations using Intel(R) AVX-512 BF16
+// instructions.
+//
+// Loads pairs of ``BFloat16`` values into the registers consumed by ``_mm512_dpbf16_ps``.
+// Values are used as is, without any conversion. The same inlining considerations as for
+// ``ConvertForVNNI`` apply.
+struct ConvertForBF16;
+
+SVS_VALIDATE_BOOL_ENV(SVS_BUILD_AVX512_BF16)
+#if SVS_BUILD_AVX512_BF16
+SVS_BEGIN_TARGET_AVX512_BF16
+
+struct ConvertForBF16 {
+    static constexpr size_t simd_width = 32;
+    using reg_t = __m512bh;
+    using mask_t = svs::mask_repr_t<simd_width>;
+
+    // Reinterpret with a vector cast rather than `std::bit_cast`, which is a function
+    // template compiled without the target extensions in runtime dispatch builds.
+    SVS_TARGET_INLINE static reg_t load(const BFloat16* ptr) {
+        return (reg_t)_mm512_loadu_epi16(ptr);
+    }
+    SVS_TARGET_INLINE static reg_t load(mask_t m, const BFloat16* ptr) {
+        return (reg_t)_mm512_maskz_loadu_epi16(m, ptr);
+    }
+
+    SVS_TARGET_INLINE static reg_t load_a(const BFloat16* a) { return load(a); }
+    SVS_TARGET_INLINE static reg_t load_a(mask_t m, const BFloat16* a) { return load(m, a); }
+    SVS_TARGET_INLINE static reg_t load_b(const BFloat16* b) { return load(b); }
+    SVS_TARGET_INLINE static reg_t load_b(mask_t m, const BFloat16* b) { return load(m, b); }
+};
+
+SVS_END_TARGET
 #endif
 
 } // namespace simd
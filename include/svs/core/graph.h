@@ -25,10 +25,13 @@ namespace svs {
 /// @brief Loader for SVS graphs.
 ///
 /// @tparam Idx The type used to encode nodes in the graph.
+/// @tparam Allocator The allocator to use for the memory backing the graph when loaded.
+///     Use ``svs::MMapAllocator`` to map saved graphs in place instead of reading them.
 ///
-template <typename Idx = uint32_t> struct GraphLoader {
+template <typename Idx = uint32_t, typename Allocator = HugepageAllocator<Idx>>
+struct GraphLoader {
     // Type aliases
-    using return_type = graphs::SimpleGraph<Idx, HugepageAllocator<Idx>>;
+    using return_type = graphs::SimpleGraph<Idx, Allocator>;
 
     /// @brief Construct a new GraphLoader
     ///
@@ -40,11 +43,17 @@ template <typename Idx = uint32_t> struct GraphLoader {
     GraphLoader(const std::filesystem::path& path)
         : path_{path} {}
 
+    /// @brief Construct a new GraphLoader using the given allocator.
+    GraphLoader(const std::filesystem::path& path, const Allocator& allocator)
+        : path_{path}
+        , allocator_{allocator} {}
+
     /// @brief Load the graph into memory.
-    return_type load() const { return return_type::load(path_); }
+    return_type load() const { return return_type::load(path_, allocator_); }
 
     ///// Members
     std::filesystem::path path_{};
+    Allocator allocator_{};
 };
 
 ///
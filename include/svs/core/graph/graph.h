@@ -15,12 +15,15 @@
 #include "svs/core/data/simple.h"
 #include "svs/lib/algorithms.h"
 #include "svs/lib/boundscheck.h"
+#include "svs/lib/concurrency/seqlock.h"
 #include "svs/lib/saveload.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstdint>
 #include <span>
 #include <type_traits>
+#include <vector>
 
 namespace svs::graphs {
 
@@ -372,6 +375,19 @@ bool operator==(const SimpleGraph<Idx, A1>& x, const SimpleGraph<Idx, A2>& y) {
     return graphs_equal(x, y);
 }
 
+///
+/// @brief Resizeable graph representation.
+///
+/// @tparam Idx The integer type used to encode vertices in this graph.
+///
+/// Adjacency lists are stored in fixed-size blocks that are never relocated when the graph
+/// grows.
+///
+/// Modifications through ``clear_node``, ``replace_node``, and ``add_edge`` are guarded by
+/// per-vertex sequence locks, allowing ``snapshot_node`` to read consistent adjacency lists
+/// while the graph is being modified. Resizing the graph is not safe while other threads
+/// access it.
+///
 template <std::unsigned_integral Idx>
 class SimpleBlockedGraph
     : public SimpleGraphBase<Idx, data::BlockedData<Idx, Dynamic, HugepageAllocator<Idx>>> {
@@ -382,18 +398,80 @@ class SimpleBlockedGraph
 
     // Constructors
     SimpleBlockedGraph(size_t max_degree, size_t num_nodes)
-        : parent_type{num_nodes, max_degree} {}
+        : parent_type{num_nodes, max_degree}
+        , versions_(num_nodes) {}
 
     explicit SimpleBlockedGraph(data_type data)
-        : parent_type{std::move(data)} {}
+        : parent_type{std::move(data)}
+        , versions_(parent_type::n_nodes()) {}
 
     explicit SimpleBlockedGraph(parent_type&& parent)
-        : parent_type(std::move(parent)) {}
+        : parent_type(std::move(parent))
+        , versions_(parent_type::n_nodes()) {}
 
     // Resizeable API
-    void unsafe_resize(size_t new_size) { (parent_type::data_).resize(new_size); }
+    void unsafe_resize(size_t new_size) {
+        (parent_type::data_).resize(new_size);
+        versions_.resize(new_size);
+    }
     void add_node() { unsafe_resize(parent_type::n_nodes() + 1); }
 
+    ///// Guarded Modification
+
+    /// @copydoc SimpleGraphBase::clear_node
+    void clear_node(Idx i) {
+        auto& lock = getindex(versions_, i);
+        lock.write_begin();
+        parent_type::clear_node(i);
+        lock.write_end();
+    }
+
+    /// @copydoc SimpleGraphBase::replace_node(Idx,const std::vector<Idx>&)
+    void replace_node(Idx i, const std::vector<Idx>& new_neighbors) {
+        replace_node(i, std::span{new_neighbors.data(), new_neighbors.size()});
+    }
+
+    /// @copydoc SimpleGraphBase::replace_node(Idx,const std::vector<Idx>&)
+    void replace_node(Idx i, std::span<const Idx> new_neighbors) {
+        auto& lock = getindex(versions_, i);
+        lock.write_begin();
+        parent_type::replace_node(i, new_neighbors);
+        lock.write_end();
+    }
+
+    /// @copydoc SimpleGraphBase::add_edge
+    size_t add_edge(Idx src, Idx dst) {
+        auto& lock = getindex(versions_, src);
+        lock.write_begin();
+        size_t degree = parent_type::add_edge(src, dst);
+        lock.write_end();
+        return degree;
+    }
+
+    ///
+    /// @brief Copy the adjacency list for vertex ``i`` into ``buffer``.
+    ///
+    /// @returns A span over the copied adjacency list, valid until ``buffer`` is modified.
+    ///
+    /// Unlike ``get_node``, this may be called while other threads modify the adjacency
+    /// list of ``i`` and will return either the list before or after the modification.
+    ///
+    std::span<const Idx> snapshot_node(Idx i, std::vector<Idx>& buffer) const {
+        const auto& lock = getindex(versions_, i);
+        buffer.resize(parent_type::max_degree());
+        size_t num_neighbors = 0;
+        uint32_t version = 0;
+        do {
+            version = lock.read_begin();
+            std::span<const Idx> raw_data = parent_type::raw_row(i);
+            // The length may be torn by a concurrent write. Clamp it to stay in-bounds and
+            // let the version check discard the result.
+            num_neighbors = std::min(size_t{raw_data.front()}, buffer.size());
+            std::copy_n(raw_data.begin() + 1, num_neighbors, buffer.begin());
+        } while (lock.read_retry(version));
+        return std::span<const Idx>{buffer.data(), num_neighbors};
+    }
+
     ///// Loading
     static constexpr SimpleBlockedGraph load(const lib::LoadTable& table) {
         auto lazy =
@@ -408,6 +486,9 @@ class SimpleBlockedGraph
             return SimpleBlockedGraph(data_type::load(path));
         }
     }
+
+  private:
+    std::vector<lib::SeqLock> versions_;
 };
 
 } // namespace svs::graphs
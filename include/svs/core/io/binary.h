@@ -203,6 +203,9 @@ class BinaryFile {
         return binary::get_dims(path_, elsize_hint);
     }
 
+    /// @brief Return the path to the file.
+    const std::filesystem::path& get_path() const { return path_; }
+
   private:
     std::filesystem::path path_;
 };
@@ -259,6 +259,9 @@ class VecsFile {
         return vecs::get_dims(path_, elsize_hint);
     }
 
+    /// @brief Return the path to the file.
+    const std::filesystem::path& get_path() const { return path_; }
+
   private:
     std::filesystem::path path_;
 };
@@ -18,12 +18,18 @@
 #include "svs/core/distance/euclidean.h"
 #include "svs/core/logging.h"
 #include "svs/lib/exception.h"
+#include "svs/lib/misc.h"
 #include "svs/lib/neighbor.h"
+#include "svs/lib/preprocessor.h"
 #include "svs/lib/threads/threadpool.h"
 #include "svs/lib/timing.h"
 #include "svs/lib/type_traits.h"
 
+#include <algorithm>
+#include <limits>
 #include <random>
+#include <unordered_set>
+#include <vector>
 
 namespace svs {
 ///
@@ -138,20 +144,13 @@ void process_batch(
     adjust_centroids.finish();
 }
 
-template <data::ImmutableMemoryDataset Data, typename Callback = lib::donothing>
-data::SimpleData<float> train_impl(
-    const KMeansParameters& parameters,
-    const Data& data,
-    threads::NativeThreadPool& threadpool,
-    Callback&& post_epoch_callback = lib::donothing()
-) {
-    size_t ndims = data.dimensions();
-    auto num_clusters = parameters.clusters;
-
-    // The cluster centroids
-    auto centroids = data::SimpleData<float>{num_clusters, ndims};
-    auto rng = std::mt19937_64(parameters.seed);
-    auto distribution = std::uniform_int_distribution<size_t>(0, data.size());
+// Pick `num_clusters` distinct elements of `data` uniformly at random as initial centroids.
+template <data::ImmutableMemoryDataset Data>
+data::SimpleData<float>
+random_centroids(const Data& data, size_t num_clusters, size_t seed) {
+    auto centroids = data::SimpleData<float>{num_clusters, data.dimensions()};
+    auto rng = std::mt19937_64(seed);
+    auto distribution = std::uniform_int_distribution<size_t>(0, data.size() - 1);
     std::unordered_set<size_t> seen{};
     for (size_t i = 0; i < num_clusters; ++i) {
         // Pick a vector a random.
@@ -162,6 +161,67 @@ data::SimpleData<float> train_impl(
         centroids.set_datum(i, data.get_datum(j));
         seen.insert(j);
     }
+    return centroids;
+}
+
+// Pick initial centroids using k-means++ seeding.
+//
+// Each new centroid is sampled with probability proportional to its squared distance to
+// the closest centroid picked so far. Compared to uniform sampling, this is much less
+// likely to leave well separated clusters without a centroid.
+template <data::ImmutableMemoryDataset Data>
+data::SimpleData<float> kmeans_plus_plus_centroids(
+    const Data& data,
+    size_t num_clusters,
+    size_t seed,
+    threads::NativeThreadPool& threadpool
+) {
+    auto centroids = data::SimpleData<float>{num_clusters, data.dimensions()};
+    auto rng = std::mt19937_64(seed);
+    auto min_distances =
+        std::vector<double>(data.size(), std::numeric_limits<double>::max());
+
+    size_t next = std::uniform_int_distribution<size_t>(0, data.size() - 1)(rng);
+    for (size_t i = 0; i < num_clusters; ++i) {
+        centroids.set_datum(i, data.get_datum(next));
+        auto centroid = centroids.get_datum(i);
+        threads::run(
+            threadpool,
+            threads::StaticPartition{data.size()},
+            [&](const auto& indices, uint64_t SVS_UNUSED(tid)) {
+                auto f = distance::DistanceL2{};
+                for (auto j : indices) {
+                    double d = distance::compute(f, centroid, data.get_datum(j));
+                    min_distances[j] = std::min(min_distances[j], d);
+                }
+            }
+        );
+
+        // Once every element coincides with a centroid, fall back to uniform sampling.
+        bool degenerate = std::all_of(
+            min_distances.begin(), min_distances.end(), [](double d) { return d == 0; }
+        );
+        if (degenerate) {
+            next = std::uniform_int_distribution<size_t>(0, data.size() - 1)(rng);
+        } else {
+            next = std::discrete_distribution<size_t>(
+                min_distances.begin(), min_distances.end()
+            )(rng);
+        }
+    }
+    return centroids;
+}
+
+// Refine `centroids` using mini-batch k-means.
+template <data::ImmutableMemoryDataset Data, typename Callback = lib::donothing>
+void train_centroids(
+    const KMeansParameters& parameters,
+    const Data& data,
+    data::SimpleData<float>& centroids,
+    threads::NativeThreadPool& threadpool,
+    Callback&& post_epoch_callback = lib::donothing()
+) {
+    auto num_clusters = centroids.size();
 
     // Book-keeping
     auto counts = std::vector<int64_t>(num_clusters);
@@ -197,6 +257,24 @@ data::SimpleData<float> train_impl(
         }
     }
     svs::logging::debug("{}", timer);
+}
+
+template <data::ImmutableMemoryDataset Data, typename Callback = lib::donothing>
+data::SimpleData<float> train_impl(
+    const KMeansParameters& parameters,
+    const Data& data,
+    threads::NativeThreadPool& threadpool,
+    Callback&& post_epoch_callback = lib::donothing()
+) {
+    // The cluster centroids
+    auto centroids = random_centroids(data, parameters.clusters, parameters.seed);
+    train_centroids(
+        parameters,
+        data,
+        centroids,
+        threadpool,
+        std::forward<Callback>(post_epoch_callback)
+    );
     return centroids;
 }
 
@@ -216,4 +294,90 @@ data::SimpleData<float> train(
         parameters, data, threadpool, std::forward<Callback>(post_epoch_callback)
     );
 }
+
+///
+/// @brief Return the indices of elements representative of the k-means clusters of a
+/// dataset.
+///
+/// @param data The dataset to cluster.
+/// @param num_clusters The number of clusters to compute.
+/// @param threadpool The threadpool to use.
+/// @param map Optional conversion applied to the elements of ``data`` before clustering.
+///     Mapped elements must be indexable and convertible to ``float``.
+///
+/// Clustering is performed on an evenly strided sample of ``data`` using k-means++ seeding
+/// followed by mini-batch k-means. Each centroid is then replaced by the closest sampled
+/// element with respect to the L2 distance. The returned indices are unique, so fewer than
+/// ``num_clusters`` indices may be returned.
+///
+template <
+    data::ImmutableMemoryDataset Data,
+    threads::ThreadPool Pool,
+    typename Map = lib::identity>
+std::vector<size_t> find_cluster_representatives(
+    const Data& data, size_t num_clusters, Pool& threadpool, Map&& map = lib::identity()
+) {
+    // The number of sampled elements per cluster.
+    constexpr size_t sample_factor = 64;
+    // The number of epochs of training.
+    constexpr size_t epochs = 10;
+
+    num_clusters = std::min(num_clusters, data.size());
+    if (num_clusters == 0) {
+        return {};
+    }
+
+    // Gather the training sample.
+    size_t sample_size = std::min(data.size(), num_clusters * sample_factor);
+    auto sample_ids = std::vector<size_t>(sample_size);
+    for (size_t i = 0; i < sample_size; ++i) {
+        sample_ids[i] = (i * data.size()) / sample_size;
+    }
+
+    auto sample = data::SimpleData<float>(sample_size, data.dimensions());
+    threads::run(
+        threadpool,
+        threads::StaticPartition{sample_size},
+        [&](const auto& is, uint64_t SVS_UNUSED(tid)) {
+            auto map_local = map;
+            for (auto i : is) {
+                const auto& mapped = map_local(data.get_datum(sample_ids[i]));
+                auto dst = sample.get_datum(i);
+                for (size_t k = 0, kmax = dst.size(); k < kmax; ++k) {
+                    dst[k] = static_cast<float>(mapped[k]);
+                }
+            }
+        }
+    );
+
+    // K-means is implemented in terms of the native threadpool.
+    // Use k-means++ seeding to avoid missing well separated clusters.
+    auto native_threadpool = threads::NativeThreadPool(threadpool.size());
+    auto parameters = KMeansParameters{num_clusters, sample_size, epochs};
+    auto centroids = kmeans_plus_plus_centroids(
+        sample, num_clusters, parameters.seed, native_threadpool
+    );
+    train_centroids(parameters, sample, centroids, native_threadpool);
+
+    // Replace each centroid by its nearest sampled element.
+    auto nearest = std::vector<size_t>(num_clusters);
+    threads::run(
+        threadpool,
+        threads::StaticPartition{num_clusters},
+        [&](const auto& is, uint64_t SVS_UNUSED(tid)) {
+            for (auto i : is) {
+                nearest[i] = sample_ids[find_nearest(centroids.get_datum(i), sample).id()];
+            }
+        }
+    );
+
+    auto representatives = std::vector<size_t>();
+    for (auto id : nearest) {
+        if (std::find(representatives.begin(), representatives.end(), id) ==
+            representatives.end()) {
+            representatives.push_back(id);
+        }
+    }
+    return representatives;
+}
 } // namespace svs
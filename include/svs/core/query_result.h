@@ -16,7 +16,11 @@
 #include "svs/lib/neighbor.h"
 
 #include <cassert>
+#include <numeric>
+#include <ranges>
+#include <span>
 #include <type_traits>
+#include <vector>
 
 namespace svs {
 
@@ -166,4 +170,117 @@ template <typename Idx> using QueryResult = QueryResultImpl<Idx, Matrix>;
 ///
 template <typename Idx> using QueryResultView = QueryResultImpl<Idx, MatrixView>;
 
+///
+/// @brief Results of a range search for a query batch.
+///
+/// Unlike a k-nearest neighbor search, the number of results for each query is not known
+/// in advance. Results are stored in compressed sparse row (CSR) form: the results for
+/// query `i` occupy positions `[offsets()[i], offsets()[i + 1])` of the concatenated
+/// indices and distances.
+///
+template <typename Idx> class RangeSearchResult {
+  public:
+    /// Construct an empty result for zero queries.
+    RangeSearchResult() = default;
+
+    ///
+    /// @brief Construct an uninitialized result from the number of results for each query.
+    ///
+    /// @param counts The number of results for each query.
+    ///
+    /// The constructed result will have `n_queries() == counts.size()` and
+    /// `num_results(i) == counts[i]`.
+    ///
+    explicit RangeSearchResult(std::span<const size_t> counts)
+        : offsets_(counts.size() + 1, 0) {
+        std::inclusive_scan(counts.begin(), counts.end(), offsets_.begin() + 1);
+        indices_.resize(offsets_.back());
+        distances_.resize(offsets_.back());
+    }
+
+    ///
+    /// @brief Construct a result by concatenating the neighbors found for each query.
+    ///
+    /// @param neighbors The neighbors for each query in the order they should be returned.
+    ///
+    template <std::ranges::random_access_range Neighbors>
+        requires NeighborLike<std::ranges::range_value_t<Neighbors>>
+    explicit RangeSearchResult(const std::vector<Neighbors>& neighbors)
+        : offsets_(neighbors.size() + 1, 0) {
+        for (size_t i = 0, imax = neighbors.size(); i < imax; ++i) {
+            offsets_[i + 1] = offsets_[i] + std::ranges::size(neighbors[i]);
+        }
+        indices_.reserve(offsets_.back());
+        distances_.reserve(offsets_.back());
+        for (const auto& query_neighbors : neighbors) {
+            for (const auto& neighbor : query_neighbors) {
+                indices_.push_back(neighbor.id());
+                distances_.push_back(neighbor.distance());
+            }
+        }
+    }
+
+    /// Return the number of queries this instance has results for.
+    size_t n_queries() const { return offsets_.size() - 1; }
+    /// Return the number of results for query `query`.
+    size_t num_results(size_t query) const {
+        return offsets_.at(query + 1) - offsets_.at(query);
+    }
+    /// Return the total number of results across all queries.
+    size_t total_results() const { return offsets_.back(); }
+
+    /// Return the `n_queries() + 1` row offsets.
+    const std::vector<size_t>& offsets() const { return offsets_; }
+    /// @copydoc offsets() const
+    std::vector<size_t>& offsets() { return offsets_; }
+
+    /// Return the concatenated indices for all queries.
+    const std::vector<Idx>& indices() const { return indices_; }
+    /// @copydoc indices() const
+    std::vector<Idx>& indices() { return indices_; }
+
+    /// Return the concatenated distances for all queries.
+    const std::vector<float>& distances() const { return distances_; }
+    /// @copydoc distances() const
+    std::vector<float>& distances() { return distances_; }
+
+    /// Return the indices of the results for query `query`.
+    std::span<const Idx> indices(size_t query) const {
+        return {indices_.data() + offsets_.at(query), num_results(query)};
+    }
+    /// @copydoc indices(size_t) const
+    std::span<Idx> indices(size_t query) {
+        return {indices_.data() + offsets_.at(query), num_results(query)};
+    }
+
+    /// Return the distances of the results for query `query`.
+    std::span<const float> distances(size_t query) const {
+        return {distances_.data() + offsets_.at(query), num_results(query)};
+    }
+    /// @copydoc distances(size_t) const
+    std::span<float> distances(size_t query) {
+        return {distances_.data() + offsets_.at(query), num_results(query)};
+    }
+
+    ///
+    /// @brief Assign the `i`th result for query `query`.
+    ///
+    /// @param neighbor The neighbor to store.
+    /// @param query The query index. Must be in `[0, n_queries())`.
+    /// @param i The result index. Must be in `[0, num_results(query))`.
+    ///
+    template <NeighborLike Neighbor>
+    void set(const Neighbor& neighbor, size_t query, size_t i) {
+        assert(i < num_results(query));
+        size_t position = offsets_[query] + i;
+        indices_[position] = neighbor.id();
+        distances_[position] = neighbor.distance();
+    }
+
+  private:
+    std::vector<size_t> offsets_{0};
+    std::vector<Idx> indices_{};
+    std::vector<float> distances_{};
+};
+
 } // namespace svs
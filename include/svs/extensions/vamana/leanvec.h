@@ -36,6 +36,18 @@ size_t svs_invoke(
     );
 }
 
+template <IsLeanDataset Data, threads::ThreadPool Pool>
+std::vector<size_t> svs_invoke(
+    svs::tag_t<svs::index::vamana::extensions::compute_entry_points>,
+    const Data& data,
+    Pool& threadpool,
+    size_t num_entry_points
+) {
+    return svs::index::vamana::extensions::compute_entry_points(
+        data.view_primary_dataset(), threadpool, num_entry_points
+    );
+}
+
 template <IsLeanDataset Data>
 svs::index::vamana::GreedySearchPrefetchParameters svs_invoke(
     svs::tag_t<svs::index::vamana::extensions::estimate_prefetch_parameters>,
@@ -150,7 +162,8 @@ void svs_invoke(
     data::ConstSimpleDataView<QueryType> queries,
     QueryResultView<I>& result,
     threads::UnitRange<size_t> thread_indices,
-    const Search& search
+    const Search& search,
+    size_t rerank_depth
 ) {
     size_t num_neighbors = result.n_neighbors();
     size_t batch_start = thread_indices.start();
@@ -176,15 +189,20 @@ void svs_invoke(
             search(processed_query, accessor, distance_primary, search_buffer);
         }
 
-        // For LeanVec, always rerank the result
+        // For LeanVec, always rerank the best `rerank_depth` results.
+        size_t jmax = search_buffer.size();
+        if (rerank_depth != 0) {
+            jmax = std::min(jmax, rerank_depth);
+        }
         distance::maybe_fix_argument(distance_secondary, query);
-        for (size_t j = 0, jmax = search_buffer.size(); j < jmax; ++j) {
+        for (size_t j = 0; j < jmax; ++j) {
             auto& neighbor = search_buffer[j];
             auto id = neighbor.id();
             auto new_distance =
                 distance::compute(distance_secondary, query, dataset.get_secondary(id));
             neighbor.set_distance(new_distance);
         }
+        search_buffer.truncate(jmax);
         search_buffer.sort();
 
         // Copy back results.
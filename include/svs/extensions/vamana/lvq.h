@@ -14,6 +14,9 @@
 #include "svs/index/vamana/extensions.h"
 #include "svs/quantization/lvq/lvq.h"
 
+// stl
+#include <algorithm>
+
 namespace svs::quantization::lvq {
 
 /////
@@ -30,6 +33,18 @@ size_t svs_invoke(
     return utils::find_medioid(data, threadpool, SVS_FWD(predicate), data.decompressor());
 }
 
+template <IsLVQDataset Data, threads::ThreadPool Pool>
+std::vector<size_t> svs_invoke(
+    svs::tag_t<svs::index::vamana::extensions::compute_entry_points>,
+    const Data& data,
+    Pool& threadpool,
+    size_t num_entry_points
+) {
+    return find_cluster_representatives(
+        data, num_entry_points, threadpool, data.decompressor()
+    );
+}
+
 template <IsLVQDataset Data>
 svs::index::vamana::GreedySearchPrefetchParameters svs_invoke(
     svs::tag_t<svs::index::vamana::extensions::estimate_prefetch_parameters>,
@@ -148,6 +163,9 @@ biased_distance_t<Distance> svs_invoke(
     return adapt(data, distance);
 }
 
+// The number of candidates ahead to prefetch residuals when reranking.
+inline constexpr size_t rerank_prefetch_lookahead = 4;
+
 // Only extend search for two-level dataset.
 // One level datasets can use the default implementation directly.
 template <
@@ -162,7 +180,8 @@ void svs_invoke(
     SearchBuffer& search_buffer,
     Distance& distance,
     const Query& query,
-    const Search& search
+    const Search& search,
+    size_t rerank_depth
 ) {
     // Perform graph search.
     {
@@ -170,13 +189,29 @@ void svs_invoke(
         search(query, accessor, distance, search_buffer);
     }
 
-    // Rerank the results
-    for (size_t j = 0, jmax = search_buffer.size(); j < jmax; ++j) {
+    // Rerank the best `rerank_depth` results (or all of them if `rerank_depth` is zero).
+    // Residuals are not touched by graph search, so prefetch them ahead of use.
+    size_t jmax = search_buffer.size();
+    if (rerank_depth != 0) {
+        jmax = std::min(jmax, rerank_depth);
+    }
+
+    for (size_t j = 0, jpre = std::min(jmax, rerank_prefetch_lookahead); j < jpre; ++j) {
+        dataset.prefetch_residual(search_buffer[j].id());
+    }
+    for (size_t j = 0; j < jmax; ++j) {
+        if (j + rerank_prefetch_lookahead < jmax) {
+            dataset.prefetch_residual(search_buffer[j + rerank_prefetch_lookahead].id());
+        }
         auto& neighbor = search_buffer[j];
         auto id = neighbor.id();
         auto new_distance = distance::compute(distance, query, dataset.get_datum(id));
         neighbor.set_distance(new_distance);
     }
+
+    // Candidates past the rerank depth only have primary distances and cannot be
+    // meaningfully compared with the refined distances.
+    search_buffer.truncate(jmax);
     search_buffer.sort();
 }
 
@@ -13,10 +13,12 @@
 
 // Flat index utilities
 #include "svs/index/flat/inserters.h"
+#include "svs/index/flat/tiled.h"
 #include "svs/index/index.h"
 
 // svs
 #include "svs/concepts/distance.h"
+#include "svs/core/bitset.h"
 #include "svs/core/data.h"
 #include "svs/core/distance.h"
 #include "svs/core/loading.h"
@@ -27,6 +29,7 @@
 
 // stdlib
 #include <tuple>
+#include <vector>
 
 namespace svs::index::flat {
 
@@ -86,6 +89,25 @@ struct ReferencesMembers {
 template <typename Ownership, typename T>
 using storage_type_t = typename Ownership::template storage_type<T>;
 
+namespace detail {
+
+// Invoke `f` on each index in `indices` accepted by `predicate`.
+// Bit set predicates skip whole words of excluded indices without testing them one by one.
+template <typename Pred, typename F>
+void for_each_allowed(Pred& predicate, const threads::UnitRange<size_t>& indices, F&& f) {
+    if constexpr (std::is_same_v<Pred, BitSetView>) {
+        predicate.for_each(indices.start(), indices.stop(), f);
+    } else {
+        for (auto i : indices) {
+            if (predicate(i)) {
+                f(i);
+            }
+        }
+    }
+}
+
+} // namespace detail
+
 struct FlatParameters {
     FlatParameters() = default;
     FlatParameters(size_t data_batch_size, size_t query_batch_size)
@@ -167,6 +189,23 @@ class FlatIndex {
         return std::min(sz, num_queries);
     }
 
+    // Copy the sorted neighbors accumulated in `scratch` into `result`.
+    void write_results(QueryResultView<size_t> result, const sorter_type& scratch) {
+        size_t num_neighbors = result.n_neighbors();
+        threads::run(
+            threadpool_,
+            threads::StaticPartition(result.n_queries()),
+            [&](const auto& query_indices, uint64_t /*tid*/) {
+                for (auto i : query_indices) {
+                    const auto& neighbors = scratch.result(i);
+                    for (size_t j = 0; j < num_neighbors; ++j) {
+                        result.set(neighbors[j], i, j);
+                    }
+                }
+            }
+        );
+    }
+
   public:
     search_parameters_type get_search_parameters() const { return search_parameters_; }
 
@@ -229,7 +268,8 @@ class FlatIndex {
     ///     elements from consideration. This functor must implement
     ///     ``bool operator()(size_t)`` where the ``size_t`` argument is an index in
     ///     ``[0, data.size())``. If the predicate returns ``true``, that dataset element
-    ///     will be considered.
+    ///     will be considered. A ``svs::BitSetView`` predicate skips whole words of
+    ///     excluded elements at a time.
     ///
     /// **Preconditions:**
     ///
@@ -262,54 +302,163 @@ class FlatIndex {
         const search_parameters_type& search_parameters,
         Pred predicate = lib::Returns(lib::Const<true>())
     ) {
-        const size_t data_max_size = data_.size();
-
-        // Partition the data into `data_batch_size_` chunks.
-        // This will keep all threads at least working on the same sub-region of the dataset
-        // to provide somewhat better locality.
-        auto data_batch_size = compute_data_batch_size(search_parameters);
-
         // Allocate query processing space.
         size_t num_neighbors = result.n_neighbors();
         sorter_type scratch{queries.size(), num_neighbors, compare()};
         scratch.prepare();
-
-        size_t start = 0;
-        while (start < data_.size()) {
-            size_t stop = std::min(data_max_size, start + data_batch_size);
-            search_subset(
-                queries,
-                threads::UnitRange(start, stop),
-                scratch,
-                search_parameters,
-                predicate
-            );
-            start = stop;
-        }
+        search_batches(queries, scratch, search_parameters, predicate);
 
         // By this point, all queries have been compared with all dataset elements.
         // Perform any necessary post-processing on the sorting network and write back
         // the results.
         scratch.cleanup();
+        write_results(result, scratch);
+    }
+
+    ///
+    /// @brief Fill the result with the nearest neighbors of each query among the dataset
+    ///     elements allowed by ``filter``.
+    ///
+    /// @param result The result data structure to populate.
+    /// @param queries The queries. Each entry will be processed.
+    /// @param search_parameters Parameters controlling the batching strategy.
+    /// @param filter The allowed dataset elements, either shared by all queries or given
+    ///     separately for each query. See ``svs::SearchFilter``.
+    ///
+    /// Excluded dataset elements are skipped without being loaded. A filter shared by all
+    /// queries uses the same batching as ``search``. With per-query filters, each query is
+    /// compared with its own allowed elements across the whole dataset.
+    ///
+    template <typename QueryType>
+    void search(
+        QueryResultView<size_t> result,
+        const data::ConstSimpleDataView<QueryType>& queries,
+        const search_parameters_type& search_parameters,
+        const SearchFilter& filter
+    ) {
+        filter.check(queries.size());
+        if (filter.empty()) {
+            search(result, queries, search_parameters);
+            return;
+        }
+        if (!filter.is_per_query()) {
+            search(result, queries, search_parameters, filter.view(0));
+            return;
+        }
+
+        sorter_type scratch{queries.size(), result.n_neighbors(), compare()};
+        scratch.prepare();
+        threads::run(
+            threadpool_,
+            threads::DynamicPartition{
+                queries.size(),
+                compute_query_batch_size(search_parameters, queries.size())},
+            [&](const auto& query_indices, uint64_t /*tid*/) {
+                distance::BroadcastDistance distances{
+                    extensions::distance(data_, distance_), 1};
+                for (auto i : query_indices) {
+                    search_patch(
+                        queries,
+                        threads::UnitRange<size_t>(0, data_.size()),
+                        threads::UnitRange<size_t>(i, i + 1),
+                        scratch,
+                        distances,
+                        filter.view(i)
+                    );
+                }
+            }
+        );
+        scratch.cleanup();
+        write_results(result, scratch);
+    }
+
+    ///
+    /// @brief Return all dataset elements within ``radius`` of each query.
+    ///
+    /// @tparam QueryType The element type of the queries.
+    /// @tparam Pred The type of the optional predicate.
+    ///
+    /// @param queries The queries. Each entry will be processed.
+    /// @param radius The search radius. A dataset element is returned if its distance to
+    ///     the query is at least as good as ``radius``. For similarity measures like inner
+    ///     product, this means the similarity must be greater than or equal to ``radius``.
+    /// @param search_parameters Parameters controlling the batching strategy.
+    /// @param predicate A predicate functor that can be used to exclude certain dataset
+    ///     elements from consideration. See the documentation for ``search``.
+    ///
+    /// The results for each query are ordered from nearest to furthest.
+    /// The batching over the dataset and queries is identical to ``search``, with the
+    /// fixed-size sorting network replaced by an unbounded predicate driven collection.
+    ///
+    template <typename QueryType, typename Pred = lib::Returns<lib::Const<true>>>
+    RangeSearchResult<size_t> range_search(
+        const data::ConstSimpleDataView<QueryType>& queries,
+        float radius,
+        const search_parameters_type& search_parameters,
+        Pred predicate = lib::Returns(lib::Const<true>())
+    ) {
+        auto scratch =
+            RangeInserter<Neighbor<size_t>, compare>{queries.size(), radius, compare()};
+        scratch.prepare();
+        search_batches(queries, scratch, search_parameters, predicate);
+        scratch.cleanup();
+
+        auto counts = std::vector<size_t>(queries.size());
+        for (size_t i = 0, imax = queries.size(); i < imax; ++i) {
+            counts[i] = scratch.result(i).size();
+        }
+        auto result = RangeSearchResult<size_t>(counts);
         threads::run(
             threadpool_,
             threads::StaticPartition(queries.size()),
             [&](const auto& query_indices, uint64_t /*tid*/) {
                 for (auto i : query_indices) {
                     const auto& neighbors = scratch.result(i);
-                    for (size_t j = 0; j < num_neighbors; ++j) {
+                    for (size_t j = 0, jmax = neighbors.size(); j < jmax; ++j) {
                         result.set(neighbors[j], i, j);
                     }
                 }
             }
         );
+        return result;
     }
 
-    template <typename QueryType, typename Pred = lib::Returns<lib::Const<true>>>
+    // Compare all queries with all dataset elements, accumulating results in `scratch`.
+    //
+    // The data is partitioned into `data_batch_size_` chunks. This will keep all threads
+    // at least working on the same sub-region of the dataset to provide somewhat better
+    // locality.
+    template <typename QueryType, typename Scratch, typename Pred>
+    void search_batches(
+        const data::ConstSimpleDataView<QueryType>& queries,
+        Scratch& scratch,
+        const search_parameters_type& search_parameters,
+        Pred& predicate
+    ) {
+        const size_t data_max_size = data_.size();
+        auto data_batch_size = compute_data_batch_size(search_parameters);
+        size_t start = 0;
+        while (start < data_max_size) {
+            size_t stop = std::min(data_max_size, start + data_batch_size);
+            search_subset(
+                queries,
+                threads::UnitRange(start, stop),
+                scratch,
+                search_parameters,
+                predicate
+            );
+            start = stop;
+        }
+    }
+
+    template <
+        typename QueryType,
+        typename Scratch,
+        typename Pred = lib::Returns<lib::Const<true>>>
     void search_subset(
         const data::ConstSimpleDataView<QueryType>& queries,
         const threads::UnitRange<size_t>& data_indices,
-        sorter_type& scratch,
+        Scratch& scratch,
         const search_parameters_type& search_parameters,
         Pred predicate = lib::Returns(lib::Const<true>())
     ) {
@@ -341,22 +490,41 @@ class FlatIndex {
     // the cartesian product of `query_indices` x `data_indices`.
     //
     // Insert the computed distance for each query/distance pair into `scratch`, which
-    // will maintain the correct number of nearest neighbors.
+    // will maintain the correct number of nearest neighbors (or all neighbors within the
+    // search radius).
     template <
         typename QueryType,
+        typename Scratch,
         typename DistFull,
         typename Pred = lib::Returns<lib::Const<true>>>
     void search_patch(
         const data::ConstSimpleDataView<QueryType>& queries,
         const threads::UnitRange<size_t>& data_indices,
         const threads::UnitRange<size_t>& query_indices,
-        sorter_type& scratch,
+        Scratch& scratch,
         distance::BroadcastDistance<DistFull>& distance_functors,
         Pred predicate = lib::Returns(lib::Const<true>())
     ) {
         assert(distance_functors.size() >= query_indices.size());
         auto accessor = extensions::accessor(data_);
 
+        // Dense floating point data with a supported distance computes whole tiles of
+        // the query/data cartesian product at once.
+        if constexpr (std::is_same_v<decltype(accessor), data::GetDatumAccessor> &&
+                      tiled::is_applicable_v<const_value_type, QueryType, DistFull>) {
+            if (tiled::available()) {
+                search_patch_tiled(
+                    queries,
+                    data_indices,
+                    query_indices,
+                    scratch,
+                    distance_functors[0],
+                    predicate
+                );
+                return;
+            }
+        }
+
         // Fix arguments
         for (size_t i = 0; i < query_indices.size(); ++i) {
             distance::maybe_fix_argument(
@@ -364,12 +532,8 @@ class FlatIndex {
             );
         }
 
-        for (auto data_index : data_indices) {
-            // Skip this index if it doesn't pass the predicate.
-            if (!predicate(data_index)) {
-                continue;
-            }
-
+        // Only dataset elements passing the predicate are accessed.
+        detail::for_each_allowed(predicate, data_indices, [&](size_t data_index) {
             auto datum = accessor(data_, data_index);
 
             // Loop over the queries.
@@ -382,7 +546,57 @@ class FlatIndex {
                 );
                 scratch.insert(query_index, {data_index, d});
             }
-        }
+        });
+    }
+
+    // Implementation of `search_patch` using the tiled kernels.
+    //
+    // Dataset elements passing the predicate are packed into contiguous tiles. Each data
+    // tile is then compared with successive tiles of queries while it remains in cache.
+    template <typename Scratch, typename DistFull, typename Pred>
+    void search_patch_tiled(
+        const data::ConstSimpleDataView<float>& queries,
+        const threads::UnitRange<size_t>& data_indices,
+        const threads::UnitRange<size_t>& query_indices,
+        Scratch& scratch,
+        const DistFull& distance,
+        Pred& predicate
+    ) {
+        auto tile = tiled::TileScratch(data_.dimensions());
+        auto ids = std::vector<size_t>();
+        ids.reserve(tiled::data_tile_size);
+
+        auto process_tile = [&]() {
+            if (ids.empty()) {
+                return;
+            }
+
+            tile.pack_data(data_, ids);
+            const size_t n = ids.size();
+            for (size_t q = 0; q < query_indices.size(); q += tiled::query_tile_size) {
+                const size_t m = std::min(tiled::query_tile_size, query_indices.size() - q);
+                const size_t first_query = query_indices[q];
+                tiled::compute_tile(
+                    distance, queries.get_datum(first_query).data(), m, n, tile
+                );
+
+                const float* distances = tile.distances();
+                for (size_t i = 0; i < m; ++i) {
+                    for (size_t j = 0; j < n; ++j) {
+                        scratch.insert(first_query + i, {ids[j], distances[i * n + j]});
+                    }
+                }
+            }
+            ids.clear();
+        };
+
+        detail::for_each_allowed(predicate, data_indices, [&](size_t data_index) {
+            ids.push_back(data_index);
+            if (ids.size() == tiled::data_tile_size) {
+                process_tile();
+            }
+        });
+        process_tile();
     }
 
     // Threading Interface
@@ -14,7 +14,9 @@
 // stdlib
 #include <algorithm>
 #include <iterator>
+#include <span>
 #include <type_traits>
+#include <vector>
 
 // svs
 #include "svs/lib/array.h"
@@ -200,4 +202,69 @@ template <typename T, typename Cmp> class BulkInserter {
     [[no_unique_address]] Cmp compare_;
 };
 
+///
+/// Inserter collecting all elements within a fixed radius for multiple queries.
+///
+/// Unlike the ``BulkInserter``, the number of results for each query is unbounded.
+/// An element ``x`` is retained if ``compare(radius, x.distance())`` is ``false``.
+/// That is, the radius is inclusive.
+///
+template <typename T, typename Cmp> class RangeInserter {
+  public:
+    using value_type = T;
+
+    // Constructor
+    RangeInserter(size_t batch_size, float radius, Cmp compare)
+        : data_(batch_size)
+        , radius_{radius}
+        , compare_{compare} {}
+
+    ///
+    /// Prepare for bulk insertion.
+    ///
+    void prepare() {
+        for (auto& v : data_) {
+            v.clear();
+        }
+    }
+
+    ///
+    /// Insert an element into batch `i` if it is within the radius.
+    ///
+    void insert(size_t i, T x) {
+        if (!compare_(radius_, x.distance())) {
+            data_[i].push_back(x);
+        }
+    }
+
+    ///
+    /// Sort the results for each batch from best to worst.
+    ///
+    void cleanup() {
+        for (auto& v : data_) {
+            std::sort(v.begin(), v.end(), compare_);
+        }
+    }
+
+    ///
+    /// Return the results for batch `i`.
+    ///
+    std::span<const T> result(size_t i) const { return data_.at(i); }
+
+    ///
+    /// Return the currently configured batch size.
+    ///
+    size_t batch_size() const { return data_.size(); }
+
+    ///
+    /// Return the configured radius.
+    ///
+    float radius() const { return radius_; }
+
+  private:
+    std::vector<std::vector<T>> data_;
+    float radius_;
+    [[no_unique_address]] Cmp compare_;
+};
+
 } // namespace svs::index::flat
@@ -0,0 +1,326 @@
+/**
+ *    Copyright (C) 2023, Intel Corporation
+ *
+ *    You can redistribute and/or modify this software under the terms of the
+ *    GNU Affero General Public License version 3.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    version 3 along with this software. If not, see
+ *    <https://www.gnu.org/licenses/agpl-3.0.en.html>.
+ */
+
+#pragma once
+
+// svs
+#include "svs/core/data/simple.h"
+#include "svs/core/distance/euclidean.h"
+#include "svs/core/distance/inner_product.h"
+#include "svs/lib/arch.h"
+#include "svs/lib/exception.h"
+#include "svs/lib/preprocessor.h"
+#include "svs/lib/meta.h"
+
+// Intel(R) MKL
+SVS_VALIDATE_BOOL_ENV(SVS_HAVE_MKL)
+#if SVS_HAVE_MKL
+#include <mkl.h>
+#endif
+
+// third-party
+#include "x86intrin.h"
+
+// stl
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstring>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace svs::index::flat::tiled {
+
+///
+/// The tiled kernels compute the distances between a tile of queries and a tile of dataset
+/// elements at once rather than one pair at a time, loading each dataset element once per
+/// query tile instead of once per query.
+///
+/// Only dense `float` data with the squared L2 and inner product distances are supported.
+/// Everything else falls back to pair-wise distance computations.
+///
+
+// Number of queries processed at once.
+inline constexpr size_t query_tile_size = 64;
+// Number of dataset elements packed into a contiguous tile.
+inline constexpr size_t data_tile_size = 256;
+
+template <typename Dist> inline constexpr bool is_supported_distance_v = false;
+template <> inline constexpr bool is_supported_distance_v<distance::DistanceL2> = true;
+template <> inline constexpr bool is_supported_distance_v<distance::DistanceIP> = true;
+
+template <typename T> inline constexpr bool is_float_span_v = false;
+template <size_t N> inline constexpr bool is_float_span_v<std::span<const float, N>> = true;
+
+///
+/// Return whether the tiled kernels may be used for the given dataset element type, query
+/// element type, and distance functor.
+///
+template <typename Datum, typename QueryType, typename Dist>
+inline constexpr bool is_applicable_v =
+    is_float_span_v<Datum> && std::is_same_v<QueryType, float> &&
+    is_supported_distance_v<Dist>;
+
+/////
+///// Register blocked kernel
+/////
+
+#if SVS_BUILD_AVX512_F
+SVS_BEGIN_TARGET_AVX512_F
+
+// Register blocking: four queries by four dataset elements uses 16 accumulators, leaving
+// room for the loaded queries and dataset element in the 32 vector registers.
+inline constexpr size_t block_size = 4;
+using BlockIndices = std::make_index_sequence<block_size>;
+
+// Reduce four accumulators to their horizontal sums in the first four lanes.
+inline __m128 reduce_block(const __m512 (&x)[block_size]) {
+    // Within each 128-bit lane: [x0[0]+x0[2], x1[0]+x1[2], x0[1]+x0[3], x1[1]+x1[3]].
+    auto x01 = _mm512_add_ps(_mm512_unpacklo_ps(x[0], x[1]), _mm512_unpackhi_ps(x[0], x[1]));
+    auto x23 = _mm512_add_ps(_mm512_unpacklo_ps(x[2], x[3]), _mm512_unpackhi_ps(x[2], x[3]));
+    // Within each 128-bit lane: partial sums of [x0, x1, x2, x3].
+    auto lo = _mm512_unpacklo_pd(_mm512_castps_pd(x01), _mm512_castps_pd(x23));
+    auto hi = _mm512_unpackhi_pd(_mm512_castps_pd(x01), _mm512_castps_pd(x23));
+    auto y = _mm512_add_ps(_mm512_castpd_ps(lo), _mm512_castpd_ps(hi));
+    // Sum across the 128-bit lanes.
+    y = _mm512_add_ps(y, _mm512_shuffle_f32x4(y, y, 0b01001110));
+    y = _mm512_add_ps(y, _mm512_shuffle_f32x4(y, y, 0b10110001));
+    return _mm512_castps512_ps128(y);
+}
+
+// Compute the distances between `block_size` queries and `block_size` dataset elements and
+// store the upper-left `mr x nr` block of results in `out`.
+//
+// Partial blocks are handled by the caller repeating the last valid row.
+template <bool L2, size_t... Is>
+void block_kernel(
+    const std::array<const float*, block_size>& queries,
+    const std::array<const float*, block_size>& data,
+    size_t dims,
+    float* out,
+    size_t out_stride,
+    size_t mr,
+    size_t nr,
+    std::index_sequence<Is...> SVS_UNUSED(indices)
+) {
+    // Indexed as `accumulators[query][datum]`.
+    __m512 accumulators[block_size][block_size];
+    for (auto& row : accumulators) {
+        for (auto& x : row) {
+            x = _mm512_setzero_ps();
+        }
+    }
+
+    auto step = [&](size_t k, __mmask16 mask) {
+        __m512 q[block_size] = {_mm512_maskz_loadu_ps(mask, queries[Is] + k)...};
+        auto update = [&]<size_t J>(lib::Val<J>) {
+            auto x = _mm512_maskz_loadu_ps(mask, data[J] + k);
+            if constexpr (L2) {
+                ((accumulators[Is][J] = _mm512_fmadd_ps(
+                      _mm512_sub_ps(q[Is], x), _mm512_sub_ps(q[Is], x), accumulators[Is][J]
+                  )),
+                 ...);
+            } else {
+                ((accumulators[Is][J] = _mm512_fmadd_ps(q[Is], x, accumulators[Is][J])),
+                 ...);
+            }
+        };
+        (update(lib::Val<Is>()), ...);
+    };
+
+    size_t k = 0;
+    for (; k + 16 <= dims; k += 16) {
+        step(k, __mmask16(0xFFFF));
+    }
+    if (k < dims) {
+        step(k, __mmask16((1u << (dims - k)) - 1));
+    }
+
+    auto store_mask = __mmask8((1u << nr) - 1);
+    for (size_t i = 0; i < mr; ++i) {
+        _mm_mask_storeu_ps(out + i * out_stride, store_mask, reduce_block(accumulators[i]));
+    }
+}
+
+template <bool L2>
+void compute_tile_avx512(
+    const float* queries,
+    size_t m,
+    const float* data,
+    size_t n,
+    size_t dims,
+    float* out
+) {
+    for (size_t i = 0; i < m; i += block_size) {
+        size_t mr = std::min(block_size, m - i);
+        std::array<const float*, block_size> q;
+        for (size_t ii = 0; ii < block_size; ++ii) {
+            q[ii] = queries + (i + std::min(ii, mr - 1)) * dims;
+        }
+
+        for (size_t j = 0; j < n; j += block_size) {
+            size_t nr = std::min(block_size, n - j);
+            std::array<const float*, block_size> x;
+            for (size_t jj = 0; jj < block_size; ++jj) {
+                x[jj] = data + (j + std::min(jj, nr - 1)) * dims;
+            }
+            block_kernel<L2>(q, x, dims, out + i * n + j, n, mr, nr, BlockIndices());
+        }
+    }
+}
+
+SVS_END_TARGET
+#endif
+
+/////
+///// Entry points
+/////
+
+///
+/// @brief Return whether a tiled kernel is available on this host.
+///
+inline bool available() {
+#if SVS_HAVE_MKL
+    return true;
+#elif SVS_BUILD_AVX512_F
+    return arch::is_supported(arch::ISA::avx512f);
+#else
+    return false;
+#endif
+}
+
+///
+/// @brief Per-thread scratch space for the tiled kernels.
+///
+class TileScratch {
+  public:
+    explicit TileScratch(size_t dims)
+        : dims_{dims}
+        , data_(data_tile_size * dims)
+        , data_norms_(data_tile_size)
+        , query_norms_(query_tile_size)
+        , distances_(query_tile_size * data_tile_size) {}
+
+    size_t dimensions() const { return dims_; }
+
+    /// Copy the dataset elements into contiguous storage.
+    template <typename Data, typename Indices>
+    void pack_data(const Data& data, const Indices& indices) {
+        assert(indices.size() <= data_tile_size);
+        float* dst = data_.data();
+        for (auto i : indices) {
+            auto datum = data.get_datum(i);
+            assert(datum.size() == dims_);
+            std::memcpy(dst, datum.data(), dims_ * sizeof(float));
+            dst += dims_;
+        }
+    }
+
+    const float* packed_data() const { return data_.data(); }
+    float* data_norms() { return data_norms_.data(); }
+    float* query_norms() { return query_norms_.data(); }
+    float* distances() { return distances_.data(); }
+    const float* distances() const { return distances_.data(); }
+
+  private:
+    size_t dims_;
+    std::vector<float> data_;
+    std::vector<float> data_norms_;
+    std::vector<float> query_norms_;
+    std::vector<float> distances_;
+};
+
+namespace detail {
+#if SVS_HAVE_MKL
+inline void squared_norms(const float* x, size_t n, size_t dims, float* norms) {
+    for (size_t i = 0; i < n; ++i) {
+        const float* row = x + i * dims;
+        norms[i] = distance::IP::compute(row, row, dims);
+    }
+}
+#endif
+} // namespace detail
+
+///
+/// @brief Compute the distances between `m` contiguous queries and the `n` dataset elements
+///     packed in `scratch`.
+///
+/// Results are written row-major into `scratch.distances()` with row stride `n`.
+/// The query tile must contain at most `query_tile_size` queries and `n` must be at most
+/// `data_tile_size`.
+///
+/// **Preconditions:** ``available()`` returns ``true``.
+///
+template <typename Dist>
+void compute_tile(
+    const Dist& SVS_UNUSED(distance),
+    const float* queries,
+    size_t m,
+    size_t n,
+    TileScratch& scratch
+) {
+    static_assert(is_supported_distance_v<Dist>);
+    constexpr bool is_l2 = std::is_same_v<Dist, distance::DistanceL2>;
+    assert(m <= query_tile_size);
+    assert(n <= data_tile_size);
+    size_t dims = scratch.dimensions();
+    const float* data = scratch.packed_data();
+    float* out = scratch.distances();
+
+#if SVS_HAVE_MKL
+    // Squared L2 is expanded as `|q|^2 + |x|^2 - 2 <q, x>`.
+    float alpha = is_l2 ? -2.0f : 1.0f;
+    cblas_sgemm(
+        CblasRowMajor,
+        CblasNoTrans,
+        CblasTrans,
+        m,
+        n,
+        dims,
+        alpha,
+        queries,
+        dims,
+        data,
+        dims,
+        0.0f,
+        out,
+        n
+    );
+    if constexpr (is_l2) {
+        float* qnorms = scratch.query_norms();
+        float* xnorms = scratch.data_norms();
+        detail::squared_norms(queries, m, dims, qnorms);
+        detail::squared_norms(data, n, dims, xnorms);
+        for (size_t i = 0; i < m; ++i) {
+            for (size_t j = 0; j < n; ++j) {
+                // Cancellation can drive nearly identical vectors slightly negative.
+                out[i * n + j] = std::max(out[i * n + j] + qnorms[i] + xnorms[j], 0.0f);
+            }
+        }
+    }
+#elif SVS_BUILD_AVX512_F
+    compute_tile_avx512<is_l2>(queries, m, data, n, dims, out);
+#else
+    // Unreachable when `available()` holds.
+    (void)queries;
+    (void)m;
+    (void)n;
+    (void)dims;
+    (void)data;
+    (void)out;
+    (void)is_l2;
+    throw ANNEXCEPTION("No tiled distance kernel is available!");
+#endif
+}
+
+} // namespace svs::index::flat::tiled
@@ -13,6 +13,7 @@
 
 // svs
 #include "svs/concepts/data.h"
+#include "svs/core/bitset.h"
 #include "svs/core/query_result.h"
 
 // stl
@@ -79,4 +80,88 @@ search_batch(Index& index, const Queries& queries, size_t num_neighbors) {
         index, queries, num_neighbors, index.get_search_parameters()
     );
 }
+
+/////
+///// Filtered Search
+/////
+
+// Restrict the results of each query to the IDs allowed by `filter`.
+template <typename Index, std::integral I, data::ImmutableMemoryDataset Queries>
+void search_batch_into_with(
+    Index& index,
+    svs::QueryResultView<I> result,
+    const Queries& queries,
+    const search_parameters_t<Index>& search_parameters,
+    const svs::SearchFilter& filter
+) {
+    // Assert pre-conditions.
+    assert(result.n_queries() == queries.size());
+    index.search(result, queries, search_parameters, filter);
+}
+
+// Apply default search parameters
+template <typename Index, std::integral I, data::ImmutableMemoryDataset Queries>
+void search_batch_into(
+    Index& index,
+    svs::QueryResultView<I> result,
+    const Queries& queries,
+    const svs::SearchFilter& filter
+) {
+    svs::index::search_batch_into_with(
+        index, result, queries, index.get_search_parameters(), filter
+    );
+}
+
+// Allocate the destination result and invoke `search_batch_into`.
+template <typename Index, data::ImmutableMemoryDataset Queries>
+svs::QueryResult<size_t> search_batch_with(
+    Index& index,
+    const Queries& queries,
+    size_t num_neighbors,
+    const search_parameters_t<Index>& search_parameters,
+    const svs::SearchFilter& filter
+) {
+    auto result = svs::QueryResult<size_t>{queries.size(), num_neighbors};
+    svs::index::search_batch_into_with(
+        index, result.view(), queries, search_parameters, filter
+    );
+    return result;
+}
+
+// Obtain default search parameters.
+template <typename Index, data::ImmutableMemoryDataset Queries>
+svs::QueryResult<size_t> search_batch(
+    Index& index,
+    const Queries& queries,
+    size_t num_neighbors,
+    const svs::SearchFilter& filter
+) {
+    return svs::index::search_batch_with(
+        index, queries, num_neighbors, index.get_search_parameters(), filter
+    );
+}
+
+/////
+///// Range Search
+/////
+
+// Return all indexed elements within `radius` of each query.
+template <typename Index, data::ImmutableMemoryDataset Queries>
+svs::RangeSearchResult<size_t> range_search_with(
+    Index& index,
+    const Queries& queries,
+    float radius,
+    const search_parameters_t<Index>& search_parameters
+) {
+    return index.range_search(queries, radius, search_parameters);
+}
+
+// Obtain default search parameters.
+template <typename Index, data::ImmutableMemoryDataset Queries>
+svs::RangeSearchResult<size_t>
+range_search(Index& index, const Queries& queries, float radius) {
+    return svs::index::range_search_with(
+        index, queries, radius, index.get_search_parameters()
+    );
+}
 } // namespace svs::index
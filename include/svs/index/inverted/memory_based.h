@@ -13,6 +13,9 @@
 
 // svs
 #include "svs/concepts/data.h"
+#include "svs/core/allocator.h"
+#include "svs/core/bitset.h"
+#include "svs/core/io/native.h"
 #include "svs/index/inverted/clustering.h"
 #include "svs/index/inverted/common.h"
 #include "svs/index/inverted/extensions.h"
@@ -21,6 +24,9 @@
 
 // stl
 #include <concepts>
+#include <filesystem>
+#include <memory>
+#include <string_view>
 
 namespace svs::index::inverted {
 
@@ -28,6 +34,46 @@ namespace detail {
 inline size_t get_number_of_centroids(size_t datasize, lib::Percent percent_centroids) {
     return lib::narrow_cast<size_t>(std::floor(datasize * percent_centroids.value()));
 }
+
+// Sub-directories used by ``InvertedIndex::save``.
+inline constexpr std::string_view primary_config_dir = "primary_config";
+inline constexpr std::string_view primary_graph_dir = "primary_graph";
+inline constexpr std::string_view primary_data_dir = "primary_data";
+inline constexpr std::string_view inverted_config_dir = "inverted_config";
+
+// Ensure that clustered datasets are reloaded with the same integer type they were saved
+// with.
+template <std::integral I> void check_integer_type(const lib::LoadTable& table) {
+    auto saved_integer_type = lib::load_at<DataType>(table, "integer_type");
+    if (saved_integer_type != datatype_v<I>) {
+        auto type = datatype_v<I>;
+        throw ANNEXCEPTION(
+            "Clustering was saved using {} but we're trying to reload it using {}!",
+            saved_integer_type,
+            type
+        );
+    }
+}
+
+inline void check_filesize(const std::filesystem::path& file, size_t expected_filesize) {
+    size_t actual_filesize = std::filesystem::file_size(file);
+    if (actual_filesize != expected_filesize) {
+        throw ANNEXCEPTION(
+            "Expected file {} to have size {}. Instead, it is {}!",
+            file,
+            expected_filesize,
+            actual_filesize
+        );
+    }
+}
+
+// Dense leaves can only be written to (and memory mapped from) a single contiguous file
+// when they are stored as dense, uncompressed vectors.
+template <typename Data> inline constexpr bool is_mappable_leaf_v = false;
+
+template <typename T, size_t Extent, typename Alloc>
+inline constexpr bool is_mappable_leaf_v<data::SimpleData<T, Extent, Alloc>> =
+    data::SimpleData<T, Extent, Alloc>::is_memory_map_compatible;
 } // namespace detail
 
 /////
@@ -131,66 +177,59 @@ template <data::MemoryDataset Data, std::integral I> class SparseClusteredDatase
     size_t get_prefetch_offset() const { return prefetch_offset_; }
     void set_prefetch_offset(size_t offset) { prefetch_offset_ = offset; }
 
-    // ///// Saving and Loading.
-    // static constexpr lib::Version save_version{0, 0, 0};
-    // lib::SaveTable save(const lib::SaveContext& ctx) const {
-    //     // Save the IDs to a file.
-    //     auto ids_file = ctx.generate_name("cluster_ids", "bin");
-    //     size_t filesize = 0;
-    //     {
-    //         auto io = lib::open_write(ids_file);
-    //         for (auto& v : ids_) {
-    //             filesize += lib::write_binary(io, v.size());
-    //             filesize += lib::write_binary(io, v);
-    //         }
-    //     }
-
-    //     return lib::SaveTable(
-    //         save_version,
-    //         {{"ids_file", lib::save(ids_file.filename())},
-    //          SVS_LIST_SAVE(filesize),
-    //          {"num_clusters", lib::save(ids_.size())},
-    //          {"integer_type", lib::save(datatype_v<I>)},
-    //          SVS_LIST_SAVE_(data, ctx)}
-    //     );
-    // }
-
-    // template <typename Alloc = typename Data::allocator_type>
-    // static SparseClusteredDataset load(
-    //     const toml::table& table,
-    //     const lib::LoadContext& ctx,
-    //     const lib::Version& version,
-    //     const Alloc& allocator = {}
-    // ) {
-    //     // Ensure we have the correct integer type when decoding.
-    //     auto saved_integer_type = lib::load_at<DataType>(table, "integer_type");
-    //     if (saved_integer_type != datatype_v<I>) {
-    //         auto type = datatype_v<I>;
-    //         auto msg = fmt::format(
-    //             "Clustering was saved using {} but we're trying to reload it using {}!",
-    //             saved_integer_type,
-    //             type
-    //         );
-    //         throw ANNEXCEPTION(msg);
-    //     }
-
-    //     auto num_clusters = lib::load_at<size_t>(table, "num_clusters");
-    //     auto file = ctx.get_directory();
-    //     file /= lib::load_at<std::filesystem::path>(table, "ids_file");
-    //     auto ids = std::vector<std::vector<SparseIDs<I>>>();
-    //     {
-    //         auto io = lib::open_read(file);
-    //         for (size_t i = 0; i < num_clusters; ++i) {
-    //             size_t cluster_size = lib::read_binary<size_t>(io);
-    //             auto& v = ids.emplace_back(cluster_size);
-    //             lib::read_binary(io, v);
-    //         }
-    //     }
-
-    //     return SparseClusteredDataset(
-    //         SVS_LOAD_MEMBER_AT(table, ctx, allocator), std::move(ids)
-    //     );
-    // }
+    /// @brief Return the number of unique leaf elements stored across all clusters.
+    size_t num_leaves() const { return data_.size(); }
+
+    ///// Saving and Loading.
+    static constexpr lib::Version save_version{0, 0, 0};
+    static constexpr std::string_view serialization_schema = "sparse_clustered_dataset";
+    lib::SaveTable save(const lib::SaveContext& ctx) const {
+        // Save the IDs to a file.
+        auto ids_file = ctx.generate_name("cluster_ids", "bin");
+        size_t filesize = 0;
+        {
+            auto io = lib::open_write(ids_file);
+            for (auto& v : ids_) {
+                filesize += lib::write_binary(io, v.size());
+                filesize += lib::write_binary(io, v);
+            }
+        }
+
+        return lib::SaveTable(
+            serialization_schema,
+            save_version,
+            {{"ids_file", lib::save(ids_file.filename())},
+             SVS_LIST_SAVE(filesize),
+             {"num_clusters", lib::save(ids_.size())},
+             {"integer_type", lib::save(datatype_v<I>)},
+             SVS_LIST_SAVE_(prefetch_offset),
+             SVS_LIST_SAVE_(data, ctx)}
+        );
+    }
+
+    template <typename... Args>
+    static SparseClusteredDataset load(const lib::LoadTable& table, Args&&... args) {
+        detail::check_integer_type<I>(table);
+
+        auto num_clusters = lib::load_at<size_t>(table, "num_clusters");
+        auto ids = std::vector<std::vector<SparseIDs<I>>>();
+        {
+            auto file = table.resolve_at("ids_file");
+            detail::check_filesize(file, lib::load_at<size_t>(table, "filesize"));
+            auto io = lib::open_read(file);
+            for (size_t i = 0; i < num_clusters; ++i) {
+                auto cluster_size = lib::read_binary<size_t>(io);
+                auto& v = ids.emplace_back(cluster_size);
+                lib::read_binary(io, v);
+            }
+        }
+
+        auto dataset = SparseClusteredDataset(
+            lib::load_at<Data>(table, "data", SVS_FWD(args)...), std::move(ids)
+        );
+        dataset.set_prefetch_offset(SVS_LOAD_MEMBER_AT_(table, prefetch_offset));
+        return dataset;
+    }
 };
 
 ///// DenseClusteredDataset
@@ -228,17 +267,26 @@ template <typename Data, std::integral I> struct DenseCluster {
     std::vector<I> ids_;
 };
 
-template <data::MemoryDataset Data, std::integral I> class DenseClusteredDataset {
+///
+/// @brief Clustered dataset with the leaves of each cluster co-located in memory.
+///
+/// Uncompressed leaves are saved into a single contiguous file. Reloading the dataset as a
+/// ``DenseClusteredDataset`` over constant views (see ``MappedDenseClusteredDataset``)
+/// memory maps that file rather than copying the leaves into memory.
+///
+template <data::ImmutableMemoryDataset Data, std::integral I> class DenseClusteredDataset {
   public:
     // Type aliases
     using index_type = I;
+    using cluster_type = DenseCluster<Data, I>;
 
     // Constructor
     template <typename Original, typename Alloc>
     DenseClusteredDataset(
         const Original& original, const Clustering<I>& clustering, const Alloc& allocator
     )
-        : clusters_{} {
+        : clusters_{}
+        , num_leaves_{clustering.leaf_histogram().size()} {
         clustering.for_each_cluster([&](const auto& cluster) {
             size_t cluster_size = cluster.size();
             // Create a new dense leaf for this data structure.
@@ -256,6 +304,22 @@ template <data::MemoryDataset Data, std::integral I> class DenseClusteredDataset
         });
     }
 
+    ///
+    /// @brief Construct directly from clusters.
+    ///
+    /// @param clusters The dense clusters.
+    /// @param num_leaves The number of unique leaf elements across all clusters.
+    /// @param storage Optional owner of memory referenced by the clusters.
+    ///
+    DenseClusteredDataset(
+        std::vector<cluster_type> clusters,
+        size_t num_leaves,
+        std::shared_ptr<void> storage = nullptr
+    )
+        : clusters_{std::move(clusters)}
+        , num_leaves_{num_leaves}
+        , storage_{std::move(storage)} {}
+
     template <typename Callback> void on_leaves(Callback&& f, size_t cluster) const {
         clusters_.at(cluster).on_leaves(SVS_FWD(f));
     }
@@ -263,11 +327,153 @@ template <data::MemoryDataset Data, std::integral I> class DenseClusteredDataset
     size_t get_prefetch_offset() const { return prefetch_offset_; }
     void set_prefetch_offset(size_t offset) { prefetch_offset_ = offset; }
 
+    /// @brief Return the number of clusters.
+    size_t num_clusters() const { return clusters_.size(); }
+
+    /// @brief Return the number of unique leaf elements stored across all clusters.
+    size_t num_leaves() const { return num_leaves_; }
+
+    /// @brief Return the cluster at index ``i``.
+    const cluster_type& cluster(size_t i) const { return clusters_.at(i); }
+
+    /// @brief Return the dimensionality of the leaf elements.
+    size_t dimensions() const {
+        return clusters_.empty() ? 0 : clusters_.front().data_.dimensions();
+    }
+
+    ///// Saving and Loading.
+    static constexpr lib::Version save_version{0, 0, 0};
+    static constexpr std::string_view serialization_schema = "dense_clustered_dataset";
+    lib::SaveTable save(const lib::SaveContext& ctx) const
+        requires detail::is_mappable_leaf_v<Data>
+    {
+        using T = std::remove_const_t<typename Data::element_type>;
+
+        // Write all leaves contiguously in cluster order.
+        auto leaves_file = ctx.generate_name("dense_leaves", "svs");
+        size_t total_leaves = 0;
+        {
+            auto writer =
+                io::v1::NativeFile(leaves_file).writer(lib::Type<T>(), dimensions());
+            for (const auto& cluster : clusters_) {
+                for (size_t i = 0, imax = cluster.size(); i < imax; ++i) {
+                    writer << cluster.data_.get_datum(i);
+                }
+                total_leaves += cluster.size();
+            }
+        }
+
+        // Save the IDs to a file.
+        auto ids_file = ctx.generate_name("cluster_ids", "bin");
+        size_t filesize = 0;
+        {
+            auto io = lib::open_write(ids_file);
+            for (const auto& cluster : clusters_) {
+                filesize += lib::write_binary(io, cluster.ids_.size());
+                filesize += lib::write_binary(io, cluster.ids_);
+            }
+        }
+
+        return lib::SaveTable(
+            serialization_schema,
+            save_version,
+            {{"leaves_file", lib::save(leaves_file.filename())},
+             {"ids_file", lib::save(ids_file.filename())},
+             SVS_LIST_SAVE(filesize),
+             {"num_clusters", lib::save(clusters_.size())},
+             SVS_LIST_SAVE_(num_leaves),
+             SVS_LIST_SAVE(total_leaves),
+             {"dims", lib::save(dimensions())},
+             {"eltype", lib::save(datatype_v<T>)},
+             {"integer_type", lib::save(datatype_v<I>)},
+             SVS_LIST_SAVE_(prefetch_offset)}
+        );
+    }
+
+    // Reloading memory maps the leaves, so is only available for constant views.
+    static DenseClusteredDataset load(const lib::LoadTable& table)
+        requires(detail::is_mappable_leaf_v<Data> && Data::is_view && Data::is_const)
+    {
+        using T = std::remove_const_t<typename Data::element_type>;
+        detail::check_integer_type<I>(table);
+        auto eltype = lib::load_at<DataType>(table, "eltype");
+        if (eltype != datatype_v<T>) {
+            throw ANNEXCEPTION(
+                "Trying to load dense leaves with element type {} as {}!",
+                eltype,
+                datatype_v<T>
+            );
+        }
+
+        auto num_clusters = lib::load_at<size_t>(table, "num_clusters");
+        auto total_leaves = lib::load_at<size_t>(table, "total_leaves");
+        auto dims = lib::load_at<size_t>(table, "dims");
+
+        // Memory map the leaves.
+        auto file = io::v1::NativeFile(table.resolve_at("leaves_file"));
+        auto [file_leaves, file_dims] = file.get_dims();
+        if (file_leaves != total_leaves || (total_leaves != 0 && file_dims != dims)) {
+            throw ANNEXCEPTION(
+                "Expected {} dense leaves with {} dimensions. Instead, found {} with {}!",
+                total_leaves,
+                dims,
+                file_leaves,
+                file_dims
+            );
+        }
+
+        using pointer_type = io::v1::NativeFile::pointer<const T>;
+        auto mapping = std::make_shared<pointer_type>(file.mmap(
+            lib::Type<const T>(),
+            lib::Bytes(sizeof(T) * total_leaves * dims),
+            MemoryMapper(MemoryMapper::ReadOnly, MemoryMapper::MustUseExisting)
+        ));
+
+        // Reconstruct each cluster as a view into the mapping.
+        auto clusters = std::vector<cluster_type>();
+        clusters.reserve(num_clusters);
+        {
+            auto ids_file = table.resolve_at("ids_file");
+            detail::check_filesize(ids_file, lib::load_at<size_t>(table, "filesize"));
+            auto io = lib::open_read(ids_file);
+            size_t offset = 0;
+            for (size_t i = 0; i < num_clusters; ++i) {
+                auto cluster_size = lib::read_binary<size_t>(io);
+                auto ids = std::vector<I>(cluster_size);
+                lib::read_binary(io, ids);
+                if (offset + cluster_size > total_leaves) {
+                    throw ANNEXCEPTION("Cluster ids exceed the number of saved leaves!");
+                }
+                clusters.emplace_back(
+                    Data(mapping->data() + offset * dims, cluster_size, dims),
+                    std::move(ids)
+                );
+                offset += cluster_size;
+            }
+        }
+
+        auto dataset = DenseClusteredDataset(
+            std::move(clusters),
+            SVS_LOAD_MEMBER_AT_(table, num_leaves),
+            std::shared_ptr<void>(std::move(mapping))
+        );
+        dataset.set_prefetch_offset(SVS_LOAD_MEMBER_AT_(table, prefetch_offset));
+        return dataset;
+    }
+
   private:
-    std::vector<DenseCluster<Data, I>> clusters_;
+    std::vector<cluster_type> clusters_;
+    size_t num_leaves_ = 0;
     size_t prefetch_offset_ = 2;
+    // Keeps memory backing the clusters alive (e.g., a memory map of the saved leaves).
+    std::shared_ptr<void> storage_ = nullptr;
 };
 
+/// @brief A dense clustered dataset whose uncompressed leaves are memory mapped from disk.
+template <typename T, size_t Extent = Dynamic, std::integral I = uint32_t>
+using MappedDenseClusteredDataset =
+    DenseClusteredDataset<data::ConstSimpleDataView<T, Extent>, I>;
+
 namespace detail {
 
 // Associate extension customization point objects with an implementation for the in-memory
@@ -310,6 +516,34 @@ template <typename T> inline constexpr bool is_strategy_dispatcher_v = false;
 template <typename T>
 inline constexpr bool is_strategy_dispatcher_v<StrategyDispatcher<T>> = true;
 
+// Auxiliary state saved alongside the primary index by ``InvertedIndex::save``.
+template <typename Cluster> struct InvertedStateLoader {
+    using index_type = typename Cluster::index_type;
+    using translator_type = std::vector<index_type, lib::Allocator<index_type>>;
+
+    static constexpr lib::Version save_version{0, 0, 0};
+    static constexpr std::string_view serialization_schema = "inverted_index";
+
+    static bool
+    check_load_compatibility(std::string_view schema, const lib::Version& version) {
+        return schema == serialization_schema && version == save_version;
+    }
+
+    static InvertedStateLoader load(const lib::LoadTable& table) {
+        return InvertedStateLoader{
+            lib::load_at<InvertedSearchParameters>(table, "search_parameters"),
+            lib::load_at<lib::BinaryBlobLoader<index_type, lib::Allocator<index_type>>>(
+                table, "index_local_to_global"
+            ),
+            lib::load_at<Cluster>(table, "cluster")};
+    }
+
+    ///// Members
+    InvertedSearchParameters search_parameters_;
+    translator_type index_local_to_global_;
+    Cluster cluster_;
+};
+
 } // namespace detail
 
 // Cleaner aliases for the associated strategy.
@@ -331,6 +565,8 @@ template <typename Index, typename Cluster> class InvertedIndex {
     using index_type = typename Cluster::index_type;
     using translator_type = std::vector<index_type, lib::Allocator<index_type>>;
     using search_parameters_type = InvertedSearchParameters;
+    // Reads back the auxiliary state written by ``save``.
+    using state_loader_type = detail::InvertedStateLoader<Cluster>;
 
     InvertedIndex(
         Index index,
@@ -354,10 +590,8 @@ template <typename Index, typename Cluster> class InvertedIndex {
         threadpool_.resize(std::max<size_t>(num_threads, 1));
     }
 
-    size_t size() const {
-        // TODO: Fix
-        return 0;
-    }
+    /// @brief Return the number of elements in the index (centroids and leaves).
+    size_t size() const { return index_.size() + cluster_.num_leaves(); }
     size_t dimensions() const { return index_.dimensions(); }
 
     ///// Search Parameter Setting
@@ -378,6 +612,20 @@ template <typename Index, typename Cluster> class InvertedIndex {
         const Queries& queries,
         const search_parameters_type& search_parameters
     ) {
+        search(results, queries, search_parameters, SearchFilter());
+    }
+
+    // Search restricted to the IDs allowed by `filter`.
+    // The primary index is searched without the filter so excluded centroids still guide
+    // the search to their clusters. Excluded leaves are skipped before computing distances.
+    template <typename Idx, data::ImmutableMemoryDataset Queries>
+    void search(
+        QueryResultView<Idx> results,
+        const Queries& queries,
+        const search_parameters_type& search_parameters,
+        const SearchFilter& filter
+    ) {
+        filter.check(queries.size());
         threads::run(
             threadpool_,
             threads::StaticPartition(queries.size()),
@@ -393,9 +641,15 @@ template <typename Index, typename Cluster> class InvertedIndex {
                 // A search buffer to accumulate results of the cluster search.
                 auto buffer = threads::shallow_copy(scratch.buffer);
                 buffer.change_maxsize(num_neighbors);
+                using compare_type = typename decltype(buffer)::compare_type;
+                auto sentinel = type_traits::sentinel_v<Neighbor<Idx>, compare_type>;
 
                 for (auto i : is) {
                     buffer.clear();
+                    auto allowed = filter.empty() ? BitSetView() : filter.view(i);
+                    auto is_allowed = [&](index_type id) {
+                        return filter.empty() || allowed.test(id);
+                    };
                     auto&& query = queries.get_datum(i);
                     // Primary Index Search
                     index_.search(query, scratch);
@@ -421,6 +675,9 @@ template <typename Index, typename Cluster> class InvertedIndex {
                         // Compute the distance between the query and each leaf element.
                         cluster_.on_leaves(
                             [&](const auto& datum, index_type global_id) {
+                                if (!is_allowed(global_id)) {
+                                    return;
+                                }
                                 // TODO: Can we provide a better API for obtaining the
                                 // distance component of the scratchspace?
                                 auto distance =
@@ -431,25 +688,65 @@ template <typename Index, typename Cluster> class InvertedIndex {
                         );
 
                         // Add the centroid to the results.
-                        buffer.insert(
-                            {index_local_to_global_.at(cluster_id), candidate.distance()}
-                        );
+                        auto centroid_id = index_local_to_global_.at(cluster_id);
+                        if (is_allowed(centroid_id)) {
+                            buffer.insert({centroid_id, candidate.distance()});
+                        }
                     }
 
-                    // Store results
+                    // Store results.
+                    // Fewer than `num_neighbors` candidates may have been found.
                     for (size_t j = 0; j < num_neighbors; ++j) {
-                        results.set(buffer[j], i, j);
+                        if (j < buffer.size()) {
+                            results.set(buffer[j], i, j);
+                        } else {
+                            results.set(sentinel, i, j);
+                        }
                     }
                 }
             }
         );
     }
 
-    // Saving
-    // N.B.: For prototyping, we don't provide an entire saving API.
-    // Instead, we allow for saving of the underlying index and require that the
-    // clustered portion of the dataset is loaded from a `Clustering` and an original
-    // dataset.
+    ///// Saving
+    static constexpr lib::Version save_version = state_loader_type::save_version;
+    static constexpr std::string_view serialization_schema =
+        state_loader_type::serialization_schema;
+
+    ///
+    /// @brief Save the whole index to ``directory``.
+    ///
+    /// The primary index is saved into the ``primary_config``, ``primary_graph`` and
+    /// ``primary_data`` sub-directories. The clustered leaves and the ID translation for
+    /// the primary index are saved into the ``inverted_config`` sub-directory.
+    ///
+    /// The saved index can be reloaded with ``auto_load``.
+    ///
+    void save(const std::filesystem::path& directory) const {
+        std::filesystem::create_directory(directory);
+        index_.save(
+            directory / detail::primary_config_dir,
+            directory / detail::primary_graph_dir,
+            directory / detail::primary_data_dir
+        );
+
+        lib::save_to_disk(
+            lib::SaveOverride([&](const lib::SaveContext& ctx) {
+                return lib::SaveTable(
+                    serialization_schema,
+                    save_version,
+                    {{"search_parameters", lib::save(get_search_parameters())},
+                     {"index_local_to_global",
+                      lib::save(lib::BinaryBlobSaver(index_local_to_global_), ctx)},
+                     SVS_LIST_SAVE_(cluster, ctx)}
+                );
+            }),
+            directory / detail::inverted_config_dir
+        );
+    }
+
+    // Save only the primary index. The clustered portion of the dataset must then be
+    // reconstructed from a `Clustering` and the original dataset.
     void save_primary_index(
         const std::filesystem::path& index_config,
         const std::filesystem::path& graph,
@@ -592,4 +889,53 @@ auto assemble_from_clustering(
     );
 }
 
+///// Loading
+
+///
+/// @brief Reload an index previously saved with ``InvertedIndex::save``.
+///
+/// @tparam PrimaryData The dataset type of the primary index.
+/// @tparam Cluster The clustered dataset type. Dense clusters over uncompressed data
+///     should use ``MappedDenseClusteredDataset`` to memory map the saved leaves.
+///
+/// @param directory The directory given to ``InvertedIndex::save``.
+/// @param distance The distance functor to use.
+/// @param num_threads The number of threads to use for search.
+///
+template <typename PrimaryData, typename Cluster, typename Distance>
+auto auto_load(
+    const std::filesystem::path& directory, Distance distance, size_t num_threads
+) {
+    using I = typename Cluster::index_type;
+    auto index = index::vamana::auto_assemble(
+        directory / detail::primary_config_dir,
+        GraphLoader<I>(directory / detail::primary_graph_dir),
+        lib::Lazy([&]() {
+            return lib::load_from_disk<PrimaryData>(directory / detail::primary_data_dir);
+        }),
+        distance,
+        1
+    );
+
+    auto state = lib::load_from_disk<detail::InvertedStateLoader<Cluster>>(
+        directory / detail::inverted_config_dir
+    );
+    if (state.index_local_to_global_.size() != index.size()) {
+        throw ANNEXCEPTION(
+            "Primary index has {} elements but its ID translation has {}!",
+            index.size(),
+            state.index_local_to_global_.size()
+        );
+    }
+
+    auto inverted = InvertedIndex(
+        std::move(index),
+        std::move(state.cluster_),
+        std::move(state.index_local_to_global_),
+        threads::NativeThreadPool(num_threads)
+    );
+    inverted.set_search_parameters(state.search_parameters_);
+    return inverted;
+}
+
 } // namespace svs::index::inverted
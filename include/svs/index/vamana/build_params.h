@@ -29,14 +29,20 @@ struct VamanaBuildParameters {
         size_t window_size_,
         size_t max_candidate_pool_size_,
         size_t prune_to_,
-        bool use_full_search_history_
+        bool use_full_search_history_,
+        size_t num_entry_points_ = 1,
+        bool use_exact_visited_set_ = false,
+        bool use_vectorized_search_buffer_ = false
     )
         : alpha{alpha_}
         , graph_max_degree{graph_max_degree_}
         , window_size{window_size_}
         , max_candidate_pool_size{max_candidate_pool_size_}
         , prune_to{prune_to_}
-        , use_full_search_history{use_full_search_history_} {}
+        , use_full_search_history{use_full_search_history_}
+        , num_entry_points{num_entry_points_}
+        , use_exact_visited_set{use_exact_visited_set_}
+        , use_vectorized_search_buffer{use_vectorized_search_buffer_} {}
 
     /// The pruning parameter.
     float alpha;
@@ -67,6 +73,23 @@ struct VamanaBuildParameters {
     /// The latter case may yield a slightly better graph as the cost of more search time.
     bool use_full_search_history = true;
 
+    /// The total number of entry points available to search. When greater than one, the
+    /// elements closest to the centroids of a k-means clustering of the dataset are used as
+    /// additional entry points after graph construction. Each search starts from the
+    /// entry points closest to its query, which shortens the path through the graph for
+    /// skewed or multi-modal datasets.
+    size_t num_entry_points = 1;
+
+    /// Track the candidates visited by each construction search exactly. The default
+    /// visited filter is lossy and may recompute distances for large window sizes, while
+    /// the exact set uses up to two bytes per dataset element for each construction thread.
+    bool use_exact_visited_set = false;
+
+    /// Use the structure-of-arrays search buffer with SIMD insertion for construction
+    /// searches. Results are identical to the default buffer; this is an experimental
+    /// option until construction-time measurements show a consistent improvement.
+    bool use_vectorized_search_buffer = false;
+
     ///// Comparison
     friend bool
     operator==(const VamanaBuildParameters&, const VamanaBuildParameters&) = default;
@@ -79,7 +102,14 @@ struct VamanaBuildParameters {
     // v0.0.0 - Initial version
     // v0.0.1 - Add the "prune_to" parameter.
     //   * Behavior if loading from v0.0.0: Set "prune_to = graph_max_degree"
-    static constexpr lib::Version save_version = lib::Version(0, 0, 1);
+    // v0.0.2 - Add the "num_entry_points" parameter.
+    //   * Behavior if loading from older versions: Set "num_entry_points = 1"
+    // v0.0.3 - Add the "use_exact_visited_set" parameter.
+    //   * Behavior if loading from older versions: Set "use_exact_visited_set = false"
+    // v0.0.4 - Add the "use_vectorized_search_buffer" parameter.
+    //   * Behavior if loading from older versions: Set
+    //     "use_vectorized_search_buffer = false"
+    static constexpr lib::Version save_version = lib::Version(0, 0, 4);
     static constexpr std::string_view serialization_schema = "vamana_build_parameters";
 
     lib::SaveTable save() const {
@@ -92,6 +122,9 @@ struct VamanaBuildParameters {
              SVS_LIST_SAVE(max_candidate_pool_size),
              SVS_LIST_SAVE(prune_to),
              SVS_LIST_SAVE(use_full_search_history),
+             SVS_LIST_SAVE(num_entry_points),
+             SVS_LIST_SAVE(use_exact_visited_set),
+             SVS_LIST_SAVE(use_vectorized_search_buffer),
              SVS_LIST_SAVE(name)}
         );
     }
@@ -114,13 +147,32 @@ struct VamanaBuildParameters {
             prune_to = lib::load_at<size_t>(table, "prune_to");
         }
 
+        size_t num_entry_points = 1;
+        if (table.version() > lib::Version(0, 0, 1)) {
+            num_entry_points = lib::load_at<size_t>(table, "num_entry_points");
+        }
+
+        bool use_exact_visited_set = false;
+        if (table.version() > lib::Version(0, 0, 2)) {
+            use_exact_visited_set = lib::load_at<bool>(table, "use_exact_visited_set");
+        }
+
+        bool use_vectorized_search_buffer = false;
+        if (table.version() > lib::Version(0, 0, 3)) {
+            use_vectorized_search_buffer =
+                lib::load_at<bool>(table, "use_vectorized_search_buffer");
+        }
+
         return VamanaBuildParameters(
             SVS_LOAD_MEMBER_AT(table, alpha),
             graph_max_degree,
             SVS_LOAD_MEMBER_AT(table, window_size),
             SVS_LOAD_MEMBER_AT(table, max_candidate_pool_size),
             prune_to,
-            SVS_LOAD_MEMBER_AT(table, use_full_search_history)
+            SVS_LOAD_MEMBER_AT(table, use_full_search_history),
+            num_entry_points,
+            use_exact_visited_set,
+            use_vectorized_search_buffer
         );
     }
 };
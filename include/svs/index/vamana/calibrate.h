@@ -82,6 +82,17 @@ namespace svs::index::vamana {
 //
 // This process continues until the target recall can no longer be achieved, at which point
 // the algorithm terminates.
+//
+// For datasets that use reranking, the rerank depth is tuned next. The search buffer is
+// optimized while reranking the entire buffer, after which a binary search determines the
+// smallest number of reranked candidates that still achieves the target recall. This
+// depth is kept if it is faster than reranking everything.
+//
+// Finally, early termination may be tuned (opt-in). Early termination gives up some recall
+// at a fixed search window size in exchange for fewer candidate expansions. For each
+// candidate patience, a binary search finds the smallest search window size that reaches
+// the target recall with that patience. The fastest configuration wins, including the
+// configuration without early termination.
 
 struct CalibrationParameters {
     enum class SearchBufferOptimization { Disable, All, ROIOnly, ROITuneUp };
@@ -98,6 +109,8 @@ struct CalibrationParameters {
     double search_timeout_ = 0.125;
     /// The steps to use when training prefetchers.
     std::vector<size_t> prefetch_steps_ = {1, 2, 4};
+    /// The early termination patience values to try.
+    std::vector<size_t> early_termination_patience_ = {4, 8, 16, 32, 64};
 
     ///// Flags determining which aspects of the algorithm will be run.
 
@@ -105,6 +118,10 @@ struct CalibrationParameters {
     SearchBufferOptimization search_buffer_optimization_ = SearchBufferOptimization::All;
     /// Do we train the prefetchers as well?
     bool train_prefetchers_ = true;
+    /// Do we tune the rerank depth for datasets that use reranking?
+    bool train_rerank_depth_ = true;
+    /// Do we tune the early termination patience?
+    bool train_early_termination_ = false;
     /// Should we obtain untrained parameters from default values or from the index.
     bool use_existing_parameter_values_ = true;
 
@@ -335,6 +352,126 @@ std::pair<VamanaSearchParameters, bool> optimize_search_buffer(
     return std::make_pair(current, converged);
 }
 
+template <typename Index, typename ComputeRecall, typename DoSearch>
+VamanaSearchParameters tune_rerank_depth(
+    const CalibrationParameters& calibration_parameters,
+    VamanaSearchParameters current,
+    size_t num_neighbors,
+    double target_recall,
+    const ComputeRecall& compute_recall,
+    const DoSearch& do_search
+) {
+    using dataset_type = typename Index::data_type;
+    if (!extensions::calibration_uses_reranking<dataset_type>()) {
+        return current;
+    }
+
+    auto logger = svs::logging::get();
+    svs::logging::trace(logger, "Tuning rerank depth");
+
+    // Reranking the entire buffer is the baseline.
+    current.rerank_depth_ = 0;
+    size_t capacity = current.buffer_config_.get_total_capacity();
+    if (capacity <= num_neighbors) {
+        return current;
+    }
+    double min_search_time = get_search_time(calibration_parameters, do_search, current);
+    svs::logging::trace(logger, "Time reranking all candidates: {}s", min_search_time);
+
+    // Find the smallest depth meeting the target recall.
+    // If no depth less than the capacity works, this yields the capacity itself.
+    auto sp = current;
+    auto range = threads::UnitRange<size_t>(num_neighbors, capacity);
+    auto rerank_depth = *std::lower_bound(
+        range.begin(),
+        range.end(),
+        target_recall,
+        [&](size_t depth, double recall) {
+            sp.rerank_depth_ = depth;
+            return compute_recall(sp) < recall;
+        }
+    );
+    if (rerank_depth >= capacity) {
+        return current;
+    }
+
+    sp.rerank_depth_ = rerank_depth;
+    double search_time = get_search_time(calibration_parameters, do_search, sp);
+    svs::logging::trace(
+        logger, "Best rerank depth: {}, Search time: {}s", rerank_depth, search_time
+    );
+    if (search_time < min_search_time) {
+        current = sp;
+    }
+    return current;
+}
+
+template <typename ComputeRecall, typename DoSearch>
+VamanaSearchParameters tune_early_termination(
+    const CalibrationParameters& calibration_parameters,
+    VamanaSearchParameters current,
+    double target_recall,
+    const ComputeRecall& compute_recall,
+    const DoSearch& do_search
+) {
+    auto logger = svs::logging::get();
+    svs::logging::trace(logger, "Tuning early termination");
+
+    // Searching without early termination is the baseline.
+    current.early_termination_patience_ = 0;
+    double min_search_time = get_search_time(calibration_parameters, do_search, current);
+    svs::logging::trace(logger, "Time without early termination: {}s", min_search_time);
+
+    // Early termination only ever removes work from a search, so search window sizes
+    // smaller than the current one cannot reach the target recall.
+    const size_t capacity = current.buffer_config_.get_total_capacity();
+    const size_t window_lower = current.buffer_config_.get_search_window_size();
+    const size_t window_upper = calibration_parameters.search_window_size_upper_;
+    if (window_lower >= window_upper) {
+        return current;
+    }
+
+    auto sp = current;
+    auto configure_buffer = [&](size_t search_window_size) {
+        sp.buffer_config({search_window_size, std::max(search_window_size, capacity)});
+    };
+    for (auto patience : calibration_parameters.early_termination_patience_) {
+        if (patience == 0) {
+            continue;
+        }
+        sp.early_termination_patience_ = patience;
+        auto range = threads::UnitRange<size_t>(window_lower, window_upper);
+        auto search_window_size = *std::lower_bound(
+            range.begin(),
+            range.end(),
+            target_recall,
+            [&](size_t window_size, double recall) {
+                configure_buffer(window_size);
+                return compute_recall(sp) < recall;
+            }
+        );
+        if (search_window_size >= window_upper) {
+            svs::logging::trace(logger, "Patience {} cannot reach the target", patience);
+            continue;
+        }
+
+        configure_buffer(search_window_size);
+        double search_time = get_search_time(calibration_parameters, do_search, sp);
+        svs::logging::trace(
+            logger,
+            "Patience {}, search window size {}, search time: {}s",
+            patience,
+            search_window_size,
+            search_time
+        );
+        if (search_time < min_search_time) {
+            min_search_time = search_time;
+            current = sp;
+        }
+    }
+    return current;
+}
+
 template <typename Index, typename DoSearch>
 VamanaSearchParameters tune_prefetch(
     const CalibrationParameters& calibration_parameters,
@@ -485,6 +622,16 @@ VamanaSearchParameters calibrate(
                        ? preset_parameters
                        : default_parameters;
 
+    // Optimize the search buffer with full reranking if the rerank depth will be tuned.
+    if (calibration_parameters.train_rerank_depth_) {
+        current.rerank_depth_ = 0;
+    }
+
+    // Likewise, optimize the search buffer without early termination if it will be tuned.
+    if (calibration_parameters.train_early_termination_) {
+        current.early_termination_patience_ = 0;
+    }
+
     // Step 1: Optimize aspects of the search buffer if desired.
     if (calibration_parameters.should_optimize_search_buffer()) {
         svs::logging::trace("Optimizing search buffer.");
@@ -506,7 +653,28 @@ VamanaSearchParameters calibrate(
         }
     }
 
-    // Step 2: Optimize prefetch parameters.
+    // Step 2: Optimize the rerank depth.
+    if (calibration_parameters.train_rerank_depth_) {
+        svs::logging::trace("Tuning rerank depth.");
+        current = calibration::tune_rerank_depth<Index>(
+            calibration_parameters,
+            current,
+            num_neighbors,
+            target_recall,
+            compute_recall,
+            do_search
+        );
+    }
+
+    // Step 3: Optimize early termination.
+    if (calibration_parameters.train_early_termination_) {
+        svs::logging::trace("Tuning early termination.");
+        current = calibration::tune_early_termination(
+            calibration_parameters, current, target_recall, compute_recall, do_search
+        );
+    }
+
+    // Step 4: Optimize prefetch parameters.
     if (calibration_parameters.train_prefetchers_) {
         svs::logging::trace("Training Prefetchers.");
         current =
@@ -0,0 +1,692 @@
+/**
+ *    Copyright (C) 2023, Intel Corporation
+ *
+ *    You can redistribute and/or modify this software under the terms of the
+ *    GNU Affero General Public License version 3.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    version 3 along with this software. If not, see
+ *    <https://www.gnu.org/licenses/agpl-3.0.en.html>.
+ */
+
+#pragma once
+
+// svs
+#include "svs/core/data.h"
+#include "svs/core/distance.h"
+#include "svs/core/graph.h"
+#include "svs/core/query_result.h"
+#include "svs/index/vamana/greedy_search.h"
+#include "svs/index/vamana/inlined_graph.h"
+#include "svs/index/vamana/search_buffer.h"
+#include "svs/lib/block_file.h"
+#include "svs/lib/exception.h"
+#include "svs/lib/file.h"
+#include "svs/lib/misc.h"
+#include "svs/lib/narrow.h"
+#include "svs/lib/neighbor.h"
+#include "svs/lib/preprocessor.h"
+#include "svs/lib/readwrite.h"
+#include "svs/lib/saveload.h"
+#include "svs/lib/threads.h"
+#include "svs/lib/type_traits.h"
+
+// stl
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace svs::index::vamana {
+
+///
+/// @brief Geometry of the on-disk records of a ``DiskVamanaIndex``.
+///
+/// Each vertex is stored as a record laid out as
+/// @code{}
+/// [degree][neighbor 0]...[neighbor R - 1][full-precision vector as float32]
+/// @endcode
+/// where ``R`` is the maximum degree. Records are packed into blocks of whole sectors,
+/// either several records per sector or one record spanning several sectors, so that
+/// fetching a vertex reads a single sector-aligned block.
+///
+template <std::integral Idx> class DiskLayout {
+  public:
+    /// The default sector size, compatible with direct I/O on all common devices.
+    static constexpr size_t default_sector_bytes = 4096;
+
+    /// @brief Construct an empty layout.
+    DiskLayout() = default;
+
+    ///
+    /// @brief Construct the layout for vectors of ``dimensions`` elements.
+    ///
+    /// @param dimensions The number of dimensions of each vector.
+    /// @param max_degree The largest number of neighbors of any vertex.
+    /// @param sector_bytes The size of a sector. Must be a power of two.
+    ///
+    DiskLayout(
+        size_t dimensions, size_t max_degree, size_t sector_bytes = default_sector_bytes
+    )
+        : dimensions_{dimensions}
+        , max_degree_{max_degree}
+        , sector_bytes_{sector_bytes}
+        , vector_offset_{(max_degree + 1) * sizeof(Idx)}
+        , record_bytes_{lib::round_up_to_multiple_of(
+              vector_offset_ + dimensions * sizeof(float), sizeof(Idx)
+          )}
+        , block_bytes_{lib::round_up_to_multiple_of(record_bytes_, sector_bytes)} {
+        if (sector_bytes == 0 || (sector_bytes & (sector_bytes - 1)) != 0) {
+            throw ANNEXCEPTION("Sector size {} is not a power of two!", sector_bytes);
+        }
+    }
+
+    /// @brief Return the number of dimensions of each vector.
+    size_t dimensions() const { return dimensions_; }
+    /// @brief Return the largest number of neighbors of any vertex.
+    size_t max_degree() const { return max_degree_; }
+    /// @brief Return the size of a sector.
+    size_t sector_bytes() const { return sector_bytes_; }
+    /// @brief Return the size of the record of a vertex.
+    size_t record_bytes() const { return record_bytes_; }
+    /// @brief Return the size of the block read to fetch a vertex.
+    size_t block_bytes() const { return block_bytes_; }
+    /// @brief Return the number of records stored in each block.
+    size_t records_per_block() const { return block_bytes_ / record_bytes_; }
+
+    /// @brief Return the number of blocks storing ``num_nodes`` vertices.
+    size_t num_blocks(size_t num_nodes) const {
+        return lib::div_round_up(num_nodes, records_per_block());
+    }
+    /// @brief Return the file offset of the block holding vertex ``i``.
+    size_t block_offset(size_t i) const { return (i / records_per_block()) * block_bytes_; }
+    /// @brief Return the offset of the record of vertex ``i`` within its block.
+    size_t record_offset(size_t i) const {
+        return (i % records_per_block()) * record_bytes_;
+    }
+
+    /// @brief Return the adjacency list stored in ``record``.
+    std::span<const Idx> neighbors(const std::byte* record) const {
+        const auto* header = reinterpret_cast<const Idx*>(record);
+        return std::span<const Idx>(header + 1, header[0]);
+    }
+
+    /// @brief Return the vector stored in ``record``.
+    std::span<const float> vector(const std::byte* record) const {
+        return std::span<const float>(
+            reinterpret_cast<const float*>(record + vector_offset_), dimensions_
+        );
+    }
+
+    /// @brief Store the adjacency list and vector of a vertex in ``record``.
+    template <typename Datum>
+    void write_record(
+        std::byte* record, std::span<const Idx> neighbors, const Datum& datum
+    ) const {
+        assert(neighbors.size() <= max_degree_);
+        assert(datum.size() == dimensions_);
+        std::memset(record, 0, record_bytes_);
+        auto* header = reinterpret_cast<Idx*>(record);
+        header[0] = lib::narrow<Idx>(neighbors.size());
+        std::copy(neighbors.begin(), neighbors.end(), header + 1);
+        auto* vector = reinterpret_cast<float*>(record + vector_offset_);
+        for (size_t d = 0; d < dimensions_; ++d) {
+            vector[d] = static_cast<float>(datum[d]);
+        }
+    }
+
+    friend bool operator==(const DiskLayout&, const DiskLayout&) = default;
+
+  private:
+    size_t dimensions_ = 0;
+    size_t max_degree_ = 0;
+    size_t sector_bytes_ = default_sector_bytes;
+    size_t vector_offset_ = 0;
+    size_t record_bytes_ = 0;
+    size_t block_bytes_ = 0;
+};
+
+/// @brief Runtime parameters controlling the accuracy and performance of disk search.
+struct DiskSearchParameters {
+  public:
+    /// @brief Configuration of the search buffer.
+    ///
+    /// Candidates are ordered by their distances estimated from the in-memory codes.
+    /// Every candidate expanded from the search window costs one block read.
+    SearchBufferConfig buffer_config_{};
+
+    /// @brief The number of candidates expanded together on each step of search.
+    ///
+    /// The blocks of all candidates in the beam are read concurrently before any of them
+    /// is expanded. Wider beams reduce the number of dependent reads at the cost of more
+    /// total reads.
+    size_t beam_width_ = 4;
+
+  public:
+    DiskSearchParameters() = default;
+    DiskSearchParameters(SearchBufferConfig buffer_config, size_t beam_width)
+        : buffer_config_{buffer_config}
+        , beam_width_{beam_width} {}
+
+    SVS_CHAIN_SETTER_(DiskSearchParameters, buffer_config);
+    SVS_CHAIN_SETTER_(DiskSearchParameters, beam_width);
+
+    friend bool operator==(const DiskSearchParameters&, const DiskSearchParameters&) =
+        default;
+};
+
+namespace detail {
+
+inline constexpr std::string_view disk_index_schema = "vamana_disk_index";
+inline constexpr lib::Version disk_index_save_version = lib::Version(0, 0, 0);
+
+// Serializer writing the components of a disk index from an in-memory graph and dataset.
+template <typename Graph, typename Data, std::integral Idx> struct DiskIndexWriter {
+    const Graph& graph_;
+    const Data& data_;
+    std::span<const Idx> entry_points_;
+    std::span<const Idx> external_ids_;
+    threads::NativeThreadPool& threadpool_;
+    DiskLayout<Idx> layout_;
+
+    // Records are written in batches of roughly this many bytes.
+    static constexpr size_t batch_bytes = size_t{1} << 26;
+
+    static constexpr std::string_view serialization_schema = disk_index_schema;
+    static constexpr lib::Version save_version = disk_index_save_version;
+
+    lib::SaveTable save(const lib::SaveContext& ctx) const {
+        const size_t num_nodes = graph_.n_nodes();
+        auto codebook = NeighborCodebook::train(data_, threadpool_);
+        const size_t code_bytes = codebook.code_bytes();
+        auto codes = std::vector<uint8_t>(num_nodes * code_bytes);
+        threads::run(
+            threadpool_,
+            threads::StaticPartition{num_nodes},
+            [&](const auto& is, uint64_t SVS_UNUSED(tid)) {
+                for (auto i : is) {
+                    codebook.encode(
+                        std::span<const typename Data::element_type>(data_.get_datum(i)),
+                        codes.data() + i * code_bytes
+                    );
+                }
+            }
+        );
+
+        // Fill batches of blocks in parallel and append them to the file.
+        auto filename = ctx.generate_name("disk_graph", "binary");
+        auto stream = lib::open_write(filename);
+        const size_t block_bytes = layout_.block_bytes();
+        const size_t per_block = layout_.records_per_block();
+        const size_t num_blocks = layout_.num_blocks(num_nodes);
+        const size_t blocks_per_batch = std::max<size_t>(batch_bytes / block_bytes, 1);
+        auto buffer = std::vector<std::byte>();
+        for (size_t start = 0; start < num_blocks; start += blocks_per_batch) {
+            size_t stop = std::min(start + blocks_per_batch, num_blocks);
+            buffer.assign((stop - start) * block_bytes, std::byte{0});
+            size_t first = start * per_block;
+            size_t last = std::min(stop * per_block, num_nodes);
+            threads::run(
+                threadpool_,
+                threads::StaticPartition{last - first},
+                [&](const auto& is, uint64_t SVS_UNUSED(tid)) {
+                    for (auto j : is) {
+                        size_t i = first + j;
+                        auto* block = buffer.data() + (j / per_block) * block_bytes;
+                        layout_.write_record(
+                            block + layout_.record_offset(i),
+                            graph_.get_node(i),
+                            data_.get_datum(i)
+                        );
+                    }
+                }
+            );
+            stream.write(
+                reinterpret_cast<const char*>(buffer.data()),
+                lib::narrow<std::streamsize>(buffer.size())
+            );
+        }
+        if (!stream) {
+            throw ANNEXCEPTION("Writing disk index file {} failed!", filename);
+        }
+
+        auto codes_filename = ctx.generate_name("disk_codes", "binary");
+        auto codes_stream = lib::open_write(codes_filename);
+        lib::write_binary(codes_stream, codes);
+
+        auto table = lib::SaveTable(
+            serialization_schema,
+            save_version,
+            {{"index_type", lib::save(datatype_v<Idx>)},
+             {"num_nodes", lib::save(num_nodes)},
+             {"dimensions", lib::save(layout_.dimensions())},
+             {"max_degree", lib::save(layout_.max_degree())},
+             {"sector_bytes", lib::save(layout_.sector_bytes())},
+             {"entry_points",
+              lib::save(std::vector<size_t>(entry_points_.begin(), entry_points_.end()))},
+             {"codebook", lib::save(codebook)},
+             {"codes_filename", lib::save(codes_filename.filename())},
+             {"num_external_ids", lib::save(external_ids_.size())},
+             {"filename", lib::save(filename.filename())}}
+        );
+
+        // Reading empty files fails, so skip the file when there are no external IDs.
+        if (!external_ids_.empty()) {
+            auto ids_filename = ctx.generate_name("external_ids", "binary");
+            auto ids_stream = lib::open_write(ids_filename);
+            lib::write_binary(ids_stream, external_ids_);
+            table.insert("external_ids_filename", lib::save(ids_filename.filename()));
+        }
+        return table;
+    }
+};
+
+// The components of a disk index loaded from a directory.
+template <std::integral Idx> struct DiskIndexComponents {
+    DiskLayout<Idx> layout_;
+    size_t num_nodes_;
+    std::vector<Idx> entry_points_;
+    NeighborCodebook codebook_;
+    std::vector<uint8_t> codes_;
+    std::vector<Idx> external_ids_;
+    std::filesystem::path filename_;
+
+    static bool check_load_compatibility(std::string_view schema, lib::Version version) {
+        return schema == disk_index_schema && version == disk_index_save_version;
+    }
+
+    static DiskIndexComponents load(const lib::LoadTable& table) {
+        auto index_type = lib::load_at<DataType>(table, "index_type");
+        if (index_type != datatype_v<Idx>) {
+            throw ANNEXCEPTION(
+                "Trying to load a disk index with index type {} as {}!",
+                index_type,
+                datatype_v<Idx>
+            );
+        }
+        auto num_nodes = lib::load_at<size_t>(table, "num_nodes");
+        auto layout = DiskLayout<Idx>(
+            lib::load_at<size_t>(table, "dimensions"),
+            lib::load_at<size_t>(table, "max_degree"),
+            lib::load_at<size_t>(table, "sector_bytes")
+        );
+        auto entry_points = std::vector<Idx>();
+        for (auto id : lib::load_at<std::vector<size_t>>(table, "entry_points")) {
+            if (id >= num_nodes) {
+                throw ANNEXCEPTION("Entry point {} is out of bounds!", id);
+            }
+            entry_points.push_back(lib::narrow<Idx>(id));
+        }
+        auto codebook = lib::load_at<NeighborCodebook>(table, "codebook");
+        if (codebook.dimensions() != layout.dimensions()) {
+            throw ANNEXCEPTION("Disk index codebook does not match the index!");
+        }
+        auto codes = std::vector<uint8_t>(num_nodes * codebook.code_bytes());
+        if (!codes.empty()) {
+            auto stream = lib::open_read(table.resolve_at("codes_filename"));
+            lib::read_binary(stream, codes);
+        }
+
+        auto num_external_ids = lib::load_at<size_t>(table, "num_external_ids");
+        auto external_ids = std::vector<Idx>(num_external_ids);
+        if (!external_ids.empty()) {
+            auto stream = lib::open_read(table.resolve_at("external_ids_filename"));
+            lib::read_binary(stream, external_ids);
+        }
+
+        auto filename = table.resolve_at("filename");
+        auto expected_bytes = layout.num_blocks(num_nodes) * layout.block_bytes();
+        if (std::filesystem::file_size(filename) < expected_bytes) {
+            throw ANNEXCEPTION("Disk index file {} is truncated!", filename);
+        }
+        return DiskIndexComponents{
+            layout,
+            num_nodes,
+            std::move(entry_points),
+            std::move(codebook),
+            std::move(codes),
+            std::move(external_ids),
+            std::move(filename)};
+    }
+};
+
+} // namespace detail
+
+///
+/// @brief Return whether ``Data`` can be written as the full-precision vectors of a
+///     ``DiskVamanaIndex``.
+///
+template <typename Data>
+inline constexpr bool supports_disk_index_v =
+    requires(const Data& data) { static_cast<float>(data.get_datum(0)[0]); };
+
+///
+/// @brief Save the graph and dataset of a Vamana index in the ``DiskVamanaIndex`` format.
+///
+/// @param dir The directory to save to. Created if it does not exist.
+/// @param graph The graph of the index.
+/// @param data The dataset of the index. Vectors are stored as ``float`` on disk.
+/// @param entry_points The search entry points of the graph.
+/// @param external_ids The external ID of each vertex. May be empty if the external IDs
+///     are the vertex IDs.
+/// @param threadpool The threadpool used to train and encode the in-memory codes and to
+///     lay out the records.
+/// @param sector_bytes The sector size of the on-disk layout.
+///
+template <
+    graphs::ImmutableMemoryGraph Graph,
+    data::ImmutableMemoryDataset Data,
+    std::integral Idx = typename Graph::index_type>
+    requires supports_disk_index_v<Data>
+void save_disk_index(
+    const std::filesystem::path& dir,
+    const Graph& graph,
+    const Data& data,
+    std::span<const Idx> entry_points,
+    std::span<const Idx> external_ids,
+    threads::NativeThreadPool& threadpool,
+    size_t sector_bytes = DiskLayout<Idx>::default_sector_bytes
+) {
+    static_assert(std::is_same_v<Idx, typename Graph::index_type>);
+    if (graph.n_nodes() != data.size()) {
+        throw ANNEXCEPTION(
+            "Graph has {} nodes but the dataset has {} elements!",
+            graph.n_nodes(),
+            data.size()
+        );
+    }
+    if (!external_ids.empty() && external_ids.size() != data.size()) {
+        throw ANNEXCEPTION(
+            "Got {} external IDs for {} elements!", external_ids.size(), data.size()
+        );
+    }
+    auto writer = detail::DiskIndexWriter<Graph, Data, Idx>{
+        graph,
+        data,
+        entry_points,
+        external_ids,
+        threadpool,
+        DiskLayout<Idx>(data.dimensions(), graph.max_degree(), sector_bytes)};
+    lib::save_to_disk(writer, dir);
+}
+
+///
+/// @brief Vamana index serving search from a graph and dataset stored on disk.
+///
+/// @tparam Dist The distance functor. Either ``svs::distance::DistanceL2`` or
+///     ``svs::distance::DistanceIP``.
+/// @tparam Idx The integer type used to encode vertex IDs.
+///
+/// Only compact 4-bit codes of the dataset (see ``NeighborCodebook``) and the entry points
+/// are kept in memory. The graph and the full-precision vectors are read from a
+/// sector-aligned file written by ``save_disk_index``.
+///
+/// Search follows the DiskANN beam search: candidates are ordered by distances estimated
+/// from the in-memory codes. On each step, the blocks of the best ``beam_width``
+/// unexpanded candidates are read together. Each fetched block provides the exact
+/// distance to its vertex from the full-precision vector and the adjacency list used to
+/// discover new candidates. Results are the expanded vertices ranked by exact distance.
+///
+/// The reads of a beam are submitted together through io_uring, using direct I/O when
+/// supported, and each search thread waits once per beam. Each search thread keeps its own
+/// submission queue across searches, so up to ``beam_width`` reads per thread are in
+/// flight. Systems without io_uring fall back to sequential ``pread`` calls (see
+/// ``lib::BatchReader``).
+///
+template <typename Dist, std::integral Idx = uint32_t> class DiskVamanaIndex {
+  public:
+    using distance_type = Dist;
+    using index_type = Idx;
+    using compare = distance::compare_t<Dist>;
+    using search_buffer_type = SearchBuffer<Idx, compare>;
+    using search_parameters_type = DiskSearchParameters;
+
+    static_assert(
+        std::is_same_v<Dist, distance::DistanceL2> ||
+            std::is_same_v<Dist, distance::DistanceIP>,
+        "Unsupported distance for disk index search!"
+    );
+
+    ///
+    /// @brief Load a disk index from the directory written by ``save_disk_index``.
+    ///
+    /// @param dir The directory containing the disk index.
+    /// @param distance The distance functor.
+    /// @param num_threads The number of threads used to process queries.
+    /// @param direct Read records with direct I/O, bypassing the page cache, if the file
+    ///     system supports it.
+    ///
+    DiskVamanaIndex(
+        const std::filesystem::path& dir,
+        Dist distance,
+        size_t num_threads,
+        bool direct = true
+    )
+        : DiskVamanaIndex(
+              lib::load_from_disk<detail::DiskIndexComponents<Idx>>(dir),
+              std::move(distance),
+              num_threads,
+              direct
+          ) {}
+
+    /// @brief Return the number of indexed vectors.
+    size_t size() const { return num_nodes_; }
+    /// @brief Return the number of dimensions of the indexed vectors.
+    size_t dimensions() const { return layout_.dimensions(); }
+    /// @brief Return the largest number of neighbors of any vertex.
+    size_t max_degree() const { return layout_.max_degree(); }
+    /// @brief Return the on-disk record layout.
+    const DiskLayout<Idx>& layout() const { return layout_; }
+    /// @brief Return the search entry points.
+    const std::vector<Idx>& entry_points() const { return entry_points_; }
+    /// @brief Return the quantizer of the in-memory codes.
+    const NeighborCodebook& codebook() const { return codebook_; }
+    /// @brief Return whether records are read with direct I/O.
+    bool direct_io() const { return file_.direct(); }
+
+    /// @brief Return the size of the in-memory codes in bytes.
+    size_t resident_bytes() const { return codes_.size(); }
+    /// @brief Return the size of the on-disk file in bytes.
+    size_t disk_bytes() const { return file_.size(); }
+
+    /// @brief Return the number of threads used to process queries.
+    size_t get_num_threads() const { return threadpool_.size(); }
+    /// @brief Change the number of threads used to process queries.
+    /// Zero is silently changed to one.
+    void set_num_threads(size_t num_threads) {
+        threadpool_.resize(std::max(num_threads, size_t(1)));
+        readers_.resize(threadpool_.size());
+    }
+
+    /// @brief Return the default search parameters.
+    const DiskSearchParameters& get_search_parameters() const { return search_parameters_; }
+    /// @brief Change the default search parameters.
+    void set_search_parameters(const DiskSearchParameters& search_parameters) {
+        search_parameters_ = search_parameters;
+    }
+
+    /// @brief Return the external ID of vertex ``i``.
+    size_t translate_internal_id(Idx i) const {
+        return external_ids_.empty() ? i : external_ids_[i];
+    }
+
+    ///
+    /// @brief Fill the result with the ``result.n_neighbors()`` nearest neighbors for each
+    /// query.
+    ///
+    /// If the search window is smaller than the number of neighbors, it is temporarily
+    /// increased. Rows are padded with ``std::numeric_limits<I>::max()`` and the worst
+    /// possible distance if fewer vertices were expanded.
+    ///
+    template <typename I, data::ImmutableMemoryDataset Queries>
+    void search(
+        QueryResultView<I> result,
+        const Queries& queries,
+        const search_parameters_type& search_parameters
+    ) {
+        if (search_parameters.beam_width_ == 0) {
+            throw ANNEXCEPTION("The beam width must be at least 1!");
+        }
+        threads::run(
+            threadpool_,
+            threads::StaticPartition{queries.size()},
+            [&](const auto& is, uint64_t tid) {
+                const size_t num_neighbors = result.n_neighbors();
+                auto config = search_parameters.buffer_config_;
+                if (config.get_search_window_size() < num_neighbors) {
+                    config = SearchBufferConfig{num_neighbors};
+                }
+                // Reuse the submission queue of this thread unless it is too shallow.
+                const size_t beam_width = search_parameters.beam_width_;
+                auto& reader = readers_.at(tid);
+                if (reader.queue_depth() < beam_width) {
+                    reader = lib::BatchReader(beam_width);
+                }
+
+                auto buffer = search_buffer_type(config, compare(), true, true);
+                auto scratch = Scratch(layout_, beam_width, reader);
+                auto distance = threads::shallow_copy(distance_);
+                auto sentinel = type_traits::sentinel_v<Neighbor<I>, compare>;
+
+                for (auto i : is) {
+                    const auto& expanded =
+                        search_one(queries.get_datum(i), distance, buffer, scratch);
+                    for (size_t j = 0; j < num_neighbors; ++j) {
+                        if (j < expanded.size()) {
+                            const auto& neighbor = expanded[j];
+                            result.set(
+                                Neighbor<I>{
+                                    lib::narrow_cast<I>(translate_internal_id(neighbor.id())
+                                    ),
+                                    neighbor.distance()},
+                                i,
+                                j
+                            );
+                        } else {
+                            result.set(sentinel, i, j);
+                        }
+                    }
+                }
+            }
+        );
+    }
+
+  private:
+    // Per-thread resources for search.
+    struct Scratch {
+        Scratch(const DiskLayout<Idx>& layout, size_t beam_width, lib::BatchReader& reader)
+            : beam_width{beam_width}
+            , blocks{beam_width * layout.block_bytes(), layout.sector_bytes()}
+            , reader{reader} {
+            beam.reserve(beam_width);
+            reads.reserve(beam_width);
+        }
+
+        size_t beam_width;
+        NeighborCodeTable<Dist> table{};
+        lib::AlignedBuffer blocks;
+        lib::BatchReader& reader;
+        std::vector<Idx> beam{};
+        std::vector<lib::BlockRead> reads{};
+        std::vector<Neighbor<Idx>> expanded{};
+    };
+
+    DiskVamanaIndex(
+        detail::DiskIndexComponents<Idx> components,
+        Dist distance,
+        size_t num_threads,
+        bool direct
+    )
+        : layout_{components.layout_}
+        , num_nodes_{components.num_nodes_}
+        , entry_points_{std::move(components.entry_points_)}
+        , codebook_{std::move(components.codebook_)}
+        , codes_{std::move(components.codes_)}
+        , external_ids_{std::move(components.external_ids_)}
+        , file_{components.filename_, direct}
+        , distance_{std::move(distance)}
+        , threadpool_{num_threads}
+        , readers_(threadpool_.size()) {
+        if (entry_points_.empty()) {
+            throw ANNEXCEPTION("A disk index needs at least one entry point!");
+        }
+    }
+
+    // Run beam search for `query` and return the expanded vertices sorted by their exact
+    // distances.
+    template <typename Query>
+    const std::vector<Neighbor<Idx>>& search_one(
+        const Query& query, Dist& distance, search_buffer_type& buffer, Scratch& scratch
+    ) const {
+        auto builder = NeighborBuilder();
+        const size_t code_bytes = codebook_.code_bytes();
+        auto estimate = [&](Idx id) {
+            return scratch.table(codes_.data() + id * code_bytes);
+        };
+        scratch.table.fix(codebook_, query);
+        distance::maybe_fix_argument(distance, query);
+
+        buffer.clear();
+        for (auto id : entry_points_) {
+            buffer.emplace_visited(id);
+            buffer.push_back(builder(id, estimate(id)));
+        }
+        buffer.sort();
+
+        auto& beam = scratch.beam;
+        auto& expanded = scratch.expanded;
+        const size_t beam_width = scratch.beam_width;
+        const size_t block_bytes = layout_.block_bytes();
+        expanded.clear();
+        while (!buffer.done()) {
+            beam.clear();
+            while (beam.size() < beam_width && !buffer.done()) {
+                beam.push_back(buffer.next().id());
+            }
+            scratch.reads.clear();
+            for (size_t k = 0; k < beam.size(); ++k) {
+                scratch.reads.push_back(lib::BlockRead{
+                    scratch.blocks.data() + k * block_bytes,
+                    block_bytes,
+                    layout_.block_offset(beam[k])});
+            }
+            scratch.reader.read(file_, scratch.reads);
+
+            for (size_t k = 0; k < beam.size(); ++k) {
+                const std::byte* record = scratch.blocks.data() + k * block_bytes +
+                                          layout_.record_offset(beam[k]);
+                expanded.push_back(Neighbor<Idx>{
+                    beam[k], distance::compute(distance, query, layout_.vector(record))});
+                for (auto id : layout_.neighbors(record)) {
+                    if (buffer.emplace_visited(id)) {
+                        continue;
+                    }
+                    buffer.insert(builder(id, estimate(id)));
+                }
+            }
+        }
+        std::sort(expanded.begin(), expanded.end(), compare());
+        return expanded;
+    }
+
+    DiskLayout<Idx> layout_;
+    size_t num_nodes_;
+    std::vector<Idx> entry_points_;
+    NeighborCodebook codebook_;
+    std::vector<uint8_t> codes_;
+    std::vector<Idx> external_ids_;
+    lib::BlockFile file_;
+    Dist distance_;
+    threads::NativeThreadPool threadpool_;
+    // Submission queues of the search threads, created on first use.
+    std::vector<lib::BatchReader> readers_;
+    DiskSearchParameters search_parameters_{};
+};
+
+} // namespace svs::index::vamana
@@ -12,12 +12,19 @@
 #pragma once
 
 // stdlib
+#include <functional>
+#include <limits>
 #include <memory>
+#include <mutex>
+#include <numeric>
+#include <shared_mutex>
+#include <span>
 
 // Include the flat index to spin-up exhaustive searches on demand.
 #include "svs/index/flat/flat.h"
 
 // svs
+#include "svs/core/bitset.h"
 #include "svs/core/data.h"
 #include "svs/core/distance.h"
 #include "svs/core/graph.h"
@@ -85,16 +92,70 @@ class ValidBuilder {
 
     template <typename I>
     constexpr PredicatedSearchNeighbor<I> operator()(I i, float distance) const {
-        bool invalid = getindex(status_, i) == SlotMetadata::Deleted;
+        bool valid = getindex(status_, i) == SlotMetadata::Valid;
         // This neighbor should be skipped if the metadata corresponding to the given index
-        // marks this slot as deleted.
-        return PredicatedSearchNeighbor<I>(i, distance, !invalid);
+        // marks this slot as deleted or as a point whose insertion is still in progress.
+        return PredicatedSearchNeighbor<I>(i, distance, valid);
     }
 
   private:
     const std::vector<SlotMetadata>& status_;
 };
 
+///
+/// Graph adaptor for searches running concurrently with modifications of the graph.
+///
+/// If the underlying graph supports it, adjacency lists are copied into an internal buffer
+/// using ``snapshot_node``. The list returned by ``get_node`` is then valid until the next
+/// call to ``get_node``.
+///
+template <graphs::ImmutableMemoryGraph Graph> class SnapshotGraphView {
+  public:
+    using index_type = typename Graph::index_type;
+    using reference = typename Graph::const_reference;
+    using const_reference = typename Graph::const_reference;
+
+    explicit SnapshotGraphView(const Graph& graph)
+        : graph_{graph}
+        , buffer_{} {}
+
+    size_t max_degree() const { return graph_.max_degree(); }
+    size_t n_nodes() const { return graph_.n_nodes(); }
+
+    const_reference get_node(index_type i) const {
+        if constexpr (requires { graph_.snapshot_node(i, buffer_); }) {
+            return graph_.snapshot_node(i, buffer_);
+        } else {
+            return graph_.get_node(i);
+        }
+    }
+
+    size_t get_node_degree(index_type i) const { return graph_.get_node_degree(i); }
+    void prefetch_node(index_type i) const { graph_.prefetch_node(i); }
+
+  private:
+    const Graph& graph_;
+    mutable std::vector<index_type> buffer_;
+};
+
+///
+/// @brief A Vamana index supporting insertions and deletions.
+///
+/// **Concurrency:** ``search``, ``exhaustive_search``, and ``reconstruct_at`` may be called
+/// concurrently with each other and with ``add_points``, ``delete_entries``, and
+/// ``consolidate``. Mutating operations are serialized among themselves.
+///
+/// Mutations only block searches while resizing the dataset and graph, updating the slot
+/// metadata, or updating the ID translation. The bulk of the work (graph construction for
+/// new points and graph repair during consolidation) runs alongside searches, which read
+/// adjacency lists through per-vertex sequence locks. New points only become visible to
+/// searches once they are fully inserted.
+///
+/// Slots freed by ``consolidate`` are not reused until all searches that started before
+/// the consolidation finished, so in-flight searches never observe a recycled slot.
+///
+/// ``compact`` and ``save`` block searches for their duration.
+///
 template <graphs::MemoryGraph Graph, typename Data, typename Dist>
 class MutableVamanaIndex {
   public:
@@ -122,6 +183,8 @@ class MutableVamanaIndex {
   private:
     // Invariants:
     // * The ID translator should track only valid IDs.
+    // * `free_slots_` contains exactly the `Empty` slots, sorted in decreasing order so
+    //   the lowest slots are handed out first.
     // TODO:
     // * Maybe merge some of the `status` metadata tracker with the IDTranslator to reduce
     //   memory requirements. There are probably some bits we can reclaim there to
@@ -131,6 +194,7 @@ class MutableVamanaIndex {
     data_type data_;
     entry_point_type entry_point_;
     std::vector<SlotMetadata> status_;
+    std::vector<Idx> free_slots_;
     IDTranslator translator_;
 
     // Thread local data structures.
@@ -138,6 +202,17 @@ class MutableVamanaIndex {
     threads::NativeThreadPool threadpool_;
     lib::ReadWriteProtected<VamanaSearchParameters> search_parameters_;
 
+    // Synchronization between searches and mutations.
+    // * Searches hold `structure_mutex_` in shared mode.
+    // * Mutations are serialized by `mutation_mutex_`. While holding it, the slot metadata,
+    //   ID translation and entry point may be read without further synchronization, but
+    //   must only be modified while holding `structure_mutex_` exclusively.
+    //
+    // Lock order: `mutation_mutex_` before `structure_mutex_` before the thread pool.
+    std::unique_ptr<std::mutex> mutation_mutex_{std::make_unique<std::mutex>()};
+    std::unique_ptr<std::shared_mutex> structure_mutex_{
+        std::make_unique<std::shared_mutex>()};
+
     // Configurations
     size_t construction_window_size_;
     size_t max_candidates_;
@@ -402,13 +477,21 @@ class MutableVamanaIndex {
     ///
     size_t dimensions() const { return data_.dimensions(); }
 
-    auto greedy_search_closure(GreedySearchPrefetchParameters prefetch_parameters) const {
-        return [&, prefetch_parameters](
+    auto greedy_search_closure(
+        GreedySearchPrefetchParameters prefetch_parameters,
+        const GreedySearchTerminationParameters& termination_parameters = {}
+    ) const {
+        // Adjacency lists may be modified by a concurrent mutation. Read them through
+        // per-thread snapshots.
+        return [&,
+                graph = SnapshotGraphView{graph_},
+                prefetch_parameters,
+                termination_parameters](
                    const auto& query, auto& accessor, auto& distance, auto& buffer
                ) {
             // Perform the greedy search using the provided resources.
             greedy_search(
-                graph_,
+                graph,
                 data_,
                 accessor,
                 query,
@@ -416,7 +499,8 @@ class MutableVamanaIndex {
                 buffer,
                 entry_point_,
                 ValidBuilder{status_},
-                prefetch_parameters
+                prefetch_parameters,
+                termination_parameters
             );
             // Take a pass over the search buffer to remove any deleted elements that
             // might remain.
@@ -424,10 +508,122 @@ class MutableVamanaIndex {
         };
     }
 
+    // Translate a set of allowed external IDs into the corresponding internal IDs.
+    // The internal IDs are set in `internal`, which must cover all internal IDs, and
+    // appended to `ids` so they can be cleared again without scanning the whole set.
+    void translate_allowed(
+        BitSetView allowed, BitSet& internal, std::vector<Idx>& ids
+    ) const {
+        allowed.for_each(0, allowed.size(), [&](size_t e) {
+            if (translator_.has_external(e)) {
+                auto i = translator_.get_internal(e);
+                internal.set(i);
+                ids.push_back(i);
+            }
+        });
+    }
+
+    BitSet translate_allowed(BitSetView allowed) const {
+        auto internal = BitSet(data_.size());
+        auto ids = std::vector<Idx>();
+        translate_allowed(allowed, internal, ids);
+        return internal;
+    }
+
+    // Only valid entries whose internal IDs are set in `allowed` are returned.
+    auto filtered_search_closure(
+        BitSetView allowed,
+        GreedySearchPrefetchParameters prefetch_parameters,
+        const GreedySearchTerminationParameters& termination_parameters = {}
+    ) const {
+        auto predicate = [&, allowed](Idx i) {
+            return getindex(status_, i) == SlotMetadata::Valid && allowed.test(i);
+        };
+        return [&,
+                graph = SnapshotGraphView{graph_},
+                predicate,
+                prefetch_parameters,
+                termination_parameters](
+                   const auto& query, auto& accessor, auto& distance, auto& buffer
+               ) {
+            greedy_search(
+                graph,
+                data_,
+                accessor,
+                query,
+                distance,
+                buffer,
+                entry_point_,
+                PredicateBuilder{predicate},
+                prefetch_parameters,
+                termination_parameters
+            );
+            buffer.cleanup();
+        };
+    }
+
+    auto range_search_closure(
+        float radius,
+        size_t max_capacity,
+        GreedySearchPrefetchParameters prefetch_parameters
+    ) const {
+        return [&,
+                graph = SnapshotGraphView{graph_},
+                radius,
+                max_capacity,
+                prefetch_parameters](
+                   const auto& query, auto& accessor, auto& distance, auto& buffer
+               ) {
+            range_greedy_search(
+                graph,
+                data_,
+                accessor,
+                query,
+                distance,
+                buffer,
+                entry_point_,
+                ValidBuilder{status_},
+                radius,
+                max_capacity,
+                prefetch_parameters
+            );
+            buffer.cleanup();
+        };
+    }
+
+    auto interleaved_search_closure(
+        GreedySearchPrefetchParameters prefetch_parameters,
+        const GreedySearchTerminationParameters& termination_parameters = {}
+    ) const {
+        return [&,
+                graph = SnapshotGraphView{graph_},
+                prefetch_parameters,
+                termination_parameters](
+                   auto queries, auto& accessor, auto distances, auto buffers
+               ) {
+            interleaved_greedy_search(
+                graph,
+                data_,
+                accessor,
+                queries,
+                distances,
+                buffers,
+                entry_point_,
+                ValidBuilder{status_},
+                prefetch_parameters,
+                termination_parameters
+            );
+            for (auto& buffer : buffers) {
+                buffer.cleanup();
+            }
+        };
+    }
+
     template <typename I, data::ImmutableMemoryDataset Queries>
     void search(
         QueryResultView<I> results, const Queries& queries, const search_parameters_type& sp
     ) {
+        std::shared_lock lock{*structure_mutex_};
         threads::run(
             threadpool_,
             threads::StaticPartition{queries.size()},
@@ -438,11 +634,43 @@ class MutableVamanaIndex {
 
                 auto prefetch_parameters = GreedySearchPrefetchParameters{
                     sp.prefetch_lookahead_, sp.prefetch_step_};
+                auto termination_parameters = GreedySearchTerminationParameters{
+                    num_neighbors,
+                    sp.early_termination_patience_,
+                    sp.early_termination_ratio_};
 
                 // Legalize search buffer for this search.
                 if (buffer.target() < num_neighbors) {
                     buffer.change_maxsize(num_neighbors);
                 }
+                // Interleave the graph traversals of multiple queries if requested and
+                // supported by the dataset.
+                if constexpr (extensions::supports_interleaved_search<Data>()) {
+                    size_t interleave = std::min(sp.interleave_, max_interleaved_queries);
+                    if (interleave > 1) {
+                        auto buffers = std::vector<search_buffer_type>(interleave, buffer);
+                        auto distances = std::vector<
+                            decltype(extensions::single_search_setup(data_, distance_))>();
+                        for (size_t i = 0; i < interleave; ++i) {
+                            distances.push_back(
+                                extensions::single_search_setup(data_, distance_)
+                            );
+                        }
+
+                        extensions::interleaved_batch_search(
+                            std::span(buffers),
+                            std::span(distances),
+                            queries,
+                            results,
+                            threads::UnitRange{is},
+                            interleaved_search_closure(
+                                prefetch_parameters, termination_parameters
+                            )
+                        );
+                        return;
+                    }
+                }
+
                 auto scratch = extensions::per_thread_batch_search_setup(data_, distance_);
 
                 extensions::per_thread_batch_search(
@@ -452,7 +680,8 @@ class MutableVamanaIndex {
                     queries,
                     results,
                     threads::UnitRange{is},
-                    greedy_search_closure(prefetch_parameters)
+                    greedy_search_closure(prefetch_parameters, termination_parameters),
+                    sp.effective_rerank_depth(num_neighbors)
                 );
             }
         );
@@ -462,6 +691,158 @@ class MutableVamanaIndex {
         translate_to_external(results.indices());
     }
 
+    ///
+    /// @brief Fill the result with the nearest valid neighbors for each query among the
+    ///     entries allowed by ``filter``.
+    ///
+    /// @param results The result data structure to populate.
+    /// @param queries A dense collection of queries in R^n.
+    /// @param sp The search parameters to use.
+    /// @param filter The allowed external IDs, either shared by all queries or given
+    ///     separately for each query. See ``svs::SearchFilter``.
+    ///
+    /// Like deleted entries, excluded entries are traversed but never returned.
+    /// Queries are not interleaved.
+    ///
+    template <typename I, data::ImmutableMemoryDataset Queries>
+    void search(
+        QueryResultView<I> results,
+        const Queries& queries,
+        const search_parameters_type& sp,
+        const SearchFilter& filter
+    ) {
+        filter.check(queries.size());
+        if (filter.empty()) {
+            search(results, queries, sp);
+            return;
+        }
+
+        std::shared_lock lock{*structure_mutex_};
+        // Bits of the filter refer to external IDs while graph search sees internal IDs.
+        // Translate the allowed set up front rather than translating every visited entry.
+        auto shared_allowed =
+            filter.is_per_query() ? BitSet() : translate_allowed(filter.view(0));
+        auto compare = distance::comparator(distance_);
+        threads::run(
+            threadpool_,
+            threads::StaticPartition{queries.size()},
+            [&](const auto is, uint64_t SVS_UNUSED(tid)) {
+                size_t num_neighbors = results.n_neighbors();
+                auto buffer = search_buffer_type{sp.buffer_config_, compare};
+                if (buffer.target() < num_neighbors) {
+                    buffer.change_maxsize(num_neighbors);
+                }
+                auto scratch = extensions::single_search_setup(data_, distance_);
+
+                auto prefetch_parameters = GreedySearchPrefetchParameters{
+                    sp.prefetch_lookahead_, sp.prefetch_step_};
+                auto termination_parameters = GreedySearchTerminationParameters{
+                    num_neighbors,
+                    sp.early_termination_patience_,
+                    sp.early_termination_ratio_};
+                auto sentinel = type_traits::sentinel_v<Neighbor<I>, decltype(compare)>;
+
+                // Per-query filters are translated into a set reused by all queries of
+                // this thread. Only the bits set for a query are cleared before the next.
+                auto query_allowed =
+                    filter.is_per_query() ? BitSet(data_.size()) : BitSet();
+                auto query_ids = std::vector<Idx>();
+                for (auto i : is) {
+                    if (filter.is_per_query()) {
+                        for (auto id : query_ids) {
+                            query_allowed.reset(id);
+                        }
+                        query_ids.clear();
+                        translate_allowed(filter.view(i), query_allowed, query_ids);
+                    }
+                    const auto& allowed =
+                        filter.is_per_query() ? query_allowed : shared_allowed;
+                    extensions::single_search(
+                        data_,
+                        buffer,
+                        scratch,
+                        queries.get_datum(i),
+                        filtered_search_closure(
+                            allowed.view(), prefetch_parameters, termination_parameters
+                        ),
+                        sp.effective_rerank_depth(num_neighbors)
+                    );
+
+                    // Translate while copying since missing results have no translation.
+                    for (size_t j = 0; j < num_neighbors; ++j) {
+                        if (j < buffer.size()) {
+                            const auto& neighbor = buffer[j];
+                            results.set(
+                                Neighbor<size_t>{
+                                    translate_internal_id(neighbor.id()),
+                                    neighbor.distance()},
+                                i,
+                                j
+                            );
+                        } else {
+                            results.set(sentinel, i, j);
+                        }
+                    }
+                }
+            }
+        );
+    }
+
+    ///
+    /// @brief Return the external IDs of the valid entries within ``radius`` of each query.
+    ///
+    /// @param queries A dense collection of queries in R^n.
+    /// @param radius The search radius. An entry is returned if its distance to the query
+    ///     is at least as good as ``radius``.
+    /// @param sp The search parameters to use.
+    ///
+    /// See ``VamanaIndex::range_search`` for a description of the algorithm.
+    /// The search buffer cannot grow beyond 65535 valid entries.
+    ///
+    template <data::ImmutableMemoryDataset Queries>
+    RangeSearchResult<size_t>
+    range_search(const Queries& queries, float radius, const search_parameters_type& sp) {
+        std::shared_lock lock{*structure_mutex_};
+        auto compare = distance::comparator(distance_);
+        auto results = std::vector<std::vector<Neighbor<size_t>>>(queries.size());
+        threads::run(
+            threadpool_,
+            threads::StaticPartition{queries.size()},
+            [&](const auto is, uint64_t SVS_UNUSED(tid)) {
+                auto config =
+                    SearchBufferConfig(sp.buffer_config_.get_search_window_size());
+                auto buffer = search_buffer_type{config, compare};
+                auto scratch = extensions::single_search_setup(data_, distance_);
+                size_t max_capacity = std::max(
+                    config.get_total_capacity(),
+                    std::min(data_.size(), size_t{std::numeric_limits<uint16_t>::max()})
+                );
+                auto closure = range_search_closure(
+                    radius, max_capacity, {sp.prefetch_lookahead_, sp.prefetch_step_}
+                );
+
+                for (auto i : is) {
+                    // Undo any growth from the previous query.
+                    buffer.change_maxsize(config);
+                    extensions::single_search(
+                        data_, buffer, scratch, queries.get_datum(i), closure, 0
+                    );
+
+                    auto& neighbors = results[i];
+                    for (const auto& neighbor : buffer) {
+                        if (compare(radius, neighbor.distance())) {
+                            break;
+                        }
+                        neighbors.emplace_back(
+                            translate_internal_id(neighbor.id()), neighbor.distance()
+                        );
+                    }
+                }
+            }
+        );
+        return RangeSearchResult<size_t>(results);
+    }
+
     ///
     /// @brief Return a unique instance of the distance function.
     ///
@@ -477,10 +858,22 @@ class MutableVamanaIndex {
         size_t num_neighbors,
         QueryResultView<I> result
     ) {
-        auto temp_index = temporary_flat_index(data_, distance_, threadpool_);
-        temp_index.search(queries, num_neighbors, result, [&](size_t i) {
-            return getindex(status_, i) == SlotMetadata::Valid;
-        });
+        if (num_neighbors != result.n_neighbors()) {
+            throw ANNEXCEPTION(
+                "Requested {} neighbors but the result has room for {}!",
+                num_neighbors,
+                result.n_neighbors()
+            );
+        }
+
+        std::shared_lock lock{*structure_mutex_};
+        auto temp_index = flat::temporary_flat_index(data_, distance_, threadpool_);
+        temp_index.search(
+            result,
+            queries,
+            temp_index.get_search_parameters(),
+            [&](size_t i) { return getindex(status_, i) == SlotMetadata::Valid; }
+        );
 
         // After the search procedure, the indices in `results` are internal.
         // Perform one more pass to convert these to external ids.
@@ -546,25 +939,16 @@ class MutableVamanaIndex {
             );
         }
 
-        // Gather all empty slots.
-        std::vector<size_t> slots{};
-        slots.reserve(num_points);
+        std::lock_guard mutation_lock{*mutation_mutex_};
 
-        bool have_room = false;
-        for (size_t i = 0, imax = status_.size(); i < imax; ++i) {
-            if (status_[i] == SlotMetadata::Empty) {
-                slots.push_back(i);
-            }
-            if (slots.size() == num_points) {
-                have_room = true;
-                break;
-            }
-        }
+        // Storage growth and ID translation are not visible to searches.
+        std::unique_lock structure_lock{*structure_mutex_};
 
-        // Check if we have enough indices. If we don't, we need to resize the data and
-        // the graph.
-        if (!have_room) {
-            size_t needed = num_points - slots.size();
+        // Check if we have enough empty slots. If we don't, we need to resize the data
+        // and the graph.
+        size_t num_free = free_slots_.size();
+        if (num_free < num_points) {
+            size_t needed = num_points - num_free;
             size_t current_size = data_.size();
             size_t new_size = current_size + needed;
             data_.resize(new_size);
@@ -573,17 +957,29 @@ class MutableVamanaIndex {
             // and thus it's not a good idea to go around shrinking the graph without care.
             graph_.unsafe_resize(new_size);
             status_.resize(new_size, SlotMetadata::Empty);
-            // Append the correct number of extra slots.
-            threads::UnitRange<size_t> extra_points{current_size, current_size + needed};
-            slots.insert(slots.end(), extra_points.begin(), extra_points.end());
+
+            // The new slots are higher than all existing empty slots and thus go to the
+            // front of the pool.
+            auto extra_slots = std::vector<Idx>(needed);
+            std::iota(
+                extra_slots.rbegin(), extra_slots.rend(), lib::narrow<Idx>(current_size)
+            );
+            free_slots_.insert(free_slots_.begin(), extra_slots.begin(), extra_slots.end());
         }
-        assert(slots.size() == num_points);
+
+        // Take the lowest `num_points` empty slots.
+        std::vector<size_t> slots(free_slots_.rbegin(), free_slots_.rbegin() + num_points);
 
         // Try to update the id translation now that we have internal ids.
-        // If this fails, we still haven't mutated the index data structure so we're safe
-        // to throw an exception.
+        // If this fails, the slots are still in the pool of empty slots, so we're safe to
+        // throw an exception.
         translator_.insert(external_ids, slots);
+        free_slots_.resize(free_slots_.size() - num_points);
+        structure_lock.unlock();
 
+        // The remaining steps run concurrently with searches.
+        // Until linked into the graph, the new slots are unreachable from searches.
+        //
         // Copy the given points into the data and clear the adjacency lists for the graph.
         copy_points(points, slots);
         clear_lists(slots);
@@ -603,7 +999,9 @@ class MutableVamanaIndex {
         VamanaBuilder builder{
             graph_, data_, distance_, parameters, threadpool_, prefetch_parameters};
         builder.construct(alpha_, entry_point(), slots, logging::Level::Trace);
-        // Mark all added entries as valid.
+
+        // Mark all added entries as valid, making them visible to searches.
+        structure_lock.lock();
         for (const auto& i : slots) {
             status_[i] = SlotMetadata::Valid;
         }
@@ -633,6 +1031,8 @@ class MutableVamanaIndex {
     ///   graph.
     ///
     template <typename T> void delete_entries(const T& ids) {
+        std::lock_guard mutation_lock{*mutation_mutex_};
+        std::unique_lock structure_lock{*structure_mutex_};
         translator_.check_external_exist(ids.begin(), ids.end());
         for (auto i : ids) {
             delete_entry(translator_.get_internal(i));
@@ -676,6 +1076,13 @@ class MutableVamanaIndex {
     ///     improve performance but requires more working memory.
     ///
     void compact(Idx batch_size = 1'000) {
+        std::lock_guard mutation_lock{*mutation_mutex_};
+        std::unique_lock structure_lock{*structure_mutex_};
+        compact_impl(batch_size);
+    }
+
+  private:
+    void compact_impl(Idx batch_size) {
         // Step 1: Compute a prefix-sum matching each valid internal index to its new
         // internal index.
         //
@@ -768,6 +1175,8 @@ class MutableVamanaIndex {
             }
         }
         status_.resize(max_index);
+        // Only valid entries survive compaction.
+        free_slots_.clear();
 
         // Update entry points.
         for (auto& ep : entry_point_) {
@@ -775,6 +1184,64 @@ class MutableVamanaIndex {
         }
     }
 
+    // Requires holding `mutation_mutex_`.
+    void consolidate_impl() {
+        auto check_is_deleted = [&](size_t i) { return this->is_deleted(i); };
+        auto valid = [&](size_t i) { return !(this->is_deleted(i)); };
+
+        // Determine if the entry point is deleted.
+        // If so - we need to pick a new one.
+        assert(entry_point_.size() == 1);
+        auto entry_point = entry_point_[0];
+        if (status_.at(entry_point) == SlotMetadata::Deleted) {
+            auto logger = svs::logging::get();
+            svs::logging::debug(logger, "Replacing entry point.");
+            auto new_entry_point =
+                extensions::compute_entry_point(data_, threadpool_, valid);
+            svs::logging::debug(logger, "New point: {}", new_entry_point);
+            assert(!is_deleted(new_entry_point));
+            std::unique_lock structure_lock{*structure_mutex_};
+            entry_point_[0] = new_entry_point;
+        }
+
+        // Perform graph consolidation.
+        // Deleted slots are still marked as such, so concurrent searches may keep
+        // traversing (but not returning) them.
+        svs::index::vamana::consolidate(
+            graph_,
+            data_,
+            threadpool_,
+            prune_to_,
+            max_candidates_,
+            alpha_,
+            distance_,
+            check_is_deleted
+        );
+
+        // After consolidation - set all `Deleted` slots to `Empty`.
+        //
+        // No adjacency list refers to deleted slots anymore, but searches that started
+        // earlier may still hold them. Acquiring the structure lock waits for those
+        // searches to finish before the slots become available for reuse.
+        std::unique_lock structure_lock{*structure_mutex_};
+        size_t num_free = free_slots_.size();
+        for (size_t i = status_.size(); i > 0; --i) {
+            auto& status = status_[i - 1];
+            if (status == SlotMetadata::Deleted) {
+                status = SlotMetadata::Empty;
+                free_slots_.push_back(lib::narrow_cast<Idx>(i - 1));
+            }
+        }
+        std::inplace_merge(
+            free_slots_.begin(),
+            free_slots_.begin() + num_free,
+            free_slots_.end(),
+            std::greater<>()
+        );
+    }
+
+  public:
+
     ///// Threading Interface
     static bool can_change_threads() { return true; }
     size_t get_num_threads() const { return threadpool_.size(); }
@@ -812,41 +1279,8 @@ class MutableVamanaIndex {
 
     ///// Mutation
     void consolidate() {
-        auto check_is_deleted = [&](size_t i) { return this->is_deleted(i); };
-        auto valid = [&](size_t i) { return !(this->is_deleted(i)); };
-
-        // Determine if the entry point is deleted.
-        // If so - we need to pick a new one.
-        assert(entry_point_.size() == 1);
-        auto entry_point = entry_point_[0];
-        if (status_.at(entry_point) == SlotMetadata::Deleted) {
-            auto logger = svs::logging::get();
-            svs::logging::debug(logger, "Replacing entry point.");
-            auto new_entry_point =
-                extensions::compute_entry_point(data_, threadpool_, valid);
-            svs::logging::debug(logger, "New point: {}", new_entry_point);
-            assert(!is_deleted(new_entry_point));
-            entry_point_[0] = new_entry_point;
-        }
-
-        // Perform graph consolidation.
-        svs::index::vamana::consolidate(
-            graph_,
-            data_,
-            threadpool_,
-            prune_to_,
-            max_candidates_,
-            alpha_,
-            distance_,
-            check_is_deleted
-        );
-
-        // After consolidation - set all `Deleted` slots to `Empty`.
-        for (auto& status : status_) {
-            if (status == SlotMetadata::Deleted) {
-                status = SlotMetadata::Empty;
-            }
-        }
+        std::lock_guard mutation_lock{*mutation_mutex_};
+        consolidate_impl();
     }
 
     ///// Saving
@@ -857,10 +1291,15 @@ class MutableVamanaIndex {
         const std::filesystem::path& graph_directory,
         const std::filesystem::path& data_directory
     ) {
+        std::lock_guard mutation_lock{*mutation_mutex_};
+
         // Post-consolidation, all entries should be "valid".
         // Therefore, we don't need to save the slot metadata.
-        consolidate();
-        compact();
+        consolidate_impl();
+        {
+            std::unique_lock structure_lock{*structure_mutex_};
+            compact_impl(1'000);
+        }
 
         // Save auxiliary data structures.
         lib::save_to_disk(
@@ -959,6 +1398,7 @@ class MutableVamanaIndex {
     /// If such an exception is thrown, the argument ``dst`` will be left unmodified.
     template <std::unsigned_integral I, svs::Arithmetic T>
     void reconstruct_at(data::SimpleDataView<T> dst, std::span<const I> ids) {
+        std::shared_lock lock{*structure_mutex_};
         const size_t ids_size = ids.size();
         const size_t dst_size = dst.size();
         const size_t dst_dims = dst.dimensions();
@@ -1010,9 +1450,40 @@ class MutableVamanaIndex {
     ///
     void debug_check_invariants(bool allow_deleted) const {
         debug_check_size();
+        debug_check_free_slots();
         debug_check_graph_consistency(allow_deleted);
     }
 
+    ///
+    /// @brief Ensure the pool of free slots contains exactly the empty slots.
+    ///
+    void debug_check_free_slots() const {
+        if (!std::is_sorted(free_slots_.begin(), free_slots_.end(), std::greater<>())) {
+            throw ANNEXCEPTION("FREE SLOT INVARIANT: Free slots are not sorted!");
+        }
+
+        auto it = free_slots_.rbegin();
+        for (size_t i = 0, imax = status_.size(); i < imax; ++i) {
+            bool is_empty = status_[i] == SlotMetadata::Empty;
+            bool is_free = it != free_slots_.rend() && *it == i;
+            if (is_empty != is_free) {
+                throw ANNEXCEPTION(
+                    "FREE SLOT INVARIANT: Slot {} is {} but is {}in the free list!",
+                    i,
+                    index::vamana::name(status_[i]),
+                    is_free ? "" : "not "
+                );
+            }
+            if (is_free) {
+                ++it;
+            }
+        }
+
+        if (it != free_slots_.rend()) {
+            throw ANNEXCEPTION("FREE SLOT INVARIANT: Free slot {} is out of bounds!", *it);
+        }
+    }
+
     ///
     /// Make sure that the capacities of the main data structures (graph, data, metadata)
     /// agree.
@@ -44,6 +44,7 @@ template <typename Idx, typename Cmp = std::less<>> class MutableBuffer {
     using const_iterator = typename vector_type::const_iterator;
     using compare_type = Cmp;
     using filter_type = VisitedFilter<Idx, 16>;
+    using exact_filter_type = VisitedTable<Idx>;
 
   private:
     ///// Invariants:
@@ -86,13 +87,18 @@ template <typename Idx, typename Cmp = std::less<>> class MutableBuffer {
     vector_type candidates_{};
     // An optional visited filter.
     std::optional<filter_type> visited_{std::nullopt};
+    // An optional exact visited set. At most one of the visited sets is enabled.
+    std::optional<exact_filter_type> exact_visited_{std::nullopt};
 
   public:
     MutableBuffer() = default;
 
     /// Construct a new buffer with the given buffer configuration.
     explicit MutableBuffer(
-        SearchBufferConfig config, Cmp compare = Cmp{}, bool enable_visited = false
+        SearchBufferConfig config,
+        Cmp compare = Cmp{},
+        bool enable_visited = false,
+        bool exact_visited = false
     )
         : compare_{std::move(compare)}
         , target_valid_{lib::narrow<uint16_t>(config.get_search_window_size())}
@@ -100,7 +106,11 @@ template <typename Idx, typename Cmp = std::less<>> class MutableBuffer {
         , candidates_{valid_capacity_} {
         candidates_.clear();
         if (enable_visited) {
-            enable_visited_set();
+            if (exact_visited) {
+                enable_exact_visited_set();
+            } else {
+                enable_visited_set();
+            }
         }
     }
 
@@ -115,7 +125,8 @@ template <typename Idx, typename Cmp = std::less<>> class MutableBuffer {
     MutableBuffer shallow_copy() const {
         // We don't care about the contents of the buffer - just its size.
         // Therefore, we can construct a new buffer from scratch.
-        return MutableBuffer{config(), compare_, visited_set_enabled()};
+        return MutableBuffer{
+            config(), compare_, visited_set_enabled(), exact_visited_set_enabled()};
     }
 
     // TODO: Allow this construction to be noexcept.
@@ -142,14 +153,40 @@ template <typename Idx, typename Cmp = std::less<>> class MutableBuffer {
     // Change the maximum number of elements that can be in the search buffer.
     void change_maxsize(size_t new_size) { change_maxsize(SearchBufferConfig{new_size}); }
 
+    ///
+    /// @brief Increase the target and capacity of valid elements while preserving the
+    ///     contents.
+    ///
+    /// @param new_size The new target and capacity. Must be at least the current capacity.
+    ///
+    /// Unlike ``change_maxsize``, this may be called in the middle of a search.
+    /// Candidates beyond the previous region of interest become eligible for expansion.
+    ///
+    void grow(size_t new_size) {
+        uint16_t new_size_temp = lib::narrow<uint16_t>(new_size);
+        assert(new_size_temp >= valid_capacity_);
+        target_valid_ = new_size_temp;
+        valid_capacity_ = new_size_temp;
+
+        // Either `valid() < target_valid_` (invariant 5A) or the buffer was full, in which
+        // case invariant 6 implies the `target_valid_`th valid candidate is `back()`.
+        // In both cases, the region of interest extends to the end of the buffer.
+        roi_end_ = size();
+        while (best_unvisited_ < roi_end_ && candidates_[best_unvisited_].visited()) {
+            ++best_unvisited_;
+        }
+    }
+
     /// @brief Prepare the buffer for a new search operation.
     void clear() {
         candidates_.clear();
         best_unvisited_ = 0;
         roi_end_ = 0;
         valid_ = 0;
-        if (visited_set_enabled()) {
+        if (visited_) {
             visited_->reset();
+        } else if (exact_visited_) {
+            exact_visited_->reset();
         }
     }
 
@@ -469,6 +506,20 @@ template <typename Idx, typename Cmp = std::less<>> class MutableBuffer {
         }
     }
 
+    // Discard all but the first `n` candidates.
+    // Follow with `sort()` to restore the region-of-interest invariants.
+    void truncate(size_t n) {
+        if (n >= size()) {
+            return;
+        }
+        for (size_t i = n, imax = size(); i < imax; ++i) {
+            valid_ -= static_cast<uint16_t>(candidates_[i].valid());
+        }
+        candidates_.resize(n);
+        roi_end_ = std::min(roi_end_, lib::narrow_cast<uint16_t>(n));
+        best_unvisited_ = std::min(best_unvisited_, lib::narrow_cast<uint16_t>(n));
+    }
+
     // TODO: Switch over to using iterators for the return values to avoid this.
     void cleanup() {
         auto new_end =
@@ -489,17 +540,26 @@ template <typename Idx, typename Cmp = std::less<>> class MutableBuffer {
     size_t size() const { return candidates_.size(); }
 
     ///// Visited API
-    bool visited_set_enabled() const { return visited_.has_value(); }
+    bool visited_set_enabled() const {
+        return visited_.has_value() || exact_visited_.has_value();
+    }
+    bool exact_visited_set_enabled() const { return exact_visited_.has_value(); }
     void enable_visited_set() {
-        if (!visited_set_enabled()) {
+        exact_visited_.reset();
+        if (!visited_) {
             visited_.emplace();
         }
     }
+    void enable_exact_visited_set() {
+        visited_.reset();
+        if (!exact_visited_) {
+            exact_visited_.emplace();
+        }
+    }
 
     void disable_visited_set() {
-        if (visited_set_enabled()) {
-            visited_.reset();
-        }
+        visited_.reset();
+        exact_visited_.reset();
     }
 
     bool is_visited(Idx i) const { return visited_set_enabled() && unsafe_is_visited(i); }
@@ -514,16 +574,20 @@ template <typename Idx, typename Cmp = std::less<>> class MutableBuffer {
 
     // Unsafe API
     bool unsafe_is_visited(Idx i) const {
-        assert(visited_);
-        return visited_->contains(i);
+        assert(visited_set_enabled());
+        return exact_visited_ ? exact_visited_->contains(i) : visited_->contains(i);
     }
     void unsafe_prefetch_visited(Idx i) const {
-        assert(visited_);
-        return visited_->prefetch(i);
+        assert(visited_set_enabled());
+        if (exact_visited_) {
+            exact_visited_->prefetch(i);
+        } else {
+            visited_->prefetch(i);
+        }
     }
     bool unsafe_emplace_visited(Idx i) {
-        assert(visited_);
-        return visited_->emplace(i);
+        assert(visited_set_enabled());
+        return exact_visited_ ? exact_visited_->emplace(i) : visited_->emplace(i);
     }
 
   private:
@@ -14,6 +14,7 @@
 #include "svs/concepts/distance.h"
 #include "svs/core/data.h"
 #include "svs/core/distance.h"
+#include "svs/core/kmeans.h"
 #include "svs/core/medioid.h"
 #include "svs/core/query_result.h"
 #include "svs/index/vamana/greedy_search.h"
@@ -22,6 +23,13 @@
 #include "svs/lib/preprocessor.h"
 #include "svs/lib/threads.h"
 
+// stl
+#include <algorithm>
+#include <array>
+#include <span>
+#include <type_traits>
+#include <vector>
+
 namespace svs::index::vamana::extensions {
 
 /////
@@ -62,6 +70,38 @@ size_t svs_invoke(
     return utils::find_medioid(dataset, threadpool, predicate);
 }
 
+struct ComputeEntryPoints {
+    ///
+    /// @brief Compute entry points for search covering the clusters of the given dataset.
+    ///
+    /// @param dataset The dataset being processed.
+    /// @param threadpool The pool to use for computation.
+    /// @param num_entry_points The desired number of entry points.
+    ///
+    /// Returns the indices of at most ``num_entry_points`` distinct elements of
+    /// ``dataset``.
+    ///
+    template <typename Data, threads::ThreadPool Pool>
+    std::vector<size_t>
+    operator()(const Data& dataset, Pool& threadpool, size_t num_entry_points) const {
+        return svs::svs_invoke(*this, dataset, threadpool, num_entry_points);
+    }
+};
+
+/// @brief Customization point for computing multiple entry points.
+inline constexpr ComputeEntryPoints compute_entry_points{};
+
+// Default Implementation
+template <typename Data, threads::ThreadPool Pool>
+std::vector<size_t> svs_invoke(
+    svs::tag_t<compute_entry_points>,
+    const Data& dataset,
+    Pool& threadpool,
+    size_t num_entry_points
+) {
+    return find_cluster_representatives(dataset, num_entry_points, threadpool);
+}
+
 /////
 ///// PERFORMANCE EXTENSIONS
 /////
@@ -387,6 +427,9 @@ struct VamanaSingleSearchType {
     ///        ``svs::index::vamana::extensions::single_search_setup``().
     /// @param query The query used for this search.
     /// @param search A search functor. See the extended description.
+    /// @param rerank_depth The number of candidates to refine for datasets that rerank
+    ///        the results of graph search. A value of zero refines the entire buffer.
+    ///        Implementations that rerank may discard candidates beyond this depth.
     ///
     /// API of the ``search`` argument.
     /// This argument is invocable as follows:
@@ -411,9 +454,10 @@ struct VamanaSingleSearchType {
         SearchBuffer& search_buffer,
         Scratch& scratch,
         const Query& query,
-        const Search& search
+        const Search& search,
+        size_t rerank_depth = 0
     ) const {
-        svs::svs_invoke(*this, data, search_buffer, scratch, query, search);
+        svs::svs_invoke(*this, data, search_buffer, scratch, query, search, rerank_depth);
     }
 };
 
@@ -432,7 +476,8 @@ SVS_FORCE_INLINE void svs_invoke(
     SearchBuffer& search_buffer,
     Distance& distance,
     const Query& query,
-    const Search& search
+    const Search& search,
+    size_t SVS_UNUSED(rerank_depth)
 ) {
     // Perform graph search.
     auto accessor = data::GetDatumAccessor();
@@ -461,6 +506,9 @@ struct VamanaPerThreadBatchSearchType {
     ///        the ``search_buffer`` argument. See the documentation for
     ///        ``svs::index::vamana::extensions::VamanaSingleSearchType`` for details on
     ///        the signature of ``search``.
+    /// @param rerank_depth The number of candidates to refine for datasets that rerank
+    ///        the results of graph search. A value of zero refines the entire buffer.
+    ///        When non-zero, this is at least ``result.n_neighbors()``.
     ///
     /// This function is expected to process all element queries for the range defined by
     /// the ``thread_indices`` argument and store the results in the corresponding position
@@ -482,10 +530,19 @@ struct VamanaPerThreadBatchSearchType {
         const Queries& queries,
         QueryResultView<I>& result,
         threads::UnitRange<size_t> thread_indices,
-        const Search& search
+        const Search& search,
+        size_t rerank_depth = 0
     ) const {
         svs::svs_invoke(
-            *this, data, search_buffer, scratch, queries, result, thread_indices, search
+            *this,
+            data,
+            search_buffer,
+            scratch,
+            queries,
+            result,
+            thread_indices,
+            search,
+            rerank_depth
         );
     }
 };
@@ -509,13 +566,16 @@ void svs_invoke(
     const Queries& queries,
     QueryResultView<I>& result,
     threads::UnitRange<size_t> thread_indices,
-    const Search& search
+    const Search& search,
+    size_t rerank_depth
 ) {
     // Fallback implementation
     size_t num_neighbors = result.n_neighbors();
     for (auto i : thread_indices) {
         // Perform search - results will be queued in the search buffer.
-        single_search(dataset, search_buffer, distance, queries.get_datum(i), search);
+        single_search(
+            dataset, search_buffer, distance, queries.get_datum(i), search, rerank_depth
+        );
 
         // Copy back results.
         for (size_t j = 0; j < num_neighbors; ++j) {
@@ -540,6 +600,98 @@ template <typename Data> struct UsesReranking {
 
 template <typename Data> inline constexpr UsesReranking<Data> calibration_uses_reranking{};
 
+/////
+///// Interleaved Batch Search
+/////
+
+///
+/// @brief Trait indicating whether batch search may interleave queries on a thread.
+///
+/// Interleaved search bypasses ``single_search`` and ``per_thread_batch_search`` and runs
+/// graph search directly using ``svs::data::GetDatumAccessor``. Datasets that rerank the
+/// results of graph search opt out by default. Other datasets customizing search should
+/// opt out by extending this trait.
+///
+template <typename Data> struct SupportsInterleavedSearch {
+    constexpr bool operator()() const {
+        if constexpr (svs::svs_invocable<SupportsInterleavedSearch>) {
+            return svs::svs_invoke(*this);
+        } else {
+            return !UsesReranking<Data>{}();
+        }
+    }
+};
+
+template <typename Data>
+inline constexpr SupportsInterleavedSearch<Data> supports_interleaved_search{};
+
+///
+/// @brief Process a batch of queries on a single thread, interleaving groups of queries.
+///
+/// @param search_buffers One search buffer per interleaved query.
+/// @param distances One distance functor per interleaved query, obtained from
+///        ``svs::index::vamana::extensions::single_search_setup()``.
+/// @param queries The global batch of queries.
+/// @param result The global result buffer.
+/// @param thread_indices The entries in ``queries`` and ``result`` that this function
+///        is responsible for handling.
+/// @param search A functor invoked as
+///        @code{cpp}
+///        search(group, accessor, distances, search_buffers)
+///        @endcode
+///        where ``group`` is a ``std::span`` of queries. On return, the results for
+///        ``group[i]`` must be stored in ``search_buffers[i]``.
+///
+/// Queries are processed in groups of up to ``search_buffers.size()`` elements.
+///
+template <
+    typename SearchBuffer,
+    typename Distance,
+    data::ImmutableMemoryDataset Queries,
+    std::integral I,
+    typename Search>
+void interleaved_batch_search(
+    std::span<SearchBuffer> search_buffers,
+    std::span<Distance> distances,
+    const Queries& queries,
+    QueryResultView<I>& result,
+    threads::UnitRange<size_t> thread_indices,
+    const Search& search
+) {
+    using query_type = std::remove_cvref_t<decltype(queries.get_datum(0))>;
+    size_t group_size =
+        std::min({search_buffers.size(), distances.size(), max_interleaved_queries});
+    size_t num_neighbors = result.n_neighbors();
+    auto group = std::array<query_type, max_interleaved_queries>{};
+    auto accessor = data::GetDatumAccessor();
+
+    size_t start = 0;
+    size_t stop = thread_indices.size();
+    while (start < stop) {
+        size_t count = std::min(group_size, stop - start);
+        for (size_t g = 0; g < count; ++g) {
+            group[g] = queries.get_datum(thread_indices[start + g]);
+        }
+
+        search(
+            std::span<const query_type>(group.data(), count),
+            accessor,
+            distances.first(count),
+            search_buffers.first(count)
+        );
+
+        // Copy back results.
+        for (size_t g = 0; g < count; ++g) {
+            const auto& search_buffer = search_buffers[g];
+            size_t i = thread_indices[start + g];
+            for (size_t j = 0; j < num_neighbors; ++j) {
+                result.set(search_buffer[j], i, j);
+            }
+        }
+        start += count;
+    }
+}
+
 /////
 ///// Reconstruct Vector
 /////
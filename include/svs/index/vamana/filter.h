@@ -15,7 +15,11 @@
 #include "svs/lib/prefetch.h"
 
 // stl
+#include <algorithm>
 #include <bit>
+#include <cassert>
+#include <concepts>
+#include <cstdint>
 #include <limits>
 #include <type_traits>
 #include <vector>
@@ -124,4 +128,112 @@ template <size_t N> class VisitedFilter<uint32_t, N> {
     std::vector<value_type> values_;
 };
 
+///
+/// An exact set of visited IDs with constant time reset.
+///
+/// Each ID owns a tag holding the epoch in which it was last inserted and an ID is a
+/// member of the set if its tag matches the current epoch. Resetting the set increments
+/// the epoch instead of clearing the tags. The tags are only cleared when the epoch wraps
+/// around, which happens once every ``2^bits(Tag) - 1`` resets.
+///
+/// Unlike the ``VisitedFilter``, this set never yields false negatives, so no distance is
+/// computed twice during a search regardless of the size of the search window.
+///
+/// Tags are allocated in pages of ``page_size`` entries on first insertion into the page,
+/// so the memory footprint is proportional to the portion of the ID space touched by
+/// searches rather than the size of the dataset. Each thread should own its own set.
+///
+/// @tparam I The integer type of the IDs.
+/// @tparam Tag The unsigned type used for epoch tags. Narrower tags use less memory but
+///     wrap around (and thus clear all pages) more often.
+///
+template <std::integral I, std::unsigned_integral Tag = uint16_t> class VisitedTable {
+  public:
+    // The integer type compatible with this set.
+    using integer_type = I;
+    // The type of the per-ID epoch tags.
+    using value_type = Tag;
+
+    /// @brief The base-2 logarithm of the number of tags in each page.
+    static constexpr size_t page_bits = 12;
+    /// @brief The number of tags in each page.
+    static constexpr size_t page_size = size_t(1) << page_bits;
+    // Mask to extract the offset of an ID within its page.
+    static constexpr size_t page_mask = page_size - 1;
+
+    /// @brief Construct a new empty visited set.
+    ///
+    /// No storage is allocated until IDs are inserted.
+    VisitedTable() = default;
+
+    /// @brief Remove all entries from the set.
+    void reset() {
+        ++epoch_;
+        if (epoch_ == 0) {
+            // The epoch wrapped around. Stale tags may now match future epochs.
+            for (auto& page : pages_) {
+                std::fill(page.begin(), page.end(), value_type{0});
+            }
+            epoch_ = 1;
+        }
+    }
+
+    /// @brief Return the number of IDs the set can hold without allocating a new page.
+    size_t capacity() const { return pages_.size() * page_size; }
+
+    /// @brief Return the current epoch.
+    value_type epoch() const { return epoch_; }
+
+    /// @brief Prefetch the storage that contains the tag for ``key``.
+    void prefetch(integer_type key) const {
+        if (const value_type* tag = find(key)) {
+            lib::prefetch_l0(tag);
+        }
+    }
+
+    /// @brief Insert ``key`` into the set. Return ``true`` if it was already present.
+    bool emplace(integer_type key) {
+        auto& tag = slot(key);
+        bool b = (tag == epoch_);
+        tag = epoch_;
+        return b;
+    }
+
+    /// @brief Return whether or not ``key`` is present in the set.
+    bool contains(integer_type key) const {
+        const value_type* tag = find(key);
+        return tag != nullptr && *tag == epoch_;
+    }
+
+  private:
+    static size_t page(integer_type key) { return static_cast<size_t>(key) >> page_bits; }
+    static size_t offset(integer_type key) { return static_cast<size_t>(key) & page_mask; }
+
+    // Return a pointer to the tag for `key` or `nullptr` if its page is not allocated.
+    const value_type* find(integer_type key) const {
+        auto p = page(key);
+        if (p >= pages_.size() || pages_[p].empty()) {
+            return nullptr;
+        }
+        return &pages_[p][offset(key)];
+    }
+
+    // Return the tag for `key`, allocating its page if required.
+    value_type& slot(integer_type key) {
+        auto p = page(key);
+        if (p >= pages_.size()) {
+            pages_.resize(p + 1);
+        }
+        auto& page = pages_[p];
+        if (page.empty()) {
+            page.resize(page_size, value_type{0});
+        }
+        return page[offset(key)];
+    }
+
+    // Tags of zero are never current, so freshly allocated pages are empty.
+    value_type epoch_ = 1;
+    std::vector<std::vector<value_type>> pages_{};
+};
+
 } // namespace svs::index::vamana
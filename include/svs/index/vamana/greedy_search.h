@@ -15,9 +15,16 @@
 #include "svs/concepts/distance.h"
 #include "svs/concepts/graph.h"
 #include "svs/index/vamana/search_buffer.h"
+#include "svs/lib/exception.h"
+#include "svs/lib/prefetch.h"
+#include "svs/lib/preprocessor.h"
 
 #include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
 #include <memory>
+#include <span>
 
 namespace svs::index::vamana {
 
@@ -44,6 +51,29 @@ struct GreedySearchPrefetchParameters {
     size_t step{2};
 };
 
+///
+/// @brief Optional conditions for ending a greedy search before the search window has
+/// been fully expanded.
+///
+/// Both conditions are disabled by default, in which case greedy search terminates only
+/// when every candidate in the search window has been expanded.
+///
+struct GreedySearchTerminationParameters {
+  public:
+    /// The number of leading search buffer entries monitored by the termination conditions
+    /// (usually the number of requested neighbors). Zero monitors the whole search window.
+    size_t num_neighbors{0};
+    /// Stop after this many consecutive expansions fail to insert a candidate into the
+    /// monitored entries. Zero disables this condition.
+    size_t patience{0};
+    /// Stop when the best unexpanded candidate is further than ``distance_ratio`` times the
+    /// distance of the last monitored entry. Values less than one disable this condition.
+    float distance_ratio{0};
+
+    /// Return whether any termination condition is enabled.
+    bool enabled() const { return patience != 0 || distance_ratio >= 1; }
+};
+
 /////
 ///// Greedy Search
 /////
@@ -58,17 +88,121 @@ struct NeighborBuilder {
     }
 };
 
+// Builder for searches restricting results to the IDs accepted by a predicate.
+// Rejected neighbors are still traversed but are marked as invalid, so this builder must
+// be paired with a search buffer supporting invalid entries (such as the `MutableBuffer`).
+template <typename Pred> struct PredicateBuilder {
+    [[no_unique_address]] Pred predicate;
+
+    template <typename I>
+    constexpr PredicatedSearchNeighbor<I> operator()(I i, float distance) const {
+        return PredicatedSearchNeighbor<I>(i, distance, predicate(i));
+    }
+};
+
+// Deduction guide
+template <typename Pred> PredicateBuilder(Pred) -> PredicateBuilder<Pred>;
+
+// Builder for searches confined to the subgraph induced by the IDs accepted by a predicate.
+// Rejected neighbors are skipped without computing their distance, so they are neither
+// traversed nor returned. Entry points are not checked and should satisfy the predicate.
+template <typename Pred> struct SubgraphBuilder {
+    [[no_unique_address]] Pred predicate;
+
+    template <typename I> bool admits(I i) const { return predicate(i); }
+
+    template <typename I>
+    constexpr SearchNeighbor<I> operator()(I i, float distance) const {
+        return SearchNeighbor<I>{i, distance};
+    }
+};
+
+// Deduction guide
+template <typename Pred> SubgraphBuilder(Pred) -> SubgraphBuilder<Pred>;
+
+namespace detail {
+
+// Return the number of search results currently held by the search buffer.
+template <typename Buffer> size_t num_results(const Buffer& search_buffer) {
+    if constexpr (requires { search_buffer.valid(); }) {
+        return search_buffer.valid();
+    } else {
+        return search_buffer.size();
+    }
+}
+
+// State for the optional early termination conditions of greedy search.
+//
+// Monitored entries are counted by their position in the search buffer. For buffers that
+// navigate through invalid entries (such as the `MutableBuffer`), invalid entries count
+// toward the monitored positions as well.
+class EarlyTermination {
+  public:
+    EarlyTermination() = default;
+
+    template <typename Buffer>
+    EarlyTermination(
+        const GreedySearchTerminationParameters& parameters, const Buffer& search_buffer
+    )
+        : num_neighbors_{parameters.num_neighbors}
+        , patience_{parameters.patience}
+        , distance_ratio_{parameters.distance_ratio} {
+        if (num_neighbors_ == 0 && parameters.enabled()) {
+            num_neighbors_ = search_buffer.config().get_search_window_size();
+        }
+    }
+
+    // Return `true` if the best unexpanded candidate in the buffer is too far away from the
+    // monitored entries to be worth expanding. Since candidates are sorted, this holds for
+    // all remaining candidates.
+    //
+    // Pre-conditions:
+    // * `search_buffer.done()` must evaluate to `false`.
+    template <typename Buffer> bool out_of_range(const Buffer& search_buffer) const {
+        if (distance_ratio_ < 1 || num_results(search_buffer) < num_neighbors_) {
+            return false;
+        }
+        auto compare = typename Buffer::compare_type{};
+        float last = search_buffer[num_neighbors_ - 1].distance();
+        float candidate = search_buffer[search_buffer.best_unvisited()].distance();
+        // Test against both `last + slack` and `last - slack` so the bound works whether
+        // the comparator is minimizing or maximizing.
+        float slack = (distance_ratio_ - 1) * std::abs(last);
+        return compare(last + slack, candidate) && compare(last - slack, candidate);
+    }
+
+    // Record the result of expanding a candidate, where `position` is the best position
+    // at which a neighbor was inserted. Return `true` if search should stop.
+    template <typename Buffer> bool stalled(const Buffer& search_buffer, size_t position) {
+        if (patience_ == 0) {
+            return false;
+        }
+        if (position < num_neighbors_ || num_results(search_buffer) < num_neighbors_) {
+            expansions_without_improvement_ = 0;
+            return false;
+        }
+        return ++expansions_without_improvement_ >= patience_;
+    }
+
+  private:
+    size_t num_neighbors_ = 0;
+    size_t patience_ = 0;
+    float distance_ratio_ = 0;
+    size_t expansions_without_improvement_ = 0;
+};
+
+// Compute the distances to the entry points and seed the search buffer.
 template <
-    graphs::ImmutableMemoryGraph Graph,
-    data::ImmutableMemoryDataset Dataset,
-    data::AccessorFor<Dataset> Accessor,
+    typename Graph,
+    typename Dataset,
+    typename Accessor,
     typename QueryType,
-    distance::Distance<QueryType, typename Dataset::const_value_type> Dist,
+    typename Dist,
     typename Buffer,
     typename Ep,
     typename Builder,
-    GreedySearchTracker<typename Graph::index_type> Tracker>
-void greedy_search(
+    typename Tracker>
+SVS_FORCE_INLINE void initialize_search(
     const Graph& graph,
     const Dataset& dataset,
     Accessor& accessor,
@@ -77,8 +211,7 @@ void greedy_search(
     Buffer& search_buffer,
     const Ep& entry_points,
     const Builder& builder,
-    Tracker& search_tracker,
-    GreedySearchPrefetchParameters prefetch_parameters = {}
+    Tracker& search_tracker
 ) {
     using I = typename Graph::index_type;
 
@@ -91,60 +224,387 @@ void greedy_search(
     }
 
     // Populate initial points.
+    // If there are more entry points than the buffer can hold, keep the closest ones.
     search_buffer.clear();
+    bool overflow = false;
     for (const auto& id : entry_points) {
         auto dist = distance::compute(distance_function, query, accessor(dataset, id));
-        search_buffer.push_back(builder(id, dist));
-        graph.prefetch_node(id);
         search_tracker.visited(Neighbor<I>{id, dist}, 1);
+        if (!search_buffer.full()) {
+            search_buffer.push_back(builder(id, dist));
+        } else {
+            if (!overflow) {
+                search_buffer.sort();
+                overflow = true;
+            }
+            search_buffer.insert(builder(id, dist));
+        }
+        graph.prefetch_node(id);
     }
+    search_buffer.sort();
+}
+
+// Compute the distances to all unvisited elements of `neighbors` and add them to the
+// search buffer. Return the smallest position at which a neighbor was inserted.
+template <
+    typename Dataset,
+    typename Accessor,
+    typename QueryType,
+    typename Dist,
+    typename Buffer,
+    typename Neighbors,
+    typename Builder>
+SVS_FORCE_INLINE size_t expand_neighbors(
+    const Dataset& dataset,
+    Accessor& accessor,
+    const QueryType& query,
+    Dist& distance_function,
+    Buffer& search_buffer,
+    const Neighbors& neighbors,
+    const Builder& builder,
+    GreedySearchPrefetchParameters prefetch_parameters
+) {
+    const size_t num_neighbors = neighbors.size();
+    auto prefetcher = lib::make_prefetcher(
+        lib::PrefetchParameters{prefetch_parameters.lookahead, prefetch_parameters.step},
+        num_neighbors,
+        [&](size_t i) { accessor.prefetch(dataset, neighbors[i]); },
+        [&](size_t i) {
+            // Don't bother fetching neighbors that will be skipped.
+            if constexpr (requires { builder.admits(neighbors[i]); }) {
+                if (!builder.admits(neighbors[i])) {
+                    return false;
+                }
+            }
+
+            // Perform the visited set enabled check just once.
+            if (search_buffer.visited_set_enabled()) {
+                // Prefetch next bucket so it's (hopefully) in the cache when we next
+                // consult the visited filter.
+                if (i + 1 < num_neighbors) {
+                    search_buffer.unsafe_prefetch_visited(neighbors[i + 1]);
+                }
+                return !search_buffer.unsafe_is_visited(neighbors[i]);
+            }
+
+            // Otherwise, always prefetch the next data item.
+            return true;
+        }
+    );
+
+    ///// Neighbor expansion.
+    size_t best_position = std::numeric_limits<size_t>::max();
+    prefetcher();
+    for (auto id : neighbors) {
+        if constexpr (requires { builder.admits(id); }) {
+            if (!builder.admits(id)) {
+                continue;
+            }
+        }
+        if (search_buffer.emplace_visited(id)) {
+            continue;
+        }
+
+        // Run the prefetcher.
+        prefetcher();
+
+        // Compute distance and update search buffer.
+        auto dist = distance::compute(distance_function, query, accessor(dataset, id));
+        best_position = std::min(best_position, search_buffer.insert(builder(id, dist)));
+    }
+    return best_position;
+}
+
+// Grow the search buffer for range search if expanding the next candidate could evict a
+// result within `radius`.
+//
+// Expanding a candidate inserts at most `max_degree` neighbors, so only entries at
+// positions `capacity - max_degree` and beyond can be evicted. Since the buffer is sorted,
+// it suffices to check the entry at that position. For buffers containing invalid entries,
+// the entry at that position is no further than the corresponding valid entry, so the
+// check is conservative.
+template <typename Buffer>
+void maybe_grow_for_range(
+    Buffer& search_buffer, float radius, size_t max_degree, size_t max_capacity
+) {
+    size_t capacity = search_buffer.config().get_total_capacity();
+    if (capacity >= max_capacity || num_results(search_buffer) + max_degree <= capacity) {
+        return;
+    }
+    size_t position = capacity > max_degree ? capacity - max_degree : 0;
+    auto compare = typename Buffer::compare_type{};
+    if (position < search_buffer.size() &&
+        compare(radius, search_buffer[position].distance())) {
+        return;
+    }
+    size_t new_capacity =
+        std::min(max_capacity, std::max(2 * capacity, capacity + max_degree));
+    search_buffer.grow(new_capacity);
+}
+
+} // namespace detail
+
+template <
+    graphs::ImmutableMemoryGraph Graph,
+    data::ImmutableMemoryDataset Dataset,
+    data::AccessorFor<Dataset> Accessor,
+    typename QueryType,
+    distance::Distance<QueryType, typename Dataset::const_value_type> Dist,
+    typename Buffer,
+    typename Ep,
+    typename Builder,
+    GreedySearchTracker<typename Graph::index_type> Tracker>
+void greedy_search(
+    const Graph& graph,
+    const Dataset& dataset,
+    Accessor& accessor,
+    const QueryType& query,
+    Dist& distance_function,
+    Buffer& search_buffer,
+    const Ep& entry_points,
+    const Builder& builder,
+    Tracker& search_tracker,
+    GreedySearchPrefetchParameters prefetch_parameters = {},
+    const GreedySearchTerminationParameters& termination_parameters = {}
+) {
+    using I = typename Graph::index_type;
+    detail::initialize_search(
+        graph,
+        dataset,
+        accessor,
+        query,
+        distance_function,
+        search_buffer,
+        entry_points,
+        builder,
+        search_tracker
+    );
 
     // Main search routine.
-    search_buffer.sort();
-    while (!search_buffer.done()) {
+    auto termination = detail::EarlyTermination(termination_parameters, search_buffer);
+    while (!search_buffer.done() && !termination.out_of_range(search_buffer)) {
         // Get the next unvisited vertex.
         const auto& node = search_buffer.next();
         auto node_id = node.id();
 
-        // Get the adjacency list for this vertex and prepare prefetching logic.
+        // Get the adjacency list for this vertex.
         auto neighbors = graph.get_node(node_id);
-        const size_t num_neighbors = neighbors.size();
         search_tracker.visited(Neighbor<I>{node}, neighbors.size());
+        size_t position = detail::expand_neighbors(
+            dataset,
+            accessor,
+            query,
+            distance_function,
+            search_buffer,
+            neighbors,
+            builder,
+            prefetch_parameters
+        );
+        if (termination.stalled(search_buffer, position)) {
+            break;
+        }
+    }
+}
 
-        auto prefetcher = lib::make_prefetcher(
-            lib::PrefetchParameters{
-                prefetch_parameters.lookahead, prefetch_parameters.step},
-            num_neighbors,
-            [&](size_t i) { accessor.prefetch(dataset, neighbors[i]); },
-            [&](size_t i) {
-                // Perform the visited set enabled check just once.
-                if (search_buffer.visited_set_enabled()) {
-                    // Prefetch next bucket so it's (hopefully) in the cache when we next
-                    // consult the visited filter.
-                    if (i + 1 < num_neighbors) {
-                        search_buffer.unsafe_prefetch_visited(neighbors[i + 1]);
-                    }
-                    return !search_buffer.unsafe_is_visited(neighbors[i]);
-                }
+///
+/// @brief Run greedy search, growing the search buffer to retain all results in a radius.
+///
+/// @param graph The graph to search.
+/// @param dataset The dataset being searched.
+/// @param accessor Accessor for the elements of ``dataset``.
+/// @param query The query.
+/// @param distance_function The distance functor for the query.
+/// @param search_buffer The search buffer. Its search window size and capacity should be
+///     equal and determine the minimum number of candidates to expand.
+/// @param entry_points The entry points for the search.
+/// @param builder Builder for search buffer elements.
+/// @param radius The search radius. Candidates compared less than or equal to ``radius``
+///     with the buffer's comparison functor are within the radius.
+/// @param max_capacity The largest capacity the search buffer may grow to.
+/// @param prefetch_parameters Prefetch parameters for neighbor expansion.
+///
+/// Search proceeds as ``greedy_search``, except the buffer is grown (preserving its
+/// contents) whenever expanding the next candidate could evict a candidate within the
+/// radius. As a result, search keeps expanding while the frontier remains within the
+/// radius and no candidate within the radius is ever discarded.
+///
+/// On return, all candidates within the radius that were discovered during search are
+/// contained in the buffer.
+///
+template <
+    graphs::ImmutableMemoryGraph Graph,
+    data::ImmutableMemoryDataset Dataset,
+    data::AccessorFor<Dataset> Accessor,
+    typename QueryType,
+    distance::Distance<QueryType, typename Dataset::const_value_type> Dist,
+    typename Buffer,
+    typename Ep,
+    typename Builder = NeighborBuilder>
+void range_greedy_search(
+    const Graph& graph,
+    const Dataset& dataset,
+    Accessor& accessor,
+    const QueryType& query,
+    Dist& distance_function,
+    Buffer& search_buffer,
+    const Ep& entry_points,
+    const Builder& builder,
+    float radius,
+    size_t max_capacity,
+    GreedySearchPrefetchParameters prefetch_parameters = {}
+) {
+    auto null_tracker = NullTracker{};
+    detail::initialize_search(
+        graph,
+        dataset,
+        accessor,
+        query,
+        distance_function,
+        search_buffer,
+        entry_points,
+        builder,
+        null_tracker
+    );
 
-                // Otherwise, always prefetch the next data item.
-                return true;
-            }
+    const size_t max_degree = graph.max_degree();
+    while (!search_buffer.done()) {
+        detail::maybe_grow_for_range(search_buffer, radius, max_degree, max_capacity);
+        const auto& node = search_buffer.next();
+        detail::expand_neighbors(
+            dataset,
+            accessor,
+            query,
+            distance_function,
+            search_buffer,
+            graph.get_node(node.id()),
+            builder,
+            prefetch_parameters
         );
+    }
+}
 
-        ///// Neighbor expansion.
-        prefetcher();
-        for (auto id : neighbors) {
-            if (search_buffer.emplace_visited(id)) {
+/////
+///// Interleaved Greedy Search
+/////
+
+/// The largest number of queries that may be interleaved by a single thread.
+inline constexpr size_t max_interleaved_queries = 32;
+
+///
+/// @brief Run greedy search for a group of queries, interleaving their graph traversals.
+///
+/// @param graph The graph to search.
+/// @param dataset The dataset being searched.
+/// @param accessor Accessor for the elements of ``dataset``.
+/// @param queries The queries to process.
+/// @param distance_functions One distance functor for each query.
+/// @param search_buffers One search buffer for each query. On return, the buffer for
+///     query ``i`` contains the same results as a call to ``greedy_search`` would.
+/// @param entry_points The entry points for the search.
+/// @param builder Builder for search buffer elements.
+/// @param prefetch_parameters Prefetch parameters for neighbor expansion.
+/// @param termination_parameters Early termination conditions applied to each query.
+///
+/// Each query is a small state machine consisting of its search buffer and the next
+/// candidate to expand. After expanding a candidate, the adjacency list of the query's
+/// next candidate is prefetched and the thread switches to the next query in the group,
+/// giving the prefetch time to complete before the adjacency list is needed.
+///
+/// The sequence of operations applied to each search buffer is identical to
+/// ``greedy_search``, so interleaving does not change the search results.
+///
+template <
+    graphs::ImmutableMemoryGraph Graph,
+    data::ImmutableMemoryDataset Dataset,
+    data::AccessorFor<Dataset> Accessor,
+    typename QueryType,
+    distance::Distance<QueryType, typename Dataset::const_value_type> Dist,
+    typename Buffer,
+    typename Ep,
+    typename Builder = NeighborBuilder>
+void interleaved_greedy_search(
+    const Graph& graph,
+    const Dataset& dataset,
+    Accessor& accessor,
+    std::span<const QueryType> queries,
+    std::span<Dist> distance_functions,
+    std::span<Buffer> search_buffers,
+    const Ep& entry_points,
+    const Builder& builder = NeighborBuilder(),
+    GreedySearchPrefetchParameters prefetch_parameters = {},
+    const GreedySearchTerminationParameters& termination_parameters = {}
+) {
+    using I = typename Graph::index_type;
+    const size_t num_queries = queries.size();
+    if (num_queries > max_interleaved_queries) {
+        throw ANNEXCEPTION(
+            "Cannot interleave {} queries (maximum {})!",
+            num_queries,
+            max_interleaved_queries
+        );
+    }
+    if (distance_functions.size() < num_queries || search_buffers.size() < num_queries) {
+        throw ANNEXCEPTION("Not enough resources to interleave {} queries!", num_queries);
+    }
+
+    // The queries that still have candidates to expand and the next candidate for each.
+    auto active = std::array<size_t, max_interleaved_queries>{};
+    auto pending = std::array<I, max_interleaved_queries>{};
+    auto termination = std::array<detail::EarlyTermination, max_interleaved_queries>{};
+    size_t num_active = 0;
+
+    auto null_tracker = NullTracker{};
+    for (size_t i = 0; i < num_queries; ++i) {
+        auto& search_buffer = search_buffers[i];
+        detail::initialize_search(
+            graph,
+            dataset,
+            accessor,
+            queries[i],
+            distance_functions[i],
+            search_buffer,
+            entry_points,
+            builder,
+            null_tracker
+        );
+        termination[i] = detail::EarlyTermination(termination_parameters, search_buffer);
+        if (!search_buffer.done() && !termination[i].out_of_range(search_buffer)) {
+            pending[i] = search_buffer.next().id();
+            active[num_active] = i;
+            ++num_active;
+        }
+    }
+
+    // Round-robin over the active queries until all searches have converged.
+    while (num_active != 0) {
+        size_t k = 0;
+        while (k < num_active) {
+            size_t i = active[k];
+            auto& search_buffer = search_buffers[i];
+            size_t position = detail::expand_neighbors(
+                dataset,
+                accessor,
+                queries[i],
+                distance_functions[i],
+                search_buffer,
+                graph.get_node(pending[i]),
+                builder,
+                prefetch_parameters
+            );
+
+            if (termination[i].stalled(search_buffer, position) || search_buffer.done() ||
+                termination[i].out_of_range(search_buffer)) {
+                // Retire this query. Order among the remaining queries does not matter.
+                --num_active;
+                active[k] = active[num_active];
                 continue;
             }
 
-            // Run the prefetcher.
-            prefetcher();
-
-            // Compute distance and update search buffer.
-            auto dist = distance::compute(distance_function, query, accessor(dataset, id));
-            search_buffer.insert(builder(id, dist));
+            // Queue up the next candidate and switch to the next query while its
+            // adjacency list is fetched.
+            pending[i] = search_buffer.next().id();
+            graph.prefetch_node(pending[i]);
+            ++k;
         }
     }
 }
@@ -169,7 +629,8 @@ void greedy_search(
     Buffer& search_buffer,
     const Ep& entry_points,
     const Builder& builder = NeighborBuilder(),
-    GreedySearchPrefetchParameters prefetch_parameters = {}
+    GreedySearchPrefetchParameters prefetch_parameters = {},
+    const GreedySearchTerminationParameters& termination_parameters = {}
 ) {
     auto null_tracker = NullTracker{};
     greedy_search(
@@ -182,7 +643,8 @@ void greedy_search(
         entry_points,
         builder,
         null_tracker,
-        prefetch_parameters
+        prefetch_parameters,
+        termination_parameters
     );
 }
 } // namespace svs::index::vamana
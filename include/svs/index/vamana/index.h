@@ -12,6 +12,7 @@
 #pragma once
 
 // svs
+#include "svs/core/bitset.h"
 #include "svs/core/data.h"
 #include "svs/core/graph.h"
 #include "svs/core/loading.h"
@@ -19,8 +20,13 @@
 #include "svs/core/query_result.h"
 #include "svs/core/recall.h"
 #include "svs/index/vamana/calibrate.h"
+#include "svs/index/vamana/disk_index.h"
+#include "svs/index/vamana/dynamic_search_buffer.h"
 #include "svs/index/vamana/extensions.h"
 #include "svs/index/vamana/greedy_search.h"
+#include "svs/index/vamana/inlined_graph.h"
+#include "svs/index/vamana/labels.h"
+#include "svs/index/vamana/reorder.h"
 #include "svs/index/vamana/search_buffer.h"
 #include "svs/index/vamana/search_params.h"
 #include "svs/index/vamana/vamana_build.h"
@@ -31,10 +37,14 @@
 
 // stl
 #include <algorithm>
+#include <array>
 #include <concepts>
 #include <filesystem>
 #include <fstream>
+#include <span>
 #include <iostream>
+#include <limits>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <tuple>
@@ -52,16 +62,20 @@ struct VamanaIndexParameters {
     VamanaBuildParameters build_parameters;
     // Search Parameters
     VamanaSearchParameters search_parameters;
+    // Entry points used by search in addition to ``entry_point``.
+    std::vector<size_t> additional_entry_points;
 
   public:
     VamanaIndexParameters(
         size_t entry_point_,
         const VamanaBuildParameters& build_parameters_,
-        const VamanaSearchParameters& search_parameters_
+        const VamanaSearchParameters& search_parameters_,
+        std::vector<size_t> additional_entry_points_ = {}
     )
         : entry_point{entry_point_}
         , build_parameters{build_parameters_}
-        , search_parameters{search_parameters_} {}
+        , search_parameters{search_parameters_}
+        , additional_entry_points{std::move(additional_entry_points_)} {}
 
     static constexpr std::string_view legacy_name = "vamana config parameters";
     static constexpr std::string_view name = "vamana index parameters";
@@ -73,9 +87,11 @@ struct VamanaIndexParameters {
     ///     Loading from older versions default this to "graph_max_degree"
     /// v0.0.3 - Refactored to split out build parameters and search parameters into their
     ///     own pieces.
+    /// v0.0.4 - Added the "additional_entry_points" list.
+    ///     Loading from older versions default this to an empty list.
     ///
     ///     Compatible with all previous versions.
-    static constexpr lib::Version save_version = lib::Version(0, 0, 3);
+    static constexpr lib::Version save_version = lib::Version(0, 0, 4);
     static constexpr std::string_view serialization_schema = "vamana_index_parameters";
 
     // Save and Reload.
@@ -86,7 +102,8 @@ struct VamanaIndexParameters {
             {SVS_LIST_SAVE(name),
              SVS_LIST_SAVE(entry_point),
              SVS_LIST_SAVE(build_parameters),
-             SVS_LIST_SAVE(search_parameters)}
+             SVS_LIST_SAVE(search_parameters),
+             SVS_LIST_SAVE(additional_entry_points)}
         );
     }
 
@@ -153,26 +170,113 @@ struct VamanaIndexParameters {
             throw ANNEXCEPTION("Name mismatch! Got {}, expected {}!", this_name, name);
         }
 
+        auto additional_entry_points = std::vector<size_t>();
+        if (version > lib::Version(0, 0, 3)) {
+            additional_entry_points = SVS_LOAD_MEMBER_AT(table, additional_entry_points);
+        }
+
         return VamanaIndexParameters{
             SVS_LOAD_MEMBER_AT(table, entry_point),
             SVS_LOAD_MEMBER_AT(table, build_parameters),
             SVS_LOAD_MEMBER_AT(table, search_parameters),
-        };
+            std::move(additional_entry_points)};
     }
 
     friend bool
     operator==(const VamanaIndexParameters&, const VamanaIndexParameters&) = default;
 };
 
+namespace detail {
+
+// The external ID of each vector of a reordered index, stored in a binary file.
+struct ExternalIDs {
+    std::vector<uint64_t> ids_;
+
+    static constexpr std::string_view serialization_schema = "vamana_external_ids";
+    static constexpr lib::Version save_version = lib::Version(0, 0, 0);
+
+    lib::SaveTable save(const lib::SaveContext& ctx) const {
+        auto filename = ctx.generate_name("external_ids", "binary");
+        auto stream = lib::open_write(filename);
+        lib::write_binary(stream, ids_);
+        return lib::SaveTable(
+            serialization_schema,
+            save_version,
+            {{"num_vectors", lib::save(ids_.size())},
+             {"filename", lib::save(filename.filename())}}
+        );
+    }
+
+    static ExternalIDs load(const lib::LoadTable& table) {
+        auto ids = std::vector<uint64_t>(lib::load_at<size_t>(table, "num_vectors"));
+        // Indexes that were never reordered save an empty file.
+        if (ids.empty()) {
+            return ExternalIDs{};
+        }
+        auto stream = lib::open_read(table.resolve_at("filename"));
+        lib::read_binary(stream, ids);
+        return ExternalIDs{std::move(ids)};
+    }
+};
+
+// Loader for the index metadata saved by `VamanaIndex::save`.
+// Label-aware and reordered indexes and indexes with an inlined graph layout wrap their
+// parameters in a table that also holds their labels, external IDs and inlined graph.
+template <std::integral Idx> struct VamanaConfigLoader {
+    // Version History
+    // - v0.0.0: Initial version with parameters and labels.
+    // - v0.0.1: Add the external ID of each vector for reordered indexes.
+    // - v0.0.2: Add the optional "inlined_graph" entry.
+    static constexpr std::string_view labeled_serialization_schema =
+        "vamana_labeled_index_parameters";
+    static constexpr lib::Version labeled_save_version = lib::Version(0, 0, 2);
+
+    static bool check_load_compatibility(std::string_view schema, lib::Version version) {
+        return VamanaIndexParameters::check_load_compatibility(schema, version) ||
+               (schema == labeled_serialization_schema && version <= labeled_save_version);
+    }
+
+    static VamanaConfigLoader load(const lib::LoadTable& table) {
+        if (table.schema() != labeled_serialization_schema) {
+            return VamanaConfigLoader{
+                lib::load<VamanaIndexParameters>(table), {}, {}, {}, std::nullopt};
+        }
+        auto external_ids = std::vector<uint64_t>();
+        if (table.version() > lib::Version(0, 0, 0)) {
+            external_ids = lib::load_at<ExternalIDs>(table, "external_ids").ids_;
+        }
+        auto inlined_graph = std::optional<InlinedGraph<Idx>>();
+        if (table.version() > lib::Version(0, 0, 1) && table.contains("inlined_graph")) {
+            inlined_graph = lib::load_at<InlinedGraph<Idx>>(table, "inlined_graph");
+        }
+        return VamanaConfigLoader{
+            SVS_LOAD_MEMBER_AT_(table, parameters),
+            lib::load_at<VectorLabels>(table, "labels"),
+            lib::load_at<std::vector<size_t>>(table, "label_entry_points"),
+            std::move(external_ids),
+            std::move(inlined_graph)};
+    }
+
+    ///// Members
+    VamanaIndexParameters parameters_;
+    VectorLabels labels_;
+    std::vector<size_t> label_entry_points_;
+    std::vector<uint64_t> external_ids_;
+    std::optional<InlinedGraph<Idx>> inlined_graph_;
+};
+
+} // namespace detail
+
 ///
 /// @brief Search scratchspace used by the Vamana index.
 ///
 /// These can be pre-allocated and passed to the index when performing externally
 /// threaded searches to reduce allocations.
 ///
-/// **NOTE**: The members ``buffer``, ``scratch``, and ``prefetch_parameters`` are part of
-/// the public API for this class. Users are free to access and manipulate these objects.
-/// However, doing so incorrectly can yield undefined-behavior.
+/// **NOTE**: The members ``buffer``, ``scratch``, ``prefetch_parameters``, and
+/// ``termination_parameters`` are part of the public API for this class. Users are free to
+/// access and manipulate these objects. However, doing so incorrectly can yield
+/// undefined-behavior.
 ///
 /// Acceptable uses are as follows:
 /// * Changing the max capacity of the buffer (search window size).
@@ -186,15 +290,26 @@ template <typename Buffer, typename Scratch> struct SearchScratchspace {
     Buffer buffer;
     Scratch scratch;
     GreedySearchPrefetchParameters prefetch_parameters;
+    // The number of candidates to rerank (zero reranks the whole buffer).
+    size_t rerank_depth = 0;
+    // Early termination conditions. Set ``num_neighbors`` to the number of neighbors that
+    // will be extracted to monitor only those entries instead of the whole search window.
+    GreedySearchTerminationParameters termination_parameters{};
 
   public:
     // Constructors
     SearchScratchspace(
-        Buffer buffer_, Scratch scratch_, GreedySearchPrefetchParameters prefetch_parameters
+        Buffer buffer_,
+        Scratch scratch_,
+        GreedySearchPrefetchParameters prefetch_parameters,
+        size_t rerank_depth = 0,
+        GreedySearchTerminationParameters termination_parameters = {}
     )
         : buffer{std::move(buffer_)}
         , scratch{std::move(scratch_)}
-        , prefetch_parameters{prefetch_parameters} {}
+        , prefetch_parameters{prefetch_parameters}
+        , rerank_depth{rerank_depth}
+        , termination_parameters{termination_parameters} {}
 };
 
 // Construct the default search parameters for this index.
@@ -250,6 +365,8 @@ class VamanaIndex {
     /// Type of the distance functor.
     using distance_type = Dist;
     using search_buffer_type = SearchBuffer<Idx, distance::compare_t<Dist>>;
+    /// Search buffer used by filtered search, which keeps excluded candidates as invalid.
+    using filtered_search_buffer_type = MutableBuffer<Idx, distance::compare_t<Dist>>;
     /// Type of the graph.
     using graph_type = Graph;
     /// Type of the dataset.
@@ -271,6 +388,16 @@ class VamanaIndex {
     lib::ReadWriteProtected<VamanaSearchParameters> default_search_parameters_{};
     // Construction parameters
     VamanaBuildParameters build_parameters_{};
+    // Labels of each vector for label-aware indexes (empty otherwise).
+    VectorLabels labels_{};
+    // The entry point of each label.
+    std::vector<Idx> label_entry_points_{};
+    // Optional graph layout with inlined neighbor codes used by batch search.
+    std::optional<InlinedGraph<Idx>> inlined_graph_{};
+    // The external ID of each internal ID and its inverse (both empty if the IDs
+    // coincide). IDs differ once the index has been reordered.
+    std::vector<Idx> external_ids_{};
+    std::vector<Idx> internal_ids_{};
 
   public:
     /// The type of the search resource used for external threading.
@@ -357,6 +484,40 @@ class VamanaIndex {
         Idx entry_point,
         Dist distance_function,
         threads::NativeThreadPool threadpool
+    )
+        : VamanaIndex{
+              parameters,
+              std::move(graph),
+              std::move(data),
+              entry_point,
+              std::move(distance_function),
+              std::move(threadpool),
+              VectorLabels()} {}
+
+    ///
+    /// @brief Build a label-aware VamanaIndex over the given dataset.
+    ///
+    /// @param labels The labels of each element of ``data``. If empty, a regular index is
+    ///     built.
+    ///
+    /// The remaining arguments are as for the unlabeled constructor.
+    ///
+    /// The graph is constructed following Filtered-Vamana so that the vectors carrying
+    /// each label form a navigable subgraph starting from an entry point selected for the
+    /// label. Label-constrained searches are then confined to that subgraph.
+    ///
+    /// **Preconditions:**
+    ///
+    /// * `labels.empty() || labels.size() == data.size()`.
+    ///
+    VamanaIndex(
+        const VamanaBuildParameters& parameters,
+        Graph graph,
+        Data data,
+        Idx entry_point,
+        Dist distance_function,
+        threads::NativeThreadPool threadpool,
+        VectorLabels labels
     )
         : VamanaIndex{
               std::move(graph),
@@ -369,22 +530,48 @@ class VamanaIndex {
         }
 
         build_parameters_ = parameters;
-        auto builder = VamanaBuilder(
-            graph_,
-            data_,
-            distance_,
-            parameters,
-            threadpool_,
-            extensions::estimate_prefetch_parameters(data_)
-        );
-        builder.construct(1.0F, entry_point_[0]);
-        builder.construct(parameters.alpha, entry_point_[0]);
+        auto construct = [&](auto& builder) {
+            builder.construct(1.0F, entry_point_[0]);
+            builder.construct(parameters.alpha, entry_point_[0]);
+        };
+        auto prefetch_parameters = extensions::estimate_prefetch_parameters(data_);
+        if (labels.empty()) {
+            auto builder = VamanaBuilder(
+                graph_, data_, distance_, parameters, threadpool_, prefetch_parameters
+            );
+            construct(builder);
+        } else {
+            set_labels(std::move(labels), {});
+            auto builder = VamanaBuilder(
+                graph_,
+                data_,
+                distance_,
+                parameters,
+                threadpool_,
+                labels_,
+                label_entry_points_,
+                prefetch_parameters
+            );
+            construct(builder);
+        }
+
+        // Select additional entry points for search.
+        if (parameters.num_entry_points > 1) {
+            for (auto id : extensions::compute_entry_points(
+                     data_, threadpool_, parameters.num_entry_points - 1
+                 )) {
+                add_entry_point(lib::narrow<Idx>(id));
+            }
+        }
     }
 
     /// @brief Apply the given configuration parameters to the index.
     void apply(const VamanaIndexParameters& parameters) {
         entry_point_.clear();
         entry_point_.push_back(parameters.entry_point);
+        for (auto id : parameters.additional_entry_points) {
+            add_entry_point(lib::narrow<Idx>(id));
+        }
 
         build_parameters_ = parameters.build_parameters;
         set_search_parameters(parameters.search_parameters);
@@ -396,10 +583,13 @@ class VamanaIndex {
             search_buffer_type(
                 sp.buffer_config_,
                 distance::comparator(distance_),
-                sp.search_buffer_visited_set_
+                sp.search_buffer_visited_set_,
+                sp.search_buffer_exact_visited_set_
             ),
             extensions::single_search_setup(data_, distance_),
-            {sp.prefetch_lookahead_, sp.prefetch_step_}};
+            {sp.prefetch_lookahead_, sp.prefetch_step_},
+            sp.rerank_depth_,
+            {0, sp.early_termination_patience_, sp.early_termination_ratio_}};
     }
 
     /// @brief Return scratch-space resources for external threading with default parameters
@@ -408,8 +598,11 @@ class VamanaIndex {
     /// ``set_search_parameters``.
     scratchspace_type scratchspace() const { return scratchspace(get_search_parameters()); }
 
-    auto greedy_search_closure(GreedySearchPrefetchParameters prefetch_parameters) const {
-        return [&, prefetch_parameters](
+    auto greedy_search_closure(
+        GreedySearchPrefetchParameters prefetch_parameters,
+        const GreedySearchTerminationParameters& termination_parameters = {}
+    ) const {
+        return [&, prefetch_parameters, termination_parameters](
                    const auto& query, auto& accessor, auto& distance, auto& buffer
                ) {
             greedy_search(
@@ -421,6 +614,110 @@ class VamanaIndex {
                 buffer,
                 entry_point_,
                 NeighborBuilder(),
+                prefetch_parameters,
+                termination_parameters
+            );
+        };
+    }
+
+    auto interleaved_search_closure(
+        GreedySearchPrefetchParameters prefetch_parameters,
+        const GreedySearchTerminationParameters& termination_parameters = {}
+    ) const {
+        return [&, prefetch_parameters, termination_parameters](
+                   auto queries, auto& accessor, auto distances, auto buffers
+               ) {
+            interleaved_greedy_search(
+                graph_,
+                data_,
+                accessor,
+                queries,
+                distances,
+                buffers,
+                entry_point_,
+                NeighborBuilder(),
+                prefetch_parameters,
+                termination_parameters
+            );
+        };
+    }
+
+    auto filtered_search_closure(
+        BitSetView allowed,
+        GreedySearchPrefetchParameters prefetch_parameters,
+        const GreedySearchTerminationParameters& termination_parameters = {}
+    ) const {
+        return [&, allowed, prefetch_parameters, termination_parameters](
+                   const auto& query, auto& accessor, auto& distance, auto& buffer
+               ) {
+            auto search = [&](const auto& builder) {
+                greedy_search(
+                    graph_,
+                    data_,
+                    accessor,
+                    query,
+                    distance,
+                    buffer,
+                    entry_point_,
+                    builder,
+                    prefetch_parameters,
+                    termination_parameters
+                );
+            };
+            // Filters refer to external IDs.
+            if (external_ids_.empty()) {
+                search(PredicateBuilder{allowed});
+            } else {
+                search(PredicateBuilder{[&](Idx i) { return allowed(external_ids_[i]); }});
+            }
+            // Drop the excluded candidates before any reranking.
+            buffer.cleanup();
+        };
+    }
+
+    auto label_search_closure(
+        VectorLabels::label_type label,
+        GreedySearchPrefetchParameters prefetch_parameters,
+        const GreedySearchTerminationParameters& termination_parameters = {}
+    ) const {
+        return [&, label, prefetch_parameters, termination_parameters](
+                   const auto& query, auto& accessor, auto& distance, auto& buffer
+               ) {
+            auto entry_point = std::array<Idx, 1>{label_entry_points_[label]};
+            greedy_search(
+                graph_,
+                data_,
+                accessor,
+                query,
+                distance,
+                buffer,
+                entry_point,
+                SubgraphBuilder{[&](Idx i) { return labels_.has_label(i, label); }},
+                prefetch_parameters,
+                termination_parameters
+            );
+        };
+    }
+
+    auto range_search_closure(
+        float radius,
+        size_t max_capacity,
+        GreedySearchPrefetchParameters prefetch_parameters
+    ) const {
+        return [&, radius, max_capacity, prefetch_parameters](
+                   const auto& query, auto& accessor, auto& distance, auto& buffer
+               ) {
+            range_greedy_search(
+                graph_,
+                data_,
+                accessor,
+                query,
+                distance,
+                buffer,
+                entry_point_,
+                NeighborBuilder(),
+                radius,
+                max_capacity,
                 prefetch_parameters
             );
         };
@@ -435,10 +732,12 @@ class VamanaIndex {
     /// * Search result reranking (if needed).
     ///
     /// Results will be present in the data structures contained inside ``scratch``.
-    /// Extraction should pull out the search buffer for extra post-processing.
+    /// Extraction should pull out the search buffer for extra post-processing. The buffer
+    /// holds internal IDs, see ``translate_internal_id``.
     ///
     /// **Note**: It is the caller's responsibility to ensure that the scratch space has
-    /// been initialized properly to return the requested number of neighbors.
+    /// been initialized properly to return the requested number of neighbors. This
+    /// includes a rerank depth of either zero or at least the number of neighbors.
     ///
     template <typename Query>
     void search(const Query& query, scratchspace_type& scratch) const {
@@ -447,7 +746,10 @@ class VamanaIndex {
             scratch.buffer,
             scratch.scratch,
             query,
-            greedy_search_closure(scratch.prefetch_parameters)
+            greedy_search_closure(
+                scratch.prefetch_parameters, scratch.termination_parameters
+            ),
+            scratch.rerank_depth
         );
     }
 
@@ -486,9 +788,28 @@ class VamanaIndex {
         QueryResultView<I> result,
         const Queries& queries,
         const search_parameters_type& search_parameters
+    ) {
+        search(result, queries, search_parameters, threadpool_);
+    }
+
+    ///
+    /// @brief Fill the result with the nearest neighbors of each query using the given
+    ///     thread pool instead of the index's own.
+    ///
+    /// This allows searches to be issued from within the tasks of a pool supporting
+    /// nested parallelism, such as the ``svs::threads::WorkStealingThreadPool``, or to
+    /// share one pool among several indexes. The remaining arguments are as for the
+    /// overload above.
+    ///
+    template <typename I, data::ImmutableMemoryDataset Queries, threads::ThreadPool Pool>
+    void search(
+        QueryResultView<I> result,
+        const Queries& queries,
+        const search_parameters_type& search_parameters,
+        Pool& threadpool
     ) {
         threads::run(
-            threadpool_,
+            threadpool,
             threads::StaticPartition{queries.size()},
             [&](const auto is, uint64_t SVS_UNUSED(tid)) {
                 // The number of neighbors to store in the result.
@@ -498,11 +819,16 @@ class VamanaIndex {
                 auto search_buffer = search_buffer_type{
                     SearchBufferConfig(search_parameters.buffer_config_),
                     distance::comparator(distance_),
-                    search_parameters.search_buffer_visited_set_};
+                    search_parameters.search_buffer_visited_set_,
+                    search_parameters.search_buffer_exact_visited_set_};
 
                 auto prefetch_parameters = GreedySearchPrefetchParameters{
                     search_parameters.prefetch_lookahead_,
                     search_parameters.prefetch_step_};
+                auto termination_parameters = GreedySearchTerminationParameters{
+                    num_neighbors,
+                    search_parameters.early_termination_patience_,
+                    search_parameters.early_termination_ratio_};
 
                 // Increase the search window size if the defaults are not suitable for the
                 // requested number of neighbors.
@@ -510,6 +836,46 @@ class VamanaIndex {
                     search_buffer.change_maxsize(SearchBufferConfig{num_neighbors});
                 }
 
+                // Search the inlined graph layout if present.
+                if constexpr (supports_inlined_search()) {
+                    if (inlined_graph_) {
+                        inlined_batch_search(
+                            search_buffer, queries, result, threads::UnitRange{is}
+                        );
+                        return;
+                    }
+                }
+
+                // Interleave the graph traversals of multiple queries if requested and
+                // supported by the dataset.
+                if constexpr (extensions::supports_interleaved_search<Data>()) {
+                    size_t interleave =
+                        std::min(search_parameters.interleave_, max_interleaved_queries);
+                    if (interleave > 1) {
+                        auto search_buffers =
+                            std::vector<search_buffer_type>(interleave, search_buffer);
+                        auto distances = std::vector<
+                            decltype(extensions::single_search_setup(data_, distance_))>();
+                        for (size_t i = 0; i < interleave; ++i) {
+                            distances.push_back(
+                                extensions::single_search_setup(data_, distance_)
+                            );
+                        }
+
+                        extensions::interleaved_batch_search(
+                            std::span(search_buffers),
+                            std::span(distances),
+                            queries,
+                            result,
+                            threads::UnitRange{is},
+                            interleaved_search_closure(
+                                prefetch_parameters, termination_parameters
+                            )
+                        );
+                        return;
+                    }
+                }
+
                 // Pre-allocate scratch space needed by the dataset implementation.
                 auto scratch = extensions::per_thread_batch_search_setup(data_, distance_);
 
@@ -521,10 +887,250 @@ class VamanaIndex {
                     queries,
                     result,
                     threads::UnitRange{is},
-                    greedy_search_closure(prefetch_parameters)
+                    greedy_search_closure(prefetch_parameters, termination_parameters),
+                    search_parameters.effective_rerank_depth(num_neighbors)
+                );
+            }
+        );
+        translate_to_external(result, threadpool);
+    }
+
+    ///
+    /// @brief Fill the result with the ``num_neighbors`` nearest neighbors for each query
+    ///     among the vectors allowed by ``filter``.
+    ///
+    /// @param result The result data structure to populate.
+    /// @param queries A dense collection of queries in R^n.
+    /// @param search_parameters The search parameters to use.
+    /// @param filter The allowed vectors, either shared by all queries or given separately
+    ///     for each query. See ``svs::SearchFilter``.
+    ///
+    /// Excluded vectors are still traversed by graph search, so the search continues until
+    /// the search window holds enough allowed candidates. The cost of the search therefore
+    /// grows as the filter becomes more selective. Queries are not interleaved.
+    ///
+    template <typename I, data::ImmutableMemoryDataset Queries>
+    void search(
+        QueryResultView<I> result,
+        const Queries& queries,
+        const search_parameters_type& search_parameters,
+        const SearchFilter& filter
+    ) {
+        filter.check(queries.size());
+        if (filter.empty()) {
+            search(result, queries, search_parameters);
+            return;
+        }
+
+        auto compare = distance::comparator(distance_);
+        threads::run(
+            threadpool_,
+            threads::StaticPartition{queries.size()},
+            [&](const auto is, uint64_t SVS_UNUSED(tid)) {
+                size_t num_neighbors = result.n_neighbors();
+                auto config = SearchBufferConfig(search_parameters.buffer_config_);
+                if (config.get_search_window_size() < num_neighbors) {
+                    config = SearchBufferConfig{num_neighbors};
+                }
+                auto search_buffer = filtered_search_buffer_type{
+                    config,
+                    compare,
+                    search_parameters.search_buffer_visited_set_,
+                    search_parameters.search_buffer_exact_visited_set_};
+                auto scratch = extensions::single_search_setup(data_, distance_);
+
+                auto prefetch_parameters = GreedySearchPrefetchParameters{
+                    search_parameters.prefetch_lookahead_,
+                    search_parameters.prefetch_step_};
+                auto termination_parameters = GreedySearchTerminationParameters{
+                    num_neighbors,
+                    search_parameters.early_termination_patience_,
+                    search_parameters.early_termination_ratio_};
+                auto sentinel = type_traits::sentinel_v<Neighbor<I>, decltype(compare)>;
+
+                for (auto i : is) {
+                    extensions::single_search(
+                        data_,
+                        search_buffer,
+                        scratch,
+                        queries.get_datum(i),
+                        filtered_search_closure(
+                            filter.view(i), prefetch_parameters, termination_parameters
+                        ),
+                        search_parameters.effective_rerank_depth(num_neighbors)
+                    );
+
+                    // Fewer than `num_neighbors` allowed vectors may have been found.
+                    for (size_t j = 0; j < num_neighbors; ++j) {
+                        if (j < search_buffer.size()) {
+                            result.set(search_buffer[j], i, j);
+                        } else {
+                            result.set(sentinel, i, j);
+                        }
+                    }
+                }
+            }
+        );
+        translate_to_external(result);
+    }
+
+    ///
+    /// @brief Fill the result with the ``num_neighbors`` nearest neighbors for each query
+    ///     among the vectors carrying the query's label.
+    ///
+    /// @param result The result data structure to populate.
+    /// @param queries A dense collection of queries in R^n.
+    /// @param search_parameters The search parameters to use.
+    /// @param labels Entry ``i`` is the label of query ``i``.
+    ///
+    /// The index must have been built with labels. Search for each query begins at the
+    /// entry point of its label and only traverses vectors carrying the label, so the cost
+    /// of search does not grow as labels become rarer. If fewer than ``num_neighbors``
+    /// vectors are found, the remaining entries hold the ID
+    /// ``std::numeric_limits<I>::max()`` with the worst possible distance. Queries are not
+    /// interleaved.
+    ///
+    template <typename I, data::ImmutableMemoryDataset Queries>
+    void search(
+        QueryResultView<I> result,
+        const Queries& queries,
+        const search_parameters_type& search_parameters,
+        std::span<const VectorLabels::label_type> labels
+    ) {
+        if (labels_.empty()) {
+            throw ANNEXCEPTION("Label-constrained search requires a labeled index!");
+        }
+        if (labels.size() != queries.size()) {
+            throw ANNEXCEPTION(
+                "Got {} labels for {} queries!", labels.size(), queries.size()
+            );
+        }
+
+        auto compare = distance::comparator(distance_);
+        threads::run(
+            threadpool_,
+            threads::StaticPartition{queries.size()},
+            [&](const auto is, uint64_t SVS_UNUSED(tid)) {
+                size_t num_neighbors = result.n_neighbors();
+                auto search_buffer = search_buffer_type{
+                    SearchBufferConfig(search_parameters.buffer_config_),
+                    compare,
+                    search_parameters.search_buffer_visited_set_,
+                    search_parameters.search_buffer_exact_visited_set_};
+                if (search_buffer.capacity() < num_neighbors) {
+                    search_buffer.change_maxsize(SearchBufferConfig{num_neighbors});
+                }
+                auto scratch = extensions::single_search_setup(data_, distance_);
+
+                auto prefetch_parameters = GreedySearchPrefetchParameters{
+                    search_parameters.prefetch_lookahead_,
+                    search_parameters.prefetch_step_};
+                auto termination_parameters = GreedySearchTerminationParameters{
+                    num_neighbors,
+                    search_parameters.early_termination_patience_,
+                    search_parameters.early_termination_ratio_};
+                auto sentinel = type_traits::sentinel_v<Neighbor<I>, decltype(compare)>;
+
+                for (auto i : is) {
+                    auto label = labels[i];
+                    // Skip the search if no vector carries the label.
+                    size_t found = 0;
+                    if (label < labels_.num_labels() &&
+                        labels_.has_label(label_entry_points_[label], label)) {
+                        extensions::single_search(
+                            data_,
+                            search_buffer,
+                            scratch,
+                            queries.get_datum(i),
+                            label_search_closure(
+                                label, prefetch_parameters, termination_parameters
+                            ),
+                            search_parameters.effective_rerank_depth(num_neighbors)
+                        );
+                        found = search_buffer.size();
+                    }
+
+                    for (size_t j = 0; j < num_neighbors; ++j) {
+                        if (j < found) {
+                            result.set(search_buffer[j], i, j);
+                        } else {
+                            result.set(sentinel, i, j);
+                        }
+                    }
+                }
+            }
+        );
+        translate_to_external(result);
+    }
+
+    ///
+    /// @brief Return the indexed vectors within ``radius`` of each query.
+    ///
+    /// @param queries A dense collection of queries in R^n.
+    /// @param radius The search radius. A vector is returned if its distance to the query
+    ///     is at least as good as ``radius``. For similarity measures like inner product,
+    ///     this means the similarity must be greater than or equal to ``radius``.
+    /// @param search_parameters The search parameters to use.
+    ///
+    /// Graph search begins with a search buffer the size of the configured search window.
+    /// The buffer is grown whenever expanding the next candidate could discard a candidate
+    /// within the radius, so search continues while the frontier is within the radius.
+    /// The results for each query are ordered from nearest to furthest.
+    ///
+    /// Datasets that rerank the results of graph search rerank all candidates in the
+    /// buffer before the radius is applied. Early termination and interleaving are not
+    /// used for range search.
+    ///
+    template <data::ImmutableMemoryDataset Queries>
+    RangeSearchResult<size_t> range_search(
+        const Queries& queries,
+        float radius,
+        const search_parameters_type& search_parameters
+    ) {
+        auto compare = distance::comparator(distance_);
+        auto results = std::vector<std::vector<Neighbor<size_t>>>(queries.size());
+        threads::run(
+            threadpool_,
+            threads::StaticPartition{queries.size()},
+            [&](const auto is, uint64_t SVS_UNUSED(tid)) {
+                auto config = SearchBufferConfig(
+                    search_parameters.buffer_config_.get_search_window_size()
                 );
+                auto search_buffer = search_buffer_type{
+                    config,
+                    compare,
+                    search_parameters.search_buffer_visited_set_,
+                    search_parameters.search_buffer_exact_visited_set_};
+                auto scratch = extensions::single_search_setup(data_, distance_);
+                auto prefetch_parameters = GreedySearchPrefetchParameters{
+                    search_parameters.prefetch_lookahead_,
+                    search_parameters.prefetch_step_};
+                auto closure = range_search_closure(
+                    radius,
+                    std::max(config.get_total_capacity(), size()),
+                    prefetch_parameters
+                );
+
+                for (auto i : is) {
+                    // Undo any growth from the previous query.
+                    search_buffer.change_maxsize(config);
+                    extensions::single_search(
+                        data_, search_buffer, scratch, queries.get_datum(i), closure, 0
+                    );
+
+                    auto& neighbors = results[i];
+                    for (const auto& neighbor : search_buffer) {
+                        if (compare(radius, neighbor.distance())) {
+                            break;
+                        }
+                        neighbors.emplace_back(
+                            translate_internal_id(neighbor.id()), neighbor.distance()
+                        );
+                    }
+                }
             }
         );
+        return RangeSearchResult<size_t>(results);
     }
 
     // TODO (Mark): Make descriptions better.
@@ -586,7 +1192,7 @@ class VamanaIndex {
         auto threaded_function = [&](auto is, uint64_t SVS_UNUSED(tid)) {
             auto accessor = extensions::reconstruct_accessor(data_);
             for (auto i : is) {
-                auto id = ids[i];
+                auto id = translate_external_id(ids[i]);
                 dst.set_datum(i, accessor(data_, id));
             }
         };
@@ -626,6 +1232,299 @@ class VamanaIndex {
     ///
     threads::NativeThreadPool& borrow_threadpool() { return threadpool_; }
 
+    ///// Entry Points
+
+    ///
+    /// @brief Return the entry points used to begin searches.
+    ///
+    /// The first entry point is used for graph construction. Additional entry points are
+    /// selected when building with ``VamanaBuildParameters::num_entry_points`` greater than
+    /// one. Each search starts from the entry points closest to its query that fit in the
+    /// search buffer.
+    ///
+    const entry_point_type& entry_points() const { return entry_point_; }
+
+    ///// Labels
+
+    /// @brief Return the labels of each vector (empty if the index is not label-aware).
+    const VectorLabels& labels() const { return labels_; }
+
+    /// @brief Return the entry point of each label for label-constrained search.
+    const std::vector<Idx>& label_entry_points() const { return label_entry_points_; }
+
+    ///
+    /// @brief Attach labels to the index.
+    ///
+    /// @param labels The labels of each vector.
+    /// @param label_entry_points The entry point of each label. If empty, entry points
+    ///     are selected with ``select_label_entry_points``.
+    ///
+    /// This is used when reloading a label-aware index. The graph should have been built
+    /// with the same labels for label-constrained search to be effective.
+    ///
+    void set_labels(VectorLabels labels, std::vector<Idx> label_entry_points) {
+        if (labels.size() != size()) {
+            throw ANNEXCEPTION(
+                "Expected labels for {} vectors but got {}!", size(), labels.size()
+            );
+        }
+        if (label_entry_points.empty()) {
+            label_entry_points = select_label_entry_points(labels, entry_point_.front());
+        }
+        if (label_entry_points.size() != labels.num_labels()) {
+            throw ANNEXCEPTION(
+                "Expected entry points for {} labels but got {}!",
+                labels.num_labels(),
+                label_entry_points.size()
+            );
+        }
+        for (auto id : label_entry_points) {
+            if (id >= size()) {
+                throw ANNEXCEPTION("Label entry point {} is out of bounds!", id);
+            }
+        }
+        labels_ = std::move(labels);
+        label_entry_points_ = std::move(label_entry_points);
+    }
+
+    ///// Inlined Graph
+
+    ///
+    /// @brief Return whether batch search can use a graph layout with inlined neighbor
+    ///     codes for this dataset and distance.
+    ///
+    /// The inlined layout requires uncompressed data and either the Euclidean or inner
+    /// product distance.
+    ///
+    static constexpr bool supports_inlined_search() {
+        return extensions::supports_interleaved_search<Data>() &&
+               supports_inlined_graph_v<Data, Dist>;
+    }
+
+    ///
+    /// @brief Build the inlined graph layout from the current graph and dataset.
+    ///
+    /// Each vertex record of the inlined layout stores 4-bit codes of its neighbors after
+    /// its adjacency list, so a graph hop estimates all neighbor distances from one
+    /// contiguous read. Once built, batch search without a filter uses the inlined layout,
+    /// fetching full vectors only for neighbors whose estimates can enter the search
+    /// buffer. Interleaving and early termination do not apply to the inlined search.
+    ///
+    /// The layout stores a code of every edge, so it may take considerably more memory than
+    /// the graph itself.
+    ///
+    /// @sa InlinedGraph
+    ///
+    void build_inlined_graph() {
+        if constexpr (supports_inlined_search()) {
+            inlined_graph_ = InlinedGraph<Idx>::build(graph_, data_, threadpool_);
+        } else {
+            throw ANNEXCEPTION(
+                "The inlined graph layout is not supported for this dataset and distance!"
+            );
+        }
+    }
+
+    ///
+    /// @brief Use a previously built inlined graph layout for batch search.
+    ///
+    /// The layout must have been built from the graph and dataset of this index, for
+    /// example by saving the result of ``get_inlined_graph()`` with
+    /// ``svs::lib::save_to_disk`` and loading it with ``svs::lib::load_from_disk``.
+    /// Indexes saved with ``save()`` keep their inlined layout automatically.
+    ///
+    void set_inlined_graph(InlinedGraph<Idx> inlined_graph) {
+        if constexpr (supports_inlined_search()) {
+            if (inlined_graph.n_nodes() != size() ||
+                inlined_graph.max_degree() != graph_.max_degree() ||
+                inlined_graph.codebook().dimensions() != dimensions()) {
+                throw ANNEXCEPTION(
+                    "Inlined graph with {} nodes, maximum degree {} and {} dimensions does "
+                    "not match the index with {} nodes, maximum degree {} and {} "
+                    "dimensions!",
+                    inlined_graph.n_nodes(),
+                    inlined_graph.max_degree(),
+                    inlined_graph.codebook().dimensions(),
+                    size(),
+                    graph_.max_degree(),
+                    dimensions()
+                );
+            }
+            inlined_graph_ = std::move(inlined_graph);
+        } else {
+            throw ANNEXCEPTION(
+                "The inlined graph layout is not supported for this dataset and distance!"
+            );
+        }
+    }
+
+    /// @brief Return whether batch search uses the inlined graph layout.
+    bool has_inlined_graph() const { return inlined_graph_.has_value(); }
+
+    ///
+    /// @brief Return the inlined graph layout.
+    ///
+    /// Throws ``svs::ANNException`` if the layout has not been built or set.
+    ///
+    const InlinedGraph<Idx>& get_inlined_graph() const {
+        if (!inlined_graph_) {
+            throw ANNEXCEPTION("The index has no inlined graph layout!");
+        }
+        return *inlined_graph_;
+    }
+
+    /// @brief Discard the inlined graph layout, returning to regular graph search.
+    void clear_inlined_graph() { inlined_graph_.reset(); }
+
+    ///// Disk Layout
+
+    ///
+    /// @brief Save the graph and dataset for serving from disk with a ``DiskVamanaIndex``.
+    ///
+    /// @param dir The directory to save to. Created if it does not exist.
+    /// @param sector_bytes The sector size of the on-disk layout.
+    ///
+    /// The external IDs of reordered indexes are saved so disk search returns the same IDs.
+    ///
+    /// @sa svs::index::vamana::save_disk_index
+    ///
+    void save_disk_index(
+        const std::filesystem::path& dir,
+        size_t sector_bytes = DiskLayout<Idx>::default_sector_bytes
+    ) {
+        if constexpr (supports_disk_index_v<Data>) {
+            svs::index::vamana::save_disk_index(
+                dir,
+                graph_,
+                data_,
+                lib::as_const_span(entry_point_),
+                lib::as_const_span(external_ids_),
+                threadpool_,
+                sector_bytes
+            );
+        } else {
+            throw ANNEXCEPTION("The disk index layout is not supported for this dataset!");
+        }
+    }
+
+    ///// Reordering
+
+    ///
+    /// @brief Renumber the vectors of the index to improve memory locality during search.
+    ///
+    /// @param ordering The strategy used to compute the new order from the graph.
+    ///
+    /// Vertex IDs initially follow the order of the input dataset, so the neighbors of a
+    /// vertex are scattered across the graph and the dataset. Reordering places vertices
+    /// visited close together during search next to each other and permutes the graph and
+    /// dataset accordingly.
+    ///
+    /// The position of each vector in the graph and dataset becomes its internal ID. The
+    /// index keeps the mapping to the original (external) IDs: search results, filters and
+    /// ``reconstruct_at`` use external IDs. Entry points, labels and the scratchspace
+    /// search buffer use internal IDs.
+    ///
+    /// The dataset is permuted through a temporary copy of the whole dataset. An inlined
+    /// graph layout, if present, is rebuilt.
+    ///
+    /// @sa compute_graph_ordering
+    ///
+    void reorder(GraphOrdering ordering = GraphOrdering::BreadthFirst)
+        requires PermutableData<Data, Idx>
+    {
+        auto new_to_old =
+            compute_graph_ordering(graph_, lib::as_const_span(entry_point_), ordering);
+        reorder(lib::as_const_span(new_to_old));
+    }
+
+    ///
+    /// @brief Move the vector with internal ID ``new_to_old[i]`` to internal ID ``i``.
+    ///
+    /// External IDs are preserved. See ``reorder(GraphOrdering)``.
+    ///
+    void reorder(std::span<const Idx> new_to_old)
+        requires PermutableData<Data, Idx>
+    {
+        const size_t num_nodes = size();
+        auto old_to_new = invert_permutation(new_to_old, num_nodes);
+
+        // Permute the data and graph.
+        data_.compact(new_to_old, threadpool_, num_nodes);
+        auto temp_graph = graphs::SimpleGraph<Idx>(num_nodes, graph_.max_degree());
+        auto range = threads::StaticPartition{num_nodes};
+        threads::run(threadpool_, range, [&](const auto& is, uint64_t SVS_UNUSED(tid)) {
+            auto buffer = std::vector<Idx>();
+            for (auto i : is) {
+                auto list = graph_.get_node(new_to_old[i]);
+                buffer.resize(list.size());
+                std::transform(list.begin(), list.end(), buffer.begin(), [&](Idx id) {
+                    return old_to_new[id];
+                });
+                temp_graph.replace_node(lib::narrow_cast<Idx>(i), buffer);
+            }
+        });
+        threads::run(threadpool_, range, [&](const auto& is, uint64_t SVS_UNUSED(tid)) {
+            for (auto i : is) {
+                auto id = lib::narrow_cast<Idx>(i);
+                graph_.replace_node(id, temp_graph.get_node(id));
+            }
+        });
+
+        // Remap the remaining state.
+        for (auto& id : entry_point_) {
+            id = old_to_new[id];
+        }
+        if (!labels_.empty()) {
+            labels_ = labels_.permute(new_to_old);
+            for (auto& id : label_entry_points_) {
+                id = old_to_new[id];
+            }
+        }
+        auto external_ids = std::vector<Idx>(num_nodes);
+        for (size_t i = 0; i < num_nodes; ++i) {
+            external_ids[i] = external_ids_.empty() ? new_to_old[i]
+                                                    : external_ids_[new_to_old[i]];
+        }
+        set_external_ids(std::move(external_ids));
+        if (inlined_graph_) {
+            build_inlined_graph();
+        }
+    }
+
+    ///
+    /// @brief Return the external ID of each internal ID.
+    ///
+    /// Empty if the index has not been reordered, in which case the IDs coincide.
+    ///
+    const std::vector<Idx>& external_ids() const { return external_ids_; }
+
+    ///
+    /// @brief Set the external ID of each internal ID.
+    ///
+    /// This is used when reloading a reordered index. An empty vector restores the
+    /// identity mapping. Otherwise, ``external_ids`` must be a permutation of the IDs
+    /// ``[0, size())``.
+    ///
+    void set_external_ids(std::vector<Idx> external_ids) {
+        if (external_ids.empty()) {
+            external_ids_.clear();
+            internal_ids_.clear();
+            return;
+        }
+        internal_ids_ = invert_permutation(lib::as_const_span(external_ids), size());
+        external_ids_ = std::move(external_ids);
+    }
+
+    /// @brief Return the external ID of the vector with internal ID ``i``.
+    size_t translate_internal_id(Idx i) const {
+        return external_ids_.empty() ? i : external_ids_[i];
+    }
+
+    /// @brief Return the internal ID of the vector with external ID ``e``.
+    Idx translate_external_id(size_t e) const {
+        return internal_ids_.empty() ? lib::narrow_cast<Idx>(e) : internal_ids_[e];
+    }
+
     ///// Search Parameter Setting
 
     ///
@@ -716,6 +1615,11 @@ class VamanaIndex {
     /// designed to be orthogonal to allow mixing and matching of different types upon
     /// reloading.
     ///
+    /// The labels and label entry points of label-aware indexes, the external IDs of
+    /// reordered indexes and the inlined graph layout, if built, are saved alongside the
+    /// index metadata in ``config_directory``.
+    /// The graph and data are saved in internal ID order.
+    ///
     void save(
         const std::filesystem::path& config_directory,
         const std::filesystem::path& graph_directory,
@@ -723,10 +1627,43 @@ class VamanaIndex {
     ) const {
         // Construct and save runtime parameters.
         auto parameters = VamanaIndexParameters{
-            entry_point_.front(), build_parameters_, get_search_parameters()};
+            entry_point_.front(),
+            build_parameters_,
+            get_search_parameters(),
+            std::vector<size_t>(entry_point_.begin() + 1, entry_point_.end())};
 
         // Config
-        lib::save_to_disk(parameters, config_directory);
+        if (labels_.empty() && external_ids_.empty() && !inlined_graph_) {
+            lib::save_to_disk(parameters, config_directory);
+        } else {
+            using loader_type = detail::VamanaConfigLoader<Idx>;
+            lib::save_to_disk(
+                lib::SaveOverride([&](const lib::SaveContext& ctx) {
+                    auto table = lib::SaveTable(
+                        loader_type::labeled_serialization_schema,
+                        loader_type::labeled_save_version,
+                        {{"parameters", lib::save(parameters, ctx)},
+                         {"labels", lib::save(labels_, ctx)},
+                         {"label_entry_points",
+                          lib::save(std::vector<size_t>(
+                              label_entry_points_.begin(), label_entry_points_.end()
+                          ))},
+                         {"external_ids",
+                          lib::save(
+                              detail::ExternalIDs{std::vector<uint64_t>(
+                                  external_ids_.begin(), external_ids_.end()
+                              )},
+                              ctx
+                          )}}
+                    );
+                    if (inlined_graph_) {
+                        table.insert("inlined_graph", lib::save(*inlined_graph_, ctx));
+                    }
+                    return table;
+                }),
+                config_directory
+            );
+        }
         // Data
         lib::save_to_disk(data_, data_directory);
         // Graph
@@ -777,6 +1714,93 @@ class VamanaIndex {
         set_search_parameters(p);
         return p;
     }
+
+  private:
+    void add_entry_point(Idx id) {
+        if (std::find(entry_point_.begin(), entry_point_.end(), id) == entry_point_.end()) {
+            entry_point_.push_back(id);
+        }
+    }
+
+    // Return the inverse of the permutation `ids` of `[0, size)`.
+    static std::vector<Idx> invert_permutation(std::span<const Idx> ids, size_t size) {
+        if (ids.size() != size) {
+            throw ANNEXCEPTION(
+                "Permutation has {} entries for {} vectors!", ids.size(), size
+            );
+        }
+        constexpr Idx missing = std::numeric_limits<Idx>::max();
+        auto inverse = std::vector<Idx>(size, missing);
+        for (size_t i = 0; i < size; ++i) {
+            auto id = ids[i];
+            if (static_cast<size_t>(id) >= size || inverse[id] != missing) {
+                throw ANNEXCEPTION("Entry {} with value {} breaks the permutation!", i, id);
+            }
+            inverse[id] = lib::narrow_cast<Idx>(i);
+        }
+        return inverse;
+    }
+
+    // Replace the internal IDs in `result` with external IDs.
+    // Entries not referring to a vector (such as padding of filtered search) are unchanged.
+    template <typename I> void translate_to_external(QueryResultView<I> result) {
+        translate_to_external(result, threadpool_);
+    }
+
+    template <typename I, threads::ThreadPool Pool>
+    void translate_to_external(QueryResultView<I> result, Pool& threadpool) {
+        if (external_ids_.empty()) {
+            return;
+        }
+        threads::run(
+            threadpool,
+            threads::StaticPartition{result.n_queries()},
+            [&](const auto is, uint64_t SVS_UNUSED(tid)) {
+                for (auto i : is) {
+                    for (size_t j = 0, jmax = result.n_neighbors(); j < jmax; ++j) {
+                        auto& id = result.index(i, j);
+                        if (static_cast<size_t>(id) < external_ids_.size()) {
+                            id = lib::narrow_cast<I>(external_ids_[id]);
+                        }
+                    }
+                }
+            }
+        );
+    }
+
+    // Search the queries at `indices` over the inlined graph layout.
+    template <typename Queries, typename I>
+    void inlined_batch_search(
+        search_buffer_type& search_buffer,
+        const Queries& queries,
+        QueryResultView<I>& result,
+        threads::UnitRange<size_t> indices
+    ) const {
+        const auto& inlined_graph = *inlined_graph_;
+        auto distance = extensions::single_search_setup(data_, distance_);
+        auto accessor = data::GetDatumAccessor();
+        auto table = NeighborCodeTable<Dist>();
+        auto candidates = std::vector<Idx>();
+        candidates.reserve(inlined_graph.max_degree());
+        for (auto i : indices) {
+            auto query = queries.get_datum(i);
+            table.fix(inlined_graph.codebook(), query);
+            inlined_greedy_search(
+                inlined_graph,
+                data_,
+                accessor,
+                query,
+                distance,
+                table,
+                search_buffer,
+                entry_point_,
+                candidates
+            );
+            for (size_t j = 0, jmax = result.n_neighbors(); j < jmax; ++j) {
+                result.set(search_buffer[j], i, j);
+            }
+        }
+    }
 };
 
 // Shared documentation for assembly methods.
@@ -820,6 +1844,50 @@ auto auto_build(
         std::move(threadpool)};
 }
 
+///
+/// @brief Entry point for building a label-aware Vamana graph-index.
+///
+/// @param parameters The parameters to use for graph construction.
+/// @param data_proto A dispatch loadable class yielding a dataset.
+/// @param distance The distance **functor** to use to compare queries with elements of
+///     the dataset.
+/// @param threadpool_proto Precursor for the thread pool to use. Can either be a
+///     threadpool instance of an integer specifying the number of threads to use.
+/// @param labels The labels of each element of the dataset.
+/// @param graph_allocator The allocator to use for the graph data structure.
+///
+/// The resulting index supports search constrained to the vectors carrying a label.
+///
+template <
+    typename DataProto,
+    typename Distance,
+    typename ThreadpoolProto,
+    typename Allocator = HugepageAllocator<uint32_t>>
+auto auto_build(
+    const VamanaBuildParameters& parameters,
+    DataProto data_proto,
+    Distance distance,
+    ThreadpoolProto threadpool_proto,
+    VectorLabels labels,
+    const Allocator& graph_allocator = {}
+) {
+    auto threadpool = threads::as_threadpool(std::move(threadpool_proto));
+    auto data = svs::detail::dispatch_load(std::move(data_proto), threadpool);
+    auto entry_point = extensions::compute_entry_point(data, threadpool);
+
+    // Default graph.
+    auto graph = default_graph(data.size(), parameters.graph_max_degree, graph_allocator);
+    using I = typename decltype(graph)::index_type;
+    return VamanaIndex{
+        parameters,
+        std::move(graph),
+        std::move(data),
+        lib::narrow<I>(entry_point),
+        std::move(distance),
+        std::move(threadpool),
+        std::move(labels)};
+}
+
 ///
 /// @brief Entry point for loading a Vamana graph-index from disk.
 ///
@@ -858,8 +1926,29 @@ auto auto_assemble(
     auto index = VamanaIndex{
         std::move(graph), std::move(data), I{}, std::move(distance), std::move(threadpool)};
 
-    auto config = lib::load_from_disk<VamanaIndexParameters>(config_path);
-    index.apply(config);
+    auto config = lib::load_from_disk<detail::VamanaConfigLoader<I>>(config_path);
+    index.apply(config.parameters_);
+    if (!config.labels_.empty()) {
+        auto label_entry_points = std::vector<I>();
+        for (auto id : config.label_entry_points_) {
+            label_entry_points.push_back(lib::narrow<I>(id));
+        }
+        index.set_labels(std::move(config.labels_), std::move(label_entry_points));
+    }
+    if (!config.external_ids_.empty()) {
+        auto external_ids = std::vector<I>();
+        for (auto id : config.external_ids_) {
+            external_ids.push_back(lib::narrow<I>(id));
+        }
+        index.set_external_ids(std::move(external_ids));
+    }
+    // The inlined layout only accelerates search, so it is dropped when the index is
+    // assembled with a dataset or distance that cannot use it.
+    if constexpr (decltype(index)::supports_inlined_search()) {
+        if (config.inlined_graph_) {
+            index.set_inlined_graph(std::move(*config.inlined_graph_));
+        }
+    }
     return index;
 }
 } // namespace svs::index::vamana
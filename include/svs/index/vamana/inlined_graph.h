@@ -0,0 +1,508 @@
+/**
+ *    Copyright (C) 2023, Intel Corporation
+ *
+ *    You can redistribute and/or modify this software under the terms of the
+ *    GNU Affero General Public License version 3.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    version 3 along with this software. If not, see
+ *    <https://www.gnu.org/licenses/agpl-3.0.en.html>.
+ */
+
+#pragma once
+
+// svs
+#include "svs/core/data.h"
+#include "svs/core/distance.h"
+#include "svs/core/graph.h"
+#include "svs/index/vamana/greedy_search.h"
+#include "svs/lib/exception.h"
+#include "svs/lib/file.h"
+#include "svs/lib/misc.h"
+#include "svs/lib/narrow.h"
+#include "svs/lib/prefetch.h"
+#include "svs/lib/readwrite.h"
+#include "svs/lib/saveload.h"
+#include "svs/lib/threads.h"
+
+// stl
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace svs::index::vamana {
+
+///
+/// @brief Per-dimension 4-bit scalar quantizer for the neighbor codes of an
+///     ``InlinedGraph``.
+///
+/// Each dimension is quantized uniformly to 16 levels spanning the range of that dimension
+/// over the training dataset. Two dimensions are packed per byte, the even dimension in the
+/// low nibble.
+///
+class NeighborCodebook {
+  public:
+    /// The number of quantization levels per dimension.
+    static constexpr size_t levels = 16;
+
+    /// @brief Construct an empty codebook for zero dimensions.
+    NeighborCodebook() = default;
+
+    ///
+    /// @brief Construct a codebook from the per-dimension offsets and steps.
+    ///
+    /// Dimension ``d`` with code ``c`` is decoded as ``min[d] + c * step[d]``.
+    ///
+    NeighborCodebook(std::vector<float> min, std::vector<float> step)
+        : min_{std::move(min)}
+        , step_{std::move(step)} {
+        if (min_.size() != step_.size()) {
+            throw ANNEXCEPTION(
+                "Codebook offsets and steps have different sizes ({} and {})!",
+                min_.size(),
+                step_.size()
+            );
+        }
+    }
+
+    ///
+    /// @brief Train a codebook spanning the range of each dimension of ``data``.
+    ///
+    template <data::ImmutableMemoryDataset Data, threads::ThreadPool Pool>
+    static NeighborCodebook train(const Data& data, Pool& threadpool) {
+        const size_t dims = data.dimensions();
+        constexpr float inf = std::numeric_limits<float>::infinity();
+        auto mins = std::vector<std::vector<float>>(threadpool.size());
+        auto maxs = std::vector<std::vector<float>>(threadpool.size());
+        threads::run(
+            threadpool,
+            threads::StaticPartition{data.size()},
+            [&](const auto& is, uint64_t tid) {
+                auto& lo = mins.at(tid);
+                auto& hi = maxs.at(tid);
+                lo.assign(dims, inf);
+                hi.assign(dims, -inf);
+                for (auto i : is) {
+                    auto datum = data.get_datum(i);
+                    for (size_t d = 0; d < dims; ++d) {
+                        auto x = static_cast<float>(datum[d]);
+                        lo[d] = std::min(lo[d], x);
+                        hi[d] = std::max(hi[d], x);
+                    }
+                }
+            }
+        );
+
+        auto min = std::vector<float>(dims, inf);
+        auto step = std::vector<float>(dims, 0);
+        for (size_t d = 0; d < dims; ++d) {
+            float max = -inf;
+            for (size_t t = 0; t < mins.size(); ++t) {
+                if (!mins[t].empty()) {
+                    min[d] = std::min(min[d], mins[t][d]);
+                    max = std::max(max, maxs[t][d]);
+                }
+            }
+            if (max < min[d]) {
+                // Empty dataset.
+                min[d] = 0;
+            } else {
+                step[d] = (max - min[d]) / static_cast<float>(levels - 1);
+            }
+        }
+        return NeighborCodebook(std::move(min), std::move(step));
+    }
+
+    /// @brief Return the number of dimensions encoded by the codebook.
+    size_t dimensions() const { return min_.size(); }
+    /// @brief Return the number of bytes occupied by the code of one vector.
+    size_t code_bytes() const { return lib::div_round_up(dimensions(), 2); }
+
+    /// @brief Return the value of dimension ``d`` with code ``code``.
+    float decode(size_t d, uint8_t code) const {
+        return min_[d] + step_[d] * static_cast<float>(code);
+    }
+
+    /// @brief Write the ``code_bytes()`` byte code of ``datum`` to ``dst``.
+    template <typename T> void encode(std::span<const T> datum, uint8_t* dst) const {
+        std::memset(dst, 0, code_bytes());
+        for (size_t d = 0, dims = dimensions(); d < dims; ++d) {
+            uint8_t code = 0;
+            if (step_[d] > 0) {
+                float scaled = (static_cast<float>(datum[d]) - min_[d]) / step_[d];
+                code = static_cast<uint8_t>(
+                    std::clamp(std::round(scaled), 0.0F, static_cast<float>(levels - 1))
+                );
+            }
+            dst[d / 2] |= static_cast<uint8_t>(code << (4 * (d % 2)));
+        }
+    }
+
+    friend bool operator==(const NeighborCodebook&, const NeighborCodebook&) = default;
+
+    ///// Saving and Loading
+    static constexpr std::string_view serialization_schema = "vamana_neighbor_codebook";
+    static constexpr lib::Version save_version = lib::Version(0, 0, 0);
+
+    lib::SaveTable save() const {
+        return lib::SaveTable(
+            serialization_schema,
+            save_version,
+            {{"min", lib::save(min_)}, {"step", lib::save(step_)}}
+        );
+    }
+
+    static NeighborCodebook load(const lib::ContextFreeLoadTable& table) {
+        return NeighborCodebook(
+            lib::load_at<std::vector<float>>(table, "min"),
+            lib::load_at<std::vector<float>>(table, "step")
+        );
+    }
+
+  private:
+    std::vector<float> min_{};
+    std::vector<float> step_{};
+};
+
+///
+/// @brief Return whether an ``InlinedGraph`` can estimate distances for the dataset and
+///     distance functor.
+///
+/// Neighbor codes are estimated with per-query lookup tables, which are exact sums over
+/// dimensions only for the Euclidean and inner product distances.
+///
+template <typename Data, typename Dist>
+inline constexpr bool supports_inlined_graph_v =
+    (std::is_same_v<Dist, distance::DistanceL2> ||
+     std::is_same_v<Dist, distance::DistanceIP>) &&
+    requires(const Data& data) { static_cast<float>(data.get_datum(0)[0]); };
+
+///
+/// @brief Per-query lookup table estimating distances to vectors encoded by a
+///     ``NeighborCodebook``.
+///
+template <typename Dist> class NeighborCodeTable {
+  public:
+    static_assert(
+        std::is_same_v<Dist, distance::DistanceL2> ||
+            std::is_same_v<Dist, distance::DistanceIP>,
+        "Unsupported distance for neighbor code estimation!"
+    );
+
+    /// @brief Populate the table for ``query``.
+    template <typename Query>
+    void fix(const NeighborCodebook& codebook, const Query& query) {
+        constexpr size_t levels = NeighborCodebook::levels;
+        const size_t dims = codebook.dimensions();
+        // Odd dimensionalities encode a zero high nibble in the last byte.
+        table_.assign(2 * codebook.code_bytes() * levels, 0);
+        for (size_t d = 0; d < dims; ++d) {
+            auto q = static_cast<float>(query[d]);
+            for (size_t c = 0; c < levels; ++c) {
+                float v = codebook.decode(d, lib::narrow_cast<uint8_t>(c));
+                if constexpr (std::is_same_v<Dist, distance::DistanceL2>) {
+                    table_[d * levels + c] = (q - v) * (q - v);
+                } else {
+                    table_[d * levels + c] = q * v;
+                }
+            }
+        }
+    }
+
+    /// @brief Return the estimated distance to the vector with code ``codes``.
+    float operator()(const uint8_t* codes) const {
+        constexpr size_t levels = NeighborCodebook::levels;
+        const float* table = table_.data();
+        float sum = 0;
+        for (size_t b = 0, bmax = table_.size() / (2 * levels); b < bmax; ++b) {
+            uint8_t code = codes[b];
+            sum += table[code & 0xF] + table[levels + (code >> 4)];
+            table += 2 * levels;
+        }
+        return sum;
+    }
+
+  private:
+    std::vector<float> table_{};
+};
+
+///
+/// @brief Static graph storing compact codes of each vertex's neighbors alongside its
+///     adjacency list.
+///
+/// Each vertex is stored as a cache-line aligned record laid out as
+/// @code{}
+/// [degree][neighbor 0]...[neighbor R - 1][code of neighbor 0]...[code of neighbor R - 1]
+/// @endcode
+/// where ``R`` is the maximum degree. Expanding a vertex during search estimates the
+/// distances to all its neighbors from this single contiguous record. Only neighbors whose
+/// estimates could enter the search buffer have their full vectors fetched.
+///
+/// The layout trades memory for locality: each neighbor code is duplicated in every
+/// adjacency list containing it.
+///
+template <std::integral Idx> class InlinedGraph {
+  public:
+    using index_type = Idx;
+    using reference = std::span<const Idx>;
+    using const_reference = std::span<const Idx>;
+
+    /// @brief Construct an empty graph.
+    InlinedGraph() = default;
+
+    ///
+    /// @brief Construct a graph with ``num_nodes`` vertices, all without neighbors.
+    ///
+    /// @param num_nodes The number of vertices.
+    /// @param max_degree The largest number of neighbors of any vertex.
+    /// @param codebook The quantizer used to encode neighbors.
+    ///
+    InlinedGraph(size_t num_nodes, size_t max_degree, NeighborCodebook codebook)
+        : num_nodes_{num_nodes}
+        , max_degree_{max_degree}
+        , codebook_{std::move(codebook)}
+        , codes_offset_{(max_degree + 1) * sizeof(Idx)}
+        , record_bytes_{lib::round_up_to_multiple_of(
+              codes_offset_ + max_degree * codebook_.code_bytes(), lib::CACHELINE_BYTES
+          )}
+        , storage_(num_nodes * record_bytes_, std::byte{0}) {}
+
+    ///
+    /// @brief Build the inlined layout of ``graph`` with neighbor codes from ``data``.
+    ///
+    template <
+        graphs::ImmutableMemoryGraph Graph,
+        data::ImmutableMemoryDataset Data,
+        threads::ThreadPool Pool>
+    static InlinedGraph build(const Graph& graph, const Data& data, Pool& threadpool) {
+        if (graph.n_nodes() != data.size()) {
+            throw ANNEXCEPTION(
+                "Graph has {} nodes but the dataset has {} elements!",
+                graph.n_nodes(),
+                data.size()
+            );
+        }
+        auto result = InlinedGraph(
+            graph.n_nodes(), graph.max_degree(), NeighborCodebook::train(data, threadpool)
+        );
+        threads::run(
+            threadpool,
+            threads::StaticPartition{graph.n_nodes()},
+            [&](const auto& is, uint64_t SVS_UNUSED(tid)) {
+                for (auto i : is) {
+                    result.set_node(lib::narrow<Idx>(i), graph.get_node(i), data);
+                }
+            }
+        );
+        return result;
+    }
+
+    /// @brief Return the number of vertices.
+    size_t n_nodes() const { return num_nodes_; }
+    /// @brief Return the largest number of neighbors of any vertex.
+    size_t max_degree() const { return max_degree_; }
+    /// @brief Return the quantizer used to encode neighbors.
+    const NeighborCodebook& codebook() const { return codebook_; }
+    /// @brief Return the number of bytes occupied by each vertex record.
+    size_t record_bytes() const { return record_bytes_; }
+
+    /// @brief Return the neighbors of vertex ``i``.
+    const_reference get_node(Idx i) const {
+        const Idx* p = header(i);
+        return const_reference{p + 1, p[0]};
+    }
+
+    /// @brief Return the number of neighbors of vertex ``i``.
+    size_t get_node_degree(Idx i) const { return header(i)[0]; }
+
+    ///
+    /// @brief Return the codes of the neighbors of vertex ``i``.
+    ///
+    /// The code of neighbor ``j`` begins at byte ``j * codebook().code_bytes()``.
+    ///
+    const uint8_t* get_codes(Idx i) const {
+        return reinterpret_cast<const uint8_t*>(record(i) + codes_offset_);
+    }
+
+    /// @brief Prefetch the adjacency list and neighbor codes of vertex ``i``.
+    void prefetch_node(Idx i) const {
+        lib::prefetch_l0(std::span<const std::byte>(
+            record(i), codes_offset_ + max_degree_ * codebook_.code_bytes()
+        ));
+    }
+
+    ///
+    /// @brief Set the neighbors of vertex ``i`` and encode them from ``data``.
+    ///
+    template <data::ImmutableMemoryDataset Data>
+    void set_node(Idx i, std::span<const Idx> neighbors, const Data& data) {
+        if (neighbors.size() > max_degree_) {
+            throw ANNEXCEPTION(
+                "Vertex {} has {} neighbors which exceeds the maximum degree {}!",
+                i,
+                neighbors.size(),
+                max_degree_
+            );
+        }
+        auto* p = reinterpret_cast<Idx*>(record(i));
+        p[0] = lib::narrow<Idx>(neighbors.size());
+        std::copy(neighbors.begin(), neighbors.end(), p + 1);
+        auto* codes = reinterpret_cast<uint8_t*>(record(i) + codes_offset_);
+        const size_t bytes = codebook_.code_bytes();
+        for (size_t j = 0; j < neighbors.size(); ++j) {
+            codebook_.encode(
+                std::span<const typename Data::element_type>(data.get_datum(neighbors[j])),
+                codes + j * bytes
+            );
+        }
+    }
+
+    ///// Saving and Loading
+    static constexpr std::string_view serialization_schema = "vamana_inlined_graph";
+    static constexpr lib::Version save_version = lib::Version(0, 0, 0);
+
+    lib::SaveTable save(const lib::SaveContext& ctx) const {
+        auto filename = ctx.generate_name("inlined_graph", "binary");
+        auto stream = lib::open_write(filename);
+        lib::write_binary(stream, storage_);
+        return lib::SaveTable(
+            serialization_schema,
+            save_version,
+            {{"num_nodes", lib::save(num_nodes_)},
+             {"max_degree", lib::save(max_degree_)},
+             {"index_type", lib::save(datatype_v<Idx>)},
+             {"codebook", lib::save(codebook_)},
+             {"filename", lib::save(filename.filename())}}
+        );
+    }
+
+    static InlinedGraph load(const lib::LoadTable& table) {
+        auto index_type = lib::load_at<DataType>(table, "index_type");
+        if (index_type != datatype_v<Idx>) {
+            throw ANNEXCEPTION(
+                "Trying to load an inlined graph with index type {} as {}!",
+                index_type,
+                datatype_v<Idx>
+            );
+        }
+        auto result = InlinedGraph(
+            lib::load_at<size_t>(table, "num_nodes"),
+            lib::load_at<size_t>(table, "max_degree"),
+            lib::load_at<NeighborCodebook>(table, "codebook")
+        );
+        auto stream = lib::open_read(table.resolve_at("filename"));
+        lib::read_binary(stream, result.storage_);
+        for (size_t i = 0; i < result.num_nodes_; ++i) {
+            if (result.get_node_degree(lib::narrow_cast<Idx>(i)) > result.max_degree_) {
+                throw ANNEXCEPTION("Corrupted inlined graph record {}!", i);
+            }
+        }
+        return result;
+    }
+
+  private:
+    const std::byte* record(Idx i) const { return storage_.data() + i * record_bytes_; }
+    std::byte* record(Idx i) { return storage_.data() + i * record_bytes_; }
+    const Idx* header(Idx i) const { return reinterpret_cast<const Idx*>(record(i)); }
+
+    size_t num_nodes_ = 0;
+    size_t max_degree_ = 0;
+    NeighborCodebook codebook_{};
+    size_t codes_offset_ = 0;
+    size_t record_bytes_ = 0;
+    std::vector<std::byte, threads::CacheAlignedAllocator<std::byte>> storage_{};
+};
+
+///
+/// @brief Run greedy search over an ``InlinedGraph``, estimating neighbor distances from
+///     the inlined codes.
+///
+/// @param graph The graph to search.
+/// @param dataset The dataset being searched.
+/// @param accessor Accessor for the elements of ``dataset``.
+/// @param query The query.
+/// @param distance_function The distance functor for the query.
+/// @param table The lookup table for the query, populated by ``NeighborCodeTable::fix``.
+/// @param search_buffer The search buffer.
+/// @param entry_points The entry points for the search.
+/// @param candidates Scratch space for the neighbors kept after filtering. Reusing it
+///     across queries avoids an allocation per query.
+///
+/// When a vertex is expanded, the estimated distance to each unvisited neighbor is computed
+/// from the codes stored with the adjacency list. Neighbors whose estimates would not
+/// enter the full search buffer are discarded. The full vectors of the remaining neighbors
+/// are prefetched together and their exact distances are inserted into the buffer.
+///
+/// Since estimates may exceed the true distances, some true neighbors can be discarded.
+/// Results therefore approximate those of ``greedy_search`` with the same buffer.
+///
+template <
+    std::integral Idx,
+    data::ImmutableMemoryDataset Dataset,
+    data::AccessorFor<Dataset> Accessor,
+    typename QueryType,
+    typename Dist,
+    typename Table,
+    typename Buffer,
+    typename Ep>
+void inlined_greedy_search(
+    const InlinedGraph<Idx>& graph,
+    const Dataset& dataset,
+    Accessor& accessor,
+    const QueryType& query,
+    Dist& distance_function,
+    const Table& table,
+    Buffer& search_buffer,
+    const Ep& entry_points,
+    std::vector<Idx>& candidates
+) {
+    auto builder = NeighborBuilder();
+    auto tracker = NullTracker();
+    detail::initialize_search(
+        graph,
+        dataset,
+        accessor,
+        query,
+        distance_function,
+        search_buffer,
+        entry_points,
+        builder,
+        tracker
+    );
+
+    const size_t code_bytes = graph.codebook().code_bytes();
+    while (!search_buffer.done()) {
+        auto node_id = search_buffer.next().id();
+        auto neighbors = graph.get_node(node_id);
+        const uint8_t* codes = graph.get_codes(node_id);
+
+        // Filter neighbors on their estimated distances and prefetch the survivors.
+        candidates.clear();
+        for (size_t j = 0, jmax = neighbors.size(); j < jmax; ++j) {
+            auto id = neighbors[j];
+            if (search_buffer.emplace_visited(id)) {
+                continue;
+            }
+            if (search_buffer.can_skip(table(codes + j * code_bytes))) {
+                continue;
+            }
+            accessor.prefetch(dataset, id);
+            candidates.push_back(id);
+        }
+
+        for (auto id : candidates) {
+            auto dist = distance::compute(distance_function, query, accessor(dataset, id));
+            search_buffer.insert(builder(id, dist));
+        }
+    }
+}
+
+} // namespace svs::index::vamana
@@ -0,0 +1,273 @@
+/**
+ *    Copyright (C) 2023, Intel Corporation
+ *
+ *    You can redistribute and/or modify this software under the terms of the
+ *    GNU Affero General Public License version 3.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    version 3 along with this software. If not, see
+ *    <https://www.gnu.org/licenses/agpl-3.0.en.html>.
+ */
+
+#pragma once
+
+// svs
+#include "svs/lib/exception.h"
+#include "svs/lib/file.h"
+#include "svs/lib/misc.h"
+#include "svs/lib/narrow.h"
+#include "svs/lib/readwrite.h"
+#include "svs/lib/saveload.h"
+
+// stl
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace svs::index::vamana {
+
+///
+/// @brief The set of labels attached to each vector of a dataset.
+///
+/// Labels are small integers (for example, tenant or category IDs). Each vector may carry
+/// any number of labels, including none. The labels of all vectors are stored contiguously
+/// and the labels of each vector are kept sorted.
+///
+/// When given to graph construction, search for a vector is confined to the vectors that
+/// share at least one of its labels and pruning keeps the edges needed to navigate the
+/// subgraph induced by each label. Vectors without labels are indexed as usual.
+///
+class VectorLabels {
+  public:
+    using label_type = uint32_t;
+
+    /// @brief Construct an empty label set covering no vectors.
+    VectorLabels() = default;
+
+    ///
+    /// @brief Construct from the labels of each vector.
+    ///
+    /// @param labels Entry ``i`` contains the labels of vector ``i``. Duplicate labels are
+    ///     ignored and labels need not be sorted.
+    ///
+    explicit VectorLabels(const std::vector<std::vector<label_type>>& labels)
+        : offsets_(labels.size() + 1, 0) {
+        for (size_t i = 0, imax = labels.size(); i < imax; ++i) {
+            auto start = labels_.size();
+            labels_.insert(labels_.end(), labels[i].begin(), labels[i].end());
+            auto begin = labels_.begin() + lib::narrow_cast<ptrdiff_t>(start);
+            std::sort(begin, labels_.end());
+            labels_.erase(std::unique(begin, labels_.end()), labels_.end());
+            offsets_[i + 1] = labels_.size();
+        }
+        if (!labels_.empty()) {
+            num_labels_ = size_t{*std::max_element(labels_.begin(), labels_.end())} + 1;
+        }
+    }
+
+    /// @brief Return the number of vectors covered by the label set.
+    size_t size() const { return offsets_.empty() ? 0 : offsets_.size() - 1; }
+    /// @brief Return whether the label set covers no vectors.
+    bool empty() const { return size() == 0; }
+    /// @brief Return one past the largest label carried by any vector.
+    size_t num_labels() const { return num_labels_; }
+
+    /// @brief Return the sorted labels of vector ``i``.
+    std::span<const label_type> labels(size_t i) const {
+        return {labels_.data() + offsets_[i], labels_.data() + offsets_[i + 1]};
+    }
+
+    /// @brief Return whether vector ``i`` carries ``label``.
+    bool has_label(size_t i, label_type label) const {
+        auto these = labels(i);
+        return std::binary_search(these.begin(), these.end(), label);
+    }
+
+    /// @brief Return whether vectors ``i`` and ``j`` have at least one label in common.
+    bool shares_label(size_t i, size_t j) const {
+        auto a = labels(i);
+        auto b = labels(j);
+        auto ia = a.begin();
+        auto ib = b.begin();
+        while (ia != a.end() && ib != b.end()) {
+            if (*ia == *ib) {
+                return true;
+            }
+            if (*ia < *ib) {
+                ++ia;
+            } else {
+                ++ib;
+            }
+        }
+        return false;
+    }
+
+    /// @brief Return whether every label shared by vectors ``i`` and ``j`` is carried by
+    ///     vector ``k``.
+    bool covers_shared(size_t i, size_t j, size_t k) const {
+        auto a = labels(i);
+        auto b = labels(j);
+        auto ia = a.begin();
+        auto ib = b.begin();
+        while (ia != a.end() && ib != b.end()) {
+            if (*ia < *ib) {
+                ++ia;
+            } else if (*ib < *ia) {
+                ++ib;
+            } else {
+                if (!has_label(k, *ia)) {
+                    return false;
+                }
+                ++ia;
+                ++ib;
+            }
+        }
+        return true;
+    }
+
+    ///
+    /// @brief Return the labels reordered so that vector ``i`` carries the labels of
+    ///     vector ``new_to_old[i]``.
+    ///
+    template <std::integral I>
+    VectorLabels permute(std::span<const I> new_to_old) const {
+        if (new_to_old.size() != size()) {
+            throw ANNEXCEPTION(
+                "Permutation has {} entries for {} vectors!", new_to_old.size(), size()
+            );
+        }
+        auto result = VectorLabels();
+        result.offsets_.assign(size() + 1, 0);
+        result.labels_.reserve(labels_.size());
+        for (size_t i = 0, imax = size(); i < imax; ++i) {
+            auto these = labels(lib::narrow_cast<size_t>(new_to_old[i]));
+            result.labels_.insert(result.labels_.end(), these.begin(), these.end());
+            result.offsets_[i + 1] = result.labels_.size();
+        }
+        result.num_labels_ = num_labels_;
+        return result;
+    }
+
+    /// @brief Return the number of vectors carrying each label.
+    std::vector<size_t> label_counts() const {
+        auto counts = std::vector<size_t>(num_labels_, 0);
+        for (auto label : labels_) {
+            ++counts[label];
+        }
+        return counts;
+    }
+
+    ///// Saving and Loading
+    static constexpr std::string_view serialization_schema = "vamana_vector_labels";
+    static constexpr lib::Version save_version = lib::Version(0, 0, 0);
+
+    lib::SaveTable save(const lib::SaveContext& ctx) const {
+        auto filename = ctx.generate_name("labels", "binary");
+        auto stream = lib::open_write(filename);
+        lib::write_binary(stream, offsets_);
+        lib::write_binary(stream, labels_);
+        return lib::SaveTable(
+            serialization_schema,
+            save_version,
+            {{"num_vectors", lib::save(size())},
+             {"num_entries", lib::save(labels_.size())},
+             {"filename", lib::save(filename.filename())}}
+        );
+    }
+
+    static VectorLabels load(const lib::LoadTable& table) {
+        auto num_vectors = lib::load_at<size_t>(table, "num_vectors");
+        auto num_entries = lib::load_at<size_t>(table, "num_entries");
+
+        auto result = VectorLabels();
+        if (num_vectors == 0) {
+            return result;
+        }
+        result.offsets_.resize(num_vectors + 1);
+        result.labels_.resize(num_entries);
+        auto stream = lib::open_read(table.resolve_at("filename"));
+        lib::read_binary(stream, result.offsets_);
+        lib::read_binary(stream, result.labels_);
+
+        // Validate the offsets before using them to index the labels.
+        if (result.offsets_.front() != 0 || result.offsets_.back() != num_entries ||
+            !std::is_sorted(result.offsets_.begin(), result.offsets_.end())) {
+            throw ANNEXCEPTION("Corrupted label offsets!");
+        }
+        if (!result.labels_.empty()) {
+            auto max = *std::max_element(result.labels_.begin(), result.labels_.end());
+            result.num_labels_ = size_t{max} + 1;
+        }
+        return result;
+    }
+
+  private:
+    // Labels of vector `i` are stored in `labels_[offsets_[i]:offsets_[i + 1]]`.
+    std::vector<size_t> offsets_{};
+    std::vector<label_type> labels_{};
+    size_t num_labels_ = 0;
+};
+
+///
+/// @brief Select the graph search entry point for each label.
+///
+/// @param labels The labels of each vector.
+/// @param fallback The entry point recorded for labels carried by no vector.
+/// @param max_candidates The largest number of vectors considered for each label.
+///
+/// Returns a vector whose entry ``l`` is a vector carrying label ``l``. Following the
+/// Filtered-Vamana construction, the entry point of each label is the least loaded of up to
+/// ``max_candidates`` vectors carrying that label, where the load of a vector is the number
+/// of labels already using it as an entry point. This spreads the entry points of labels
+/// attached to the same vectors across distinct vectors.
+///
+template <std::integral Idx>
+std::vector<Idx> select_label_entry_points(
+    const VectorLabels& labels, Idx fallback, size_t max_candidates = 1000
+) {
+    const size_t num_labels = labels.num_labels();
+    auto entry_points = std::vector<Idx>(num_labels, fallback);
+    if (num_labels == 0) {
+        return entry_points;
+    }
+
+    // Invert the labels to obtain the vectors carrying each label.
+    auto counts = labels.label_counts();
+    auto offsets = std::vector<size_t>(num_labels + 1, 0);
+    for (size_t label = 0; label < num_labels; ++label) {
+        offsets[label + 1] = offsets[label] + counts[label];
+    }
+    auto members = std::vector<Idx>(offsets.back());
+    auto position = std::vector<size_t>(offsets.begin(), offsets.end() - 1);
+    for (size_t i = 0, imax = labels.size(); i < imax; ++i) {
+        for (auto label : labels.labels(i)) {
+            members[position[label]++] = lib::narrow<Idx>(i);
+        }
+    }
+
+    auto load = std::vector<size_t>(labels.size(), 0);
+    for (size_t label = 0; label < num_labels; ++label) {
+        size_t count = counts[label];
+        if (count == 0) {
+            continue;
+        }
+        // Consider evenly spaced members to bound the work for common labels.
+        size_t stride = lib::div_round_up(count, max_candidates);
+        Idx best = members[offsets[label]];
+        for (size_t j = 0; j < count; j += stride) {
+            Idx candidate = members[offsets[label] + j];
+            if (load[candidate] < load[best]) {
+                best = candidate;
+            }
+        }
+        ++load[best];
+        entry_points[label] = best;
+    }
+    return entry_points;
+}
+
+} // namespace svs::index::vamana
@@ -0,0 +1,715 @@
+/**
+ *    Copyright (C) 2023, Intel Corporation
+ *
+ *    You can redistribute and/or modify this software under the terms of the
+ *    GNU Affero General Public License version 3.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    version 3 along with this software. If not, see
+ *    <https://www.gnu.org/licenses/agpl-3.0.en.html>.
+ */
+
+#pragma once
+
+// svs
+#include "svs/concepts/data.h"
+#include "svs/core/data/simple.h"
+#include "svs/core/distance.h"
+#include "svs/core/graph.h"
+#include "svs/core/kmeans.h"
+#include "svs/core/logging.h"
+#include "svs/index/vamana/build_params.h"
+#include "svs/index/vamana/extensions.h"
+#include "svs/index/vamana/index.h"
+#include "svs/index/vamana/prune.h"
+#include "svs/index/vamana/vamana_build.h"
+#include "svs/lib/exception.h"
+#include "svs/lib/misc.h"
+#include "svs/lib/narrow.h"
+#include "svs/lib/preprocessor.h"
+#include "svs/lib/saveload.h"
+#include "svs/lib/spinlock.h"
+#include "svs/lib/threads.h"
+#include "svs/lib/timing.h"
+
+// third-party
+#include "fmt/core.h"
+
+// stl
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace svs::index::vamana {
+
+///
+/// @brief Parameters controlling the out-of-core partitioned graph construction.
+///
+/// The dataset is split into overlapping partitions using k-means, the graph of each
+/// partition is built independently and the partition graphs are merged into the final
+/// graph.
+///
+struct PartitionedBuildParameters {
+  public:
+    /// @brief The minimum number of partitions.
+    ///
+    /// More partitions are used if required to satisfy ``memory_budget``.
+    size_t num_partitions_ = 1;
+
+    /// @brief The number of partitions each vector is assigned to.
+    ///
+    /// Vectors are assigned to the partitions of their ``overlap`` nearest centroids.
+    /// Overlapping partitions connect the partition graphs in the merged graph. Values of
+    /// 2 or 3 work well in practice.
+    size_t overlap_ = 2;
+
+    /// @brief The approximate number of bytes available to partition the dataset and
+    /// build the graph of a partition.
+    ///
+    /// The budget covers the partition assignments, which hold ``overlap`` indices per
+    /// vector, and the copy and graph of the partition being built. It does not cover the
+    /// dataset or the final graph. Zero places no limit on the size of partitions.
+    size_t memory_budget_ = 0;
+
+    /// @brief Directory where partition graphs are kept until they are merged.
+    std::filesystem::path spill_directory_ = {};
+
+  public:
+    PartitionedBuildParameters() = default;
+
+    SVS_CHAIN_SETTER_(PartitionedBuildParameters, num_partitions);
+    SVS_CHAIN_SETTER_(PartitionedBuildParameters, overlap);
+    SVS_CHAIN_SETTER_(PartitionedBuildParameters, memory_budget);
+    SVS_CHAIN_SETTER_(PartitionedBuildParameters, spill_directory);
+};
+
+///
+/// @brief Assignment of the vectors of a dataset to overlapping partitions.
+///
+/// The members of partition ``p`` are stored contiguously, in increasing order.
+///
+template <std::unsigned_integral Idx> struct Partitioning {
+    /// Entry ``p`` is the offset of the first member of partition ``p`` in ``members``.
+    std::vector<size_t> offsets{0};
+    /// The concatenated members of each partition.
+    std::vector<Idx> members{};
+
+    /// @brief Return the number of partitions.
+    size_t size() const { return offsets.size() - 1; }
+
+    /// @brief Return the members of partition ``p``.
+    std::span<const Idx> partition(size_t p) const {
+        return {members.data() + offsets.at(p), members.data() + offsets.at(p + 1)};
+    }
+};
+
+///
+/// @brief Return the approximate number of bytes needed to build the graph of a vector.
+///
+/// This accounts for the copy of the vector, its adjacency list and its vertex lock.
+///
+template <typename T, std::unsigned_integral Idx = uint32_t>
+size_t partition_bytes_per_vector(size_t dimensions, size_t max_degree) {
+    return sizeof(T) * dimensions + sizeof(Idx) * (max_degree + 1) + sizeof(SpinLock);
+}
+
+///
+/// @brief Return the bytes of the partition assignments of a dataset.
+///
+/// The assignments hold ``overlap`` indices per vector and stay in memory for the whole
+/// partitioned build.
+///
+template <std::unsigned_integral Idx = uint32_t>
+size_t partition_assignment_bytes(size_t num_vectors, size_t overlap) {
+    return sizeof(Idx) * num_vectors * std::max(overlap, size_t{1});
+}
+
+///
+/// @brief Return the largest number of vectors of a partition within the memory budget.
+///
+/// @param parameters The partitioning parameters.
+/// @param num_vectors The number of vectors in the dataset.
+/// @param bytes_per_vector The bytes needed to build the graph of a vector.
+///
+/// The partition assignments are deducted from the memory budget and the rest is
+/// available to build the graph of a partition.
+/// Returns zero if there is no memory budget.
+/// Throws ``svs::ANNException`` if the budget cannot hold the partition assignments and
+/// the graph of at least one vector.
+///
+template <std::unsigned_integral Idx = uint32_t>
+size_t max_partition_size(
+    const PartitionedBuildParameters& parameters,
+    size_t num_vectors,
+    size_t bytes_per_vector
+) {
+    const size_t budget = parameters.memory_budget_;
+    if (budget == 0) {
+        return 0;
+    }
+    size_t assignment_bytes =
+        partition_assignment_bytes<Idx>(num_vectors, parameters.overlap_);
+    if (budget < assignment_bytes + bytes_per_vector) {
+        throw ANNEXCEPTION(
+            "A memory budget of {} bytes cannot hold the {} bytes of partition "
+            "assignments and the {} bytes needed to build the graph of a vector!",
+            budget,
+            assignment_bytes,
+            bytes_per_vector
+        );
+    }
+    return (budget - assignment_bytes) / std::max(bytes_per_vector, size_t{1});
+}
+
+///
+/// @brief Return the number of partitions to use for a dataset.
+///
+/// @param parameters The partitioning parameters.
+/// @param num_vectors The number of vectors in the dataset.
+/// @param bytes_per_vector The bytes needed to build the graph of a vector.
+///
+/// With a memory budget, this is enough partitions for partitions of average size to fit
+/// in ``max_partition_size``. K-means does not balance partitions, so
+/// ``partition_dataset`` still splits the partitions exceeding the budget.
+///
+template <std::unsigned_integral Idx = uint32_t>
+size_t num_partitions(
+    const PartitionedBuildParameters& parameters,
+    size_t num_vectors,
+    size_t bytes_per_vector
+) {
+    size_t count = std::max(parameters.num_partitions_, size_t{1});
+    size_t max_size = max_partition_size<Idx>(parameters, num_vectors, bytes_per_vector);
+    if (max_size != 0) {
+        size_t overlap = std::max(parameters.overlap_, size_t{1});
+        count = std::max(count, lib::div_round_up(num_vectors * overlap, max_size));
+    }
+    return std::min(count, std::max(num_vectors, size_t{1}));
+}
+
+namespace detail {
+
+// Cluster the `num_vectors` vectors `data.get_datum(id(i))` with k-means and assign each
+// of them to the partitions of its `overlap` nearest centroids.
+//
+// Members are recorded by their IDs `id(i)` and are in increasing order if `id` is.
+template <
+    std::unsigned_integral Idx,
+    data::ImmutableMemoryDataset Data,
+    typename F,
+    threads::ThreadPool Pool>
+Partitioning<Idx> cluster_partitions(
+    const Data& data,
+    size_t num_vectors,
+    const F& id,
+    size_t num_partitions,
+    size_t overlap,
+    Pool& threadpool
+) {
+    // The number of sampled elements per centroid.
+    constexpr size_t sample_factor = 256;
+    // The number of epochs of training.
+    constexpr size_t epochs = 10;
+
+    if (num_vectors == 0) {
+        return {};
+    }
+    num_partitions = std::clamp(num_partitions, size_t{1}, num_vectors);
+    overlap = std::clamp(overlap, size_t{1}, num_partitions);
+
+    // Train the centroids on a sample.
+    size_t sample_size = std::min(num_vectors, num_partitions * sample_factor);
+    auto sample = data::SimpleData<float>(sample_size, data.dimensions());
+    threads::run(
+        threadpool,
+        threads::StaticPartition{sample_size},
+        [&](const auto& is, uint64_t SVS_UNUSED(tid)) {
+            for (auto i : is) {
+                const auto& datum = data.get_datum(id((i * num_vectors) / sample_size));
+                auto dst = sample.get_datum(i);
+                for (size_t k = 0, kmax = dst.size(); k < kmax; ++k) {
+                    dst[k] = static_cast<float>(datum[k]);
+                }
+            }
+        }
+    );
+
+    // K-means is implemented in terms of the native threadpool.
+    auto native_threadpool = threads::NativeThreadPool(threadpool.size());
+    auto parameters = KMeansParameters{num_partitions, sample_size, epochs};
+    auto centroids = kmeans_plus_plus_centroids(
+        sample, num_partitions, parameters.seed, native_threadpool
+    );
+    train_centroids(parameters, sample, centroids, native_threadpool);
+
+    // Find the nearest centroids of each vector.
+    // Entries `[overlap * i, overlap * (i + 1))` hold the partitions of vector `i`.
+    auto assignments = std::vector<Idx>(num_vectors * overlap);
+    threads::run(
+        threadpool,
+        threads::DynamicPartition{num_vectors, 1024},
+        [&](const auto& is, uint64_t SVS_UNUSED(tid)) {
+            auto f = distance::DistanceL2{};
+            auto nearest = std::vector<Neighbor<Idx>>(num_partitions);
+            for (auto i : is) {
+                const auto& datum = data.get_datum(id(i));
+                for (size_t p = 0; p < num_partitions; ++p) {
+                    nearest[p] = Neighbor<Idx>{
+                        lib::narrow_cast<Idx>(p),
+                        distance::compute(f, centroids.get_datum(p), datum)};
+                }
+                std::partial_sort(
+                    nearest.begin(),
+                    nearest.begin() + overlap,
+                    nearest.end(),
+                    TotalOrder(std::less<>())
+                );
+                for (size_t j = 0; j < overlap; ++j) {
+                    assignments[overlap * i + j] = nearest[j].id();
+                }
+            }
+        }
+    );
+
+    // Group the vectors by partition.
+    auto result = Partitioning<Idx>{};
+    auto counts = std::vector<size_t>(num_partitions, 0);
+    for (auto p : assignments) {
+        ++counts[p];
+    }
+    result.offsets.resize(num_partitions + 1);
+    for (size_t p = 0; p < num_partitions; ++p) {
+        result.offsets[p + 1] = result.offsets[p] + counts[p];
+    }
+    result.members.resize(assignments.size());
+    auto next = std::vector<size_t>(result.offsets.begin(), result.offsets.end() - 1);
+    for (size_t i = 0, imax = assignments.size(); i < imax; ++i) {
+        result.members[next[assignments[i]]++] = lib::narrow_cast<Idx>(id(i / overlap));
+    }
+    return result;
+}
+
+// Append `members` to `result` as one or more partitions of at most `max_size` vectors.
+//
+// Oversized groups are re-clustered into disjoint sub-partitions. Groups that k-means
+// cannot separate, such as duplicated vectors, are split into consecutive runs.
+template <
+    std::unsigned_integral Idx,
+    data::ImmutableMemoryDataset Data,
+    threads::ThreadPool Pool>
+void append_partition(
+    Partitioning<Idx>& result,
+    const Data& data,
+    std::span<const Idx> members,
+    size_t max_size,
+    Pool& threadpool
+) {
+    if (members.empty()) {
+        return;
+    }
+    if (members.size() <= max_size) {
+        result.members.insert(result.members.end(), members.begin(), members.end());
+        result.offsets.push_back(result.members.size());
+        return;
+    }
+
+    size_t count = lib::div_round_up(members.size(), max_size);
+    auto split = cluster_partitions<Idx>(
+        data, members.size(), [&](size_t i) { return members[i]; }, count, 1, threadpool
+    );
+    size_t largest = 0;
+    for (size_t p = 0; p < split.size(); ++p) {
+        largest = std::max(largest, split.partition(p).size());
+    }
+    if (largest == members.size()) {
+        for (size_t start = 0; start < members.size(); start += max_size) {
+            append_partition(
+                result,
+                data,
+                members.subspan(start, std::min(max_size, members.size() - start)),
+                max_size,
+                threadpool
+            );
+        }
+        return;
+    }
+    for (size_t p = 0; p < split.size(); ++p) {
+        append_partition(result, data, split.partition(p), max_size, threadpool);
+    }
+}
+
+} // namespace detail
+
+///
+/// @brief Assign each element of ``data`` to the partitions of its nearest centroids.
+///
+/// @param data The dataset to partition.
+/// @param num_partitions The number of partitions.
+/// @param overlap The number of partitions each vector is assigned to.
+/// @param threadpool The threadpool to use.
+/// @param max_size The largest number of vectors of a partition. Zero places no limit.
+///
+/// Centroids are computed with k-means on an evenly strided sample of ``data``.
+/// Nearest centroids are found using the L2 distance.
+///
+/// K-means may yield partitions of very different sizes. Partitions with more than
+/// ``max_size`` vectors are re-clustered into disjoint sub-partitions, so the result may
+/// have more than ``num_partitions`` partitions. Each vector still belongs to ``overlap``
+/// partitions. Grouping and splitting briefly hold extra copies of the assignments, before
+/// any partition graph is built.
+///
+template <
+    std::unsigned_integral Idx = uint32_t,
+    data::ImmutableMemoryDataset Data,
+    threads::ThreadPool Pool>
+Partitioning<Idx> partition_dataset(
+    const Data& data,
+    size_t num_partitions,
+    size_t overlap,
+    Pool& threadpool,
+    size_t max_size = 0
+) {
+    const size_t num_vectors = data.size();
+    if (num_vectors > std::numeric_limits<Idx>::max()) {
+        throw ANNEXCEPTION(
+            "Cannot encode {} vectors with {}!", num_vectors, name<datatype_v<Idx>>()
+        );
+    }
+    auto partitioning = detail::cluster_partitions<Idx>(
+        data, num_vectors, [](size_t i) { return i; }, num_partitions, overlap, threadpool
+    );
+    if (max_size == 0) {
+        return partitioning;
+    }
+
+    auto result = Partitioning<Idx>{};
+    for (size_t p = 0; p < partitioning.size(); ++p) {
+        detail::append_partition(
+            result, data, partitioning.partition(p), max_size, threadpool
+        );
+    }
+    return result;
+}
+
+namespace detail {
+
+inline std::filesystem::path
+partition_path(const std::filesystem::path& dir, size_t partition) {
+    return dir / fmt::format("partition_{}", partition);
+}
+
+// Build the graph over the vectors `members` of `data` and save it to `path` with vertices
+// relabeled to their global IDs.
+template <
+    std::unsigned_integral Idx,
+    data::ImmutableMemoryDataset Data,
+    typename Dist,
+    threads::ThreadPool Pool>
+void build_partition(
+    const VamanaBuildParameters& parameters,
+    const Data& data,
+    std::span<const Idx> members,
+    const Dist& distance_function,
+    Pool& threadpool,
+    const std::filesystem::path& path
+) {
+    using T = typename Data::element_type;
+    const size_t num_members = members.size();
+    auto partition_data = data::SimpleData<T>(num_members, data.dimensions());
+    threads::run(
+        threadpool,
+        threads::StaticPartition{num_members},
+        [&](const auto& is, uint64_t SVS_UNUSED(tid)) {
+            for (auto i : is) {
+                partition_data.set_datum(i, data.get_datum(members[i]));
+            }
+        }
+    );
+
+    auto graph = graphs::SimpleGraph<Idx>(num_members, parameters.graph_max_degree);
+    auto entry_point =
+        lib::narrow<Idx>(extensions::compute_entry_point(partition_data, threadpool));
+    auto builder = VamanaBuilder(
+        graph,
+        partition_data,
+        distance_function,
+        parameters,
+        threadpool,
+        extensions::estimate_prefetch_parameters(partition_data)
+    );
+    builder.construct(1.0F, entry_point, logging::Level::Trace);
+    builder.construct(parameters.alpha, entry_point, logging::Level::Trace);
+
+    // Relabel the adjacency lists with global IDs.
+    threads::run(
+        threadpool,
+        threads::StaticPartition{num_members},
+        [&](const auto& is, uint64_t SVS_UNUSED(tid)) {
+            auto neighbors = std::vector<Idx>();
+            for (auto i : is) {
+                neighbors.clear();
+                for (auto j : graph.get_node(i)) {
+                    neighbors.push_back(members[j]);
+                }
+                graph.replace_node(i, neighbors);
+            }
+        }
+    );
+    lib::save_to_disk(graph, path);
+}
+
+// Merge the partition graph saved at `path` into `graph`.
+//
+// The adjacency list of each member is the union of its current adjacency list and its
+// adjacency list in the partition graph. Lists exceeding the maximum degree are pruned.
+template <
+    typename Graph,
+    data::ImmutableMemoryDataset Data,
+    typename Dist,
+    threads::ThreadPool Pool>
+void merge_partition(
+    const VamanaBuildParameters& parameters,
+    Graph& graph,
+    const Data& data,
+    std::span<const typename Graph::index_type> members,
+    const Dist& distance_function,
+    Pool& threadpool,
+    const std::filesystem::path& path
+) {
+    using Idx = typename Graph::index_type;
+    auto partition_graph = lib::load_from_disk<graphs::SimpleGraph<Idx>>(path);
+    if (partition_graph.n_nodes() != members.size()) {
+        throw ANNEXCEPTION(
+            "Partition graph {} has {} vertices but the partition has {} members!",
+            path,
+            partition_graph.n_nodes(),
+            members.size()
+        );
+    }
+
+    // Vertices appear at most once per partition, so adjacency lists may be updated
+    // without synchronization.
+    const size_t max_degree = parameters.graph_max_degree;
+    threads::run(
+        threadpool,
+        threads::DynamicPartition{members.size(), 256},
+        [&](const auto& is, uint64_t SVS_UNUSED(tid)) {
+            auto neighbors = std::vector<Idx>();
+            auto candidates = std::vector<Neighbor<Idx>>();
+            auto pruned = std::vector<Idx>();
+            auto build_adaptor = extensions::build_adaptor(data, distance_function);
+            auto general_accessor = build_adaptor.general_accessor();
+            auto&& general_distance = build_adaptor.general_distance();
+            auto cmp = distance::comparator(general_distance);
+
+            for (auto i : is) {
+                auto src = members[i];
+                auto current = graph.get_node(src);
+                neighbors.assign(current.begin(), current.end());
+                for (auto j : partition_graph.get_node(i)) {
+                    if (std::find(neighbors.begin(), neighbors.end(), j) ==
+                        neighbors.end()) {
+                        neighbors.push_back(j);
+                    }
+                }
+
+                if (neighbors.size() <= max_degree) {
+                    graph.replace_node(src, neighbors);
+                    continue;
+                }
+
+                const auto& src_data = general_accessor(data, src);
+                distance::maybe_fix_argument(general_distance, src_data);
+                candidates.clear();
+                for (auto j : neighbors) {
+                    candidates.emplace_back(
+                        j,
+                        distance::compute(
+                            general_distance, src_data, general_accessor(data, j)
+                        )
+                    );
+                }
+                std::sort(candidates.begin(), candidates.end(), TotalOrder(cmp));
+                heuristic_prune_neighbors(
+                    prune_strategy(distance_function),
+                    max_degree,
+                    parameters.alpha,
+                    data,
+                    general_accessor,
+                    general_distance,
+                    src,
+                    lib::as_const_span(candidates),
+                    pruned
+                );
+                graph.replace_node(src, pruned);
+            }
+        }
+    );
+}
+
+} // namespace detail
+
+///
+/// @brief Build a Vamana graph partition by partition.
+///
+/// @param parameters The parameters to use for graph construction.
+/// @param partition_parameters The parameters controlling the partitioning.
+/// @param data The dataset to index.
+/// @param distance_function The distance functor used to compare elements of the dataset.
+/// @param threadpool The threadpool to use.
+/// @param graph_allocator The allocator to use for the resulting graph.
+///
+/// The dataset is split into overlapping partitions with ``partition_dataset`` and the
+/// graph of each partition is built in turn from a copy of its members. Partition graphs
+/// are saved to the spill directory and then merged one at a time into the final graph,
+/// pruning adjacency lists that exceed the maximum degree.
+///
+/// Only the partition being built resides in memory, in addition to ``data``, the final
+/// graph and the partition assignments. The memory budget covers the partition
+/// assignments and the partition being built, and partitions exceeding it are split
+/// (see ``max_partition_size``). Pair this with a memory-mapped dataset (see
+/// ``svs::MMapAllocator``) to build graphs over datasets larger than main memory.
+///
+template <
+    std::unsigned_integral Idx = uint32_t,
+    data::ImmutableMemoryDataset Data,
+    typename Dist,
+    threads::ThreadPool Pool,
+    typename Allocator = HugepageAllocator<Idx>>
+graphs::SimpleGraph<Idx, Allocator> build_partitioned_graph(
+    const VamanaBuildParameters& parameters,
+    const PartitionedBuildParameters& partition_parameters,
+    const Data& data,
+    const Dist& distance_function,
+    Pool& threadpool,
+    const Allocator& graph_allocator = {}
+) {
+    using T = typename Data::element_type;
+    const auto& spill_directory = partition_parameters.spill_directory_;
+    if (spill_directory.empty()) {
+        throw ANNEXCEPTION("A spill directory is required for partitioned graph builds!");
+    }
+    std::filesystem::create_directories(spill_directory);
+
+    auto timer = lib::Timer();
+    auto partition_timer = timer.push_back("partition");
+    const size_t bytes_per_vector =
+        partition_bytes_per_vector<T, Idx>(data.dimensions(), parameters.graph_max_degree);
+    auto count = num_partitions<Idx>(partition_parameters, data.size(), bytes_per_vector);
+    auto partitioning = partition_dataset<Idx>(
+        data,
+        count,
+        partition_parameters.overlap_,
+        threadpool,
+        max_partition_size<Idx>(partition_parameters, data.size(), bytes_per_vector)
+    );
+    partition_timer.finish();
+
+    auto build_timer = timer.push_back("build partitions");
+    for (size_t p = 0, pmax = partitioning.size(); p < pmax; ++p) {
+        auto members = partitioning.partition(p);
+        logging::info(
+            "Building partition {} of {} with {} vectors.", p + 1, pmax, members.size()
+        );
+        if (!members.empty()) {
+            detail::build_partition(
+                parameters,
+                data,
+                members,
+                distance_function,
+                threadpool,
+                detail::partition_path(spill_directory, p)
+            );
+        }
+    }
+    build_timer.finish();
+
+    auto merge_timer = timer.push_back("merge partitions");
+    auto graph = graphs::SimpleGraph<Idx, Allocator>(
+        data.size(), parameters.graph_max_degree, graph_allocator
+    );
+    for (size_t p = 0, pmax = partitioning.size(); p < pmax; ++p) {
+        auto members = partitioning.partition(p);
+        if (!members.empty()) {
+            auto path = detail::partition_path(spill_directory, p);
+            detail::merge_partition(
+                parameters,
+                graph,
+                data,
+                members,
+                distance_function,
+                threadpool,
+                path
+            );
+            std::filesystem::remove_all(path);
+        }
+    }
+    merge_timer.finish();
+    logging::debug("{}", timer);
+    return graph;
+}
+
+///
+/// @brief Entry point for building a Vamana graph-index partition by partition.
+///
+/// @param parameters The parameters to use for graph construction.
+/// @param partition_parameters The parameters controlling the partitioning.
+/// @param data_proto A dispatch loadable class yielding a dataset.
+/// @param distance The distance **functor** to use to compare queries with elements of
+///     the dataset.
+/// @param threadpool_proto Precursor for the thread pool to use. Can either be a
+///     threadpool instance of an integer specifying the number of threads to use.
+/// @param graph_allocator The allocator to use for the graph data structure.
+///
+/// @sa build_partitioned_graph
+///
+template <
+    typename DataProto,
+    typename Distance,
+    typename ThreadpoolProto,
+    typename Allocator = HugepageAllocator<uint32_t>>
+auto auto_build_partitioned(
+    const VamanaBuildParameters& parameters,
+    const PartitionedBuildParameters& partition_parameters,
+    DataProto data_proto,
+    Distance distance,
+    ThreadpoolProto threadpool_proto,
+    const Allocator& graph_allocator = {}
+) {
+    auto threadpool = threads::as_threadpool(std::move(threadpool_proto));
+    auto data = svs::detail::dispatch_load(std::move(data_proto), threadpool);
+    auto entry_point = extensions::compute_entry_point(data, threadpool);
+
+    using I = typename Allocator::value_type;
+    auto graph = build_partitioned_graph<I>(
+        parameters, partition_parameters, data, distance, threadpool, graph_allocator
+    );
+
+    auto additional_entry_points = std::vector<size_t>();
+    if (parameters.num_entry_points > 1) {
+        additional_entry_points = extensions::compute_entry_points(
+            data, threadpool, parameters.num_entry_points - 1
+        );
+    }
+
+    auto index = VamanaIndex{
+        std::move(graph),
+        std::move(data),
+        lib::narrow<I>(entry_point),
+        std::move(distance),
+        std::move(threadpool)};
+    index.apply(VamanaIndexParameters{
+        entry_point,
+        parameters,
+        index.get_search_parameters(),
+        std::move(additional_entry_points)});
+    return index;
+}
+
+} // namespace svs::index::vamana
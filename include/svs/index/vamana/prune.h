@@ -14,6 +14,7 @@
 #include "svs/concepts/data.h"
 #include "svs/concepts/distance.h"
 #include "svs/core/distance.h"
+#include "svs/index/vamana/labels.h"
 #include "svs/lib/neighbor.h"
 #include "svs/lib/type_traits.h"
 
@@ -71,6 +72,34 @@ As construct_as(lib::Type<As>, const N& n) {
 
 } // namespace detail
 
+/////
+///// Pruning Constraints
+/////
+
+// Constraints are invoked as `constraint(node, selected, candidate)` when the neighbor
+// `selected` of `node` would prune `candidate` and return whether the candidate may be
+// pruned.
+
+// Default constraint allowing any candidate to be pruned.
+struct UnconstrainedPrune {
+    constexpr bool operator()(
+        size_t SVS_UNUSED(node), size_t SVS_UNUSED(selected), size_t SVS_UNUSED(candidate)
+    ) const {
+        return true;
+    }
+};
+
+// Filtered-Vamana constraint: A candidate may only be pruned by a neighbor carrying all
+// labels shared by the candidate and the node, so that the edges needed to navigate the
+// subgraph induced by each label are kept.
+struct LabelPreservingPrune {
+    const VectorLabels& labels;
+
+    bool operator()(size_t node, size_t selected, size_t candidate) const {
+        return labels.covers_shared(node, candidate, selected);
+    }
+};
+
 /////
 ///// Iterative Prune Strategy
 /////
@@ -91,6 +120,8 @@ inline bool excluded(PruneState state) { return state != PruneState::Available;
 /// @tparam Neighbors The full neighbor-type of the candidate pool.
 /// @tparam I The type of the resulting index for each neighbor.
 /// @tparam Alloc Allocator for the result vector.
+/// @tparam Constraint Optional restriction on which candidates may be pruned (see
+///     ``UnconstrainedPrune`` and ``LabelPreservingPrune``).
 ///
 template <
     data::ImmutableMemoryDataset Data,
@@ -98,7 +129,8 @@ template <
     distance::Distance<data::const_value_type_t<Data>, data::const_value_type_t<Data>> Dist,
     NeighborLike Neighbors,
     detail::IntegerOrNeighbor I,
-    typename Alloc>
+    typename Alloc,
+    typename Constraint = UnconstrainedPrune>
 void heuristic_prune_neighbors(
     IterativePruneStrategy SVS_UNUSED(dispatch),
     size_t max_result_size,
@@ -108,7 +140,8 @@ void heuristic_prune_neighbors(
     Dist& distance_function,
     size_t current_node_id,
     const std::span<const Neighbors>& pool,
-    std::vector<I, Alloc>& result
+    std::vector<I, Alloc>& result,
+    const Constraint& can_prune = {}
 ) {
     auto cmp = distance::comparator(distance_function);
     assert(std::is_sorted(pool.begin(), pool.end(), cmp));
@@ -146,6 +179,9 @@ void heuristic_prune_neighbors(
                 }
 
                 const auto& candidate = pool[t];
+                if (!can_prune(current_node_id, id, candidate.id())) {
+                    continue;
+                }
                 auto djk = distance::compute(
                     distance_function, query, accessor(dataset, candidate.id())
                 );
@@ -174,7 +210,8 @@ template <
     distance::Distance<data::const_value_type_t<Data>, data::const_value_type_t<Data>> Dist,
     NeighborLike Neighbors,
     detail::IntegerOrNeighbor I,
-    typename Alloc>
+    typename Alloc,
+    typename Constraint = UnconstrainedPrune>
 void heuristic_prune_neighbors(
     ProgressivePruneStrategy SVS_UNUSED(dispatch),
     size_t max_result_size,
@@ -184,7 +221,8 @@ void heuristic_prune_neighbors(
     Dist& distance_function,
     size_t current_node_id,
     const std::span<const Neighbors>& pool,
-    std::vector<I, Alloc>& result
+    std::vector<I, Alloc>& result,
+    const Constraint& can_prune = {}
 ) {
     auto cmp = distance::comparator(distance_function);
     assert(std::is_sorted(pool.begin(), pool.end(), cmp));
@@ -219,6 +257,9 @@ void heuristic_prune_neighbors(
                 }
 
                 const auto& candidate = pool[t];
+                if (!can_prune(current_node_id, id, candidate.id())) {
+                    continue;
+                }
                 auto djk = distance::compute(
                     distance_function, query, accessor(dataset, candidate.id())
                 );
@@ -241,6 +282,8 @@ void heuristic_prune_neighbors(
 /// @tparam Neighbors The full neighbor-type of the candidate pool.
 /// @tparam I The type of the reusting index for each neighbor.
 /// @tparam Alloc Allocator for the result vector.
+/// @tparam Constraint Optional restriction on which candidates may be pruned (see
+///     ``UnconstrainedPrune`` and ``LabelPreservingPrune``).
 ///
 template <
     data::ImmutableMemoryDataset Data,
@@ -248,7 +291,8 @@ template <
     distance::Distance<data::const_value_type_t<Data>, data::const_value_type_t<Data>> Dist,
     NeighborLike Neighbors,
     detail::IntegerOrNeighbor I,
-    typename Alloc>
+    typename Alloc,
+    typename Constraint = UnconstrainedPrune>
 void heuristic_prune_neighbors(
     LegacyPruneStrategy SVS_UNUSED(dispatch),
     size_t max_result_size,
@@ -258,7 +302,8 @@ void heuristic_prune_neighbors(
     Dist& distance_function,
     size_t current_node_id,
     const std::span<const Neighbors>& pool,
-    std::vector<I, Alloc>& result
+    std::vector<I, Alloc>& result,
+    const Constraint& can_prune = {}
 ) {
     auto cmp = distance::comparator(distance_function);
     assert(std::is_sorted(pool.begin(), pool.end(), cmp));
@@ -291,6 +336,9 @@ void heuristic_prune_neighbors(
             }
 
             const auto& candidate = pool[t];
+            if (!can_prune(current_node_id, id, candidate.id())) {
+                continue;
+            }
             auto djk = distance::compute(
                 distance_function, query, accessor(dataset, candidate.id())
             );
@@ -0,0 +1,390 @@
+/**
+ *    Copyright (C) 2023, Intel Corporation
+ *
+ *    You can redistribute and/or modify this software under the terms of the
+ *    GNU Affero General Public License version 3.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    version 3 along with this software. If not, see
+ *    <https://www.gnu.org/licenses/agpl-3.0.en.html>.
+ */
+
+#pragma once
+
+// svs
+#include "svs/core/graph.h"
+#include "svs/lib/exception.h"
+#include "svs/lib/narrow.h"
+#include "svs/lib/saveload.h"
+#include "svs/lib/threads.h"
+
+// stl
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace svs::index::vamana {
+
+///
+/// @brief Strategies for computing a locality-improving vertex order of a graph.
+///
+/// Each strategy returns a permutation ``new_to_old`` of the vertices where entry ``i``
+/// is the vertex placed at position ``i``. Placing vertices visited close together during
+/// graph search next to each other improves cache and TLB reuse.
+///
+enum class GraphOrdering {
+    /// Breadth-first traversal from the entry points.
+    BreadthFirst,
+    /// Reverse Cuthill-McKee: breadth-first traversal from low-degree vertices visiting
+    /// neighbors by increasing degree, reversed.
+    ReverseCuthillMcKee,
+    /// Gorder: greedily place the vertex sharing the most edges and in-neighbors with the
+    /// most recently placed vertices.
+    Gorder
+};
+
+inline constexpr std::string_view name(GraphOrdering ordering) {
+    switch (ordering) {
+        case GraphOrdering::BreadthFirst: {
+            return "bfs";
+        }
+        case GraphOrdering::ReverseCuthillMcKee: {
+            return "rcm";
+        }
+        case GraphOrdering::Gorder: {
+            return "gorder";
+        }
+    }
+    throw ANNEXCEPTION("Unknown graph ordering!");
+}
+
+inline GraphOrdering parse_graph_ordering(std::string_view str) {
+    for (auto ordering :
+         {GraphOrdering::BreadthFirst,
+          GraphOrdering::ReverseCuthillMcKee,
+          GraphOrdering::Gorder}) {
+        if (name(ordering) == str) {
+            return ordering;
+        }
+    }
+    throw ANNEXCEPTION("Unknown graph ordering name: {}!", str);
+}
+
+///
+/// @brief Datasets whose entries can be permuted with ``compact``.
+///
+/// When the batch size is at least the size of the dataset, ``compact`` applies arbitrary
+/// permutations.
+///
+template <typename Data, typename Idx>
+concept PermutableData =
+    requires(Data& data, std::span<const Idx> ids, threads::NativeThreadPool& threadpool) {
+        data.compact(ids, threadpool, size_t{0});
+    };
+
+///
+/// @brief Return the breadth-first order of ``graph`` starting from ``roots``.
+///
+/// Vertices not reachable from the roots are traversed in turn, in increasing ID order.
+///
+template <graphs::ImmutableMemoryGraph Graph, std::integral I>
+std::vector<typename Graph::index_type>
+breadth_first_order(const Graph& graph, std::span<const I> roots) {
+    using Idx = typename Graph::index_type;
+    const size_t num_nodes = graph.n_nodes();
+    auto order = std::vector<Idx>();
+    order.reserve(num_nodes);
+    auto visited = std::vector<bool>(num_nodes, false);
+
+    // The order doubles as the queue of the traversal.
+    auto traverse = [&](Idx root) {
+        if (visited[root]) {
+            return;
+        }
+        visited[root] = true;
+        size_t head = order.size();
+        order.push_back(root);
+        while (head < order.size()) {
+            for (auto u : graph.get_node(order[head++])) {
+                if (!visited[u]) {
+                    visited[u] = true;
+                    order.push_back(u);
+                }
+            }
+        }
+    };
+
+    for (auto root : roots) {
+        traverse(lib::narrow<Idx>(root));
+    }
+    for (size_t i = 0; i < num_nodes; ++i) {
+        traverse(lib::narrow_cast<Idx>(i));
+    }
+    return order;
+}
+
+///
+/// @brief Return the reverse Cuthill-McKee order of ``graph``.
+///
+/// Each traversal starts from the unvisited vertex of lowest out-degree and visits the
+/// unvisited neighbors of each vertex by increasing out-degree.
+///
+template <graphs::ImmutableMemoryGraph Graph>
+std::vector<typename Graph::index_type> reverse_cuthill_mckee_order(const Graph& graph) {
+    using Idx = typename Graph::index_type;
+    const size_t num_nodes = graph.n_nodes();
+    auto by_degree = [&](Idx a, Idx b) {
+        return graph.get_node_degree(a) < graph.get_node_degree(b);
+    };
+
+    auto roots = std::vector<Idx>(num_nodes);
+    std::iota(roots.begin(), roots.end(), Idx{0});
+    std::stable_sort(roots.begin(), roots.end(), by_degree);
+
+    auto order = std::vector<Idx>();
+    order.reserve(num_nodes);
+    auto visited = std::vector<bool>(num_nodes, false);
+    for (auto root : roots) {
+        if (visited[root]) {
+            continue;
+        }
+        visited[root] = true;
+        size_t head = order.size();
+        order.push_back(root);
+        while (head < order.size()) {
+            size_t start = order.size();
+            for (auto u : graph.get_node(order[head++])) {
+                if (!visited[u]) {
+                    visited[u] = true;
+                    order.push_back(u);
+                }
+            }
+            std::stable_sort(
+                order.begin() + lib::narrow_cast<ptrdiff_t>(start), order.end(), by_degree
+            );
+        }
+    }
+    std::reverse(order.begin(), order.end());
+    return order;
+}
+
+namespace detail {
+
+// Max-priority queue over vertices whose keys change by one at a time.
+//
+// Vertices with the same key are kept in a doubly linked list, so increments, decrements
+// and removals take constant time and extracting the maximum is amortized constant time.
+template <std::integral Idx> class UnitHeap {
+  public:
+    static constexpr Idx none = std::numeric_limits<Idx>::max();
+
+    explicit UnitHeap(size_t size)
+        : key_(size, 0)
+        , prev_(size, none)
+        , next_(size, none)
+        , heads_(1, none) {
+        for (size_t i = size; i > 0; --i) {
+            link(lib::narrow_cast<Idx>(i - 1));
+        }
+    }
+
+    void increment(Idx v) {
+        unlink(v);
+        ++key_[v];
+        if (key_[v] == heads_.size()) {
+            heads_.push_back(none);
+        }
+        link(v);
+        top_ = std::max(top_, key_[v]);
+    }
+
+    void decrement(Idx v) {
+        unlink(v);
+        --key_[v];
+        link(v);
+    }
+
+    void remove(Idx v) { unlink(v); }
+
+    // Remove and return a vertex with the largest key.
+    // The heap must not be empty.
+    Idx pop() {
+        while (heads_[top_] == none) {
+            --top_;
+        }
+        Idx v = heads_[top_];
+        unlink(v);
+        return v;
+    }
+
+  private:
+    void link(Idx v) {
+        Idx head = heads_[key_[v]];
+        prev_[v] = none;
+        next_[v] = head;
+        if (head != none) {
+            prev_[head] = v;
+        }
+        heads_[key_[v]] = v;
+    }
+
+    void unlink(Idx v) {
+        if (prev_[v] != none) {
+            next_[prev_[v]] = next_[v];
+        } else {
+            heads_[key_[v]] = next_[v];
+        }
+        if (next_[v] != none) {
+            prev_[next_[v]] = prev_[v];
+        }
+        prev_[v] = none;
+        next_[v] = none;
+    }
+
+    std::vector<size_t> key_;
+    std::vector<Idx> prev_;
+    std::vector<Idx> next_;
+    // The first vertex with each key.
+    std::vector<Idx> heads_;
+    // An upper bound on the largest key.
+    size_t top_ = 0;
+};
+
+} // namespace detail
+
+///
+/// @brief Return the Gorder of ``graph`` starting from ``first``.
+///
+/// @param graph The graph to order.
+/// @param first The first vertex to place.
+/// @param window The number of most recently placed vertices considered when placing the
+///     next vertex.
+///
+/// Following Wei et al. ("Speedup Graph Processing by Graph Ordering", SIGMOD 2016), the
+/// next vertex placed is the one maximizing the number of edges to and in-neighbors shared
+/// with the vertices in the window. The cost is proportional to the number of edges times
+/// the maximum degree, making this the most expensive ordering to compute.
+///
+template <graphs::ImmutableMemoryGraph Graph>
+std::vector<typename Graph::index_type> gorder(
+    const Graph& graph, typename Graph::index_type first, size_t window = 5
+) {
+    using Idx = typename Graph::index_type;
+    const size_t num_nodes = graph.n_nodes();
+    if (num_nodes == 0) {
+        return {};
+    }
+    if (static_cast<size_t>(first) >= num_nodes) {
+        throw ANNEXCEPTION("First vertex {} is out of bounds!", first);
+    }
+
+    // Build the in-neighbors of each vertex.
+    auto offsets = std::vector<size_t>(num_nodes + 1, 0);
+    for (size_t i = 0; i < num_nodes; ++i) {
+        for (auto u : graph.get_node(i)) {
+            ++offsets[u + 1];
+        }
+    }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    auto in_neighbors = std::vector<Idx>(offsets.back());
+    auto position = std::vector<size_t>(offsets.begin(), offsets.end() - 1);
+    for (size_t i = 0; i < num_nodes; ++i) {
+        for (auto u : graph.get_node(i)) {
+            in_neighbors[position[u]++] = lib::narrow_cast<Idx>(i);
+        }
+    }
+
+    auto heap = detail::UnitHeap<Idx>(num_nodes);
+    auto placed = std::vector<bool>(num_nodes, false);
+    // Add (or remove) the contribution of `v` to the scores of unplaced vertices when it
+    // enters (or leaves) the window.
+    auto update = [&](Idx v, bool enter) {
+        auto apply = [&](Idx u) {
+            if (!placed[u]) {
+                enter ? heap.increment(u) : heap.decrement(u);
+            }
+        };
+        for (auto u : graph.get_node(v)) {
+            apply(u);
+        }
+        for (size_t k = offsets[v]; k < offsets[v + 1]; ++k) {
+            Idx w = in_neighbors[k];
+            apply(w);
+            for (auto u : graph.get_node(w)) {
+                apply(u);
+            }
+        }
+    };
+
+    auto order = std::vector<Idx>();
+    order.reserve(num_nodes);
+    auto place = [&](Idx v) {
+        placed[v] = true;
+        order.push_back(v);
+        update(v, true);
+    };
+
+    heap.remove(first);
+    place(first);
+    while (order.size() < num_nodes) {
+        if (order.size() > window) {
+            update(order[order.size() - window - 1], false);
+        }
+        place(heap.pop());
+    }
+    return order;
+}
+
+///
+/// @brief Compute a locality-improving vertex order of ``graph``.
+///
+/// @param graph The graph to order.
+/// @param entry_points The search entry points of the graph. Breadth-first traversal and
+///     Gorder start from them.
+/// @param ordering The ordering strategy.
+///
+/// Returns a permutation ``new_to_old`` of the vertices where entry ``i`` is the vertex
+/// placed at position ``i``.
+///
+template <graphs::ImmutableMemoryGraph Graph, std::integral I>
+std::vector<typename Graph::index_type> compute_graph_ordering(
+    const Graph& graph, std::span<const I> entry_points, GraphOrdering ordering
+) {
+    using Idx = typename Graph::index_type;
+    switch (ordering) {
+        case GraphOrdering::BreadthFirst: {
+            return breadth_first_order(graph, entry_points);
+        }
+        case GraphOrdering::ReverseCuthillMcKee: {
+            return reverse_cuthill_mckee_order(graph);
+        }
+        case GraphOrdering::Gorder: {
+            Idx first = entry_points.empty() ? Idx{0} : lib::narrow<Idx>(entry_points[0]);
+            return gorder(graph, first);
+        }
+    }
+    throw ANNEXCEPTION("Unknown graph ordering!");
+}
+
+} // namespace svs::index::vamana
+
+// Saving and Loading.
+namespace svs::lib {
+template <> struct Saver<svs::index::vamana::GraphOrdering> {
+    static SaveNode save(svs::index::vamana::GraphOrdering ordering) {
+        return svs::index::vamana::name(ordering);
+    }
+};
+
+template <> struct Loader<svs::index::vamana::GraphOrdering> {
+    using toml_type = toml::value<std::string>;
+    static svs::index::vamana::GraphOrdering load(const toml_type& val) {
+        return svs::index::vamana::parse_graph_ordering(val.get());
+    }
+};
+} // namespace svs::lib
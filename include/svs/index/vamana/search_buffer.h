@@ -99,6 +99,8 @@ template <typename Idx, typename Cmp = std::less<>> class SearchBuffer {
 
     /// A visited filter with 65,535 entries with a memory footpring of 128 kiB.
     using set_type = VisitedFilter<Idx, 16>;
+    /// An exact visited set with constant time reset.
+    using exact_set_type = VisitedTable<Idx>;
 
     ///
     /// @brief Initialize a buffer with zero capacity.
@@ -115,9 +117,13 @@ template <typename Idx, typename Cmp = std::less<>> class SearchBuffer {
     ///     capacity.
     /// @param compare The functor used to compare two ``SearchNeighbor``s together.
     /// @param enable_visited Whether or not the visited set is enabled.
+    /// @param exact_visited Whether an enabled visited set should be exact.
     ///
     explicit SearchBuffer(
-        SearchBufferConfig config, Cmp compare = {}, bool enable_visited = false
+        SearchBufferConfig config,
+        Cmp compare = {},
+        bool enable_visited = false,
+        bool exact_visited = false
     )
         : compare_{std::move(compare)}
         , search_window_size_{config.get_search_window_size()}
@@ -125,7 +131,11 @@ template <typename Idx, typename Cmp = std::less<>> class SearchBuffer {
         , candidates_{capacity_ + 1}
         , visited_{std::nullopt} {
         if (enable_visited) {
-            enable_visited_set();
+            if (exact_visited) {
+                enable_exact_visited_set();
+            } else {
+                enable_visited_set();
+            }
         }
     }
 
@@ -150,7 +160,8 @@ template <typename Idx, typename Cmp = std::less<>> class SearchBuffer {
     SearchBuffer shallow_copy() const {
         // We care about the contents of the buffer - just its size.
         // Therefore, we can construct a new buffer from scratch.
-        return SearchBuffer{config(), compare_, visited_set_enabled()};
+        return SearchBuffer{
+            config(), compare_, visited_set_enabled(), exact_visited_set_enabled()};
     }
 
     // TODO: Allow this construction to be noexcept since the pre-conditions for the
@@ -187,14 +198,35 @@ template <typename Idx, typename Cmp = std::less<>> class SearchBuffer {
         candidates_.resize(capacity_ + 1);
     }
 
+    ///
+    /// @brief Increase the search window size and capacity while preserving the contents.
+    ///
+    /// @param new_size The new search window size and capacity. Must be at least the
+    ///     current capacity.
+    ///
+    /// Unlike ``change_maxsize``, this may be called in the middle of a search.
+    /// Candidates beyond the previous search window become eligible for expansion.
+    ///
+    void grow(size_t new_size) {
+        assert(new_size >= capacity_);
+        search_window_size_ = new_size;
+        capacity_ = new_size;
+        candidates_.resize(new_size + 1);
+        while (best_unvisited_ < size_ && candidates_[best_unvisited_].visited()) {
+            ++best_unvisited_;
+        }
+    }
+
     ///
     /// @brief Prepare the buffer for a new search operation.
     ///
     void clear() {
         size_ = 0;
         best_unvisited_ = 0;
-        if (visited_set_enabled()) {
+        if (visited_) {
             visited_->reset();
+        } else if (exact_visited_) {
+            exact_visited_->reset();
         }
     }
 
@@ -363,39 +395,73 @@ template <typename Idx, typename Cmp = std::less<>> class SearchBuffer {
     ///
     void sort() { std::sort(begin(), end(), compare_); }
 
+    ///
+    /// @brief Discard all but the first ``n`` elements in the buffer.
+    ///
+    /// Useful for post-processing steps like reranking that only refine a prefix of the
+    /// buffer. Does nothing if ``n`` is not less than ``size()``.
+    ///
+    void truncate(size_t n) {
+        size_ = std::min(size_, n);
+        best_unvisited_ = std::min(best_unvisited_, size_);
+    }
+
     ///// Visited API
 
     ///
     /// @brief Return ``true`` if the visited set is enabled. Otherwise, return ``false``.
     ///
-    bool visited_set_enabled() const { return visited_.has_value(); }
+    bool visited_set_enabled() const {
+        return visited_.has_value() || exact_visited_.has_value();
+    }
+
+    ///
+    /// @brief Return ``true`` if the exact visited set is enabled.
+    ///
+    bool exact_visited_set_enabled() const { return exact_visited_.has_value(); }
 
     ///
     /// @brief Enable use of the visited set when performing greedy searcher.
     ///
     /// Visited set use does not affect accuracy but may affect performance.
+    /// Replaces the exact visited set if it is enabled.
     ///
     void enable_visited_set() {
-        if (!visited_set_enabled()) {
+        exact_visited_.reset();
+        if (!visited_) {
             visited_.emplace();
         }
     }
 
+    ///
+    /// @brief Enable use of the exact visited set when performing greedy searches.
+    ///
+    /// The exact set never computes the distance to a candidate twice, at the cost of
+    /// memory proportional to the range of IDs visited. Replaces the default visited set
+    /// if it is enabled.
+    ///
+    void enable_exact_visited_set() {
+        visited_.reset();
+        if (!exact_visited_) {
+            exact_visited_.emplace();
+        }
+    }
+
     ///
     /// @brief Disable use of the visited set when performing greedy searches.
     /// Visited set use does not affect accuracy but may affect performance.
     ///
     void disable_visited_set() {
-        if (visited_set_enabled()) {
-            visited_.reset();
-        }
+        visited_.reset();
+        exact_visited_.reset();
     }
 
     ///
     /// @brief Return `true` if key `i` has definitely been marked as visited. Otherwise
     /// ``false``.
     ///
-    /// This function is allowed to spuriously return ``false``.
+    /// This function is allowed to spuriously return ``false`` unless the exact visited
+    /// set is enabled.
     ///
     bool is_visited(Idx i) const { return visited_set_enabled() && unsafe_is_visited(i); }
 
@@ -411,18 +477,22 @@ template <typename Idx, typename Cmp = std::less<>> class SearchBuffer {
 
     // Unsafe implementations.
     bool unsafe_is_visited(Idx i) const {
-        assert(visited_);
-        return visited_->contains(i);
+        assert(visited_set_enabled());
+        return exact_visited_ ? exact_visited_->contains(i) : visited_->contains(i);
     }
 
     void unsafe_prefetch_visited(Idx i) const {
-        assert(visited_);
-        visited_->prefetch(i);
+        assert(visited_set_enabled());
+        if (exact_visited_) {
+            exact_visited_->prefetch(i);
+        } else {
+            visited_->prefetch(i);
+        }
     }
 
     bool unsafe_emplace_visited(Idx i) {
-        assert(visited_);
-        return visited_->emplace(i);
+        assert(visited_set_enabled());
+        return exact_visited_ ? exact_visited_->emplace(i) : visited_->emplace(i);
     }
 
   private:
@@ -441,6 +511,8 @@ template <typename Idx, typename Cmp = std::less<>> class SearchBuffer {
     // The visited set. Implemented as a `std::optional` to allow enablind and disabling
     // without always requiring allocation of the data structure.
     std::optional<set_type> visited_{std::nullopt};
+    // The exact visited set. At most one of the visited sets is enabled.
+    std::optional<exact_set_type> exact_visited_{std::nullopt};
 };
 
 } // namespace svs::index::vamana
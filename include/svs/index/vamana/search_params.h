@@ -16,6 +16,9 @@
 #include "svs/lib/preprocessor.h"
 #include "svs/lib/saveload.h"
 
+// stl
+#include <algorithm>
+
 namespace svs::index::vamana {
 
 /// @brief Runtime parameters controlling the accuracy and performance of index search.
@@ -36,12 +39,62 @@ struct VamanaSearchParameters {
     /// performance in the high-recall or high-neighbor regime.
     bool search_buffer_visited_set_ = false;
 
+    /// @brief Use an exact visited set when the visited set is enabled.
+    ///
+    /// The default visited set is a small lossy cache that may forget visited candidates
+    /// for large search windows, leading to repeated distance computations. The exact set
+    /// never does, and is reset in constant time between queries, but uses up to two bytes
+    /// per indexed vector for each search thread.
+    bool search_buffer_exact_visited_set_ = false;
+
     /// @brief The number of iterations ahead to prefetch candidates.
     size_t prefetch_lookahead_ = 4;
 
     /// @brief Parameter controlling the ramp phase of prefetching.
     size_t prefetch_step_ = 1;
 
+    /// @brief The number of candidates refined by datasets that rerank search results.
+    ///
+    /// Datasets such as two-level LVQ recompute distances for the best candidates found by
+    /// graph search using a more accurate representation. Only the first
+    /// ``rerank_depth_`` candidates in the search buffer are refined and the remainder are
+    /// discarded. Setting this to zero reranks the entire search buffer.
+    ///
+    /// Batch search never reranks fewer candidates than the requested number of neighbors.
+    size_t rerank_depth_ = 0;
+
+    /// @brief The number of queries each thread traverses concurrently during batch search.
+    ///
+    /// When greater than one, each thread steps through the graph searches of a group of
+    /// queries in a round-robin fashion, prefetching the next adjacency list of a query
+    /// before moving on to the next one. This hides memory latency for indices that do not
+    /// fit in the last level cache and does not change the search results.
+    ///
+    /// Only applies to datasets that do not rerank. Values above
+    /// ``svs::index::vamana::max_interleaved_queries`` are clamped.
+    size_t interleave_ = 1;
+
+    ///// Early termination.
+    //
+    // By default, greedy search ends once every candidate in the search window has been
+    // expanded. The options below end the search earlier for queries whose nearest
+    // neighbors stop changing, reducing the latency of easy queries without shrinking the
+    // search window for hard ones. Both conditions monitor the first ``num_neighbors``
+    // entries of the search buffer, where ``num_neighbors`` is the number of neighbors
+    // requested from batch search.
+
+    /// @brief Stop after this many consecutive candidate expansions fail to improve the
+    /// current nearest neighbors. Zero disables this condition.
+    size_t early_termination_patience_ = 0;
+
+    /// @brief Stop once the best unexpanded candidate is further away than this factor
+    /// times the distance to the furthest current nearest neighbor.
+    ///
+    /// The ratio applies to the values computed by the index's distance functor (e.g.,
+    /// squared distances for Euclidean indices). Values less than one disable this
+    /// condition.
+    float early_termination_ratio_ = 0;
+
   public:
     VamanaSearchParameters() = default;
 
@@ -49,18 +102,42 @@ struct VamanaSearchParameters {
         SearchBufferConfig buffer_config,
         bool search_buffer_visited_set,
         size_t prefetch_lookahead,
-        size_t prefetch_step
+        size_t prefetch_step,
+        size_t rerank_depth = 0,
+        size_t interleave = 1,
+        size_t early_termination_patience = 0,
+        float early_termination_ratio = 0,
+        bool search_buffer_exact_visited_set = false
     )
         : buffer_config_{buffer_config}
         , search_buffer_visited_set_{search_buffer_visited_set}
+        , search_buffer_exact_visited_set_{search_buffer_exact_visited_set}
         , prefetch_lookahead_{prefetch_lookahead}
-        , prefetch_step_{prefetch_step} {}
+        , prefetch_step_{prefetch_step}
+        , rerank_depth_{rerank_depth}
+        , interleave_{interleave}
+        , early_termination_patience_{early_termination_patience}
+        , early_termination_ratio_{early_termination_ratio} {}
 
     // Buffer config
     SVS_CHAIN_SETTER_(VamanaSearchParameters, buffer_config);
     SVS_CHAIN_SETTER_(VamanaSearchParameters, search_buffer_visited_set);
+    SVS_CHAIN_SETTER_(VamanaSearchParameters, search_buffer_exact_visited_set);
     SVS_CHAIN_SETTER_(VamanaSearchParameters, prefetch_lookahead);
     SVS_CHAIN_SETTER_(VamanaSearchParameters, prefetch_step);
+    SVS_CHAIN_SETTER_(VamanaSearchParameters, rerank_depth);
+    SVS_CHAIN_SETTER_(VamanaSearchParameters, interleave);
+    SVS_CHAIN_SETTER_(VamanaSearchParameters, early_termination_patience);
+    SVS_CHAIN_SETTER_(VamanaSearchParameters, early_termination_ratio);
+
+    ///
+    /// @brief Return the number of candidates to rerank when returning ``num_neighbors``.
+    ///
+    /// A return value of zero indicates that the entire search buffer should be reranked.
+    ///
+    size_t effective_rerank_depth(size_t num_neighbors) const {
+        return rerank_depth_ == 0 ? 0 : std::max(rerank_depth_, num_neighbors);
+    }
 
     // Version History
     // - v0.0.0:
@@ -71,7 +148,40 @@ struct VamanaSearchParameters {
     //      bool search_buffer_visited_set_ = false;
     //      size_t prefetch_lookahead = 4
     //      size_t prefetch_lookstep = 1
-    static constexpr lib::Version save_version{0, 0, 1};
+    // - v0.0.2: Added rerank depth. Backwards compatible with a default of 0.
+    //      SearchBufferConfig buffer_config_{};
+    //      bool search_buffer_visited_set_ = false;
+    //      size_t prefetch_lookahead = 4
+    //      size_t prefetch_lookstep = 1
+    //      size_t rerank_depth = 0
+    // - v0.0.3: Added query interleaving. Backwards compatible with a default of 1.
+    //      SearchBufferConfig buffer_config_{};
+    //      bool search_buffer_visited_set_ = false;
+    //      size_t prefetch_lookahead = 4
+    //      size_t prefetch_lookstep = 1
+    //      size_t rerank_depth = 0
+    //      size_t interleave = 1
+    // - v0.0.4: Added early termination. Backwards compatible with both conditions
+    //   disabled.
+    //      SearchBufferConfig buffer_config_{};
+    //      bool search_buffer_visited_set_ = false;
+    //      size_t prefetch_lookahead = 4
+    //      size_t prefetch_lookstep = 1
+    //      size_t rerank_depth = 0
+    //      size_t interleave = 1
+    //      size_t early_termination_patience = 0
+    //      float early_termination_ratio = 0
+    // - v0.0.5: Added the exact visited set. Backwards compatible with a default of false.
+    //      SearchBufferConfig buffer_config_{};
+    //      bool search_buffer_visited_set_ = false;
+    //      bool search_buffer_exact_visited_set_ = false;
+    //      size_t prefetch_lookahead = 4
+    //      size_t prefetch_lookstep = 1
+    //      size_t rerank_depth = 0
+    //      size_t interleave = 1
+    //      size_t early_termination_patience = 0
+    //      float early_termination_ratio = 0
+    static constexpr lib::Version save_version{0, 0, 5};
     static constexpr std::string_view serialization_schema = "vamana_search_parameters";
     lib::SaveTable save() const {
         return lib::SaveTable(
@@ -80,8 +190,13 @@ struct VamanaSearchParameters {
             {{"search_window_size", lib::save(buffer_config_.get_search_window_size())},
              {"search_buffer_capacity", lib::save(buffer_config_.get_total_capacity())},
              SVS_LIST_SAVE_(search_buffer_visited_set),
+             SVS_LIST_SAVE_(search_buffer_exact_visited_set),
              SVS_LIST_SAVE_(prefetch_lookahead),
-             SVS_LIST_SAVE_(prefetch_step)}
+             SVS_LIST_SAVE_(prefetch_step),
+             SVS_LIST_SAVE_(rerank_depth),
+             SVS_LIST_SAVE_(interleave),
+             SVS_LIST_SAVE_(early_termination_patience),
+             SVS_LIST_SAVE_(early_termination_ratio)}
         );
     }
 
@@ -104,10 +219,38 @@ struct VamanaSearchParameters {
     }
 
     static VamanaSearchParameters load(const lib::ContextFreeLoadTable& table) {
-        if (table.version() < save_version) {
+        if (table.version() == lib::Version(0, 0, 0)) {
             return load_legacy(table);
         }
 
+        // Version 0.0.1 lacked the `rerank_depth` field. Default to reranking everything.
+        size_t rerank_depth = 0;
+        if (table.version() >= lib::Version(0, 0, 2)) {
+            rerank_depth = SVS_LOAD_MEMBER_AT_(table, rerank_depth);
+        }
+
+        // Versions prior to 0.0.3 lacked the `interleave` field. Default to one query.
+        size_t interleave = 1;
+        if (table.version() >= lib::Version(0, 0, 3)) {
+            interleave = SVS_LOAD_MEMBER_AT_(table, interleave);
+        }
+
+        // Versions prior to 0.0.4 lacked early termination. Keep it disabled.
+        size_t early_termination_patience = 0;
+        float early_termination_ratio = 0;
+        if (table.version() >= lib::Version(0, 0, 4)) {
+            early_termination_patience =
+                SVS_LOAD_MEMBER_AT_(table, early_termination_patience);
+            early_termination_ratio = SVS_LOAD_MEMBER_AT_(table, early_termination_ratio);
+        }
+
+        // Versions prior to 0.0.5 lacked the exact visited set.
+        bool search_buffer_exact_visited_set = false;
+        if (table.version() >= lib::Version(0, 0, 5)) {
+            search_buffer_exact_visited_set =
+                SVS_LOAD_MEMBER_AT_(table, search_buffer_exact_visited_set);
+        }
+
         return VamanaSearchParameters{
             SearchBufferConfig(
                 lib::load_at<size_t>(table, "search_window_size"),
@@ -116,7 +259,11 @@ struct VamanaSearchParameters {
             SVS_LOAD_MEMBER_AT_(table, search_buffer_visited_set),
             SVS_LOAD_MEMBER_AT_(table, prefetch_lookahead),
             SVS_LOAD_MEMBER_AT_(table, prefetch_step),
-        };
+            rerank_depth,
+            interleave,
+            early_termination_patience,
+            early_termination_ratio,
+            search_buffer_exact_visited_set};
     }
 
     friend bool
@@ -18,9 +18,11 @@
 #include "svs/index/vamana/build_params.h"
 #include "svs/index/vamana/extensions.h"
 #include "svs/index/vamana/greedy_search.h"
+#include "svs/index/vamana/labels.h"
 #include "svs/index/vamana/prune.h"
 #include "svs/index/vamana/search_buffer.h"
 #include "svs/index/vamana/search_tracker.h"
+#include "svs/index/vamana/vectorized_search_buffer.h"
 #include "svs/lib/boundscheck.h"
 #include "svs/lib/exception.h"
 #include "svs/lib/narrow.h"
@@ -166,6 +168,8 @@ class VamanaBuilder {
     // Type Aliases
     using Idx = typename Graph::index_type;
     using search_buffer_type = SearchBuffer<Idx, distance::compare_t<Dist>>;
+    using vectorized_search_buffer_type =
+        VectorizedSearchBuffer<Idx, distance::compare_t<Dist>>;
 
     template <typename T> using set_type = tsl::robin_set<T>;
 
@@ -197,6 +201,47 @@ class VamanaBuilder {
         }
     }
 
+    ///
+    /// @brief Construct a builder for a label-aware (Filtered-Vamana) graph.
+    ///
+    /// @param labels The labels of each vector. Must outlive the builder.
+    /// @param label_entry_points Entry ``l`` is the entry point of label ``l``, which must
+    ///     carry label ``l``.
+    ///
+    /// The search generating candidates for a labeled vector starts from the entry points
+    /// of its labels and only traverses vectors sharing one of its labels. Pruning keeps
+    /// an edge unless the pruning neighbor carries every label shared by the two endpoints
+    /// of the edge. Vectors without labels are processed as by an unlabeled builder.
+    ///
+    VamanaBuilder(
+        Graph& graph,
+        const Data& data,
+        Dist distance_function,
+        const VamanaBuildParameters& params,
+        Pool& threadpool,
+        const VectorLabels& labels,
+        std::vector<Idx> label_entry_points,
+        GreedySearchPrefetchParameters prefetch_hint = {}
+    )
+        : VamanaBuilder(
+              graph, data, std::move(distance_function), params, threadpool, prefetch_hint
+          ) {
+        if (labels.size() != data_.size()) {
+            throw ANNEXCEPTION(
+                "Expected labels for {} vectors but got {}!", data_.size(), labels.size()
+            );
+        }
+        if (label_entry_points.size() < labels.num_labels()) {
+            throw ANNEXCEPTION(
+                "Expected entry points for {} labels but got {}!",
+                labels.num_labels(),
+                label_entry_points.size()
+            );
+        }
+        labels_ = &labels;
+        label_entry_points_ = std::move(label_entry_points);
+    }
+
     void
     construct(float alpha, Idx entry_point, logging::Level level = logging::Level::Info) {
         construct(alpha, entry_point, threads::UnitRange<size_t>{0, data_.size()}, level);
@@ -296,6 +341,28 @@ class VamanaBuilder {
         float alpha,
         const std::vector<Idx>& entry_points,
         lib::Timer& timer
+    ) {
+        if (params_.use_vectorized_search_buffer) {
+            generate_neighbors_with<vectorized_search_buffer_type>(
+                indices, alpha, entry_points, timer
+            );
+        } else {
+            generate_neighbors_with<search_buffer_type>(
+                indices, alpha, entry_points, timer
+            );
+        }
+    }
+
+    ///
+    /// Implementation of ``generate_neighbors`` using ``Buffer`` as the search buffer for
+    /// construction searches.
+    ///
+    template <typename Buffer, typename /*std::ranges::random_access_range*/ R>
+    void generate_neighbors_with(
+        const R& indices,
+        float alpha,
+        const std::vector<Idx>& entry_points,
+        lib::Timer& timer
     ) {
         auto range = threads::StaticPartition{indices};
 
@@ -307,11 +374,15 @@ class VamanaBuilder {
 
             // Scratch space.
             std::vector<Neighbor<Idx>> pool{};
-            auto search_buffer = search_buffer_type{params_.window_size};
+            auto search_buffer = Buffer{params_.window_size};
 
             // Enable use of the visited filter of the search buffer.
             // It seems to help in high-window-size scenarios.
-            search_buffer.enable_visited_set();
+            if (params_.use_exact_visited_set) {
+                search_buffer.enable_exact_visited_set();
+            } else {
+                search_buffer.enable_visited_set();
+            }
             set_type<Idx> visited{};
             auto tracker = OptionalTracker<Idx>(params_.use_full_search_history);
 
@@ -321,6 +392,9 @@ class VamanaBuilder {
             auto&& general_distance = build_adaptor.general_distance();
             auto general_accessor = build_adaptor.general_accessor();
 
+            // Entry points for labeled vectors.
+            std::vector<Idx> node_entry_points{};
+
             for (auto node_id : local_indices) {
                 pool.clear();
                 search_buffer.clear();
@@ -334,18 +408,38 @@ class VamanaBuilder {
                 // The search tracker will be used if it is enabled.
                 {
                     auto accessor = build_adaptor.graph_search_accessor();
-                    greedy_search(
-                        graph_,
-                        data_,
-                        accessor,
-                        graph_search_query,
-                        graph_search_distance,
-                        search_buffer,
-                        entry_points,
-                        NeighborBuilder(),
-                        tracker,
-                        prefetch_hint_
-                    );
+                    auto search = [&](const auto& eps, const auto& builder) {
+                        greedy_search(
+                            graph_,
+                            data_,
+                            accessor,
+                            graph_search_query,
+                            graph_search_distance,
+                            search_buffer,
+                            eps,
+                            builder,
+                            tracker,
+                            prefetch_hint_
+                        );
+                    };
+
+                    if (is_labeled(node_id)) {
+                        // Confine the search to the vectors sharing a label with this one.
+                        node_entry_points.clear();
+                        for (auto label : labels_->labels(node_id)) {
+                            node_entry_points.push_back(label_entry_points_[label]);
+                        }
+                        std::sort(node_entry_points.begin(), node_entry_points.end());
+                        node_entry_points.erase(
+                            std::unique(node_entry_points.begin(), node_entry_points.end()),
+                            node_entry_points.end()
+                        );
+                        search(node_entry_points, SubgraphBuilder{[&](Idx i) {
+                                   return labels_->shares_label(node_id, i);
+                               }});
+                    } else {
+                        search(entry_points, NeighborBuilder());
+                    }
                 }
 
                 const auto& post_search_query = build_adaptor.modify_post_search_query(
@@ -413,11 +507,9 @@ class VamanaBuilder {
                 // Prune and wait for an update.
                 thread_local_updates.emplace_back(node_id, std::vector<Idx>{});
                 auto& pruned_results = thread_local_updates.back().second;
-                heuristic_prune_neighbors(
-                    prune_strategy(distance_function_),
+                prune(
                     params_.graph_max_degree,
                     alpha,
-                    data_,
                     general_accessor,
                     general_distance,
                     node_id,
@@ -518,11 +610,9 @@ class VamanaBuilder {
                             std::min(candidates.size(), params_.max_candidate_pool_size)
                         );
 
-                        heuristic_prune_neighbors(
-                            prune_strategy(distance_function_),
+                        prune(
                             params_.prune_to,
                             alpha,
-                            data_,
                             general_accessor,
                             general_distance,
                             src,
@@ -537,6 +627,51 @@ class VamanaBuilder {
     }
 
   private:
+    // Return whether candidate generation and pruning for `node_id` use its labels.
+    bool is_labeled(size_t node_id) const {
+        return labels_ != nullptr && !labels_->labels(node_id).empty();
+    }
+
+    // Prune the candidates for `node_id`, preserving label connectivity if labeled.
+    template <typename Accessor, typename Distance, typename Neighbors>
+    void prune(
+        size_t max_result_size,
+        float alpha,
+        const Accessor& accessor,
+        Distance& distance,
+        size_t node_id,
+        std::span<const Neighbors> pool,
+        std::vector<Idx>& result
+    ) const {
+        auto strategy = prune_strategy(distance_function_);
+        if (is_labeled(node_id)) {
+            heuristic_prune_neighbors(
+                strategy,
+                max_result_size,
+                alpha,
+                data_,
+                accessor,
+                distance,
+                node_id,
+                pool,
+                result,
+                LabelPreservingPrune{*labels_}
+            );
+        } else {
+            heuristic_prune_neighbors(
+                strategy,
+                max_result_size,
+                alpha,
+                data_,
+                accessor,
+                distance,
+                node_id,
+                pool,
+                result
+            );
+        }
+    }
+
     /// The graph being constructed.
     Graph& graph_;
     /// The dataset we're building the graph over.
@@ -553,5 +688,9 @@ class VamanaBuilder {
     std::vector<SpinLock> vertex_locks_;
     /// Overflow backedge buffer.
     BackedgeBuffer<Idx> backedge_buffer_;
+    /// Optional labels of each vector.
+    const VectorLabels* labels_ = nullptr;
+    /// The entry point of each label.
+    std::vector<Idx> label_entry_points_{};
 };
 } // namespace svs::index::vamana
@@ -0,0 +1,475 @@
+/**
+ *    Copyright (C) 2023, Intel Corporation
+ *
+ *    You can redistribute and/or modify this software under the terms of the
+ *    GNU Affero General Public License version 3.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    version 3 along with this software. If not, see
+ *    <https://www.gnu.org/licenses/agpl-3.0.en.html>.
+ */
+
+#pragma once
+
+// svs
+#include "svs/index/vamana/filter.h"
+#include "svs/index/vamana/search_buffer.h"
+#include "svs/lib/neighbor.h"
+#include "svs/lib/preprocessor.h"
+#include "svs/lib/threads/threadlocal.h"
+
+// third-party
+#include <x86intrin.h>
+
+// stl
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+namespace svs::index::vamana {
+
+namespace detail {
+
+template <typename Cmp>
+inline constexpr bool is_vectorizable_compare_v =
+    std::is_same_v<Cmp, std::less<>> || std::is_same_v<Cmp, std::greater<>>;
+
+///
+/// Return the number of leading elements of the sorted range ``[x, x + n)`` that ``Cmp``
+/// does not order after ``value``. This is the position at which ``value`` is inserted
+/// after all elements comparing equal to it.
+///
+/// The range is scanned with vector compares, stopping at the first vector containing an
+/// element ordered after ``value``. The instruction set is chosen at compile time since
+/// this function is inlined into the search loop.
+///
+template <typename Cmp>
+SVS_FORCE_INLINE size_t count_not_after(const float* x, size_t n, float value) {
+    static_assert(is_vectorizable_compare_v<Cmp>);
+#if SVS_AVX512_F
+    constexpr int predicate = std::is_same_v<Cmp, std::less<>> ? _CMP_LE_OQ : _CMP_GE_OQ;
+    constexpr size_t simd_width = 16;
+    constexpr __mmask16 all = 0xFFFF;
+    auto v = _mm512_set1_ps(value);
+    size_t count = 0;
+    size_t i = 0;
+    for (; i + simd_width <= n; i += simd_width) {
+        __mmask16 m = _mm512_cmp_ps_mask(_mm512_loadu_ps(x + i), v, predicate);
+        count += std::popcount(static_cast<uint32_t>(m));
+        if (m != all) {
+            return count;
+        }
+    }
+    if (i < n) {
+        auto tail = static_cast<__mmask16>((uint32_t{1} << (n - i)) - 1);
+        __mmask16 m =
+            _mm512_mask_cmp_ps_mask(tail, _mm512_maskz_loadu_ps(tail, x + i), v, predicate);
+        count += std::popcount(static_cast<uint32_t>(m));
+    }
+    return count;
+#elif SVS_AVX2
+    constexpr int predicate = std::is_same_v<Cmp, std::less<>> ? _CMP_LE_OQ : _CMP_GE_OQ;
+    constexpr size_t simd_width = 8;
+    constexpr int all = 0xFF;
+    auto v = _mm256_set1_ps(value);
+    size_t count = 0;
+    size_t i = 0;
+    for (; i + simd_width <= n; i += simd_width) {
+        int m = _mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(x + i), v, predicate));
+        count += std::popcount(static_cast<uint32_t>(m));
+        if (m != all) {
+            return count;
+        }
+    }
+    auto cmp = Cmp{};
+    while (i < n && !cmp(value, x[i])) {
+        ++count;
+        ++i;
+    }
+    return count;
+#else
+    return std::upper_bound(x, x + n, value, Cmp{}) - x;
+#endif
+}
+
+} // namespace detail
+
+///
+/// @brief Search buffer for static greedy search storing distances and IDs separately.
+///
+/// @tparam Idx Type used to uniquely identify DB vectors
+/// @tparam Cmp Type of the comparison function used to sort neighbors by distance.
+///
+/// Behaves identically to ``SearchBuffer``, but keeps the distances, IDs, and visited flags
+/// of its candidates in separate contiguous arrays. The insertion position of a candidate
+/// is found by comparing its distance against a full SIMD register of stored distances at
+/// a time and shifting the candidates after it moves densely packed arrays.
+///
+/// Elements are returned by value, so the contents of the buffer cannot be modified through
+/// ``operator[]``. This makes the buffer unsuitable for datasets that rerank search results
+/// in place.
+///
+template <typename Idx, typename Cmp = std::less<>> class VectorizedSearchBuffer {
+  public:
+    // External type aliases
+    using value_type = SearchNeighbor<Idx>;
+    using compare_type = Cmp;
+
+    template <typename T>
+    using vector_type = std::vector<T, threads::CacheAlignedAllocator<T>>;
+
+    /// A visited filter with 65,535 entries with a memory footpring of 128 kiB.
+    using set_type = VisitedFilter<Idx, 16>;
+    /// An exact visited set with constant time reset.
+    using exact_set_type = VisitedTable<Idx>;
+
+    ///
+    /// @brief Initialize a buffer with zero capacity.
+    ///
+    /// In order to use a buffer that has been default constructed, use the
+    /// @ref change_maxsize(size_t) method.
+    ///
+    VectorizedSearchBuffer() = default;
+
+    ///
+    /// @brief Construct a search buffer with the target capacity and comparison function.
+    ///
+    /// @param config The configuration for split region of interest (ROI) size and total
+    ///     capacity.
+    /// @param compare The functor used to compare two ``SearchNeighbor``s together.
+    /// @param enable_visited Whether or not the visited set is enabled.
+    /// @param exact_visited Whether an enabled visited set should be exact.
+    ///
+    explicit VectorizedSearchBuffer(
+        SearchBufferConfig config,
+        Cmp compare = {},
+        bool enable_visited = false,
+        bool exact_visited = false
+    )
+        : compare_{std::move(compare)}
+        , search_window_size_{config.get_search_window_size()}
+        , capacity_{config.get_total_capacity()}
+        , distances_(capacity_ + 1)
+        , ids_(capacity_ + 1)
+        , visited_flags_(capacity_ + 1) {
+        if (enable_visited) {
+            if (exact_visited) {
+                enable_exact_visited_set();
+            } else {
+                enable_visited_set();
+            }
+        }
+    }
+
+    ///
+    /// @brief Construct a search buffer with the target capacity and comparison function.
+    ///
+    /// @param size The number of valid elements to return from a search operation.
+    /// @param compare The functor used to compare two ``SearchNeighbor``s together.
+    /// @param enable_visited Whether or not the visited set is enabled.
+    ///
+    explicit VectorizedSearchBuffer(
+        size_t size, Cmp compare = Cmp{}, bool enable_visited = false
+    )
+        : VectorizedSearchBuffer{
+              SearchBufferConfig(size), std::move(compare), enable_visited} {}
+
+    ///
+    /// @brief Perform an efficient copy.
+    ///
+    /// Perserves the sizes of various containers but not necessarily the values.
+    ///
+    VectorizedSearchBuffer shallow_copy() const {
+        return VectorizedSearchBuffer{
+            config(), compare_, visited_set_enabled(), exact_visited_set_enabled()};
+    }
+
+    SearchBufferConfig config() const {
+        return SearchBufferConfig{search_window_size_, capacity_};
+    }
+
+    ///
+    /// @brief Change the target number of elements to return after search.
+    ///
+    /// @param new_size The new number of elements to return.
+    ///
+    /// Post conditions
+    /// - The capacity of the search buffer will be set to the new size.
+    /// - The actual size (number of valid elements) will be the minimum of the current
+    ///   size and the new size.
+    ///
+    void change_maxsize(size_t new_size) {
+        search_window_size_ = new_size;
+        capacity_ = new_size;
+        resize_storage();
+        size_ = std::min(size_, new_size);
+    }
+
+    ///
+    /// @brief Change the target number of elements to return after search.
+    ///
+    /// @param config The new configuration for the buffer.
+    ///
+    void change_maxsize(SearchBufferConfig config) {
+        search_window_size_ = config.get_search_window_size();
+        capacity_ = config.get_total_capacity();
+        resize_storage();
+        size_ = std::min(size_, capacity_);
+    }
+
+    ///
+    /// @brief Increase the search window size and capacity while preserving the contents.
+    ///
+    /// @param new_size The new search window size and capacity. Must be at least the
+    ///     current capacity.
+    ///
+    void grow(size_t new_size) {
+        assert(new_size >= capacity_);
+        search_window_size_ = new_size;
+        capacity_ = new_size;
+        resize_storage();
+        while (best_unvisited_ < size_ && visited_flags_[best_unvisited_]) {
+            ++best_unvisited_;
+        }
+    }
+
+    ///
+    /// @brief Prepare the buffer for a new search operation.
+    ///
+    void clear() {
+        size_ = 0;
+        best_unvisited_ = 0;
+        if (visited_) {
+            visited_->reset();
+        } else if (exact_visited_) {
+            exact_visited_->reset();
+        }
+    }
+
+    /// @brief Return the current number of valid elements in the buffer.
+    size_t size() const { return size_; }
+
+    /// @brief Return the maximum number of neighbors that can be held by the buffer.
+    size_t capacity() const { return capacity_; }
+
+    /// @brief Return whether or not the buffer is full of valid elements.
+    bool full() const { return size() == capacity(); }
+
+    /// @brief Return the neighbor at position `i`.
+    value_type operator[](size_t i) const {
+        return value_type{ids_[i], distances_[i], visited_flags_[i] != 0};
+    }
+
+    /// @brief Return the furtherst valid neighbor.
+    value_type back() const { return (*this)[size_ - 1]; }
+
+    /// @brief Return the position of the best unvisited neighbor.
+    size_t best_unvisited() const { return best_unvisited_; }
+
+    ///
+    /// @brief Return `true` if the search buffer has reached its terminating condition.
+    ///
+    bool done() const { return best_unvisited_ == std::min(size_, search_window_size_); }
+
+    ///
+    /// @brief Return the best unvisited neighbor in the buffer and mark it as visited.
+    ///
+    /// Pre-conditions:
+    /// * `search_buffer.done()` must evaluate to `false`.
+    ///
+    value_type next() {
+        size_t i = best_unvisited_;
+        visited_flags_[i] = 1;
+        size_t upper = std::min(size(), search_window_size_);
+        while (++best_unvisited_ != upper && visited_flags_[best_unvisited_]) {}
+        return value_type{ids_[i], distances_[i], true};
+    }
+
+    ///
+    /// @brief Place the neighbor at the end of the search buffer if `full() != true`.
+    ///
+    /// Otherwise, do nothing.
+    ///
+    void push_back(value_type neighbor) {
+        if (!full()) {
+            store(size_, neighbor);
+            ++size_;
+        }
+    }
+
+    ///
+    /// @brief Return ``true`` if a neighbor with the given distance can be skipped.
+    ///
+    bool can_skip(float distance) const {
+        return full() && compare_(distances_[size_ - 1], distance);
+    }
+
+    ///
+    /// @brief Insert the neighbor into the buffer.
+    ///
+    /// @param neighbor The neighbor to insert.
+    ///
+    /// @returns The position where the neighbor was inserted. If the neighbor was not
+    ///     inserted, returns ``size()`` if it is too far away and ``size() + 1`` if it is
+    ///     already present.
+    ///
+    size_t insert(value_type neighbor) {
+        if (can_skip(neighbor.distance())) {
+            return size();
+        }
+        return insert_inner(neighbor);
+    }
+
+    size_t insert_inner(value_type neighbor) {
+        const float distance = neighbor.distance();
+        const size_t i = insertion_point(distance);
+
+        // Repeat IDs have the same distance, so only the entries immediately before the
+        // insertion point comparing equal to the new neighbor need to be checked.
+        for (size_t j = i; j != 0; --j) {
+            if (compare_(distances_[j - 1], distance)) {
+                break;
+            }
+            if (ids_[j - 1] == neighbor.id()) {
+                return size() + 1;
+            }
+        }
+
+        // Shift the tail of the buffer back by one. The storage is one longer than the
+        // capacity, so shifting out the last element of a full buffer is safe.
+        auto shift = [&](auto& v) {
+            std::copy_backward(v.begin() + i, v.begin() + size_, v.begin() + size_ + 1);
+        };
+        shift(distances_);
+        shift(ids_);
+        shift(visited_flags_);
+        store(i, neighbor);
+        size_ = std::min(size_ + 1, capacity());
+        best_unvisited_ = std::min(best_unvisited_, i);
+        return i;
+    }
+
+    ///
+    /// @brief Sort the elements in the buffer according to the internal comparison functor.
+    ///
+    void sort() {
+        scratch_.resize(size_);
+        for (size_t i = 0; i < size_; ++i) {
+            scratch_[i] = (*this)[i];
+        }
+        std::sort(scratch_.begin(), scratch_.end(), compare_);
+        for (size_t i = 0; i < size_; ++i) {
+            store(i, scratch_[i]);
+        }
+    }
+
+    ///
+    /// @brief Discard all but the first ``n`` elements in the buffer.
+    ///
+    void truncate(size_t n) {
+        size_ = std::min(size_, n);
+        best_unvisited_ = std::min(best_unvisited_, size_);
+    }
+
+    ///// Visited API
+
+    bool visited_set_enabled() const {
+        return visited_.has_value() || exact_visited_.has_value();
+    }
+    bool exact_visited_set_enabled() const { return exact_visited_.has_value(); }
+
+    void enable_visited_set() {
+        exact_visited_.reset();
+        if (!visited_) {
+            visited_.emplace();
+        }
+    }
+    void enable_exact_visited_set() {
+        visited_.reset();
+        if (!exact_visited_) {
+            exact_visited_.emplace();
+        }
+    }
+    void disable_visited_set() {
+        visited_.reset();
+        exact_visited_.reset();
+    }
+
+    bool is_visited(Idx i) const { return visited_set_enabled() && unsafe_is_visited(i); }
+    void prefetch_visited(Idx i) const {
+        if (visited_set_enabled()) {
+            unsafe_prefetch_visited(i);
+        }
+    }
+    bool emplace_visited(Idx i) {
+        return visited_set_enabled() && unsafe_emplace_visited(i);
+    }
+
+    // Unsafe implementations.
+    bool unsafe_is_visited(Idx i) const {
+        assert(visited_set_enabled());
+        return exact_visited_ ? exact_visited_->contains(i) : visited_->contains(i);
+    }
+    void unsafe_prefetch_visited(Idx i) const {
+        assert(visited_set_enabled());
+        if (exact_visited_) {
+            exact_visited_->prefetch(i);
+        } else {
+            visited_->prefetch(i);
+        }
+    }
+    bool unsafe_emplace_visited(Idx i) {
+        assert(visited_set_enabled());
+        return exact_visited_ ? exact_visited_->emplace(i) : visited_->emplace(i);
+    }
+
+  private:
+    // Return the position after all stored neighbors not ordered after `distance`.
+    size_t insertion_point(float distance) const {
+        if constexpr (detail::is_vectorizable_compare_v<Cmp>) {
+            return detail::count_not_after<Cmp>(distances_.data(), size_, distance);
+        } else {
+            auto begin = distances_.begin();
+            return std::upper_bound(begin, begin + size_, distance, compare_) - begin;
+        }
+    }
+
+    void store(size_t i, value_type neighbor) {
+        distances_[i] = neighbor.distance();
+        ids_[i] = neighbor.id();
+        visited_flags_[i] = neighbor.visited();
+    }
+
+    void resize_storage() {
+        distances_.resize(capacity_ + 1);
+        ids_.resize(capacity_ + 1);
+        visited_flags_.resize(capacity_ + 1);
+    }
+
+    // The comparison functor.
+    [[no_unique_address]] Cmp compare_ = Cmp{};
+    // The current number of valid neighbors.
+    size_t size_ = 0;
+    // The index of the lowest (w.r.t ``compare_`) unvisited neighbor.
+    size_t best_unvisited_ = 0;
+    // The size of region of interest (determines stopping conditions).
+    size_t search_window_size_ = 0;
+    // The maximum capacity of the buffer.
+    size_t capacity_ = 0;
+    // Storage for the neighbors. Each array is one longer than the capacity.
+    vector_type<float> distances_ = {};
+    vector_type<Idx> ids_ = {};
+    vector_type<uint8_t> visited_flags_ = {};
+    // Scratch space for sorting.
+    std::vector<value_type> scratch_ = {};
+    // The visited sets. At most one is enabled.
+    std::optional<set_type> visited_{std::nullopt};
+    std::optional<exact_set_type> exact_visited_{std::nullopt};
+};
+
+} // namespace svs::index::vamana
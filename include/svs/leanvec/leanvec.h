@@ -1217,8 +1217,9 @@ struct LeanVecLoader {
                         source.type,
                         [&]<typename V>(lib::Type<V> SVS_UNUSED(type)) {
                             using rebind_type = lib::rebind_allocator_t<V, Alloc>;
+                            using source_type = data::SimpleData<V, Extent, rebind_type>;
                             return loaded_type::reduce(
-                                data::SimpleData<V, Extent, rebind_type>::load(source.path),
+                                source_type::load(source.path, threadpool),
                                 matrices_,
                                 threadpool,
                                 alignment_,
@@ -0,0 +1,139 @@
+/**
+ *    Copyright (C) 2023, Intel Corporation
+ *
+ *    You can redistribute and/or modify this software under the terms of the
+ *    GNU Affero General Public License version 3.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    version 3 along with this software. If not, see
+ *    <https://www.gnu.org/licenses/agpl-3.0.en.html>.
+ */
+
+#pragma once
+
+// svs
+#include "svs/lib/exception.h"
+#include "svs/lib/preprocessor.h"
+
+// stl
+#include <array>
+#include <cstdlib>
+#include <string_view>
+
+namespace svs::arch {
+
+///
+/// @brief Instruction set levels for which distance kernels may be compiled.
+///
+/// Levels are ordered such that a processor supporting a level also supports all lower
+/// levels.
+///
+enum class ISA {
+    /// Portable C++ implementation.
+    generic,
+    /// Intel(R) AVX2 with FMA and F16C.
+    avx2,
+    /// Intel(R) AVX-512 F, VL, BW, and DQ.
+    avx512f,
+    /// All of the above plus Intel(R) AVX-512 VNNI.
+    avx512vnni,
+    /// All of the above plus Intel(R) AVX-512 BF16.
+    avx512bf16,
+};
+
+/// All instruction set levels in increasing order.
+inline constexpr std::array<ISA, 5> all_isas = {
+    ISA::generic, ISA::avx2, ISA::avx512f, ISA::avx512vnni, ISA::avx512bf16};
+
+inline constexpr std::string_view name(ISA isa) {
+    switch (isa) {
+        case ISA::generic: {
+            return "generic";
+        }
+        case ISA::avx2: {
+            return "avx2";
+        }
+        case ISA::avx512f: {
+            return "avx512f";
+        }
+        case ISA::avx512vnni: {
+            return "avx512vnni";
+        }
+        case ISA::avx512bf16: {
+            return "avx512bf16";
+        }
+    }
+    throw ANNEXCEPTION("Unknown ISA!");
+}
+
+inline ISA parse_isa(std::string_view str) {
+    for (auto isa : all_isas) {
+        if (name(isa) == str) {
+            return isa;
+        }
+    }
+    throw ANNEXCEPTION("Unknown ISA name: {}!", str);
+}
+
+///
+/// @brief Return the highest instruction set level supported by the host processor.
+///
+inline ISA detect_isa() {
+    // Keep the feature lists in-sync with the `SVS_BEGIN_TARGET_*` macros.
+    __builtin_cpu_init();
+    bool avx2 = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    if (!avx2) {
+        return ISA::generic;
+    }
+
+    bool avx512 = __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vl") &&
+                  __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512dq");
+    if (!avx512) {
+        return ISA::avx2;
+    }
+    if (!__builtin_cpu_supports("avx512vnni")) {
+        return ISA::avx512f;
+    }
+    return __builtin_cpu_supports("avx512bf16") ? ISA::avx512bf16 : ISA::avx512vnni;
+}
+
+///
+/// @brief Return the instruction set level used by runtime-dispatched kernels.
+///
+/// This is the level returned by ``detect_isa()``, optionally lowered by setting the
+/// environment variable ``SVS_MAX_ISA`` to one of "generic", "avx2", "avx512f",
+/// "avx512vnni", or "avx512bf16". Requesting a level higher than the host supports has no
+/// effect.
+///
+/// The result is computed once per process. Kernels resolve their implementation the first
+/// time they are called, so the environment variable must be set before then.
+///
+inline ISA runtime_isa() {
+    static const ISA isa = []() {
+        auto detected = detect_isa();
+        const char* cap = std::getenv("SVS_MAX_ISA");
+        if (cap == nullptr) {
+            return detected;
+        }
+        auto requested = parse_isa(cap);
+        return requested < detected ? requested : detected;
+    }();
+    return isa;
+}
+
+///
+/// @brief Return whether kernels compiled for ``isa`` may execute in this build.
+///
+/// In runtime dispatch builds, this depends on the host processor. Otherwise, kernels are
+/// only compiled for extensions enabled by the compiler flags and thus may always execute.
+///
+inline bool is_supported(ISA isa) {
+#if SVS_RUNTIME_DISPATCH
+    return isa <= runtime_isa();
+#else
+    (void)isa;
+    return true;
+#endif
+}
+
+} // namespace svs::arch
@@ -0,0 +1,129 @@
+/**
+ *    Copyright (C) 2023, Intel Corporation
+ *
+ *    You can redistribute and/or modify this software under the terms of the
+ *    GNU Affero General Public License version 3.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    version 3 along with this software. If not, see
+ *    <https://www.gnu.org/licenses/agpl-3.0.en.html>.
+ */
+
+#pragma once
+
+#include "svs/lib/narrow.h"
+#include "svs/lib/type_traits.h"
+#include "svs/third-party/fmt.h"
+
+#include <bit>
+#include <cstdint>
+#include <iostream>
+#include <type_traits>
+
+namespace svs {
+namespace bfloat16 {
+namespace detail {
+
+// The "brain" floating point format keeps the sign, the full 8-bit exponent, and the top
+// 7 bits of the mantissa of an IEEE single precision number.
+//
+// Widening is therefore exact and amounts to shifting the bit pattern into the upper half
+// of a 32-bit word.
+inline float bfloat16_to_float_untyped(const uint16_t x) {
+    return std::bit_cast<float>(static_cast<uint32_t>(x) << 16);
+}
+
+// Narrow with round-to-nearest-even.
+//
+// Rounding is implemented by adding `0x7FFF` plus the least significant retained bit to
+// the 32-bit pattern before truncating. NaNs are handled separately to prevent rounding
+// from turning a NaN with a small payload into infinity.
+inline uint16_t float_to_bfloat16_untyped(const float x) {
+    const uint32_t u = std::bit_cast<uint32_t>(x);
+    if ((u & 0x7FFFFFFF) > 0x7F800000) {
+        // Keep the sign and force a quiet NaN.
+        return static_cast<uint16_t>((u >> 16) | 0x0040);
+    }
+    const uint32_t rounding_bias = 0x00007FFF + ((u >> 16) & 1);
+    return static_cast<uint16_t>((u + rounding_bias) >> 16);
+}
+} // namespace detail
+
+// On GCC - we need to add this attribute so that BFloat16 members can appear inside
+// packed structs.
+class __attribute__((packed)) BFloat16 {
+  public:
+    BFloat16() = default;
+
+    // converting constructors
+    explicit BFloat16(float x)
+        : value_{detail::float_to_bfloat16_untyped(x)} {}
+    explicit BFloat16(double x)
+        : BFloat16(lib::narrow_cast<float>(x)) {}
+    explicit BFloat16(size_t x)
+        : BFloat16(lib::narrow<float>(x)) {}
+    explicit BFloat16(int x)
+        : BFloat16(lib::narrow<float>(x)) {}
+
+    // conversion functions
+    operator float() const { return detail::bfloat16_to_float_untyped(value_); }
+    BFloat16& operator=(float x) {
+        value_ = detail::float_to_bfloat16_untyped(x);
+        return *this;
+    }
+
+    // Allow users to set and expect the contents of the class as a uint16_t using an
+    // explicit API.
+    static BFloat16 from_raw(uint16_t value) { return BFloat16{value, FromRawTag{}}; }
+    uint16_t raw() const { return value_; }
+
+  private:
+    // Use a tag to construct from a raw value in order to still allow a constructor
+    // for a lone `uint16_t`.
+    struct FromRawTag {};
+    explicit BFloat16(uint16_t value, FromRawTag /*unused*/)
+        : value_{value} {}
+    uint16_t value_;
+};
+static_assert(std::is_trivial_v<BFloat16>);
+static_assert(std::is_standard_layout_v<BFloat16>);
+static_assert(sizeof(BFloat16) == sizeof(uint16_t));
+
+/////
+///// Operators
+/////
+
+// For equality, still use `float` rather than the underlying bit pattern to handle cases
+// like signed zeros.
+inline bool operator==(BFloat16 x, BFloat16 y) { return float{x} == float{y}; }
+
+} // namespace bfloat16
+
+using BFloat16 = bfloat16::BFloat16;
+
+// SVS local arithmetric trait.
+template <> inline constexpr bool is_arithmetic_v<BFloat16> = true;
+template <> inline constexpr bool is_signed_v<BFloat16> = true;
+template <> inline constexpr bool allow_lossy_conversion<float, BFloat16> = true;
+
+} // namespace svs
+
+// Apply hashing to `BFloat16`
+namespace std {
+template <> struct hash<svs::BFloat16> {
+    inline std::size_t operator()(const svs::BFloat16& x) const noexcept {
+        return std::hash<float>()(x);
+    }
+};
+} // namespace std
+
+// Formatting and Printing
+template <> struct fmt::formatter<svs::BFloat16> : svs::format_empty {
+    auto format(svs::BFloat16 x, auto& ctx) const {
+        return fmt::format_to(ctx.out(), "{}bf16", float{x});
+    }
+};
+
+inline std::ostream& operator<<(std::ostream& stream, svs::BFloat16 x) {
+    return stream << fmt::format("{}", x);
+}
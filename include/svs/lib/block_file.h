@@ -0,0 +1,491 @@
+/**
+ *    Copyright (C) 2023, Intel Corporation
+ *
+ *    You can redistribute and/or modify this software under the terms of the
+ *    GNU Affero General Public License version 3.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    version 3 along with this software. If not, see
+ *    <https://www.gnu.org/licenses/agpl-3.0.en.html>.
+ */
+
+#pragma once
+
+// svs
+#include "svs/lib/exception.h"
+#include "svs/lib/file.h"
+#include "svs/lib/misc.h"
+#include "svs/lib/narrow.h"
+
+// stl
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <memory>
+#include <new>
+#include <span>
+#include <utility>
+#include <vector>
+
+// posix
+#include <fcntl.h>
+#include <unistd.h>
+
+// Batched reads are submitted through io_uring where the kernel headers provide it.
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define SVS_HAS_IO_URING 1
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#else
+#define SVS_HAS_IO_URING 0
+#endif
+
+namespace svs::lib {
+
+///
+/// @brief Read-only file supporting concurrent positional reads.
+///
+/// Reads are issued with ``pread`` and so do not share a file offset, making a single
+/// ``BlockFile`` safe to read from multiple threads.
+///
+/// When opened for direct I/O, reads bypass the operating system page cache. In that case,
+/// the destination, offset and length of each read must be aligned to the logical block
+/// size of the underlying device (a multiple of 4096 bytes is always sufficient).
+/// File systems that do not support direct I/O fall back to buffered reads.
+///
+class BlockFile {
+  public:
+    /// @brief Construct a closed file.
+    BlockFile() = default;
+
+    ///
+    /// @brief Open ``path`` for reading.
+    ///
+    /// @param path The file to open.
+    /// @param direct Request direct I/O bypassing the page cache.
+    ///
+    explicit BlockFile(const std::filesystem::path& path, bool direct = false) {
+        check_file(path, file_flags::open_read);
+        size_ = std::filesystem::file_size(path);
+#ifdef O_DIRECT
+        if (direct) {
+            fd_ = ::open(path.c_str(), O_RDONLY | O_DIRECT);
+            direct_ = fd_ != -1;
+        }
+#endif
+        if (fd_ == -1) {
+            fd_ = ::open(path.c_str(), O_RDONLY);
+        }
+        if (fd_ == -1) {
+            throw ANNEXCEPTION("Could not open file {}: {}!", path, std::strerror(errno));
+        }
+    }
+
+    BlockFile(const BlockFile&) = delete;
+    BlockFile& operator=(const BlockFile&) = delete;
+    BlockFile(BlockFile&& other) noexcept
+        : fd_{std::exchange(other.fd_, -1)}
+        , size_{other.size_}
+        , direct_{other.direct_} {}
+    BlockFile& operator=(BlockFile&& other) noexcept {
+        if (this != &other) {
+            close();
+            fd_ = std::exchange(other.fd_, -1);
+            size_ = other.size_;
+            direct_ = other.direct_;
+        }
+        return *this;
+    }
+    ~BlockFile() { close(); }
+
+    /// @brief Return whether the file is open.
+    bool is_open() const { return fd_ != -1; }
+    /// @brief Return the size of the file in bytes.
+    size_t size() const { return size_; }
+    /// @brief Return whether reads bypass the page cache.
+    bool direct() const { return direct_; }
+
+    ///
+    /// @brief Read ``bytes`` bytes starting at ``offset`` into ``dst``.
+    ///
+    /// Throws ``svs::ANNException`` if the read fails or extends past the end of the file.
+    ///
+    void read(void* dst, size_t bytes, size_t offset) const {
+        auto count = read_some(dst, bytes, offset);
+        if (count != bytes) {
+            throw ANNEXCEPTION(
+                "Reading {} bytes at offset {} failed: unexpected end of file!",
+                bytes,
+                offset
+            );
+        }
+    }
+
+    ///
+    /// @brief Read up to ``bytes`` bytes starting at ``offset`` into ``dst``.
+    ///
+    /// Reading stops early at the end of the file. Direct I/O reads must still request
+    /// a block aligned number of bytes, even when the file ends before that.
+    ///
+    /// Returns the number of bytes read.
+    /// Throws ``svs::ANNException`` if the read fails.
+    ///
+    size_t read_some(void* dst, size_t bytes, size_t offset) const {
+        auto* ptr = static_cast<std::byte*>(dst);
+        size_t total = 0;
+        while (total != bytes) {
+            auto count =
+                ::pread(fd_, ptr + total, bytes - total, lib::narrow<off_t>(offset + total));
+            if (count == -1 && errno == EINTR) {
+                continue;
+            }
+            if (count == -1) {
+                throw ANNEXCEPTION(
+                    "Reading {} bytes at offset {} failed: {}!",
+                    bytes,
+                    offset,
+                    std::strerror(errno)
+                );
+            }
+            if (count == 0) {
+                break;
+            }
+            total += lib::narrow_cast<size_t>(count);
+        }
+        return total;
+    }
+
+  private:
+    friend class BatchReader;
+
+    void close() {
+        if (fd_ != -1) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+
+    int fd_ = -1;
+    size_t size_ = 0;
+    bool direct_ = false;
+};
+
+/// @brief A read of ``bytes`` bytes at file offset ``offset`` into ``dst``.
+struct BlockRead {
+    void* dst;
+    size_t bytes;
+    size_t offset;
+};
+
+///
+/// @brief Issues batches of reads from a ``BlockFile`` concurrently.
+///
+/// All reads of a batch are submitted to an io_uring submission queue at once and the
+/// caller waits a single time for all of them to complete, so the device can serve the
+/// whole batch in parallel. Each reader owns its own queue and must not be shared between
+/// threads.
+///
+/// If io_uring is unavailable, for example on other platforms, older kernels, or when it
+/// is disabled by a sandbox, reads fall back to sequential ``pread`` calls.
+///
+class BatchReader {
+  public:
+    /// @brief Construct a reader issuing reads sequentially.
+    BatchReader() = default;
+
+    ///
+    /// @brief Construct a reader submitting up to ``queue_depth`` reads at once.
+    ///
+    /// @param queue_depth The largest number of reads in flight. Larger batches are
+    ///     submitted in several rounds.
+    /// @param async Use io_uring if the system supports it. Otherwise, always read
+    ///     sequentially.
+    ///
+    explicit BatchReader(size_t queue_depth, bool async = true)
+        : queue_depth_{queue_depth} {
+#if SVS_HAS_IO_URING
+        if (async && queue_depth != 0) {
+            ring_.setup(lib::narrow<unsigned>(queue_depth));
+        }
+#else
+        (void)async;
+#endif
+    }
+
+    /// @brief Return the queue depth requested at construction.
+    size_t queue_depth() const { return queue_depth_; }
+
+    /// @brief Return whether reads are submitted concurrently.
+    bool async() const {
+#if SVS_HAS_IO_URING
+        return ring_.is_open();
+#else
+        return false;
+#endif
+    }
+
+    ///
+    /// @brief Perform all ``reads`` from ``file``, returning once all have completed.
+    ///
+    /// Each read follows the requirements of ``BlockFile::read()``.
+    /// Throws ``svs::ANNException`` if a read fails or extends past the end of the file.
+    ///
+    void read(const BlockFile& file, std::span<const BlockRead> reads) {
+#if SVS_HAS_IO_URING
+        if (ring_.is_open()) {
+            for (size_t start = 0; start < reads.size(); start += ring_.entries()) {
+                size_t count = std::min<size_t>(ring_.entries(), reads.size() - start);
+                ring_.read(file, reads.subspan(start, count));
+            }
+            return;
+        }
+#endif
+        for (const auto& r : reads) {
+            file.read(r.dst, r.bytes, r.offset);
+        }
+    }
+
+  private:
+#if SVS_HAS_IO_URING
+    // Minimal io_uring submission and completion queue pair used for batches of reads.
+    class Ring {
+      public:
+        Ring() = default;
+        Ring(const Ring&) = delete;
+        Ring& operator=(const Ring&) = delete;
+        Ring(Ring&& other) noexcept { *this = std::move(other); }
+        Ring& operator=(Ring&& other) noexcept {
+            if (this != &other) {
+                close();
+                fd_ = std::exchange(other.fd_, -1);
+                params_ = other.params_;
+                sq_map_ = std::exchange(other.sq_map_, Mapping{});
+                cq_map_ = std::exchange(other.cq_map_, Mapping{});
+                sqe_map_ = std::exchange(other.sqe_map_, Mapping{});
+            }
+            return *this;
+        }
+        ~Ring() { close(); }
+
+        // Create the queues. The ring stays closed if the system does not support it.
+        void setup(unsigned entries) {
+            auto params = io_uring_params{};
+            int fd = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+            if (fd < 0) {
+                return;
+            }
+            fd_ = fd;
+            params_ = params;
+            size_t sq_bytes = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+            size_t cq_bytes =
+                params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+            bool single = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+            if (single) {
+                sq_bytes = cq_bytes = std::max(sq_bytes, cq_bytes);
+            }
+            sq_map_ = map(sq_bytes, IORING_OFF_SQ_RING);
+            cq_map_ = single ? Mapping{sq_map_.ptr, 0} : map(cq_bytes, IORING_OFF_CQ_RING);
+            sqe_map_ = map(params.sq_entries * sizeof(io_uring_sqe), IORING_OFF_SQES);
+            if (sq_map_.ptr == nullptr || cq_map_.ptr == nullptr ||
+                sqe_map_.ptr == nullptr) {
+                close();
+            }
+        }
+
+        bool is_open() const { return fd_ != -1; }
+        size_t entries() const { return params_.sq_entries; }
+
+        // Submit all `reads`, which must fit in the submission queue, and wait for them.
+        void read(const BlockFile& file, std::span<const BlockRead> reads) {
+            auto* sqes = static_cast<io_uring_sqe*>(sqe_map_.ptr);
+            const unsigned mask = *sq_field(params_.sq_off.ring_mask);
+            unsigned tail = *sq_field(params_.sq_off.tail);
+            for (size_t i = 0; i < reads.size(); ++i) {
+                const auto& r = reads[i];
+                unsigned slot = tail & mask;
+                auto& sqe = sqes[slot];
+                std::memset(&sqe, 0, sizeof(sqe));
+                sqe.opcode = IORING_OP_READ;
+                sqe.fd = file.fd_;
+                sqe.addr = reinterpret_cast<uintptr_t>(r.dst);
+                sqe.len = lib::narrow<uint32_t>(r.bytes);
+                sqe.off = r.offset;
+                sqe.user_data = i;
+                sq_field(params_.sq_off.array)[slot] = slot;
+                ++tail;
+            }
+            std::atomic_ref<unsigned>(*sq_field(params_.sq_off.tail))
+                .store(tail, std::memory_order_release);
+
+            // Submit and wait for completions. A single call normally suffices, but the
+            // wait may be interrupted by signals.
+            //
+            // A failed read is reported only once every read of the batch has completed,
+            // so that the kernel no longer writes into the destination buffers.
+            size_t to_submit = reads.size();
+            size_t completed = 0;
+            auto error = std::exception_ptr();
+            while (completed != reads.size()) {
+                long ret = ::syscall(
+                    __NR_io_uring_enter,
+                    fd_,
+                    static_cast<unsigned>(to_submit),
+                    static_cast<unsigned>(reads.size() - completed),
+                    IORING_ENTER_GETEVENTS,
+                    nullptr,
+                    0
+                );
+                if (ret < 0 && errno != EINTR) {
+                    throw ANNEXCEPTION(
+                        "Submitting {} reads failed: {}!",
+                        reads.size(),
+                        std::strerror(errno)
+                    );
+                }
+                if (ret > 0) {
+                    to_submit -= std::min(to_submit, static_cast<size_t>(ret));
+                }
+                completed += reap(file, reads, error);
+            }
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+
+      private:
+        struct Mapping {
+            void* ptr = nullptr;
+            size_t bytes = 0;
+        };
+
+        Mapping map(size_t bytes, uint64_t offset) const {
+            void* ptr = ::mmap(
+                nullptr,
+                bytes,
+                PROT_READ | PROT_WRITE,
+                MAP_SHARED | MAP_POPULATE,
+                fd_,
+                lib::narrow<off_t>(offset)
+            );
+            return ptr == MAP_FAILED ? Mapping{} : Mapping{ptr, bytes};
+        }
+
+        // Return the ring field at byte ``offset`` of a queue mapping.
+        static unsigned* field(const Mapping& mapping, uint32_t offset) {
+            auto* base = static_cast<std::byte*>(mapping.ptr);
+            return reinterpret_cast<unsigned*>(base + offset);
+        }
+        unsigned* sq_field(uint32_t offset) const { return field(sq_map_, offset); }
+        unsigned* cq_field(uint32_t offset) const { return field(cq_map_, offset); }
+
+        // Consume the available completions, returning how many there were.
+        // Reads the kernel did not finish, such as short reads, are completed with
+        // ``pread``. The first error is stored in ``error``.
+        size_t reap(
+            const BlockFile& file,
+            std::span<const BlockRead> reads,
+            std::exception_ptr& error
+        ) {
+            auto head_ref = std::atomic_ref<unsigned>(*cq_field(params_.cq_off.head));
+            auto tail_ref = std::atomic_ref<unsigned>(*cq_field(params_.cq_off.tail));
+            const unsigned mask = *cq_field(params_.cq_off.ring_mask);
+            const auto* cqes = reinterpret_cast<const io_uring_cqe*>(
+                static_cast<std::byte*>(cq_map_.ptr) + params_.cq_off.cqes
+            );
+            unsigned head = head_ref.load(std::memory_order_relaxed);
+            unsigned tail = tail_ref.load(std::memory_order_acquire);
+            size_t count = 0;
+            for (; head != tail; ++head, ++count) {
+                const auto& cqe = cqes[head & mask];
+                const auto& r = reads[cqe.user_data];
+                size_t done = cqe.res < 0 ? 0 : static_cast<size_t>(cqe.res);
+                if (done != r.bytes && !error) {
+                    try {
+                        auto* dst = static_cast<std::byte*>(r.dst) + done;
+                        file.read(dst, r.bytes - done, r.offset + done);
+                    } catch (...) {
+                        error = std::current_exception();
+                    }
+                }
+            }
+            head_ref.store(head, std::memory_order_release);
+            return count;
+        }
+
+        void close() {
+            for (auto* m : {&sqe_map_, &cq_map_, &sq_map_}) {
+                if (m->ptr != nullptr && m->bytes != 0) {
+                    ::munmap(m->ptr, m->bytes);
+                }
+                *m = Mapping{};
+            }
+            if (fd_ != -1) {
+                ::close(fd_);
+                fd_ = -1;
+            }
+        }
+
+        int fd_ = -1;
+        io_uring_params params_{};
+        Mapping sq_map_{};
+        Mapping cq_map_{};
+        Mapping sqe_map_{};
+    };
+#endif
+
+    size_t queue_depth_ = 0;
+#if SVS_HAS_IO_URING
+    Ring ring_{};
+#endif
+};
+
+///
+/// @brief Uninitialized byte buffer with a custom alignment.
+///
+/// Used as the destination of direct I/O reads, which must be aligned to the logical block
+/// size of the device.
+///
+class AlignedBuffer {
+  public:
+    /// @brief Construct an empty buffer.
+    AlignedBuffer() = default;
+
+    ///
+    /// @brief Allocate ``bytes`` bytes aligned to ``alignment``.
+    ///
+    /// The alignment must be a power of two.
+    ///
+    AlignedBuffer(size_t bytes, size_t alignment)
+        : data_{static_cast<std::byte*>(::operator new(
+                    lib::round_up_to_multiple_of(bytes, alignment),
+                    std::align_val_t{alignment}
+                )),
+                Deleter{alignment}}
+        , size_{bytes} {}
+
+    /// @brief Return a pointer to the first byte.
+    std::byte* data() { return data_.get(); }
+    /// @brief Return a pointer to the first byte.
+    const std::byte* data() const { return data_.get(); }
+    /// @brief Return the number of bytes.
+    size_t size() const { return size_; }
+
+  private:
+    struct Deleter {
+        size_t alignment;
+        void operator()(std::byte* ptr) const {
+            ::operator delete(ptr, std::align_val_t{alignment});
+        }
+    };
+
+    std::unique_ptr<std::byte, Deleter> data_{nullptr, Deleter{1}};
+    size_t size_ = 0;
+};
+
+} // namespace svs::lib
@@ -0,0 +1,102 @@
+/**
+ *    Copyright (C) 2023, Intel Corporation
+ *
+ *    You can redistribute and/or modify this software under the terms of the
+ *    GNU Affero General Public License version 3.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    version 3 along with this software. If not, see
+ *    <https://www.gnu.org/licenses/agpl-3.0.en.html>.
+ */
+
+#pragma once
+
+// svs
+#include "svs/lib/spinlock.h"
+
+// stl
+#include <atomic>
+#include <cstdint>
+
+namespace svs::lib {
+
+///
+/// @brief A sequence lock for a single writer and many optimistic readers.
+///
+/// Writers bracket their modifications with ``write_begin()`` and ``write_end()``.
+/// Writers of the same protected object must be serialized externally.
+///
+/// Readers never block writers. Instead, a reader copies the protected object between
+/// ``read_begin()`` and ``read_retry()`` and retries the copy if a write overlapped it.
+///
+/// @code{.cpp}
+/// uint32_t version;
+/// do {
+///     version = lock.read_begin();
+///     copy_protected_data();
+/// } while (lock.read_retry(version));
+/// @endcode
+///
+class SeqLock {
+  public:
+    SeqLock() = default;
+
+    // Copying only transfers the current version. Both copies must not be in use.
+    SeqLock(const SeqLock& other) noexcept
+        : version_{other.version_.load(std::memory_order_relaxed)} {}
+    SeqLock& operator=(const SeqLock& other) noexcept {
+        version_.store(
+            other.version_.load(std::memory_order_relaxed), std::memory_order_relaxed
+        );
+        return *this;
+    }
+    ~SeqLock() = default;
+
+    ///
+    /// @brief Mark the beginning of a modification.
+    ///
+    void write_begin() noexcept {
+        version_.store(
+            version_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed
+        );
+        // Order the odd version before any of the following data stores.
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+
+    ///
+    /// @brief Mark the end of a modification, publishing the written data.
+    ///
+    void write_end() noexcept {
+        version_.store(
+            version_.load(std::memory_order_relaxed) + 1, std::memory_order_release
+        );
+    }
+
+    ///
+    /// @brief Begin an optimistic read, returning the version to pass to ``read_retry``.
+    ///
+    /// Spins while a write is in progress.
+    ///
+    uint32_t read_begin() const noexcept {
+        uint32_t version = version_.load(std::memory_order_acquire);
+        while (version & 1) {
+            svs::detail::pause();
+            version = version_.load(std::memory_order_acquire);
+        }
+        return version;
+    }
+
+    ///
+    /// @brief Return ``true`` if a write overlapped the read started at ``version``.
+    ///
+    bool read_retry(uint32_t version) const noexcept {
+        // Order the preceeding data loads before the version check.
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return version_.load(std::memory_order_relaxed) != version;
+    }
+
+  private:
+    std::atomic<uint32_t> version_{0};
+};
+
+} // namespace svs::lib
@@ -17,6 +17,7 @@
 ///
 
 // local deps
+#include "svs/lib/bfloat16.h"
 #include "svs/lib/exception.h"
 #include "svs/lib/float16.h"
 #include "svs/third-party/fmt.h"
@@ -47,6 +48,7 @@ enum class DataType {
     float16,
     float32,
     float64,
+    bfloat16,
     byte,
     undef
 };
@@ -75,6 +77,9 @@ template <> inline constexpr std::string_view name<DataType::float32>() {
 template <> inline constexpr std::string_view name<DataType::float64>() {
     return "float64";
 }
+template <> inline constexpr std::string_view name<DataType::bfloat16>() {
+    return "bfloat16";
+}
 
 template <> inline constexpr std::string_view name<DataType::byte>() { return "byte"; }
 
@@ -98,6 +103,7 @@ inline constexpr std::string_view name(DataType type) {
         case DataType::float16: { return name<DataType::float16>(); }
         case DataType::float32: { return name<DataType::float32>(); }
         case DataType::float64: { return name<DataType::float64>(); }
+        case DataType::bfloat16: { return name<DataType::bfloat16>(); }
 
         case DataType::byte: { return name<DataType::byte>(); }
 
@@ -123,6 +129,7 @@ inline constexpr size_t element_size(DataType type) {
         case DataType::float16: { return sizeof(svs::Float16); }
         case DataType::float32: { return sizeof(float); }
         case DataType::float64: { return sizeof(double); }
+        case DataType::bfloat16: { return sizeof(svs::BFloat16); }
 
         case DataType::byte: { return sizeof(std::byte); }
         case DataType::undef: { return 0; }
@@ -189,6 +196,9 @@ inline constexpr DataType parse_datatype(std::string_view name) {
     if (name.starts_with("float")) {
         return parse_datatype_floating(name);
     }
+    if (name == "bfloat16") {
+        return DataType::bfloat16;
+    }
     if (name.starts_with("uint")) {
         return parse_datatype_unsigned(name);
     }
@@ -260,6 +270,7 @@ template <> struct CppType<DataType::int64> { using type = int64_t; };
 template <> struct CppType<DataType::float16> { using type = Float16; };
 template <> struct CppType<DataType::float32> { using type = float; };
 template <> struct CppType<DataType::float64> { using type = double; };
+template <> struct CppType<DataType::bfloat16> { using type = BFloat16; };
 
 template <> struct CppType<DataType::byte> { using type = std::byte; };
 
@@ -279,6 +290,7 @@ template<> inline constexpr DataType datatype_v<int64_t> = DataType::int64;
 template<> inline constexpr DataType datatype_v<Float16> = DataType::float16;
 template<> inline constexpr DataType datatype_v<float> = DataType::float32;
 template<> inline constexpr DataType datatype_v<double> = DataType::float64;
+template<> inline constexpr DataType datatype_v<BFloat16> = DataType::bfloat16;
 
 template<> inline constexpr DataType datatype_v<std::byte> = DataType::byte;
 // clang-format on
@@ -144,6 +144,15 @@ inline constexpr bool have_avx512_vnni = true;
 inline constexpr bool have_avx512_vnni = false;
 #endif
 
+// Dot products of brain floating point (bfloat16) pairs with single precision accumulation.
+#if defined(__AVX512BF16__)
+#define SVS_AVX512_BF16 1
+inline constexpr bool have_avx512_bf16 = true;
+#else
+#define SVS_AVX512_BF16 0
+inline constexpr bool have_avx512_bf16 = false;
+#endif
+
 // 256-bit Intel(R) AVX instruction set.
 #if defined(__AVX2__)
 #define SVS_AVX2 1
@@ -154,3 +163,81 @@ inline constexpr bool have_avx512_avx2 = true;
 #endif
 
 } // namespace svs::arch
+
+/////
+///// Runtime dispatch
+/////
+
+// When `SVS_RUNTIME_DISPATCH` is enabled, distance kernels for all supported Intel(R) AVX
+// extensions are compiled regardless of the flags passed to the compiler. The kernel used
+// is selected when the process starts based on the capabilities of the host processor.
+//
+// The `SVS_BUILD_*` macros indicate whether kernels for an extension are compiled at all.
+// Such kernels must be enclosed in a `SVS_BEGIN_TARGET_*`/`SVS_END_TARGET` pair, which
+// enables code generation for the extension in runtime dispatch builds and expands to
+// nothing otherwise.
+//
+// Helpers compiled for a wider extension than their callers cannot be forcibly inlined in
+// runtime dispatch builds. Such helpers use `SVS_TARGET_INLINE`, which expands to
+// `SVS_FORCE_INLINE` in static builds and to `inline` otherwise.
+SVS_VALIDATE_BOOL_ENV(SVS_RUNTIME_DISPATCH)
+#if SVS_RUNTIME_DISPATCH
+
+#define SVS_BUILD_AVX2 1
+#define SVS_BUILD_AVX512_F 1
+#define SVS_BUILD_AVX512_VNNI 1
+#define SVS_BUILD_AVX512_BF16 1
+
+// Keep the feature lists in-sync with `svs::arch::detect_isa()`.
+#if defined(__clang__)
+// clang-format off
+#define SVS_BEGIN_TARGET_AVX2 _Pragma( \
+    "clang attribute push(__attribute__((target(\"avx2,fma,f16c\"))), apply_to = function)" \
+)
+#define SVS_BEGIN_TARGET_AVX512_F _Pragma( \
+    "clang attribute push(__attribute__((target(\"avx2,fma,f16c,avx512f,avx512vl,avx512bw,avx512dq\"))), apply_to = function)" \
+)
+#define SVS_BEGIN_TARGET_AVX512_VNNI _Pragma( \
+    "clang attribute push(__attribute__((target(\"avx2,fma,f16c,avx512f,avx512vl,avx512bw,avx512dq,avx512vnni\"))), apply_to = function)" \
+)
+#define SVS_BEGIN_TARGET_AVX512_BF16 _Pragma( \
+    "clang attribute push(__attribute__((target(\"avx2,fma,f16c,avx512f,avx512vl,avx512bw,avx512dq,avx512vnni,avx512bf16\"))), apply_to = function)" \
+)
+// clang-format on
+#define SVS_END_TARGET _Pragma("clang attribute pop")
+#else
+// clang-format off
+#define SVS_BEGIN_TARGET_AVX2 \
+    _Pragma("GCC push_options") \
+    _Pragma("GCC target(\"avx2,fma,f16c\")")
+#define SVS_BEGIN_TARGET_AVX512_F \
+    _Pragma("GCC push_options") \
+    _Pragma("GCC target(\"avx2,fma,f16c,avx512f,avx512vl,avx512bw,avx512dq\")")
+#define SVS_BEGIN_TARGET_AVX512_VNNI \
+    _Pragma("GCC push_options") \
+    _Pragma("GCC target(\"avx2,fma,f16c,avx512f,avx512vl,avx512bw,avx512dq,avx512vnni\")")
+#define SVS_BEGIN_TARGET_AVX512_BF16 \
+    _Pragma("GCC push_options") \
+    _Pragma("GCC target(\"avx2,fma,f16c,avx512f,avx512vl,avx512bw,avx512dq,avx512vnni,avx512bf16\")")
+// clang-format on
+#define SVS_END_TARGET _Pragma("GCC pop_options")
+#endif
+
+#define SVS_TARGET_INLINE inline
+
+#else
+
+#define SVS_BUILD_AVX2 SVS_AVX2
+#define SVS_BUILD_AVX512_F SVS_AVX512_F
+#define SVS_BUILD_AVX512_VNNI SVS_AVX512_VNNI
+#define SVS_BUILD_AVX512_BF16 SVS_AVX512_BF16
+
+#define SVS_BEGIN_TARGET_AVX2
+#define SVS_BEGIN_TARGET_AVX512_F
+#define SVS_BEGIN_TARGET_AVX512_VNNI
+#define SVS_BEGIN_TARGET_AVX512_BF16
+#define SVS_END_TARGET
+
+#define SVS_TARGET_INLINE SVS_FORCE_INLINE
+
+#endif
@@ -16,6 +16,7 @@
 #include "svs/lib/threads/threadpool.h"
 #include "svs/lib/threads/thunks.h"
 #include "svs/lib/threads/types.h"
+#include "svs/lib/threads/workstealing.h"
 
 namespace svs::threads {
 
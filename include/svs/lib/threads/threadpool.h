@@ -53,15 +53,45 @@ concept ResizeableThreadPool = requires(Pool& pool, size_t sz) {
     ///
     pool.resize(sz);
 };
+
+///
+/// Thread pools that can schedule an arbitrary number of independent tasks.
+///
+/// Dynamic partitions given to such pools are split into one task per chunk rather than
+/// being claimed from a shared counter by one closure per thread.
+///
+template <typename Pool>
+concept TaskThreadPool = requires(Pool& pool, TaskRef f, size_t num_tasks) {
+    requires(ThreadPool<Pool>);
+
+    ///
+    /// Invoke `f(task, tid)` once for each `task` in `[0, num_tasks)`.
+    /// Argument `tid` is the index of the executing thread in `[0, pool.size())`.
+    ///
+    pool.run_tasks(f, num_tasks);
+};
 // clang-format on
 
+namespace detail {
+template <typename T> inline constexpr bool is_dynamic_partition_v = false;
+template <typename I>
+inline constexpr bool is_dynamic_partition_v<DynamicPartition<I>> = true;
+} // namespace detail
+
 template <ThreadPool Pool, typename F> void run(Pool& pool, F&& f) {
     auto f_wrapped = thunks::wrap(ThreadCount{pool.size()}, f);
     pool.run(FunctionRef(f_wrapped));
 }
 
 template <ThreadPool Pool, typename T, typename F> void run(Pool& pool, T&& arg, F&& f) {
-    if (!arg.empty()) {
+    if (arg.empty()) {
+        return;
+    }
+
+    if constexpr (TaskThreadPool<Pool> && detail::is_dynamic_partition_v<std::decay_t<T>>) {
+        auto [f_wrapped, num_tasks] = thunks::wrap_chunks(f, std::forward<T>(arg));
+        pool.run_tasks(TaskRef(f_wrapped), num_tasks);
+    } else {
         auto f_wrapped = thunks::wrap(ThreadCount{pool.size()}, f, std::forward<T>(arg));
         pool.run(FunctionRef(f_wrapped));
     }
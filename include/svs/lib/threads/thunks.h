@@ -15,6 +15,7 @@
 #include <atomic>
 #include <cstdint>
 #include <memory>
+#include <utility>
 #include <vector>
 
 // local
@@ -47,6 +48,32 @@ struct FunctionRef {
     constexpr friend bool operator==(FunctionRef, FunctionRef) = default;
 };
 
+/// @brief A function pointer-like object invoked as `f(task, tid)`.
+///
+/// Used by task-based thread pools (see ``TaskThreadPool``) where the number of tasks is
+/// decoupled from the number of threads. Argument ``task`` is the index of the task to
+/// run and ``tid`` is the ID of the executing thread.
+struct TaskRef {
+  public:
+    using function_type = void (*)(void*, size_t, size_t);
+    function_type fn = nullptr;
+    void* arg = nullptr;
+
+  public:
+    TaskRef() = default;
+
+    template <typename F>
+        requires(!std::is_same_v<std::remove_const_t<F>, TaskRef>)
+    explicit TaskRef(F& f)
+        : fn{+[](void* arg, size_t task, size_t tid) {
+            static_cast<F*>(arg)->operator()(task, tid);
+        }}
+        , arg{static_cast<void*>(&f)} {}
+
+    void operator()(size_t task, size_t tid) const { fn(arg, task, tid); }
+    constexpr friend bool operator==(TaskRef, TaskRef) = default;
+};
+
 struct ThreadFunctionRef {
   public:
     FunctionRef fn{};
@@ -119,6 +146,20 @@ template <typename F, typename I> struct Thunk<F, DynamicPartition<I>> {
     }
 };
 
+// Dynamic partition as independent tasks: one task per chunk of `grainsize` elements.
+// Returns the wrapped function along with the number of tasks.
+template <typename F, typename I> auto wrap_chunks(F& f, DynamicPartition<I> space) {
+    size_t num_chunks = lib::div_round_up(space.size(), space.grainsize);
+    auto chunk_fn = [&f, space](uint64_t chunk, uint64_t tid) {
+        size_t grainsize = space.grainsize;
+        auto start = grainsize * chunk;
+        auto stop = std::min(grainsize * (chunk + 1), space.size());
+        auto this_range = IteratorPair{std::begin(space) + start, std::begin(space) + stop};
+        f(this_range, tid);
+    };
+    return std::make_pair(std::move(chunk_fn), num_chunks);
+}
+
 // Thunk entry point.
 template <typename F, typename... Args>
 auto wrap(ThreadCount nthreads, F& f, Args&&... args) {
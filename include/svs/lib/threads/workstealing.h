@@ -0,0 +1,512 @@
+/**
+ *    Copyright (C) 2023, Intel Corporation
+ *
+ *    You can redistribute and/or modify this software under the terms of the
+ *    GNU Affero General Public License version 3.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    version 3 along with this software. If not, see
+ *    <https://www.gnu.org/licenses/agpl-3.0.en.html>.
+ */
+
+#pragma once
+
+// stdlib
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// local
+#include "svs/lib/misc.h"
+#include "svs/lib/spinlock.h"
+#include "svs/lib/threads/thread.h"
+#include "svs/lib/threads/threadpool.h"
+#include "svs/lib/threads/thunks.h"
+#include "svs/lib/threads/types.h"
+#include "svs/third-party/fmt.h"
+
+namespace svs {
+namespace threads {
+namespace detail {
+
+///
+/// A batch of tasks submitted by a single call to `run` or `run_tasks`.
+///
+/// Jobs live on the stack of the submitting thread, which does not return until every
+/// task belonging to the job has finished.
+///
+class Job {
+  public:
+    Job(TaskRef fn, size_t num_tasks, std::string_view label)
+        : fn_{fn}
+        , remaining_{num_tasks}
+        , label_{label} {}
+
+    ///
+    /// Run task `task` on the thread with ID `tid`.
+    /// Exceptions are recorded and propagated to the submitting thread by `rethrow`.
+    ///
+    void execute(size_t task, size_t tid) {
+        try {
+            fn_(task, tid);
+        } catch (const std::exception& error) {
+            record_error(task, error.what());
+        } catch (...) { record_error(task, "unknown exception"); }
+
+        // The thread finishing the last task signals the submitter.
+        // The submitter may destroy the job as soon as it observes `done_`, so the
+        // notification must happen while holding the lock.
+        if (remaining_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            std::lock_guard lock{done_mutex_};
+            done_ = true;
+            done_cv_.notify_all();
+        }
+    }
+
+    bool done() const { return remaining_.load(std::memory_order_acquire) == 0; }
+
+    ///
+    /// Block until all tasks have finished.
+    ///
+    void wait() {
+        std::unique_lock lock{done_mutex_};
+        done_cv_.wait(lock, [&] { return done_; });
+    }
+
+    ///
+    /// Throw a ``svs::threads::ThreadingException`` if any task failed.
+    /// Must only be called after ``wait()``.
+    ///
+    void rethrow() const {
+        if (!errors_.empty()) {
+            throw ThreadingException{errors_};
+        }
+    }
+
+  private:
+    void record_error(size_t task, std::string_view message) {
+        std::lock_guard lock{error_mutex_};
+        fmt::format_to(std::back_inserter(errors_), "{} {}: {}\n", label_, task, message);
+    }
+
+    TaskRef fn_;
+    std::atomic<size_t> remaining_;
+    std::string_view label_;
+
+    // Error reporting.
+    SpinLock error_mutex_{};
+    std::string errors_{};
+
+    // Completion signalling.
+    std::mutex done_mutex_{};
+    std::condition_variable done_cv_{};
+    bool done_ = false;
+};
+
+struct Task {
+    Job* job;
+    size_t index;
+};
+
+///
+/// Double ended task queue.
+///
+/// The owning thread pushes and pops at the back while other threads steal from the
+/// front. Each queue is padded to a cache line to avoid false sharing between the locks.
+///
+struct alignas(64) TaskQueue {
+  public:
+    // Pop the newest task. If `job` is not null, only tasks belonging to `job` match.
+    std::optional<Task> pop_back(const Job* job) {
+        std::lock_guard lock{lock_};
+        for (auto it = tasks_.rbegin(), end = tasks_.rend(); it != end; ++it) {
+            if (job == nullptr || it->job == job) {
+                auto task = *it;
+                tasks_.erase(std::next(it).base());
+                return task;
+            }
+        }
+        return std::nullopt;
+    }
+
+    // Steal the oldest task. If `job` is not null, only tasks belonging to `job` match.
+    std::optional<Task> steal_front(const Job* job) {
+        std::lock_guard lock{lock_};
+        for (auto it = tasks_.begin(), end = tasks_.end(); it != end; ++it) {
+            if (job == nullptr || it->job == job) {
+                auto task = *it;
+                tasks_.erase(it);
+                return task;
+            }
+        }
+        return std::nullopt;
+    }
+
+    SpinLock lock_{};
+    std::deque<Task> tasks_{};
+};
+
+class WorkStealingState;
+
+// Identifies the threads currently participating in a work-stealing pool to detect
+// reentrant calls.
+struct WorkerIdentity {
+    const WorkStealingState* pool = nullptr;
+    size_t id = 0;
+};
+inline thread_local WorkerIdentity current_worker{};
+
+///
+/// Scheduler state shared by the worker threads of a ``WorkStealingThreadPool``.
+///
+/// Thread IDs `[0, num_callers)` are caller slots, each held by at most one thread
+/// external to the pool at a time. Thread IDs `[num_callers, size())` belong to the worker
+/// threads. Each thread ID owns one task queue.
+///
+class WorkStealingState {
+  public:
+    WorkStealingState(size_t num_callers, size_t num_workers, size_t spin_count)
+        : num_callers_{num_callers}
+        , spin_count_{spin_count}
+        , slot_busy_(num_callers, false) {
+        for (size_t i = 0; i < num_callers + num_workers; ++i) {
+            queues_.push_back(std::make_unique<TaskQueue>());
+        }
+    }
+
+    size_t size() const { return queues_.size(); }
+    size_t num_callers() const { return num_callers_; }
+
+    ///
+    /// Run `fn(task, tid)` for all `task` in `[0, num_tasks)` and wait for completion.
+    ///
+    /// The calling thread executes task 0 and then helps with the remaining tasks of this
+    /// job (but no others) before blocking. Restricting help to the job being waited on
+    /// keeps nested calls from a worker thread from becoming entangled with unrelated work
+    /// and bounds the latency of the caller.
+    ///
+    /// External threads participate under a free caller slot. If all slots are taken,
+    /// the whole job is left to the worker threads.
+    ///
+    void run(TaskRef fn, size_t num_tasks, std::string_view label) {
+        if (num_tasks == 0) {
+            return;
+        }
+
+        auto job = Job{fn, num_tasks, label};
+        if (current_worker.pool == this) {
+            participate(job, num_tasks, current_worker.id);
+        } else if (auto slot = acquire_slot()) {
+            // Register the slot so that nested calls from our own tasks reuse it.
+            auto previous = current_worker;
+            current_worker = WorkerIdentity{this, *slot};
+            auto guard = lib::make_scope_guard([&]() noexcept {
+                current_worker = previous;
+                release_slot(*slot);
+            });
+            participate(job, num_tasks, *slot);
+        } else {
+            push(job, 0, num_tasks, size());
+            job.wait();
+            job.rethrow();
+        }
+    }
+
+    ///
+    /// Main loop for worker thread `id`.
+    ///
+    void work(size_t id) {
+        current_worker = WorkerIdentity{this, id};
+        for (;;) {
+            if (auto task = take(id, nullptr)) {
+                task->job->execute(task->index, id);
+                continue;
+            }
+
+            // Spin for a while before going to sleep.
+            size_t count = 0;
+            auto queued = threads::detail::spin_while(
+                queued_, size_t{0}, [&count, this]() { return ++count >= spin_count_; }
+            );
+            if (queued != 0) {
+                continue;
+            }
+
+            std::unique_lock lock{sleep_mutex_};
+            sleeping_.fetch_add(1);
+            wakeup_.wait(lock, [&] { return stopping_ || queued_.load() != 0; });
+            sleeping_.fetch_sub(1);
+            if (stopping_) {
+                return;
+            }
+        }
+    }
+
+    ///
+    /// Signal all worker threads to exit.
+    ///
+    void stop() {
+        {
+            std::lock_guard lock{sleep_mutex_};
+            stopping_ = true;
+        }
+        wakeup_.notify_all();
+    }
+
+  private:
+    // Execute task 0 of `job` on thread `id`, then help with the remaining tasks.
+    void participate(Job& job, size_t num_tasks, size_t id) {
+        if (num_tasks > 1) {
+            push(job, 1, num_tasks, num_callers_ <= id ? id : size());
+        }
+
+        job.execute(0, id);
+        while (!job.done()) {
+            auto task = take(id, &job);
+            if (!task) {
+                break;
+            }
+            job.execute(task->index, id);
+        }
+        job.wait();
+        job.rethrow();
+    }
+
+    // Claim a free caller slot.
+    // Without worker threads, wait for a slot to become free since no one else can
+    // execute the job. Otherwise, return an empty optional if all slots are taken.
+    std::optional<size_t> acquire_slot() {
+        std::unique_lock lock{slot_mutex_};
+        auto free_slot = [&]() {
+            return std::find(slot_busy_.begin(), slot_busy_.end(), false);
+        };
+        if (free_slot() == slot_busy_.end()) {
+            if (size() > num_callers_) {
+                return std::nullopt;
+            }
+            slot_freed_.wait(lock, [&]() { return free_slot() != slot_busy_.end(); });
+        }
+        auto it = free_slot();
+        *it = true;
+        return std::distance(slot_busy_.begin(), it);
+    }
+
+    void release_slot(size_t slot) {
+        {
+            std::lock_guard lock{slot_mutex_};
+            slot_busy_[slot] = false;
+        }
+        slot_freed_.notify_one();
+    }
+
+    // Enqueue tasks `[first, num_tasks)` of `job`.
+    //
+    // Worker threads push onto their own queue (`id`) so that nested work stays local
+    // unless stolen. Otherwise (`id == size()`), tasks are distributed round-robin across
+    // all queues so each worker finds work without contending on a single lock.
+    void push(Job& job, size_t first, size_t num_tasks, size_t id) {
+        // Increment the queued count before making tasks visible so it never underflows.
+        queued_.fetch_add(num_tasks - first);
+        if (id < size()) {
+            auto& queue = *queues_[id];
+            std::lock_guard lock{queue.lock_};
+            for (size_t task = first; task < num_tasks; ++task) {
+                queue.tasks_.push_back(Task{&job, task});
+            }
+        } else {
+            size_t num_queues = queues_.size();
+            for (size_t q = 0; q < num_queues; ++q) {
+                auto& queue = *queues_[q];
+                std::lock_guard lock{queue.lock_};
+                for (size_t task = first + q; task < num_tasks; task += num_queues) {
+                    queue.tasks_.push_back(Task{&job, task});
+                }
+            }
+        }
+
+        // Wake up sleeping workers.
+        // Pairs with the sequentially consistent accesses in `work`: either the worker
+        // observes the new tasks or we observe the sleeping worker.
+        if (sleeping_.load() != 0) {
+            { std::lock_guard lock{sleep_mutex_}; }
+            wakeup_.notify_all();
+        }
+    }
+
+    // Take a task, preferring the newest task of our own queue before stealing the oldest
+    // task from other queues.
+    std::optional<Task> take(size_t id, const Job* job) {
+        if (queued_.load(std::memory_order_acquire) == 0) {
+            return std::nullopt;
+        }
+
+        size_t num_queues = queues_.size();
+        for (size_t i = 0; i < num_queues; ++i) {
+            size_t q = (id + i) % num_queues;
+            auto task = (i == 0) ? queues_[q]->pop_back(job) : queues_[q]->steal_front(job);
+            if (task) {
+                queued_.fetch_sub(1, std::memory_order_relaxed);
+                return task;
+            }
+        }
+        return std::nullopt;
+    }
+
+    std::vector<std::unique_ptr<TaskQueue>> queues_{};
+    std::atomic<size_t> queued_{0};
+    size_t num_callers_;
+    size_t spin_count_;
+
+    // Caller slots.
+    std::vector<bool> slot_busy_;
+    std::mutex slot_mutex_{};
+    std::condition_variable slot_freed_{};
+
+    // Sleeping workers.
+    std::atomic<size_t> sleeping_{0};
+    std::mutex sleep_mutex_{};
+    std::condition_variable wakeup_{};
+    bool stopping_ = false;
+};
+
+} // namespace detail
+
+///
+/// @brief Thread pool with per-worker task queues and work stealing.
+///
+/// Unlike the ``svs::threads::NativeThreadPool``, which serializes calls to ``run`` and
+/// statically assigns one closure to each thread, this pool accepts concurrent calls
+/// from multiple threads as well as nested calls from within its own worker threads.
+/// Each call is split into tasks which idle workers steal from each other, so small
+/// batches submitted by different clients share the available cores.
+///
+/// Dynamic partitions passed to ``svs::threads::run`` are split into one task per chunk.
+///
+/// Threads outside the pool participate in their own work under one of ``num_callers``
+/// caller slots, which take the thread IDs ``[0, num_callers)``. Worker threads take the
+/// remaining IDs. When all slots are taken, further external calls are executed by the
+/// worker threads alone. The thread IDs passed by ``run_tasks`` are therefore unique
+/// among all concurrently executing tasks, even across calls, and may be used to index
+/// per-thread scratch space of ``size()`` entries.
+///
+/// The argument passed by ``run`` is the index of the invocation in ``[0, size())``,
+/// which is only unique within a single call.
+///
+class WorkStealingThreadPool {
+  public:
+    ///
+    /// @brief Construct a new thread pool.
+    ///
+    /// @param num_threads The number of threads doing work for a single caller, including
+    ///     the calling thread.
+    /// @param spin_count The number of iterations idle workers spin before sleeping.
+    /// @param num_callers The number of external threads that may participate in their
+    ///     own calls at the same time.
+    ///
+    /// The pool launches ``num_threads - 1`` worker threads and provides
+    /// ``num_threads + num_callers - 1`` thread IDs.
+    ///
+    explicit WorkStealingThreadPool(
+        size_t num_threads = 1,
+        size_t spin_count = default_spintime(),
+        size_t num_callers = 1
+    )
+        : spin_count_{spin_count}
+        , num_callers_{std::max(num_callers, size_t{1})} {
+        start(num_threads);
+    }
+
+    WorkStealingThreadPool(WorkStealingThreadPool&&) noexcept = default;
+    WorkStealingThreadPool& operator=(WorkStealingThreadPool&& other) noexcept {
+        if (this != &other) {
+            shutdown();
+            state_ = std::move(other.state_);
+            threads_ = std::move(other.threads_);
+            spin_count_ = other.spin_count_;
+            num_callers_ = other.num_callers_;
+        }
+        return *this;
+    }
+
+    WorkStealingThreadPool(const WorkStealingThreadPool&) = delete;
+    WorkStealingThreadPool& operator=(const WorkStealingThreadPool&) = delete;
+
+    ~WorkStealingThreadPool() { shutdown(); }
+
+    /// Return the number of thread IDs, including the caller slots.
+    size_t size() const { return threads_.size() + num_callers_; }
+
+    /// Return the number of caller slots.
+    size_t num_callers() const { return num_callers_; }
+
+    ///
+    /// @brief Change the number of threads doing work for a single caller.
+    ///
+    /// Must not be called concurrently with ``run`` or ``run_tasks``.
+    ///
+    void resize(size_t new_size) {
+        new_size = std::max(new_size, size_t{1});
+        if (new_size != threads_.size() + 1) {
+            shutdown();
+            start(new_size);
+        }
+    }
+
+    ///
+    /// @brief Invoke `f(tid)` once for each `tid` in `[0, size())`.
+    ///
+    void run(FunctionRef f) {
+        auto task_fn = [f](size_t task, size_t /*tid*/) { f(task); };
+        state_->run(TaskRef(task_fn), size(), "Thread");
+    }
+
+    ///
+    /// @brief Invoke `f(task, tid)` once for each `task` in `[0, num_tasks)`.
+    ///
+    void run_tasks(TaskRef f, size_t num_tasks) { state_->run(f, num_tasks, "Task"); }
+
+  private:
+    void start(size_t num_threads) {
+        size_t num_workers = std::max(num_threads, size_t{1}) - 1;
+        state_ = std::make_unique<detail::WorkStealingState>(
+            num_callers_, num_workers, spin_count_
+        );
+        auto* state = state_.get();
+        for (size_t id = num_callers_; id < num_callers_ + num_workers; ++id) {
+            threads_.emplace_back([state, id]() { state->work(id); });
+        }
+    }
+
+    void shutdown() {
+        if (state_ != nullptr) {
+            state_->stop();
+        }
+        for (auto& thread : threads_) {
+            thread.join();
+        }
+        threads_.clear();
+    }
+
+    // Heap allocate the scheduler state so the pool can be moved while worker threads
+    // keep a stable pointer.
+    std::unique_ptr<detail::WorkStealingState> state_;
+    std::vector<std::thread> threads_{};
+    size_t spin_count_;
+    size_t num_callers_;
+};
+
+static_assert(ResizeableThreadPool<WorkStealingThreadPool>);
+static_assert(TaskThreadPool<WorkStealingThreadPool>);
+
+} // namespace threads
+} // namespace svs
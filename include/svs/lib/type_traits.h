@@ -41,6 +41,7 @@ concept Arithmetic = is_arithmetic_v<std::remove_const_t<T>>;
 /// Specialization List:
 ///     double -> float
 ///     float -> svs::Float16
+///     float -> svs::BFloat16
 ///
 template <typename From, typename To> inline constexpr bool allow_lossy_conversion = false;
 template <> inline constexpr bool allow_lossy_conversion<double, float> = true;
@@ -24,6 +24,7 @@ class InvertedInterface {
     virtual std::string experimental_backend_string() const = 0;
 
     ///// Saving
+    virtual void save(const std::filesystem::path& directory) = 0;
     virtual void save_primary_index(
         const std::filesystem::path& primary_config,
         const std::filesystem::path& primary_data,
@@ -60,6 +61,8 @@ class InvertedImpl : public manager::ManagerImpl<QueryTypes, Impl, IFace> {
     }
 
     ///// Saving
+    void save(const std::filesystem::path& directory) override { impl().save(directory); }
+
     void save_primary_index(
         const std::filesystem::path& primary_config,
         const std::filesystem::path& primary_data,
@@ -93,6 +96,14 @@ class Inverted : public manager::IndexManager<InvertedInterface> {
     }
 
     ///// Saving
+
+    ///
+    /// @brief Save the whole index to ``directory``.
+    ///
+    /// The index can be reloaded using ``svs::Inverted::assemble``.
+    ///
+    void save(const std::filesystem::path& directory) { impl_->save(directory); }
+
     void save_primary_index(
         const std::filesystem::path& primary_config,
         const std::filesystem::path& primary_data,
@@ -134,6 +145,36 @@ class Inverted : public manager::IndexManager<InvertedInterface> {
             )};
     }
 
+    ///// Loading
+
+    ///
+    /// @brief Reload an index saved with ``svs::Inverted::save``.
+    ///
+    /// @tparam QueryTypes The query element types supported by the returned index.
+    /// @tparam PrimaryData The dataset type of the primary index.
+    /// @tparam Cluster The clustered dataset type. Dense clusters over uncompressed data
+    ///     should use ``svs::index::inverted::MappedDenseClusteredDataset``.
+    ///
+    /// @param directory The directory the index was saved to.
+    /// @param distance The distance functor to use.
+    /// @param num_threads The number of threads to use for search.
+    ///
+    template <
+        manager::QueryTypeDefinition QueryTypes,
+        typename PrimaryData,
+        typename Cluster,
+        typename Distance>
+    static Inverted assemble(
+        const std::filesystem::path& directory, Distance distance, size_t num_threads
+    ) {
+        return Inverted{
+            std::in_place,
+            manager::as_typelist<QueryTypes>{},
+            index::inverted::auto_load<PrimaryData, Cluster>(
+                directory, std::move(distance), num_threads
+            )};
+    }
+
     ///// Assembling
     template <
         manager::QueryTypeDefinition QueryTypes,
@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include "svs/core/bitset.h"
 #include "svs/core/data/simple.h"
 #include "svs/core/distance.h"
 #include "svs/core/query_result.h"
@@ -73,6 +74,19 @@ template <typename IFace> class ManagerInterface : public IFace {
         const search_parameters_type& search_parameters
     ) = 0;
 
+    virtual void search(
+        svs::QueryResultView<size_t> results,
+        AnonymousArray<2> data,
+        const search_parameters_type& search_parameters,
+        const svs::SearchFilter& filter
+    ) = 0;
+
+    virtual svs::RangeSearchResult<size_t> range_search(
+        AnonymousArray<2> data,
+        float radius,
+        const search_parameters_type& search_parameters
+    ) = 0;
+
     // Data Interface
     virtual size_t size() const = 0;
     virtual size_t dimensions() const = 0;
@@ -155,6 +169,67 @@ class ManagerImpl : public ManagerInterface<IFace> {
         );
     }
 
+    // Filtered search is dispatched like `search`.
+    void search(
+        QueryResultView<size_t> result,
+        AnonymousArray<2> data,
+        const search_parameters_type& search_parameters,
+        const svs::SearchFilter& filter
+    ) override {
+        lib::match(
+            QueryTypes{},
+            data.type(),
+            [&]<typename T>(lib::Type<T> SVS_UNUSED(type)) {
+                const auto view = data::ConstSimpleDataView<T>(data);
+                svs::index::search_batch_into_with(
+                    implementation_, result, view, search_parameters, filter
+                );
+            },
+            [&](svs::DataType data_type) {
+                throw ANNEXCEPTION(
+                    "Unsupported datatype! Got: {}. Expected one of: {}.",
+                    data_type,
+                    fmt::join(QueryTypes::data_types(), ", ")
+                );
+            }
+        );
+    }
+
+    // Range search is dispatched like `search`. Implementations that do not provide range
+    // search throw an exception.
+    svs::RangeSearchResult<size_t> range_search(
+        AnonymousArray<2> data,
+        float radius,
+        const search_parameters_type& search_parameters
+    ) override {
+        return lib::match(
+            QueryTypes{},
+            data.type(),
+            [&]<typename T>(lib::Type<T> SVS_UNUSED(type)
+            ) -> svs::RangeSearchResult<size_t> {
+                const auto view = data::ConstSimpleDataView<T>(data);
+                if constexpr (requires {
+                                  implementation_.range_search(
+                                      view, radius, search_parameters
+                                  );
+                              }) {
+                    return svs::index::range_search_with(
+                        implementation_, view, radius, search_parameters
+                    );
+                } else {
+                    throw ANNEXCEPTION("Range search is not supported by this index!");
+                }
+            },
+            [&](svs::DataType data_type) {
+                throw ANNEXCEPTION(
+                    "Unsupported datatype! Got: {}. Expected one of: {}.",
+                    data_type,
+                    fmt::join(QueryTypes::data_types(), ", ")
+                );
+            }
+        );
+    }
+
     // Data Interface
     size_t size() const override { return implementation_.size(); }
     size_t dimensions() const override { return implementation_.dimensions(); }
@@ -218,6 +293,59 @@ template <typename IFace> class IndexManager {
         return svs::index::search_batch(*this, queries.cview(), num_neighbors);
     }
 
+    ///
+    /// @brief Fill the result with the nearest neighbors of each query among the elements
+    ///     allowed by ``filter``.
+    ///
+    /// @param result The result data structure to populate.
+    /// @param queries The queries.
+    /// @param search_parameters The search parameters to use.
+    /// @param filter The allowed IDs, either shared by all queries or given separately
+    ///     for each query. See ``svs::SearchFilter``.
+    ///
+    template <typename QueryType>
+    void search(
+        QueryResultView<size_t> result,
+        data::ConstSimpleDataView<QueryType> queries,
+        const search_parameters_type& search_parameters,
+        const svs::SearchFilter& filter
+    ) {
+        impl_->search(result, AnonymousArray<2>(queries), search_parameters, filter);
+    }
+
+    // Apply the default search parameters.
+    template <typename Queries>
+    QueryResult<size_t> search(
+        const Queries& queries, size_t num_neighbors, const svs::SearchFilter& filter
+    ) {
+        return svs::index::search_batch(*this, queries.cview(), num_neighbors, filter);
+    }
+
+    ///
+    /// @brief Return the indexed elements within ``radius`` of each query.
+    ///
+    /// @param queries The queries.
+    /// @param radius The search radius. An element is returned if its distance to the
+    ///     query is at least as good as ``radius``.
+    /// @param search_parameters The search parameters to use.
+    ///
+    /// Throws an ``svs::ANNException`` if the backend does not support range search.
+    ///
+    template <typename QueryType>
+    RangeSearchResult<size_t> range_search(
+        data::ConstSimpleDataView<QueryType> queries,
+        float radius,
+        const search_parameters_type& search_parameters
+    ) {
+        return impl_->range_search(AnonymousArray<2>(queries), radius, search_parameters);
+    }
+
+    // Apply the default search parameters.
+    template <typename Queries>
+    RangeSearchResult<size_t> range_search(const Queries& queries, float radius) {
+        return svs::index::range_search(*this, queries.cview(), radius);
+    }
+
     ///// Data Interface
 
     /// @brief Return the number of elements in the indexed dataset.
@@ -0,0 +1,607 @@
+/**
+ *    Copyright (C) 2023, Intel Corporation
+ *
+ *    You can redistribute and/or modify this software under the terms of the
+ *    GNU Affero General Public License version 3.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    version 3 along with this software. If not, see
+ *    <https://www.gnu.org/licenses/agpl-3.0.en.html>.
+ */
+
+#pragma once
+
+// svs
+#include "svs/core/data/simple.h"
+#include "svs/core/distance.h"
+#include "svs/core/query_result.h"
+#include "svs/index/index.h"
+#include "svs/lib/array.h"
+#include "svs/lib/exception.h"
+#include "svs/lib/misc.h"
+#include "svs/lib/neighbor.h"
+#include "svs/lib/preprocessor.h"
+#include "svs/lib/saveload.h"
+#include "svs/lib/threads.h"
+#include "svs/lib/type_traits.h"
+#include "svs/orchestrators/manager.h"
+
+// third-party
+#include "fmt/core.h"
+#include <x86intrin.h>
+
+// stl
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace svs {
+
+namespace detail {
+
+template <typename Cmp>
+inline constexpr bool is_mergeable_compare_v =
+    std::is_same_v<Cmp, std::less<>> || std::is_same_v<Cmp, std::greater<>>;
+
+///
+/// Return the position of the first element of ``[x, x + n)`` that no other element is
+/// ordered before by ``Cmp``. Requires ``n > 0``.
+///
+/// The best value is found with vector min/max reductions followed by a vector search
+/// for its first occurrence.
+///
+template <typename Cmp> SVS_FORCE_INLINE size_t find_best(const float* x, size_t n) {
+    static_assert(is_mergeable_compare_v<Cmp>);
+    constexpr bool is_less = std::is_same_v<Cmp, std::less<>>;
+#if SVS_AVX512_F
+    constexpr size_t simd_width = 16;
+    auto tail_mask = [&](size_t i) {
+        return (n - i >= simd_width) ? __mmask16{0xFFFF}
+                                     : static_cast<__mmask16>((uint32_t{1} << (n - i)) - 1);
+    };
+    auto fill = _mm512_set1_ps(type_traits::sentinel_v<float, Cmp>);
+    auto best = fill;
+    for (size_t i = 0; i < n; i += simd_width) {
+        auto v = _mm512_mask_loadu_ps(fill, tail_mask(i), x + i);
+        best = is_less ? _mm512_min_ps(best, v) : _mm512_max_ps(best, v);
+    }
+    auto value = _mm512_set1_ps(
+        is_less ? _mm512_reduce_min_ps(best) : _mm512_reduce_max_ps(best)
+    );
+    for (size_t i = 0; i < n; i += simd_width) {
+        auto mask = tail_mask(i);
+        __mmask16 m = _mm512_mask_cmp_ps_mask(
+            mask, _mm512_maskz_loadu_ps(mask, x + i), value, _CMP_EQ_OQ
+        );
+        if (m != 0) {
+            return i + std::countr_zero(static_cast<uint32_t>(m));
+        }
+    }
+    return 0;
+#elif SVS_AVX2
+    constexpr size_t simd_width = 8;
+    auto cmp = Cmp{};
+    size_t i = 0;
+    float value = type_traits::sentinel_v<float, Cmp>;
+    if (n >= simd_width) {
+        auto best = _mm256_loadu_ps(x);
+        for (i = simd_width; i + simd_width <= n; i += simd_width) {
+            auto v = _mm256_loadu_ps(x + i);
+            best = is_less ? _mm256_min_ps(best, v) : _mm256_max_ps(best, v);
+        }
+        alignas(32) float lanes[simd_width];
+        _mm256_store_ps(lanes, best);
+        value = *std::min_element(lanes, lanes + simd_width, cmp);
+    }
+    for (; i < n; ++i) {
+        value = std::min(value, x[i], cmp);
+    }
+    auto v = _mm256_set1_ps(value);
+    for (i = 0; i + simd_width <= n; i += simd_width) {
+        int m = _mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(x + i), v, _CMP_EQ_OQ));
+        if (m != 0) {
+            return i + std::countr_zero(static_cast<uint32_t>(m));
+        }
+    }
+    for (; i < n; ++i) {
+        if (x[i] == value) {
+            return i;
+        }
+    }
+    return 0;
+#else
+    return std::min_element(x, x + n, Cmp{}) - x;
+#endif
+}
+
+} // namespace detail
+
+///
+/// @brief Merge the sorted per-shard results of a query into the overall best results.
+///
+/// @tparam Cmp The comparison used to order distances. Either ``std::less<>`` or
+///     ``std::greater<>``.
+///
+/// The head of each list is kept in a contiguous array and the best head is selected with
+/// vector instructions, so that each merged neighbor costs a single pass over one distance
+/// per list.
+///
+template <typename Cmp> class KWayMerge {
+  public:
+    static_assert(detail::is_mergeable_compare_v<Cmp>);
+
+    /// @brief Construct scratch space for merging ``num_lists`` lists.
+    explicit KWayMerge(size_t num_lists)
+        : heads_(num_lists)
+        , positions_(num_lists) {}
+
+    ///
+    /// @brief Merge row ``query`` of each of ``lists`` into row ``query`` of ``result``.
+    ///
+    /// @param result The destination of the merged neighbors.
+    /// @param query The query to merge.
+    /// @param lists Results sorted by ``Cmp``, with the same number of neighbors.
+    /// @param offsets Value added to the IDs of each list.
+    ///
+    /// Requires at least one list. Entries with the maximum ID, such as the padding of
+    /// searches returning fewer neighbors than requested, end their list. If the lists hold
+    /// fewer neighbors than requested, the remaining entries of ``result`` are filled with
+    /// the maximum ID and the worst distance.
+    ///
+    void operator()(
+        QueryResultView<size_t> result,
+        size_t query,
+        std::span<const QueryResult<size_t>> lists,
+        std::span<const size_t> offsets
+    ) {
+        constexpr float exhausted = type_traits::sentinel_v<float, Cmp>;
+        constexpr size_t missing = std::numeric_limits<size_t>::max();
+        const size_t num_lists = lists.size();
+        assert(num_lists != 0 && num_lists == heads_.size());
+        const size_t list_size = lists.front().n_neighbors();
+
+        // Move list `s` to `position`, stopping at padded entries.
+        auto seek = [&](size_t s, size_t position) {
+            if (position != list_size && lists[s].index(query, position) == missing) {
+                position = list_size;
+            }
+            positions_[s] = position;
+            heads_[s] =
+                (position == list_size) ? exhausted : lists[s].distance(query, position);
+        };
+        for (size_t s = 0; s < num_lists; ++s) {
+            seek(s, 0);
+        }
+
+        for (size_t j = 0, jmax = result.n_neighbors(); j < jmax; ++j) {
+            auto s = detail::find_best<Cmp>(heads_.data(), num_lists);
+            auto position = positions_[s];
+            if (position == list_size) {
+                // All lists are exhausted.
+                result.set(Neighbor<size_t>{missing, exhausted}, query, j);
+                continue;
+            }
+            auto id = offsets[s] + lists[s].index(query, position);
+            result.set(Neighbor<size_t>{id, heads_[s]}, query, j);
+            seek(s, position + 1);
+        }
+    }
+
+  private:
+    std::vector<float> heads_;
+    std::vector<size_t> positions_;
+};
+
+namespace detail {
+
+// Configuration of a saved sharded index. Shards are saved separately.
+struct ShardedIndexConfig {
+  public:
+    std::vector<size_t> offsets_;
+    DistanceType distance_;
+
+  public:
+    static constexpr std::string_view serialization_schema = "sharded_index";
+    static constexpr lib::Version save_version = lib::Version(0, 0, 0);
+
+    lib::SaveTable save() const {
+        return lib::SaveTable(
+            serialization_schema,
+            save_version,
+            {{"offsets", lib::save(offsets_)}, {"distance", lib::save(distance_)}}
+        );
+    }
+
+    static bool check_load_compatibility(std::string_view schema, lib::Version version) {
+        return schema == serialization_schema && version == save_version;
+    }
+
+    static ShardedIndexConfig load(const lib::ContextFreeLoadTable& table) {
+        return ShardedIndexConfig{
+            lib::load_at<std::vector<size_t>>(table, "offsets"),
+            lib::load_at<DistanceType>(table, "distance")};
+    }
+};
+
+inline std::filesystem::path shard_path(const std::filesystem::path& dir, size_t shard) {
+    return dir / fmt::format("shard_{}", shard);
+}
+
+} // namespace detail
+
+///
+/// @brief Orchestrator searching a collection of indexes as a single logical index.
+///
+/// @tparam Index The type of each shard. Any of the type erased orchestrators such as
+///     ``svs::Vamana``, ``svs::DynamicVamana``, ``svs::Flat`` or ``svs::Inverted``.
+///
+/// Shard ``i`` contributes its results with IDs shifted by the global offset of the shard.
+/// By default, the offset of each shard is the total size of the preceding shards.
+///
+/// Searches are fanned out over the shards, each shard searching all queries on its own
+/// thread pool with its search parameters. The threads of the sharded index are divided
+/// among the shards, so every thread searches concurrently as long as there are at least
+/// as many queries as threads. The per-shard results of each query are then merged into
+/// the overall best results with ``svs::KWayMerge``.
+///
+/// Shards whose thread count cannot be changed search with their own thread pools.
+///
+template <typename Index> class ShardedIndex {
+  public:
+    using search_parameters_type = typename Index::search_parameters_type;
+
+    ///
+    /// @brief Construct a sharded index with consecutive global IDs.
+    ///
+    /// @param shards The shards. Must not be empty.
+    /// @param distance The distance used by all shards, determining how results are
+    ///     merged.
+    /// @param num_threads The number of threads used for searching.
+    ///
+    ShardedIndex(std::vector<Index> shards, DistanceType distance, size_t num_threads)
+        : ShardedIndex(std::move(shards), std::vector<size_t>(), distance, num_threads) {}
+
+    ///
+    /// @brief Construct a sharded index with the given global ID offsets.
+    ///
+    /// @param shards The shards. Must not be empty.
+    /// @param offsets The value added to the IDs returned by each shard. If empty,
+    ///     shards are assigned consecutive global IDs.
+    /// @param distance The distance used by all shards, determining how results are
+    ///     merged.
+    /// @param num_threads The number of threads used for searching.
+    ///
+    /// Shards that support it are resized to their share of ``num_threads``.
+    ///
+    ShardedIndex(
+        std::vector<Index> shards,
+        std::vector<size_t> offsets,
+        DistanceType distance,
+        size_t num_threads
+    )
+        : shards_{std::move(shards)}
+        , offsets_{std::move(offsets)}
+        , distance_{distance}
+        , threadpool_{std::max(num_threads, size_t{1})} {
+        if (shards_.empty()) {
+            throw ANNEXCEPTION("A sharded index requires at least one shard!");
+        }
+        if (offsets_.empty()) {
+            size_t offset = 0;
+            for (const auto& shard : shards_) {
+                offsets_.push_back(offset);
+                offset += shard.size();
+            }
+        }
+        if (offsets_.size() != shards_.size()) {
+            throw ANNEXCEPTION(
+                "Got {} offsets for {} shards!", offsets_.size(), shards_.size()
+            );
+        }
+        for (auto& shard : shards_) {
+            if (shard.dimensions() != shards_.front().dimensions()) {
+                throw ANNEXCEPTION(
+                    "Shards with {} and {} dimensions cannot be combined!",
+                    shard.dimensions(),
+                    shards_.front().dimensions()
+                );
+            }
+            search_parameters_.push_back(shard.get_search_parameters());
+        }
+        distribute_threads();
+    }
+
+    ///// Shards
+
+    /// @brief Return the number of shards.
+    size_t num_shards() const { return shards_.size(); }
+    /// @brief Return shard ``i``.
+    Index& shard(size_t i) { return shards_.at(i); }
+    /// @brief Return shard ``i``.
+    const Index& shard(size_t i) const { return shards_.at(i); }
+    /// @brief Return the value added to the IDs returned by shard ``i``.
+    size_t offset(size_t i) const { return offsets_.at(i); }
+    /// @brief Return the global ID offset of each shard.
+    const std::vector<size_t>& offsets() const { return offsets_; }
+
+    ///// Data Interface
+
+    /// @brief Return the total number of elements in all shards.
+    size_t size() const {
+        size_t total = 0;
+        for (const auto& shard : shards_) {
+            total += shard.size();
+        }
+        return total;
+    }
+
+    /// @brief Return the number of dimensions of the indexed vectors.
+    size_t dimensions() const { return shards_.front().dimensions(); }
+
+    /// @brief Return the distance used to merge the results of the shards.
+    DistanceType distance_type() const { return distance_; }
+
+    ///// Search Parameters
+
+    /// @brief Return the default search parameters of shard ``i``.
+    search_parameters_type get_search_parameters(size_t i) const {
+        return search_parameters_.at(i);
+    }
+
+    /// @brief Return the default search parameters of each shard.
+    const std::vector<search_parameters_type>& get_search_parameters() const {
+        return search_parameters_;
+    }
+
+    /// @brief Set the default search parameters of shard ``i``.
+    void set_search_parameters(size_t i, const search_parameters_type& search_parameters) {
+        search_parameters_.at(i) = search_parameters;
+    }
+
+    /// @brief Set the default search parameters of all shards.
+    void set_search_parameters(const search_parameters_type& search_parameters) {
+        std::fill(search_parameters_.begin(), search_parameters_.end(), search_parameters);
+    }
+
+    ///// Search
+
+    ///
+    /// @brief Fill the result with the nearest neighbors of each query among all shards.
+    ///
+    /// @param result The result data structure to populate.
+    /// @param queries The queries.
+    /// @param search_parameters The search parameters to use for each shard.
+    ///
+    /// IDs in ``result`` are global IDs.
+    ///
+    template <typename QueryType>
+    void search(
+        QueryResultView<size_t> result,
+        data::ConstSimpleDataView<QueryType> queries,
+        std::span<const search_parameters_type> search_parameters
+    ) {
+        const size_t num_shards = shards_.size();
+        if (search_parameters.size() != num_shards) {
+            throw ANNEXCEPTION(
+                "Got search parameters for {} shards but the index has {} shards!",
+                search_parameters.size(),
+                num_shards
+            );
+        }
+        const size_t num_queries = queries.size();
+        const size_t num_neighbors = result.n_neighbors();
+
+        auto shard_results = std::vector<QueryResult<size_t>>();
+        shard_results.reserve(num_shards);
+        for (size_t s = 0; s < num_shards; ++s) {
+            shard_results.emplace_back(num_queries, num_neighbors);
+        }
+
+        // Fan out: each task searches all queries on one shard, parallelized by the thread
+        // pool of the shard. Shards are never searched by two tasks at once, so their
+        // thread pools do not serialize concurrent searches.
+        threads::run(
+            threadpool_,
+            threads::DynamicPartition{num_shards, 1},
+            [&](const auto& ss, uint64_t SVS_UNUSED(tid)) {
+                for (auto s : ss) {
+                    auto view = shard_results[s].view();
+                    shards_[s].search(view, queries, search_parameters[s]);
+                }
+            }
+        );
+
+        // Merge the per-shard results of each query.
+        visit_comparator([&]<typename Cmp>(Cmp SVS_UNUSED(cmp)) {
+            threads::run(
+                threadpool_,
+                threads::StaticPartition{num_queries},
+                [&](const auto& is, uint64_t SVS_UNUSED(tid)) {
+                    auto merge = KWayMerge<Cmp>(num_shards);
+                    for (auto i : is) {
+                        merge(
+                            result,
+                            i,
+                            lib::as_const_span(shard_results),
+                            lib::as_const_span(offsets_)
+                        );
+                    }
+                }
+            );
+        });
+    }
+
+    /// @brief Search using the default search parameters of each shard.
+    template <typename QueryType>
+    void search(
+        QueryResultView<size_t> result, data::ConstSimpleDataView<QueryType> queries
+    ) {
+        search(result, queries, lib::as_const_span(search_parameters_));
+    }
+
+    ///
+    /// @brief Return the ``num_neighbors`` nearest neighbors of each query among all
+    ///     shards using the default search parameters.
+    ///
+    template <typename Queries>
+    QueryResult<size_t> search(const Queries& queries, size_t num_neighbors) {
+        auto result = QueryResult<size_t>(queries.size(), num_neighbors);
+        search(result.view(), queries.cview());
+        return result;
+    }
+
+    ///// Threading Interface
+
+    /// @brief Return the number of threads used for searching.
+    size_t get_num_threads() const { return threadpool_.size(); }
+
+    ///
+    /// @brief Set the number of threads used for searching.
+    ///
+    /// The threads are divided among the shards that support changing their thread count.
+    ///
+    void set_num_threads(size_t num_threads) {
+        threadpool_.resize(std::max(num_threads, size_t{1}));
+        distribute_threads();
+    }
+
+    ///// Saving and Loading
+
+    ///
+    /// @brief Save the sharded index to ``directory``.
+    ///
+    /// @param directory The directory to save to.
+    /// @param saver Invoked as ``saver(shard, path)`` to save each shard to a separate
+    ///     subdirectory of ``directory``.
+    ///
+    /// @sa load
+    ///
+    template <typename Saver>
+    void save(const std::filesystem::path& directory, Saver&& saver) {
+        std::filesystem::create_directories(directory);
+        for (size_t s = 0, smax = shards_.size(); s < smax; ++s) {
+            saver(shards_[s], detail::shard_path(directory, s));
+        }
+        lib::save_to_disk(
+            detail::ShardedIndexConfig{offsets_, distance_}, directory / "config"
+        );
+    }
+
+    ///
+    /// @brief Save a sharded index whose shards save to a single directory.
+    ///
+    /// Requires ``Index`` to provide ``save(const std::filesystem::path&)``, as
+    /// ``svs::Inverted`` does.
+    ///
+    void save(const std::filesystem::path& directory)
+        requires requires(Index& index, const std::filesystem::path& path) {
+                     index.save(path);
+                 }
+    {
+        save(directory, [](Index& index, const std::filesystem::path& path) {
+            index.save(path);
+        });
+    }
+
+    ///
+    /// @brief Load a sharded index saved with ``save``.
+    ///
+    /// @param directory The directory the index was saved to.
+    /// @param loader Invoked as ``loader(path)`` to load each shard from the path it was
+    ///     saved to, returning an ``Index``.
+    /// @param num_threads The number of threads used for searching.
+    ///
+    template <typename Loader>
+    static ShardedIndex
+    load(const std::filesystem::path& directory, Loader&& loader, size_t num_threads) {
+        auto config = lib::load_from_disk<detail::ShardedIndexConfig>(directory / "config");
+        auto shards = std::vector<Index>();
+        for (size_t s = 0, smax = config.offsets_.size(); s < smax; ++s) {
+            shards.push_back(loader(detail::shard_path(directory, s)));
+        }
+        return ShardedIndex(
+            std::move(shards), std::move(config.offsets_), config.distance_, num_threads
+        );
+    }
+
+#if SVS_ENABLE_NUMA
+    ///
+    /// @brief Construct each shard on a NUMA node.
+    ///
+    /// @param num_shards The number of shards.
+    /// @param f Invoked as ``f(i)`` to construct shard ``i``, returning an ``Index``.
+    /// @param distance The distance used by all shards.
+    /// @param num_threads The number of threads used for searching.
+    ///
+    /// Shards are distributed round-robin over the NUMA nodes and constructed by a thread
+    /// bound to that node, so that memory allocated by each shard is local to its node.
+    ///
+    template <typename F>
+    static ShardedIndex
+    build_on_nodes(size_t num_shards, F&& f, DistanceType distance, size_t num_threads) {
+        auto threadpool = threads::internuma_threadpool();
+        auto shards = std::vector<std::optional<Index>>(num_shards);
+        threads::run(threadpool, [&](uint64_t node) {
+            for (size_t s = node; s < num_shards; s += threadpool.size()) {
+                shards[s].emplace(f(s));
+            }
+        });
+        auto unwrapped = std::vector<Index>();
+        for (auto& shard : shards) {
+            unwrapped.push_back(std::move(shard).value());
+        }
+        return ShardedIndex(std::move(unwrapped), distance, num_threads);
+    }
+#endif
+
+  private:
+    // Divide the threads of the sharded index evenly among the shards, giving each shard at
+    // least one thread. Shards are searched concurrently, so the total number of searching
+    // threads matches the size of the thread pool whenever it has at least as many threads
+    // as there are shards.
+    void distribute_threads() {
+        const size_t num_threads = threadpool_.size();
+        const size_t num_shards = shards_.size();
+        for (size_t s = 0; s < num_shards; ++s) {
+            auto& shard = shards_[s];
+            if (shard.can_change_threads()) {
+                size_t share = num_threads / num_shards + (s < num_threads % num_shards);
+                shard.set_num_threads(std::max(share, size_t{1}));
+            }
+        }
+    }
+
+    // Invoke `f` with the comparator ordering the distances of the shards.
+    template <typename F> void visit_comparator(F&& f) const {
+        switch (distance_) {
+            case DistanceType::L2: {
+                f(std::less<>());
+                return;
+            }
+            case DistanceType::MIP:
+            case DistanceType::Cosine: {
+                f(std::greater<>());
+                return;
+            }
+        }
+        throw ANNEXCEPTION("Unknown distance type!");
+    }
+
+    std::vector<Index> shards_;
+    std::vector<size_t> offsets_;
+    std::vector<search_parameters_type> search_parameters_{};
+    DistanceType distance_;
+    threads::NativeThreadPool threadpool_;
+};
+
+} // namespace svs
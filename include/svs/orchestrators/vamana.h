@@ -61,6 +61,9 @@ class VamanaInterface {
     virtual void
     reconstruct_at(data::SimpleDataView<float> dst, std::span<const uint64_t> ids) = 0;
 
+    ///// Reordering
+    virtual void reorder(index::vamana::GraphOrdering ordering) = 0;
+
     ///// Calibrations
     virtual index::vamana::VamanaSearchParameters experimental_calibrate(
         ConstErasedPointer queries,
@@ -142,6 +145,15 @@ class VamanaImpl : public manager::ManagerImpl<QueryTypes, Impl, IFace> {
         impl().reconstruct_at(data, ids);
     }
 
+    ///// Reordering
+    void reorder(index::vamana::GraphOrdering ordering) override {
+        if constexpr (requires { impl().reorder(ordering); }) {
+            impl().reorder(ordering);
+        } else {
+            throw ANNEXCEPTION("The current Vamana backend doesn't support reordering!");
+        }
+    }
+
     ///// Calibration
 
     VamanaSearchParameters experimental_calibrate(
@@ -291,6 +303,15 @@ class Vamana : public manager::IndexManager<VamanaInterface> {
         impl_->reconstruct_at(data, ids);
     }
 
+    ///
+    /// @copydoc svs::index::vamana::VamanaIndex::reorder(GraphOrdering)
+    ///
+    void reorder(
+        index::vamana::GraphOrdering ordering = index::vamana::GraphOrdering::BreadthFirst
+    ) {
+        impl_->reorder(ordering);
+    }
+
     ///
     /// @brief Load a Vamana Index from a previously saved index.
     ///
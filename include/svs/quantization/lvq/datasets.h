@@ -592,7 +592,7 @@ class ScaledBiasedDataset {
         }
         // If the data dimensions doesn't match the alignment, then we were constructed
         // incorrectly.
-        if (data_dims % alignment_) {
+        if (alignment_ != 0 && data_dims % alignment_) {
             throw ANNEXCEPTION("Misaligned data");
         }
     }
@@ -706,6 +706,20 @@ class ScaledBiasedDataset {
             throw ANNEXCEPTION("Could not open file with uuid {}!", uuid.str());
         }
 
+        // Sequentially packed data without padding is stored in its canonical layout.
+        // In that case, memory mapped datasets use the saved file in place.
+        auto logical_dims = lib::MaybeStatic<Extent>(ndims);
+        if constexpr (is_mmap_allocator_v<Alloc> && std::is_same_v<Strategy, Sequential>) {
+            auto layout = helper_type(logical_dims);
+            if (compute_data_dimensions(layout, alignment) == layout.total_bytes()) {
+                auto data = dataset_type::map(binary_file.value(), allocator);
+                detail::assert_equal(
+                    data.size(), lib::load_at<size_t>(table, "num_vectors")
+                );
+                return ScaledBiasedDataset(std::move(data), alignment, logical_dims);
+            }
+        }
+
         // Setup and execute the binary loading.
         auto expected_size = lib::load_at<size_t>(table, "num_vectors");
         auto lazy_constructor =
@@ -721,9 +735,7 @@ class ScaledBiasedDataset {
                 // Ignore the number of dimensions returned from the file deduction.
                 // The number of provided dimensions corresponds to the number of bytes in
                 // the canonical layout.
-                return ScaledBiasedDataset(
-                    size, lib::MaybeStatic<Extent>(ndims), alignment, allocator
-                );
+                return ScaledBiasedDataset(size, logical_dims, alignment, allocator);
             });
         auto write_accessor = detail::CanonicalAccessor();
         return io::load_dataset(binary_file.value(), write_accessor, lazy_constructor);
@@ -231,6 +231,9 @@ class LVQDataset {
     /// @brief Prefetch only the primary dataset.
     void prefetch_primary(size_t i) const { primary_.prefetch(i); }
 
+    /// @brief Prefetch only the residual dataset.
+    void prefetch_residual(size_t i) const { residual_.prefetch(i); }
+
     ///// Resizing
     void resize(size_t new_size)
         requires is_resizeable
@@ -1048,7 +1051,7 @@ struct LVQLoader {
                         source.type,
                         [&]<typename T>(lib::Type<T> SVS_UNUSED(type)) {
                             return loaded_type::compress(
-                                data::SimpleData<T>::load(source.path),
+                                data::SimpleData<T>::load(source.path, threadpool),
                                 threadpool,
                                 alignment_,
                                 allocator_
@@ -0,0 +1,112 @@
+/**
+ *    Copyright (C) 2023, Intel Corporation
+ *
+ *    You can redistribute and/or modify this software under the terms of the
+ *    GNU Affero General Public License version 3.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    version 3 along with this software. If not, see
+ *    <https://www.gnu.org/licenses/agpl-3.0.en.html>.
+ */
+
+// Code under test.
+#include "svs-benchmark/latency.h"
+#include "svs-benchmark/search.h"
+
+// catch2
+#include "catch2/catch_test_macros.hpp"
+
+// stl
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+CATCH_TEST_CASE("Latency Histogram", "[benchmark]") {
+    using Histogram = svsbenchmark::LatencyHistogram;
+
+    CATCH_SECTION("Buckets") {
+        // Small values are exact.
+        for (uint64_t i = 0; i < 2 * Histogram::sub_buckets; ++i) {
+            CATCH_REQUIRE(Histogram::bucket_index(i) == i);
+            CATCH_REQUIRE(Histogram::lowest_equivalent(i) == i);
+            CATCH_REQUIRE(Histogram::highest_equivalent(i) == i);
+        }
+
+        // Bucket boundaries are contiguous and each bucket covers its values with bounded
+        // relative error.
+        for (size_t i = 0; i + 1 < Histogram::num_buckets; ++i) {
+            auto lo = Histogram::lowest_equivalent(i);
+            auto hi = Histogram::highest_equivalent(i);
+            CATCH_REQUIRE(lo <= hi);
+            CATCH_REQUIRE(Histogram::lowest_equivalent(i + 1) == hi + 1);
+            CATCH_REQUIRE(Histogram::bucket_index(lo) == i);
+            CATCH_REQUIRE(Histogram::bucket_index(hi) == i);
+            CATCH_REQUIRE((hi - lo) <= lo / Histogram::sub_buckets);
+        }
+
+        auto max = std::numeric_limits<uint64_t>::max();
+        CATCH_REQUIRE(Histogram::bucket_index(max) == Histogram::num_buckets - 1);
+        CATCH_REQUIRE(Histogram::highest_equivalent(Histogram::num_buckets - 1) == max);
+    }
+
+    CATCH_SECTION("Percentiles") {
+        auto histogram = Histogram();
+        CATCH_REQUIRE(histogram.count() == 0);
+        CATCH_REQUIRE(histogram.value_at_percentile(50) == 0);
+
+        // Record 1..=10000.
+        for (uint64_t i = 1; i <= 10'000; ++i) {
+            histogram.record(i);
+        }
+        CATCH_REQUIRE(histogram.count() == 10'000);
+        CATCH_REQUIRE(histogram.min() == 1);
+        CATCH_REQUIRE(histogram.max() == 10'000);
+        CATCH_REQUIRE(histogram.mean() == 5000.5);
+
+        auto check = [&](double p, uint64_t expected) {
+            auto v = histogram.value_at_percentile(p);
+            // Never optimistic, and within the relative error of the histogram.
+            CATCH_REQUIRE(v >= expected);
+            CATCH_REQUIRE(v <= expected + expected / Histogram::sub_buckets);
+        };
+        check(50, 5'000);
+        check(90, 9'000);
+        check(99, 9'900);
+        check(99.9, 9'990);
+        CATCH_REQUIRE(histogram.value_at_percentile(100) == 10'000);
+        CATCH_REQUIRE(histogram.value_at_percentile(0) == 1);
+        CATCH_REQUIRE_THROWS_AS(histogram.value_at_percentile(101), svs::ANNException);
+
+        // Merging.
+        auto other = Histogram();
+        other.record(1'000'000, 10'000);
+        histogram.merge(other);
+        CATCH_REQUIRE(histogram.count() == 20'000);
+        CATCH_REQUIRE(histogram.max() == 1'000'000);
+        check(25, 5'000);
+        CATCH_REQUIRE(histogram.value_at_percentile(51) == 1'000'000);
+    }
+}
+
+CATCH_TEST_CASE("Latency Report", "[benchmark]") {
+    using Report = svsbenchmark::search::LatencyReport;
+
+    // 10 queries with 4 neighbors each.
+    auto counts = std::vector<size_t>{1, 0, 1, 3, 5};
+    CATCH_REQUIRE(Report::recall_mean(counts) == (0.0 + 2 + 3 * 3 + 4 * 5) / 40);
+    CATCH_REQUIRE(Report::recall_at_percentile(counts, 1) == 0.0);
+    CATCH_REQUIRE(Report::recall_at_percentile(counts, 10) == 0.0);
+    CATCH_REQUIRE(Report::recall_at_percentile(counts, 20) == 0.5);
+    CATCH_REQUIRE(Report::recall_at_percentile(counts, 50) == 0.75);
+    CATCH_REQUIRE(Report::recall_at_percentile(counts, 51) == 1.0);
+
+    auto histogram = svsbenchmark::LatencyHistogram();
+    histogram.record(2'000, 10);
+    auto parameters = svsbenchmark::search::LatencyParameters(1);
+    auto report = Report(parameters, histogram, 0.5, counts);
+    CATCH_REQUIRE(report.num_queries_ == 10);
+    CATCH_REQUIRE(report.qps_ == 20.0);
+    CATCH_REQUIRE(report.latency_p50_us_ == 2.0);
+    CATCH_REQUIRE(report.latency_max_us_ == 2.0);
+    CATCH_REQUIRE(report.recall_counts_ == counts);
+}
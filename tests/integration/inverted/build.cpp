@@ -19,6 +19,7 @@
 // tests
 #include "tests/utils/inverted_reference.h"
 #include "tests/utils/test_dataset.h"
+#include "tests/utils/utils.h"
 
 // catch2
 #include "catch2/catch_test_macros.hpp"
@@ -49,6 +50,19 @@ svs::Inverted build_index(
     return index;
 }
 
+// The clustered dataset types to use when reloading a saved index.
+template <typename Strategy> struct ReloadedCluster;
+
+template <> struct ReloadedCluster<svs::index::inverted::SparseStrategy> {
+    using type = svs::index::inverted::SparseClusteredDataset<
+        svs::data::SimpleData<float, svs::Dynamic, svs::HugepageAllocator<float>>,
+        uint32_t>;
+};
+
+template <> struct ReloadedCluster<svs::index::inverted::DenseStrategy> {
+    using type = svs::index::inverted::MappedDenseClusteredDataset<float>;
+};
+
 template <typename Distance, typename Strategy, typename Queries>
 void run_test(const Queries& queries) {
     auto distance = Distance();
@@ -95,6 +109,31 @@ void run_test(const Queries& queries) {
             CATCH_REQUIRE(recall < expected.recall_ + epsilon);
         }
     }
+
+    // Saving and reloading.
+    auto data = svs::data::SimpleData<float>::load(test_dataset::data_svs_file());
+    CATCH_REQUIRE(index.size() == data.size());
+
+    auto expected = index.search(queries, 10);
+    svs_test::prepare_temp_directory();
+    auto dir = svs_test::temp_directory() / "inverted";
+    index.save(dir);
+
+    svs::Inverted reloaded = svs::Inverted::assemble<
+        float,
+        svs::data::SimpleData<float>,
+        typename ReloadedCluster<Strategy>::type>(dir, distance, num_threads);
+    CATCH_REQUIRE(reloaded.size() == index.size());
+    CATCH_REQUIRE(reloaded.get_num_threads() == num_threads);
+    CATCH_REQUIRE(reloaded.get_search_parameters() == index.get_search_parameters());
+
+    reloaded.set_num_threads(index.get_num_threads());
+    auto results = reloaded.search(queries, 10);
+    for (size_t i = 0, imax = results.n_queries(); i < imax; ++i) {
+        for (size_t j = 0, jmax = results.n_neighbors(); j < jmax; ++j) {
+            CATCH_REQUIRE(results.index(i, j) == expected.index(i, j));
+        }
+    }
 }
 
 } // namespace
@@ -10,6 +10,7 @@
  */
 
 // stl
+#include <algorithm>
 #include <cstdint>
 #include <filesystem>
 #include <iostream>
@@ -184,6 +185,18 @@ void run_tests(
             CATCH_REQUIRE(recall > expected.recall_ - epsilon);
             CATCH_REQUIRE(recall < expected.recall_ + epsilon);
 
+            // Interleaving queries on each thread should not change the results.
+            auto interleaved_parameters = expected.search_parameters_;
+            interleaved_parameters.interleave(5);
+            index.set_search_parameters(interleaved_parameters);
+            auto interleaved = index.search(queries, expected.num_neighbors_);
+            index.set_search_parameters(expected.search_parameters_);
+            const auto& indices = results.indices();
+            const auto& interleaved_indices = interleaved.indices();
+            CATCH_REQUIRE(
+                std::equal(indices.begin(), indices.end(), interleaved_indices.begin())
+            );
+
             // Test Float16 results, but only on the first iteration.
             // Otherwise, skip it to keep run times down.
             if (first) {
@@ -226,6 +239,19 @@ void run_tests(
         first_result.recall_k_
     );
     CATCH_REQUIRE(recall >= first_result.recall_);
+
+    // Tuning early termination must still reach the target recall.
+    c.train_early_termination_ = true;
+    index.experimental_calibrate(
+        queries, groundtruth, first_result.num_neighbors_, first_result.recall_, c
+    );
+    recall = svs::k_recall_at_n(
+        groundtruth,
+        index.search(queries, first_result.num_neighbors_),
+        first_result.num_neighbors_,
+        first_result.recall_k_
+    );
+    CATCH_REQUIRE(recall >= first_result.recall_);
 }
 } // namespace
 
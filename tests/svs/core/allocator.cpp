@@ -10,8 +10,14 @@
  */
 
 // stdlib
+#include <cstdint>
+#include <cstdio>
 #include <filesystem>
+#include <fstream>
 #include <memory>
+#include <numeric>
+#include <string>
+#include <string_view>
 #include <vector>
 
 // svs
@@ -48,6 +54,25 @@ static_assert(std::is_same_v<
 static_assert(std::is_same_v<typename Traits::propagate_on_container_swap, std::true_type>);
 static_assert(std::is_same_v<typename Traits::is_always_equal, std::true_type>);
 
+// Return the ``Anonymous`` size in kB of the mapping containing `ptr`, as reported by
+// ``/proc/self/smaps``.
+size_t anonymous_kb(const void* ptr) {
+    auto address = reinterpret_cast<uintptr_t>(ptr);
+    auto stream = std::ifstream("/proc/self/smaps");
+    auto line = std::string();
+    bool found = false;
+    while (std::getline(stream, line)) {
+        uintptr_t start = 0;
+        uintptr_t stop = 0;
+        if (std::sscanf(line.c_str(), "%lx-%lx ", &start, &stop) == 2) {
+            found = (start <= address && address < stop);
+        } else if (found && line.starts_with("Anonymous:")) {
+            return std::stoull(line.substr(std::string_view("Anonymous:").size()));
+        }
+    }
+    throw ANNEXCEPTION("Could not find the mapping of {} in smaps!", ptr);
+}
+
 } // namespace
 
 CATCH_TEST_CASE("Testing Allocator", "[allocators]") {
@@ -132,4 +157,115 @@ CATCH_TEST_CASE("Testing Allocator", "[allocators]") {
             }
         }
     }
+
+    CATCH_SECTION("Testing `MMapAllocator`") {
+        using Registry = svs::detail::MMapRegistry;
+        CATCH_REQUIRE(svs_test::prepare_temp_directory());
+        auto temp_file = svs_test::temp_directory() / "mapped.bin";
+
+        // Write a file with a 64-byte header followed by the values 0 to 99.
+        const size_t offset = 64;
+        const size_t nelements = 100;
+        auto contents = std::vector<float>(nelements);
+        std::iota(contents.begin(), contents.end(), 0);
+        {
+            auto stream = std::ofstream(temp_file, std::ios_base::binary);
+            auto header = std::vector<char>(offset, 'x');
+            stream.write(header.data(), static_cast<std::streamsize>(offset));
+            stream.write(
+                reinterpret_cast<const char*>(contents.data()),
+                static_cast<std::streamsize>(sizeof(float) * nelements)
+            );
+        }
+
+        CATCH_SECTION("Anonymous") {
+            auto allocator = svs::MMapAllocator<float>();
+            CATCH_REQUIRE(!allocator.is_bound());
+            CATCH_REQUIRE(allocator.allocate(0) == nullptr);
+            float* ptr = allocator.allocate(nelements);
+            auto mappings = Registry::get_mappings();
+            CATCH_REQUIRE(mappings.size() == 1);
+            CATCH_REQUIRE(mappings.at(ptr).base == ptr);
+            CATCH_REQUIRE(mappings.at(ptr).size == sizeof(float) * nelements);
+            for (size_t i = 0; i < nelements; ++i) {
+                ptr[i] = 2 * i;
+            }
+            allocator.deallocate(ptr, nelements);
+            CATCH_REQUIRE(Registry::get_mappings().empty());
+        }
+
+        CATCH_SECTION("File Backed") {
+            auto populate = svs::MMapOptions().willneed(true).hugepage(true);
+            auto prefault = svs::MMapOptions().populate(false).prefault_threads(2);
+            for (auto opt : {populate, prefault}) {
+                auto allocator = svs::MMapAllocator<float>(opt).bind(temp_file, offset);
+                CATCH_REQUIRE(allocator.options() == opt);
+                CATCH_REQUIRE(allocator.is_bound());
+
+                // The first allocation maps the file contents after the header.
+                float* ptr = allocator.allocate(nelements);
+                CATCH_REQUIRE(!allocator.is_bound());
+                CATCH_REQUIRE(std::equal(ptr, ptr + nelements, contents.begin()));
+                auto mapping = Registry::get_mappings().at(ptr);
+                CATCH_REQUIRE(static_cast<char*>(mapping.base) + offset == (void*)ptr);
+                CATCH_REQUIRE(mapping.size == offset + sizeof(float) * nelements);
+
+                // Writes are private to the mapping.
+                ptr[0] = -1;
+
+                // Later allocations are anonymous.
+                float* other = allocator.allocate(nelements);
+                CATCH_REQUIRE(Registry::get_mappings().at(other).base == other);
+                allocator.deallocate(other, nelements);
+                allocator.deallocate(ptr, nelements);
+                CATCH_REQUIRE(Registry::get_mappings().empty());
+            }
+
+            auto allocator = svs::MMapAllocator<float>().bind(temp_file, offset);
+            float* ptr = allocator.allocate(nelements);
+            CATCH_REQUIRE(ptr[0] == 0);
+            allocator.deallocate(ptr, nelements);
+
+            // Copies of containers do not map the file again.
+            auto copy = std::allocator_traits<svs::MMapAllocator<float>>::
+                select_on_container_copy_construction(allocator.bind(temp_file));
+            CATCH_REQUIRE(!copy.is_bound());
+
+            // Mapping past the end of the file fails.
+            allocator = svs::MMapAllocator<float>().bind(temp_file, offset);
+            CATCH_REQUIRE_THROWS_AS(allocator.allocate(nelements + 1), svs::ANNException);
+            CATCH_REQUIRE(Registry::get_mappings().empty());
+        }
+
+        CATCH_SECTION("File Backed Memory") {
+            // Populating a file mapping must not copy the file into anonymous memory.
+            auto large_file = svs_test::temp_directory() / "large.bin";
+            const size_t large_elements = 1 << 20;
+            {
+                auto stream = std::ofstream(large_file, std::ios_base::binary);
+                auto large = std::vector<float>(large_elements, 1.0f);
+                stream.write(
+                    reinterpret_cast<const char*>(large.data()),
+                    static_cast<std::streamsize>(sizeof(float) * large_elements)
+                );
+            }
+
+            auto allocator = svs::MMapAllocator<float>().bind(large_file);
+            float* ptr = allocator.allocate(large_elements);
+            CATCH_REQUIRE(ptr[large_elements - 1] == 1.0f);
+            CATCH_REQUIRE(anonymous_kb(ptr) <= 64);
+
+            // Writing copies only the written page.
+            ptr[0] = 2.0f;
+            CATCH_REQUIRE(anonymous_kb(ptr) <= 64 + 4);
+            allocator.deallocate(ptr, large_elements);
+        }
+
+        CATCH_SECTION("Prefault") {
+            auto threadpool = svs::threads::NativeThreadPool(3);
+            svs::prefault(contents.data(), sizeof(float) * nelements, threadpool);
+            auto large = std::vector<std::byte>(1 << 20);
+            svs::prefault(large.data(), large.size(), threadpool);
+        }
+    }
 }
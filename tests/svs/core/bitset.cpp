@@ -0,0 +1,138 @@
+/**
+ *    Copyright (C) 2023, Intel Corporation
+ *
+ *    You can redistribute and/or modify this software under the terms of the
+ *    GNU Affero General Public License version 3.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    version 3 along with this software. If not, see
+ *    <https://www.gnu.org/licenses/agpl-3.0.en.html>.
+ */
+
+// header under test
+#include "svs/core/bitset.h"
+
+// catch2
+#include "catch2/catch_test_macros.hpp"
+
+// stl
+#include <vector>
+
+namespace {
+
+std::vector<size_t> collect(const svs::BitSet& bitset, size_t start, size_t stop) {
+    auto result = std::vector<size_t>();
+    bitset.for_each(start, stop, [&](size_t i) { result.push_back(i); });
+    return result;
+}
+
+} // namespace
+
+CATCH_TEST_CASE("BitSet", "[core][bitset]") {
+    CATCH_SECTION("Basic") {
+        auto bitset = svs::BitSet(130);
+        CATCH_REQUIRE(bitset.size() == 130);
+        CATCH_REQUIRE(bitset.words().size() == 3);
+        CATCH_REQUIRE(bitset.count() == 0);
+
+        for (size_t i : {0, 5, 63, 64, 100, 129}) {
+            bitset.set(i);
+        }
+        CATCH_REQUIRE(bitset.count() == 6);
+        CATCH_REQUIRE(bitset.test(63));
+        CATCH_REQUIRE(bitset(64));
+        CATCH_REQUIRE(!bitset.test(1));
+        CATCH_REQUIRE(!bitset.test(130));
+        CATCH_REQUIRE(!bitset.test(1000));
+
+        bitset.reset(64);
+        CATCH_REQUIRE(!bitset.test(64));
+        CATCH_REQUIRE(bitset.count() == 5);
+
+        CATCH_REQUIRE_THROWS_AS(bitset.set(130), svs::ANNException);
+        CATCH_REQUIRE_THROWS_AS(bitset.reset(130), svs::ANNException);
+
+        // Views reference the same bits.
+        auto view = bitset.view();
+        CATCH_REQUIRE(view.size() == 130);
+        CATCH_REQUIRE(view.count() == 5);
+        CATCH_REQUIRE(view(129));
+        CATCH_REQUIRE(!view(128));
+    }
+
+    CATCH_SECTION("Filled") {
+        auto bitset = svs::BitSet(70, true);
+        CATCH_REQUIRE(bitset.count() == 70);
+        CATCH_REQUIRE(bitset.test(69));
+        CATCH_REQUIRE(!bitset.test(70));
+        CATCH_REQUIRE(collect(bitset, 0, 1000).size() == 70);
+
+        auto empty = svs::BitSet();
+        CATCH_REQUIRE(empty.size() == 0);
+        CATCH_REQUIRE(empty.count() == 0);
+        CATCH_REQUIRE(collect(empty, 0, 10).empty());
+    }
+
+    CATCH_SECTION("Iteration") {
+        auto bitset = svs::BitSet(300);
+        auto expected = std::vector<size_t>();
+        for (size_t i = 0; i < bitset.size(); i += 7) {
+            bitset.set(i);
+            expected.push_back(i);
+        }
+        // Leave words 2 and 3 empty.
+        for (size_t i = 128; i < 256; ++i) {
+            bitset.reset(i);
+        }
+        std::erase_if(expected, [](size_t i) { return i >= 128 && i < 256; });
+        CATCH_REQUIRE(collect(bitset, 0, bitset.size()) == expected);
+
+        // Every sub-range is visited exactly.
+        for (size_t start : {0, 1, 7, 63, 64, 65, 127, 200, 299, 300}) {
+            for (size_t stop : {0, 1, 8, 64, 100, 128, 257, 299, 300, 500}) {
+                auto sub = std::vector<size_t>();
+                for (auto i : expected) {
+                    if (i >= start && i < stop) {
+                        sub.push_back(i);
+                    }
+                }
+                CATCH_REQUIRE(collect(bitset, start, stop) == sub);
+            }
+        }
+    }
+}
+
+CATCH_TEST_CASE("Search Filter", "[core][bitset]") {
+    auto filter = svs::SearchFilter();
+    CATCH_REQUIRE(filter.empty());
+    CATCH_REQUIRE(!filter.is_per_query());
+    filter.check(10);
+
+    auto allowed = svs::BitSet(10);
+    allowed.set(3);
+    filter = svs::SearchFilter(allowed);
+    CATCH_REQUIRE(!filter.empty());
+    CATCH_REQUIRE(!filter.is_per_query());
+    filter.check(5);
+    // Shared filters apply to every query.
+    CATCH_REQUIRE(filter.view(0).test(3));
+    CATCH_REQUIRE(filter.view(4).test(3));
+    CATCH_REQUIRE(!filter.view(4).test(2));
+
+    auto per_query = std::vector<svs::BitSet>(2, svs::BitSet(10));
+    per_query[0].set(1);
+    per_query[1].set(2);
+    filter = svs::SearchFilter(per_query);
+    CATCH_REQUIRE(!filter.empty());
+    CATCH_REQUIRE(filter.is_per_query());
+    filter.check(2);
+    CATCH_REQUIRE_THROWS_AS(filter.check(3), svs::ANNException);
+    CATCH_REQUIRE(filter.view(0).test(1));
+    CATCH_REQUIRE(!filter.view(0).test(2));
+    CATCH_REQUIRE(filter.view(1).test(2));
+
+    // A per-query filter for an empty batch is not the same as no filter.
+    filter = svs::SearchFilter(std::vector<svs::BitSet>());
+    CATCH_REQUIRE(!filter.empty());
+    filter.check(0);
+}
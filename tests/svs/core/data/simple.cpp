@@ -15,8 +15,10 @@
 #include "svs/core/data/view.h"
 
 #include "tests/svs/core/data/data.h"
+#include "tests/utils/utils.h"
 
 // stdlib
+#include <filesystem>
 #include <span>
 #include <type_traits>
 
@@ -210,3 +212,70 @@ CATCH_TEST_CASE("Testing Simple Data", "[core][data]") {
         );
     }
 }
+
+CATCH_TEST_CASE("Memory Mapped Simple Data", "[core][data]") {
+    using Alloc = svs::MMapAllocator<float>;
+    using Mapped = svs::data::SimpleData<float, svs::Dynamic, Alloc>;
+    using Registry = svs::detail::MMapRegistry;
+
+    CATCH_REQUIRE(svs_test::prepare_temp_directory());
+    auto dir = svs_test::temp_directory() / "data";
+    auto x = svs::data::SimpleData<float>(100, 10);
+    fill_lines(x);
+    svs::lib::save_to_disk(x, dir);
+    const size_t file_bytes = sizeof(svs::io::v1::Header) + sizeof(float) * 100 * 10;
+
+    CATCH_SECTION("Reload") {
+        auto options = svs::MMapOptions().populate(false).prefault_threads(2);
+        for (auto opt : {svs::MMapOptions(), options}) {
+            auto y = Mapped::load(dir, Alloc(opt));
+            CATCH_REQUIRE(y.size() == 100);
+            CATCH_REQUIRE(y.dimensions() == 10);
+            CATCH_REQUIRE(check_fill_lines(y));
+            CATCH_REQUIRE(y.get_allocator().options() == opt);
+
+            // The dataset is backed by a mapping of the whole saved file.
+            auto mappings = Registry::get_mappings();
+            CATCH_REQUIRE(mappings.size() == 1);
+            CATCH_REQUIRE(mappings.at(y.data()).size == file_bytes);
+        }
+        CATCH_REQUIRE(Registry::get_mappings().empty());
+    }
+
+    CATCH_SECTION("Private Writes") {
+        {
+            auto y = Mapped::load(dir);
+            auto z = y;
+            CATCH_REQUIRE(check_fill_lines(z));
+            CATCH_REQUIRE(Registry::get_mappings().at(z.data()).base == z.data());
+
+            fill_lines(y);
+            y.get_datum(0)[0] = -1;
+            CATCH_REQUIRE(!check_fill_lines(y));
+            CATCH_REQUIRE(check_fill_lines(z));
+
+            // Growing the dataset moves it to anonymous memory.
+            y.resize(200);
+            CATCH_REQUIRE(Registry::get_mappings().at(y.data()).base == y.data());
+            CATCH_REQUIRE(y.get_datum(0)[0] == -1);
+        }
+        // The saved file is left untouched.
+        auto y = Mapped::load(dir);
+        CATCH_REQUIRE(check_fill_lines(y));
+    }
+
+    CATCH_SECTION("Native Files") {
+        auto file = std::filesystem::path();
+        for (const auto& entry : std::filesystem::directory_iterator(dir)) {
+            if (entry.path().extension() == ".svs") {
+                file = entry.path();
+            }
+        }
+        auto y = svs::data::SimpleData<float, 10, Alloc>::load(file);
+        CATCH_REQUIRE(check_fill_lines(y));
+        CATCH_REQUIRE(Registry::get_mappings().at(y.data()).size == file_bytes);
+        CATCH_REQUIRE_THROWS_AS(
+            (svs::data::SimpleData<float, 20, Alloc>::load(file)), svs::ANNException
+        );
+    }
+}
@@ -21,7 +21,9 @@
 // svs
 #include "svs/concepts/distance.h"
 #include "svs/core/distance/cosine.h"
+#include "svs/lib/arch.h"
 #include "svs/lib/array.h"
+#include "svs/lib/bfloat16.h"
 #include "svs/lib/float16.h"
 #include "svs/lib/static.h"
 
@@ -86,6 +88,18 @@ void test_types(T lo, T hi, size_t num_tests) {
         // Dynamically Sized Computation
         auto dist = svs::distance::CosineSimilarity::compute(a.data(), b.data(), a_norm, N);
         CATCH_REQUIRE((dist == expected));
+
+        // Every implementation the host can execute.
+        using Dispatcher =
+            svs::simd::Dispatcher<svs::distance::CosineSimilarityKernel, N, Ea, Eb>;
+        for (auto isa : svs::arch::all_isas) {
+            if (!svs::arch::is_supported(isa)) {
+                continue;
+            }
+            auto f = Dispatcher::resolve(isa);
+            auto dist_isa = f(a.data(), b.data(), a_norm, svs::lib::MaybeStatic<N>());
+            CATCH_REQUIRE((dist_isa == expected));
+        }
     }
 }
 } // anonymous namespace
@@ -112,6 +126,12 @@ CATCH_TEST_CASE("Testing CosineSimilarity", "[distance][cosinesimilarity_distanc
         CATCH_SECTION("Float16-Float16") {
             test_types<svs::Float16, svs::Float16, N>(-1, 1, ntests);
         }
+        CATCH_SECTION("Float-BFloat16") {
+            test_types<float, svs::BFloat16, N>(-1, 1, ntests);
+        }
+        CATCH_SECTION("BFloat16-BFloat16") {
+            test_types<svs::BFloat16, svs::BFloat16, N>(-1, 1, ntests);
+        }
         CATCH_SECTION("Float-UInt8") { test_types<float, uint8_t, N>(0, 255, ntests); }
         CATCH_SECTION("UInt8-UInt8") { test_types<uint8_t, uint8_t, N>(0, 255, ntests); }
         CATCH_SECTION("Float-Int8") { test_types<float, int8_t, N>(-128, 127, ntests); }
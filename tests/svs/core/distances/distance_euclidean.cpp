@@ -20,7 +20,9 @@
 // svs
 #include "svs/concepts/distance.h"
 #include "svs/core/distance/euclidean.h"
+#include "svs/lib/arch.h"
 #include "svs/lib/array.h"
+#include "svs/lib/bfloat16.h"
 #include "svs/lib/float16.h"
 #include "svs/lib/static.h"
 
@@ -66,6 +68,15 @@ void test_types(T lo, T hi, size_t num_tests) {
         CATCH_REQUIRE((svs::distance::L2::compute<N>(a.data(), b.data()) == expected));
         // Dynamically Sized Computation
         CATCH_REQUIRE((svs::distance::L2::compute(a.data(), b.data(), N) == expected));
+
+        // Every implementation the host can execute.
+        for (auto isa : svs::arch::all_isas) {
+            if (!svs::arch::is_supported(isa)) {
+                continue;
+            }
+            auto f = svs::simd::Dispatcher<svs::distance::L2Kernel, N, Ea, Eb>::resolve(isa);
+            CATCH_REQUIRE((f(a.data(), b.data(), svs::lib::MaybeStatic<N>()) == expected));
+        }
     }
 }
 } // namespace
@@ -88,6 +99,12 @@ CATCH_TEST_CASE("Testing Euclidean Distance", "[distance][euclidean_distance]")
         CATCH_SECTION("Float16-Float16") {
             test_types<svs::Float16, svs::Float16, ndims>(-1, 1, ntests);
         }
+        CATCH_SECTION("Float-BFloat16") {
+            test_types<float, svs::BFloat16, ndims>(-1, 1, ntests);
+        }
+        CATCH_SECTION("BFloat16-BFloat16") {
+            test_types<svs::BFloat16, svs::BFloat16, ndims>(-1, 1, ntests);
+        }
         CATCH_SECTION("Float-UInt8") { test_types<float, uint8_t, ndims>(0, 255, ntests); }
         CATCH_SECTION("UInt8-UInt8") {
             test_types<uint8_t, uint8_t, ndims>(0, 255, ntests);
@@ -106,6 +123,12 @@ CATCH_TEST_CASE("Testing Euclidean Distance", "[distance][euclidean_distance]")
         CATCH_SECTION("Float16-Float16") {
             test_types<svs::Float16, svs::Float16, ndims>(-1, 1, ntests);
         }
+        CATCH_SECTION("Float-BFloat16") {
+            test_types<float, svs::BFloat16, ndims>(-1, 1, ntests);
+        }
+        CATCH_SECTION("BFloat16-BFloat16") {
+            test_types<svs::BFloat16, svs::BFloat16, ndims>(-1, 1, ntests);
+        }
         CATCH_SECTION("Float-UInt8") { test_types<float, uint8_t, ndims>(0, 255, ntests); }
         CATCH_SECTION("UInt8-UInt8") {
             test_types<uint8_t, uint8_t, ndims>(0, 255, ntests);
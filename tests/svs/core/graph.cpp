@@ -11,6 +11,7 @@
 
 // svs
 #include "svs/concepts/graph.h"
+#include "svs/core/graph.h"
 #include "svs/core/graph/graph.h"
 
 // test utils
@@ -22,7 +23,9 @@
 // stdlib
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstdint>
+#include <thread>
 #include <vector>
 
 CATCH_TEST_CASE("Simple Graph", "[graphs][simple]") {
@@ -117,3 +120,100 @@ CATCH_TEST_CASE("Simple Graph", "[graphs][simple]") {
         CATCH_REQUIRE(std::equal(s.begin(), s.end(), replacement.begin()));
     }
 }
+
+CATCH_TEST_CASE("Simple Blocked Graph Snapshots", "[graphs][simple]") {
+    using Idx = uint32_t;
+    const size_t n_nodes = 10;
+    const size_t max_degree = 5;
+
+    auto graph = svs::graphs::SimpleBlockedGraph<Idx>(max_degree, n_nodes);
+    auto buffer = std::vector<Idx>();
+
+    std::vector<Idx> neighbors{1, 2, 3};
+    graph.replace_node(0, neighbors);
+    auto s = graph.snapshot_node(0, buffer);
+    CATCH_REQUIRE(s.size() == neighbors.size());
+    CATCH_REQUIRE(std::equal(s.begin(), s.end(), neighbors.begin()));
+    CATCH_REQUIRE(s.data() == buffer.data());
+
+    graph.add_edge(0, 4);
+    s = graph.snapshot_node(0, buffer);
+    CATCH_REQUIRE(s.size() == 4);
+    CATCH_REQUIRE(s.back() == 4);
+
+    graph.clear_node(0);
+    CATCH_REQUIRE(graph.snapshot_node(0, buffer).empty());
+
+    // Growing the graph extends the sequence locks as well.
+    graph.unsafe_resize(2 * n_nodes);
+    graph.replace_node(2 * n_nodes - 1, neighbors);
+    s = graph.snapshot_node(2 * n_nodes - 1, buffer);
+    CATCH_REQUIRE(std::equal(s.begin(), s.end(), neighbors.begin(), neighbors.end()));
+
+    // Readers running concurrently with a writer always observe complete lists.
+    std::vector<Idx> a{1, 2, 3, 4, 5};
+    std::vector<Idx> b{6, 7};
+    std::atomic<bool> done{false};
+    size_t torn = 0;
+    auto reader = std::thread([&]() {
+        auto local = std::vector<Idx>();
+        while (!done) {
+            auto list = graph.snapshot_node(1, local);
+            bool is_a = std::equal(list.begin(), list.end(), a.begin(), a.end());
+            bool is_b = std::equal(list.begin(), list.end(), b.begin(), b.end());
+            if (!is_a && !is_b && !list.empty()) {
+                ++torn;
+            }
+        }
+    });
+    for (size_t i = 0; i < 100'000; ++i) {
+        graph.replace_node(1, (i % 2 == 0) ? a : b);
+    }
+    done = true;
+    reader.join();
+    CATCH_REQUIRE(torn == 0);
+}
+
+CATCH_TEST_CASE("Memory Mapped Graph", "[graphs][simple]") {
+    using Idx = uint32_t;
+    using Alloc = svs::MMapAllocator<Idx>;
+    const size_t n_nodes = 10;
+    const size_t max_degree = 5;
+
+    auto graph = svs::graphs::SimpleGraph<Idx>(n_nodes, max_degree);
+    for (Idx i = 0; i < n_nodes; ++i) {
+        for (Idx j = 0; j < i % max_degree; ++j) {
+            graph.add_edge(i, (i + j + 1) % n_nodes);
+        }
+    }
+    CATCH_REQUIRE(svs_test::prepare_temp_directory());
+    auto dir = svs_test::temp_directory() / "graph";
+    svs::lib::save_to_disk(graph, dir);
+
+    auto check = [&](const auto& other) {
+        CATCH_REQUIRE(other.n_nodes() == n_nodes);
+        CATCH_REQUIRE(other.max_degree() == max_degree);
+        for (Idx i = 0; i < n_nodes; ++i) {
+            auto expected = graph.get_node(i);
+            auto neighbors = other.get_node(i);
+            CATCH_REQUIRE(std::equal(
+                neighbors.begin(), neighbors.end(), expected.begin(), expected.end()
+            ));
+        }
+    };
+
+    {
+        auto options = svs::MMapOptions().populate(false).willneed(true);
+        auto loader = svs::GraphLoader<Idx, Alloc>(dir, Alloc(options));
+        auto mapped = loader.load();
+        check(mapped);
+        CATCH_REQUIRE(mapped.get_data().get_allocator().options() == options);
+        auto mappings = svs::detail::MMapRegistry::get_mappings();
+        CATCH_REQUIRE(mappings.size() == 1);
+
+        // Mapped graphs remain mutable without changing the saved graph.
+        mapped.clear_node(1);
+        CATCH_REQUIRE(mapped.get_node_degree(1) == 0);
+    }
+    check(svs::GraphLoader<Idx, Alloc>(dir).load());
+}
@@ -12,9 +12,12 @@
 // svs
 #include "svs/concepts/data.h"
 #include "svs/core/allocator.h"
+#include "svs/core/data.h"
 #include "svs/core/graph.h"
 #include "svs/lib/array.h"
+#include "svs/lib/float16.h"
 #include "svs/lib/memory.h"
+#include "svs/lib/threads.h"
 
 // tests
 #include "tests/utils/test_dataset.h"
@@ -26,6 +29,7 @@
 // stl
 #include <algorithm>
 #include <filesystem>
+#include <fstream>
 #include <numeric>
 #include <span>
 
@@ -138,3 +142,90 @@ CATCH_TEST_CASE("Testing Graph Loading and Saving", "[core][integrated_io]") {
         compare(reference_graph, other);
     }
 }
+
+CATCH_TEST_CASE("Testing Parallel Dataset Loading", "[core][integrated_io]") {
+    CATCH_REQUIRE(svs_test::prepare_temp_directory());
+    auto temp_dir = svs_test::temp_directory();
+    auto reference = test_dataset::data_f32();
+    auto threadpool = svs::threads::NativeThreadPool(4);
+
+    // Write the reference dataset in each supported file format.
+    auto native_file = temp_dir / "data.svs";
+    auto vecs_file = temp_dir / "data.fvecs";
+    auto binary_file = temp_dir / "data.fbin";
+    svs::io::save(reference, svs::io::NativeFile(native_file));
+    {
+        auto vecs = svs::io::vecs::VecsWriter<float>(vecs_file, reference.dimensions());
+        auto binary = svs::io::binary::BinaryWriter<float>(
+            binary_file, reference.size(), reference.dimensions()
+        );
+        for (size_t i = 0; i < reference.size(); ++i) {
+            vecs << reference.get_datum(i);
+            binary << reference.get_datum(i);
+        }
+    }
+
+    auto lazy = svs::lib::Lazy([](size_t n_elements, size_t n_dimensions) {
+        return svs::data::SimpleData<float>(n_elements, n_dimensions);
+    });
+
+    CATCH_SECTION("File Formats") {
+        // Use chunks that split vectors across block boundaries.
+        auto options = {
+            svs::io::ParallelLoadOptions(),
+            svs::io::ParallelLoadOptions().chunk_bytes(1000),
+            svs::io::ParallelLoadOptions().chunk_bytes(5000).direct(true)};
+        for (auto opt : options) {
+            for (const auto& path : {native_file, vecs_file, binary_file}) {
+                auto data = svs::io::parallel_auto_load<float>(path, lazy, threadpool, opt);
+                CATCH_REQUIRE(compare(reference, data));
+            }
+        }
+    }
+
+    CATCH_SECTION("Conversion") {
+        auto data = svs::io::parallel_load_dataset(
+            svs::io::vecs::VecsFile(vecs_file),
+            svs::lib::Type<float>(),
+            svs::lib::Lazy([](size_t n_elements, size_t n_dimensions) {
+                return svs::data::SimpleData<svs::Float16>(n_elements, n_dimensions);
+            }),
+            threadpool
+        );
+        CATCH_REQUIRE(data.size() == reference.size());
+        for (size_t i = 0; i < reference.size(); ++i) {
+            auto expected = reference.get_datum(i);
+            auto datum = data.get_datum(i);
+            for (size_t j = 0; j < expected.size(); ++j) {
+                CATCH_REQUIRE(float(datum[j]) == float(svs::Float16(expected[j])));
+            }
+        }
+    }
+
+    CATCH_SECTION("Loaders") {
+        auto dir = temp_dir / "saved";
+        svs::lib::save_to_disk(reference, dir);
+        for (const auto& path : {dir, vecs_file}) {
+            auto data = svs::data::SimpleData<float>::load(path, threadpool);
+            CATCH_REQUIRE(compare(reference, data));
+        }
+        auto loader = svs::VectorDataLoader<float>(native_file);
+        loader.parallel_options(svs::io::ParallelLoadOptions().chunk_bytes(4096));
+        CATCH_REQUIRE(compare(reference, loader.load(threadpool)));
+    }
+
+    CATCH_SECTION("Errors") {
+        // Corrupt the length of a vector in the middle of the vecs file.
+        {
+            auto stream = std::fstream(vecs_file, std::ios_base::in | std::ios_base::out);
+            auto row_bytes = sizeof(uint32_t) + sizeof(float) * reference.dimensions();
+            stream.seekp(static_cast<std::streamoff>(row_bytes * reference.size() / 2));
+            auto length = svs::lib::narrow<uint32_t>(reference.dimensions() + 1);
+            stream.write(reinterpret_cast<const char*>(&length), sizeof(length));
+        }
+        CATCH_REQUIRE_THROWS_AS(
+            svs::io::parallel_auto_load<float>(vecs_file, lazy, threadpool),
+            svs::ANNException
+        );
+    }
+}
@@ -75,6 +75,34 @@ CATCH_TEST_CASE("Testing Vecs Reader Iterator", "[core][io]") {
         CATCH_REQUIRE(svs_test::compare_files(vecs_file, output_file) == true);
     }
 
+    CATCH_SECTION("Writing BFloat16") {
+        auto vecs_file = test_dataset::reference_vecs_file();
+        auto loader = svs::io::vecs::VecsReader<float>(vecs_file);
+        std::string output_file = svs_test::prepare_temp_directory_v2() / "output.bvecs";
+        {
+            auto writer =
+                svs::io::vecs::VecsWriter<svs::BFloat16>(output_file, loader.ndims());
+            for (auto i : loader) {
+                writer << i;
+            }
+        }
+
+        // Values should round-trip through the file after rounding to bfloat16.
+        auto reader = svs::io::vecs::VecsReader<svs::BFloat16>(output_file);
+        CATCH_REQUIRE(reader.ndims() == reference_ndims);
+        CATCH_REQUIRE(reader.nvectors() == reference.size());
+        size_t i = 0;
+        for (const auto& slice : reader) {
+            const auto& this_reference = reference.at(i);
+            CATCH_REQUIRE(slice.size() == this_reference.size());
+            for (size_t j = 0; j < slice.size(); ++j) {
+                CATCH_REQUIRE(slice[j].raw() == svs::BFloat16(this_reference[j]).raw());
+            }
+            ++i;
+        }
+        CATCH_REQUIRE(i == reference.size());
+    }
+
     CATCH_SECTION("VecsFile interface") {
         auto vecs_file = test_dataset::reference_vecs_file();
 
@@ -18,6 +18,10 @@
 // catch2
 #include "catch2/catch_test_macros.hpp"
 
+// stl
+#include <atomic>
+#include <set>
+
 namespace {
 
 // Initialize the base dataset with known contents.
@@ -91,4 +95,33 @@ CATCH_TEST_CASE("KMeans Clustering", "[core][kmeans]") {
         double expected_mse = centroids.dimensions() * ((0.5 * 0.5) + (1.5 * 1.5)) / 2;
         CATCH_REQUIRE(mse == expected_mse);
     }
+
+    CATCH_SECTION("Cluster Representatives") {
+        auto data = gen_data(1000);
+        auto threadpool = svs::threads::NativeThreadPool(2);
+        auto representatives = svs::find_cluster_representatives(data, 10, threadpool);
+        CATCH_REQUIRE(!representatives.empty());
+        CATCH_REQUIRE(representatives.size() <= 10);
+        auto unique = std::set<size_t>(representatives.begin(), representatives.end());
+        CATCH_REQUIRE(unique.size() == representatives.size());
+        for (auto id : representatives) {
+            CATCH_REQUIRE(id < data.size());
+        }
+
+        // Requesting more clusters than elements is clamped to the dataset size.
+        auto small = gen_data(5);
+        representatives = svs::find_cluster_representatives(small, 10, threadpool);
+        CATCH_REQUIRE(!representatives.empty());
+        CATCH_REQUIRE(representatives.size() <= small.size());
+
+        // The optional map is applied before clustering.
+        auto calls = std::atomic<size_t>{0};
+        auto map = [&calls](const auto& datum) {
+            ++calls;
+            return datum;
+        };
+        representatives = svs::find_cluster_representatives(data, 4, threadpool, map);
+        CATCH_REQUIRE(calls.load() > 0);
+        CATCH_REQUIRE(representatives.size() <= 4);
+    }
 }
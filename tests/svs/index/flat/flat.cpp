@@ -0,0 +1,170 @@
+/**
+ *    Copyright (C) 2023, Intel Corporation
+ *
+ *    You can redistribute and/or modify this software under the terms of the
+ *    GNU Affero General Public License version 3.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    version 3 along with this software. If not, see
+ *    <https://www.gnu.org/licenses/agpl-3.0.en.html>.
+ */
+
+// header under test
+#include "svs/index/flat/flat.h"
+
+// svs
+#include "svs/core/bitset.h"
+#include "svs/core/data/simple.h"
+#include "svs/core/distance.h"
+
+// catch2
+#include "catch2/catch_test_macros.hpp"
+
+// tests
+#include "tests/utils/generators.h"
+
+// stl
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace {
+
+template <typename T> svs::data::SimpleData<T> make_data(size_t size, size_t dims) {
+    // Integer values keep the distances computed by all kernels exact.
+    auto generator = svs_test::make_generator<int8_t>(-64, 64);
+    auto data = svs::data::SimpleData<T>(size, dims);
+    for (size_t i = 0; i < size; ++i) {
+        for (auto& x : data.get_datum(i)) {
+            x = static_cast<T>(svs_test::generate(generator));
+        }
+    }
+    return data;
+}
+
+// Check that row `i` of `result` holds the nearest elements of `data` allowed by `allowed`.
+template <typename Data, typename Queries>
+void check_filtered(
+    const svs::QueryResult<size_t>& result,
+    size_t i,
+    const Data& data,
+    const Queries& queries,
+    const svs::BitSet& allowed
+) {
+    auto distance = svs::distance::DistanceL2();
+    auto expected = std::vector<float>();
+    for (size_t j = 0; j < data.size(); ++j) {
+        if (allowed.test(j)) {
+            expected.push_back(
+                svs::distance::compute(distance, queries.get_datum(i), data.get_datum(j))
+            );
+        }
+    }
+    std::sort(expected.begin(), expected.end());
+
+    for (size_t j = 0; j < result.n_neighbors(); ++j) {
+        auto id = result.index(i, j);
+        if (j < expected.size()) {
+            CATCH_REQUIRE(allowed.test(id));
+            CATCH_REQUIRE(result.distance(i, j) == expected[j]);
+        } else {
+            // Not enough allowed elements.
+            CATCH_REQUIRE(id == std::numeric_limits<size_t>::max());
+            CATCH_REQUIRE(result.distance(i, j) == std::numeric_limits<float>::max());
+        }
+    }
+}
+
+template <typename T> struct FilteredSearchTest {
+    static constexpr size_t num_neighbors = 10;
+
+    FilteredSearchTest()
+        : data_{make_data<T>(1000, 16)}
+        , queries_{make_data<T>(20, 16)}
+        , index_{copy(data_), svs::distance::DistanceL2(), 2} {
+        // Use small batches so filters apply across batch boundaries.
+        index_.set_search_parameters(svs::index::flat::FlatParameters(300, 3));
+    }
+
+    static svs::data::SimpleData<T> copy(const svs::data::SimpleData<T>& data) {
+        auto result = svs::data::SimpleData<T>(data.size(), data.dimensions());
+        svs::data::copy(data, result);
+        return result;
+    }
+
+    void shared() {
+        // Allow a sparse, irregular subset including whole empty words.
+        auto allowed = svs::BitSet(data_.size());
+        for (size_t i = 0; i < data_.size(); i += 3) {
+            if (i < 200 || i > 400) {
+                allowed.set(i);
+            }
+        }
+        auto filter = svs::SearchFilter(allowed);
+        auto result =
+            svs::index::search_batch(index_, queries_.cview(), num_neighbors, filter);
+        for (size_t i = 0; i < queries_.size(); ++i) {
+            check_filtered(result, i, data_, queries_, allowed);
+        }
+
+        // An empty filter is identical to unfiltered search.
+        auto unfiltered =
+            svs::index::search_batch(index_, queries_.cview(), num_neighbors);
+        result = svs::index::search_batch(
+            index_, queries_.cview(), num_neighbors, svs::SearchFilter()
+        );
+        for (size_t i = 0; i < queries_.size(); ++i) {
+            for (size_t j = 0; j < num_neighbors; ++j) {
+                CATCH_REQUIRE(result.index(i, j) == unfiltered.index(i, j));
+            }
+        }
+    }
+
+    void per_query() {
+        auto bitsets = std::vector<svs::BitSet>();
+        for (size_t i = 0; i < queries_.size(); ++i) {
+            auto& allowed = bitsets.emplace_back(data_.size());
+            // Query `i` may only return elements congruent to `i` modulo 17.
+            // The final query has fewer allowed elements than requested neighbors.
+            size_t step = i + 1 == queries_.size() ? 200 : 17;
+            for (size_t j = i % 17; j < data_.size(); j += step) {
+                allowed.set(j);
+            }
+        }
+        auto filter = svs::SearchFilter(bitsets);
+        auto result =
+            svs::index::search_batch(index_, queries_.cview(), num_neighbors, filter);
+        for (size_t i = 0; i < queries_.size(); ++i) {
+            check_filtered(result, i, data_, queries_, bitsets[i]);
+        }
+
+        // The number of per-query filters must match the number of queries.
+        bitsets.pop_back();
+        CATCH_REQUIRE_THROWS_AS(
+            svs::index::search_batch(
+                index_, queries_.cview(), num_neighbors, svs::SearchFilter(bitsets)
+            ),
+            svs::ANNException
+        );
+    }
+
+    svs::data::SimpleData<T> data_;
+    svs::data::SimpleData<T> queries_;
+    svs::index::flat::FlatIndex<svs::data::SimpleData<T>, svs::distance::DistanceL2> index_;
+};
+
+} // namespace
+
+CATCH_TEST_CASE("Flat Index Filtered Search", "[index][flat]") {
+    // Floating point data uses the tiled kernels where available.
+    CATCH_SECTION("Shared") {
+        FilteredSearchTest<float>().shared();
+        FilteredSearchTest<int8_t>().shared();
+    }
+
+    CATCH_SECTION("Per Query") {
+        FilteredSearchTest<float>().per_query();
+        FilteredSearchTest<int8_t>().per_query();
+    }
+}
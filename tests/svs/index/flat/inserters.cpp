@@ -12,9 +12,11 @@
 // stdlib
 #include <functional>
 #include <type_traits>
+#include <vector>
 
 // svs
 #include "svs/index/flat/inserters.h"
+#include "svs/lib/neighbor.h"
 
 // catch2
 #include "catch2/catch_test_macros.hpp"
@@ -187,4 +189,45 @@ CATCH_TEST_CASE("Sorters", "[core][sorters]") {
         CATCH_REQUIRE(inserter.num_neighbors() == 70);
         test_bulk_inserter(inserter);
     }
+
+    CATCH_SECTION("Range Inserter") {
+        using N = svs::Neighbor<size_t>;
+        auto check = [](const auto& inserter, size_t i, const std::vector<size_t>& ids) {
+            auto result = inserter.result(i);
+            CATCH_REQUIRE(result.size() == ids.size());
+            for (size_t j = 0; j < ids.size(); ++j) {
+                CATCH_REQUIRE(result[j].id() == ids[j]);
+            }
+        };
+
+        // The radius is inclusive and results are sorted.
+        auto inserter = svs::index::flat::RangeInserter<N, std::less<>>{2, 10, std::less{}};
+        CATCH_REQUIRE(inserter.batch_size() == 2);
+        CATCH_REQUIRE(inserter.radius() == 10);
+        inserter.prepare();
+        inserter.insert(0, N{0, 5});
+        inserter.insert(0, N{1, 10});
+        inserter.insert(0, N{2, 11});
+        inserter.insert(0, N{3, 1});
+        inserter.insert(1, N{4, 20});
+        inserter.cleanup();
+        check(inserter, 0, {3, 0, 1});
+        check(inserter, 1, {});
+
+        // Preparing clears previous results.
+        inserter.prepare();
+        inserter.insert(1, N{5, 0});
+        inserter.cleanup();
+        check(inserter, 0, {});
+        check(inserter, 1, {5});
+
+        // Similarity measures retain elements at least as large as the radius.
+        auto ip = svs::index::flat::RangeInserter<N, std::greater<>>{1, 10, std::greater{}};
+        ip.prepare();
+        ip.insert(0, N{0, 5});
+        ip.insert(0, N{1, 10});
+        ip.insert(0, N{2, 11});
+        ip.cleanup();
+        check(ip, 0, {2, 1});
+    }
 }
@@ -0,0 +1,103 @@
+/**
+ *    Copyright (C) 2023, Intel Corporation
+ *
+ *    You can redistribute and/or modify this software under the terms of the
+ *    GNU Affero General Public License version 3.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    version 3 along with this software. If not, see
+ *    <https://www.gnu.org/licenses/agpl-3.0.en.html>.
+ */
+
+// stdlib
+#include <cstdint>
+#include <vector>
+
+// svs
+#include "svs/core/data/simple.h"
+#include "svs/core/distance.h"
+#include "svs/index/flat/tiled.h"
+#include "svs/lib/float16.h"
+
+// catch2
+#include "catch2/catch_approx.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+// tests
+#include "tests/utils/generators.h"
+
+namespace {
+
+namespace tiled = svs::index::flat::tiled;
+
+template <typename Dist> void test_tile(Dist distance, size_t m, size_t n, size_t dims) {
+    auto generator = svs_test::make_generator<float>(-1, 1);
+    auto queries = svs::data::SimpleData<float>(m, dims);
+    auto data = svs::data::SimpleData<float>(n, dims);
+    for (auto* dataset : {&queries, &data}) {
+        for (size_t i = 0; i < dataset->size(); ++i) {
+            for (auto& x : dataset->get_datum(i)) {
+                x = svs_test::generate(generator);
+            }
+        }
+    }
+
+    // Pack every other element to exercise non-contiguous selections.
+    std::vector<size_t> ids{};
+    for (size_t i = 0; i < n; i += 2) {
+        ids.push_back(i);
+    }
+
+    auto scratch = tiled::TileScratch(dims);
+    scratch.pack_data(data, ids);
+    tiled::compute_tile(distance, queries.data(), m, ids.size(), scratch);
+
+    const float* result = scratch.distances();
+    for (size_t i = 0; i < m; ++i) {
+        for (size_t j = 0; j < ids.size(); ++j) {
+            auto expected =
+                svs::distance::compute(distance, queries.get_datum(i), data.get_datum(ids[j]));
+            CATCH_REQUIRE(
+                result[i * ids.size() + j] == Catch::Approx(expected).epsilon(1e-4).margin(1e-4)
+            );
+        }
+    }
+}
+
+} // namespace
+
+CATCH_TEST_CASE("Tiled Flat Kernels", "[index][flat]") {
+    CATCH_SECTION("Applicability") {
+        using DistanceL2 = svs::distance::DistanceL2;
+        using DistanceIP = svs::distance::DistanceIP;
+        using DistanceCosine = svs::distance::DistanceCosineSimilarity;
+        using FloatSpan = std::span<const float>;
+
+        CATCH_STATIC_REQUIRE(tiled::is_applicable_v<FloatSpan, float, DistanceL2>);
+        CATCH_STATIC_REQUIRE(tiled::is_applicable_v<FloatSpan, float, DistanceIP>);
+        CATCH_STATIC_REQUIRE(
+            tiled::is_applicable_v<std::span<const float, 128>, float, DistanceL2>
+        );
+        CATCH_STATIC_REQUIRE(!tiled::is_applicable_v<FloatSpan, float, DistanceCosine>);
+        CATCH_STATIC_REQUIRE(
+            !tiled::is_applicable_v<std::span<const svs::Float16>, float, DistanceL2>
+        );
+        CATCH_STATIC_REQUIRE(!tiled::is_applicable_v<FloatSpan, uint8_t, DistanceL2>);
+    }
+
+    CATCH_SECTION("Distances") {
+        if (!tiled::available()) {
+            return;
+        }
+
+        // Cover full and partial register blocks and vector widths.
+        for (size_t dims : {1, 15, 16, 100, 128}) {
+            for (size_t m : {size_t{1}, size_t{3}, size_t{4}, tiled::query_tile_size}) {
+                for (size_t n : {size_t{1}, size_t{9}, 2 * tiled::data_tile_size}) {
+                    test_tile(svs::distance::DistanceL2(), m, n, dims);
+                    test_tile(svs::distance::DistanceIP(), m, n, dims);
+                }
+            }
+        }
+    }
+}
@@ -19,6 +19,9 @@
 // catch2
 #include "catch2/catch_test_macros.hpp"
 
+// stl
+#include <vector>
+
 namespace {
 
 // A minimal, light-weight index for testing the query-processing pipeline.
@@ -55,8 +58,45 @@ struct TestIndex {
             }
         }
     }
+
+    // Return `p.value_` results for each query. Result IDs are the query index and
+    // distances are the radius.
+    svs::RangeSearchResult<size_t> range_search(
+        svs::data::ConstSimpleDataView<float> queries, float radius, SearchParameters p
+    ) const {
+        CATCH_REQUIRE(queries.size() == expected_num_queries_);
+        auto counts =
+            std::vector<size_t>(queries.size(), svs::lib::narrow_cast<size_t>(p.value_));
+        auto result = svs::RangeSearchResult<size_t>(counts);
+        for (size_t i = 0, imax = queries.size(); i < imax; ++i) {
+            for (size_t j = 0, jmax = counts[i]; j < jmax; ++j) {
+                result.set(svs::Neighbor<size_t>{i, radius}, i, j);
+            }
+        }
+        return result;
+    }
 };
 
+bool check_range_result(
+    const svs::RangeSearchResult<size_t>& result, size_t num_results, float radius
+) {
+    if (result.total_results() != result.n_queries() * num_results) {
+        return false;
+    }
+    for (size_t i = 0, imax = result.n_queries(); i < imax; ++i) {
+        if (result.num_results(i) != num_results ||
+            result.offsets().at(i) != i * num_results) {
+            return false;
+        }
+        for (size_t j = 0; j < num_results; ++j) {
+            if (result.indices(i)[j] != i || result.distances(i)[j] != radius) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
 bool check_all_are(svs::QueryResultView<size_t> result, size_t value) {
     auto value_float = svs::lib::narrow<float>(value);
     for (size_t i = 0, imax = result.n_queries(); i < imax; ++i) {
@@ -172,4 +212,35 @@ CATCH_TEST_CASE("Query Processing", "[index][general]") {
         CATCH_REQUIRE(check_all_are(results.view(), 234));
         CATCH_REQUIRE(!check_all_are(results.view(), 123));
     }
+
+    CATCH_SECTION("range_search_with") {
+        index.expected_num_queries_ = queries.size();
+        index.default_parameters_ = {10};
+
+        auto result = svs::index::range_search_with(
+            index, queries.cview(), 2.0f, TestIndex::SearchParameters{3}
+        );
+        CATCH_REQUIRE(result.n_queries() == queries.size());
+        CATCH_REQUIRE(check_range_result(result, 3, 2.0f));
+
+        // Queries without any results.
+        result = svs::index::range_search_with(
+            index, queries.cview(), 2.0f, TestIndex::SearchParameters{0}
+        );
+        CATCH_REQUIRE(result.n_queries() == queries.size());
+        CATCH_REQUIRE(check_range_result(result, 0, 2.0f));
+    }
+
+    CATCH_SECTION("range_search") {
+        index.expected_num_queries_ = queries.size();
+        index.default_parameters_ = {4};
+
+        // Ensure default values are used.
+        auto result = svs::index::range_search(index, queries.cview(), 1.5f);
+        CATCH_REQUIRE(check_range_result(result, 4, 1.5f));
+
+        index.default_parameters_ = {1};
+        result = svs::index::range_search(index, queries.cview(), 1.5f);
+        CATCH_REQUIRE(check_range_result(result, 1, 1.5f));
+    }
 }
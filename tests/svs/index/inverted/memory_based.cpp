@@ -0,0 +1,134 @@
+/**
+ *    Copyright (C) 2023, Intel Corporation
+ *
+ *    You can redistribute and/or modify this software under the terms of the
+ *    GNU Affero General Public License version 3.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    version 3 along with this software. If not, see
+ *    <https://www.gnu.org/licenses/agpl-3.0.en.html>.
+ */
+
+// header under test
+#include "svs/index/inverted/memory_based.h"
+
+// tests
+#include "tests/utils/utils.h"
+
+// catch
+#include "catch2/catch_test_macros.hpp"
+
+// stl
+#include <utility>
+#include <vector>
+
+namespace {
+
+namespace inverted = svs::index::inverted;
+
+svs::data::SimpleData<float> make_data(size_t num_points, size_t dims) {
+    auto data = svs::data::SimpleData<float>(num_points, dims);
+    auto buffer = std::vector<float>(dims);
+    for (size_t i = 0; i < num_points; ++i) {
+        for (size_t j = 0; j < dims; ++j) {
+            buffer[j] = static_cast<float>(dims * i + j);
+        }
+        data.set_datum(i, buffer);
+    }
+    return data;
+}
+
+// Two clusters with centroids 0 and 5.
+// Leaves 3 and 4 are shared by both clusters.
+inverted::Clustering<uint32_t> make_clustering() {
+    auto centroids = std::vector<uint32_t>({0, 5});
+    auto clustering = inverted::Clustering<uint32_t>(centroids.begin(), centroids.end());
+    for (uint32_t i : {1, 2, 3, 4}) {
+        clustering.insert(0, {i, static_cast<float>(i)});
+    }
+    for (uint32_t i : {3, 4, 6, 7, 8, 9}) {
+        clustering.insert(5, {i, static_cast<float>(i)});
+    }
+    return clustering;
+}
+
+// Flatten the leaves of each cluster into (global id, datum) pairs.
+template <typename Clustered>
+std::vector<std::vector<std::pair<uint32_t, std::vector<float>>>>
+collect(const Clustered& clustered, size_t num_clusters) {
+    auto result = std::vector<std::vector<std::pair<uint32_t, std::vector<float>>>>();
+    for (size_t c = 0; c < num_clusters; ++c) {
+        auto& leaves = result.emplace_back();
+        clustered.on_leaves(
+            [&](const auto& datum, uint32_t id) {
+                leaves.emplace_back(id, std::vector<float>(datum.begin(), datum.end()));
+            },
+            c
+        );
+    }
+    return result;
+}
+
+} // namespace
+
+CATCH_TEST_CASE("Inverted Clustered Datasets", "[inverted][clustered_dataset]") {
+    auto data = make_data(10, 4);
+    auto clustering = make_clustering();
+    auto allocator = svs::HugepageAllocator<std::byte>();
+
+    CATCH_SECTION("Sparse") {
+        using Leaves =
+            svs::data::SimpleData<float, svs::Dynamic, svs::HugepageAllocator<float>>;
+        using Sparse = inverted::SparseClusteredDataset<Leaves, uint32_t>;
+        auto sparse = Sparse(data, clustering, allocator);
+        CATCH_REQUIRE(sparse.num_leaves() == 8);
+        sparse.set_prefetch_offset(5);
+        auto expected = collect(sparse, 2);
+        CATCH_REQUIRE(expected.at(0).size() == 4);
+        CATCH_REQUIRE(expected.at(1).size() == 6);
+
+        CATCH_REQUIRE(svs_test::prepare_temp_directory());
+        auto dir = svs_test::temp_directory();
+        svs::lib::save_to_disk(sparse, dir);
+        auto reloaded = svs::lib::load_from_disk<Sparse>(dir);
+        CATCH_REQUIRE(reloaded.num_leaves() == 8);
+        CATCH_REQUIRE(reloaded.get_prefetch_offset() == 5);
+        CATCH_REQUIRE(collect(reloaded, 2) == expected);
+
+        // Reloading with the wrong integer type should fail.
+        using Wrong = inverted::SparseClusteredDataset<Leaves, int64_t>;
+        CATCH_REQUIRE_THROWS_AS(svs::lib::load_from_disk<Wrong>(dir), svs::ANNException);
+    }
+
+    CATCH_SECTION("Dense") {
+        using Dense =
+            inverted::DenseClusteredDataset<svs::data::SimpleData<float>, uint32_t>;
+        auto dense = Dense(data, clustering, allocator);
+        CATCH_REQUIRE(dense.num_clusters() == 2);
+        CATCH_REQUIRE(dense.num_leaves() == 8);
+        CATCH_REQUIRE(dense.dimensions() == 4);
+        auto expected = collect(dense, 2);
+        CATCH_REQUIRE(expected.at(0).size() == 4);
+        CATCH_REQUIRE(expected.at(1).size() == 6);
+
+        CATCH_REQUIRE(svs_test::prepare_temp_directory());
+        auto dir = svs_test::temp_directory();
+        svs::lib::save_to_disk(dense, dir);
+
+        // Reloading memory maps the saved leaves.
+        using Mapped = inverted::MappedDenseClusteredDataset<float>;
+        auto reloaded = svs::lib::load_from_disk<Mapped>(dir);
+        CATCH_REQUIRE(reloaded.num_clusters() == 2);
+        CATCH_REQUIRE(reloaded.num_leaves() == 8);
+        CATCH_REQUIRE(reloaded.dimensions() == 4);
+        CATCH_REQUIRE(collect(reloaded, 2) == expected);
+
+        // The reloaded dataset should remain valid after being moved.
+        auto moved = std::move(reloaded);
+        CATCH_REQUIRE(collect(moved, 2) == expected);
+
+        // Mismatched element types should fail.
+        using Wrong = inverted::MappedDenseClusteredDataset<uint8_t>;
+        CATCH_REQUIRE_THROWS_AS(svs::lib::load_from_disk<Wrong>(dir), svs::ANNException);
+    }
+}
@@ -33,6 +33,18 @@ name = 'vamana build parameters'
 use_full_search_history = true
 window_size = 200
 )";
+
+std::string_view v0_0_1 = R"(
+__version__ = 'v0.0.1'
+__schema__ = 'vamana_build_parameters'
+alpha = 1.2
+graph_max_degree = 128
+max_candidate_pool_size = 750
+name = 'vamana build parameters'
+prune_to = 120
+use_full_search_history = false
+window_size = 200
+)";
 } // namespace
 
 CATCH_TEST_CASE("VamanaBuildParameters", "[index][vamana]") {
@@ -44,12 +56,17 @@ CATCH_TEST_CASE("VamanaBuildParameters", "[index][vamana]") {
         CATCH_REQUIRE(p.max_candidate_pool_size == 750);
         CATCH_REQUIRE(p.prune_to == 60);
         CATCH_REQUIRE(p.use_full_search_history == true);
+        CATCH_REQUIRE(p.num_entry_points == 1);
 
         // Check for equality.
         auto u = svs::index::vamana::VamanaBuildParameters{1.2, 64, 128, 750, 60, false};
         CATCH_REQUIRE(p != u);
         u.use_full_search_history = true;
         CATCH_REQUIRE(p == u);
+        u.num_entry_points = 16;
+        CATCH_REQUIRE(p != u);
+        CATCH_REQUIRE(p.use_exact_visited_set == false);
+        CATCH_REQUIRE(p.use_vectorized_search_buffer == false);
     }
 
     // Serialization.
@@ -59,6 +76,15 @@ CATCH_TEST_CASE("VamanaBuildParameters", "[index][vamana]") {
 
         auto p = svs::index::vamana::VamanaBuildParameters{1.2, 64, 128, 750, 60, false};
         CATCH_REQUIRE(svs::lib::test_self_save_load(p, temp_directory));
+
+        p.num_entry_points = 32;
+        CATCH_REQUIRE(svs::lib::test_self_save_load(p, temp_directory));
+
+        p.use_exact_visited_set = true;
+        CATCH_REQUIRE(svs::lib::test_self_save_load(p, temp_directory));
+
+        p.use_vectorized_search_buffer = true;
+        CATCH_REQUIRE(svs::lib::test_self_save_load(p, temp_directory));
     }
 
     CATCH_SECTION("Loading Legacy Objects") {
@@ -74,6 +100,26 @@ CATCH_TEST_CASE("VamanaBuildParameters", "[index][vamana]") {
             CATCH_REQUIRE(p.window_size == 200);
             // Default parameters
             CATCH_REQUIRE(p.prune_to == 128);
+            CATCH_REQUIRE(p.num_entry_points == 1);
+            CATCH_REQUIRE(p.use_exact_visited_set == false);
+            CATCH_REQUIRE(p.use_vectorized_search_buffer == false);
+        }
+
+        CATCH_SECTION("v0.0.1") {
+            auto table = toml::parse(v0_0_1);
+            auto p = svs::lib::load<svs::index::vamana::VamanaBuildParameters>(
+                svs::lib::node_view(table)
+            );
+            CATCH_REQUIRE(p.alpha == 1.2f);
+            CATCH_REQUIRE(p.graph_max_degree == 128);
+            CATCH_REQUIRE(p.max_candidate_pool_size == 750);
+            CATCH_REQUIRE(p.prune_to == 120);
+            CATCH_REQUIRE(p.use_full_search_history == false);
+            CATCH_REQUIRE(p.window_size == 200);
+            // Default parameters
+            CATCH_REQUIRE(p.num_entry_points == 1);
+            CATCH_REQUIRE(p.use_exact_visited_set == false);
+            CATCH_REQUIRE(p.use_vectorized_search_buffer == false);
         }
     }
 }
@@ -0,0 +1,179 @@
+/**
+ *    Copyright (C) 2023, Intel Corporation
+ *
+ *    You can redistribute and/or modify this software under the terms of the
+ *    GNU Affero General Public License version 3.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    version 3 along with this software. If not, see
+ *    <https://www.gnu.org/licenses/agpl-3.0.en.html>.
+ */
+
+// header under test
+#include "svs/index/vamana/disk_index.h"
+
+// svs
+#include "svs/core/data/simple.h"
+#include "svs/core/distance.h"
+#include "svs/core/graph.h"
+#include "svs/core/recall.h"
+#include "svs/index/vamana/index.h"
+
+// tests
+#include "tests/utils/synthetic.h"
+#include "tests/utils/utils.h"
+
+// catch2
+#include "catch2/catch_approx.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+// stl
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+CATCH_TEST_CASE("Disk Layout", "[index][vamana][disk_index]") {
+    using Layout = svs::index::vamana::DiskLayout<uint32_t>;
+
+    // Several records per sector.
+    auto layout = Layout(16, 24);
+    CATCH_REQUIRE(layout.record_bytes() == 25 * 4 + 16 * 4);
+    CATCH_REQUIRE(layout.block_bytes() == 4096);
+    CATCH_REQUIRE(layout.records_per_block() == 4096 / 164);
+    CATCH_REQUIRE(layout.num_blocks(100) == 5);
+    CATCH_REQUIRE(layout.block_offset(23) == 0);
+    CATCH_REQUIRE(layout.block_offset(24) == 4096);
+    CATCH_REQUIRE(layout.record_offset(25) == 164);
+
+    // Records spanning several sectors.
+    layout = Layout(100, 8, 128);
+    CATCH_REQUIRE(layout.record_bytes() == 9 * 4 + 100 * 4);
+    CATCH_REQUIRE(layout.block_bytes() == 512);
+    CATCH_REQUIRE(layout.records_per_block() == 1);
+    CATCH_REQUIRE(layout.block_offset(3) == 3 * 512);
+    CATCH_REQUIRE(layout.record_offset(3) == 0);
+
+    // Records round trip.
+    auto record = std::vector<std::byte>(layout.record_bytes());
+    auto neighbors = std::vector<uint32_t>{5, 1, 7};
+    auto datum = std::vector<float>(100);
+    for (size_t i = 0; i < datum.size(); ++i) {
+        datum[i] = static_cast<float>(i) / 2;
+    }
+    layout.write_record(record.data(), std::span<const uint32_t>(neighbors), datum);
+    auto n = layout.neighbors(record.data());
+    CATCH_REQUIRE(std::equal(n.begin(), n.end(), neighbors.begin(), neighbors.end()));
+    auto v = layout.vector(record.data());
+    CATCH_REQUIRE(std::equal(v.begin(), v.end(), datum.begin(), datum.end()));
+
+    CATCH_REQUIRE_THROWS_AS(Layout(16, 24, 1000), svs::ANNException);
+}
+
+CATCH_TEST_CASE("Disk Index", "[index][vamana][disk_index]") {
+    namespace v = svs::index::vamana;
+    const size_t dims = 16;
+    const size_t num_neighbors = 10;
+    auto rng = std::mt19937(0xc0ffee);
+    auto data = synthetic::make_data(2000, dims, rng);
+    auto queries = synthetic::make_data(100, dims, rng);
+
+    auto groundtruth = synthetic::groundtruth(data, queries, num_neighbors);
+    auto index = synthetic::build_vamana(data);
+
+    svs_test::prepare_temp_directory();
+    auto dir = svs_test::temp_directory() / "disk";
+    auto parameters = v::DiskSearchParameters().buffer_config(40);
+
+    // Results carry the exact distances to the returned vectors.
+    auto check = [&](v::DiskVamanaIndex<svs::distance::DistanceL2>& disk) {
+        CATCH_REQUIRE(disk.size() == data.size());
+        CATCH_REQUIRE(disk.dimensions() == dims);
+        CATCH_REQUIRE(disk.resident_bytes() == data.size() * dims / 2);
+        CATCH_REQUIRE(disk.disk_bytes() > data.size() * dims * sizeof(float));
+
+        auto results = svs::QueryResult<size_t>(queries.size(), num_neighbors);
+        disk.search(results.view(), queries.cview(), parameters);
+        CATCH_REQUIRE(svs::k_recall_at_n(groundtruth, results) > 0.9);
+        auto distance = svs::distance::DistanceL2();
+        for (size_t i = 0; i < queries.size(); ++i) {
+            for (size_t j = 0; j < num_neighbors; ++j) {
+                auto id = results.index(i, j);
+                CATCH_REQUIRE(
+                    results.distance(i, j) ==
+                    Catch::Approx(svs::distance::compute(
+                        distance, queries.get_datum(i), data.get_datum(id)
+                    ))
+                );
+            }
+        }
+        return results;
+    };
+
+    CATCH_SECTION("Search") {
+        index.save_disk_index(dir);
+        auto disk = v::DiskVamanaIndex<svs::distance::DistanceL2>(
+            dir, svs::distance::DistanceL2(), 2
+        );
+        CATCH_REQUIRE(disk.max_degree() == 24);
+        CATCH_REQUIRE(disk.entry_points() == index.entry_points());
+        auto results = check(disk);
+
+        // Other thread counts return the same results.
+        auto other_results = svs::QueryResult<size_t>(queries.size(), num_neighbors);
+        disk.set_num_threads(3);
+        CATCH_REQUIRE(disk.get_num_threads() == 3);
+        disk.search(other_results.view(), queries.cview(), parameters);
+        for (size_t i = 0; i < queries.size(); ++i) {
+            for (size_t j = 0; j < num_neighbors; ++j) {
+                CATCH_REQUIRE(other_results.index(i, j) == results.index(i, j));
+            }
+        }
+
+        // Search windows smaller than the number of neighbors are extended.
+        auto narrow = v::DiskSearchParameters().buffer_config(2).beam_width(1);
+        disk.search(other_results.view(), queries.cview(), narrow);
+        CATCH_REQUIRE(svs::k_recall_at_n(groundtruth, other_results) > 0.5);
+
+        // The per-thread readers grow again for wider beams.
+        disk.search(other_results.view(), queries.cview(), parameters);
+        for (size_t i = 0; i < queries.size(); ++i) {
+            CATCH_REQUIRE(other_results.index(i, 0) == results.index(i, 0));
+        }
+
+        CATCH_REQUIRE_THROWS_AS(
+            disk.search(other_results.view(), queries.cview(), narrow.beam_width(0)),
+            svs::ANNException
+        );
+
+        // Loading with a different index type fails.
+        CATCH_REQUIRE_THROWS_AS(
+            (v::DiskVamanaIndex<svs::distance::DistanceL2, uint64_t>(
+                dir, svs::distance::DistanceL2(), 1
+            )),
+            svs::ANNException
+        );
+    }
+
+    CATCH_SECTION("Small Sectors") {
+        // Each record spans several sectors.
+        index.save_disk_index(dir, 64);
+        auto disk = v::DiskVamanaIndex<svs::distance::DistanceL2>(
+            dir, svs::distance::DistanceL2(), 2, false
+        );
+        CATCH_REQUIRE(!disk.direct_io());
+        CATCH_REQUIRE(disk.layout().records_per_block() == 1);
+        CATCH_REQUIRE(disk.layout().block_bytes() == 192);
+        check(disk);
+    }
+
+    CATCH_SECTION("Reordered") {
+        // Disk search returns the external IDs of reordered indexes.
+        index.reorder(v::GraphOrdering::BreadthFirst);
+        index.save_disk_index(dir);
+        auto disk = v::DiskVamanaIndex<svs::distance::DistanceL2>(
+            dir, svs::distance::DistanceL2(), 2
+        );
+        check(disk);
+    }
+}
@@ -10,6 +10,7 @@
  */
 
 // svs
+#include "svs/core/bitset.h"
 #include "svs/core/medioid.h"
 #include "svs/core/recall.h"
 #include "svs/index/flat/flat.h"
@@ -19,6 +20,7 @@
 #include "svs/misc/dynamic_helper.h"
 
 // tests
+#include "tests/utils/generators.h"
 #include "tests/utils/test_dataset.h"
 
 // catch
@@ -26,9 +28,12 @@
 
 // stl
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <numeric>
 #include <random>
 #include <sstream>
+#include <thread>
 
 using Idx = uint32_t;
 using Eltype = float;
@@ -351,3 +356,280 @@ CATCH_TEST_CASE("Testing Graph Index", "[graph_index][dynamic_index]") {
     // ID's preserved across runs.
     index.on_ids([&](size_t e) { CATCH_REQUIRE(reloaded.has_id(e)); });
 }
+
+CATCH_TEST_CASE("Concurrent Search and Mutation", "[graph_index][dynamic_index]") {
+    const size_t dims = 16;
+    const size_t num_points = 4000;
+    const size_t num_queries = 100;
+    const size_t max_degree = 32;
+    const size_t num_threads = 2;
+    const size_t batch_size = num_points / 4;
+
+    auto generator = svs_test::make_generator<float>(-1, 1, 0x12345678);
+    auto random_data = [&](size_t n) {
+        auto data = svs::data::SimpleData<float>(n, dims);
+        for (size_t i = 0; i < n; ++i) {
+            for (auto& x : data.get_datum(i)) {
+                x = svs_test::generate(generator);
+            }
+        }
+        return data;
+    };
+    auto id_range = [](size_t start, size_t stop) {
+        auto ids = std::vector<size_t>(stop - start);
+        std::iota(ids.begin(), ids.end(), start);
+        return ids;
+    };
+
+    auto initial = random_data(num_points);
+    auto data = svs::data::BlockedData<float>(num_points, dims);
+    for (size_t i = 0; i < num_points; ++i) {
+        data.set_datum(i, initial.get_datum(i));
+    }
+    auto queries = random_data(num_queries);
+
+    svs::index::vamana::VamanaBuildParameters parameters{
+        1.2, max_degree, 2 * max_degree, 1000, max_degree - 4, true};
+    auto index = svs::index::vamana::MutableVamanaIndex(
+        parameters, std::move(data), id_range(0, num_points), Distance(), num_threads
+    );
+    index.set_search_parameters(
+        svs::index::vamana::VamanaSearchParameters().buffer_config(50)
+    );
+
+    // External IDs below `deleted_below` have been deleted.
+    // External IDs at or above `max_id` have not yet been assigned.
+    std::atomic<size_t> deleted_below{0};
+    const size_t max_id = num_points + 2 * batch_size;
+    std::atomic<bool> done{false};
+
+    size_t num_searches = 0;
+    size_t num_errors = 0;
+    auto searcher = std::thread([&]() {
+        while (!done) {
+            size_t lower = deleted_below;
+            auto results = svs::index::search_batch(index, queries, NUM_NEIGHBORS);
+            for (size_t i = 0; i < results.n_queries(); ++i) {
+                for (size_t j = 0; j < results.n_neighbors(); ++j) {
+                    auto id = results.index(i, j);
+                    if (id < lower || id >= max_id) {
+                        ++num_errors;
+                    }
+                }
+            }
+            ++num_searches;
+        }
+    });
+
+    for (size_t round = 0; round < 2; ++round) {
+        // Delete a batch and reuse the freed slots for new points.
+        auto to_delete = id_range(round * batch_size, (round + 1) * batch_size);
+        index.delete_entries(to_delete);
+        deleted_below = (round + 1) * batch_size;
+        index.consolidate();
+
+        auto start = num_points + round * batch_size;
+        auto slots =
+            index.add_points(random_data(batch_size), id_range(start, start + batch_size));
+        CATCH_REQUIRE(slots.size() == batch_size);
+        // Slots freed by consolidation are reused before growing the index.
+        CATCH_REQUIRE(std::all_of(slots.begin(), slots.end(), [&](size_t slot) {
+            return slot < num_points;
+        }));
+        index.debug_check_free_slots();
+    }
+    // Compaction runs exclusively but must still interleave correctly with searches.
+    index.compact();
+
+    done = true;
+    searcher.join();
+    CATCH_REQUIRE(num_searches > 0);
+    CATCH_REQUIRE(num_errors == 0);
+
+    index.debug_check_invariants(false);
+    CATCH_REQUIRE(index.size() == num_points);
+    for (size_t id = 0; id < max_id; ++id) {
+        CATCH_REQUIRE(index.has_id(id) == (id >= 2 * batch_size));
+    }
+
+    // The mutated index should still be searchable with reasonable accuracy.
+    auto groundtruth = svs::QueryResult<size_t>(num_queries, NUM_NEIGHBORS);
+    index.exhaustive_search(queries.cview(), NUM_NEIGHBORS, groundtruth.view());
+    auto results = svs::index::search_batch(index, queries, NUM_NEIGHBORS);
+    CATCH_REQUIRE(svs::k_recall_at_n(groundtruth, results) > 0.9);
+}
+
+CATCH_TEST_CASE("Dynamic Range Search", "[graph_index][dynamic_index]") {
+    const size_t dims = 8;
+    const size_t num_points = 2000;
+    const size_t num_queries = 50;
+    const size_t max_degree = 32;
+    const size_t id_offset = 1000;
+    const float radius = 1.5f;
+
+    auto generator = svs_test::make_generator<float>(-1, 1, 0xabcdef);
+    auto random_data = [&](size_t n) {
+        auto data = svs::data::SimpleData<float>(n, dims);
+        for (size_t i = 0; i < n; ++i) {
+            for (auto& x : data.get_datum(i)) {
+                x = svs_test::generate(generator);
+            }
+        }
+        return data;
+    };
+
+    auto initial = random_data(num_points);
+    auto data = svs::data::BlockedData<float>(num_points, dims);
+    for (size_t i = 0; i < num_points; ++i) {
+        data.set_datum(i, initial.get_datum(i));
+    }
+    auto queries = random_data(num_queries);
+    auto ids = std::vector<size_t>(num_points);
+    std::iota(ids.begin(), ids.end(), id_offset);
+
+    svs::index::vamana::VamanaBuildParameters parameters{
+        1.2, max_degree, 2 * max_degree, 1000, max_degree - 4, true};
+    auto index = svs::index::vamana::MutableVamanaIndex(
+        parameters, std::move(data), ids, Distance(), 2
+    );
+    index.set_search_parameters(
+        svs::index::vamana::VamanaSearchParameters().buffer_config(NUM_NEIGHBORS)
+    );
+
+    // Delete every third point.
+    auto deleted = std::vector<size_t>();
+    for (size_t i = 0; i < num_points; i += 3) {
+        deleted.push_back(i + id_offset);
+    }
+    index.delete_entries(deleted);
+
+    auto results = svs::index::range_search(index, queries, radius);
+    CATCH_REQUIRE(results.n_queries() == num_queries);
+
+    size_t expected_total = 0;
+    auto distance = Distance();
+    for (size_t q = 0; q < num_queries; ++q) {
+        // Compute the valid results by brute force.
+        auto expected = std::vector<size_t>();
+        for (size_t i = 0; i < num_points; ++i) {
+            if (i % 3 == 0) {
+                continue;
+            }
+            auto d = svs::distance::compute(
+                distance, queries.get_datum(q), initial.get_datum(i)
+            );
+            if (d <= radius) {
+                expected.push_back(i + id_offset);
+            }
+        }
+        expected_total += expected.size();
+
+        auto found = results.indices(q);
+        auto distances = results.distances(q);
+        CATCH_REQUIRE(std::is_sorted(distances.begin(), distances.end()));
+        for (auto id : found) {
+            CATCH_REQUIRE(
+                std::find(expected.begin(), expected.end(), id) != expected.end()
+            );
+        }
+    }
+    CATCH_REQUIRE(expected_total > NUM_NEIGHBORS * num_queries);
+    CATCH_REQUIRE(results.total_results() >= 0.95 * expected_total);
+}
+
+CATCH_TEST_CASE("Dynamic Filtered Search", "[graph_index][dynamic_index]") {
+    const size_t dims = 8;
+    const size_t num_points = 2000;
+    const size_t num_queries = 50;
+    const size_t max_degree = 32;
+    const size_t id_offset = 1000;
+
+    auto generator = svs_test::make_generator<float>(-1, 1, 0x12345);
+    auto random_data = [&](size_t n) {
+        auto data = svs::data::SimpleData<float>(n, dims);
+        for (size_t i = 0; i < n; ++i) {
+            for (auto& x : data.get_datum(i)) {
+                x = svs_test::generate(generator);
+            }
+        }
+        return data;
+    };
+
+    auto initial = random_data(num_points);
+    auto data = svs::data::BlockedData<float>(num_points, dims);
+    for (size_t i = 0; i < num_points; ++i) {
+        data.set_datum(i, initial.get_datum(i));
+    }
+    auto queries = random_data(num_queries);
+    auto ids = std::vector<size_t>(num_points);
+    std::iota(ids.begin(), ids.end(), id_offset);
+
+    svs::index::vamana::VamanaBuildParameters parameters{
+        1.2, max_degree, 2 * max_degree, 1000, max_degree - 4, true};
+    auto index = svs::index::vamana::MutableVamanaIndex(
+        parameters, std::move(data), ids, Distance(), 2
+    );
+    index.set_search_parameters(
+        svs::index::vamana::VamanaSearchParameters().buffer_config(2 * NUM_NEIGHBORS)
+    );
+
+    // Delete every third point.
+    auto deleted = std::vector<size_t>();
+    for (size_t i = 0; i < num_points; i += 3) {
+        deleted.push_back(i + id_offset);
+    }
+    index.delete_entries(deleted);
+
+    // Filters refer to external IDs.
+    auto make_allowed = [&](size_t modulus, size_t remainder) {
+        auto allowed = svs::BitSet(id_offset + num_points);
+        for (size_t i = remainder; i < num_points; i += modulus) {
+            allowed.set(i + id_offset);
+        }
+        return allowed;
+    };
+
+    auto check = [&](const svs::SearchFilter& filter) {
+        auto results = svs::index::search_batch(index, queries, NUM_NEIGHBORS, filter);
+        auto distance = Distance();
+        size_t hits = 0;
+        for (size_t q = 0; q < num_queries; ++q) {
+            auto allowed = filter.view(q);
+            // Compute the allowed valid nearest neighbors by brute force.
+            auto expected = std::vector<svs::Neighbor<size_t>>();
+            for (size_t i = 0; i < num_points; ++i) {
+                if (i % 3 == 0 || !allowed.test(i + id_offset)) {
+                    continue;
+                }
+                auto d = svs::distance::compute(
+                    distance, queries.get_datum(q), initial.get_datum(i)
+                );
+                expected.emplace_back(i + id_offset, d);
+            }
+            std::sort(expected.begin(), expected.end(), std::less<>());
+            expected.resize(NUM_NEIGHBORS);
+
+            for (size_t j = 0; j < NUM_NEIGHBORS; ++j) {
+                auto id = results.index(q, j);
+                CATCH_REQUIRE(allowed.test(id));
+                CATCH_REQUIRE((id - id_offset) % 3 != 0);
+                hits += std::count_if(
+                    expected.begin(),
+                    expected.end(),
+                    [&](const auto& neighbor) { return neighbor.id() == id; }
+                );
+            }
+        }
+        CATCH_REQUIRE(hits >= 0.9 * NUM_NEIGHBORS * num_queries);
+    };
+
+    CATCH_SECTION("Shared") { check(svs::SearchFilter(make_allowed(5, 1))); }
+
+    CATCH_SECTION("Per Query") {
+        auto bitsets = std::vector<svs::BitSet>();
+        for (size_t q = 0; q < num_queries; ++q) {
+            bitsets.push_back(make_allowed(7, q % 7));
+        }
+        check(svs::SearchFilter(std::move(bitsets)));
+    }
+}
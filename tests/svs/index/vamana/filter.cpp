@@ -16,6 +16,11 @@
 // catch2
 #include "catch2/catch_test_macros.hpp"
 
+// stl
+#include <cstdint>
+#include <limits>
+#include <vector>
+
 namespace {
 
 template <typename I, size_t N>
@@ -87,6 +92,53 @@ template <typename I, size_t N> void test_filter() {
     assert_is_reset(filter);
 }
 
+template <typename I, typename Tag> void test_table() {
+    using table_type = svs::index::vamana::VisitedTable<I, Tag>;
+    constexpr size_t page_size = table_type::page_size;
+    auto table = table_type{};
+    CATCH_REQUIRE(table.capacity() == 0);
+
+    // Insert IDs spread across distant pages, including IDs that alias in a direct-mapped
+    // filter of the same size.
+    auto ids = std::vector<I>{};
+    for (size_t i = 0; i < 2 * page_size; i += 7) {
+        ids.push_back(i);
+        ids.push_back(i + 16 * page_size);
+    }
+    for (auto i : ids) {
+        CATCH_REQUIRE(!table.contains(i));
+        CATCH_REQUIRE(!table.emplace(i));
+    }
+    CATCH_REQUIRE(table.capacity() == 18 * page_size);
+
+    // Nothing is forgotten.
+    for (auto i : ids) {
+        CATCH_REQUIRE(table.contains(i));
+        CATCH_REQUIRE(table.emplace(i));
+        CATCH_REQUIRE(!table.contains(i + 1));
+        table.prefetch(i);
+    }
+    // Unallocated pages are empty.
+    CATCH_REQUIRE(!table.contains(100 * page_size));
+    table.prefetch(100 * page_size);
+
+    // Resetting empties the set for many epochs, including across wraparound.
+    size_t num_resets = 3 * size_t{std::numeric_limits<Tag>::max()};
+    for (size_t r = 0; r < num_resets; ++r) {
+        table.reset();
+        CATCH_REQUIRE(table.epoch() != 0);
+        auto i = ids[r % ids.size()];
+        CATCH_REQUIRE(!table.contains(i));
+        CATCH_REQUIRE(!table.emplace(i));
+        CATCH_REQUIRE(table.contains(i));
+    }
+    table.reset();
+    for (auto i : ids) {
+        CATCH_REQUIRE(!table.contains(i));
+    }
+    CATCH_REQUIRE(table.capacity() == 18 * page_size);
+}
+
 } // namespace
 
 CATCH_TEST_CASE("Visited Filter", "[vamana][visited_filter]") {
@@ -96,3 +148,9 @@ CATCH_TEST_CASE("Visited Filter", "[vamana][visited_filter]") {
     test_filter<uint32_t, 17>();
     test_filter<uint32_t, 18>();
 }
+
+CATCH_TEST_CASE("Visited Table", "[vamana][visited_filter]") {
+    test_table<uint32_t, uint8_t>();
+    test_table<uint32_t, uint16_t>();
+    test_table<uint64_t, uint8_t>();
+}
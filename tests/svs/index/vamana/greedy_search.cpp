@@ -0,0 +1,337 @@
+/**
+ *    Copyright (C) 2023, Intel Corporation
+ *
+ *    You can redistribute and/or modify this software under the terms of the
+ *    GNU Affero General Public License version 3.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    version 3 along with this software. If not, see
+ *    <https://www.gnu.org/licenses/agpl-3.0.en.html>.
+ */
+
+// The distance overloads must be visible before the greedy search is defined.
+#include "svs/core/distance.h"
+
+// Header under test.
+#include "svs/index/vamana/greedy_search.h"
+
+// svs
+#include "svs/core/data/simple.h"
+#include "svs/core/graph/graph.h"
+#include "svs/index/vamana/dynamic_search_buffer.h"
+#include "svs/index/vamana/search_buffer.h"
+
+// catch2
+#include "catch2/catch_test_macros.hpp"
+
+// stl
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace vamana = svs::index::vamana;
+
+namespace {
+
+const size_t NUM_POINTS = 20;
+
+// Count the number of entry points and candidates visited by greedy search.
+class VisitCounter {
+  public:
+    template <typename I>
+    void visited(svs::Neighbor<I> /*neighbor*/, size_t /*num_distance_computations*/) {
+        ++visits_;
+    }
+    size_t visits() const { return visits_; }
+
+  private:
+    size_t visits_ = 0;
+};
+
+// Construct a hub graph where node 0 is connected to all other nodes and all other nodes
+// are only connected to node 0.
+svs::graphs::SimpleGraph<uint32_t> hub_graph() {
+    auto graph = svs::graphs::SimpleGraph<uint32_t>(NUM_POINTS, NUM_POINTS - 1);
+    auto all = std::vector<uint32_t>{};
+    for (uint32_t i = 1; i < NUM_POINTS; ++i) {
+        all.push_back(i);
+        graph.replace_node(i, std::vector<uint32_t>{0});
+    }
+    graph.replace_node(0, all);
+    return graph;
+}
+
+// One dimensional data where element ``i`` has the value ``scale * i``.
+svs::data::SimpleData<float> line_data(float scale) {
+    auto data = svs::data::SimpleData<float>(NUM_POINTS, 1);
+    for (size_t i = 0; i < NUM_POINTS; ++i) {
+        data.get_datum(i)[0] = scale * static_cast<float>(i);
+    }
+    return data;
+}
+
+template <typename Buffer, typename Dist, typename Builder = vamana::NeighborBuilder>
+size_t run_search(
+    const svs::data::SimpleData<float>& data,
+    Dist distance,
+    float query_value,
+    Buffer& buffer,
+    const vamana::GreedySearchTerminationParameters& termination,
+    const Builder& builder = vamana::NeighborBuilder()
+) {
+    auto graph = hub_graph();
+    auto accessor = svs::data::GetDatumAccessor();
+    auto query = std::vector<float>{query_value};
+    auto entry_points = std::vector<uint32_t>{0};
+    auto counter = VisitCounter();
+    vamana::greedy_search(
+        graph,
+        data,
+        accessor,
+        std::span<const float>(query),
+        distance,
+        buffer,
+        entry_points,
+        builder,
+        counter,
+        {},
+        termination
+    );
+    // Discount the single entry point.
+    return counter.visits() - entry_points.size();
+}
+
+template <typename Buffer> std::vector<uint32_t> ids(const Buffer& buffer, size_t n) {
+    auto result = std::vector<uint32_t>{};
+    for (size_t i = 0; i < n; ++i) {
+        result.push_back(buffer[i].id());
+    }
+    return result;
+}
+
+} // namespace
+
+CATCH_TEST_CASE("Greedy Search Early Termination", "[index][vamana][greedy_search]") {
+    const size_t window_size = 10;
+    const size_t num_neighbors = 3;
+    auto expected = std::vector<uint32_t>{0, 1, 2};
+
+    CATCH_SECTION("Disabled") {
+        auto termination = vamana::GreedySearchTerminationParameters{};
+        CATCH_REQUIRE(!termination.enabled());
+        CATCH_REQUIRE(vamana::GreedySearchTerminationParameters{0, 1, 0}.enabled());
+        CATCH_REQUIRE(vamana::GreedySearchTerminationParameters{0, 0, 1.5f}.enabled());
+        CATCH_REQUIRE(!vamana::GreedySearchTerminationParameters{0, 0, 0.5f}.enabled());
+
+        // Loose conditions do not change the search.
+        auto data = line_data(1);
+        auto loose = vamana::GreedySearchTerminationParameters{3, 1000, 1e6f};
+        for (auto t : {termination, loose}) {
+            auto buffer = vamana::SearchBuffer<uint32_t>(window_size);
+            auto expansions = run_search(data, svs::distance::DistanceL2(), 0, buffer, t);
+            CATCH_REQUIRE(expansions == window_size);
+            CATCH_REQUIRE(buffer.size() == window_size);
+            CATCH_REQUIRE(buffer.done());
+            CATCH_REQUIRE(ids(buffer, num_neighbors) == expected);
+        }
+    }
+
+    CATCH_SECTION("Patience") {
+        // Expanding the hub fills the buffer. Expanding node 1 and node 2 does not find
+        // anything new, after which search stops.
+        auto data = line_data(1);
+        auto buffer = vamana::SearchBuffer<uint32_t>(window_size);
+        auto termination = vamana::GreedySearchTerminationParameters{num_neighbors, 2, 0};
+        auto expansions =
+            run_search(data, svs::distance::DistanceL2(), 0, buffer, termination);
+        CATCH_REQUIRE(expansions == 3);
+        CATCH_REQUIRE(!buffer.done());
+        CATCH_REQUIRE(ids(buffer, num_neighbors) == expected);
+
+        // With the visited set enabled, duplicate neighbors are filtered before insertion.
+        buffer.enable_visited_set();
+        expansions = run_search(data, svs::distance::DistanceL2(), 0, buffer, termination);
+        CATCH_REQUIRE(expansions == 3);
+        CATCH_REQUIRE(ids(buffer, num_neighbors) == expected);
+
+        // Monitoring the whole window.
+        termination.num_neighbors = 0;
+        expansions = run_search(data, svs::distance::DistanceL2(), 0, buffer, termination);
+        CATCH_REQUIRE(expansions == 3);
+    }
+
+    CATCH_SECTION("Distance Ratio") {
+        // The third nearest neighbor has a (squared) distance of 4.
+        // Candidate 3 has distance 9 which is more than twice that.
+        auto data = line_data(1);
+        auto buffer = vamana::SearchBuffer<uint32_t>(window_size);
+        auto termination = vamana::GreedySearchTerminationParameters{num_neighbors, 0, 2};
+        auto expansions =
+            run_search(data, svs::distance::DistanceL2(), 0, buffer, termination);
+        CATCH_REQUIRE(expansions == 3);
+        CATCH_REQUIRE(ids(buffer, num_neighbors) == expected);
+
+        // For similarity measures, the bound extends below the third best similarity of
+        // -2 to -4. Candidates 3 and 4 are expanded while candidate 5 is out of range.
+        data = line_data(-1);
+        using IPBuffer = vamana::SearchBuffer<uint32_t, std::greater<>>;
+        auto ip_buffer = IPBuffer(window_size);
+        expansions =
+            run_search(data, svs::distance::DistanceIP(), 1, ip_buffer, termination);
+        CATCH_REQUIRE(expansions == 5);
+        CATCH_REQUIRE(ids(ip_buffer, num_neighbors) == expected);
+    }
+
+    CATCH_SECTION("Mutable Buffer") {
+        // Odd elements are invalid and are navigated through but not returned.
+        auto builder = [](uint32_t i, float distance) {
+            return svs::PredicatedSearchNeighbor<uint32_t>(i, distance, i % 2 == 0);
+        };
+        auto data = line_data(1);
+        auto buffer = vamana::MutableBuffer<uint32_t>(window_size);
+        auto full = run_search(data, svs::distance::DistanceL2(), 0, buffer, {}, builder);
+        buffer.cleanup();
+        auto full_ids = ids(buffer, num_neighbors);
+        CATCH_REQUIRE(full_ids == std::vector<uint32_t>{0, 2, 4});
+
+        auto termination = vamana::GreedySearchTerminationParameters{num_neighbors, 2, 0};
+        auto expansions =
+            run_search(data, svs::distance::DistanceL2(), 0, buffer, termination, builder);
+        buffer.cleanup();
+        CATCH_REQUIRE(expansions == 3);
+        CATCH_REQUIRE(expansions < full);
+        CATCH_REQUIRE(ids(buffer, num_neighbors) == full_ids);
+    }
+
+    CATCH_SECTION("Interleaved") {
+        // Interleaved search applies the same conditions to each query.
+        auto data = line_data(1);
+        auto graph = hub_graph();
+        auto accessor = svs::data::GetDatumAccessor();
+        auto entry_points = std::vector<uint32_t>{0};
+        auto termination = vamana::GreedySearchTerminationParameters{num_neighbors, 2, 0};
+
+        auto query_storage = std::vector<std::vector<float>>{{0}, {19}, {7.2f}};
+        auto queries = std::vector<std::span<const float>>{};
+        auto distances = std::vector<svs::distance::DistanceL2>(query_storage.size());
+        auto buffers = std::vector<vamana::SearchBuffer<uint32_t>>{};
+        for (const auto& q : query_storage) {
+            queries.emplace_back(q);
+            buffers.emplace_back(window_size);
+        }
+        vamana::interleaved_greedy_search(
+            graph,
+            data,
+            accessor,
+            std::span<const std::span<const float>>(queries),
+            std::span(distances),
+            std::span(buffers),
+            entry_points,
+            vamana::NeighborBuilder(),
+            {},
+            termination
+        );
+
+        for (size_t i = 0; i < queries.size(); ++i) {
+            auto buffer = vamana::SearchBuffer<uint32_t>(window_size);
+            run_search(
+                data, svs::distance::DistanceL2(), query_storage[i][0], buffer, termination
+            );
+            CATCH_REQUIRE(ids(buffers[i], window_size) == ids(buffer, window_size));
+        }
+    }
+}
+
+CATCH_TEST_CASE("Range Greedy Search", "[index][vamana][greedy_search]") {
+    auto data = line_data(1);
+    auto graph = hub_graph();
+    auto accessor = svs::data::GetDatumAccessor();
+    auto entry_points = std::vector<uint32_t>{0};
+    auto distance = svs::distance::DistanceL2();
+    // Elements 0 through 5 are within a squared distance of 25 from the query.
+    auto query = std::vector<float>{0};
+    const float radius = 25;
+
+    CATCH_SECTION("Growing") {
+        // The initial window is too small to hold all results.
+        auto buffer = vamana::SearchBuffer<uint32_t>(2);
+        vamana::range_greedy_search(
+            graph,
+            data,
+            accessor,
+            std::span<const float>(query),
+            distance,
+            buffer,
+            entry_points,
+            vamana::NeighborBuilder(),
+            radius,
+            NUM_POINTS
+        );
+        CATCH_REQUIRE(buffer.done());
+        CATCH_REQUIRE(buffer.capacity() > 2);
+        CATCH_REQUIRE(buffer.capacity() <= NUM_POINTS);
+        CATCH_REQUIRE(buffer.size() >= 6);
+        CATCH_REQUIRE(ids(buffer, 6) == std::vector<uint32_t>{0, 1, 2, 3, 4, 5});
+        CATCH_REQUIRE(buffer[6].distance() > radius);
+
+        // The buffer does not grow beyond the maximum capacity.
+        buffer.change_maxsize(2);
+        vamana::range_greedy_search(
+            graph,
+            data,
+            accessor,
+            std::span<const float>(query),
+            distance,
+            buffer,
+            entry_points,
+            vamana::NeighborBuilder(),
+            radius,
+            4
+        );
+        CATCH_REQUIRE(buffer.capacity() == 4);
+        CATCH_REQUIRE(ids(buffer, 4) == std::vector<uint32_t>{0, 1, 2, 3});
+    }
+
+    CATCH_SECTION("No Growth") {
+        // Nothing besides the entry point is within the radius, so the buffer keeps its
+        // size once the entry point can no longer be evicted.
+        auto buffer = vamana::SearchBuffer<uint32_t>(NUM_POINTS);
+        vamana::range_greedy_search(
+            graph,
+            data,
+            accessor,
+            std::span<const float>(query),
+            distance,
+            buffer,
+            entry_points,
+            vamana::NeighborBuilder(),
+            0.5f,
+            2 * NUM_POINTS
+        );
+        CATCH_REQUIRE(buffer.capacity() == NUM_POINTS);
+        CATCH_REQUIRE(buffer[0].id() == 0);
+    }
+
+    CATCH_SECTION("Mutable Buffer") {
+        // Odd elements are invalid and are navigated through but not returned.
+        auto builder = [](uint32_t i, float d) {
+            return svs::PredicatedSearchNeighbor<uint32_t>(i, d, i % 2 == 0);
+        };
+        auto buffer = vamana::MutableBuffer<uint32_t>(2);
+        vamana::range_greedy_search(
+            graph,
+            data,
+            accessor,
+            std::span<const float>(query),
+            distance,
+            buffer,
+            entry_points,
+            builder,
+            radius,
+            NUM_POINTS
+        );
+        buffer.cleanup();
+        CATCH_REQUIRE(buffer.size() >= 3);
+        CATCH_REQUIRE(ids(buffer, 3) == std::vector<uint32_t>{0, 2, 4});
+    }
+}
@@ -12,11 +12,27 @@
 // Header under test
 #include "svs/index/vamana/index.h"
 
+// svs
+#include "svs/core/bitset.h"
+#include "svs/core/data/simple.h"
+#include "svs/core/graph.h"
+#include "svs/core/recall.h"
+#include "svs/index/flat/flat.h"
+#include "svs/lib/threads/workstealing.h"
+
+// tests
+#include "tests/utils/utils.h"
+
 // catch2
 #include "catch2/catch_test_macros.hpp"
 
 // stl
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <set>
 #include <string_view>
+#include <utility>
 
 namespace {
 
@@ -62,6 +78,19 @@ prune_to = 100
 visited_set = false
 )";
 
+// Populate `dataset` with points from `num_clusters` well separated clusters.
+void fill_clusters(
+    svs::data::SimpleData<float>& dataset, size_t num_clusters, std::mt19937& rng
+) {
+    auto noise = std::normal_distribution<float>(0, 1);
+    for (size_t i = 0; i < dataset.size(); ++i) {
+        auto center = static_cast<float>(100 * (i % num_clusters));
+        for (auto& v : dataset.get_datum(i)) {
+            v = center + noise(rng);
+        }
+    }
+}
+
 } // namespace
 
 CATCH_TEST_CASE("Vamana Index Parameters", "[index][vamana]") {
@@ -101,5 +130,659 @@ CATCH_TEST_CASE("Vamana Index Parameters", "[index][vamana]") {
         auto p = VamanaIndexParameters{
             128, {12.4f, 478, 13, 4, 10, false}, {{10, 20}, true, 1, 1}};
         CATCH_REQUIRE(svs::lib::test_self_save_load_context_free(p));
+
+        p.additional_entry_points = {1, 20, 300};
+        CATCH_REQUIRE(svs::lib::test_self_save_load_context_free(p));
+    }
+}
+
+CATCH_TEST_CASE("Vamana Index Entry Points", "[index][vamana]") {
+    // Generate a dataset with a few well separated clusters.
+    size_t num_clusters = 8;
+    size_t cluster_size = 250;
+    size_t dims = 16;
+    auto rng = std::mt19937(0xbeef);
+    auto data = svs::data::SimpleData<float>(num_clusters * cluster_size, dims);
+    auto queries = svs::data::SimpleData<float>(num_clusters * 10, dims);
+    fill_clusters(data, num_clusters, rng);
+    fill_clusters(queries, num_clusters, rng);
+
+    auto parameters =
+        svs::index::vamana::VamanaBuildParameters{1.2f, 16, 32, 100, 16, true};
+    auto build = [&](size_t num_entry_points) {
+        parameters.num_entry_points = num_entry_points;
+        auto copy = svs::data::SimpleData<float>(data.size(), data.dimensions());
+        svs::data::copy(data, copy);
+        return svs::index::vamana::auto_build(
+            parameters, std::move(copy), svs::distance::DistanceL2(), 2
+        );
+    };
+
+    // By default, only the medioid is used.
+    auto index = build(1);
+    CATCH_REQUIRE(index.entry_points().size() == 1);
+
+    index = build(num_clusters + 1);
+    const auto& entry_points = index.entry_points();
+    CATCH_REQUIRE(entry_points.size() > 1);
+    CATCH_REQUIRE(entry_points.size() <= num_clusters + 1);
+    auto unique = std::set<uint32_t>(entry_points.begin(), entry_points.end());
+    CATCH_REQUIRE(unique.size() == entry_points.size());
+
+    // Searching with more entry points than the search window should still return the
+    // nearest neighbor for these well separated queries.
+    index.set_search_parameters(
+        svs::index::vamana::VamanaSearchParameters().buffer_config({4, 4})
+    );
+    auto results = svs::QueryResult<size_t>(queries.size(), 1);
+    index.search(results.view(), queries.cview(), index.get_search_parameters());
+    for (size_t i = 0; i < queries.size(); ++i) {
+        CATCH_REQUIRE(results.index(i, 0) % num_clusters == i % num_clusters);
+    }
+
+    // Entry points are saved with the index.
+    svs_test::prepare_temp_directory();
+    auto temp_directory = svs_test::temp_directory();
+    index.save(
+        temp_directory / "config", temp_directory / "graph", temp_directory / "data"
+    );
+    auto reloaded = svs::index::vamana::auto_assemble(
+        temp_directory / "config",
+        svs::GraphLoader(temp_directory / "graph"),
+        svs::VectorDataLoader<float>(temp_directory / "data"),
+        svs::distance::DistanceL2(),
+        2
+    );
+    CATCH_REQUIRE(reloaded.entry_points() == entry_points);
+
+    // Saved indexes can be mapped in place instead of being read.
+    using MappedData =
+        svs::VectorDataLoader<float, svs::Dynamic, svs::MMapAllocator<float>>;
+    auto mapped = svs::index::vamana::auto_assemble(
+        temp_directory / "config",
+        svs::GraphLoader<uint32_t, svs::MMapAllocator<uint32_t>>(temp_directory / "graph"),
+        MappedData(temp_directory / "data"),
+        svs::distance::DistanceL2(),
+        2
+    );
+    auto mapped_results = svs::QueryResult<size_t>(queries.size(), 1);
+    mapped.search(mapped_results.view(), queries.cview(), index.get_search_parameters());
+    for (size_t i = 0; i < queries.size(); ++i) {
+        CATCH_REQUIRE(mapped_results.index(i, 0) == results.index(i, 0));
+    }
+}
+
+CATCH_TEST_CASE("Vamana Index Exact Visited Set", "[index][vamana]") {
+    size_t num_clusters = 4;
+    size_t dims = 16;
+    auto rng = std::mt19937(0xcafe);
+    auto data = svs::data::SimpleData<float>(2000, dims);
+    auto queries = svs::data::SimpleData<float>(50, dims);
+    fill_clusters(data, num_clusters, rng);
+    fill_clusters(queries, num_clusters, rng);
+
+    auto parameters =
+        svs::index::vamana::VamanaBuildParameters{1.2f, 16, 64, 200, 16, true};
+    parameters.use_exact_visited_set = true;
+    auto index = svs::index::vamana::auto_build(
+        parameters, std::move(data), svs::distance::DistanceL2(), 2
+    );
+
+    // The visited set only avoids repeated distance computations, so every kind of
+    // visited set must return the same results.
+    auto search = [&](bool visited, bool exact) {
+        auto p = svs::index::vamana::VamanaSearchParameters()
+                     .buffer_config({100, 100})
+                     .search_buffer_visited_set(visited)
+                     .search_buffer_exact_visited_set(exact);
+        auto results = svs::QueryResult<size_t>(queries.size(), 10);
+        index.search(results.view(), queries.cview(), p);
+        return results;
+    };
+    auto expected = search(false, false);
+    for (auto [visited, exact] : {std::pair{true, false}, {true, true}, {false, true}}) {
+        auto results = search(visited, exact);
+        for (size_t i = 0; i < queries.size(); ++i) {
+            for (size_t j = 0; j < results.n_neighbors(); ++j) {
+                CATCH_REQUIRE(results.index(i, j) == expected.index(i, j));
+                CATCH_REQUIRE(results.distance(i, j) == expected.distance(i, j));
+            }
+        }
+    }
+}
+
+CATCH_TEST_CASE("Vamana Index Range Search", "[index][vamana]") {
+    size_t num_clusters = 8;
+    size_t cluster_size = 250;
+    size_t dims = 16;
+    auto rng = std::mt19937(0xc0ffee);
+    auto data = svs::data::SimpleData<float>(num_clusters * cluster_size, dims);
+    auto queries = svs::data::SimpleData<float>(num_clusters * 10, dims);
+    fill_clusters(data, num_clusters, rng);
+    fill_clusters(queries, num_clusters, rng);
+
+    auto copy = svs::data::SimpleData<float>(data.size(), data.dimensions());
+    svs::data::copy(data, copy);
+    auto flat =
+        svs::index::flat::FlatIndex(std::move(copy), svs::distance::DistanceL2(), 2);
+    auto index = svs::index::vamana::auto_build(
+        svs::index::vamana::VamanaBuildParameters{1.2f, 16, 32, 100, 16, true},
+        std::move(data),
+        svs::distance::DistanceL2(),
+        2
+    );
+
+    // The search window is much smaller than the number of results for each query.
+    const size_t search_window_size = 10;
+    index.set_search_parameters(
+        svs::index::vamana::VamanaSearchParameters().buffer_config(search_window_size)
+    );
+
+    const float radius = 24;
+    auto expected =
+        flat.range_search(queries.cview(), radius, flat.get_search_parameters());
+    CATCH_REQUIRE(expected.n_queries() == queries.size());
+    CATCH_REQUIRE(expected.offsets().size() == queries.size() + 1);
+    CATCH_REQUIRE(expected.total_results() > search_window_size * queries.size());
+
+    auto results = svs::index::range_search(index, queries, radius);
+    CATCH_REQUIRE(results.n_queries() == queries.size());
+    CATCH_REQUIRE(results.indices().size() == results.total_results());
+    CATCH_REQUIRE(results.distances().size() == results.total_results());
+    for (size_t i = 0; i < queries.size(); ++i) {
+        auto ids = results.indices(i);
+        auto distances = results.distances(i);
+        auto expected_ids = expected.indices(i);
+        auto expected_distances = expected.distances(i);
+        CATCH_REQUIRE(std::is_sorted(distances.begin(), distances.end()));
+        CATCH_REQUIRE(std::is_sorted(expected_distances.begin(), expected_distances.end()));
+        for (auto d : expected_distances) {
+            CATCH_REQUIRE(d <= radius);
+        }
+
+        // Graph search only returns true results.
+        auto truth = std::set<size_t>(expected_ids.begin(), expected_ids.end());
+        for (auto id : ids) {
+            CATCH_REQUIRE(truth.contains(id));
+        }
+    }
+    // Growing the search buffer recovers (almost) all results.
+    CATCH_REQUIRE(results.total_results() >= 0.95 * expected.total_results());
+
+    // A radius excluding everything returns nothing.
+    results = svs::index::range_search(index, queries, -1.0f);
+    CATCH_REQUIRE(results.n_queries() == queries.size());
+    CATCH_REQUIRE(results.total_results() == 0);
+}
+
+CATCH_TEST_CASE("Vamana Index Filtered Search", "[index][vamana]") {
+    size_t num_clusters = 8;
+    size_t cluster_size = 250;
+    size_t dims = 16;
+    auto rng = std::mt19937(0xbeef);
+    auto data = svs::data::SimpleData<float>(num_clusters * cluster_size, dims);
+    auto queries = svs::data::SimpleData<float>(num_clusters * 10, dims);
+    fill_clusters(data, num_clusters, rng);
+    fill_clusters(queries, num_clusters, rng);
+
+    auto copy = svs::data::SimpleData<float>(data.size(), data.dimensions());
+    svs::data::copy(data, copy);
+    auto flat =
+        svs::index::flat::FlatIndex(std::move(copy), svs::distance::DistanceL2(), 2);
+    auto index = svs::index::vamana::auto_build(
+        svs::index::vamana::VamanaBuildParameters{1.2f, 16, 32, 100, 16, true},
+        std::move(data),
+        svs::distance::DistanceL2(),
+        2
+    );
+    index.set_search_parameters(
+        svs::index::vamana::VamanaSearchParameters().buffer_config(20)
+    );
+
+    const size_t num_neighbors = 10;
+    auto check = [&](const svs::SearchFilter& filter) {
+        auto expected = svs::index::search_batch(
+            flat, queries.cview(), num_neighbors, filter
+        );
+        auto results = svs::index::search_batch(index, queries, num_neighbors, filter);
+        for (size_t i = 0; i < queries.size(); ++i) {
+            auto allowed = filter.view(i);
+            for (size_t j = 0; j < num_neighbors; ++j) {
+                CATCH_REQUIRE(allowed.test(results.index(i, j)));
+            }
+        }
+        auto recall = svs::k_recall_at_n(expected, results, num_neighbors, num_neighbors);
+        CATCH_REQUIRE(recall >= 0.95);
+    };
+
+    CATCH_SECTION("Shared") {
+        // Points are assigned to clusters round robin, so the allowed points of every
+        // tenth ID are spread over all clusters.
+        auto allowed = svs::BitSet(index.size());
+        for (size_t i = 0; i < index.size(); i += 10) {
+            allowed.set(i);
+        }
+        check(svs::SearchFilter(allowed));
+    }
+
+    CATCH_SECTION("Per Query") {
+        auto bitsets = std::vector<svs::BitSet>();
+        auto coin = std::bernoulli_distribution(0.05);
+        for (size_t i = 0; i < queries.size(); ++i) {
+            auto& allowed = bitsets.emplace_back(index.size());
+            for (size_t j = 0; j < index.size(); ++j) {
+                if (coin(rng)) {
+                    allowed.set(j);
+                }
+            }
+        }
+        check(svs::SearchFilter(std::move(bitsets)));
+    }
+
+    CATCH_SECTION("Fewer Allowed Than Neighbors") {
+        // Excluded points are traversed, so every allowed point is eventually found.
+        auto allowed = svs::BitSet(index.size());
+        auto ids = std::set<size_t>({3, 500, 1201, 1999});
+        for (auto id : ids) {
+            allowed.set(id);
+        }
+        auto results = svs::index::search_batch(
+            index, queries, num_neighbors, svs::SearchFilter(allowed)
+        );
+        for (size_t i = 0; i < queries.size(); ++i) {
+            auto found = std::set<size_t>();
+            for (size_t j = 0; j < ids.size(); ++j) {
+                found.insert(results.index(i, j));
+            }
+            CATCH_REQUIRE(found == ids);
+            for (size_t j = ids.size(); j < num_neighbors; ++j) {
+                CATCH_REQUIRE(results.index(i, j) == std::numeric_limits<size_t>::max());
+            }
+        }
+    }
+
+    CATCH_SECTION("Empty") {
+        auto expected = svs::index::search_batch(index, queries, num_neighbors);
+        auto results =
+            svs::index::search_batch(index, queries, num_neighbors, svs::SearchFilter());
+        for (size_t i = 0; i < queries.size(); ++i) {
+            for (size_t j = 0; j < num_neighbors; ++j) {
+                CATCH_REQUIRE(results.index(i, j) == expected.index(i, j));
+            }
+        }
+    }
+}
+
+CATCH_TEST_CASE("Vamana Index Label Search", "[index][vamana]") {
+    namespace v = svs::index::vamana;
+    size_t num_clusters = 8;
+    size_t cluster_size = 250;
+    size_t dims = 16;
+    auto rng = std::mt19937(0xbeef);
+    auto data = svs::data::SimpleData<float>(num_clusters * cluster_size, dims);
+    auto queries = svs::data::SimpleData<float>(num_clusters * 10, dims);
+    fill_clusters(data, num_clusters, rng);
+    fill_clusters(queries, num_clusters, rng);
+
+    // Label 0 is rare (about 0.5% of the points, spread over all clusters), labels 1 and 2
+    // overlap, and most points are unlabeled.
+    auto label_lists = std::vector<std::vector<uint32_t>>(data.size());
+    for (size_t i = 0; i < data.size(); ++i) {
+        if (i % 199 == 3) {
+            label_lists[i].push_back(0);
+        }
+        if (i % 7 == 0) {
+            label_lists[i].push_back(1);
+        }
+        if (i % 3 == 0) {
+            label_lists[i].push_back(2);
+        }
+    }
+    auto labels = v::VectorLabels(label_lists);
+
+    auto copy = svs::data::SimpleData<float>(data.size(), data.dimensions());
+    svs::data::copy(data, copy);
+    auto flat =
+        svs::index::flat::FlatIndex(std::move(copy), svs::distance::DistanceL2(), 2);
+    auto index = v::auto_build(
+        v::VamanaBuildParameters{1.2f, 16, 32, 100, 16, true},
+        std::move(data),
+        svs::distance::DistanceL2(),
+        2,
+        labels
+    );
+    index.set_search_parameters(v::VamanaSearchParameters().buffer_config(20));
+    CATCH_REQUIRE(index.labels().size() == index.size());
+    CATCH_REQUIRE(index.label_entry_points().size() == 3);
+    for (uint32_t label = 0; label < 3; ++label) {
+        CATCH_REQUIRE(labels.has_label(index.label_entry_points()[label], label));
+    }
+
+    const size_t num_neighbors = 10;
+    auto search = [&](auto& searched, const std::vector<uint32_t>& query_labels) {
+        auto results = svs::QueryResult<size_t>(queries.size(), num_neighbors);
+        searched.search(
+            results.view(),
+            queries.cview(),
+            searched.get_search_parameters(),
+            std::span<const uint32_t>(query_labels)
+        );
+        return results;
+    };
+
+    auto check = [&](const std::vector<uint32_t>& query_labels) {
+        auto bitsets = std::vector<svs::BitSet>();
+        for (auto label : query_labels) {
+            auto& allowed = bitsets.emplace_back(index.size());
+            for (size_t i = 0; i < index.size(); ++i) {
+                if (labels.has_label(i, label)) {
+                    allowed.set(i);
+                }
+            }
+        }
+        auto expected = svs::index::search_batch(
+            flat, queries.cview(), num_neighbors, svs::SearchFilter(std::move(bitsets))
+        );
+        auto results = search(index, query_labels);
+        for (size_t i = 0; i < queries.size(); ++i) {
+            for (size_t j = 0; j < num_neighbors; ++j) {
+                CATCH_REQUIRE(labels.has_label(results.index(i, j), query_labels[i]));
+            }
+        }
+        auto recall = svs::k_recall_at_n(expected, results, num_neighbors, num_neighbors);
+        CATCH_REQUIRE(recall >= 0.95);
+        return results;
+    };
+
+    CATCH_SECTION("Shared Label") {
+        for (uint32_t label = 0; label < 3; ++label) {
+            check(std::vector<uint32_t>(queries.size(), label));
+        }
+    }
+
+    CATCH_SECTION("Per Query Label") {
+        auto query_labels = std::vector<uint32_t>(queries.size());
+        for (size_t i = 0; i < queries.size(); ++i) {
+            query_labels[i] = i % 3;
+        }
+        auto results = check(query_labels);
+
+        // Labels are saved with the index.
+        svs_test::prepare_temp_directory();
+        auto temp_directory = svs_test::temp_directory();
+        index.save(
+            temp_directory / "config", temp_directory / "graph", temp_directory / "data"
+        );
+        auto reloaded = v::auto_assemble(
+            temp_directory / "config",
+            svs::GraphLoader(temp_directory / "graph"),
+            svs::VectorDataLoader<float>(temp_directory / "data"),
+            svs::distance::DistanceL2(),
+            2
+        );
+        CATCH_REQUIRE(reloaded.labels().size() == index.size());
+        CATCH_REQUIRE(reloaded.label_entry_points() == index.label_entry_points());
+        auto reloaded_results = search(reloaded, query_labels);
+        for (size_t i = 0; i < queries.size(); ++i) {
+            for (size_t j = 0; j < num_neighbors; ++j) {
+                CATCH_REQUIRE(reloaded_results.index(i, j) == results.index(i, j));
+            }
+        }
+    }
+
+    CATCH_SECTION("Missing Label") {
+        // No vector carries label 5, so only sentinels are returned.
+        auto results = search(index, std::vector<uint32_t>(queries.size(), 5));
+        for (size_t i = 0; i < queries.size(); ++i) {
+            for (size_t j = 0; j < num_neighbors; ++j) {
+                CATCH_REQUIRE(results.index(i, j) == std::numeric_limits<size_t>::max());
+            }
+        }
+
+        // Label counts must match the queries.
+        CATCH_REQUIRE_THROWS_AS(search(index, {0, 1}), svs::ANNException);
+    }
+
+    CATCH_SECTION("Unlabeled Index") {
+        auto small = svs::data::SimpleData<float>(queries.size(), dims);
+        svs::data::copy(queries, small);
+        auto unlabeled = v::auto_build(
+            v::VamanaBuildParameters{1.2f, 16, 32, 100, 16, true},
+            std::move(small),
+            svs::distance::DistanceL2(),
+            1
+        );
+        CATCH_REQUIRE(unlabeled.labels().empty());
+        CATCH_REQUIRE_THROWS_AS(
+            search(unlabeled, std::vector<uint32_t>(queries.size(), 0)), svs::ANNException
+        );
+    }
+}
+
+CATCH_TEST_CASE("Vamana Index Reorder", "[index][vamana]") {
+    namespace v = svs::index::vamana;
+    size_t num_clusters = 4;
+    size_t dims = 16;
+    auto rng = std::mt19937(0xd00d);
+    auto data = svs::data::SimpleData<float>(2000, dims);
+    auto queries = svs::data::SimpleData<float>(50, dims);
+    fill_clusters(data, num_clusters, rng);
+    fill_clusters(queries, num_clusters, rng);
+
+    auto label_lists = std::vector<std::vector<uint32_t>>(data.size());
+    for (size_t i = 0; i < data.size(); i += 3) {
+        label_lists[i].push_back(0);
+    }
+    auto copy = svs::data::SimpleData<float>(data.size(), data.dimensions());
+    svs::data::copy(data, copy);
+    auto index = v::auto_build(
+        v::VamanaBuildParameters{1.2f, 16, 32, 100, 16, true},
+        std::move(copy),
+        svs::distance::DistanceL2(),
+        2,
+        v::VectorLabels(label_lists)
+    );
+    index.set_search_parameters(v::VamanaSearchParameters().buffer_config(20));
+    CATCH_REQUIRE(index.external_ids().empty());
+
+    const size_t num_neighbors = 10;
+    auto allowed = svs::BitSet(index.size());
+    for (size_t i = 0; i < index.size(); i += 5) {
+        allowed.set(i);
+    }
+    auto query_labels = std::vector<uint32_t>(queries.size(), 0);
+
+    // Run every kind of search.
+    auto search_all = [&](auto& searched) {
+        auto results = std::vector<svs::QueryResult<size_t>>();
+        auto p = searched.get_search_parameters();
+        results.emplace_back(queries.size(), num_neighbors);
+        searched.search(results.back().view(), queries.cview(), p);
+        results.emplace_back(queries.size(), num_neighbors);
+        searched.search(
+            results.back().view(), queries.cview(), p, svs::SearchFilter(allowed)
+        );
+        results.emplace_back(queries.size(), num_neighbors);
+        searched.search(
+            results.back().view(),
+            queries.cview(),
+            p,
+            std::span<const uint32_t>(query_labels)
+        );
+        auto range = searched.range_search(queries.cview(), 50.0f, p);
+        return std::make_pair(std::move(results), std::move(range));
+    };
+
+    // Reordering renumbers the vectors without changing the graph, so search returns
+    // exactly the same external IDs.
+    auto check = [&](auto& searched, const auto& expected) {
+        auto [results, range] = search_all(searched);
+        for (size_t k = 0; k < results.size(); ++k) {
+            for (size_t i = 0; i < queries.size(); ++i) {
+                for (size_t j = 0; j < num_neighbors; ++j) {
+                    CATCH_REQUIRE(results[k].index(i, j) == expected.first[k].index(i, j));
+                    CATCH_REQUIRE(
+                        results[k].distance(i, j) == expected.first[k].distance(i, j)
+                    );
+                }
+            }
+        }
+        CATCH_REQUIRE(range.offsets() == expected.second.offsets());
+        CATCH_REQUIRE(range.indices() == expected.second.indices());
+
+        // Reconstruction uses external IDs.
+        auto ids = std::vector<uint64_t>{0, 1, 1999, 1000};
+        auto dst = svs::data::SimpleData<float>(ids.size(), dims);
+        searched.reconstruct_at(dst.view(), std::span<const uint64_t>(ids));
+        for (size_t i = 0; i < ids.size(); ++i) {
+            CATCH_REQUIRE(std::ranges::equal(dst.get_datum(i), data.get_datum(ids[i])));
+        }
+    };
+
+    auto expected = search_all(index);
+    CATCH_REQUIRE(expected.second.indices().size() > 0);
+    for (auto ordering :
+         {v::GraphOrdering::BreadthFirst,
+          v::GraphOrdering::ReverseCuthillMcKee,
+          v::GraphOrdering::Gorder}) {
+        // Successive reorderings compose.
+        index.reorder(ordering);
+        check(index, expected);
+
+        const auto& external_ids = index.external_ids();
+        CATCH_REQUIRE(external_ids.size() == index.size());
+        for (uint32_t i = 0; i < index.size(); ++i) {
+            CATCH_REQUIRE(index.translate_internal_id(i) == external_ids[i]);
+            CATCH_REQUIRE(index.translate_external_id(external_ids[i]) == i);
+            CATCH_REQUIRE(index.labels().has_label(i, 0) == (external_ids[i] % 3 == 0));
+        }
+    }
+    // Breadth-first order places the entry point first.
+    index.reorder(v::GraphOrdering::BreadthFirst);
+    CATCH_REQUIRE(index.entry_points().front() == 0);
+
+    // External IDs are saved with the index.
+    svs_test::prepare_temp_directory();
+    auto temp_directory = svs_test::temp_directory();
+    index.save(
+        temp_directory / "config", temp_directory / "graph", temp_directory / "data"
+    );
+    auto reloaded = v::auto_assemble(
+        temp_directory / "config",
+        svs::GraphLoader(temp_directory / "graph"),
+        svs::VectorDataLoader<float>(temp_directory / "data"),
+        svs::distance::DistanceL2(),
+        2
+    );
+    CATCH_REQUIRE(reloaded.external_ids() == index.external_ids());
+    check(reloaded, expected);
+
+    // Invalid permutations are rejected.
+    auto bad = std::vector<uint32_t>(index.size(), 0);
+    CATCH_REQUIRE_THROWS_AS(
+        index.reorder(std::span<const uint32_t>(bad)), svs::ANNException
+    );
+    CATCH_REQUIRE_THROWS_AS(
+        index.set_external_ids(std::vector<uint32_t>(3, 0)), svs::ANNException
+    );
+}
+
+CATCH_TEST_CASE("Vamana Index Work Stealing", "[index][vamana]") {
+    namespace v = svs::index::vamana;
+    size_t num_clusters = 4;
+    size_t dims = 16;
+    size_t num_neighbors = 10;
+    auto rng = std::mt19937(0xf00d);
+    auto data = svs::data::SimpleData<float>(2000, dims);
+    auto queries = svs::data::SimpleData<float>(50, dims);
+    fill_clusters(data, num_clusters, rng);
+    fill_clusters(queries, num_clusters, rng);
+    auto parameters = v::VamanaBuildParameters{1.2f, 16, 32, 100, 16, true};
+    auto threadpool =
+        svs::threads::WorkStealingThreadPool(4, svs::threads::default_spintime(), 2);
+
+    // Build with the work-stealing pool.
+    auto graph = svs::graphs::SimpleGraph<uint32_t>(data.size(), 16);
+    auto entry_point =
+        svs::lib::narrow<uint32_t>(v::extensions::compute_entry_point(data, threadpool));
+    auto builder =
+        v::VamanaBuilder(graph, data, svs::distance::DistanceL2(), parameters, threadpool);
+    builder.construct(1.0f, entry_point);
+    builder.construct(parameters.alpha, entry_point);
+    auto index = v::VamanaIndex{
+        std::move(graph), std::move(data), entry_point, svs::distance::DistanceL2(), 2};
+    auto p = v::VamanaSearchParameters().buffer_config(40);
+    auto expected = svs::QueryResult<size_t>(queries.size(), num_neighbors);
+    index.search(expected.view(), queries.cview(), p);
+    for (size_t i = 0; i < queries.size(); ++i) {
+        CATCH_REQUIRE(expected.index(i, 0) % num_clusters == i % num_clusters);
+    }
+
+    // Search blocks of queries from within the tasks of the pool. Each nested search is
+    // parallelized by the same pool.
+    size_t blocksize = 16;
+    size_t num_blocks = svs::lib::div_round_up(queries.size(), blocksize);
+    auto results = svs::QueryResult<size_t>(queries.size(), num_neighbors);
+    svs::threads::run(
+        threadpool,
+        svs::threads::DynamicPartition(num_blocks, 1),
+        [&](const auto& blocks, uint64_t /*tid*/) {
+            for (auto block : blocks) {
+                size_t start = block * blocksize;
+                size_t count = std::min(blocksize, queries.size() - start);
+                auto view = svs::QueryResultView<size_t>(
+                    svs::MatrixView<size_t>(
+                        svs::make_dims(count, num_neighbors), &results.index(start, 0)
+                    ),
+                    svs::MatrixView<float>(
+                        svs::make_dims(count, num_neighbors), &results.distance(start, 0)
+                    )
+                );
+                auto batch = svs::data::ConstSimpleDataView<float>(
+                    queries.get_datum(start).data(), count, dims
+                );
+                index.search(view, batch, p, threadpool);
+            }
+        }
+    );
+    for (size_t i = 0; i < queries.size(); ++i) {
+        for (size_t j = 0; j < num_neighbors; ++j) {
+            CATCH_REQUIRE(results.index(i, j) == expected.index(i, j));
+            CATCH_REQUIRE(results.distance(i, j) == expected.distance(i, j));
+        }
+    }
+}
+
+CATCH_TEST_CASE("Vamana Build Vectorized Search Buffer", "[index][vamana]") {
+    namespace v = svs::index::vamana;
+    size_t dims = 16;
+    auto rng = std::mt19937(0xbeef);
+    auto data = svs::data::SimpleData<float>(1000, dims);
+    fill_clusters(data, 4, rng);
+
+    // With a single thread construction is deterministic, so both search buffers must
+    // produce the same graph.
+    auto build = [&](bool vectorized) {
+        auto parameters = v::VamanaBuildParameters{1.2f, 16, 32, 100, 16, true};
+        parameters.use_vectorized_search_buffer = vectorized;
+        auto threadpool = svs::threads::NativeThreadPool(1);
+        auto graph = svs::graphs::SimpleGraph<uint32_t>(data.size(), 16);
+        auto entry_point = svs::lib::narrow<uint32_t>(
+            v::extensions::compute_entry_point(data, threadpool)
+        );
+        auto builder = v::VamanaBuilder(
+            graph, data, svs::distance::DistanceL2(), parameters, threadpool
+        );
+        builder.construct(1.0f, entry_point);
+        builder.construct(parameters.alpha, entry_point);
+        return graph;
+    };
+
+    auto expected = build(false);
+    auto graph = build(true);
+    for (size_t i = 0; i < data.size(); ++i) {
+        auto a = expected.get_node(i);
+        auto b = graph.get_node(i);
+        CATCH_REQUIRE(std::equal(a.begin(), a.end(), b.begin(), b.end()));
     }
 }
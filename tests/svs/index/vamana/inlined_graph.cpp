@@ -0,0 +1,259 @@
+/**
+ *    Copyright (C) 2023, Intel Corporation
+ *
+ *    You can redistribute and/or modify this software under the terms of the
+ *    GNU Affero General Public License version 3.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    version 3 along with this software. If not, see
+ *    <https://www.gnu.org/licenses/agpl-3.0.en.html>.
+ */
+
+// header under test
+#include "svs/index/vamana/inlined_graph.h"
+
+// svs
+#include "svs/core/data/simple.h"
+#include "svs/core/distance.h"
+#include "svs/core/graph.h"
+#include "svs/core/recall.h"
+#include "svs/index/vamana/index.h"
+#include "svs/lib/saveload.h"
+
+// tests
+#include "tests/utils/synthetic.h"
+#include "tests/utils/utils.h"
+
+// catch2
+#include "catch2/catch_approx.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+// stl
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+CATCH_TEST_CASE("Neighbor Codebook", "[index][vamana][inlined_graph]") {
+    // Dimension 0 spans [0, 15], dimension 1 spans [-3, 27] and dimension 2 is constant.
+    auto data = svs::data::SimpleData<float>(2, 3);
+    data.set_datum(0, std::vector<float>{0, -3, 5});
+    data.set_datum(1, std::vector<float>{15, 27, 5});
+    auto threadpool = svs::threads::NativeThreadPool(2);
+    auto codebook = svs::index::vamana::NeighborCodebook::train(data, threadpool);
+    CATCH_REQUIRE(codebook.dimensions() == 3);
+    CATCH_REQUIRE(codebook.code_bytes() == 2);
+    CATCH_REQUIRE(codebook.decode(0, 7) == 7);
+    CATCH_REQUIRE(codebook.decode(1, 15) == 27);
+    CATCH_REQUIRE(codebook.decode(2, 0) == 5);
+
+    // Values round to the nearest level and out-of-range values are clamped.
+    auto codes = std::vector<uint8_t>(codebook.code_bytes());
+    codebook.encode(std::span<const float>(std::vector<float>{7.4, 100, 5}), codes.data());
+    CATCH_REQUIRE(codes[0] == (7 | (15 << 4)));
+    CATCH_REQUIRE(codes[1] == 0);
+    codebook.encode(std::span<const float>(std::vector<float>{-1, 0.1, 9}), codes.data());
+    CATCH_REQUIRE(codes[0] == (0 | (2 << 4)));
+
+    // The lookup tables sum the per-dimension contributions of the decoded values
+    // (0, 1, 5).
+    auto query = std::vector<float>{1, 2, 3};
+    auto l2 = svs::index::vamana::NeighborCodeTable<svs::distance::DistanceL2>();
+    l2.fix(codebook, query);
+    CATCH_REQUIRE(l2(codes.data()) == Catch::Approx(1 + 1 + 4));
+    auto ip = svs::index::vamana::NeighborCodeTable<svs::distance::DistanceIP>();
+    ip.fix(codebook, query);
+    CATCH_REQUIRE(ip(codes.data()) == Catch::Approx(0 + 2 * 1 + 3 * 5));
+
+    // Saving and loading.
+    CATCH_REQUIRE(svs::lib::test_self_save_load_context_free(codebook));
+}
+
+CATCH_TEST_CASE("Inlined Graph Layout", "[index][vamana][inlined_graph]") {
+    const size_t dims = 7;
+    const size_t max_degree = 5;
+    auto rng = std::mt19937(0xf00d);
+    auto data = synthetic::make_data(100, dims, rng);
+    auto graph = svs::graphs::SimpleGraph<uint32_t>(data.size(), max_degree);
+    auto ids = std::uniform_int_distribution<uint32_t>(0, data.size() - 1);
+    for (uint32_t i = 0; i < graph.n_nodes(); ++i) {
+        // Leave some vertices without neighbors.
+        for (size_t j = 0, jmax = i % (max_degree + 1); j < jmax; ++j) {
+            graph.add_edge(i, ids(rng));
+        }
+    }
+
+    auto threadpool = svs::threads::NativeThreadPool(2);
+    using InlinedGraph = svs::index::vamana::InlinedGraph<uint32_t>;
+    auto inlined = InlinedGraph::build(graph, data, threadpool);
+    CATCH_REQUIRE(inlined.n_nodes() == graph.n_nodes());
+    CATCH_REQUIRE(inlined.max_degree() == max_degree);
+    CATCH_REQUIRE(inlined.record_bytes() % 64 == 0);
+    CATCH_REQUIRE(inlined.record_bytes() >= (max_degree + 1) * 4 + max_degree * 4);
+
+    const auto& codebook = inlined.codebook();
+    CATCH_REQUIRE(codebook.code_bytes() == 4);
+    auto code = std::vector<uint8_t>(codebook.code_bytes());
+    for (uint32_t i = 0; i < graph.n_nodes(); ++i) {
+        auto neighbors = graph.get_node(i);
+        auto inlined_neighbors = inlined.get_node(i);
+        CATCH_REQUIRE(inlined.get_node_degree(i) == neighbors.size());
+        CATCH_REQUIRE(std::equal(
+            neighbors.begin(),
+            neighbors.end(),
+            inlined_neighbors.begin(),
+            inlined_neighbors.end()
+        ));
+        // The codes of each neighbor follow the adjacency list.
+        for (size_t j = 0; j < neighbors.size(); ++j) {
+            codebook.encode(
+                std::span<const float>(data.get_datum(neighbors[j])), code.data()
+            );
+            CATCH_REQUIRE(std::equal(
+                code.begin(), code.end(), inlined.get_codes(i) + j * code.size()
+            ));
+        }
+    }
+
+    // Graph and dataset sizes must match.
+    auto small = synthetic::make_data(10, dims, rng);
+    CATCH_REQUIRE_THROWS_AS(
+        InlinedGraph::build(graph, small, threadpool), svs::ANNException
+    );
+}
+
+CATCH_TEST_CASE("Inlined Graph", "[index][vamana][inlined_graph]") {
+    const size_t dims = 16;
+    const size_t num_neighbors = 10;
+    auto rng = std::mt19937(0xbeef);
+    auto data = synthetic::make_data(2000, dims, rng);
+    auto queries = synthetic::make_data(100, dims, rng);
+
+    auto groundtruth = synthetic::groundtruth(data, queries, num_neighbors);
+    auto index = synthetic::build_vamana(data);
+    CATCH_REQUIRE(!index.has_inlined_graph());
+    CATCH_REQUIRE_THROWS_AS(index.get_inlined_graph(), svs::ANNException);
+
+    auto parameters = svs::index::vamana::VamanaSearchParameters().buffer_config(40);
+    auto search = [&]() {
+        auto results = svs::QueryResult<size_t>(queries.size(), num_neighbors);
+        index.search(results.view(), queries.cview(), parameters);
+        return results;
+    };
+    auto expected = search();
+    auto expected_recall = svs::k_recall_at_n(groundtruth, expected);
+
+    index.build_inlined_graph();
+    CATCH_REQUIRE(index.has_inlined_graph());
+    const auto& inlined = index.get_inlined_graph();
+
+    CATCH_SECTION("Search") {
+        // Estimates occasionally discard true neighbors, so recall may drop slightly.
+        auto results = search();
+        auto recall = svs::k_recall_at_n(groundtruth, results);
+        CATCH_REQUIRE(recall > expected_recall - 0.05);
+        CATCH_REQUIRE(recall > 0.8);
+
+        // Results carry exact distances.
+        auto distance = svs::distance::DistanceL2();
+        for (size_t i = 0; i < queries.size(); ++i) {
+            for (size_t j = 0; j < num_neighbors; ++j) {
+                auto id = results.index(i, j);
+                CATCH_REQUIRE(
+                    results.distance(i, j) ==
+                    Catch::Approx(svs::distance::compute(
+                        distance, queries.get_datum(i), data.get_datum(id)
+                    ))
+                );
+            }
+        }
+
+        // Clearing the layout returns to regular search.
+        index.clear_inlined_graph();
+        CATCH_REQUIRE(!index.has_inlined_graph());
+        results = search();
+        for (size_t i = 0; i < queries.size(); ++i) {
+            for (size_t j = 0; j < num_neighbors; ++j) {
+                CATCH_REQUIRE(results.index(i, j) == expected.index(i, j));
+            }
+        }
+    }
+
+    CATCH_SECTION("Saving and Loading") {
+        svs_test::prepare_temp_directory();
+        auto dir = svs_test::temp_directory();
+        svs::lib::save_to_disk(inlined, dir);
+        using Graph = svs::index::vamana::InlinedGraph<uint32_t>;
+        auto reloaded = svs::lib::load_from_disk<Graph>(dir);
+        CATCH_REQUIRE(reloaded.n_nodes() == inlined.n_nodes());
+        CATCH_REQUIRE(reloaded.max_degree() == inlined.max_degree());
+        CATCH_REQUIRE(reloaded.codebook() == inlined.codebook());
+        for (uint32_t i = 0; i < inlined.n_nodes(); ++i) {
+            auto a = inlined.get_node(i);
+            auto b = reloaded.get_node(i);
+            CATCH_REQUIRE(std::equal(a.begin(), a.end(), b.begin(), b.end()));
+            size_t bytes = a.size() * inlined.codebook().code_bytes();
+            CATCH_REQUIRE(std::equal(
+                inlined.get_codes(i), inlined.get_codes(i) + bytes, reloaded.get_codes(i)
+            ));
+        }
+
+        // Loading with a different index type fails.
+        CATCH_REQUIRE_THROWS_AS(
+            svs::lib::load_from_disk<svs::index::vamana::InlinedGraph<uint64_t>>(dir),
+            svs::ANNException
+        );
+
+        // Reloaded layouts are accepted only if they match the index.
+        index.clear_inlined_graph();
+        index.set_inlined_graph(std::move(reloaded));
+        CATCH_REQUIRE(index.has_inlined_graph());
+        CATCH_REQUIRE_THROWS_AS(
+            index.set_inlined_graph(Graph(10, 24, inlined.codebook())), svs::ANNException
+        );
+    }
+
+    CATCH_SECTION("Index Saving and Loading") {
+        svs_test::prepare_temp_directory();
+        auto dir = svs_test::temp_directory();
+        auto results = search();
+        index.save(dir / "config", dir / "graph", dir / "data");
+        auto reloaded = svs::index::vamana::auto_assemble(
+            dir / "config",
+            svs::GraphLoader(dir / "graph"),
+            svs::VectorDataLoader<float>(dir / "data"),
+            svs::distance::DistanceL2(),
+            2
+        );
+        CATCH_REQUIRE(reloaded.has_inlined_graph());
+        const auto& layout = reloaded.get_inlined_graph();
+        CATCH_REQUIRE(layout.n_nodes() == inlined.n_nodes());
+        CATCH_REQUIRE(layout.codebook() == inlined.codebook());
+        for (uint32_t i = 0; i < inlined.n_nodes(); ++i) {
+            size_t bytes = inlined.get_node(i).size() * inlined.codebook().code_bytes();
+            CATCH_REQUIRE(std::equal(
+                inlined.get_codes(i), inlined.get_codes(i) + bytes, layout.get_codes(i)
+            ));
+        }
+
+        auto reloaded_results = svs::QueryResult<size_t>(queries.size(), num_neighbors);
+        reloaded.search(reloaded_results.view(), queries.cview(), parameters);
+        for (size_t i = 0; i < queries.size(); ++i) {
+            for (size_t j = 0; j < num_neighbors; ++j) {
+                CATCH_REQUIRE(reloaded_results.index(i, j) == results.index(i, j));
+            }
+        }
+
+        // Indexes saved without the layout reload without it.
+        index.clear_inlined_graph();
+        index.save(dir / "config", dir / "graph", dir / "data");
+        auto plain = svs::index::vamana::auto_assemble(
+            dir / "config",
+            svs::GraphLoader(dir / "graph"),
+            svs::VectorDataLoader<float>(dir / "data"),
+            svs::distance::DistanceL2(),
+            2
+        );
+        CATCH_REQUIRE(!plain.has_inlined_graph());
+    }
+}
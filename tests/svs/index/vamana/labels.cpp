@@ -0,0 +1,108 @@
+/**
+ *    Copyright (C) 2023, Intel Corporation
+ *
+ *    You can redistribute and/or modify this software under the terms of the
+ *    GNU Affero General Public License version 3.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    version 3 along with this software. If not, see
+ *    <https://www.gnu.org/licenses/agpl-3.0.en.html>.
+ */
+
+// header under test
+#include "svs/index/vamana/labels.h"
+
+// tests
+#include "tests/utils/utils.h"
+
+// catch2
+#include "catch2/catch_test_macros.hpp"
+
+// stl
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+void check_equal(
+    const svs::index::vamana::VectorLabels& a, const svs::index::vamana::VectorLabels& b
+) {
+    CATCH_REQUIRE(a.size() == b.size());
+    CATCH_REQUIRE(a.num_labels() == b.num_labels());
+    for (size_t i = 0; i < a.size(); ++i) {
+        auto x = a.labels(i);
+        auto y = b.labels(i);
+        CATCH_REQUIRE(
+            std::vector<uint32_t>(x.begin(), x.end()) ==
+            std::vector<uint32_t>(y.begin(), y.end())
+        );
+    }
+}
+
+} // namespace
+
+CATCH_TEST_CASE("Vector Labels", "[index][vamana][labels]") {
+    namespace v = svs::index::vamana;
+    auto labels = v::VectorLabels({{3, 1, 3}, {}, {1}, {0, 2}, {2, 1}});
+
+    CATCH_SECTION("Basic") {
+        auto empty = v::VectorLabels();
+        CATCH_REQUIRE(empty.empty());
+        CATCH_REQUIRE(empty.size() == 0);
+        CATCH_REQUIRE(empty.num_labels() == 0);
+
+        CATCH_REQUIRE(!labels.empty());
+        CATCH_REQUIRE(labels.size() == 5);
+        CATCH_REQUIRE(labels.num_labels() == 4);
+        // Labels are sorted and duplicates are removed.
+        auto first = labels.labels(0);
+        CATCH_REQUIRE(
+            std::vector<uint32_t>(first.begin(), first.end()) ==
+            std::vector<uint32_t>{1, 3}
+        );
+        CATCH_REQUIRE(labels.labels(1).empty());
+        CATCH_REQUIRE(labels.has_label(0, 3));
+        CATCH_REQUIRE(!labels.has_label(0, 2));
+        CATCH_REQUIRE(!labels.has_label(1, 0));
+        CATCH_REQUIRE(labels.label_counts() == std::vector<size_t>{1, 3, 2, 1});
+
+        CATCH_REQUIRE(labels.shares_label(0, 2));
+        CATCH_REQUIRE(labels.shares_label(3, 4));
+        CATCH_REQUIRE(!labels.shares_label(0, 3));
+        CATCH_REQUIRE(!labels.shares_label(1, 1));
+
+        // Vectors 0 and 4 share label 1, carried by 2 but not by 3.
+        CATCH_REQUIRE(labels.covers_shared(0, 4, 2));
+        CATCH_REQUIRE(!labels.covers_shared(0, 4, 3));
+        // Nothing is shared between 0 and 3, so anything covers it.
+        CATCH_REQUIRE(labels.covers_shared(0, 3, 1));
+    }
+
+    CATCH_SECTION("Entry Points") {
+        auto entry_points = v::select_label_entry_points(labels, uint32_t{100});
+        CATCH_REQUIRE(entry_points.size() == labels.num_labels());
+        for (uint32_t label = 0; label < labels.num_labels(); ++label) {
+            CATCH_REQUIRE(labels.has_label(entry_points[label], label));
+        }
+        // Label 2 avoids vector 3, which is already the entry point of label 0.
+        CATCH_REQUIRE(entry_points[0] == 3);
+        CATCH_REQUIRE(entry_points[1] == 0);
+        CATCH_REQUIRE(entry_points[2] == 4);
+        CATCH_REQUIRE(entry_points[3] == 0);
+
+        // Labels without vectors use the fallback.
+        auto sparse = v::VectorLabels({{2}, {2}});
+        entry_points = v::select_label_entry_points(sparse, uint32_t{100});
+        CATCH_REQUIRE(entry_points == std::vector<uint32_t>{100, 100, 0});
+    }
+
+    CATCH_SECTION("Saving and Loading") {
+        auto tempdir = svs_test::prepare_temp_directory_v2();
+        svs::lib::save_to_disk(labels, tempdir);
+        auto reloaded = svs::lib::load_from_disk<v::VectorLabels>(tempdir);
+        check_equal(labels, reloaded);
+
+        svs::lib::save_to_disk(v::VectorLabels(), tempdir);
+        CATCH_REQUIRE(svs::lib::load_from_disk<v::VectorLabels>(tempdir).empty());
+    }
+}
@@ -0,0 +1,209 @@
+/**
+ *    Copyright (C) 2023, Intel Corporation
+ *
+ *    You can redistribute and/or modify this software under the terms of the
+ *    GNU Affero General Public License version 3.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    version 3 along with this software. If not, see
+ *    <https://www.gnu.org/licenses/agpl-3.0.en.html>.
+ */
+
+// header under test
+#include "svs/index/vamana/partitioned_build.h"
+
+// svs
+#include "svs/core/data/simple.h"
+#include "svs/core/distance.h"
+#include "svs/core/recall.h"
+#include "svs/lib/threads.h"
+
+// tests
+#include "tests/utils/synthetic.h"
+#include "tests/utils/utils.h"
+
+// catch2
+#include "catch2/catch_test_macros.hpp"
+
+// stl
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <random>
+#include <vector>
+
+CATCH_TEST_CASE("Partitioned Vamana Build", "[index][vamana][partitioned_build]") {
+    namespace v = svs::index::vamana;
+    const size_t dims = 16;
+    const size_t num_neighbors = 10;
+    auto rng = std::mt19937(0xc0ffee);
+    auto data = synthetic::make_data(3000, dims, rng);
+    auto queries = synthetic::make_data(100, dims, rng);
+    auto threadpool = svs::threads::NativeThreadPool(2);
+
+    CATCH_SECTION("Partition Count") {
+        auto parameters = v::PartitionedBuildParameters().num_partitions(3).overlap(2);
+        CATCH_REQUIRE(v::num_partitions(parameters, 1000, 100) == 3);
+        // The memory budget requires more partitions. The 8000 bytes of partition
+        // assignments leave room for partitions of 420 vectors.
+        parameters.memory_budget(50'000);
+        CATCH_REQUIRE(v::partition_assignment_bytes(1000, 2) == 8000);
+        CATCH_REQUIRE(v::max_partition_size(parameters, 1000, 100) == 420);
+        CATCH_REQUIRE(v::num_partitions(parameters, 1000, 100) == 5);
+        // There are never more partitions than vectors.
+        CATCH_REQUIRE(v::num_partitions(parameters, 2, 100) == 2);
+        CATCH_REQUIRE(
+            (v::partition_bytes_per_vector<float, uint32_t>(dims, 32)) ==
+            dims * sizeof(float) + 33 * sizeof(uint32_t) + sizeof(svs::SpinLock)
+        );
+
+        // Budgets too small for the assignments and one vector are rejected.
+        parameters.memory_budget(8050);
+        CATCH_REQUIRE_THROWS_AS(
+            v::num_partitions(parameters, 1000, 100), svs::ANNException
+        );
+        // Without a budget, partitions are not limited.
+        parameters.memory_budget(0);
+        CATCH_REQUIRE(v::max_partition_size(parameters, 1000, 100) == 0);
+    }
+
+    CATCH_SECTION("Memory Budget") {
+        // Concentrate most vectors in a dense blob so k-means yields unbalanced
+        // partitions.
+        auto skewed = synthetic::copy(data);
+        for (size_t i = 0; i < 2400; ++i) {
+            for (auto& x : skewed.get_datum(i)) {
+                x *= 0.01f;
+            }
+        }
+        const size_t bytes_per_vector = v::partition_bytes_per_vector<float>(dims, 24);
+        auto parameters = v::PartitionedBuildParameters().num_partitions(2).overlap(2);
+        parameters.memory_budget(
+            v::partition_assignment_bytes(skewed.size(), 2) + 500 * bytes_per_vector
+        );
+        size_t max_size =
+            v::max_partition_size(parameters, skewed.size(), bytes_per_vector);
+        CATCH_REQUIRE(max_size == 500);
+
+        auto check = [&](const auto& partitioning, size_t num_vectors, size_t overlap) {
+            auto counts = std::vector<size_t>(num_vectors, 0);
+            for (size_t p = 0; p < partitioning.size(); ++p) {
+                auto members = partitioning.partition(p);
+                CATCH_REQUIRE(!members.empty());
+                // Every partition fits in the budget next to the assignments.
+                CATCH_REQUIRE(
+                    members.size() * bytes_per_vector +
+                        v::partition_assignment_bytes(num_vectors, overlap) <=
+                    parameters.memory_budget_
+                );
+                CATCH_REQUIRE(std::is_sorted(members.begin(), members.end()));
+                CATCH_REQUIRE(
+                    std::adjacent_find(members.begin(), members.end()) == members.end()
+                );
+                for (auto i : members) {
+                    ++counts.at(i);
+                }
+            }
+            CATCH_REQUIRE(std::all_of(counts.begin(), counts.end(), [&](size_t c) {
+                return c == overlap;
+            }));
+        };
+
+        auto count = v::num_partitions(parameters, skewed.size(), bytes_per_vector);
+        auto partitioning = v::partition_dataset(skewed, count, 2, threadpool, max_size);
+        CATCH_REQUIRE(partitioning.size() >= count);
+        check(partitioning, skewed.size(), 2);
+
+        // Vectors k-means cannot separate are split into runs.
+        auto same = svs::data::SimpleData<float>(1200, dims);
+        for (size_t i = 0; i < same.size(); ++i) {
+            same.set_datum(i, data.get_datum(0));
+        }
+        partitioning = v::partition_dataset(same, 1, 1, threadpool, max_size);
+        CATCH_REQUIRE(partitioning.size() == 3);
+        check(partitioning, same.size(), 1);
+    }
+
+    CATCH_SECTION("Partitioning") {
+        auto partitioning = v::partition_dataset(data, 8, 2, threadpool);
+        CATCH_REQUIRE(partitioning.size() == 8);
+        CATCH_REQUIRE(partitioning.members.size() == 2 * data.size());
+
+        // Each vector belongs to exactly two distinct partitions.
+        auto counts = std::vector<size_t>(data.size(), 0);
+        for (size_t p = 0; p < partitioning.size(); ++p) {
+            auto members = partitioning.partition(p);
+            CATCH_REQUIRE(!members.empty());
+            CATCH_REQUIRE(std::is_sorted(members.begin(), members.end()));
+            CATCH_REQUIRE(
+                std::adjacent_find(members.begin(), members.end()) == members.end()
+            );
+            for (auto i : members) {
+                ++counts.at(i);
+            }
+        }
+        CATCH_REQUIRE(std::all_of(counts.begin(), counts.end(), [](size_t c) {
+            return c == 2;
+        }));
+
+        // The overlap is limited by the number of partitions.
+        partitioning = v::partition_dataset(data, 1, 3, threadpool);
+        CATCH_REQUIRE(partitioning.size() == 1);
+        CATCH_REQUIRE(partitioning.members.size() == data.size());
+    }
+
+    CATCH_SECTION("Build") {
+        svs_test::prepare_temp_directory();
+        auto spill = svs_test::temp_directory() / "spill";
+        auto build_parameters = synthetic::build_parameters();
+        auto partition_parameters =
+            v::PartitionedBuildParameters().num_partitions(4).overlap(2).spill_directory(
+                spill
+            );
+
+        auto graph = v::build_partitioned_graph(
+            build_parameters, partition_parameters, data, svs::DistanceL2(), threadpool
+        );
+        CATCH_REQUIRE(graph.n_nodes() == data.size());
+        for (size_t i = 0; i < graph.n_nodes(); ++i) {
+            auto neighbors = graph.get_node(i);
+            CATCH_REQUIRE(!neighbors.empty());
+            CATCH_REQUIRE(neighbors.size() <= 24);
+            CATCH_REQUIRE(
+                std::find(neighbors.begin(), neighbors.end(), i) == neighbors.end()
+            );
+        }
+        // Partition graphs are removed once merged.
+        CATCH_REQUIRE(std::filesystem::is_empty(spill));
+
+        // The merged index is comparable to an index built in one pass.
+        auto groundtruth = synthetic::groundtruth(data, queries, num_neighbors);
+        auto index = v::auto_build_partitioned(
+            build_parameters,
+            partition_parameters,
+            synthetic::copy(data),
+            svs::DistanceL2(),
+            2
+        );
+        CATCH_REQUIRE(index.size() == data.size());
+        CATCH_REQUIRE(index.get_alpha() == build_parameters.alpha);
+
+        auto results = svs::QueryResult<size_t>(queries.size(), num_neighbors);
+        index.search(
+            results.view(), queries.cview(), v::VamanaSearchParameters().buffer_config(40)
+        );
+        CATCH_REQUIRE(svs::k_recall_at_n(groundtruth, results) > 0.9);
+
+        // A spill directory is required.
+        CATCH_REQUIRE_THROWS_AS(
+            v::build_partitioned_graph(
+                build_parameters,
+                v::PartitionedBuildParameters(),
+                data,
+                svs::DistanceL2(),
+                threadpool
+            ),
+            svs::ANNException
+        );
+    }
+}
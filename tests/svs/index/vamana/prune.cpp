@@ -12,9 +12,45 @@
 // header under test
 #include "svs/index/vamana/prune.h"
 
+// svs
+#include "svs/core/data/simple.h"
+
 // catch2
 #include "catch2/catch_test_macros.hpp"
 
+// stl
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+template <typename Strategy, typename... Constraint>
+std::vector<uint32_t> prune_line(Strategy strategy, const Constraint&... can_prune) {
+    // Vector 0 is the node being pruned. Vectors 1 and 2 lie on a line on the same side.
+    auto data = svs::data::SimpleData<float>(3, 1);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data.get_datum(i)[0] = static_cast<float>(i);
+    }
+    auto distance = svs::distance::DistanceL2();
+    auto pool = std::vector<svs::Neighbor<uint32_t>>{{1, 1.0f}, {2, 4.0f}};
+    auto result = std::vector<uint32_t>();
+    svs::index::vamana::heuristic_prune_neighbors(
+        strategy,
+        2,
+        1.0f,
+        data,
+        svs::data::GetDatumAccessor(),
+        distance,
+        0,
+        svs::lib::as_const_span(pool),
+        result,
+        can_prune...
+    );
+    return result;
+}
+
+} // namespace
+
 CATCH_TEST_CASE("Pruning", "[index][vamana]") {
     namespace v = svs::index::vamana;
     // Protect against changes to the default strategies getting merged.
@@ -41,4 +77,25 @@ CATCH_TEST_CASE("Pruning", "[index][vamana]") {
             CATCH_REQUIRE(v::excluded(v::PruneState::Pruned) == true);
         }
     }
+
+    CATCH_SECTION("Label Preserving Constraint") {
+        // Vector 1 prunes vector 2 unless vector 2 shares a label with vector 0 that
+        // vector 1 does not carry.
+        auto labels = v::VectorLabels({{0}, {1}, {0}});
+        auto constraint = v::LabelPreservingPrune{labels};
+        auto unrelated = v::VectorLabels({{0}, {0, 1}, {0}});
+        auto covered = v::LabelPreservingPrune{unrelated};
+
+        auto check = [&](auto strategy) {
+            CATCH_REQUIRE(prune_line(strategy) == std::vector<uint32_t>{1});
+            CATCH_REQUIRE(
+                prune_line(strategy, v::UnconstrainedPrune()) == std::vector<uint32_t>{1}
+            );
+            CATCH_REQUIRE(prune_line(strategy, constraint) == std::vector<uint32_t>{1, 2});
+            CATCH_REQUIRE(prune_line(strategy, covered) == std::vector<uint32_t>{1});
+        };
+        check(v::IterativePruneStrategy());
+        check(v::ProgressivePruneStrategy());
+        check(v::LegacyPruneStrategy());
+    }
 }
@@ -0,0 +1,128 @@
+/**
+ *    Copyright (C) 2023, Intel Corporation
+ *
+ *    You can redistribute and/or modify this software under the terms of the
+ *    GNU Affero General Public License version 3.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    version 3 along with this software. If not, see
+ *    <https://www.gnu.org/licenses/agpl-3.0.en.html>.
+ */
+
+// header under test
+#include "svs/index/vamana/reorder.h"
+
+// svs
+#include "svs/core/graph.h"
+
+// catch2
+#include "catch2/catch_test_macros.hpp"
+
+// stl
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace {
+
+using Graph = svs::graphs::SimpleGraph<uint32_t>;
+
+Graph make_graph(size_t num_nodes, const std::vector<std::vector<uint32_t>>& adjacency) {
+    auto graph = Graph(num_nodes, 4);
+    for (size_t i = 0; i < adjacency.size(); ++i) {
+        graph.replace_node(i, adjacency[i]);
+    }
+    return graph;
+}
+
+bool is_permutation(std::vector<uint32_t> order, size_t size) {
+    auto expected = std::vector<uint32_t>(size);
+    std::iota(expected.begin(), expected.end(), 0);
+    std::sort(order.begin(), order.end());
+    return order == expected;
+}
+
+} // namespace
+
+CATCH_TEST_CASE("Graph Ordering", "[index][vamana][reorder]") {
+    namespace v = svs::index::vamana;
+
+    CATCH_SECTION("Names") {
+        for (auto ordering :
+             {v::GraphOrdering::BreadthFirst,
+              v::GraphOrdering::ReverseCuthillMcKee,
+              v::GraphOrdering::Gorder}) {
+            CATCH_REQUIRE(v::parse_graph_ordering(v::name(ordering)) == ordering);
+        }
+        CATCH_REQUIRE_THROWS_AS(v::parse_graph_ordering("random"), svs::ANNException);
+    }
+
+    // Vertices 0 to 5 form a tree rooted at 4 and vertex 6 is unreachable.
+    auto graph = make_graph(7, {{}, {0}, {1, 5}, {}, {2, 3}, {}, {4}});
+    auto roots = std::vector<uint32_t>{4};
+
+    CATCH_SECTION("Breadth First") {
+        auto order = v::breadth_first_order(graph, std::span<const uint32_t>(roots));
+        CATCH_REQUIRE(order == std::vector<uint32_t>{4, 2, 3, 1, 5, 0, 6});
+
+        // Without roots, traversals start in increasing ID order.
+        order = v::breadth_first_order(graph, std::span<const uint32_t>());
+        CATCH_REQUIRE(order == std::vector<uint32_t>{0, 1, 2, 5, 3, 4, 6});
+    }
+
+    CATCH_SECTION("Reverse Cuthill-McKee") {
+        // Traversals start from vertices 0, 3, 5, 1 and 6 in order of increasing degree.
+        // Vertices 4 and 2 are reached from 6.
+        auto order = v::reverse_cuthill_mckee_order(graph);
+        CATCH_REQUIRE(order == std::vector<uint32_t>{2, 4, 6, 1, 5, 3, 0});
+    }
+
+    CATCH_SECTION("Gorder") {
+        // Two groups of mutually connected vertices joined by a single edge. Gorder keeps
+        // each group contiguous.
+        auto clusters = make_graph(
+            8,
+            {{2, 4, 6},
+             {3, 5, 7},
+             {0, 4, 6},
+             {1, 5, 7},
+             {0, 2, 6},
+             {1, 3, 7},
+             {0, 2, 4, 1},
+             {1, 3, 5}}
+        );
+        auto order = v::gorder(clusters, 0, 2);
+        CATCH_REQUIRE(is_permutation(order, 8));
+        CATCH_REQUIRE(order.front() == 0);
+        for (size_t i = 0; i < 4; ++i) {
+            CATCH_REQUIRE(order[i] % 2 == 0);
+        }
+
+        CATCH_REQUIRE_THROWS_AS(v::gorder(clusters, 8), svs::ANNException);
+    }
+
+    CATCH_SECTION("Random Graphs") {
+        auto rng = std::mt19937(0xdead);
+        auto ids = std::uniform_int_distribution<uint32_t>(0, 99);
+        auto random = Graph(100, 8);
+        for (uint32_t i = 0; i < 100; ++i) {
+            for (size_t j = 0; j < i % 9; ++j) {
+                random.add_edge(i, ids(rng));
+            }
+        }
+        for (auto ordering :
+             {v::GraphOrdering::BreadthFirst,
+              v::GraphOrdering::ReverseCuthillMcKee,
+              v::GraphOrdering::Gorder}) {
+            auto order = v::compute_graph_ordering(
+                random, std::span<const uint32_t>(roots), ordering
+            );
+            CATCH_REQUIRE(is_permutation(order, 100));
+            if (ordering != v::GraphOrdering::ReverseCuthillMcKee) {
+                CATCH_REQUIRE(order.front() == roots.front());
+            }
+        }
+    }
+}
@@ -12,6 +12,7 @@
 // svs
 #include "svs/index/vamana/search_buffer.h"
 #include "svs/index/vamana/dynamic_search_buffer.h"
+#include "svs/index/vamana/vectorized_search_buffer.h"
 
 // tests
 #include "tests/utils/generators.h"
@@ -25,7 +26,9 @@
 // stdlib
 #include <cstdint>
 #include <functional>
+#include <random>
 #include <type_traits>
+#include <vector>
 
 namespace vamana = svs::index::vamana;
 
@@ -291,6 +294,28 @@ template <typename Buffer> void test_visited_set_interface() {
         CATCH_REQUIRE(x.is_visited(i) == false);
     }
 
+    // Switch to the exact visited set.
+    x.enable_exact_visited_set();
+    CATCH_REQUIRE(x.visited_set_enabled() == true);
+    CATCH_REQUIRE(x.exact_visited_set_enabled() == true);
+    // Use IDs that alias in the default visited set.
+    for (int i = 0; i < 10; ++i) {
+        CATCH_REQUIRE(x.emplace_visited(i << 16) == false);
+    }
+    for (int i = 0; i < 10; ++i) {
+        CATCH_REQUIRE(x.is_visited(i << 16) == true);
+    }
+    CATCH_REQUIRE(x.shallow_copy().exact_visited_set_enabled() == true);
+    x.clear();
+    for (int i = 0; i < 10; ++i) {
+        CATCH_REQUIRE(x.is_visited(i << 16) == false);
+    }
+    x.enable_visited_set();
+    CATCH_REQUIRE(x.exact_visited_set_enabled() == false);
+    CATCH_REQUIRE(x.visited_set_enabled() == true);
+    auto y = Buffer{svs::index::vamana::SearchBufferConfig{10}, {}, true, true};
+    CATCH_REQUIRE(y.exact_visited_set_enabled() == true);
+
     // Make sure we can go the other way and disable the visited set once it has been
     // enabled.
     x.disable_visited_set();
@@ -535,6 +560,24 @@ CATCH_TEST_CASE("Testing Search Buffer", "[core][search_buffer]") {
         CATCH_REQUIRE(eq(buffer2[2], {2, 10}));
     }
 
+    CATCH_SECTION("Truncate") {
+        buffer.push_back({1, 10});
+        buffer.push_back({2, 20});
+        buffer.push_back({3, 30});
+        buffer.truncate(5);
+        CATCH_REQUIRE(buffer.size() == 3);
+
+        // Modify a prefix and keep only that.
+        buffer[0].set_distance(25);
+        buffer.truncate(2);
+        CATCH_REQUIRE(buffer.size() == 2);
+        CATCH_REQUIRE(buffer.best_unvisited() <= 2);
+        buffer.sort();
+        CATCH_REQUIRE(eq(buffer[0], {2, 20}));
+        CATCH_REQUIRE(eq(buffer[1], {1, 25}));
+        CATCH_REQUIRE(eq(buffer.back(), {1, 25}));
+    }
+
     CATCH_SECTION("Visited Set") {
         test_visited_set_interface<svs::index::vamana::SearchBuffer<uint32_t>>();
         test_visited_set_interface<svs::index::vamana::MutableBuffer<uint32_t>>();
@@ -558,6 +601,46 @@ CATCH_TEST_CASE("Testing Search Buffer", "[core][search_buffer]") {
         CATCH_REQUIRE(x.size() == 2);
     }
 
+    CATCH_SECTION("Growing") {
+        // Growing preserves the contents and search state.
+        auto x = svs::index::vamana::SearchBuffer<uint32_t>(3);
+        x.insert({0, 1.0});
+        x.insert({1, 2.0});
+        x.insert({2, 3.0});
+        CATCH_REQUIRE(x.next().id() == 0);
+        CATCH_REQUIRE(x.next().id() == 1);
+        CATCH_REQUIRE(x.next().id() == 2);
+        CATCH_REQUIRE(x.done());
+        CATCH_REQUIRE(x.full());
+
+        x.grow(5);
+        CATCH_REQUIRE(x.capacity() == 5);
+        CATCH_REQUIRE(x.config().get_search_window_size() == 5);
+        CATCH_REQUIRE(x.size() == 3);
+        CATCH_REQUIRE(x.done());
+        x.insert({4, 5.0});
+        x.insert({3, 4.0});
+        CATCH_REQUIRE(x.size() == 5);
+        CATCH_REQUIRE(!x.done());
+        CATCH_REQUIRE(x.next().id() == 3);
+        CATCH_REQUIRE(x.next().id() == 4);
+        CATCH_REQUIRE(x.done());
+
+        // Visited candidates beyond the old search window are skipped.
+        auto y = svs::index::vamana::SearchBuffer<uint32_t>({1, 3});
+        y.insert({0, 2.0});
+        CATCH_REQUIRE(y.next().id() == 0);
+        y.insert({1, 1.0});
+        y.insert({2, 3.0});
+        CATCH_REQUIRE(y.next().id() == 1);
+        CATCH_REQUIRE(y.done());
+        y.grow(3);
+        CATCH_REQUIRE(!y.done());
+        CATCH_REQUIRE(y.best_unvisited() == 2);
+        CATCH_REQUIRE(y.next().id() == 2);
+        CATCH_REQUIRE(y.done());
+    }
+
     CATCH_SECTION("Shallow Copy") {
         auto x = svs::index::vamana::SearchBuffer<uint32_t>(10);
         CATCH_REQUIRE(svs::threads::shallow_copyable_v<decltype(x)>);
@@ -606,6 +689,133 @@ CATCH_TEST_CASE("Fuzzing", "[core][search_buffer]") {
     CATCH_SECTION("Greater") { run_test(std::greater<>()); }
 }
 
+///
+/// Vectorized Search Buffer
+///
+
+namespace {
+
+// Apply the same random operations to a `VectorizedSearchBuffer` and a `SearchBuffer` and
+// check that they stay identical.
+template <typename Cmp> void test_vectorized_against_reference(size_t capacity) {
+    auto config = svs::index::vamana::SearchBufferConfig{capacity / 2 + 1, capacity};
+    auto x = svs::index::vamana::VectorizedSearchBuffer<uint32_t, Cmp>{config};
+    auto y = svs::index::vamana::SearchBuffer<uint32_t, Cmp>{config};
+
+    auto rng = std::mt19937_64(capacity);
+    // Derive distances from IDs so that repeated IDs have the same distance. Using few
+    // distinct distances exercises ties between different IDs.
+    auto id = std::uniform_int_distribution<uint32_t>(0, 300);
+    auto eq = svs::NeighborEqual();
+
+    auto check = [&]() {
+        CATCH_REQUIRE(x.size() == y.size());
+        CATCH_REQUIRE(x.best_unvisited() == y.best_unvisited());
+        CATCH_REQUIRE(x.done() == y.done());
+        for (size_t i = 0; i < x.size(); ++i) {
+            CATCH_REQUIRE(eq(x[i], y[i]));
+        }
+    };
+
+    for (size_t trial = 0; trial < 10; ++trial) {
+        x.clear();
+        y.clear();
+        for (size_t i = 0; i < 3; ++i) {
+            auto j = id(rng);
+            x.push_back({j, static_cast<float>(j % 101)});
+            y.push_back({j, static_cast<float>(j % 101)});
+        }
+        x.sort();
+        y.sort();
+        check();
+        while (!y.done()) {
+            CATCH_REQUIRE(eq(x.next(), y.next()));
+            for (size_t i = 0; i < 8; ++i) {
+                auto j = id(rng);
+                auto d = static_cast<float>(j % 101);
+                CATCH_REQUIRE(x.insert({j, d}) == y.insert({j, d}));
+            }
+            check();
+        }
+        CATCH_REQUIRE(x.done());
+    }
+}
+
+} // namespace
+
+CATCH_TEST_CASE("Vectorized Search Buffer", "[core][search_buffer]") {
+    using buffer_type = svs::index::vamana::VectorizedSearchBuffer<uint32_t>;
+    svs::NeighborEqual eq{};
+
+    CATCH_SECTION("Basic Behavior") {
+        auto buffer = buffer_type{3};
+        CATCH_REQUIRE(buffer.size() == 0);
+        CATCH_REQUIRE(buffer.capacity() == 3);
+        CATCH_REQUIRE(buffer.insert({1, 10}) == 0);
+        CATCH_REQUIRE(buffer.insert({2, 5}) == 0);
+        CATCH_REQUIRE(buffer.insert({3, 10}) == 2);
+        // Duplicate IDs are rejected.
+        CATCH_REQUIRE(buffer.insert({1, 10}) == buffer.size() + 1);
+        CATCH_REQUIRE(buffer.full());
+        // Candidates further than the last entry of a full buffer are skipped.
+        CATCH_REQUIRE(buffer.insert({4, 20}) == buffer.size());
+        CATCH_REQUIRE(eq(buffer[0], {2, 5}));
+        CATCH_REQUIRE(eq(buffer[1], {1, 10}));
+        CATCH_REQUIRE(eq(buffer[2], {3, 10}));
+        CATCH_REQUIRE(eq(buffer.back(), {3, 10}));
+
+        CATCH_REQUIRE(eq(buffer.next(), {2, 5, true}));
+        CATCH_REQUIRE(buffer[0].visited());
+        CATCH_REQUIRE(buffer.best_unvisited() == 1);
+        // Inserting ahead of the best unvisited candidate moves it back.
+        CATCH_REQUIRE(buffer.insert({5, 1}) == 0);
+        CATCH_REQUIRE(buffer.best_unvisited() == 0);
+        CATCH_REQUIRE(eq(buffer[1], {2, 5, true}));
+        CATCH_REQUIRE(eq(buffer[2], {1, 10}));
+
+        buffer.truncate(2);
+        CATCH_REQUIRE(buffer.size() == 2);
+        buffer.grow(4);
+        CATCH_REQUIRE(buffer.capacity() == 4);
+        CATCH_REQUIRE(buffer.size() == 2);
+
+        buffer.clear();
+        CATCH_REQUIRE(buffer.size() == 0);
+        buffer.push_back({1, 100});
+        buffer.push_back({2, 10});
+        buffer.push_back({3, 50});
+        buffer.sort();
+        CATCH_REQUIRE(eq(buffer[0], {2, 10}));
+        CATCH_REQUIRE(eq(buffer[1], {3, 50}));
+        CATCH_REQUIRE(eq(buffer[2], {1, 100}));
+    }
+
+    CATCH_SECTION("Visited Set") { test_visited_set_interface<buffer_type>(); }
+
+    CATCH_SECTION("Against Reference") {
+        // Cover sizes smaller than, equal to, and not a multiple of the SIMD widths.
+        for (size_t capacity : {1, 5, 8, 16, 17, 33, 100, 256}) {
+            test_vectorized_against_reference<std::less<>>(capacity);
+            test_vectorized_against_reference<std::greater<>>(capacity);
+        }
+    }
+
+    CATCH_SECTION("Fuzzing") {
+        auto setup = FuzzSetup{5, 1000, 32, 32, 0xc0ffee, false};
+        auto buffer = buffer_type{svs::index::vamana::SearchBufferConfig{32, 32}};
+        fuzz_test(buffer, setup);
+        setup.valid_capacity = 64;
+        buffer.change_maxsize(svs::index::vamana::SearchBufferConfig{32, 64});
+        fuzz_test(buffer, setup);
+
+        auto greater = svs::index::vamana::VectorizedSearchBuffer<uint32_t, std::greater<>>{
+            svs::index::vamana::SearchBufferConfig{48, 80}};
+        setup.roi_size = 48;
+        setup.valid_capacity = 80;
+        fuzz_test(greater, setup);
+    }
+}
+
 ///
 /// Mutable Buffer
 ///
@@ -685,6 +895,64 @@ CATCH_TEST_CASE("MutableBuffer", "[core][search_buffer]") {
         CATCH_REQUIRE(eq(buffer[4], {0, 100, true}));
     }
 
+    CATCH_SECTION("Truncate") {
+        buffer.insert({0, 10, true});
+        buffer.insert({1, 20, false});
+        buffer.insert({2, 30, true});
+        buffer.insert({3, 40, true});
+        CATCH_REQUIRE(buffer.size() == 4);
+        CATCH_REQUIRE(buffer.valid() == 3);
+
+        buffer.truncate(10);
+        CATCH_REQUIRE(buffer.size() == 4);
+
+        buffer.cleanup();
+        CATCH_REQUIRE(buffer.size() == 3);
+        buffer[0].set_distance(35);
+        buffer.truncate(2);
+        CATCH_REQUIRE(buffer.size() == 2);
+        CATCH_REQUIRE(buffer.valid() == 2);
+        CATCH_REQUIRE(buffer.best_unvisited() <= 2);
+        buffer.sort();
+        CATCH_REQUIRE(eq(buffer[0], {2, 30, true}));
+        CATCH_REQUIRE(eq(buffer[1], {0, 35, true}));
+    }
+
+    CATCH_SECTION("Growing") {
+        buffer.insert({0, 10, true});
+        buffer.insert({1, 20, false});
+        buffer.insert({2, 30, true});
+        buffer.insert({3, 40, true});
+        buffer.insert({4, 50, true});
+        CATCH_REQUIRE(buffer.full());
+        while (!buffer.done()) {
+            buffer.next();
+        }
+
+        // Candidates are preserved and the invalid candidate is still navigable.
+        buffer.grow(6);
+        CATCH_REQUIRE(buffer.config().get_search_window_size() == 6);
+        CATCH_REQUIRE(buffer.target() == 6);
+        CATCH_REQUIRE(!buffer.full());
+        CATCH_REQUIRE(buffer.size() == 5);
+        CATCH_REQUIRE(buffer.done());
+
+        buffer.insert({5, 5, true});
+        buffer.insert({6, 60, true});
+        CATCH_REQUIRE(buffer.full());
+        CATCH_REQUIRE(!buffer.done());
+        CATCH_REQUIRE(buffer.next().id() == 5);
+        CATCH_REQUIRE(buffer.next().id() == 6);
+        CATCH_REQUIRE(buffer.done());
+
+        buffer.cleanup();
+        auto ids = std::vector<uint32_t>{};
+        for (const auto& neighbor : buffer) {
+            ids.push_back(neighbor.id());
+        }
+        CATCH_REQUIRE(ids == std::vector<uint32_t>{5, 0, 2, 3, 4, 6});
+    }
+
     // One behavior of the MutableBuffer is that it will continue to acrue candidates until
     // the target number of valid candidates is achieved.
     //
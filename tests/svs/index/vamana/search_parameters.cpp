@@ -31,8 +31,59 @@ search_buffer_visited_set = true
 search_window_size = 50
 )";
 
+std::string_view v0_0_1 = R"(
+__schema__ = 'vamana_search_parameters'
+__version__ = 'v0.0.1'
+prefetch_lookahead = 8
+prefetch_step = 2
+search_buffer_capacity = 100
+search_buffer_visited_set = false
+search_window_size = 50
+)";
+
+std::string_view v0_0_2 = R"(
+__schema__ = 'vamana_search_parameters'
+__version__ = 'v0.0.2'
+prefetch_lookahead = 8
+prefetch_step = 2
+rerank_depth = 30
+search_buffer_capacity = 100
+search_buffer_visited_set = false
+search_window_size = 50
+)";
+
+std::string_view v0_0_3 = R"(
+__schema__ = 'vamana_search_parameters'
+__version__ = 'v0.0.3'
+interleave = 4
+prefetch_lookahead = 8
+prefetch_step = 2
+rerank_depth = 30
+search_buffer_capacity = 100
+search_buffer_visited_set = false
+search_window_size = 50
+)";
+
+std::string_view v0_0_4 = R"(
+__schema__ = 'vamana_search_parameters'
+__version__ = 'v0.0.4'
+early_termination_patience = 12
+early_termination_ratio = 1.5
+interleave = 4
+prefetch_lookahead = 8
+prefetch_step = 2
+rerank_depth = 30
+search_buffer_capacity = 100
+search_buffer_visited_set = true
+search_window_size = 50
+)";
+
 const size_t DEFAULT_PREFETCH_LOOKAHEAD = 4;
 const size_t DEFAULT_PREFETCH_STEP = 1;
+const size_t DEFAULT_RERANK_DEPTH = 0;
+const size_t DEFAULT_INTERLEAVE = 1;
+const size_t DEFAULT_EARLY_TERMINATION_PATIENCE = 0;
+const float DEFAULT_EARLY_TERMINATION_RATIO = 0;
 
 } // namespace
 
@@ -44,6 +95,11 @@ CATCH_TEST_CASE("VamanaSearcmParameters", "[index][vamana]") {
         CATCH_REQUIRE(p.search_buffer_visited_set_ == false);
         CATCH_REQUIRE(p.prefetch_lookahead_ == DEFAULT_PREFETCH_LOOKAHEAD);
         CATCH_REQUIRE(p.prefetch_step_ == DEFAULT_PREFETCH_STEP);
+        CATCH_REQUIRE(p.rerank_depth_ == DEFAULT_RERANK_DEPTH);
+        CATCH_REQUIRE(p.interleave_ == DEFAULT_INTERLEAVE);
+        CATCH_REQUIRE(p.early_termination_patience_ == DEFAULT_EARLY_TERMINATION_PATIENCE);
+        CATCH_REQUIRE(p.early_termination_ratio_ == DEFAULT_EARLY_TERMINATION_RATIO);
+        CATCH_REQUIRE(p.search_buffer_exact_visited_set_ == false);
 
         CATCH_REQUIRE(p.buffer_config(10) == p);
         CATCH_REQUIRE(p.buffer_config_ == svs::index::vamana::SearchBufferConfig{10, 10});
@@ -56,6 +112,26 @@ CATCH_TEST_CASE("VamanaSearcmParameters", "[index][vamana]") {
 
         CATCH_REQUIRE(p.prefetch_step(5) == p);
         CATCH_REQUIRE(p.prefetch_step_ == 5);
+
+        // Rerank depth of zero means "rerank everything".
+        CATCH_REQUIRE(p.effective_rerank_depth(10) == 0);
+        CATCH_REQUIRE(p.rerank_depth(20) == p);
+        CATCH_REQUIRE(p.rerank_depth_ == 20);
+        CATCH_REQUIRE(p.effective_rerank_depth(10) == 20);
+        // Never rerank fewer than the requested number of neighbors.
+        CATCH_REQUIRE(p.effective_rerank_depth(50) == 50);
+
+        CATCH_REQUIRE(p.interleave(8) == p);
+        CATCH_REQUIRE(p.interleave_ == 8);
+
+        CATCH_REQUIRE(p.early_termination_patience(16) == p);
+        CATCH_REQUIRE(p.early_termination_patience_ == 16);
+
+        CATCH_REQUIRE(p.early_termination_ratio(1.5f) == p);
+        CATCH_REQUIRE(p.early_termination_ratio_ == 1.5f);
+
+        CATCH_REQUIRE(p.search_buffer_exact_visited_set(true) == p);
+        CATCH_REQUIRE(p.search_buffer_exact_visited_set_ == true);
     }
 
     // Serialization.
@@ -65,6 +141,18 @@ CATCH_TEST_CASE("VamanaSearcmParameters", "[index][vamana]") {
 
         auto p = VamanaSearchParameters{{10, 20}, true, 10, 5};
         CATCH_REQUIRE(svs::lib::test_self_save_load(p, temp_directory));
+
+        p = VamanaSearchParameters{{10, 20}, false, 2, 1, 15};
+        CATCH_REQUIRE(svs::lib::test_self_save_load(p, temp_directory));
+
+        p = VamanaSearchParameters{{10, 20}, false, 2, 1, 15, 8};
+        CATCH_REQUIRE(svs::lib::test_self_save_load(p, temp_directory));
+
+        p = VamanaSearchParameters{{10, 20}, false, 2, 1, 15, 8, 32, 1.25f};
+        CATCH_REQUIRE(svs::lib::test_self_save_load(p, temp_directory));
+
+        p = VamanaSearchParameters{{10, 20}, true, 2, 1, 15, 8, 32, 1.25f, true};
+        CATCH_REQUIRE(svs::lib::test_self_save_load(p, temp_directory));
     }
 
     CATCH_SECTION("Loading Legacy Objects") {
@@ -79,6 +167,85 @@ CATCH_TEST_CASE("VamanaSearcmParameters", "[index][vamana]") {
             CATCH_REQUIRE(p.search_buffer_visited_set_ == true);
             CATCH_REQUIRE(p.prefetch_lookahead_ == DEFAULT_PREFETCH_LOOKAHEAD);
             CATCH_REQUIRE(p.prefetch_step_ == DEFAULT_PREFETCH_STEP);
+            CATCH_REQUIRE(p.rerank_depth_ == DEFAULT_RERANK_DEPTH);
+            CATCH_REQUIRE(p.interleave_ == DEFAULT_INTERLEAVE);
+            CATCH_REQUIRE(
+                p.early_termination_patience_ == DEFAULT_EARLY_TERMINATION_PATIENCE
+            );
+            CATCH_REQUIRE(p.early_termination_ratio_ == DEFAULT_EARLY_TERMINATION_RATIO);
+        }
+
+        CATCH_SECTION("v0.0.1") {
+            auto table = toml::parse(v0_0_1);
+            auto p =
+                svs::lib::load<VamanaSearchParameters>(svs::lib::ContextFreeLoadTable(table)
+                );
+            CATCH_REQUIRE(
+                p.buffer_config_ == svs::index::vamana::SearchBufferConfig{50, 100}
+            );
+            CATCH_REQUIRE(p.search_buffer_visited_set_ == false);
+            CATCH_REQUIRE(p.prefetch_lookahead_ == 8);
+            CATCH_REQUIRE(p.prefetch_step_ == 2);
+            CATCH_REQUIRE(p.rerank_depth_ == DEFAULT_RERANK_DEPTH);
+            CATCH_REQUIRE(p.interleave_ == DEFAULT_INTERLEAVE);
+            CATCH_REQUIRE(
+                p.early_termination_patience_ == DEFAULT_EARLY_TERMINATION_PATIENCE
+            );
+            CATCH_REQUIRE(p.early_termination_ratio_ == DEFAULT_EARLY_TERMINATION_RATIO);
+        }
+
+        CATCH_SECTION("v0.0.2") {
+            auto table = toml::parse(v0_0_2);
+            auto p =
+                svs::lib::load<VamanaSearchParameters>(svs::lib::ContextFreeLoadTable(table)
+                );
+            CATCH_REQUIRE(
+                p.buffer_config_ == svs::index::vamana::SearchBufferConfig{50, 100}
+            );
+            CATCH_REQUIRE(p.search_buffer_visited_set_ == false);
+            CATCH_REQUIRE(p.prefetch_lookahead_ == 8);
+            CATCH_REQUIRE(p.prefetch_step_ == 2);
+            CATCH_REQUIRE(p.rerank_depth_ == 30);
+            CATCH_REQUIRE(p.interleave_ == DEFAULT_INTERLEAVE);
+            CATCH_REQUIRE(
+                p.early_termination_patience_ == DEFAULT_EARLY_TERMINATION_PATIENCE
+            );
+            CATCH_REQUIRE(p.early_termination_ratio_ == DEFAULT_EARLY_TERMINATION_RATIO);
+        }
+
+        CATCH_SECTION("v0.0.3") {
+            auto table = toml::parse(v0_0_3);
+            auto p =
+                svs::lib::load<VamanaSearchParameters>(svs::lib::ContextFreeLoadTable(table)
+                );
+            CATCH_REQUIRE(
+                p.buffer_config_ == svs::index::vamana::SearchBufferConfig{50, 100}
+            );
+            CATCH_REQUIRE(p.search_buffer_visited_set_ == false);
+            CATCH_REQUIRE(p.prefetch_lookahead_ == 8);
+            CATCH_REQUIRE(p.prefetch_step_ == 2);
+            CATCH_REQUIRE(p.rerank_depth_ == 30);
+            CATCH_REQUIRE(p.interleave_ == 4);
+            CATCH_REQUIRE(
+                p.early_termination_patience_ == DEFAULT_EARLY_TERMINATION_PATIENCE
+            );
+            CATCH_REQUIRE(p.early_termination_ratio_ == DEFAULT_EARLY_TERMINATION_RATIO);
+        }
+
+        CATCH_SECTION("v0.0.4") {
+            auto table = toml::parse(v0_0_4);
+            auto p =
+                svs::lib::load<VamanaSearchParameters>(svs::lib::ContextFreeLoadTable(table)
+                );
+            CATCH_REQUIRE(
+                p.buffer_config_ == svs::index::vamana::SearchBufferConfig{50, 100}
+            );
+            CATCH_REQUIRE(p.search_buffer_visited_set_ == true);
+            CATCH_REQUIRE(p.interleave_ == 4);
+            CATCH_REQUIRE(p.early_termination_patience_ == 12);
+            CATCH_REQUIRE(p.early_termination_ratio_ == 1.5f);
+            // Default parameters
+            CATCH_REQUIRE(p.search_buffer_exact_visited_set_ == false);
         }
     }
 }
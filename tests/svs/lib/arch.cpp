@@ -0,0 +1,48 @@
+/**
+ *    Copyright (C) 2023, Intel Corporation
+ *
+ *    You can redistribute and/or modify this software under the terms of the
+ *    GNU Affero General Public License version 3.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    version 3 along with this software. If not, see
+ *    <https://www.gnu.org/licenses/agpl-3.0.en.html>.
+ */
+
+// Header under test.
+#include "svs/lib/arch.h"
+
+// catch2
+#include "catch2/catch_test_macros.hpp"
+
+// stl
+#include <algorithm>
+
+CATCH_TEST_CASE("Architecture", "[lib][arch]") {
+    namespace arch = svs::arch;
+    CATCH_SECTION("Names") {
+        for (auto isa : arch::all_isas) {
+            CATCH_REQUIRE(arch::parse_isa(arch::name(isa)) == isa);
+        }
+        CATCH_REQUIRE_THROWS_AS(arch::parse_isa("sse"), svs::ANNException);
+        CATCH_REQUIRE(std::is_sorted(arch::all_isas.begin(), arch::all_isas.end()));
+    }
+
+    CATCH_SECTION("Detection") {
+        auto detected = arch::detect_isa();
+        CATCH_REQUIRE(arch::runtime_isa() <= detected);
+        CATCH_REQUIRE(arch::is_supported(arch::ISA::generic));
+        CATCH_REQUIRE(arch::is_supported(arch::runtime_isa()));
+
+        // Compiler flags enabling an extension imply the host supports it.
+        if (arch::have_avx512_f) {
+            CATCH_REQUIRE(detected >= arch::ISA::avx512f);
+        }
+        if (arch::have_avx512_vnni) {
+            CATCH_REQUIRE(detected >= arch::ISA::avx512vnni);
+        }
+        if (arch::have_avx512_bf16) {
+            CATCH_REQUIRE(detected == arch::ISA::avx512bf16);
+        }
+    }
+}
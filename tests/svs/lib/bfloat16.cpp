@@ -0,0 +1,110 @@
+/**
+ *    Copyright (C) 2023, Intel Corporation
+ *
+ *    You can redistribute and/or modify this software under the terms of the
+ *    GNU Affero General Public License version 3.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    version 3 along with this software. If not, see
+ *    <https://www.gnu.org/licenses/agpl-3.0.en.html>.
+ */
+
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+#include "svs/lib/bfloat16.h"
+#include "svs/lib/narrow.h"
+
+#include "catch2/catch_test_macros.hpp"
+
+CATCH_TEST_CASE("Testing BFloat16", "[core][bfloat16]") {
+    CATCH_SECTION("Implicit Conversion") {
+        svs::BFloat16 x{1.0f};
+        float y = x;
+        CATCH_REQUIRE(y == 1.0f);
+        CATCH_REQUIRE(x.raw() == 0x3F80);
+
+        x = svs::BFloat16{-1};
+        CATCH_REQUIRE(float{x} == -1.0f);
+
+        // Construct from `size_t`
+        x = svs::BFloat16{size_t{100}};
+        CATCH_REQUIRE(float{x} == 100.0f);
+
+        // Default Construction.
+        CATCH_REQUIRE(svs::BFloat16{} == svs::BFloat16(float{0}));
+
+        // Raw round trip.
+        CATCH_REQUIRE(svs::BFloat16::from_raw(0xC040).raw() == 0xC040);
+        CATCH_REQUIRE(float{svs::BFloat16::from_raw(0xC040)} == -3.0f);
+    }
+
+    CATCH_SECTION("Rounding") {
+        // Values representable in bfloat16 convert exactly.
+        for (float f : {0.0f, 0.5f, 1.5f, -2.0f, 256.0f, 3.0e38f}) {
+            auto truncated = std::bit_cast<float>(std::bit_cast<uint32_t>(f) & 0xFFFF0000);
+            CATCH_REQUIRE(float{svs::BFloat16{truncated}} == truncated);
+        }
+
+        // Round to nearest. Representable values around 256 are spaced 2 apart.
+        CATCH_REQUIRE(float{svs::BFloat16{258.0f}} == 258.0f);
+        CATCH_REQUIRE(float{svs::BFloat16{258.5f}} == 258.0f);
+        CATCH_REQUIRE(float{svs::BFloat16{259.5f}} == 260.0f);
+
+        // Ties go to even.
+        CATCH_REQUIRE(float{svs::BFloat16{257.0f}} == 256.0f);
+        CATCH_REQUIRE(float{svs::BFloat16{259.0f}} == 260.0f);
+        CATCH_REQUIRE(svs::BFloat16{std::bit_cast<float>(0x3F808000)}.raw() == 0x3F80);
+        CATCH_REQUIRE(svs::BFloat16{std::bit_cast<float>(0x3F818000)}.raw() == 0x3F82);
+
+        // Overflow rounds to infinity.
+        auto max = std::numeric_limits<float>::max();
+        auto inf = std::numeric_limits<float>::infinity();
+        CATCH_REQUIRE(std::isinf(float{svs::BFloat16{max}}));
+        CATCH_REQUIRE(std::isinf(float{svs::BFloat16{-inf}}));
+
+        // NaNs stay NaNs, even with payloads that would round to infinity.
+        auto nan = std::numeric_limits<float>::quiet_NaN();
+        CATCH_REQUIRE(std::isnan(float{svs::BFloat16{nan}}));
+        CATCH_REQUIRE(std::isnan(float{svs::BFloat16{std::bit_cast<float>(0x7F800001)}}));
+        CATCH_REQUIRE(std::isnan(float{svs::BFloat16{std::bit_cast<float>(0xFFFFFFFF)}}));
+    }
+
+    CATCH_SECTION("Arithmetic") {
+        CATCH_REQUIRE(svs::is_arithmetic_v<svs::BFloat16>);
+        CATCH_REQUIRE(svs::is_signed_v<svs::BFloat16>);
+        CATCH_REQUIRE(svs::allow_lossy_conversion<float, svs::BFloat16>);
+
+        auto x = svs::BFloat16{1};
+        auto y = svs::BFloat16{2};
+        CATCH_REQUIRE(x + y == 3);
+        CATCH_REQUIRE(x != y);
+        CATCH_REQUIRE(x < y);
+        CATCH_REQUIRE(!(y < x));
+        CATCH_REQUIRE(y - x == svs::BFloat16(1));
+
+        // Signed zeros compare equal.
+        CATCH_REQUIRE(svs::BFloat16{0.0f} == svs::BFloat16{-0.0f});
+    }
+
+    CATCH_SECTION("Narrow") {
+        float x_good{1.5f};
+        auto y_good = svs::lib::narrow<svs::BFloat16>(x_good);
+        CATCH_REQUIRE(float{y_good} == x_good);
+
+        // Only 8 significant bits are available.
+        float x_bad{1.0f + 1.0f / 1024.0f};
+        CATCH_REQUIRE_THROWS_AS(
+            svs::lib::narrow<svs::BFloat16>(x_bad), svs::lib::narrowing_error
+        );
+
+        // Lossy conversion is allowed when relaxed.
+        CATCH_REQUIRE(float{svs::lib::relaxed_narrow<svs::BFloat16>(x_bad)} == 1.0f);
+    }
+
+    CATCH_SECTION("Formatting") {
+        CATCH_REQUIRE(fmt::format("{}", svs::BFloat16{1.5f}) == "1.5bf16");
+    }
+}
@@ -0,0 +1,131 @@
+/**
+ *    Copyright (C) 2023, Intel Corporation
+ *
+ *    You can redistribute and/or modify this software under the terms of the
+ *    GNU Affero General Public License version 3.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    version 3 along with this software. If not, see
+ *    <https://www.gnu.org/licenses/agpl-3.0.en.html>.
+ */
+
+// Header under test.
+#include "svs/lib/block_file.h"
+
+// test utils
+#include "tests/utils/utils.h"
+
+// catch2
+#include "catch2/catch_test_macros.hpp"
+
+// stl
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+#include <vector>
+
+CATCH_TEST_CASE("Block File", "[lib][files]") {
+    svs_test::prepare_temp_directory();
+    auto path = svs_test::temp_directory() / "blocks.bin";
+    auto contents = std::vector<uint8_t>(3 * 4096);
+    std::iota(contents.begin(), contents.end(), 0);
+    {
+        auto stream = std::ofstream(path, std::ios_base::binary);
+        stream.write(
+            reinterpret_cast<const char*>(contents.data()),
+            static_cast<std::streamsize>(contents.size())
+        );
+    }
+
+    CATCH_SECTION("Reading") {
+        for (bool direct : {false, true}) {
+            auto file = svs::lib::BlockFile(path, direct);
+            CATCH_REQUIRE(file.is_open());
+            CATCH_REQUIRE(file.size() == contents.size());
+
+            auto buffer = svs::lib::AlignedBuffer(2 * 4096, 4096);
+            CATCH_REQUIRE(buffer.size() == 2 * 4096);
+            CATCH_REQUIRE(reinterpret_cast<uintptr_t>(buffer.data()) % 4096 == 0);
+            file.read(buffer.data(), buffer.size(), 4096);
+            CATCH_REQUIRE(
+                std::memcmp(buffer.data(), contents.data() + 4096, 2 * 4096) == 0
+            );
+
+            // Reading past the end fails.
+            CATCH_REQUIRE_THROWS_AS(
+                file.read(buffer.data(), 2 * 4096, 2 * 4096), svs::ANNException
+            );
+            // Partial reads stop at the end of the file.
+            CATCH_REQUIRE(file.read_some(buffer.data(), 2 * 4096, 2 * 4096) == 4096);
+            CATCH_REQUIRE(
+                std::memcmp(buffer.data(), contents.data() + 2 * 4096, 4096) == 0
+            );
+
+            // Moving transfers ownership of the file.
+            auto other = std::move(file);
+            CATCH_REQUIRE(!file.is_open());
+            CATCH_REQUIRE(other.is_open());
+            other.read(buffer.data(), 4096, 0);
+            CATCH_REQUIRE(std::memcmp(buffer.data(), contents.data(), 4096) == 0);
+        }
+    }
+
+    CATCH_SECTION("Batched Reading") {
+        for (bool direct : {false, true}) {
+            auto file = svs::lib::BlockFile(path, direct);
+            for (bool async : {false, true}) {
+                // A queue depth of 2 splits the batch into several submissions.
+                auto reader = svs::lib::BatchReader(2, async);
+                CATCH_REQUIRE(reader.queue_depth() == 2);
+                if (!async) {
+                    CATCH_REQUIRE(!reader.async());
+                }
+
+                auto buffer = svs::lib::AlignedBuffer(5 * 4096, 4096);
+                auto* base = buffer.data();
+                auto reads = std::vector<svs::lib::BlockRead>{
+                    {base, 4096, 2 * 4096},
+                    {base + 4096, 2 * 4096, 0},
+                    {base + 3 * 4096, 4096, 4096},
+                    {base + 4 * 4096, 4096, 2 * 4096}};
+                reader.read(file, reads);
+                for (const auto& r : reads) {
+                    CATCH_REQUIRE(
+                        std::memcmp(r.dst, contents.data() + r.offset, r.bytes) == 0
+                    );
+                }
+
+                // Reading past the end fails.
+                auto past_end = std::vector<svs::lib::BlockRead>{
+                    {base, 2 * 4096, 2 * 4096}, {base + 2 * 4096, 4096, 0}};
+                CATCH_REQUIRE_THROWS_AS(reader.read(file, past_end), svs::ANNException);
+
+                // The reader remains usable after a failed batch.
+                reader.read(file, reads);
+                for (const auto& r : reads) {
+                    CATCH_REQUIRE(
+                        std::memcmp(r.dst, contents.data() + r.offset, r.bytes) == 0
+                    );
+                }
+            }
+        }
+
+        // A default constructed reader reads sequentially.
+        auto file = svs::lib::BlockFile(path);
+        auto reader = svs::lib::BatchReader();
+        CATCH_REQUIRE(!reader.async());
+        CATCH_REQUIRE(reader.queue_depth() == 0);
+        auto buffer = svs::lib::AlignedBuffer(4096, 4096);
+        auto reads = std::vector<svs::lib::BlockRead>{{buffer.data(), 4096, 4096}};
+        reader.read(file, reads);
+        CATCH_REQUIRE(std::memcmp(buffer.data(), contents.data() + 4096, 4096) == 0);
+    }
+
+    CATCH_SECTION("Errors") {
+        CATCH_REQUIRE_THROWS_AS(
+            svs::lib::BlockFile(svs_test::temp_directory() / "missing.bin"),
+            svs::ANNException
+        );
+    }
+}
@@ -0,0 +1,80 @@
+/**
+ *    Copyright (C) 2023, Intel Corporation
+ *
+ *    You can redistribute and/or modify this software under the terms of the
+ *    GNU Affero General Public License version 3.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    version 3 along with this software. If not, see
+ *    <https://www.gnu.org/licenses/agpl-3.0.en.html>.
+ */
+
+// header under test
+#include "svs/lib/concurrency/seqlock.h"
+
+// catch2
+#include "catch2/catch_test_macros.hpp"
+
+// stl
+#include <array>
+#include <atomic>
+#include <thread>
+
+CATCH_TEST_CASE("SeqLock", "[lib][concurrency]") {
+    CATCH_SECTION("Versions") {
+        auto lock = svs::lib::SeqLock();
+        auto version = lock.read_begin();
+        CATCH_REQUIRE(!lock.read_retry(version));
+
+        lock.write_begin();
+        lock.write_end();
+        CATCH_REQUIRE(lock.read_retry(version));
+        version = lock.read_begin();
+        CATCH_REQUIRE(!lock.read_retry(version));
+
+        // Copies carry the version.
+        auto other = lock;
+        CATCH_REQUIRE(!other.read_retry(version));
+    }
+
+    CATCH_SECTION("Concurrent Readers") {
+        // The writer keeps all entries equal. Readers must never observe a mix.
+        auto lock = svs::lib::SeqLock();
+        std::array<std::atomic<size_t>, 8> values{};
+        std::atomic<bool> done{false};
+        std::atomic<size_t> torn{0};
+
+        auto reader = [&]() {
+            auto local = std::array<size_t, 8>{};
+            while (!done) {
+                uint32_t version = 0;
+                do {
+                    version = lock.read_begin();
+                    for (size_t i = 0; i < local.size(); ++i) {
+                        local[i] = values[i].load(std::memory_order_relaxed);
+                    }
+                } while (lock.read_retry(version));
+
+                for (auto v : local) {
+                    if (v != local[0]) {
+                        ++torn;
+                    }
+                }
+            }
+        };
+
+        auto readers = std::array<std::thread, 2>{std::thread(reader), std::thread(reader)};
+        for (size_t iteration = 1; iteration <= 100'000; ++iteration) {
+            lock.write_begin();
+            for (auto& v : values) {
+                v.store(iteration, std::memory_order_relaxed);
+            }
+            lock.write_end();
+        }
+        done = true;
+        for (auto& t : readers) {
+            t.join();
+        }
+        CATCH_REQUIRE(torn == 0);
+    }
+}
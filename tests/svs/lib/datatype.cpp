@@ -63,6 +63,7 @@ CATCH_TEST_CASE("Data Type", "[core][datatype]") {
         test<float, DataType::float32>("float32");
         test<double, DataType::float64>("float64");
         CATCH_REQUIRE(svs::parse_datatype("float128") == DataType::undef);
+        test<svs::BFloat16, DataType::bfloat16>("bfloat16");
 
         test<std::byte, DataType::byte>("byte");
 
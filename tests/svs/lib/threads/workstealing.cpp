@@ -0,0 +1,287 @@
+/**
+ *    Copyright (C) 2023, Intel Corporation
+ *
+ *    You can redistribute and/or modify this software under the terms of the
+ *    GNU Affero General Public License version 3.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    version 3 along with this software. If not, see
+ *    <https://www.gnu.org/licenses/agpl-3.0.en.html>.
+ */
+
+// stdlib
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+// local includes
+#include "svs/lib/misc.h"
+#include "svs/lib/threads/workstealing.h"
+
+// catch macros
+#include "catch2/catch_test_macros.hpp"
+
+namespace {
+
+// Count the number of times each index in `[0, n)` is visited.
+std::vector<size_t> visit_counts(const std::vector<std::atomic<size_t>>& counts) {
+    auto result = std::vector<size_t>{};
+    for (const auto& count : counts) {
+        result.push_back(count.load());
+    }
+    return result;
+}
+
+} // namespace
+
+CATCH_TEST_CASE("Work Stealing Thread Pool", "[core][threads][threadpool]") {
+    namespace threads = svs::threads;
+    // Use a short spin time so sleeping and waking up is exercised as well.
+    auto pool = threads::WorkStealingThreadPool(4, threads::short_spintime());
+    CATCH_REQUIRE(pool.size() == 4);
+
+    CATCH_SECTION("Run") {
+        for (size_t iteration = 0; iteration < 100; ++iteration) {
+            auto counts = std::vector<std::atomic<size_t>>(pool.size());
+            threads::run(pool, [&](uint64_t tid) { counts.at(tid)++; });
+            CATCH_REQUIRE(visit_counts(counts) == std::vector<size_t>(pool.size(), 1));
+        }
+    }
+
+    CATCH_SECTION("Static Partition") {
+        auto counts = std::vector<std::atomic<size_t>>(1000);
+        auto bad_tid = std::atomic<bool>{false};
+        threads::run(
+            pool,
+            threads::StaticPartition(counts.size()),
+            [&](const auto& range, uint64_t tid) {
+                if (tid >= pool.size()) {
+                    bad_tid = true;
+                }
+                for (auto i : range) {
+                    counts.at(i)++;
+                }
+            }
+        );
+        CATCH_REQUIRE(visit_counts(counts) == std::vector<size_t>(counts.size(), 1));
+        CATCH_REQUIRE(!bad_tid);
+    }
+
+    CATCH_SECTION("Dynamic Partition") {
+        // Each chunk should be scheduled as an independent task.
+        size_t grainsize = 7;
+        auto counts = std::vector<std::atomic<size_t>>(1000);
+        auto chunks = std::atomic<size_t>{0};
+        auto bad_chunk = std::atomic<bool>{false};
+        threads::run(
+            pool,
+            threads::DynamicPartition(counts.size(), grainsize),
+            [&](const auto& range, uint64_t tid) {
+                if (tid >= pool.size() || range.size() > grainsize) {
+                    bad_chunk = true;
+                }
+                chunks++;
+                for (auto i : range) {
+                    counts.at(i)++;
+                }
+            }
+        );
+        CATCH_REQUIRE(visit_counts(counts) == std::vector<size_t>(counts.size(), 1));
+        CATCH_REQUIRE(chunks.load() == svs::lib::div_round_up(counts.size(), grainsize));
+        CATCH_REQUIRE(!bad_chunk);
+
+        // Empty partitions are a no-op.
+        threads::run(
+            pool,
+            threads::DynamicPartition(size_t{0}, grainsize),
+            [&](const auto& /*range*/, uint64_t /*tid*/) { bad_chunk = true; }
+        );
+        CATCH_REQUIRE(!bad_chunk);
+    }
+
+    CATCH_SECTION("Thread IDs are unique within a call") {
+        auto busy = std::vector<std::atomic<size_t>>(pool.size());
+        auto collisions = std::atomic<size_t>{0};
+        threads::run(
+            pool,
+            threads::DynamicPartition(size_t{10'000}, 1),
+            [&](const auto& /*range*/, uint64_t tid) {
+                if (busy.at(tid).fetch_add(1) != 0) {
+                    collisions++;
+                }
+                busy.at(tid).fetch_sub(1);
+            }
+        );
+        CATCH_REQUIRE(collisions.load() == 0);
+    }
+
+    CATCH_SECTION("Nested Parallelism") {
+        // Calling back into the pool from a worker thread must not deadlock.
+        size_t inner_size = 100;
+        auto counts = std::vector<std::atomic<size_t>>(pool.size() * inner_size);
+        threads::run(pool, [&](uint64_t outer) {
+            threads::run(
+                pool,
+                threads::DynamicPartition(inner_size, 3),
+                [&](const auto& range, uint64_t /*tid*/) {
+                    for (auto i : range) {
+                        counts.at(outer * inner_size + i)++;
+                    }
+                }
+            );
+        });
+        CATCH_REQUIRE(visit_counts(counts) == std::vector<size_t>(counts.size(), 1));
+    }
+
+    CATCH_SECTION("Concurrent Callers") {
+        // Multiple external threads may submit work at the same time.
+        size_t num_clients = 4;
+        size_t num_batches = 200;
+        size_t batchsize = 50;
+        auto totals = std::vector<std::atomic<size_t>>(num_clients);
+        auto clients = std::vector<std::thread>{};
+        for (size_t client = 0; client < num_clients; ++client) {
+            clients.emplace_back([&, client]() {
+                for (size_t batch = 0; batch < num_batches; ++batch) {
+                    threads::run(
+                        pool,
+                        threads::DynamicPartition(batchsize, 4),
+                        [&](const auto& range, uint64_t /*tid*/) {
+                            totals.at(client) += range.size();
+                        }
+                    );
+                }
+            });
+        }
+        for (auto& client : clients) {
+            client.join();
+        }
+        CATCH_REQUIRE(
+            visit_counts(totals) == std::vector<size_t>(num_clients, num_batches * batchsize)
+        );
+    }
+
+    CATCH_SECTION("Thread IDs are unique across callers") {
+        // Each client takes a caller slot of its own.
+        size_t num_clients = 3;
+        auto multi = threads::WorkStealingThreadPool(2, threads::short_spintime(), 3);
+        CATCH_REQUIRE(multi.size() == 4);
+        CATCH_REQUIRE(multi.num_callers() == 3);
+        for (auto* p : {&pool, &multi}) {
+            auto busy = std::vector<std::atomic<size_t>>(p->size());
+            auto collisions = std::atomic<size_t>{0};
+            auto clients = std::vector<std::thread>{};
+            for (size_t client = 0; client < num_clients; ++client) {
+                clients.emplace_back([&, p]() {
+                    for (size_t batch = 0; batch < 100; ++batch) {
+                        threads::run(
+                            *p,
+                            threads::DynamicPartition(size_t{20}, 1),
+                            [&](const auto& /*range*/, uint64_t tid) {
+                                if (busy.at(tid).fetch_add(1) != 0) {
+                                    collisions++;
+                                }
+                                busy.at(tid).fetch_sub(1);
+                            }
+                        );
+                    }
+                });
+            }
+            for (auto& client : clients) {
+                client.join();
+            }
+            CATCH_REQUIRE(collisions.load() == 0);
+        }
+    }
+
+    CATCH_SECTION("Nested Parallelism Without Workers") {
+        // The caller slot is reused by nested calls.
+        auto single = threads::WorkStealingThreadPool(1);
+        CATCH_REQUIRE(single.size() == 1);
+        auto count = std::atomic<size_t>{0};
+        threads::run(single, threads::DynamicPartition(size_t{4}, 1), [&](auto&&, uint64_t) {
+            threads::run(
+                single, threads::DynamicPartition(size_t{4}, 1), [&](auto&&, uint64_t) {
+                    count++;
+                }
+            );
+        });
+        CATCH_REQUIRE(count.load() == 16);
+    }
+
+    CATCH_SECTION("Exceptions") {
+        for (size_t i = 0; i < pool.size(); ++i) {
+            auto v = std::vector<uint64_t>{};
+            auto v_mutex = std::mutex{};
+            auto expected = "Thread " + std::to_string(i) + ": This is a test";
+            bool caught = false;
+            try {
+                threads::run(pool, [&](uint64_t tid) {
+                    if (tid == i) {
+                        throw std::runtime_error("This is a test");
+                    }
+                    std::lock_guard lock{v_mutex};
+                    v.push_back(tid);
+                });
+            } catch (const threads::ThreadingException& error) {
+                caught = true;
+                CATCH_REQUIRE(std::string{error.what()}.find(expected) != std::string::npos);
+            }
+            CATCH_REQUIRE(caught);
+
+            // All other items should have been added to the vector.
+            std::sort(v.begin(), v.end());
+            CATCH_REQUIRE(v.size() == pool.size() - 1);
+            CATCH_REQUIRE(std::find(v.begin(), v.end(), i) == v.end());
+        }
+
+        // Exceptions in chunks are reported by task.
+        CATCH_REQUIRE_THROWS_AS(
+            threads::run(
+                pool,
+                threads::DynamicPartition(size_t{10}, 1),
+                [&](const auto& range, uint64_t /*tid*/) {
+                    if (*range.begin() == 5) {
+                        throw std::runtime_error("chunk failed");
+                    }
+                }
+            ),
+            threads::ThreadingException
+        );
+
+        // The pool remains usable.
+        auto count = std::atomic<size_t>{0};
+        threads::run(pool, [&](uint64_t /*tid*/) { count++; });
+        CATCH_REQUIRE(count.load() == pool.size());
+    }
+
+    CATCH_SECTION("Resize and Move") {
+        pool.resize(2);
+        CATCH_REQUIRE(pool.size() == 2);
+        auto count = std::atomic<size_t>{0};
+        threads::run(pool, [&](uint64_t /*tid*/) { count++; });
+        CATCH_REQUIRE(count.load() == 2);
+
+        pool.resize(0);
+        CATCH_REQUIRE(pool.size() == 1);
+        count = 0;
+        threads::run(pool, threads::DynamicPartition(size_t{10}, 2), [&](auto&&, uint64_t) {
+            count++;
+        });
+        CATCH_REQUIRE(count.load() == 5);
+
+        pool.resize(3);
+        auto other = std::move(pool);
+        CATCH_REQUIRE(other.size() == 3);
+        count = 0;
+        threads::run(other, [&](uint64_t /*tid*/) { count++; });
+        CATCH_REQUIRE(count.load() == 3);
+
+        pool = threads::WorkStealingThreadPool(2);
+        CATCH_REQUIRE(pool.size() == 2);
+    }
+}
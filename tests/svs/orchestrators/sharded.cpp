@@ -0,0 +1,337 @@
+/**
+ *    Copyright (C) 2023, Intel Corporation
+ *
+ *    You can redistribute and/or modify this software under the terms of the
+ *    GNU Affero General Public License version 3.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    version 3 along with this software. If not, see
+ *    <https://www.gnu.org/licenses/agpl-3.0.en.html>.
+ */
+
+// header under test
+#include "svs/orchestrators/sharded.h"
+
+// SVS
+#include "svs/core/recall.h"
+#include "svs/orchestrators/exhaustive.h"
+#include "svs/orchestrators/vamana.h"
+
+// tests
+#include "tests/utils/generators.h"
+#include "tests/utils/utils.h"
+
+// Catch2
+#include "catch2/catch_test_macros.hpp"
+
+// stl
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const size_t dims = 8;
+
+svs::data::SimpleData<float>
+slice(const svs::data::SimpleData<float>& data, size_t start, size_t stop) {
+    auto result = svs::data::SimpleData<float>(stop - start, data.dimensions());
+    for (size_t i = start; i < stop; ++i) {
+        result.set_datum(i - start, data.get_datum(i));
+    }
+    return result;
+}
+
+// Shard recording how many threads search all shards at once.
+class ConcurrencyProbe {
+  public:
+    using search_parameters_type = size_t;
+
+    struct Counters {
+        std::atomic<size_t> active{0};
+        std::atomic<size_t> peak{0};
+    };
+
+    ConcurrencyProbe(std::shared_ptr<Counters> counters, size_t target)
+        : counters_{std::move(counters)}
+        , target_{target} {}
+
+    size_t size() const { return 1; }
+    size_t dimensions() const { return dims; }
+    search_parameters_type get_search_parameters() const { return 0; }
+
+    bool can_change_threads() const { return true; }
+    size_t get_num_threads() const { return threadpool_.size(); }
+    void set_num_threads(size_t num_threads) { threadpool_.resize(num_threads); }
+
+    // Each thread waits for `target` threads to be searching, up to a timeout.
+    template <typename QueryType>
+    void search(
+        svs::QueryResultView<size_t> result,
+        svs::data::ConstSimpleDataView<QueryType> queries,
+        search_parameters_type SVS_UNUSED(search_parameters)
+    ) {
+        svs::threads::run(
+            threadpool_,
+            svs::threads::StaticPartition{queries.size()},
+            [&](const auto& is, uint64_t SVS_UNUSED(tid)) {
+                if (is.empty()) {
+                    return;
+                }
+                size_t active = ++counters_->active;
+                auto& peak = counters_->peak;
+                size_t current = peak.load();
+                while (current < active && !peak.compare_exchange_weak(current, active)) {
+                }
+                auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+                while (counters_->peak.load() < target_ &&
+                       std::chrono::steady_clock::now() < deadline) {
+                    std::this_thread::yield();
+                }
+                for (auto i : is) {
+                    for (size_t j = 0; j < result.n_neighbors(); ++j) {
+                        result.set(svs::Neighbor<size_t>{0, 0}, i, j);
+                    }
+                }
+                --counters_->active;
+            }
+        );
+    }
+
+  private:
+    std::shared_ptr<Counters> counters_;
+    size_t target_;
+    svs::threads::NativeThreadPool threadpool_{1};
+};
+
+} // namespace
+
+CATCH_TEST_CASE("K-Way Merge", "[managers][sharded]") {
+    auto lists = std::vector<svs::QueryResult<size_t>>();
+    // List `s` holds the IDs `[0, 4)` at distances `s + 3 * j`.
+    for (size_t s = 0; s < 20; ++s) {
+        auto& list = lists.emplace_back(1, 4);
+        for (size_t j = 0; j < 4; ++j) {
+            list.set(svs::Neighbor<size_t>{j, static_cast<float>(s + 3 * j)}, 0, j);
+        }
+    }
+    auto offsets = std::vector<size_t>();
+    for (size_t s = 0; s < lists.size(); ++s) {
+        offsets.push_back(100 * s);
+    }
+
+    auto result = svs::QueryResult<size_t>(1, 6);
+    auto merge = svs::KWayMerge<std::less<>>(lists.size());
+    merge(
+        result.view(), 0, svs::lib::as_const_span(lists), svs::lib::as_const_span(offsets)
+    );
+    // Ties are resolved in favor of the earlier list.
+    auto expected_ids = std::vector<size_t>{0, 100, 200, 1, 300, 101};
+    auto expected_distances = std::vector<float>{0, 1, 2, 3, 3, 4};
+    for (size_t j = 0; j < 6; ++j) {
+        CATCH_REQUIRE(result.index(0, j) == expected_ids[j]);
+        CATCH_REQUIRE(result.distance(0, j) == expected_distances[j]);
+    }
+
+    // Exhausted lists fill the remaining entries.
+    auto few = std::vector<svs::QueryResult<size_t>>(lists.begin(), lists.begin() + 1);
+    auto large = svs::QueryResult<size_t>(1, 6);
+    auto few_merge = svs::KWayMerge<std::less<>>(1);
+    few_merge(
+        large.view(), 0, svs::lib::as_const_span(few), svs::lib::as_const_span(offsets)
+    );
+    CATCH_REQUIRE(large.index(0, 3) == 3);
+    CATCH_REQUIRE(large.index(0, 4) == std::numeric_limits<size_t>::max());
+    CATCH_REQUIRE(large.index(0, 5) == std::numeric_limits<size_t>::max());
+
+    // Padded entries end their list instead of being offset.
+    constexpr size_t missing = std::numeric_limits<size_t>::max();
+    auto padded = std::vector<svs::QueryResult<size_t>>(lists.begin(), lists.begin() + 2);
+    padded[1].set(svs::Neighbor<size_t>{missing, 4}, 0, 2);
+    padded[1].set(svs::Neighbor<size_t>{missing, 5}, 0, 3);
+    auto padded_merge = svs::KWayMerge<std::less<>>(2);
+    padded_merge(
+        large.view(), 0, svs::lib::as_const_span(padded), svs::lib::as_const_span(offsets)
+    );
+    auto expected_padded = std::vector<size_t>{0, 100, 1, 101, 2, 3};
+    for (size_t j = 0; j < 6; ++j) {
+        CATCH_REQUIRE(large.index(0, j) == expected_padded[j]);
+    }
+    padded[0].set(svs::Neighbor<size_t>{missing, 9}, 0, 3);
+    padded_merge(
+        large.view(), 0, svs::lib::as_const_span(padded), svs::lib::as_const_span(offsets)
+    );
+    CATCH_REQUIRE(large.index(0, 4) == 2);
+    CATCH_REQUIRE(large.index(0, 5) == missing);
+
+    // Larger distances are better for inner products.
+    for (auto& list : lists) {
+        for (size_t j = 0; j < 4; ++j) {
+            list.distance(0, j) = -list.distance(0, j);
+        }
+    }
+    auto ip_merge = svs::KWayMerge<std::greater<>>(lists.size());
+    ip_merge(
+        result.view(), 0, svs::lib::as_const_span(lists), svs::lib::as_const_span(offsets)
+    );
+    for (size_t j = 0; j < 6; ++j) {
+        CATCH_REQUIRE(result.index(0, j) == expected_ids[j]);
+        CATCH_REQUIRE(result.distance(0, j) == -expected_distances[j]);
+    }
+}
+
+CATCH_TEST_CASE("Sharded Index", "[managers][sharded]") {
+    const size_t num_points = 3000;
+    const size_t num_queries = 50;
+    const size_t num_neighbors = 10;
+    auto generator = svs_test::make_generator<float>(-1, 1, 0x5ead);
+    auto random_data = [&](size_t n) {
+        auto data = svs::data::SimpleData<float>(n, dims);
+        for (size_t i = 0; i < n; ++i) {
+            for (auto& x : data.get_datum(i)) {
+                x = svs_test::generate(generator);
+            }
+        }
+        return data;
+    };
+    auto data = random_data(num_points);
+    auto queries = random_data(num_queries);
+    auto bounds = std::vector<size_t>{0, 1000, 1700, num_points};
+
+    auto flat = svs::Flat::assemble<float>(data, svs::distance::DistanceL2(), 2);
+    auto expected = flat.search(queries, num_neighbors);
+
+    CATCH_SECTION("Flat") {
+        auto shards = std::vector<svs::Flat>();
+        for (size_t s = 0; s + 1 < bounds.size(); ++s) {
+            shards.push_back(svs::Flat::assemble<float>(
+                slice(data, bounds[s], bounds[s + 1]), svs::distance::DistanceL2(), 1
+            ));
+        }
+        auto index = svs::ShardedIndex<svs::Flat>(std::move(shards), svs::L2, 4);
+        CATCH_REQUIRE(index.num_shards() == 3);
+        CATCH_REQUIRE(index.size() == num_points);
+        CATCH_REQUIRE(index.dimensions() == dims);
+        CATCH_REQUIRE(index.offsets() == std::vector<size_t>{0, 1000, 1700});
+        // Threads are divided among the shards.
+        CATCH_REQUIRE(index.get_num_threads() == 4);
+        CATCH_REQUIRE(index.shard(0).get_num_threads() == 2);
+        CATCH_REQUIRE(index.shard(1).get_num_threads() == 1);
+        CATCH_REQUIRE(index.shard(2).get_num_threads() == 1);
+
+        // Exhaustive shards return the exact results.
+        auto results = index.search(queries, num_neighbors);
+        for (size_t i = 0; i < num_queries; ++i) {
+            for (size_t j = 0; j < num_neighbors; ++j) {
+                CATCH_REQUIRE(results.index(i, j) == expected.index(i, j));
+                CATCH_REQUIRE(results.distance(i, j) == expected.distance(i, j));
+            }
+        }
+
+        // Thread count does not change the results.
+        index.set_num_threads(1);
+        CATCH_REQUIRE(index.shard(0).get_num_threads() == 1);
+        auto other = index.search(queries, num_neighbors);
+        CATCH_REQUIRE(svs::k_recall_at_n(results, other) == 1);
+    }
+
+    CATCH_SECTION("Vamana") {
+        auto shards = std::vector<svs::Vamana>();
+        for (size_t s = 0; s + 1 < bounds.size(); ++s) {
+            shards.push_back(svs::Vamana::build<float>(
+                svs::index::vamana::VamanaBuildParameters{1.2f, 32, 64, 200, 28, true},
+                slice(data, bounds[s], bounds[s + 1]),
+                svs::distance::DistanceL2(),
+                2
+            ));
+        }
+        auto index = svs::ShardedIndex<svs::Vamana>(std::move(shards), svs::L2, 3);
+
+        // Search parameters are set per shard.
+        auto parameters = index.get_search_parameters(0);
+        index.set_search_parameters(parameters.buffer_config(40));
+        CATCH_REQUIRE(
+            index.get_search_parameters(2).buffer_config_.get_search_window_size() == 40
+        );
+        auto results = index.search(queries, num_neighbors);
+        CATCH_REQUIRE(svs::k_recall_at_n(expected, results) > 0.95);
+
+        index.set_search_parameters(1, parameters.buffer_config(num_neighbors));
+        CATCH_REQUIRE(
+            index.get_search_parameters(1).buffer_config_.get_search_window_size() ==
+            num_neighbors
+        );
+        auto wrong = std::vector<svs::index::vamana::VamanaSearchParameters>(2);
+        auto view = svs::QueryResult<size_t>(num_queries, num_neighbors);
+        CATCH_REQUIRE_THROWS_AS(
+            index.search(view.view(), queries.cview(), svs::lib::as_const_span(wrong)),
+            svs::ANNException
+        );
+
+        // Saving and loading.
+        svs_test::prepare_temp_directory();
+        auto dir = svs_test::temp_directory() / "sharded";
+        index.set_search_parameters(parameters.buffer_config(40));
+        index.save(dir, [](svs::Vamana& shard, const std::filesystem::path& path) {
+            shard.save(path / "config", path / "graph", path / "data");
+        });
+        auto loaded = svs::ShardedIndex<svs::Vamana>::load(
+            dir,
+            [](const std::filesystem::path& path) {
+                return svs::Vamana::assemble<float>(
+                    path / "config",
+                    svs::GraphLoader(path / "graph"),
+                    svs::VectorDataLoader<float>(path / "data"),
+                    svs::distance::DistanceL2()
+                );
+            },
+            2
+        );
+        CATCH_REQUIRE(loaded.num_shards() == 3);
+        CATCH_REQUIRE(loaded.offsets() == index.offsets());
+        CATCH_REQUIRE(loaded.distance_type() == svs::L2);
+        auto loaded_results = loaded.search(queries, num_neighbors);
+        CATCH_REQUIRE(svs::k_recall_at_n(results, loaded_results) > 0.99);
+    }
+
+    CATCH_SECTION("Errors") {
+        CATCH_REQUIRE_THROWS_AS(
+            svs::ShardedIndex<svs::Flat>(std::vector<svs::Flat>(), svs::L2, 1),
+            svs::ANNException
+        );
+        auto shards = std::vector<svs::Flat>();
+        shards.push_back(svs::Flat::assemble<float>(data, svs::distance::DistanceL2(), 1));
+        CATCH_REQUIRE_THROWS_AS(
+            svs::ShardedIndex<svs::Flat>(
+                std::move(shards), std::vector<size_t>{0, 1}, svs::L2, 1
+            ),
+            svs::ANNException
+        );
+    }
+}
+
+CATCH_TEST_CASE("Sharded Index Concurrency", "[managers][sharded]") {
+    // More threads than shards all search at once.
+    const size_t num_threads = 6;
+    const size_t num_shards = 2;
+    auto counters = std::make_shared<ConcurrencyProbe::Counters>();
+    auto shards = std::vector<ConcurrencyProbe>();
+    for (size_t s = 0; s < num_shards; ++s) {
+        shards.emplace_back(counters, num_threads);
+    }
+    auto index =
+        svs::ShardedIndex<ConcurrencyProbe>(std::move(shards), svs::L2, num_threads);
+    CATCH_REQUIRE(index.shard(0).get_num_threads() == 3);
+    CATCH_REQUIRE(index.shard(1).get_num_threads() == 3);
+
+    auto queries = svs::data::SimpleData<float>(20, dims);
+    auto results = index.search(queries, 1);
+    CATCH_REQUIRE(counters->peak.load() > num_shards);
+    CATCH_REQUIRE(counters->peak.load() == num_threads);
+    CATCH_REQUIRE(results.index(0, 0) == 0);
+}
@@ -10,11 +10,109 @@
  */
 
 // SVS
+#include "svs/core/bitset.h"
+#include "svs/core/recall.h"
+#include "svs/orchestrators/exhaustive.h"
 #include "svs/orchestrators/vamana.h"
 
+// tests
+#include "tests/utils/generators.h"
+
 // Catch2
 #include "catch2/catch_test_macros.hpp"
 
+// stl
+#include <algorithm>
+#include <cstdint>
+
 CATCH_TEST_CASE("Vamana Index", "[managers][vamana]") {
     // Todo?
 }
+
+CATCH_TEST_CASE("Vamana Range Search", "[managers][vamana]") {
+    const size_t num_points = 2000;
+    const size_t num_queries = 20;
+    const size_t dims = 8;
+    auto generator = svs_test::make_generator<float>(-1, 1, 0x5eed);
+    auto random_data = [&](size_t n) {
+        auto data = svs::data::SimpleData<float>(n, dims);
+        for (size_t i = 0; i < n; ++i) {
+            for (auto& x : data.get_datum(i)) {
+                x = svs_test::generate(generator);
+            }
+        }
+        return data;
+    };
+    auto data = random_data(num_points);
+    auto queries = random_data(num_queries);
+
+    auto flat = svs::Flat::assemble<float>(data, svs::distance::DistanceL2(), 2);
+    auto vamana = svs::Vamana::build<float>(
+        svs::index::vamana::VamanaBuildParameters{1.2f, 32, 64, 200, 28, true},
+        data,
+        svs::distance::DistanceL2(),
+        2
+    );
+    vamana.set_search_window_size(10);
+
+    const float radius = 1.5f;
+    auto expected = flat.range_search(queries, radius);
+    auto results = vamana.range_search(queries, radius);
+    CATCH_REQUIRE(expected.n_queries() == num_queries);
+    CATCH_REQUIRE(results.n_queries() == num_queries);
+    CATCH_REQUIRE(expected.total_results() > 10 * num_queries);
+    CATCH_REQUIRE(results.total_results() >= 0.95 * expected.total_results());
+    for (size_t i = 0; i < num_queries; ++i) {
+        auto truth = expected.indices(i);
+        for (auto id : results.indices(i)) {
+            CATCH_REQUIRE(std::find(truth.begin(), truth.end(), id) != truth.end());
+        }
+    }
+
+    // Unsupported query types are rejected.
+    auto queries_u8 = svs::data::SimpleData<uint8_t>(num_queries, dims);
+    CATCH_REQUIRE_THROWS_AS(vamana.range_search(queries_u8, radius), svs::ANNException);
+}
+
+CATCH_TEST_CASE("Vamana Filtered Search", "[managers][vamana]") {
+    const size_t num_points = 2000;
+    const size_t num_queries = 20;
+    const size_t num_neighbors = 10;
+    const size_t dims = 8;
+    auto generator = svs_test::make_generator<float>(-1, 1, 0xf11e);
+    auto random_data = [&](size_t n) {
+        auto data = svs::data::SimpleData<float>(n, dims);
+        for (size_t i = 0; i < n; ++i) {
+            for (auto& x : data.get_datum(i)) {
+                x = svs_test::generate(generator);
+            }
+        }
+        return data;
+    };
+    auto data = random_data(num_points);
+    auto queries = random_data(num_queries);
+
+    auto flat = svs::Flat::assemble<float>(data, svs::distance::DistanceL2(), 2);
+    auto vamana = svs::Vamana::build<float>(
+        svs::index::vamana::VamanaBuildParameters{1.2f, 32, 64, 200, 28, true},
+        data,
+        svs::distance::DistanceL2(),
+        2
+    );
+    vamana.set_search_window_size(2 * num_neighbors);
+
+    auto allowed = svs::BitSet(num_points);
+    for (size_t i = 0; i < num_points; i += 4) {
+        allowed.set(i);
+    }
+    auto filter = svs::SearchFilter(allowed);
+    auto expected = flat.search(queries, num_neighbors, filter);
+    auto results = vamana.search(queries, num_neighbors, filter);
+    for (size_t i = 0; i < num_queries; ++i) {
+        for (size_t j = 0; j < num_neighbors; ++j) {
+            CATCH_REQUIRE(allowed.test(expected.index(i, j)));
+            CATCH_REQUIRE(allowed.test(results.index(i, j)));
+        }
+    }
+    CATCH_REQUIRE(svs::k_recall_at_n(expected, results) >= 0.95);
+}
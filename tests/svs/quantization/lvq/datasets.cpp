@@ -621,6 +621,7 @@ CATCH_TEST_CASE("Compressed Dataset", "[quantization][lvq][lvq_datasets]") {
         auto blocking_parameters =
             svs::data::BlockingParameters{.blocksize_bytes = svs::lib::PowerOfTwo(12)};
         auto blocked = svs::data::Blocked{blocking_parameters, allocator};
+        auto mapped = svs::MMapAllocator<std::byte>();
 
         auto test_strategies = [&]<size_t N, lvq::LVQPackingStrategy Strategy>() {
             for (size_t alignment : {0, 32}) {
@@ -638,6 +639,9 @@ CATCH_TEST_CASE("Compressed Dataset", "[quantization][lvq][lvq_datasets]") {
                 tester.template populate<N, svs::Dynamic, Strategy>(
                     dataset_size, d, alignment, blocked
                 );
+                tester.template populate<N, TEST_DIM, Strategy>(
+                    dataset_size, s, alignment, mapped
+                );
             }
         };
 
@@ -652,5 +656,26 @@ CATCH_TEST_CASE("Compressed Dataset", "[quantization][lvq][lvq_datasets]") {
 
         // Turbo Strategies
         test_strategies.template operator()<4, lvq::Turbo<16, 8>>();
+
+        // Unpadded sequential datasets map the saved file in place.
+        {
+            using Mapped = lvq::
+                ScaledBiasedDataset<4, svs::Dynamic, lvq::Sequential, decltype(mapped)>;
+            auto dir = svs_test::temp_directory();
+            auto dataset = lvq::ScaledBiasedDataset<4, svs::Dynamic, lvq::Sequential>(
+                dataset_size, MaybeStatic<svs::Dynamic>(TEST_DIM)
+            );
+            svs::lib::save_to_disk(dataset, dir);
+            auto other = svs::lib::load_from_disk<Mapped>(dir, 0, mapped);
+            auto mappings = svs::detail::MMapRegistry::get_mappings();
+            CATCH_REQUIRE(mappings.size() == 1);
+            CATCH_REQUIRE(mappings.begin()->second.base != mappings.begin()->first);
+
+            // Padded datasets are converted from the canonical layout.
+            other = svs::lib::load_from_disk<Mapped>(dir, 32, mapped);
+            mappings = svs::detail::MMapRegistry::get_mappings();
+            CATCH_REQUIRE(mappings.size() == 1);
+            CATCH_REQUIRE(mappings.begin()->second.base == mappings.begin()->first);
+        }
     }
 }
@@ -17,6 +17,7 @@
 #include <unordered_set>
 #include <vector>
 
+#include "svs/lib/bfloat16.h"
 #include "svs/lib/float16.h"
 #include "svs/lib/narrow.h"
 
@@ -35,8 +36,8 @@
 // Thus, use the `CatchGenerator` type aliases to selectively convert small integers to
 // larger intergers, relying on type conversion when they are inserted into the vectors.
 //
-// This also provides an entry point for intercepting `svs::float16` and doing that
-// conversion as well.
+// This also provides an entry point for intercepting `svs::float16` and `svs::bfloat16`
+// and doing that conversion as well.
 namespace svs_test {
 template <typename T> struct CatchGenerator {
     using type = T;
@@ -50,16 +51,20 @@ template <> struct CatchGenerator<int8_t> {
 template <> struct CatchGenerator<svs::Float16> {
     using type = float;
 };
+template <> struct CatchGenerator<svs::BFloat16> {
+    using type = float;
+};
 
 // Convenience alias function.
 template <typename T> using catch_generator_type_t = typename CatchGenerator<T>::type;
 template <typename T, typename U> T convert_to(U x) { return svs::lib::narrow<T>(x); }
 
-// `narrow` doesn't work for converting from `float` to `svs::Float16` because in this
-// case we can't easily prevent loss of information.
+// `narrow` doesn't work for converting from `float` to `svs::Float16` or `svs::BFloat16`
+// because in this case we can't easily prevent loss of information.
 //
 // Fortunately in this case, it doesn't particularly matter.
 template <> inline svs::Float16 convert_to(float x) { return svs::Float16{x}; }
+template <> inline svs::BFloat16 convert_to(float x) { return svs::BFloat16{x}; }
 
 // Conveniently convert a bound of type `T` to the appropriate type for use in one of
 // the `Catch2` number generators.
@@ -0,0 +1,52 @@
+/**
+ *    Copyright (C) 2023, Intel Corporation
+ *
+ *    You can redistribute and/or modify this software under the terms of the
+ *    GNU Affero General Public License version 3.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    version 3 along with this software. If not, see
+ *    <https://www.gnu.org/licenses/agpl-3.0.en.html>.
+ */
+
+// svs-test
+#include "tests/utils/synthetic.h"
+
+// svs
+#include "svs/core/data/simple.h"
+#include "svs/core/distance.h"
+#include "svs/index/flat/flat.h"
+#include "svs/index/index.h"
+
+// stl
+#include <random>
+
+namespace synthetic {
+
+svs::data::SimpleData<float> make_data(size_t size, size_t dims, std::mt19937& rng) {
+    auto dist = std::normal_distribution<float>(0, 1);
+    auto data = svs::data::SimpleData<float>(size, dims);
+    for (size_t i = 0; i < size; ++i) {
+        for (auto& x : data.get_datum(i)) {
+            x = dist(rng);
+        }
+    }
+    return data;
+}
+
+svs::data::SimpleData<float> copy(const svs::data::SimpleData<float>& data) {
+    auto result = svs::data::SimpleData<float>(data.size(), data.dimensions());
+    svs::data::copy(data, result);
+    return result;
+}
+
+svs::QueryResult<size_t> groundtruth(
+    const svs::data::SimpleData<float>& data,
+    const svs::data::SimpleData<float>& queries,
+    size_t num_neighbors
+) {
+    auto flat = svs::index::flat::FlatIndex(copy(data), svs::distance::DistanceL2(), 2);
+    return svs::index::search_batch(flat, queries.cview(), num_neighbors);
+}
+
+} // namespace synthetic
@@ -0,0 +1,53 @@
+/**
+ *    Copyright (C) 2023, Intel Corporation
+ *
+ *    You can redistribute and/or modify this software under the terms of the
+ *    GNU Affero General Public License version 3.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    version 3 along with this software. If not, see
+ *    <https://www.gnu.org/licenses/agpl-3.0.en.html>.
+ */
+
+#pragma once
+
+// svs
+#include "svs/core/data/simple.h"
+#include "svs/core/distance.h"
+#include "svs/core/query_result.h"
+#include "svs/index/vamana/index.h"
+
+// stl
+#include <cstddef>
+#include <random>
+
+// Small random datasets for tests that need an index but not the reference dataset.
+namespace synthetic {
+
+// Return `size` vectors of `dims` dimensions with standard normal components.
+svs::data::SimpleData<float> make_data(size_t size, size_t dims, std::mt19937& rng);
+
+// Return a copy of `data`.
+svs::data::SimpleData<float> copy(const svs::data::SimpleData<float>& data);
+
+// Return the exact `num_neighbors` nearest neighbors in `data` of each query under the
+// euclidean distance.
+svs::QueryResult<size_t> groundtruth(
+    const svs::data::SimpleData<float>& data,
+    const svs::data::SimpleData<float>& queries,
+    size_t num_neighbors
+);
+
+// Build parameters reaching a recall of at least 0.9 on these datasets.
+inline svs::index::vamana::VamanaBuildParameters build_parameters() {
+    return svs::index::vamana::VamanaBuildParameters{1.2f, 24, 64, 200, 24, true};
+}
+
+// Build a Vamana index over a copy of `data` under the euclidean distance.
+inline auto build_vamana(const svs::data::SimpleData<float>& data) {
+    return svs::index::vamana::auto_build(
+        build_parameters(), copy(data), svs::distance::DistanceL2(), 2
+    );
+}
+
+} // namespace synthetic
@@ -172,6 +172,9 @@ template <> struct TypeName<int64_t> {
 template <> struct TypeName<svs::Float16> {
     static std::string name() { return "float16"; };
 };
+template <> struct TypeName<svs::BFloat16> {
+    static std::string name() { return "bfloat16"; };
+};
 template <> struct TypeName<float> {
     static std::string name() { return "float32"; };
 };
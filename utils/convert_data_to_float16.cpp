@@ -13,45 +13,61 @@
 #include <iostream>
 #include <string>
 
+#include "svs/core/data.h"
 #include "svs/core/io.h"
 #include "svs/lib/float16.h"
 #include "svsmain.h"
 
+namespace {
+
+// Read all vectors of `file` in parallel, converting them to `Float16` as they arrive.
+template <typename File>
+svs::data::SimpleData<svs::Float16> load_converted(const File& file, size_t num_threads) {
+    auto threadpool = svs::threads::NativeThreadPool(num_threads);
+    return svs::io::parallel_load_dataset(
+        file,
+        svs::lib::Type<float>(),
+        svs::lib::Lazy([](size_t n_elements, size_t n_dimensions) {
+            return svs::data::SimpleData<svs::Float16>(n_elements, n_dimensions);
+        }),
+        threadpool
+    );
+}
+
+} // namespace
+
 int svs_main(std::vector<std::string> args) {
-    if (args.size() != 4) {
+    if (args.size() != 4 && args.size() != 5) {
         std::cout << "Specify the right parameters: input index, output index, "
-                     "vector_type: 0 for SVS data, 1 for fvecs, 2 for fbin"
+                     "vector_type: 0 for SVS data, 1 for fvecs, 2 for fbin, "
+                     "and optionally the number of threads (default: 1)"
                   << std::endl;
         return 1;
     }
     const std::string& filename_f32 = args[1];
     const std::string& filename_f16 = args[2];
     const size_t file_type = std::stoull(args[3]);
+    const size_t num_threads = args.size() == 5 ? std::stoull(args[4]) : 1;
 
     if (file_type == 0) {
         std::cout << "Converting SVS data!" << std::endl;
-        auto reader = svs::io::v1::NativeFile{filename_f32}.reader(svs::lib::Type<float>());
-        auto writer = svs::io::NativeFile{filename_f16}.writer(
-            svs::lib::Type<svs::Float16>(), reader.ndims()
-        );
-
-        for (auto i : reader) {
-            writer << i;
-        }
+        auto data = load_converted(svs::io::NativeFile{filename_f32}, num_threads);
+        svs::io::save(data, svs::io::NativeFile{filename_f16});
     } else if (file_type == 1) {
         std::cout << "Converting Vecs data!" << std::endl;
-        auto reader = svs::io::vecs::VecsReader<float>{filename_f32};
-        auto writer = svs::io::vecs::VecsWriter<svs::Float16>{filename_f16, reader.ndims()};
-        for (auto i : reader) {
-            writer << i;
+        auto data = load_converted(svs::io::vecs::VecsFile{filename_f32}, num_threads);
+        auto writer =
+            svs::io::vecs::VecsWriter<svs::Float16>{filename_f16, data.dimensions()};
+        for (size_t i = 0; i < data.size(); ++i) {
+            writer << data.get_datum(i);
         }
     } else if (file_type == 2) {
         std::cout << "Converting Bin data!" << std::endl;
-        auto reader = svs::io::binary::BinaryReader<float>{filename_f32};
+        auto data = load_converted(svs::io::binary::BinaryFile{filename_f32}, num_threads);
         auto writer = svs::io::binary::BinaryWriter<svs::Float16>{
-            filename_f16, reader.nvectors(), reader.ndims()};
-        for (auto i : reader) {
-            writer << i;
+            filename_f16, data.size(), data.dimensions()};
+        for (size_t i = 0; i < data.size(); ++i) {
+            writer << data.get_datum(i);
         }
     }
 